@@ -8,10 +8,56 @@
 #include <string.h>
 #include "esp_log.h"
 #include "esp_gmf_audio_helper.h"
+#include "esp_gmf_audio_param.h"
+#include "esp_gmf_element.h"
+#include "esp_gmf_cap.h"
+#include "esp_gmf_caps_def.h"
+#include "gmf_audio_common.h"
 #include "esp_fourcc.h"
 
+/**
+ * @brief  Relative cost of the audio converters to handle one byte, resampling runs a filter for each sample
+ */
+#define AUDIO_CVT_COST_RATE  (16)
+#define AUDIO_CVT_COST_CH    (1)
+#define AUDIO_CVT_COST_BIT   (1)
+
+typedef struct {
+    const char *tag;   /*!< Tag of the converter element */
+    uint32_t    cost;  /*!< Relative cost to handle one byte of input */
+} audio_cvt_cost_t;
+
+static const audio_cvt_cost_t audio_cvt_cost[GMF_AUDIO_CVT_MAX] = {
+    [GMF_AUDIO_CVT_RATE] = {"rate_cvt", AUDIO_CVT_COST_RATE},
+    [GMF_AUDIO_CVT_CH]   = {"ch_cvt", AUDIO_CVT_COST_CH},
+    [GMF_AUDIO_CVT_BIT]  = {"bit_cvt", AUDIO_CVT_COST_BIT},
+};
+
+// All the orders of three converters, the first one is the default order on equal cost
+static const uint8_t audio_cvt_orders[][GMF_AUDIO_CVT_MAX] = {
+    {0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0},
+};
+
 static const char *TAG = "ESP_GMF_AUDIO_HELPER";
 
+static uint64_t audio_helper_cvt_cost(const esp_gmf_info_sound_t *src, const esp_gmf_info_sound_t *dest,
+                                      const uint8_t *types, uint8_t cnt)
+{
+    esp_gmf_info_sound_t cur = *src;
+    uint64_t cost = 0;
+    for (int i = 0; i < cnt; i++) {
+        cost += (uint64_t)audio_cvt_cost[types[i]].cost * cur.sample_rates * cur.channels * (cur.bits >> 3);
+        if (types[i] == GMF_AUDIO_CVT_RATE) {
+            cur.sample_rates = dest->sample_rates;
+        } else if (types[i] == GMF_AUDIO_CVT_CH) {
+            cur.channels = dest->channels;
+        } else {
+            cur.bits = dest->bits;
+        }
+    }
+    return cost;
+}
+
 esp_gmf_err_t esp_gmf_audio_helper_get_audio_type_by_uri(const char *uri, uint32_t *format_id)
 {
     const char *ext = strrchr(uri, '.');
@@ -58,3 +104,79 @@ esp_gmf_err_t esp_gmf_audio_helper_get_audio_type_by_uri(const char *uri, uint32
     }
     return ESP_GMF_ERR_OK;
 }
+
+uint8_t gmf_audio_plan_cvt(const esp_gmf_info_sound_t *src, const esp_gmf_info_sound_t *dest, uint8_t order[GMF_AUDIO_CVT_MAX])
+{
+    uint8_t needed[GMF_AUDIO_CVT_MAX] = {0};
+    uint8_t cnt = 0;
+    if (src->sample_rates != dest->sample_rates) {
+        needed[cnt++] = GMF_AUDIO_CVT_RATE;
+    }
+    if (src->channels != dest->channels) {
+        needed[cnt++] = GMF_AUDIO_CVT_CH;
+    }
+    if (src->bits != dest->bits) {
+        needed[cnt++] = GMF_AUDIO_CVT_BIT;
+    }
+    uint64_t best_cost = UINT64_MAX;
+    for (int i = 0; i < sizeof(audio_cvt_orders) / sizeof(audio_cvt_orders[0]); i++) {
+        // Drop the positions beyond the needed count, the shorter orders repeat but stay valid
+        uint8_t types[GMF_AUDIO_CVT_MAX] = {0};
+        uint8_t n = 0;
+        for (int j = 0; j < GMF_AUDIO_CVT_MAX; j++) {
+            if (audio_cvt_orders[i][j] < cnt) {
+                types[n++] = needed[audio_cvt_orders[i][j]];
+            }
+        }
+        uint64_t cost = audio_helper_cvt_cost(src, dest, types, n);
+        if (cost < best_cost) {
+            best_cost = cost;
+            memcpy(order, types, GMF_AUDIO_CVT_MAX);
+        }
+    }
+    ESP_LOGD(TAG, "Planned %d converters, rate:%d->%d, ch:%d->%d, bits:%d->%d", cnt,
+             src->sample_rates, dest->sample_rates, src->channels, dest->channels, src->bits, dest->bits);
+    return cnt;
+}
+
+esp_gmf_err_t esp_gmf_audio_helper_plan_cvt(const esp_gmf_info_sound_t *src, const esp_gmf_info_sound_t *dest,
+                                            const char *el_names[ESP_GMF_AUDIO_HELPER_CVT_MAX], uint8_t *el_cnt)
+{
+    ESP_GMF_NULL_CHECK(TAG, src, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, dest, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, el_names, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, el_cnt, return ESP_GMF_ERR_INVALID_ARG);
+    uint8_t order[GMF_AUDIO_CVT_MAX] = {0};
+    uint8_t cnt = gmf_audio_plan_cvt(src, dest, order);
+    for (int i = 0; i < cnt; i++) {
+        el_names[i] = audio_cvt_cost[order[i]].tag;
+    }
+    *el_cnt = cnt;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_audio_helper_set_cvt_dest(esp_gmf_pipeline_handle_t pipeline, const esp_gmf_info_sound_t *dest)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, dest, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_element_handle_t el = NULL;
+    esp_gmf_err_t ret = esp_gmf_pipeline_get_head_el(pipeline, &el);
+    ESP_GMF_RET_ON_NOT_OK(TAG, ret, return ret, "Failed to get the head element");
+    for (; el; esp_gmf_pipeline_get_next_el(pipeline, el, &el)) {
+        const esp_gmf_cap_t *caps = NULL;
+        esp_gmf_element_get_caps(el, &caps);
+        for (; caps; caps = caps->next) {
+            if (caps->cap_eightcc == ESP_GMF_CAPS_AUDIO_RATE_CONVERT) {
+                ret = esp_gmf_audio_param_set_dest_rate(el, dest->sample_rates);
+            } else if (caps->cap_eightcc == ESP_GMF_CAPS_AUDIO_CHANNEL_CONVERT) {
+                ret = esp_gmf_audio_param_set_dest_ch(el, dest->channels);
+            } else if (caps->cap_eightcc == ESP_GMF_CAPS_AUDIO_BIT_CONVERT) {
+                ret = esp_gmf_audio_param_set_dest_bits(el, dest->bits);
+            } else {
+                continue;
+            }
+            ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Failed to set the destination of %s", OBJ_GET_TAG(el));
+        }
+    }
+    return ESP_GMF_ERR_OK;
+}
@@ -29,6 +29,7 @@ typedef struct {
                                                         True: Execute the close function first, then execute the open function
                                                         False: Do nothing */
     bool                    bypass : 1;            /*!< Whether bypass. True: need bypass. False: needn't bypass */
+    bool                    in_place : 1;          /*!< The bypassed conversion runs on the input buffer granted by the in-place plan */
 } esp_gmf_bit_cvt_t;
 
 static const char *TAG = "ESP_GMF_BIT_CVT";
@@ -60,6 +61,10 @@ static esp_gmf_job_err_t esp_gmf_bit_cvt_open(esp_gmf_element_handle_t self, voi
              bit_info->sample_rate, bit_info->channel, bit_info->src_bits, bit_info->dest_bits);
     bit_cvt->need_reopen = false;
     bit_cvt->bypass = (bit_info->src_bits == bit_info->dest_bits);
+    // The plan made on run follows the declaration, only the identity conversion is declared for the next plan
+    esp_gmf_element_t *el = ESP_GMF_ELEMENT_GET(self);
+    bit_cvt->in_place = bit_cvt->bypass && el->in_place.enable && el->in && el->in->is_shared;
+    el->in_place.enable = bit_cvt->bypass;
     return ESP_GMF_JOB_ERR_OK;
 }
 
@@ -74,6 +79,20 @@ static esp_gmf_job_err_t esp_gmf_bit_cvt_close(esp_gmf_element_handle_t self, vo
     return ESP_GMF_ERR_OK;
 }
 
+static esp_gmf_job_err_t esp_gmf_bit_cvt_reset(esp_gmf_element_handle_t self, void *para)
+{
+    // The conversion keeps no samples between the frames, reuse the handle unless the format is changed
+    esp_gmf_bit_cvt_t *bit_cvt = (esp_gmf_bit_cvt_t *)self;
+    if (bit_cvt->need_reopen || (bit_cvt->bit_hd == NULL)) {
+        esp_gmf_bit_cvt_close(self, NULL);
+        return esp_gmf_bit_cvt_open(self, NULL);
+    }
+    esp_ae_bit_cvt_cfg_t *bit_info = (esp_ae_bit_cvt_cfg_t *)OBJ_GET_CFG(self);
+    GMF_AUDIO_UPDATE_SND_INFO(self, bit_info->sample_rate, bit_info->dest_bits, bit_info->channel);
+    ESP_LOGD(TAG, "Reset, %p", self);
+    return ESP_GMF_JOB_ERR_OK;
+}
+
 static esp_gmf_job_err_t esp_gmf_bit_cvt_process(esp_gmf_element_handle_t self, void *para)
 {
     esp_gmf_bit_cvt_t *bit_cvt = (esp_gmf_bit_cvt_t *)self;
@@ -100,13 +119,18 @@ static esp_gmf_job_err_t esp_gmf_bit_cvt_process(esp_gmf_element_handle_t self,
         out_len = ESP_GMF_JOB_ERR_FAIL;
         goto __bit_release;
     }
-    if ((bit_cvt->bypass) && (in_port->is_shared == 1)) {
+    if (bit_cvt->in_place) {
         // This case bit conversion is do bypass
         out_load = in_load;
     }
     load_ret = esp_gmf_port_acquire_out(out_port, &out_load, samples_num ? bytes : in_load->buf_length, ESP_GMF_MAX_DELAY);
     ESP_GMF_PORT_ACQUIRE_OUT_CHECK(TAG, load_ret, out_len, { goto __bit_release;});
-    if (samples_num) {
+    if (samples_num && bit_cvt->bypass) {
+        // Identity conversion, the samples are only moved when the output is another buffer
+        if (out_load->buf != in_load->buf) {
+            memcpy(out_load->buf, in_load->buf, in_load->valid_size);
+        }
+    } else if (samples_num) {
         esp_ae_err_t ret = esp_ae_bit_cvt_process(bit_cvt->bit_hd, samples_num, (unsigned char *)in_load->buf, (unsigned char *)out_load->buf);
         ESP_GMF_RET_ON_ERROR(TAG, ret, {out_len = ESP_GMF_JOB_ERR_FAIL; goto __bit_release;}, "Bit conversion process error, ret: %d", ret);
     }
@@ -255,11 +279,14 @@ esp_gmf_err_t esp_gmf_bit_cvt_init(esp_ae_bit_cvt_cfg_t *config, esp_gmf_element
     ESP_GMF_ELEMENT_IN_PORT_ATTR_SET(el_cfg.out_attr, ESP_GMF_EL_PORT_CAP_SINGLE, 0, 0,
         ESP_GMF_PORT_TYPE_BLOCK | ESP_GMF_PORT_TYPE_BYTE, ESP_GMF_ELEMENT_PORT_DATA_SIZE_DEFAULT);
     el_cfg.dependency = true;
+    // Only the identity conversion runs on the input buffer, the declaration is updated on open
+    el_cfg.in_place.enable = config && (config->src_bits == config->dest_bits);
     ret = esp_gmf_audio_el_init(bit_cvt, &el_cfg);
     ESP_GMF_RET_ON_NOT_OK(TAG, ret, goto BIT_CVT_INIT_FAIL, "Failed to initialize bit conversion element");
     ESP_GMF_ELEMENT_GET(bit_cvt)->ops.open = esp_gmf_bit_cvt_open;
     ESP_GMF_ELEMENT_GET(bit_cvt)->ops.process = esp_gmf_bit_cvt_process;
     ESP_GMF_ELEMENT_GET(bit_cvt)->ops.close = esp_gmf_bit_cvt_close;
+    ESP_GMF_ELEMENT_GET(bit_cvt)->ops.reset = esp_gmf_bit_cvt_reset;
     ESP_GMF_ELEMENT_GET(bit_cvt)->ops.event_receiver = bit_cvt_received_event_handler;
     ESP_GMF_ELEMENT_GET(bit_cvt)->ops.load_caps = _load_bit_cvt_caps_func;
     ESP_GMF_ELEMENT_GET(bit_cvt)->ops.load_methods = _load_bit_cvt_methods_func;
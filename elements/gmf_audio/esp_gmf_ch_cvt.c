@@ -29,6 +29,7 @@ typedef struct {
                                                         True: Execute the close function first, then execute the open function
                                                         False: Do nothing */
     bool                    bypass : 1;            /*!< Whether bypass. True: need bypass. False: needn't bypass */
+    bool                    in_place : 1;          /*!< The bypassed conversion runs on the input buffer granted by the in-place plan */
 } esp_gmf_ch_cvt_t;
 
 static const char *TAG = "ESP_GMF_CH_CVT";
@@ -88,6 +89,10 @@ static esp_gmf_job_err_t esp_gmf_ch_cvt_open(esp_gmf_element_handle_t self, void
              ch_info->sample_rate, ch_info->bits_per_sample, ch_info->src_ch, ch_info->dest_ch);
     ch_cvt->need_reopen = false;
     ch_cvt->bypass = ch_info->src_ch == ch_info->dest_ch;
+    // The plan made on run follows the declaration, only the identity conversion is declared for the next plan
+    esp_gmf_element_t *el = ESP_GMF_ELEMENT_GET(self);
+    ch_cvt->in_place = ch_cvt->bypass && el->in_place.enable && el->in && el->in->is_shared;
+    el->in_place.enable = ch_cvt->bypass;
     return ESP_GMF_JOB_ERR_OK;
 }
 
@@ -102,6 +107,20 @@ static esp_gmf_job_err_t esp_gmf_ch_cvt_close(esp_gmf_element_handle_t self, voi
     return ESP_GMF_JOB_ERR_OK;
 }
 
+static esp_gmf_job_err_t esp_gmf_ch_cvt_reset(esp_gmf_element_handle_t self, void *para)
+{
+    // The conversion keeps no samples between the frames, reuse the handle unless the format is changed
+    esp_gmf_ch_cvt_t *ch_cvt = (esp_gmf_ch_cvt_t *)self;
+    if (ch_cvt->need_reopen || (ch_cvt->ch_hd == NULL)) {
+        esp_gmf_ch_cvt_close(self, NULL);
+        return esp_gmf_ch_cvt_open(self, NULL);
+    }
+    esp_ae_ch_cvt_cfg_t *ch_info = (esp_ae_ch_cvt_cfg_t *)OBJ_GET_CFG(self);
+    GMF_AUDIO_UPDATE_SND_INFO(self, ch_info->sample_rate, ch_info->bits_per_sample, ch_info->dest_ch);
+    ESP_LOGD(TAG, "Reset, %p", self);
+    return ESP_GMF_JOB_ERR_OK;
+}
+
 static esp_gmf_job_err_t esp_gmf_ch_cvt_process(esp_gmf_element_handle_t self, void *para)
 {
     esp_gmf_ch_cvt_t *ch_cvt = (esp_gmf_ch_cvt_t *)self;
@@ -128,13 +147,18 @@ static esp_gmf_job_err_t esp_gmf_ch_cvt_process(esp_gmf_element_handle_t self, v
         out_len = ESP_GMF_JOB_ERR_FAIL;
         goto __ch_release;
     }
-    if (ch_cvt->bypass && (in_port->is_shared == true)) {
+    if (ch_cvt->in_place) {
         // This case channel conversion is do bypass
         out_load = in_load;
     }
     load_ret = esp_gmf_port_acquire_out(out_port, &out_load, samples_num ? bytes : in_load->buf_length, ESP_GMF_MAX_DELAY);
     ESP_GMF_PORT_ACQUIRE_OUT_CHECK(TAG, load_ret, out_len, { goto __ch_release;});
-    if (samples_num) {
+    if (samples_num && ch_cvt->bypass) {
+        // Identity conversion, the samples are only moved when the output is another buffer
+        if (out_load->buf != in_load->buf) {
+            memcpy(out_load->buf, in_load->buf, in_load->valid_size);
+        }
+    } else if (samples_num) {
         esp_ae_err_t ret = esp_ae_ch_cvt_process(ch_cvt->ch_hd, samples_num, (unsigned char *)in_load->buf, (unsigned char *)out_load->buf);
         ESP_GMF_RET_ON_ERROR(TAG, ret, {out_len = ESP_GMF_JOB_ERR_FAIL; goto __ch_release;}, "Channel conversion process error, ret: %d", ret);
     }
@@ -279,11 +303,14 @@ esp_gmf_err_t esp_gmf_ch_cvt_init(esp_ae_ch_cvt_cfg_t *config, esp_gmf_element_h
     ESP_GMF_ELEMENT_IN_PORT_ATTR_SET(el_cfg.out_attr, ESP_GMF_EL_PORT_CAP_SINGLE, 0, 0,
         ESP_GMF_PORT_TYPE_BLOCK | ESP_GMF_PORT_TYPE_BYTE, ESP_GMF_ELEMENT_PORT_DATA_SIZE_DEFAULT);
     el_cfg.dependency = true;
+    // Only the identity conversion runs on the input buffer, the declaration is updated on open
+    el_cfg.in_place.enable = config && (config->src_ch == config->dest_ch);
     ret = esp_gmf_audio_el_init(ch_cvt, &el_cfg);
     ESP_GMF_RET_ON_NOT_OK(TAG, ret, goto CH_CVT_INIT_FAIL, "Failed to initialize channel conversion element");
     ESP_GMF_ELEMENT_GET(ch_cvt)->ops.open = esp_gmf_ch_cvt_open;
     ESP_GMF_ELEMENT_GET(ch_cvt)->ops.process = esp_gmf_ch_cvt_process;
     ESP_GMF_ELEMENT_GET(ch_cvt)->ops.close = esp_gmf_ch_cvt_close;
+    ESP_GMF_ELEMENT_GET(ch_cvt)->ops.reset = esp_gmf_ch_cvt_reset;
     ESP_GMF_ELEMENT_GET(ch_cvt)->ops.event_receiver = ch_cvt_received_event_handler;
     ESP_GMF_ELEMENT_GET(ch_cvt)->ops.load_caps = _load_channel_cvt_caps_func;
     ESP_GMF_ELEMENT_GET(ch_cvt)->ops.load_methods = _load_channel_cvt_methods_func;
@@ -0,0 +1,521 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <string.h>
+#include "esp_log.h"
+#include "esp_gmf_node.h"
+#include "esp_gmf_oal_mem.h"
+#include "esp_ae_bit_cvt.h"
+#include "esp_ae_ch_cvt.h"
+#include "esp_gmf_fmt_cvt.h"
+#include "gmf_audio_common.h"
+#include "esp_gmf_audio_methods_def.h"
+#include "esp_gmf_cap.h"
+#include "esp_gmf_caps_def.h"
+#include "esp_gmf_audio_element.h"
+
+/**
+ * @brief  Frames converted through all the stages at once, 256 frames of stereo 32 bits take 2 KB
+ */
+#define FMT_CVT_TILE_FRAMES  (256)
+
+/**
+ * @brief  Audio format conversion context in GMF
+ */
+typedef struct {
+    esp_gmf_audio_element_t   parent;                                 /*!< The GMF format cvt handle */
+    esp_ae_rate_cvt_handle_t  rate_hd;                                /*!< The audio effects rate cvt handle, NULL if not needed */
+    esp_ae_ch_cvt_handle_t    ch_hd;                                  /*!< The audio effects channel cvt handle, NULL if not needed or on the fast path */
+    esp_ae_bit_cvt_handle_t   bit_hd;                                 /*!< The audio effects bit cvt handle, NULL if not needed or on the fast path */
+    esp_gmf_info_sound_t      stage_fmt[GMF_AUDIO_CVT_MAX + 1];       /*!< Input format of each stage, followed by the output format */
+    uint8_t                   order[GMF_AUDIO_CVT_MAX];               /*!< Conversion of each stage */
+    uint8_t                   stage_cnt;                              /*!< Number of the stages */
+    uint8_t                  *tile[GMF_AUDIO_CVT_MAX - 1];            /*!< Buffers between the stages */
+    uint32_t                  rate_out_frames;                        /*!< Most frames out of the resampling for one tile */
+    uint32_t                  tile_out_frames;                        /*!< Most frames out of the last stage for one tile */
+    uint8_t                   in_bytes_per_frame;                     /*!< Source bytes number of per sampling point */
+    uint8_t                   out_bytes_per_frame;                    /*!< Dest bytes number of per sampling point */
+    bool                      need_reopen : 1;                        /*!< Whether need to reopen.
+                                                                           True: Execute the close function first, then execute the open function
+                                                                           False: Do nothing */
+    bool                      bypass : 1;                             /*!< Whether bypass. True: need bypass. False: needn't bypass */
+    bool                      in_place : 1;                           /*!< The bypassed conversion runs on the input buffer granted by the in-place plan */
+} esp_gmf_fmt_cvt_t;
+
+static const char *TAG = "ESP_GMF_FMT_CVT";
+
+static inline bool fmt_cvt_is_bit_fast(const esp_gmf_info_sound_t *in, uint8_t dest_bits)
+{
+    return ((in->bits == 16) && (dest_bits == 32)) || ((in->bits == 32) && (dest_bits == 16));
+}
+
+static inline bool fmt_cvt_is_ch_fast(const esp_gmf_info_sound_t *in, uint8_t dest_ch)
+{
+    return ((in->bits == 16) || (in->bits == 32))
+           && (((in->channels == 2) && (dest_ch == 1)) || ((in->channels == 1) && (dest_ch == 2)));
+}
+
+static void fmt_cvt_bit_fast(const uint8_t *src, uint8_t src_bits, uint8_t *dst, uint32_t samples)
+{
+    if (src_bits == 16) {
+        const int16_t *in = (const int16_t *)src;
+        int32_t *out = (int32_t *)dst;
+        for (uint32_t i = 0; i < samples; i++) {
+            out[i] = (int32_t)in[i] * 65536;
+        }
+        return;
+    }
+    // Round to the nearest and saturate the positive overflow of the rounding
+    const int32_t *in = (const int32_t *)src;
+    int16_t *out = (int16_t *)dst;
+    for (uint32_t i = 0; i < samples; i++) {
+        int32_t v = (in[i] >> 16) + ((in[i] >> 15) & 1);
+        out[i] = v > INT16_MAX ? INT16_MAX : (int16_t)v;
+    }
+}
+
+static void fmt_cvt_ch_fast(const uint8_t *src, uint8_t bits, uint8_t src_ch, uint8_t *dst, uint32_t frames)
+{
+    if (bits == 16) {
+        const int16_t *in = (const int16_t *)src;
+        int16_t *out = (int16_t *)dst;
+        if (src_ch == 2) {
+            for (uint32_t i = 0; i < frames; i++) {
+                out[i] = (int16_t)(((int32_t)in[2 * i] + in[2 * i + 1]) >> 1);
+            }
+        } else {
+            for (uint32_t i = 0; i < frames; i++) {
+                out[2 * i] = out[2 * i + 1] = in[i];
+            }
+        }
+        return;
+    }
+    const int32_t *in = (const int32_t *)src;
+    int32_t *out = (int32_t *)dst;
+    if (src_ch == 2) {
+        for (uint32_t i = 0; i < frames; i++) {
+            out[i] = (int32_t)(((int64_t)in[2 * i] + in[2 * i + 1]) >> 1);
+        }
+    } else {
+        for (uint32_t i = 0; i < frames; i++) {
+            out[2 * i] = out[2 * i + 1] = in[i];
+        }
+    }
+}
+
+static esp_ae_err_t fmt_cvt_run_stage(esp_gmf_fmt_cvt_t *fmt_cvt, int stage, uint8_t *src, uint32_t frames,
+                                      uint8_t *dst, uint32_t *out_frames)
+{
+    esp_gmf_info_sound_t *in = &fmt_cvt->stage_fmt[stage];
+    esp_gmf_info_sound_t *out = &fmt_cvt->stage_fmt[stage + 1];
+    if (fmt_cvt->order[stage] == GMF_AUDIO_CVT_RATE) {
+        *out_frames = fmt_cvt->rate_out_frames;
+        return esp_ae_rate_cvt_process(fmt_cvt->rate_hd, (unsigned char *)src, frames, (unsigned char *)dst, out_frames);
+    }
+    *out_frames = frames;
+    if (fmt_cvt->order[stage] == GMF_AUDIO_CVT_CH) {
+        if (fmt_cvt->ch_hd) {
+            return esp_ae_ch_cvt_process(fmt_cvt->ch_hd, frames, (unsigned char *)src, (unsigned char *)dst);
+        }
+        fmt_cvt_ch_fast(src, in->bits, in->channels, dst, frames);
+        return ESP_AE_ERR_OK;
+    }
+    if (fmt_cvt->bit_hd) {
+        return esp_ae_bit_cvt_process(fmt_cvt->bit_hd, frames, (unsigned char *)src, (unsigned char *)dst);
+    }
+    fmt_cvt_bit_fast(src, in->bits, dst, frames * out->channels);
+    return ESP_AE_ERR_OK;
+}
+
+static esp_gmf_err_t __fmt_cvt_set_dest_rate(esp_gmf_element_handle_t handle, esp_gmf_args_desc_t *arg_desc,
+                                             uint8_t *buf, int buf_len)
+{
+    ESP_GMF_NULL_CHECK(TAG, buf, {return ESP_GMF_ERR_INVALID_ARG;});
+    uint32_t dest_rate = *((uint32_t *)buf);
+    return esp_gmf_fmt_cvt_set_dest_rate(handle, dest_rate);
+}
+
+static esp_gmf_err_t __fmt_cvt_set_dest_ch(esp_gmf_element_handle_t handle, esp_gmf_args_desc_t *arg_desc,
+                                           uint8_t *buf, int buf_len)
+{
+    ESP_GMF_NULL_CHECK(TAG, buf, {return ESP_GMF_ERR_INVALID_ARG;});
+    uint8_t dest_ch = (uint8_t)(*buf);
+    return esp_gmf_fmt_cvt_set_dest_ch(handle, dest_ch);
+}
+
+static esp_gmf_err_t __fmt_cvt_set_dest_bits(esp_gmf_element_handle_t handle, esp_gmf_args_desc_t *arg_desc,
+                                             uint8_t *buf, int buf_len)
+{
+    ESP_GMF_NULL_CHECK(TAG, buf, {return ESP_GMF_ERR_INVALID_ARG;});
+    uint8_t dest_bits = (uint8_t)(*buf);
+    return esp_gmf_fmt_cvt_set_dest_bits(handle, dest_bits);
+}
+
+static esp_gmf_err_t esp_gmf_fmt_cvt_new(void *cfg, esp_gmf_obj_handle_t *handle)
+{
+    return esp_gmf_fmt_cvt_init(cfg, (esp_gmf_element_handle_t *)handle);
+}
+
+static esp_gmf_job_err_t esp_gmf_fmt_cvt_close(esp_gmf_element_handle_t self, void *para)
+{
+    esp_gmf_fmt_cvt_t *fmt_cvt = (esp_gmf_fmt_cvt_t *)self;
+    ESP_LOGD(TAG, "Closed, %p", self);
+    if (fmt_cvt->rate_hd != NULL) {
+        esp_ae_rate_cvt_close(fmt_cvt->rate_hd);
+        fmt_cvt->rate_hd = NULL;
+    }
+    if (fmt_cvt->ch_hd != NULL) {
+        esp_ae_ch_cvt_close(fmt_cvt->ch_hd);
+        fmt_cvt->ch_hd = NULL;
+    }
+    if (fmt_cvt->bit_hd != NULL) {
+        esp_ae_bit_cvt_close(fmt_cvt->bit_hd);
+        fmt_cvt->bit_hd = NULL;
+    }
+    for (int i = 0; i < GMF_AUDIO_CVT_MAX - 1; i++) {
+        if (fmt_cvt->tile[i] != NULL) {
+            esp_gmf_oal_free(fmt_cvt->tile[i]);
+            fmt_cvt->tile[i] = NULL;
+        }
+    }
+    return ESP_GMF_JOB_ERR_OK;
+}
+
+static esp_gmf_job_err_t esp_gmf_fmt_cvt_open(esp_gmf_element_handle_t self, void *para)
+{
+    esp_gmf_fmt_cvt_t *fmt_cvt = (esp_gmf_fmt_cvt_t *)self;
+    esp_gmf_fmt_cvt_cfg_t *cfg = (esp_gmf_fmt_cvt_cfg_t *)OBJ_GET_CFG(self);
+    ESP_GMF_NULL_CHECK(TAG, cfg, {return ESP_GMF_JOB_ERR_FAIL;});
+    esp_gmf_info_sound_t src = {.sample_rates = cfg->src_rate, .channels = cfg->src_ch, .bits = cfg->src_bits};
+    esp_gmf_info_sound_t dest = {.sample_rates = cfg->dest_rate, .channels = cfg->dest_ch, .bits = cfg->dest_bits};
+    fmt_cvt->stage_cnt = gmf_audio_plan_cvt(&src, &dest, fmt_cvt->order);
+    fmt_cvt->stage_fmt[0] = src;
+    uint32_t frames = FMT_CVT_TILE_FRAMES;
+    uint32_t tile_size = 0;
+    for (int i = 0; i < fmt_cvt->stage_cnt; i++) {
+        esp_gmf_info_sound_t *in = &fmt_cvt->stage_fmt[i];
+        esp_gmf_info_sound_t *out = &fmt_cvt->stage_fmt[i + 1];
+        *out = *in;
+        if (fmt_cvt->order[i] == GMF_AUDIO_CVT_RATE) {
+            out->sample_rates = dest.sample_rates;
+            esp_ae_rate_cvt_cfg_t rate_cfg = {
+                .src_rate = in->sample_rates,
+                .dest_rate = out->sample_rates,
+                .channel = in->channels,
+                .bits_per_sample = in->bits,
+                .complexity = cfg->complexity,
+                .perf_type = cfg->perf_type,
+            };
+            esp_ae_rate_cvt_open(&rate_cfg, &fmt_cvt->rate_hd);
+            ESP_GMF_CHECK(TAG, fmt_cvt->rate_hd, {goto __open_fail;}, "Failed to create rate conversion handle");
+            esp_ae_rate_cvt_get_max_out_sample_num(fmt_cvt->rate_hd, frames, &frames);
+            fmt_cvt->rate_out_frames = frames;
+        } else if (fmt_cvt->order[i] == GMF_AUDIO_CVT_CH) {
+            out->channels = dest.channels;
+            if (fmt_cvt_is_ch_fast(in, out->channels) == false) {
+                esp_ae_ch_cvt_cfg_t ch_cfg = {
+                    .sample_rate = in->sample_rates,
+                    .bits_per_sample = in->bits,
+                    .src_ch = in->channels,
+                    .dest_ch = out->channels,
+                };
+                esp_ae_ch_cvt_open(&ch_cfg, &fmt_cvt->ch_hd);
+                ESP_GMF_CHECK(TAG, fmt_cvt->ch_hd, {goto __open_fail;}, "Failed to create channel conversion handle");
+            }
+        } else {
+            out->bits = dest.bits;
+            if (fmt_cvt_is_bit_fast(in, out->bits) == false) {
+                esp_ae_bit_cvt_cfg_t bit_cfg = {
+                    .sample_rate = in->sample_rates,
+                    .channel = in->channels,
+                    .src_bits = in->bits,
+                    .dest_bits = out->bits,
+                };
+                esp_ae_bit_cvt_open(&bit_cfg, &fmt_cvt->bit_hd);
+                ESP_GMF_CHECK(TAG, fmt_cvt->bit_hd, {goto __open_fail;}, "Failed to create bit conversion handle");
+            }
+        }
+        uint32_t size = frames * out->channels * (out->bits >> 3);
+        tile_size = size > tile_size ? size : tile_size;
+    }
+    // The last stage writes to the output payload, only the stages before it need a tile
+    for (int i = 0; i < fmt_cvt->stage_cnt - 1; i++) {
+        fmt_cvt->tile[i] = esp_gmf_oal_malloc_align(4, tile_size);
+        ESP_GMF_MEM_VERIFY(TAG, fmt_cvt->tile[i], {goto __open_fail;}, "conversion tile", (int)tile_size);
+    }
+    fmt_cvt->tile_out_frames = frames;
+    fmt_cvt->in_bytes_per_frame = (src.bits >> 3) * src.channels;
+    fmt_cvt->out_bytes_per_frame = (dest.bits >> 3) * dest.channels;
+    GMF_AUDIO_UPDATE_SND_INFO(self, dest.sample_rates, dest.bits, dest.channels);
+    ESP_LOGD(TAG, "Open, stages: %d, rate: %d-%d, ch: %d-%d, bits: %d-%d", fmt_cvt->stage_cnt,
+             src.sample_rates, dest.sample_rates, src.channels, dest.channels, src.bits, dest.bits);
+    fmt_cvt->need_reopen = false;
+    fmt_cvt->bypass = (fmt_cvt->stage_cnt == 0);
+    // The plan made on run follows the declaration, only the identity conversion is declared for the next plan
+    esp_gmf_element_t *el = ESP_GMF_ELEMENT_GET(self);
+    fmt_cvt->in_place = fmt_cvt->bypass && el->in_place.enable && el->in && el->in->is_shared;
+    el->in_place.enable = fmt_cvt->bypass;
+    return ESP_GMF_JOB_ERR_OK;
+__open_fail:
+    esp_gmf_fmt_cvt_close(self, NULL);
+    return ESP_GMF_JOB_ERR_FAIL;
+}
+
+static esp_gmf_job_err_t esp_gmf_fmt_cvt_process(esp_gmf_element_handle_t self, void *para)
+{
+    esp_gmf_fmt_cvt_t *fmt_cvt = (esp_gmf_fmt_cvt_t *)self;
+    esp_gmf_job_err_t out_len = ESP_GMF_JOB_ERR_OK;
+    if (fmt_cvt->need_reopen) {
+        esp_gmf_fmt_cvt_close(self, NULL);
+        out_len = esp_gmf_fmt_cvt_open(self, NULL);
+        if (out_len != ESP_GMF_JOB_ERR_OK) {
+            ESP_LOGE(TAG, "fmt_cvt reopen failed");
+            return out_len;
+        }
+    }
+    esp_gmf_port_handle_t in_port = ESP_GMF_ELEMENT_GET(self)->in;
+    esp_gmf_port_handle_t out_port = ESP_GMF_ELEMENT_GET(self)->out;
+    esp_gmf_payload_t *in_load = NULL;
+    esp_gmf_payload_t *out_load = NULL;
+    uint32_t frames = ESP_GMF_ELEMENT_GET(fmt_cvt)->in_attr.data_size / fmt_cvt->in_bytes_per_frame;
+    int bytes = frames * fmt_cvt->in_bytes_per_frame;
+    esp_gmf_err_io_t load_ret = esp_gmf_port_acquire_in(in_port, &in_load, bytes, ESP_GMF_MAX_DELAY);
+    frames = in_load->valid_size / fmt_cvt->in_bytes_per_frame;
+    if ((fmt_cvt->in_bytes_per_frame * frames != in_load->valid_size) || (load_ret < ESP_GMF_IO_OK)) {
+        ESP_LOGE(TAG, "Invalid in load size %d, ret %d", in_load->valid_size, load_ret);
+        out_len = ESP_GMF_JOB_ERR_FAIL;
+        goto __fmt_release;
+    }
+    uint32_t tiles = (frames + FMT_CVT_TILE_FRAMES - 1) / FMT_CVT_TILE_FRAMES;
+    bytes = fmt_cvt->bypass ? in_load->valid_size : tiles * fmt_cvt->tile_out_frames * fmt_cvt->out_bytes_per_frame;
+    if (fmt_cvt->in_place) {
+        // This case format conversion is do bypass
+        out_load = in_load;
+    }
+    load_ret = esp_gmf_port_acquire_out(out_port, &out_load, frames ? bytes : in_load->buf_length, ESP_GMF_MAX_DELAY);
+    ESP_GMF_PORT_ACQUIRE_OUT_CHECK(TAG, load_ret, out_len, {goto __fmt_release;});
+    uint32_t out_frames = 0;
+    if (frames && fmt_cvt->bypass) {
+        // Identity conversion, the samples are only moved when the output is another buffer
+        if (out_load->buf != in_load->buf) {
+            memcpy(out_load->buf, in_load->buf, in_load->valid_size);
+        }
+        out_frames = frames;
+    }
+    // Each tile goes through all the stages while it is in the cache, the last stage writes to the output
+    for (uint32_t pos = 0; (pos < frames) && (fmt_cvt->bypass == false); pos += FMT_CVT_TILE_FRAMES) {
+        uint32_t n = (frames - pos) > FMT_CVT_TILE_FRAMES ? FMT_CVT_TILE_FRAMES : (frames - pos);
+        uint8_t *src = in_load->buf + pos * fmt_cvt->in_bytes_per_frame;
+        for (int i = 0; i < fmt_cvt->stage_cnt; i++) {
+            uint8_t *dst = (i == fmt_cvt->stage_cnt - 1) ? out_load->buf + out_frames * fmt_cvt->out_bytes_per_frame : fmt_cvt->tile[i];
+            esp_ae_err_t ret = fmt_cvt_run_stage(fmt_cvt, i, src, n, dst, &n);
+            ESP_GMF_RET_ON_ERROR(TAG, ret, {out_len = ESP_GMF_JOB_ERR_FAIL; goto __fmt_release;}, "Format conversion stage %d error, ret: %d", i, ret);
+            src = dst;
+        }
+        out_frames += n;
+    }
+    out_load->valid_size = out_frames * fmt_cvt->out_bytes_per_frame;
+    out_load->pts = in_load->pts;
+    out_load->is_done = in_load->is_done;
+    ESP_LOGV(TAG, "Frames: %ld-%ld, IN-PLD: %p-%p-%d-%d-%d, OUT-PLD: %p-%p-%d-%d-%d", frames, out_frames,
+             in_load, in_load->buf, in_load->valid_size, in_load->buf_length, in_load->is_done,
+             out_load, out_load->buf, out_load->valid_size, out_load->buf_length, out_load->is_done);
+    if (out_load->valid_size > 0) {
+        esp_gmf_audio_el_update_file_pos((esp_gmf_element_handle_t)self, out_load->valid_size);
+    }
+    if (in_load->is_done) {
+        out_len = ESP_GMF_JOB_ERR_DONE;
+        ESP_LOGD(TAG, "Format convert done, out len: %d", out_load->valid_size);
+    }
+__fmt_release:
+    // Release in and out port
+    if (out_load != NULL) {
+        load_ret = esp_gmf_port_release_out(out_port, out_load, ESP_GMF_MAX_DELAY);
+        if ((load_ret < ESP_GMF_IO_OK) && (load_ret != ESP_GMF_IO_ABORT)) {
+            ESP_LOGE(TAG, "OUT port release error, ret:%d", load_ret);
+            out_len = ESP_GMF_JOB_ERR_FAIL;
+        }
+    }
+    if (in_load != NULL) {
+        load_ret = esp_gmf_port_release_in(in_port, in_load, ESP_GMF_MAX_DELAY);
+        if ((load_ret < ESP_GMF_IO_OK) && (load_ret != ESP_GMF_IO_ABORT)) {
+            ESP_LOGE(TAG, "IN port release error, ret:%d", load_ret);
+            out_len = ESP_GMF_JOB_ERR_FAIL;
+        }
+    }
+    return out_len;
+}
+
+static esp_gmf_err_t fmt_cvt_received_event_handler(esp_gmf_event_pkt_t *evt, void *ctx)
+{
+    ESP_GMF_NULL_CHECK(TAG, ctx, {return ESP_GMF_ERR_INVALID_ARG;});
+    ESP_GMF_NULL_CHECK(TAG, evt, {return ESP_GMF_ERR_INVALID_ARG;});
+    if ((evt->type != ESP_GMF_EVT_TYPE_REPORT_INFO)
+        || (evt->sub != ESP_GMF_INFO_SOUND)
+        || (evt->payload == NULL)) {
+        return ESP_GMF_ERR_OK;
+    }
+    esp_gmf_element_handle_t self = (esp_gmf_element_handle_t)ctx;
+    esp_gmf_element_handle_t el = evt->from;
+    esp_gmf_event_state_t state = ESP_GMF_EVENT_STATE_NONE;
+    esp_gmf_element_get_state(self, &state);
+    esp_gmf_info_sound_t *info = (esp_gmf_info_sound_t *)evt->payload;
+    esp_gmf_fmt_cvt_cfg_t *config = (esp_gmf_fmt_cvt_cfg_t *)OBJ_GET_CFG(self);
+    ESP_GMF_NULL_CHECK(TAG, config, { return ESP_GMF_ERR_FAIL;});
+    esp_gmf_fmt_cvt_t *fmt_cvt = (esp_gmf_fmt_cvt_t *)self;
+    fmt_cvt->need_reopen = (config->src_rate != info->sample_rates) || (info->channels != config->src_ch) || (config->src_bits != info->bits);
+    config->src_rate = info->sample_rates;
+    config->src_ch = info->channels;
+    config->src_bits = info->bits;
+    ESP_LOGD(TAG, "RECV element info, from: %s-%p, next: %p, self: %s-%p, type: %x, state: %s, rate: %d, ch: %d, bits: %d",
+             OBJ_GET_TAG(el), el, esp_gmf_node_for_next((esp_gmf_node_t *)el), OBJ_GET_TAG(self), self, evt->type,
+             esp_gmf_event_get_state_str(state), info->sample_rates, info->channels, info->bits);
+    if (state == ESP_GMF_EVENT_STATE_NONE) {
+        esp_gmf_element_set_state(self, ESP_GMF_EVENT_STATE_INITIALIZED);
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+static esp_gmf_err_t esp_gmf_fmt_cvt_destroy(esp_gmf_element_handle_t self)
+{
+    esp_gmf_fmt_cvt_t *fmt_cvt = (esp_gmf_fmt_cvt_t *)self;
+    ESP_LOGD(TAG, "Destroyed, %p", self);
+    void *cfg = OBJ_GET_CFG(self);
+    if (cfg) {
+        esp_gmf_oal_free(cfg);
+    }
+    esp_gmf_audio_el_deinit(self);
+    esp_gmf_oal_free(fmt_cvt);
+    return ESP_GMF_ERR_OK;
+}
+
+static esp_gmf_err_t _load_fmt_cvt_caps_func(esp_gmf_element_handle_t handle)
+{
+    // The union of the capabilities of `rate_cvt`, `ch_cvt` and `bit_cvt`
+    const uint64_t fmt_caps[] = {
+        ESP_GMF_CAPS_AUDIO_RATE_CONVERT,
+        ESP_GMF_CAPS_AUDIO_CHANNEL_CONVERT,
+        ESP_GMF_CAPS_AUDIO_BIT_CONVERT,
+    };
+    esp_gmf_cap_t *caps = NULL;
+    for (int i = 0; i < sizeof(fmt_caps) / sizeof(fmt_caps[0]); i++) {
+        esp_gmf_cap_t cvt_caps = {0};
+        cvt_caps.cap_eightcc = fmt_caps[i];
+        cvt_caps.attr_fun = NULL;
+        int ret = esp_gmf_cap_append(&caps, &cvt_caps);
+        ESP_GMF_RET_ON_NOT_OK(TAG, ret, {esp_gmf_cap_destroy(caps); return ret;}, "Failed to create capability");
+    }
+    esp_gmf_element_t *el = (esp_gmf_element_t *)handle;
+    el->caps = caps;
+    return ESP_GMF_ERR_OK;
+}
+
+static esp_gmf_err_t _load_fmt_cvt_methods_func(esp_gmf_element_handle_t handle)
+{
+    esp_gmf_method_t *method = NULL;
+    esp_gmf_args_desc_t *set_args = NULL;
+    esp_gmf_err_t ret = esp_gmf_args_desc_append(&set_args, AMETHOD_ARG(RATE_CVT, SET_DEST_RATE, RATE),
+                                                 ESP_GMF_ARGS_TYPE_UINT32, sizeof(uint32_t), 0);
+    ESP_GMF_RET_ON_NOT_OK(TAG, ret, {return ret;}, "Failed to append RATE argument");
+    ret = esp_gmf_method_append(&method, AMETHOD(RATE_CVT, SET_DEST_RATE), __fmt_cvt_set_dest_rate, set_args);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, {return ret;}, "Failed to register %s method", AMETHOD(RATE_CVT, SET_DEST_RATE));
+
+    set_args = NULL;
+    ret = esp_gmf_args_desc_append(&set_args, AMETHOD_ARG(CH_CVT, SET_DEST_CH, CH), ESP_GMF_ARGS_TYPE_UINT8, sizeof(uint8_t), 0);
+    ESP_GMF_RET_ON_NOT_OK(TAG, ret, {return ret;}, "Failed to append CH argument");
+    ret = esp_gmf_method_append(&method, AMETHOD(CH_CVT, SET_DEST_CH), __fmt_cvt_set_dest_ch, set_args);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, {return ret;}, "Failed to register %s method", AMETHOD(CH_CVT, SET_DEST_CH));
+
+    set_args = NULL;
+    ret = esp_gmf_args_desc_append(&set_args, AMETHOD_ARG(BIT_CVT, SET_DEST_BITS, BITS), ESP_GMF_ARGS_TYPE_UINT8, sizeof(uint8_t), 0);
+    ESP_GMF_RET_ON_NOT_OK(TAG, ret, {return ret;}, "Failed to append BITS argument");
+    ret = esp_gmf_method_append(&method, AMETHOD(BIT_CVT, SET_DEST_BITS), __fmt_cvt_set_dest_bits, set_args);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, {return ret;}, "Failed to register %s method", AMETHOD(BIT_CVT, SET_DEST_BITS));
+
+    esp_gmf_element_t *el = (esp_gmf_element_t *)handle;
+    el->method = method;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_fmt_cvt_set_dest_rate(esp_gmf_element_handle_t handle, uint32_t dest_rate)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, { return ESP_GMF_ERR_INVALID_ARG;});
+    esp_gmf_fmt_cvt_cfg_t *cfg = (esp_gmf_fmt_cvt_cfg_t *)OBJ_GET_CFG(handle);
+    ESP_GMF_NULL_CHECK(TAG, cfg, { return ESP_GMF_ERR_FAIL;});
+    if (cfg->dest_rate != dest_rate) {
+        cfg->dest_rate = dest_rate;
+        ((esp_gmf_fmt_cvt_t *)handle)->need_reopen = true;
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_fmt_cvt_set_dest_ch(esp_gmf_element_handle_t handle, uint8_t dest_ch)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, { return ESP_GMF_ERR_INVALID_ARG;});
+    esp_gmf_fmt_cvt_cfg_t *cfg = (esp_gmf_fmt_cvt_cfg_t *)OBJ_GET_CFG(handle);
+    ESP_GMF_NULL_CHECK(TAG, cfg, { return ESP_GMF_ERR_FAIL;});
+    if (cfg->dest_ch != dest_ch) {
+        cfg->dest_ch = dest_ch;
+        ((esp_gmf_fmt_cvt_t *)handle)->need_reopen = true;
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_fmt_cvt_set_dest_bits(esp_gmf_element_handle_t handle, uint8_t dest_bits)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, { return ESP_GMF_ERR_INVALID_ARG;});
+    esp_gmf_fmt_cvt_cfg_t *cfg = (esp_gmf_fmt_cvt_cfg_t *)OBJ_GET_CFG(handle);
+    ESP_GMF_NULL_CHECK(TAG, cfg, { return ESP_GMF_ERR_FAIL;});
+    if (cfg->dest_bits != dest_bits) {
+        cfg->dest_bits = dest_bits;
+        ((esp_gmf_fmt_cvt_t *)handle)->need_reopen = true;
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_fmt_cvt_init(esp_gmf_fmt_cvt_cfg_t *config, esp_gmf_element_handle_t *handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, {return ESP_GMF_ERR_INVALID_ARG;});
+    *handle = NULL;
+    esp_gmf_err_t ret = ESP_GMF_ERR_OK;
+    esp_gmf_fmt_cvt_t *fmt_cvt = esp_gmf_oal_calloc(1, sizeof(esp_gmf_fmt_cvt_t));
+    ESP_GMF_MEM_VERIFY(TAG, fmt_cvt, {return ESP_GMF_ERR_MEMORY_LACK;}, "format conversion", sizeof(esp_gmf_fmt_cvt_t));
+    esp_gmf_obj_t *obj = (esp_gmf_obj_t *)fmt_cvt;
+    obj->new_obj = esp_gmf_fmt_cvt_new;
+    obj->del_obj = esp_gmf_fmt_cvt_destroy;
+    if (config) {
+        esp_gmf_fmt_cvt_cfg_t *cfg = esp_gmf_oal_calloc(1, sizeof(*config));
+        ESP_GMF_MEM_VERIFY(TAG, cfg, {ret = ESP_GMF_ERR_MEMORY_LACK; goto FMT_CVT_INIT_FAIL;}, "format conversion configuration", sizeof(*config));
+        memcpy(cfg, config, sizeof(*config));
+        esp_gmf_obj_set_config(obj, cfg, sizeof(*config));
+    }
+    ret = esp_gmf_obj_set_tag(obj, "fmt_cvt");
+    ESP_GMF_RET_ON_NOT_OK(TAG, ret, goto FMT_CVT_INIT_FAIL, "Failed to set obj tag");
+    esp_gmf_element_cfg_t el_cfg = {0};
+    ESP_GMF_ELEMENT_IN_PORT_ATTR_SET(el_cfg.in_attr, ESP_GMF_EL_PORT_CAP_SINGLE, 0, 0,
+        ESP_GMF_PORT_TYPE_BLOCK | ESP_GMF_PORT_TYPE_BYTE, ESP_GMF_ELEMENT_PORT_DATA_SIZE_DEFAULT);
+    ESP_GMF_ELEMENT_IN_PORT_ATTR_SET(el_cfg.out_attr, ESP_GMF_EL_PORT_CAP_SINGLE, 0, 0,
+        ESP_GMF_PORT_TYPE_BLOCK | ESP_GMF_PORT_TYPE_BYTE, ESP_GMF_ELEMENT_PORT_DATA_SIZE_DEFAULT);
+    el_cfg.dependency = true;
+    // Only the identity conversion runs on the input buffer, the declaration is updated on open
+    el_cfg.in_place.enable = config && (config->src_rate == config->dest_rate) && (config->src_ch == config->dest_ch)
+                             && (config->src_bits == config->dest_bits);
+    ret = esp_gmf_audio_el_init(fmt_cvt, &el_cfg);
+    ESP_GMF_RET_ON_NOT_OK(TAG, ret, goto FMT_CVT_INIT_FAIL, "Failed to initialize format conversion element");
+    ESP_GMF_ELEMENT_GET(fmt_cvt)->ops.open = esp_gmf_fmt_cvt_open;
+    ESP_GMF_ELEMENT_GET(fmt_cvt)->ops.process = esp_gmf_fmt_cvt_process;
+    ESP_GMF_ELEMENT_GET(fmt_cvt)->ops.close = esp_gmf_fmt_cvt_close;
+    ESP_GMF_ELEMENT_GET(fmt_cvt)->ops.event_receiver = fmt_cvt_received_event_handler;
+    ESP_GMF_ELEMENT_GET(fmt_cvt)->ops.load_caps = _load_fmt_cvt_caps_func;
+    ESP_GMF_ELEMENT_GET(fmt_cvt)->ops.load_methods = _load_fmt_cvt_methods_func;
+    *handle = obj;
+    ESP_LOGD(TAG, "Initialization, %s-%p", OBJ_GET_TAG(obj), obj);
+    return ESP_GMF_ERR_OK;
+FMT_CVT_INIT_FAIL:
+    esp_gmf_fmt_cvt_destroy(obj);
+    return ret;
+}
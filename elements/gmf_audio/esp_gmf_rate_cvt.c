@@ -28,6 +28,7 @@ typedef struct {
                                                      True: Execute the close function first, then execute the open function
                                                      False: Do nothing */
     bool                     bypass : 1;        /*!< Whether bypass. True: need bypass. False: needn't bypass */
+    bool                     in_place : 1;      /*!< The bypassed conversion runs on the input buffer granted by the in-place plan */
 } esp_gmf_rate_cvt_t;
 
 static const char *TAG = "ESP_GMF_RATE_CVT";
@@ -58,6 +59,10 @@ static esp_gmf_job_err_t esp_gmf_rate_cvt_open(esp_gmf_element_handle_t self, vo
              rate_info->src_rate, rate_info->dest_rate, rate_info->channel, rate_info->bits_per_sample);
     rate_cvt->need_reopen = false;
     rate_cvt->bypass = rate_info->src_rate == rate_info->dest_rate;
+    // The plan made on run follows the declaration, only the identity conversion is declared for the next plan
+    esp_gmf_element_t *el = ESP_GMF_ELEMENT_GET(self);
+    rate_cvt->in_place = rate_cvt->bypass && el->in_place.enable && el->in && el->in->is_shared;
+    el->in_place.enable = rate_cvt->bypass;
     return ESP_GMF_JOB_ERR_OK;
 }
 
@@ -100,18 +105,25 @@ static esp_gmf_job_err_t esp_gmf_rate_cvt_process(esp_gmf_element_handle_t self,
         goto __rate_release;
     }
     uint32_t out_samples_num = 0;
-    if (samples_num) {
+    if (samples_num && rate_cvt->bypass) {
+        out_samples_num = samples_num;
+    } else if (samples_num) {
         ret = esp_ae_rate_cvt_get_max_out_sample_num(rate_cvt->rate_hd, samples_num, &out_samples_num);
         ESP_GMF_RET_ON_ERROR(TAG, ret, {out_len = ESP_GMF_JOB_ERR_FAIL; goto __rate_release;}, "Failed to get resample out size, ret: %d", ret);
     }
     int acq_out_size = out_samples_num == 0 ? in_load->buf_length : out_samples_num * rate_cvt->bytes_per_sample;
-    if (rate_cvt->bypass && (in_port->is_shared == true)) {
+    if (rate_cvt->in_place) {
         // This case rate conversion is do bypass
         out_load = in_load;
     }
     load_ret = esp_gmf_port_acquire_out(out_port, &out_load, acq_out_size, ESP_GMF_MAX_DELAY);
     ESP_GMF_PORT_ACQUIRE_OUT_CHECK(TAG, load_ret, out_len, {goto __rate_release;});
-    if (samples_num) {
+    if (samples_num && rate_cvt->bypass) {
+        // Identity conversion, the samples are only moved when the output is another buffer
+        if (out_load->buf != in_load->buf) {
+            memcpy(out_load->buf, in_load->buf, in_load->valid_size);
+        }
+    } else if (samples_num) {
         ret = esp_ae_rate_cvt_process(rate_cvt->rate_hd, (unsigned char *)in_load->buf, samples_num,
                                       (unsigned char *)out_load->buf, &out_samples_num);
         ESP_GMF_RET_ON_ERROR(TAG, ret, {out_len = ESP_GMF_JOB_ERR_FAIL; goto __rate_release;}, "Rate conversion process error, ret: %d", ret);
@@ -257,6 +269,8 @@ esp_gmf_err_t esp_gmf_rate_cvt_init(esp_ae_rate_cvt_cfg_t *config, esp_gmf_eleme
     ESP_GMF_ELEMENT_IN_PORT_ATTR_SET(el_cfg.out_attr, ESP_GMF_EL_PORT_CAP_SINGLE, 0, 0,
         ESP_GMF_PORT_TYPE_BLOCK | ESP_GMF_PORT_TYPE_BYTE, ESP_GMF_ELEMENT_PORT_DATA_SIZE_DEFAULT);
     el_cfg.dependency = true;
+    // Only the identity conversion runs on the input buffer, the declaration is updated on open
+    el_cfg.in_place.enable = config && (config->src_rate == config->dest_rate);
     ret = esp_gmf_audio_el_init(rate_cvt, &el_cfg);
     ESP_GMF_RET_ON_NOT_OK(TAG, ret, goto RATE_CVT_INIT_FAIL, "Failed to initialize rate conversion element");
     ESP_GMF_ELEMENT_GET(rate_cvt)->ops.open = esp_gmf_rate_cvt_open;
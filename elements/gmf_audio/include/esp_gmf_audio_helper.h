@@ -8,6 +8,8 @@
 #pragma once
 
 #include "esp_gmf_err.h"
+#include "esp_gmf_info.h"
+#include "esp_gmf_pipeline.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,6 +27,47 @@ extern "C" {
  */
 esp_gmf_err_t esp_gmf_audio_helper_get_audio_type_by_uri(const char *uri, uint32_t *format_id);
 
+/**
+ * @brief  Maximum number of the audio converters planned by `esp_gmf_audio_helper_plan_cvt`
+ */
+#define ESP_GMF_AUDIO_HELPER_CVT_MAX  (3)
+
+/**
+ * @brief  Plan the audio converters needed to turn the source sound format into the destination one
+ *         Only the converters of the differing parameters are listed, `rate_cvt`, `ch_cvt` or `bit_cvt`,
+ *         in the order with the lowest estimated cost. Each converter is costed by the samples it handles,
+ *         so a downmix or a bit reduction goes before the resampling and an upmix or a bit extension goes after it
+ *
+ * @note  The names can be put into the element list of `esp_gmf_pool_new_pipeline`, an empty list means no conversion.
+ *        The destination of the converters is then set by `esp_gmf_audio_helper_set_cvt_dest`
+ *
+ * @param[in]   src       Source sound information
+ * @param[in]   dest      Destination sound information
+ * @param[out]  el_names  Array to store the tags of the converters in the processing order
+ * @param[out]  el_cnt    Pointer to store the number of the converters
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_audio_helper_plan_cvt(const esp_gmf_info_sound_t *src, const esp_gmf_info_sound_t *dest,
+                                            const char *el_names[ESP_GMF_AUDIO_HELPER_CVT_MAX], uint8_t *el_cnt);
+
+/**
+ * @brief  Set the destination sound format to all the audio converters of a pipeline
+ *         The converters are found by their rate, channel and bit conversion capabilities,
+ *         a converter whose source format already matches is bypassed at runtime
+ *
+ * @param[in]  pipeline  GMF pipeline handle
+ * @param[in]  dest      Destination sound information
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - Others                   Failed to set the destination of a converter
+ */
+esp_gmf_err_t esp_gmf_audio_helper_set_cvt_dest(esp_gmf_pipeline_handle_t pipeline, const esp_gmf_info_sound_t *dest);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
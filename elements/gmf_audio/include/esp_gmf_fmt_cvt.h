@@ -0,0 +1,103 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "esp_gmf_err.h"
+#include "esp_ae_rate_cvt.h"
+#include "esp_gmf_element.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @brief  Configuration of the GMF audio format conversion
+ *         The source format is updated by the sound information reported from the previous element
+ */
+typedef struct {
+    uint32_t                     src_rate;    /*!< Source sample rate */
+    uint8_t                      src_ch;      /*!< Source channel number */
+    uint8_t                      src_bits;    /*!< Source bits per sample, supports unsigned 8 bits and signed 16, 24, 32 bits */
+    uint32_t                     dest_rate;   /*!< Destination sample rate */
+    uint8_t                      dest_ch;     /*!< Destination channel number */
+    uint8_t                      dest_bits;   /*!< Destination bits per sample, supports unsigned 8 bits and signed 16, 24, 32 bits */
+    uint8_t                      complexity;  /*!< Complexity of the resampling, refer to `esp_ae_rate_cvt_cfg_t` */
+    esp_ae_rate_cvt_perf_type_t  perf_type;   /*!< Performance type of the resampling, refer to `esp_ae_rate_cvt_cfg_t` */
+} esp_gmf_fmt_cvt_cfg_t;
+
+#define DEFAULT_ESP_GMF_FMT_CVT_CONFIG() {               \
+    .src_rate   = 44100,                                 \
+    .src_ch     = 2,                                     \
+    .src_bits   = 16,                                    \
+    .dest_rate  = 48000,                                 \
+    .dest_ch    = 2,                                     \
+    .dest_bits  = 16,                                    \
+    .complexity = 2,                                     \
+    .perf_type  = ESP_AE_RATE_CVT_PERF_TYPE_SPEED,       \
+}
+
+/**
+ * @brief  Initializes the GMF audio format conversion with the provided configuration
+ *
+ *         The element converts the bit depth, the channel number and the sample rate in one pass, as `bit_cvt`,
+ *         `ch_cvt` and `rate_cvt` in a row but with one port acquire and release. The input is converted in tiles of
+ *         a few hundred samples, each tile goes through all the needed conversions in the cheapest order while it stays
+ *         in the cache. It has the capabilities and the methods of the three converters, so it can replace them
+ *
+ * @param[in]   config  Pointer to the format conversion configuration
+ * @param[out]  handle  Pointer to the format conversion handle to be initialized
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid configuration provided
+ *       - ESP_GMF_ERR_MEMORY_LACK  Failed to allocate memory
+ */
+esp_gmf_err_t esp_gmf_fmt_cvt_init(esp_gmf_fmt_cvt_cfg_t *config, esp_gmf_element_handle_t *handle);
+
+/**
+ * @brief  Set the destination sample rate of the format conversion
+ *
+ * @param[in]  handle     The format conversion handle
+ * @param[in]  dest_rate  The destination sample rate
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Operation succeeded
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid input parameter
+ *       - ESP_GMF_ERR_FAIL         Failed to set configuration
+ */
+esp_gmf_err_t esp_gmf_fmt_cvt_set_dest_rate(esp_gmf_element_handle_t handle, uint32_t dest_rate);
+
+/**
+ * @brief  Set the destination channel number of the format conversion
+ *
+ * @param[in]  handle   The format conversion handle
+ * @param[in]  dest_ch  The destination channel number
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Operation succeeded
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid input parameter
+ *       - ESP_GMF_ERR_FAIL         Failed to set configuration
+ */
+esp_gmf_err_t esp_gmf_fmt_cvt_set_dest_ch(esp_gmf_element_handle_t handle, uint8_t dest_ch);
+
+/**
+ * @brief  Set the destination bits per sample of the format conversion
+ *
+ * @param[in]  handle     The format conversion handle
+ * @param[in]  dest_bits  The destination bits per sample
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Operation succeeded
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid input parameter
+ *       - ESP_GMF_ERR_FAIL         Failed to set configuration
+ */
+esp_gmf_err_t esp_gmf_fmt_cvt_set_dest_bits(esp_gmf_element_handle_t handle, uint8_t dest_bits);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
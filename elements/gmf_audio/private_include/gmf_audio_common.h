@@ -30,6 +30,28 @@ static inline void gmf_audio_update_snd_info(void *self, uint32_t sample_rate, u
 
 #define GMF_AUDIO_INPUT_SAMPLE_NUM (256)
 
+/**
+ * @brief  Audio conversions handled by `rate_cvt`, `ch_cvt` and `bit_cvt`
+ */
+typedef enum {
+    GMF_AUDIO_CVT_RATE = 0,  /*!< Sample rate conversion */
+    GMF_AUDIO_CVT_CH   = 1,  /*!< Channel conversion */
+    GMF_AUDIO_CVT_BIT  = 2,  /*!< Bit depth conversion */
+    GMF_AUDIO_CVT_MAX  = 3,  /*!< Number of the conversions */
+} gmf_audio_cvt_type_t;
+
+/**
+ * @brief  Plan the conversions needed from the source sound format to the destination one in the cheapest order
+ *
+ * @param[in]   src    Source sound information
+ * @param[in]   dest   Destination sound information
+ * @param[out]  order  Array to store the conversions in the processing order
+ *
+ * @return
+ *       - Number of the conversions stored in `order`
+ */
+uint8_t gmf_audio_plan_cvt(const esp_gmf_info_sound_t *src, const esp_gmf_info_sound_t *dest, uint8_t order[GMF_AUDIO_CVT_MAX]);
+
 #ifdef __cplusplus
 }
 #endif  /* __cplusplus */
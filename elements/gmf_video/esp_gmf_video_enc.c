@@ -182,6 +182,10 @@ static esp_gmf_job_err_t venc_el_process(esp_gmf_video_element_handle_t self, vo
     }
     do {
         if (venc->venc_bypass) {
+            // Each MJPEG frame passed through is a key frame too
+            if (venc->dst_codec == ESP_FOURCC_MJPG) {
+                out_load->meta_flag |= ESP_GMF_META_FLAG_VID_KEY_FRAME;
+            }
             break;
         }
         esp_video_enc_in_frame_t in_frame = {
@@ -208,6 +212,14 @@ static esp_gmf_job_err_t venc_el_process(esp_gmf_video_element_handle_t self, vo
         }
         out_load->pts = in_load->pts;
         out_load->valid_size = out_frame.encoded_size;
+        // Mark the frames decodable alone, e.g. for the data bus dropping until the next key frame:
+        // every MJPEG frame, and the I and IDR frames of H.264
+        if ((venc->dst_codec == ESP_FOURCC_MJPG) || (out_frame.frame_type == ESP_VIDEO_CODEC_FRAME_TYPE_IDR)
+            || (out_frame.frame_type == ESP_VIDEO_CODEC_FRAME_TYPE_I)) {
+            out_load->meta_flag |= ESP_GMF_META_FLAG_VID_KEY_FRAME;
+        } else {
+            out_load->meta_flag &= ~ESP_GMF_META_FLAG_VID_KEY_FRAME;
+        }
         ret = out_load->valid_size;
     } while (0);
     esp_gmf_port_release_in(in, in_load, 0);
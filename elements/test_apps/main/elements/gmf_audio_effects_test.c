@@ -5,6 +5,7 @@
  */
 #include "unity.h"
 #include <string.h>
+#include <inttypes.h>
 #include "esp_err.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/event_groups.h"
@@ -27,6 +28,7 @@
 #include "esp_gmf_fade.h"
 #include "esp_gmf_mixer.h"
 #include "esp_gmf_rate_cvt.h"
+#include "esp_gmf_fmt_cvt.h"
 #include "esp_gmf_sonic.h"
 #include "esp_gmf_interleave.h"
 #include "esp_gmf_deinterleave.h"
@@ -44,6 +46,9 @@
 #include "esp_gmf_audio_methods_def.h"
 #include "esp_gmf_method.h"
 #include "esp_gmf_audio_param.h"
+#include "esp_gmf_audio_element.h"
+#include "esp_gmf_cap.h"
+#include "esp_gmf_caps_def.h"
 #include "gmf_audio_play_com.h"
 
 #ifdef MEDIA_LIB_MEM_TEST
@@ -374,6 +379,337 @@ TEST_CASE("AUDIO EFFECTS PARAMETER TEST", "[ESP_GMF_Effects]")
     esp_gmf_obj_delete(rate_hd);
 }
 
+TEST_CASE("Audio converters planned by the sound format", "[ESP_GMF_Effects]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    ESP_GMF_MEM_SHOW(TAG);
+    const char *name[ESP_GMF_AUDIO_HELPER_CVT_MAX] = {NULL};
+    uint8_t cnt = 0;
+    esp_gmf_info_sound_t src = {.sample_rates = 48000, .channels = 2, .bits = 16};
+    esp_gmf_info_sound_t dest = src;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_ARG, esp_gmf_audio_helper_plan_cvt(NULL, &dest, name, &cnt));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_audio_helper_plan_cvt(&src, &dest, name, &cnt));
+    TEST_ASSERT_EQUAL(0, cnt);
+
+    // Downmix and bit reduction run before the resampling
+    dest.sample_rates = 16000;
+    dest.channels = 1;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_audio_helper_plan_cvt(&src, &dest, name, &cnt));
+    TEST_ASSERT_EQUAL(2, cnt);
+    TEST_ASSERT_EQUAL_STRING("ch_cvt", name[0]);
+    TEST_ASSERT_EQUAL_STRING("rate_cvt", name[1]);
+    // Upmix and bit extension run after the resampling
+    esp_gmf_info_sound_t wide = {.sample_rates = 44100, .channels = 2, .bits = 32};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_audio_helper_plan_cvt(&dest, &wide, name, &cnt));
+    TEST_ASSERT_EQUAL(3, cnt);
+    TEST_ASSERT_EQUAL_STRING("rate_cvt", name[0]);
+    TEST_ASSERT_EQUAL_STRING("ch_cvt", name[1]);
+    TEST_ASSERT_EQUAL_STRING("bit_cvt", name[2]);
+
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    gmf_register_audio_all(pool);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_audio_helper_plan_cvt(&src, &dest, name, &cnt));
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_new_pipeline(pool, NULL, name, cnt, NULL, &pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_audio_helper_set_cvt_dest(pipe, &dest));
+    esp_gmf_element_handle_t el = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_el_by_name(pipe, "ch_cvt", &el));
+    TEST_ASSERT_EQUAL(1, ((esp_ae_ch_cvt_cfg_t *)OBJ_GET_CFG(el))->dest_ch);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_el_by_name(pipe, "rate_cvt", &el));
+    TEST_ASSERT_EQUAL(16000, ((esp_ae_rate_cvt_cfg_t *)OBJ_GET_CFG(el))->dest_rate);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_pipeline_get_el_by_name(pipe, "bit_cvt", &el));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+    gmf_unregister_audio_all(pool);
+    esp_gmf_pool_deinit(pool);
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+/**
+ * @brief  Stream of PCM samples feeding or taken from a converter under test
+ */
+typedef struct {
+    uint8_t  *buf;
+    uint32_t  size;
+    uint32_t  pos;
+} cvt_test_stream_t;
+
+#define CVT_TEST_FRAMES (1920)
+
+static esp_gmf_err_io_t cvt_stream_acquire_read(void *handle, esp_gmf_data_bus_block_t *blk, int wanted_size, int block_ticks)
+{
+    cvt_test_stream_t *stream = (cvt_test_stream_t *)handle;
+    uint32_t size = stream->size - stream->pos;
+    size = size < wanted_size ? size : wanted_size;
+    if (blk->buf == NULL) {
+        return ESP_GMF_IO_FAIL;
+    }
+    memcpy(blk->buf, stream->buf + stream->pos, size);
+    blk->valid_size = size;
+    stream->pos += size;
+    blk->is_last = (stream->pos == stream->size);
+    return ESP_GMF_IO_OK;
+}
+
+static esp_gmf_err_io_t cvt_stream_release_read(void *handle, esp_gmf_data_bus_block_t *blk, int block_ticks)
+{
+    return ESP_GMF_IO_OK;
+}
+
+static esp_gmf_err_io_t cvt_stream_acquire_write(void *handle, esp_gmf_data_bus_block_t *blk, int wanted_size, int block_ticks)
+{
+    return ESP_GMF_IO_OK;
+}
+
+static esp_gmf_err_io_t cvt_stream_release_write(void *handle, esp_gmf_data_bus_block_t *blk, int block_ticks)
+{
+    cvt_test_stream_t *stream = (cvt_test_stream_t *)handle;
+    if (stream->pos + blk->valid_size > stream->size) {
+        ESP_LOGE(TAG, "Converted data overflows, pos: %" PRIu32 ", size: %d", stream->pos, (int)blk->valid_size);
+        return ESP_GMF_IO_FAIL;
+    }
+    memcpy(stream->buf + stream->pos, blk->buf, blk->valid_size);
+    stream->pos += blk->valid_size;
+    return ESP_GMF_IO_OK;
+}
+
+static void cvt_test_bind(esp_gmf_element_handle_t el, cvt_test_stream_t *in, cvt_test_stream_t *out)
+{
+    esp_gmf_port_handle_t in_port = NEW_ESP_GMF_PORT_IN_BYTE(cvt_stream_acquire_read, cvt_stream_release_read, NULL, in,
+                                                             ESP_GMF_PORT_PAYLOAD_LEN_DEFAULT, ESP_GMF_MAX_DELAY);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_element_register_in_port(el, in_port));
+    esp_gmf_port_handle_t out_port = NEW_ESP_GMF_PORT_OUT_BYTE(cvt_stream_acquire_write, cvt_stream_release_write, NULL, out,
+                                                               ESP_GMF_PORT_PAYLOAD_LEN_DEFAULT, ESP_GMF_MAX_DELAY);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_element_register_out_port(el, out_port));
+}
+
+static void cvt_test_drain(esp_gmf_element_handle_t el)
+{
+    esp_gmf_job_err_t ret = ESP_GMF_JOB_ERR_OK;
+    for (int i = 0; (i < 1000) && (ret == ESP_GMF_JOB_ERR_OK); i++) {
+        ret = esp_gmf_element_process_running(el, NULL);
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_JOB_ERR_DONE, ret);
+}
+
+static uint32_t cvt_test_run(esp_gmf_element_handle_t el, cvt_test_stream_t *in, cvt_test_stream_t *out)
+{
+    in->pos = 0;
+    out->pos = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_JOB_ERR_OK, esp_gmf_element_process_open(el, NULL));
+    cvt_test_drain(el);
+    esp_gmf_element_process_close(el, NULL);
+    return out->pos;
+}
+
+static inline int64_t cvt_test_floor_div(int64_t a, int64_t b)
+{
+    return (a >= 0) ? (a / b) : -((-a + b - 1) / b);
+}
+
+static inline int32_t cvt_test_triangle(uint32_t i, uint32_t period, int32_t amp)
+{
+    int64_t phase = i % period;
+    int64_t v = (phase < period / 2) ? (-amp + 4 * amp * phase / period) : (3 * (int64_t)amp - 4 * amp * phase / period);
+    return (int32_t)v;
+}
+
+TEST_CASE("Audio format conversion in one pass", "[ESP_GMF_Effects]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    ESP_GMF_MEM_SHOW(TAG);
+    // Stereo 32 bits input, all the buffers hold it at most
+    uint32_t in_size = CVT_TEST_FRAMES * 2 * sizeof(int32_t);
+    int32_t *src = esp_gmf_oal_calloc(1, in_size);
+    uint8_t *fmt_out = esp_gmf_oal_calloc(1, in_size);
+    uint8_t *tmp[2] = {esp_gmf_oal_calloc(1, in_size), esp_gmf_oal_calloc(1, in_size)};
+    uint8_t *chain_out = esp_gmf_oal_calloc(1, in_size);
+    TEST_ASSERT_NOT_NULL(src);
+    TEST_ASSERT_NOT_NULL(fmt_out);
+    TEST_ASSERT_NOT_NULL(tmp[0]);
+    TEST_ASSERT_NOT_NULL(tmp[1]);
+    TEST_ASSERT_NOT_NULL(chain_out);
+    cvt_test_stream_t src_stream = {.buf = (uint8_t *)src, .size = in_size};
+    cvt_test_stream_t fmt_stream = {.buf = fmt_out, .size = in_size};
+    cvt_test_stream_t tmp_stream[2] = {{.buf = tmp[0], .size = in_size}, {.buf = tmp[1], .size = in_size}};
+    cvt_test_stream_t chain_stream = {.buf = chain_out, .size = in_size};
+
+    esp_gmf_fmt_cvt_cfg_t fmt_cvt_cfg = DEFAULT_ESP_GMF_FMT_CVT_CONFIG();
+    fmt_cvt_cfg.src_rate = 48000;
+    fmt_cvt_cfg.src_ch = 2;
+    fmt_cvt_cfg.src_bits = 32;
+    esp_gmf_element_handle_t fmt_hd = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fmt_cvt_init(&fmt_cvt_cfg, &fmt_hd));
+    cvt_test_bind(fmt_hd, &src_stream, &fmt_stream);
+
+    // It has the capabilities and the methods of the rate, channel and bit converters
+    const esp_gmf_cap_t *caps = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_element_get_caps(fmt_hd, &caps));
+    int cvt_caps = 0;
+    for (; caps; caps = caps->next) {
+        cvt_caps += (caps->cap_eightcc == ESP_GMF_CAPS_AUDIO_RATE_CONVERT) || (caps->cap_eightcc == ESP_GMF_CAPS_AUDIO_CHANNEL_CONVERT)
+                    || (caps->cap_eightcc == ESP_GMF_CAPS_AUDIO_BIT_CONVERT);
+    }
+    TEST_ASSERT_EQUAL(3, cvt_caps);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_audio_param_set_dest_rate(fmt_hd, 16000));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_audio_param_set_dest_ch(fmt_hd, 1));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_audio_param_set_dest_bits(fmt_hd, 16));
+    esp_gmf_fmt_cvt_cfg_t *fmt_info = (esp_gmf_fmt_cvt_cfg_t *)OBJ_GET_CFG(fmt_hd);
+    TEST_ASSERT_EQUAL(16000, fmt_info->dest_rate);
+    TEST_ASSERT_EQUAL(1, fmt_info->dest_ch);
+    TEST_ASSERT_EQUAL(16, fmt_info->dest_bits);
+
+    // 1. Resample, downmix and reduce the bits of two triangle waves, compare with `rate_cvt`, `ch_cvt` and `bit_cvt` in a row
+    for (uint32_t i = 0; i < CVT_TEST_FRAMES; i++) {
+        src[2 * i] = cvt_test_triangle(i, 480, 1 << 29);
+        src[2 * i + 1] = cvt_test_triangle(i + 120, 480, 1 << 28);
+    }
+    uint32_t fmt_size = cvt_test_run(fmt_hd, &src_stream, &fmt_stream);
+    esp_gmf_info_sound_t snd_info = {0};
+    esp_gmf_audio_el_get_snd_info(fmt_hd, &snd_info);
+    TEST_ASSERT_EQUAL(16000, snd_info.sample_rates);
+    TEST_ASSERT_EQUAL(1, snd_info.channels);
+    TEST_ASSERT_EQUAL(16, snd_info.bits);
+
+    esp_ae_rate_cvt_cfg_t rate_cvt_cfg = DEFAULT_ESP_GMF_RATE_CVT_CONFIG();
+    rate_cvt_cfg.src_rate = 48000;
+    rate_cvt_cfg.dest_rate = 16000;
+    rate_cvt_cfg.channel = 2;
+    rate_cvt_cfg.bits_per_sample = 32;
+    esp_gmf_element_handle_t rate_hd = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_rate_cvt_init(&rate_cvt_cfg, &rate_hd));
+    cvt_test_bind(rate_hd, &src_stream, &tmp_stream[0]);
+    tmp_stream[0].size = cvt_test_run(rate_hd, &src_stream, &tmp_stream[0]);
+    esp_ae_ch_cvt_cfg_t ch_cvt_cfg = DEFAULT_ESP_GMF_CH_CVT_CONFIG();
+    ch_cvt_cfg.sample_rate = 16000;
+    ch_cvt_cfg.bits_per_sample = 32;
+    ch_cvt_cfg.src_ch = 2;
+    ch_cvt_cfg.dest_ch = 1;
+    esp_gmf_element_handle_t ch_hd = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_ch_cvt_init(&ch_cvt_cfg, &ch_hd));
+    cvt_test_bind(ch_hd, &tmp_stream[0], &tmp_stream[1]);
+    tmp_stream[1].size = cvt_test_run(ch_hd, &tmp_stream[0], &tmp_stream[1]);
+    esp_ae_bit_cvt_cfg_t bit_cvt_cfg = DEFAULT_ESP_GMF_BIT_CVT_CONFIG();
+    bit_cvt_cfg.sample_rate = 16000;
+    bit_cvt_cfg.channel = 1;
+    bit_cvt_cfg.src_bits = 32;
+    bit_cvt_cfg.dest_bits = 16;
+    esp_gmf_element_handle_t bit_hd = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_bit_cvt_init(&bit_cvt_cfg, &bit_hd));
+    cvt_test_bind(bit_hd, &tmp_stream[1], &chain_stream);
+    uint32_t chain_size = cvt_test_run(bit_hd, &tmp_stream[1], &chain_stream);
+    ESP_LOGI(TAG, "Resampled by fmt_cvt: %" PRIu32 " bytes, by the converters in a row: %" PRIu32 " bytes", fmt_size, chain_size);
+    // The stages run in another order on other sample widths, the resampled samples differ by the rounding only
+    TEST_ASSERT_GREATER_THAN(CVT_TEST_FRAMES / 3, fmt_size);
+    TEST_ASSERT_INT_WITHIN(2 * sizeof(int16_t), chain_size, fmt_size);
+    int16_t *fmt_pcm = (int16_t *)fmt_out;
+    int16_t *chain_pcm = (int16_t *)chain_out;
+    for (uint32_t i = 0; i < (fmt_size < chain_size ? fmt_size : chain_size) / sizeof(int16_t); i++) {
+        TEST_ASSERT_INT_WITHIN(8, chain_pcm[i], fmt_pcm[i]);
+    }
+
+    // 2. Downmix and reduce the bits without resampling, on the fast paths, the destination changed while opened reopens it.
+    //    Compare with the expected rounding to the nearest, saturated on the positive overflow, and with `ch_cvt` and `bit_cvt`
+    const int32_t edges[][2] = {
+        {INT32_MAX, INT32_MAX}, {INT32_MIN, INT32_MIN}, {INT32_MAX, INT32_MIN}, {0x8000, 0x8000},
+        {0x7FFF, 0x7FFF}, {-0x18000, -0x18000}, {-0x8000, -0x8000}, {0x10000, 0x30000},
+    };
+    uint32_t edge_cnt = sizeof(edges) / sizeof(edges[0]);
+    for (uint32_t i = 0; i < CVT_TEST_FRAMES; i++) {
+        src[2 * i] = i < edge_cnt ? edges[i][0] : (int32_t)(i * 2654435761u);
+        src[2 * i + 1] = i < edge_cnt ? edges[i][1] : (int32_t)(i * 40503u * 65537u);
+    }
+    src_stream.pos = 0;
+    fmt_stream.pos = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_JOB_ERR_OK, esp_gmf_element_process_open(fmt_hd, NULL));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_audio_param_set_dest_rate(fmt_hd, 48000));
+    cvt_test_drain(fmt_hd);
+    esp_gmf_element_process_close(fmt_hd, NULL);
+    esp_gmf_audio_el_get_snd_info(fmt_hd, &snd_info);
+    TEST_ASSERT_EQUAL(48000, snd_info.sample_rates);
+    TEST_ASSERT_EQUAL(CVT_TEST_FRAMES * sizeof(int16_t), fmt_stream.pos);
+    for (uint32_t i = 0; i < CVT_TEST_FRAMES; i++) {
+        int64_t mixed = cvt_test_floor_div((int64_t)src[2 * i] + src[2 * i + 1], 2);
+        int64_t expected = cvt_test_floor_div(mixed + 0x8000, 0x10000);
+        expected = expected > INT16_MAX ? INT16_MAX : expected;
+        TEST_ASSERT_EQUAL(expected, fmt_pcm[i]);
+    }
+    TEST_ASSERT_EQUAL(INT16_MAX, fmt_pcm[0]);
+    TEST_ASSERT_EQUAL(INT16_MIN, fmt_pcm[1]);
+    TEST_ASSERT_EQUAL(0, fmt_pcm[2]);
+    TEST_ASSERT_EQUAL(1, fmt_pcm[3]);
+    TEST_ASSERT_EQUAL(0, fmt_pcm[4]);
+    TEST_ASSERT_EQUAL(-1, fmt_pcm[5]);
+    TEST_ASSERT_EQUAL(0, fmt_pcm[6]);
+    TEST_ASSERT_EQUAL(2, fmt_pcm[7]);
+    esp_ae_ch_cvt_cfg_t *ch_info = (esp_ae_ch_cvt_cfg_t *)OBJ_GET_CFG(ch_hd);
+    ch_info->sample_rate = 48000;
+    esp_ae_bit_cvt_cfg_t *bit_info = (esp_ae_bit_cvt_cfg_t *)OBJ_GET_CFG(bit_hd);
+    bit_info->sample_rate = 48000;
+    memcpy(tmp[0], src, in_size);
+    tmp_stream[0].size = in_size;
+    tmp_stream[1].size = in_size;
+    tmp_stream[1].size = cvt_test_run(ch_hd, &tmp_stream[0], &tmp_stream[1]);
+    chain_size = cvt_test_run(bit_hd, &tmp_stream[1], &chain_stream);
+    TEST_ASSERT_EQUAL(fmt_stream.pos, chain_size);
+    for (uint32_t i = 0; i < CVT_TEST_FRAMES; i++) {
+        TEST_ASSERT_INT_WITHIN(2, chain_pcm[i], fmt_pcm[i]);
+    }
+    esp_gmf_obj_delete(fmt_hd);
+    esp_gmf_obj_delete(rate_hd);
+    esp_gmf_obj_delete(ch_hd);
+    esp_gmf_obj_delete(bit_hd);
+
+    // 3. Upmix and extend the bits on the fast paths, each sample is copied to both channels and scaled to 32 bits
+    int16_t *mono = (int16_t *)src;
+    for (uint32_t i = 0; i < CVT_TEST_FRAMES; i++) {
+        mono[i] = i < 4 ? (int16_t[]){INT16_MAX, INT16_MIN, -1, 1}[i] : (int16_t)(i * 40503u);
+    }
+    src_stream.size = CVT_TEST_FRAMES * sizeof(int16_t);
+    fmt_cvt_cfg.src_rate = 16000;
+    fmt_cvt_cfg.src_ch = 1;
+    fmt_cvt_cfg.src_bits = 16;
+    fmt_cvt_cfg.dest_rate = 16000;
+    fmt_cvt_cfg.dest_ch = 2;
+    fmt_cvt_cfg.dest_bits = 32;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fmt_cvt_init(&fmt_cvt_cfg, &fmt_hd));
+    cvt_test_bind(fmt_hd, &src_stream, &fmt_stream);
+    TEST_ASSERT_EQUAL(in_size, cvt_test_run(fmt_hd, &src_stream, &fmt_stream));
+    int32_t *fmt_wide = (int32_t *)fmt_out;
+    for (uint32_t i = 0; i < CVT_TEST_FRAMES; i++) {
+        TEST_ASSERT_EQUAL((int32_t)mono[i] * 65536, fmt_wide[2 * i]);
+        TEST_ASSERT_EQUAL((int32_t)mono[i] * 65536, fmt_wide[2 * i + 1]);
+    }
+    ch_cvt_cfg.bits_per_sample = 16;
+    ch_cvt_cfg.src_ch = 1;
+    ch_cvt_cfg.dest_ch = 2;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_ch_cvt_init(&ch_cvt_cfg, &ch_hd));
+    tmp_stream[1].size = in_size;
+    cvt_test_bind(ch_hd, &src_stream, &tmp_stream[1]);
+    tmp_stream[1].size = cvt_test_run(ch_hd, &src_stream, &tmp_stream[1]);
+    bit_cvt_cfg.channel = 2;
+    bit_cvt_cfg.src_bits = 16;
+    bit_cvt_cfg.dest_bits = 32;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_bit_cvt_init(&bit_cvt_cfg, &bit_hd));
+    cvt_test_bind(bit_hd, &tmp_stream[1], &chain_stream);
+    TEST_ASSERT_EQUAL(in_size, cvt_test_run(bit_hd, &tmp_stream[1], &chain_stream));
+    int32_t *chain_wide = (int32_t *)chain_out;
+    for (uint32_t i = 0; i < 2 * CVT_TEST_FRAMES; i++) {
+        TEST_ASSERT_INT_WITHIN(65536, chain_wide[i], fmt_wide[i]);
+    }
+    esp_gmf_obj_delete(fmt_hd);
+    esp_gmf_obj_delete(ch_hd);
+    esp_gmf_obj_delete(bit_hd);
+
+    esp_gmf_oal_free(src);
+    esp_gmf_oal_free(fmt_out);
+    esp_gmf_oal_free(tmp[0]);
+    esp_gmf_oal_free(tmp[1]);
+    esp_gmf_oal_free(chain_out);
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
 TEST_CASE("Test methods for all effects", "[ESP_GMF_Effects]")
 {
     esp_log_level_set("*", ESP_LOG_INFO);
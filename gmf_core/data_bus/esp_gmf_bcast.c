@@ -0,0 +1,677 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_mutex.h"
+#include "esp_gmf_err.h"
+#include "esp_gmf_bcast.h"
+
+static const char *TAG = "ESP_GMF_BCAST";
+
+#define GMF_BCAST_DEFAULT_ALIGNMENT (16)
+
+typedef struct {
+    uint8_t                  *buf;         /*!< Buffer of the block */
+    size_t                    buf_length;  /*!< Length of the buffer */
+    size_t                    valid_size;  /*!< Valid data size published by the writer */
+    bool                      is_last;     /*!< The block is the last one of the stream */
+    uint16_t                  ref_cnt;     /*!< Number of readers which have not released the block yet */
+    int64_t                   trace_us;    /*!< Trace stamp of the data, see `esp_gmf_db_meta_t` */
+    uint8_t                  *ref_buf;     /*!< Buffer of the writer published by reference instead of `buf`, NULL if none */
+    size_t                    ref_length;  /*!< Length of `ref_buf` */
+    esp_gmf_bcast_ref_free_t  ref_free;    /*!< Callback returning `ref_buf` to the writer */
+    void                     *ref_ctx;     /*!< Context of `ref_free` */
+} esp_gmf_bcast_block_t;
+
+struct esp_gmf_bcast;
+
+typedef struct esp_gmf_bcast_reader {
+    struct esp_gmf_bcast_reader *next;             /*!< Next reader of the broadcast buffer */
+    struct esp_gmf_bcast        *bcast;            /*!< Broadcast buffer the reader belongs to */
+    SemaphoreHandle_t            can_read;         /*!< Semaphore given when a block is published, writing is done or aborted */
+    esp_gmf_db_handle_t          db;               /*!< Data bus wrapping the reader, notified when a block is published */
+    uint32_t                     rd_seq;           /*!< Sequence of the oldest block the reader has not released */
+    uint32_t                     dropped_cnt;      /*!< Number of blocks dropped for the reader */
+    esp_gmf_bcast_drop_policy_t  policy;           /*!< Drop policy of the reader */
+    uint8_t                      _is_reading;      /*!< The block at `rd_seq` is acquired by the reader, protected by the lock */
+    uint8_t                      _is_abort;        /*!< The reader is aborted, protected by the lock */
+} esp_gmf_bcast_reader_t;
+
+/**
+ * @brief  Structure representing a broadcast buffer
+ *
+ *         Blocks are published in sequence, block `seq` lives in `blocks[seq % block_cnt]`. A reader has read all
+ *         the blocks before its `rd_seq`, so the block at `wr_seq` is free once every reader has passed `wr_seq - block_cnt`
+ */
+typedef struct esp_gmf_bcast {
+    esp_gmf_bcast_block_t  *blocks;               /*!< Array of blocks */
+    uint32_t                block_cnt;            /*!< Number of blocks */
+    uint32_t                block_size;           /*!< Minimum size of each block */
+    uint32_t                wr_seq;               /*!< Sequence of the next block to be published */
+    esp_gmf_bcast_reader_t *readers;              /*!< List of the registered readers */
+    esp_gmf_db_handle_t     db;                   /*!< Data bus wrapping the writer, notified when a block becomes free */
+    SemaphoreHandle_t       can_write;            /*!< Semaphore given when a reader releases a block, or the buffer is aborted */
+    void                   *lock;                 /*!< Lock protecting the blocks, the sequences and the reader list */
+    uint16_t                ref_cnt;              /*!< Number of owners, the writer and the readers */
+    uint8_t                 _is_writing;          /*!< The block at `wr_seq` is acquired by the writer */
+    uint8_t                 _is_write_done;       /*!< Writing is done */
+    uint8_t                 _is_abort;            /*!< The buffer is aborted */
+    uint8_t                 align;                /*!< Alignment of the block buffers */
+} esp_gmf_bcast_t;
+
+static inline esp_gmf_bcast_block_t *bcast_block(esp_gmf_bcast_t *bcast, uint32_t seq)
+{
+    return &bcast->blocks[seq % bcast->block_cnt];
+}
+
+static inline uint8_t *bcast_block_data(esp_gmf_bcast_block_t *block)
+{
+    return block->ref_buf ? block->ref_buf : block->buf;
+}
+
+static void bcast_block_free_ref(esp_gmf_bcast_block_t *block)
+{
+    if (block->ref_buf) {
+        block->ref_free(block->ref_ctx, block->ref_buf);
+        block->ref_buf = NULL;
+        block->ref_length = 0;
+    }
+}
+
+static void bcast_wake_readers(esp_gmf_bcast_t *bcast)
+{
+    esp_gmf_bcast_reader_t *reader = bcast->readers;
+    while (reader) {
+        xSemaphoreGive(reader->can_read);
+        if (reader->db) {
+            esp_gmf_db_notify_ready(reader->db, ESP_GMF_DB_READY_READ);
+        }
+        reader = reader->next;
+    }
+}
+
+static void bcast_wake_writer(esp_gmf_bcast_t *bcast)
+{
+    xSemaphoreGive(bcast->can_write);
+    if (bcast->db) {
+        esp_gmf_db_notify_ready(bcast->db, ESP_GMF_DB_READY_WRITE);
+    }
+}
+
+static inline bool bcast_block_put(esp_gmf_bcast_block_t *block)
+{
+    if (--block->ref_cnt == 0) {
+        bcast_block_free_ref(block);
+        return true;
+    }
+    return false;
+}
+
+static inline bool bcast_reader_droppable(esp_gmf_bcast_t *bcast, esp_gmf_bcast_reader_t *reader)
+{
+    return (reader->policy == ESP_GMF_BCAST_DROP_OLDEST) && !reader->_is_reading
+           && ((bcast->wr_seq - reader->rd_seq) >= bcast->block_cnt);
+}
+
+static void bcast_drop_oldest(esp_gmf_bcast_t *bcast, esp_gmf_bcast_block_t *block)
+{
+    esp_gmf_bcast_reader_t *reader = bcast->readers;
+    while (reader && block->ref_cnt) {
+        if (bcast_reader_droppable(bcast, reader)) {
+            reader->rd_seq++;
+            reader->dropped_cnt++;
+            bcast_block_put(block);
+            ESP_LOGD(TAG, "Drop for reader:%p, seq:%ld, dropped:%ld", reader, reader->rd_seq - 1, reader->dropped_cnt);
+        }
+        reader = reader->next;
+    }
+}
+
+static void bcast_free(esp_gmf_bcast_t *bcast)
+{
+    if (bcast->blocks) {
+        for (int i = 0; i < bcast->block_cnt; i++) {
+            bcast_block_free_ref(&bcast->blocks[i]);
+            esp_gmf_oal_free(bcast->blocks[i].buf);
+        }
+        esp_gmf_oal_free(bcast->blocks);
+    }
+    if (bcast->can_write) {
+        vSemaphoreDelete(bcast->can_write);
+    }
+    if (bcast->lock) {
+        esp_gmf_oal_mutex_destroy(bcast->lock);
+    }
+    esp_gmf_oal_free(bcast);
+}
+
+static void bcast_unref(esp_gmf_bcast_t *bcast)
+{
+    esp_gmf_oal_mutex_lock(bcast->lock);
+    bool is_last = (--bcast->ref_cnt == 0);
+    esp_gmf_oal_mutex_unlock(bcast->lock);
+    if (is_last) {
+        bcast_free(bcast);
+    }
+}
+
+esp_gmf_err_t esp_gmf_bcast_create(int block_cnt, int block_size, esp_gmf_bcast_handle_t *handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    if ((block_cnt < 1) || (block_size < 0)) {
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    *handle = NULL;
+    esp_gmf_bcast_t *bcast = esp_gmf_oal_calloc(1, sizeof(esp_gmf_bcast_t));
+    ESP_GMF_MEM_CHECK(TAG, bcast, return ESP_GMF_ERR_MEMORY_LACK;);
+    bcast->blocks = esp_gmf_oal_calloc(block_cnt, sizeof(esp_gmf_bcast_block_t));
+    ESP_GMF_MEM_CHECK(TAG, bcast->blocks, goto _bcast_create_err;);
+    bcast->can_write = xSemaphoreCreateBinary();
+    ESP_GMF_MEM_CHECK(TAG, bcast->can_write, goto _bcast_create_err;);
+    bcast->lock = esp_gmf_oal_mutex_create();
+    ESP_GMF_MEM_CHECK(TAG, bcast->lock, goto _bcast_create_err;);
+    bcast->block_cnt = block_cnt;
+    bcast->block_size = block_size;
+    bcast->ref_cnt = 1;
+    bcast->align = GMF_BCAST_DEFAULT_ALIGNMENT;
+    *handle = bcast;
+    return ESP_GMF_ERR_OK;
+
+_bcast_create_err:
+    bcast_free(bcast);
+    return ESP_GMF_ERR_MEMORY_LACK;
+}
+
+esp_gmf_err_t esp_gmf_bcast_set_db(esp_gmf_bcast_handle_t handle, esp_gmf_db_handle_t db)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_bcast_t *bcast = (esp_gmf_bcast_t *)handle;
+    esp_gmf_oal_mutex_lock(bcast->lock);
+    bcast->db = db;
+    esp_gmf_oal_mutex_unlock(bcast->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_bcast_destroy(esp_gmf_bcast_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_bcast_t *bcast = (esp_gmf_bcast_t *)handle;
+    esp_gmf_oal_mutex_lock(bcast->lock);
+    // The remaining readers read out the published blocks and then get the last flag
+    bcast->db = NULL;
+    bcast->_is_writing = 0;
+    bcast->_is_write_done = 1;
+    bcast_wake_readers(bcast);
+    esp_gmf_oal_mutex_unlock(bcast->lock);
+    bcast_unref(bcast);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_bcast_reset(esp_gmf_bcast_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_bcast_t *bcast = (esp_gmf_bcast_t *)handle;
+    esp_gmf_oal_mutex_lock(bcast->lock);
+    for (int i = 0; i < bcast->block_cnt; i++) {
+        bcast->blocks[i].valid_size = 0;
+        bcast->blocks[i].is_last = false;
+        bcast->blocks[i].ref_cnt = 0;
+        bcast_block_free_ref(&bcast->blocks[i]);
+    }
+    esp_gmf_bcast_reader_t *reader = bcast->readers;
+    while (reader) {
+        reader->rd_seq = 0;
+        reader->_is_reading = 0;
+        reader = reader->next;
+    }
+    bcast->wr_seq = 0;
+    bcast->_is_writing = 0;
+    bcast->_is_write_done = 0;
+    bcast->_is_abort = 0;
+    esp_gmf_oal_mutex_unlock(bcast->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+/**
+ * @brief  Wait until the block at `wr_seq` is free, the lock is held on `ESP_GMF_IO_OK` only
+ */
+static esp_gmf_err_io_t bcast_wait_free_block(esp_gmf_bcast_t *bcast, int block_ticks)
+{
+    esp_gmf_oal_mutex_lock(bcast->lock);
+    esp_gmf_bcast_block_t *block = bcast_block(bcast, bcast->wr_seq);
+    while (true) {
+        if (bcast->_is_abort) {
+            esp_gmf_oal_mutex_unlock(bcast->lock);
+            return ESP_GMF_IO_ABORT;
+        }
+        if (block->ref_cnt) {
+            bcast_drop_oldest(bcast, block);
+        }
+        if (block->ref_cnt == 0) {
+            return ESP_GMF_IO_OK;
+        }
+        esp_gmf_oal_mutex_unlock(bcast->lock);
+        if (xSemaphoreTake(bcast->can_write, block_ticks) != pdTRUE) {
+            return ESP_GMF_IO_TIMEOUT;
+        }
+        esp_gmf_oal_mutex_lock(bcast->lock);
+    }
+}
+
+/**
+ * @brief  Publish the block at `wr_seq` to all the registered readers, the lock is held
+ */
+static void bcast_publish(esp_gmf_bcast_t *bcast, esp_gmf_bcast_block_t *block, bool is_last)
+{
+    block->is_last = is_last;
+    block->ref_cnt = 0;
+    esp_gmf_bcast_reader_t *reader = bcast->readers;
+    while (reader) {
+        block->ref_cnt++;
+        reader = reader->next;
+    }
+    if (block->ref_cnt == 0) {
+        // Nobody reads the block, the buffer of the writer goes back at once
+        bcast_block_free_ref(block);
+    }
+    bcast->wr_seq++;
+    bcast->_is_writing = 0;
+    if (is_last) {
+        bcast->_is_write_done = 1;
+    }
+    bcast_wake_readers(bcast);
+}
+
+esp_gmf_err_io_t esp_gmf_bcast_acquire_write(esp_gmf_bcast_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, blk, return ESP_GMF_IO_FAIL);
+    esp_gmf_bcast_t *bcast = (esp_gmf_bcast_t *)handle;
+    ESP_LOGD(TAG, "WR_ACQ+, hd:%p, wanted:%ld, seq:%ld, ticks:%d", handle, wanted_size, bcast->wr_seq, block_ticks);
+    esp_gmf_err_io_t ret = bcast_wait_free_block(bcast, block_ticks);
+    if (ret != ESP_GMF_IO_OK) {
+        return ret;
+    }
+    esp_gmf_bcast_block_t *block = bcast_block(bcast, bcast->wr_seq);
+    size_t size = wanted_size > bcast->block_size ? wanted_size : bcast->block_size;
+    if (block->buf_length < size) {
+        esp_gmf_oal_free(block->buf);
+        block->buf_length = 0;
+        block->buf = esp_gmf_oal_malloc_align(bcast->align, size);
+        ESP_GMF_MEM_CHECK(TAG, block->buf, {esp_gmf_oal_mutex_unlock(bcast->lock); return ESP_GMF_IO_FAIL;});
+        block->buf_length = size;
+    }
+    block->valid_size = 0;
+    block->is_last = false;
+    block->trace_us = 0;
+    bcast->_is_writing = 1;
+    blk->buf = block->buf;
+    blk->buf_length = block->buf_length;
+    blk->valid_size = 0;
+    blk->is_last = false;
+    esp_gmf_oal_mutex_unlock(bcast->lock);
+    ESP_LOGD(TAG, "WR_ACQ-, hd:%p, b:%p, l:%d", handle, blk->buf, blk->buf_length);
+    return ESP_GMF_IO_OK;
+}
+
+esp_gmf_err_io_t esp_gmf_bcast_release_write(esp_gmf_bcast_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, blk, return ESP_GMF_IO_FAIL);
+    esp_gmf_bcast_t *bcast = (esp_gmf_bcast_t *)handle;
+    ESP_LOGD(TAG, "WR_RLS+, hd:%p, b:%p, valid:%d, last:%d", handle, blk->buf, blk->valid_size, blk->is_last);
+    esp_gmf_oal_mutex_lock(bcast->lock);
+    esp_gmf_bcast_block_t *block = bcast_block(bcast, bcast->wr_seq);
+    if (!bcast->_is_writing || (blk->valid_size > block->buf_length)) {
+        ESP_LOGE(TAG, "Release write error, writing:%d, valid:%d, length:%d", bcast->_is_writing, blk->valid_size, block->buf_length);
+        esp_gmf_oal_mutex_unlock(bcast->lock);
+        return ESP_GMF_IO_FAIL;
+    }
+    if (blk->buf != block->buf) {
+        memcpy(block->buf, blk->buf, blk->valid_size);
+    }
+    block->valid_size = blk->valid_size;
+    bcast_publish(bcast, block, blk->is_last);
+    esp_gmf_oal_mutex_unlock(bcast->lock);
+    ESP_LOGD(TAG, "WR_RLS-, hd:%p, seq:%ld, ref:%d", handle, bcast->wr_seq, block->ref_cnt);
+    return ESP_GMF_IO_OK;
+}
+
+esp_gmf_err_io_t esp_gmf_bcast_write_ref(esp_gmf_bcast_handle_t handle, const esp_gmf_data_bus_block_t *blk, const esp_gmf_db_meta_t *meta,
+                                         esp_gmf_bcast_ref_free_t ref_free, void *ref_ctx, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, blk, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, ref_free, return ESP_GMF_IO_FAIL);
+    esp_gmf_bcast_t *bcast = (esp_gmf_bcast_t *)handle;
+    ESP_LOGD(TAG, "WR_REF+, hd:%p, b:%p, valid:%d, seq:%ld, ticks:%d", handle, blk->buf, blk->valid_size, bcast->wr_seq, block_ticks);
+    esp_gmf_err_io_t ret = bcast_wait_free_block(bcast, block_ticks);
+    if (ret != ESP_GMF_IO_OK) {
+        return ret;
+    }
+    if (bcast->_is_writing) {
+        ESP_LOGE(TAG, "Write by reference while a block is acquired for writing");
+        esp_gmf_oal_mutex_unlock(bcast->lock);
+        return ESP_GMF_IO_FAIL;
+    }
+    esp_gmf_bcast_block_t *block = bcast_block(bcast, bcast->wr_seq);
+    block->ref_buf = blk->buf;
+    block->ref_length = blk->buf_length;
+    block->ref_free = ref_free;
+    block->ref_ctx = ref_ctx;
+    block->valid_size = blk->valid_size;
+    block->trace_us = meta ? meta->trace_us : 0;
+    bcast_publish(bcast, block, blk->is_last);
+    esp_gmf_oal_mutex_unlock(bcast->lock);
+    ESP_LOGD(TAG, "WR_REF-, hd:%p, seq:%ld, ref:%d", handle, bcast->wr_seq, block->ref_cnt);
+    return ESP_GMF_IO_OK;
+}
+
+esp_gmf_err_t esp_gmf_bcast_set_meta(esp_gmf_bcast_handle_t handle, const esp_gmf_db_meta_t *meta)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, meta, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_bcast_t *bcast = (esp_gmf_bcast_t *)handle;
+    esp_gmf_err_t ret = ESP_GMF_ERR_NOT_FOUND;
+    esp_gmf_oal_mutex_lock(bcast->lock);
+    if (bcast->_is_writing) {
+        bcast_block(bcast, bcast->wr_seq)->trace_us = meta->trace_us;
+        ret = ESP_GMF_ERR_OK;
+    }
+    esp_gmf_oal_mutex_unlock(bcast->lock);
+    return ret;
+}
+
+esp_gmf_err_t esp_gmf_bcast_done_write(esp_gmf_bcast_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_bcast_t *bcast = (esp_gmf_bcast_t *)handle;
+    esp_gmf_oal_mutex_lock(bcast->lock);
+    bcast->_is_write_done = 1;
+    bcast_wake_readers(bcast);
+    esp_gmf_oal_mutex_unlock(bcast->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_bcast_reset_done_write(esp_gmf_bcast_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_bcast_t *bcast = (esp_gmf_bcast_t *)handle;
+    esp_gmf_oal_mutex_lock(bcast->lock);
+    bcast->_is_write_done = 0;
+    esp_gmf_oal_mutex_unlock(bcast->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_bcast_abort(esp_gmf_bcast_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_bcast_t *bcast = (esp_gmf_bcast_t *)handle;
+    esp_gmf_oal_mutex_lock(bcast->lock);
+    bcast->_is_abort = 1;
+    xSemaphoreGive(bcast->can_write);
+    bcast_wake_readers(bcast);
+    esp_gmf_oal_mutex_unlock(bcast->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_bcast_get_total_size(esp_gmf_bcast_handle_t handle, uint32_t *total_size)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, total_size, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_bcast_t *bcast = (esp_gmf_bcast_t *)handle;
+    *total_size = bcast->block_cnt * bcast->block_size;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_bcast_get_free_size(esp_gmf_bcast_handle_t handle, uint32_t *free_size)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, free_size, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_bcast_t *bcast = (esp_gmf_bcast_t *)handle;
+    *free_size = 0;
+    esp_gmf_oal_mutex_lock(bcast->lock);
+    if (bcast->_is_abort) {
+        // The writer does not wait on the aborted buffer
+        *free_size = bcast->block_cnt * bcast->block_size;
+        esp_gmf_oal_mutex_unlock(bcast->lock);
+        return ESP_GMF_ERR_OK;
+    }
+    for (int i = 0; i < bcast->block_cnt; i++) {
+        if (bcast->blocks[i].ref_cnt == 0) {
+            *free_size += bcast->block_size;
+        }
+    }
+    if (*free_size == 0) {
+        // The next block is free as well when only the readers dropping their oldest block hold it
+        esp_gmf_bcast_block_t *block = bcast_block(bcast, bcast->wr_seq);
+        uint16_t droppable = 0;
+        esp_gmf_bcast_reader_t *reader = bcast->readers;
+        while (reader) {
+            droppable += bcast_reader_droppable(bcast, reader);
+            reader = reader->next;
+        }
+        if (droppable >= block->ref_cnt) {
+            *free_size = bcast->block_size;
+        }
+    }
+    esp_gmf_oal_mutex_unlock(bcast->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_bcast_reader_create(esp_gmf_bcast_handle_t handle, esp_gmf_bcast_drop_policy_t policy, esp_gmf_bcast_reader_handle_t *reader)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, reader, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_bcast_t *bcast = (esp_gmf_bcast_t *)handle;
+    *reader = NULL;
+    esp_gmf_bcast_reader_t *rd = esp_gmf_oal_calloc(1, sizeof(esp_gmf_bcast_reader_t));
+    ESP_GMF_MEM_CHECK(TAG, rd, return ESP_GMF_ERR_MEMORY_LACK;);
+    rd->can_read = xSemaphoreCreateBinary();
+    ESP_GMF_MEM_CHECK(TAG, rd->can_read, {esp_gmf_oal_free(rd); return ESP_GMF_ERR_MEMORY_LACK;});
+    rd->bcast = bcast;
+    rd->policy = policy;
+    esp_gmf_oal_mutex_lock(bcast->lock);
+    rd->rd_seq = bcast->wr_seq;
+    rd->next = bcast->readers;
+    bcast->readers = rd;
+    bcast->ref_cnt++;
+    esp_gmf_oal_mutex_unlock(bcast->lock);
+    ESP_LOGD(TAG, "New reader:%p, hd:%p, policy:%d, seq:%ld", rd, bcast, policy, rd->rd_seq);
+    *reader = rd;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_bcast_reader_set_db(esp_gmf_bcast_reader_handle_t reader, esp_gmf_db_handle_t db)
+{
+    ESP_GMF_NULL_CHECK(TAG, reader, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_bcast_reader_t *rd = (esp_gmf_bcast_reader_t *)reader;
+    esp_gmf_oal_mutex_lock(rd->bcast->lock);
+    rd->db = db;
+    esp_gmf_oal_mutex_unlock(rd->bcast->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_bcast_reader_set_policy(esp_gmf_bcast_reader_handle_t reader, esp_gmf_bcast_drop_policy_t policy)
+{
+    ESP_GMF_NULL_CHECK(TAG, reader, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_bcast_reader_t *rd = (esp_gmf_bcast_reader_t *)reader;
+    esp_gmf_oal_mutex_lock(rd->bcast->lock);
+    rd->policy = policy;
+    // A writer waiting for this reader may drop its oldest block now
+    bcast_wake_writer(rd->bcast);
+    esp_gmf_oal_mutex_unlock(rd->bcast->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_bcast_reader_destroy(esp_gmf_bcast_reader_handle_t reader)
+{
+    ESP_GMF_NULL_CHECK(TAG, reader, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_bcast_reader_t *rd = (esp_gmf_bcast_reader_t *)reader;
+    esp_gmf_bcast_t *bcast = rd->bcast;
+    esp_gmf_oal_mutex_lock(bcast->lock);
+    esp_gmf_bcast_reader_t **link = &bcast->readers;
+    while (*link && (*link != rd)) {
+        link = &(*link)->next;
+    }
+    if (*link) {
+        *link = rd->next;
+    }
+    // Release the references of the blocks which are not read yet
+    while (rd->rd_seq != bcast->wr_seq) {
+        bcast_block_put(bcast_block(bcast, rd->rd_seq));
+        rd->rd_seq++;
+    }
+    bcast_wake_writer(bcast);
+    esp_gmf_oal_mutex_unlock(bcast->lock);
+    vSemaphoreDelete(rd->can_read);
+    esp_gmf_oal_free(rd);
+    bcast_unref(bcast);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_io_t esp_gmf_bcast_reader_acquire_read(esp_gmf_bcast_reader_handle_t reader, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, reader, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, blk, return ESP_GMF_IO_FAIL);
+    esp_gmf_bcast_reader_t *rd = (esp_gmf_bcast_reader_t *)reader;
+    esp_gmf_bcast_t *bcast = rd->bcast;
+    ESP_LOGD(TAG, "RD_ACQ+, rd:%p, seq:%ld, wr_seq:%ld, ticks:%d", rd, rd->rd_seq, bcast->wr_seq, block_ticks);
+    esp_gmf_oal_mutex_lock(bcast->lock);
+    while (rd->rd_seq == bcast->wr_seq) {
+        if (bcast->_is_abort || rd->_is_abort) {
+            esp_gmf_oal_mutex_unlock(bcast->lock);
+            return ESP_GMF_IO_ABORT;
+        }
+        if (bcast->_is_write_done) {
+            esp_gmf_oal_mutex_unlock(bcast->lock);
+            blk->valid_size = 0;
+            blk->is_last = true;
+            return ESP_GMF_IO_OK;
+        }
+        esp_gmf_oal_mutex_unlock(bcast->lock);
+        if (xSemaphoreTake(rd->can_read, block_ticks) != pdTRUE) {
+            return ESP_GMF_IO_TIMEOUT;
+        }
+        esp_gmf_oal_mutex_lock(bcast->lock);
+    }
+    if (bcast->_is_abort || rd->_is_abort) {
+        esp_gmf_oal_mutex_unlock(bcast->lock);
+        return ESP_GMF_IO_ABORT;
+    }
+    esp_gmf_bcast_block_t *block = bcast_block(bcast, rd->rd_seq);
+    blk->buf = bcast_block_data(block);
+    blk->buf_length = block->ref_buf ? block->ref_length : block->buf_length;
+    blk->valid_size = block->valid_size;
+    blk->is_last = block->is_last;
+    rd->_is_reading = 1;
+    esp_gmf_oal_mutex_unlock(bcast->lock);
+    ESP_LOGD(TAG, "RD_ACQ-, rd:%p, b:%p, valid:%d, last:%d", rd, blk->buf, blk->valid_size, blk->is_last);
+    return ESP_GMF_IO_OK;
+}
+
+esp_gmf_err_io_t esp_gmf_bcast_reader_release_read(esp_gmf_bcast_reader_handle_t reader, esp_gmf_data_bus_block_t *blk, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, reader, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, blk, return ESP_GMF_IO_FAIL);
+    esp_gmf_bcast_reader_t *rd = (esp_gmf_bcast_reader_t *)reader;
+    esp_gmf_bcast_t *bcast = rd->bcast;
+    esp_gmf_oal_mutex_lock(bcast->lock);
+    if (!rd->_is_reading) {
+        // Nothing is acquired, e.g. the last flag without data
+        esp_gmf_oal_mutex_unlock(bcast->lock);
+        return ESP_GMF_IO_OK;
+    }
+    esp_gmf_bcast_block_t *block = bcast_block(bcast, rd->rd_seq);
+    if (bcast_block_data(block) != blk->buf) {
+        ESP_LOGE(TAG, "Release read error, buffer not match");
+        esp_gmf_oal_mutex_unlock(bcast->lock);
+        return ESP_GMF_IO_FAIL;
+    }
+    rd->_is_reading = 0;
+    rd->rd_seq++;
+    if (bcast_block_put(block)) {
+        bcast_wake_writer(bcast);
+    }
+    esp_gmf_oal_mutex_unlock(bcast->lock);
+    ESP_LOGD(TAG, "RD_RLS-, rd:%p, b:%p, seq:%ld, ref:%d", rd, blk->buf, rd->rd_seq, block->ref_cnt);
+    return ESP_GMF_IO_OK;
+}
+
+esp_gmf_err_t esp_gmf_bcast_reader_get_meta(esp_gmf_bcast_reader_handle_t reader, esp_gmf_db_meta_t *meta)
+{
+    ESP_GMF_NULL_CHECK(TAG, reader, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, meta, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_bcast_reader_t *rd = (esp_gmf_bcast_reader_t *)reader;
+    esp_gmf_bcast_t *bcast = rd->bcast;
+    memset(meta, 0, sizeof(esp_gmf_db_meta_t));
+    esp_gmf_oal_mutex_lock(bcast->lock);
+    if (rd->_is_reading) {
+        meta->trace_us = bcast_block(bcast, rd->rd_seq)->trace_us;
+    }
+    esp_gmf_oal_mutex_unlock(bcast->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_bcast_reader_abort(esp_gmf_bcast_reader_handle_t reader)
+{
+    ESP_GMF_NULL_CHECK(TAG, reader, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_bcast_reader_t *rd = (esp_gmf_bcast_reader_t *)reader;
+    esp_gmf_bcast_t *bcast = rd->bcast;
+    esp_gmf_oal_mutex_lock(bcast->lock);
+    rd->_is_abort = 1;
+    xSemaphoreGive(rd->can_read);
+    esp_gmf_oal_mutex_unlock(bcast->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_bcast_reader_reset(esp_gmf_bcast_reader_handle_t reader)
+{
+    ESP_GMF_NULL_CHECK(TAG, reader, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_bcast_reader_t *rd = (esp_gmf_bcast_reader_t *)reader;
+    esp_gmf_bcast_t *bcast = rd->bcast;
+    esp_gmf_oal_mutex_lock(bcast->lock);
+    rd->_is_abort = 0;
+    esp_gmf_oal_mutex_unlock(bcast->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_bcast_reader_get_filled(esp_gmf_bcast_reader_handle_t reader, uint32_t *filled_cnt)
+{
+    ESP_GMF_NULL_CHECK(TAG, reader, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, filled_cnt, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_bcast_reader_t *rd = (esp_gmf_bcast_reader_t *)reader;
+    esp_gmf_bcast_t *bcast = rd->bcast;
+    esp_gmf_oal_mutex_lock(bcast->lock);
+    *filled_cnt = bcast->wr_seq - rd->rd_seq;
+    if ((*filled_cnt == 0) && bcast->_is_write_done) {
+        *filled_cnt = 1;
+    }
+    esp_gmf_oal_mutex_unlock(bcast->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_bcast_reader_get_dropped(esp_gmf_bcast_reader_handle_t reader, uint32_t *dropped_cnt)
+{
+    ESP_GMF_NULL_CHECK(TAG, reader, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, dropped_cnt, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_bcast_reader_t *rd = (esp_gmf_bcast_reader_t *)reader;
+    *dropped_cnt = rd->dropped_cnt;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_bcast_reader_get_total_size(esp_gmf_bcast_reader_handle_t reader, uint32_t *total_size)
+{
+    ESP_GMF_NULL_CHECK(TAG, reader, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_bcast_reader_t *rd = (esp_gmf_bcast_reader_t *)reader;
+    return esp_gmf_bcast_get_total_size(rd->bcast, total_size);
+}
@@ -195,7 +195,9 @@ esp_gmf_err_io_t esp_gmf_block_acquire_read(esp_gmf_block_handle_t handle, esp_g
         }
         ESP_LOGV(TAG, "R-T:%p, %p, %p, wanted:%ld, fill:%ld", hd->p_rd, hd->p_wr, hd->p_wr_end, wanted_size, get_fill_size(hd));
         if (xSemaphoreTake(hd->can_read, block_ticks) != pdPASS) {
-            ESP_LOGE(TAG, "Read timeout");
+            if (block_ticks != 0) {
+                ESP_LOGE(TAG, "Read timeout");
+            }
             return ESP_GMF_IO_TIMEOUT;
         }
         if (hd->_is_abort) {
@@ -288,7 +290,9 @@ esp_gmf_err_io_t esp_gmf_block_acquire_write(esp_gmf_block_handle_t handle, esp_
         }
         ESP_LOGV(TAG, "W-T:%p,%p,%p,%ld, empt:%ld\r\n", hd->p_rd, hd->p_wr, hd->p_wr_end, wanted_size, get_empty_size(hd));
         if (xSemaphoreTake(hd->can_write, block_ticks) != pdPASS) {
-            ESP_LOGE(TAG, "Write timeout");
+            if (block_ticks != 0) {
+                ESP_LOGE(TAG, "Write timeout");
+            }
             return ESP_GMF_IO_TIMEOUT;
         }
         if (hd->_is_abort) {
@@ -324,8 +328,9 @@ esp_gmf_err_io_t esp_gmf_block_release_write(esp_gmf_block_handle_t handle, esp_
         hd->p_wr = hd->buf;
         hd->p_wr_end = hd->buf_end;
     }
-    if (hd->_set_done) {
-        hd->_is_write_done = hd->_set_done;
+    if (hd->_set_done || blk->is_last) {
+        // The last block marks the writing done as `esp_gmf_block_done_write` does
+        hd->_is_write_done = 1;
     }
     ESP_LOGD(TAG, "ACQ_W-, f:%ld, emt:%ld, rd:%p, wr:%p,wr_e:%p, done:%d, vld:%d", hd->fill_size, get_empty_size(hd), hd->p_rd, hd->p_wr, hd->p_wr_end, hd->_is_write_done, blk->valid_size);
     esp_gmf_oal_mutex_unlock(hd->lock);
@@ -333,6 +338,34 @@ esp_gmf_err_io_t esp_gmf_block_release_write(esp_gmf_block_handle_t handle, esp_
     return ESP_GMF_IO_OK;
 }
 
+esp_gmf_err_io_t esp_gmf_block_drop_unread(esp_gmf_block_handle_t handle, uint32_t held_size, uint32_t *dropped_size)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, dropped_size, return ESP_GMF_IO_FAIL);
+    esp_gmf_block_t *hd = (esp_gmf_block_t *)handle;
+    esp_gmf_oal_mutex_lock(hd->lock);
+    if ((held_size > hd->fill_size) || ((hd->p_rd + held_size) > hd->buf_end)) {
+        esp_gmf_oal_mutex_unlock(hd->lock);
+        ESP_LOGE(TAG, "The held size is invalid, held:%ld, f:%ld, rd:%p, end:%p", held_size, hd->fill_size, hd->p_rd, hd->buf_end);
+        return ESP_GMF_IO_FAIL;
+    }
+    // The held block is at the read position, the write position goes back to its end as if nothing is written after it
+    uint8_t *held_end = hd->p_rd + held_size;
+    if (held_end == hd->buf_end) {
+        hd->p_wr = hd->buf;
+        hd->p_wr_end = hd->buf_end;
+    } else {
+        hd->p_wr = held_end;
+        hd->p_wr_end = hd->buf;
+    }
+    *dropped_size = hd->fill_size - held_size;
+    hd->fill_size = held_size;
+    ESP_LOGD(TAG, "Drop unread, rd:%p, wr:%p, wr_e:%p, held:%ld, dropped:%ld", hd->p_rd, hd->p_wr, hd->p_wr_end, held_size, *dropped_size);
+    esp_gmf_oal_mutex_unlock(hd->lock);
+    xSemaphoreGive(hd->can_write);
+    return ESP_GMF_IO_OK;
+}
+
 esp_gmf_err_t esp_gmf_block_done_write(esp_gmf_block_handle_t handle)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
@@ -9,10 +9,387 @@
 #include <string.h>
 #include "esp_log.h"
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_mutex.h"
+#include "esp_gmf_oal_sys.h"
+#include "esp_gmf_payload.h"
 #include "esp_gmf_data_bus.h"
 
 static const char *TAG = "ESP_GMF_DATA_BUS";
 
+#ifdef CONFIG_ESP_GMF_LATENCY_TRACE_EN
+#define GMF_DB_TRACE_STAMP_MAX (8)
+
+/**
+ * @brief  Trace stamp of a run of written data
+ */
+typedef struct {
+    int64_t  us;    /*!< Trace stamp of the data, 0 for the data written without one */
+    uint32_t size;  /*!< Size of the data */
+} esp_gmf_db_stamp_t;
+
+/**
+ * @brief  Trace stamps of the unread data in stream order, for the data bus which can't keep them along the data
+ */
+typedef struct {
+    void               *lock;                            /*!< Lock between the writer adding the stamps and the reader taking them */
+    esp_gmf_db_stamp_t  stamps[GMF_DB_TRACE_STAMP_MAX];  /*!< Ring of the stamps */
+    uint8_t             head;                            /*!< Index of the oldest stamp */
+    uint8_t             cnt;                             /*!< Number of the stamps */
+    uint32_t            held;                            /*!< Size of the data the reader holds, taken on release */
+} esp_gmf_db_trace_t;
+
+static inline esp_gmf_db_stamp_t *esp_gmf_db_trace_at(esp_gmf_db_trace_t *trace, int idx)
+{
+    return &trace->stamps[(trace->head + idx) % GMF_DB_TRACE_STAMP_MAX];
+}
+
+static void esp_gmf_db_trace_put(esp_gmf_db_trace_t *trace, int64_t us, uint32_t size)
+{
+    esp_gmf_oal_mutex_lock(trace->lock);
+    esp_gmf_db_stamp_t *last = trace->cnt ? esp_gmf_db_trace_at(trace, trace->cnt - 1) : NULL;
+    if (last && ((last->us == us) || (trace->cnt == GMF_DB_TRACE_STAMP_MAX))) {
+        // Out of stamps, the data takes the older stamp and reads a bit later
+        last->size += size;
+    } else {
+        last = esp_gmf_db_trace_at(trace, trace->cnt++);
+        last->us = us;
+        last->size = size;
+    }
+    esp_gmf_oal_mutex_unlock(trace->lock);
+}
+
+static void esp_gmf_db_trace_cancel(esp_gmf_db_trace_t *trace, uint32_t size)
+{
+    // Take back the newest stamps of the data which is not written
+    esp_gmf_oal_mutex_lock(trace->lock);
+    while (trace->cnt && size) {
+        esp_gmf_db_stamp_t *last = esp_gmf_db_trace_at(trace, trace->cnt - 1);
+        uint32_t n = last->size < size ? last->size : size;
+        last->size -= n;
+        size -= n;
+        trace->cnt -= (last->size == 0);
+    }
+    esp_gmf_oal_mutex_unlock(trace->lock);
+}
+
+static void esp_gmf_db_trace_take(esp_gmf_db_trace_t *trace, uint32_t size)
+{
+    esp_gmf_oal_mutex_lock(trace->lock);
+    while (trace->cnt && size) {
+        esp_gmf_db_stamp_t *first = esp_gmf_db_trace_at(trace, 0);
+        uint32_t n = first->size < size ? first->size : size;
+        first->size -= n;
+        size -= n;
+        if (first->size == 0) {
+            trace->head = (trace->head + 1) % GMF_DB_TRACE_STAMP_MAX;
+            trace->cnt--;
+        }
+    }
+    esp_gmf_oal_mutex_unlock(trace->lock);
+}
+
+static void esp_gmf_db_trace_keep(esp_gmf_db_trace_t *trace, uint32_t size)
+{
+    // Only the oldest `size` bytes are left
+    esp_gmf_oal_mutex_lock(trace->lock);
+    int i = 0;
+    for (; (i < trace->cnt) && size; i++) {
+        esp_gmf_db_stamp_t *stamp = esp_gmf_db_trace_at(trace, i);
+        stamp->size = stamp->size < size ? stamp->size : size;
+        size -= stamp->size;
+    }
+    trace->cnt = i;
+    esp_gmf_oal_mutex_unlock(trace->lock);
+}
+
+static int64_t esp_gmf_db_trace_peek(esp_gmf_db_trace_t *trace)
+{
+    esp_gmf_oal_mutex_lock(trace->lock);
+    int64_t us = trace->cnt ? esp_gmf_db_trace_at(trace, 0)->us : 0;
+    esp_gmf_oal_mutex_unlock(trace->lock);
+    return us;
+}
+#endif  /* CONFIG_ESP_GMF_LATENCY_TRACE_EN */
+
+static inline void esp_gmf_db_meta_put(esp_gmf_data_bus_t *db, const esp_gmf_db_meta_t *meta, uint32_t size)
+{
+    // Called before the data is released, so the reader never gets the data without its metadata
+    if (db->op.set_meta) {
+        esp_gmf_db_meta_t none = {0};
+        db->op.set_meta(db->child, meta ? meta : &none);
+        return;
+    }
+#ifdef CONFIG_ESP_GMF_LATENCY_TRACE_EN
+    if (db->trace && size) {
+        esp_gmf_db_trace_put(db->trace, meta ? meta->trace_us : 0, size);
+    }
+#endif  /* CONFIG_ESP_GMF_LATENCY_TRACE_EN */
+}
+
+static inline void esp_gmf_db_meta_cancel(esp_gmf_data_bus_t *db, uint32_t size)
+{
+#ifdef CONFIG_ESP_GMF_LATENCY_TRACE_EN
+    if ((db->op.set_meta == NULL) && db->trace && size) {
+        esp_gmf_db_trace_cancel(db->trace, size);
+    }
+#endif  /* CONFIG_ESP_GMF_LATENCY_TRACE_EN */
+}
+
+static inline void esp_gmf_db_meta_get(esp_gmf_data_bus_t *db, esp_gmf_db_meta_t *meta)
+{
+    memset(meta, 0, sizeof(esp_gmf_db_meta_t));
+    if (db->op.get_meta) {
+        db->op.get_meta(db->child, meta);
+        return;
+    }
+#ifdef CONFIG_ESP_GMF_LATENCY_TRACE_EN
+    if (db->trace) {
+        meta->trace_us = esp_gmf_db_trace_peek(db->trace);
+    }
+#endif  /* CONFIG_ESP_GMF_LATENCY_TRACE_EN */
+}
+
+static inline void esp_gmf_db_meta_hold(esp_gmf_data_bus_t *db, uint32_t size)
+{
+#ifdef CONFIG_ESP_GMF_LATENCY_TRACE_EN
+    if (db->trace) {
+        ((esp_gmf_db_trace_t *)db->trace)->held = size;
+    }
+#endif  /* CONFIG_ESP_GMF_LATENCY_TRACE_EN */
+}
+
+static inline void esp_gmf_db_meta_unhold(esp_gmf_data_bus_t *db)
+{
+#ifdef CONFIG_ESP_GMF_LATENCY_TRACE_EN
+    // The held data is read out once released
+    esp_gmf_db_trace_t *trace = (esp_gmf_db_trace_t *)db->trace;
+    if (trace && trace->held) {
+        if (db->op.get_meta == NULL) {
+            esp_gmf_db_trace_take(trace, trace->held);
+        }
+        trace->held = 0;
+    }
+#endif  /* CONFIG_ESP_GMF_LATENCY_TRACE_EN */
+}
+
+static inline void esp_gmf_db_meta_take(esp_gmf_data_bus_t *db, uint32_t size)
+{
+#ifdef CONFIG_ESP_GMF_LATENCY_TRACE_EN
+    if ((db->op.get_meta == NULL) && db->trace && size) {
+        esp_gmf_db_trace_take(db->trace, size);
+    }
+#endif  /* CONFIG_ESP_GMF_LATENCY_TRACE_EN */
+}
+
+static inline void esp_gmf_db_meta_keep(esp_gmf_data_bus_t *db, uint32_t size)
+{
+#ifdef CONFIG_ESP_GMF_LATENCY_TRACE_EN
+    if ((db->op.get_meta == NULL) && db->trace) {
+        esp_gmf_db_trace_keep(db->trace, size);
+    }
+#endif  /* CONFIG_ESP_GMF_LATENCY_TRACE_EN */
+}
+
+static inline void esp_gmf_db_notify(esp_gmf_data_bus_t *db, esp_gmf_db_ready_t type)
+{
+    if (db->notify_cnt[type] == 0) {
+        return;
+    }
+    esp_gmf_oal_mutex_lock(db->notify_lock);
+    for (int i = 0; i < db->notify_cnt[type]; i++) {
+        db->notify[type][i](db->notify_ctx[type][i]);
+    }
+    esp_gmf_oal_mutex_unlock(db->notify_lock);
+}
+
+static inline int64_t esp_gmf_db_stats_start(esp_gmf_data_bus_t *db, esp_gmf_db_ready_t type, uint32_t wanted_size, int block_ticks)
+{
+#ifdef CONFIG_ESP_GMF_DB_STATS_EN
+    if (block_ticks == 0) {
+        return 0;
+    }
+    bool ready = true;
+    esp_gmf_db_is_ready(db, type, wanted_size, &ready);
+    if (ready && (type == ESP_GMF_DB_READY_WRITE) && (db->type == DATA_BUS_TYPE_BLOCK) && !db->_is_abort
+        && db->op.get_available && db->op.get_filled_size) {
+        // The writer of a block data bus waits when all the blocks are filled
+        uint32_t available = 0;
+        uint32_t filled = 0;
+        if ((db->op.get_available(db->child, &available) == ESP_GMF_ERR_OK)
+            && (db->op.get_filled_size(db->child, &filled) == ESP_GMF_ERR_OK)) {
+            ready = (available > 0) || (filled == 0);
+        }
+    }
+    // Zero start means the acquisition is not expected to wait
+    return ready ? 0 : esp_gmf_oal_sys_get_time_us();
+#else
+    return 0;
+#endif  /* CONFIG_ESP_GMF_DB_STATS_EN */
+}
+
+static inline void esp_gmf_db_stats_end(esp_gmf_data_bus_t *db, esp_gmf_db_ready_t type, bool is_acquire, int64_t start, esp_gmf_err_io_t ret)
+{
+#ifdef CONFIG_ESP_GMF_DB_STATS_EN
+    // Each side only updates its own statistics, so the reader and the writer don't need a lock
+    esp_gmf_db_access_stats_t *access = (type == ESP_GMF_DB_READY_READ) ? &db->stats.reader : &db->stats.writer;
+    if (is_acquire) {
+        access->acquire_cnt++;
+    }
+    if (start) {
+        access->block_cnt++;
+        access->block_us += esp_gmf_oal_sys_get_time_us() - start;
+    }
+    if (ret == ESP_GMF_IO_TIMEOUT) {
+        access->timeout_cnt++;
+    } else if (ret == ESP_GMF_IO_ABORT) {
+        access->abort_cnt++;
+    }
+#endif  /* CONFIG_ESP_GMF_DB_STATS_EN */
+}
+
+static inline void esp_gmf_db_stats_watermark(esp_gmf_data_bus_t *db, bool is_write)
+{
+#ifdef CONFIG_ESP_GMF_DB_STATS_EN
+    uint32_t filled = 0;
+    if ((db->op.get_filled_size == NULL) || (db->op.get_filled_size(db->child, &filled) != ESP_GMF_ERR_OK)) {
+        return;
+    }
+    // The filled size peaks after a write and bottoms out after a read
+    if (is_write && (filled > db->stats.high_watermark)) {
+        db->stats.high_watermark = filled;
+    } else if (!is_write && (filled < db->stats.low_watermark)) {
+        db->stats.low_watermark = filled;
+    }
+#endif  /* CONFIG_ESP_GMF_DB_STATS_EN */
+}
+
+static inline void esp_gmf_db_set_reading(esp_gmf_data_bus_t *db, bool reading, uint32_t held_size)
+{
+    if (db->drop_lock == NULL) {
+        return;
+    }
+    esp_gmf_oal_mutex_lock(db->drop_lock);
+    db->is_reading = reading;
+    db->read_held = held_size;
+    esp_gmf_oal_mutex_unlock(db->drop_lock);
+}
+
+static bool esp_gmf_db_drop_oldest(esp_gmf_data_bus_t *db, uint32_t wanted_size)
+{
+    // Read out the oldest data on behalf of the reader, which is kept out by the lock meanwhile
+    bool dropped = false;
+    esp_gmf_oal_mutex_lock(db->drop_lock);
+    if (db->is_reading) {
+        // The reader may get any unread data right now, keep it
+    } else if (db->read_held == 0) {
+        esp_gmf_data_bus_block_t blk = {0};
+        if ((db->op.acquire_read(db->child, &blk, wanted_size, 0) == ESP_GMF_IO_OK) && (blk.valid_size > 0) && !blk.is_last) {
+            db->op.release_read(db->child, &blk, 0);
+            esp_gmf_db_meta_take(db, blk.valid_size);
+            db->dropped_cnt++;
+            dropped = true;
+            ESP_LOGD(TAG, "Drop the oldest %d bytes, db:%p-%s, dropped:%ld", blk.valid_size, db, db->name, db->dropped_cnt);
+        }
+    } else if (db->op.drop_unread) {
+        // The held data goes on its release, the unread data behind it is all older than the written one
+        uint32_t size = 0;
+        if ((db->op.drop_unread(db->child, db->read_held, &size) == ESP_GMF_IO_OK) && (size > 0)) {
+            esp_gmf_db_meta_keep(db, db->read_held);
+            db->dropped_cnt += (size + wanted_size - 1) / wanted_size;
+            dropped = true;
+            ESP_LOGD(TAG, "Drop %ld unread bytes behind the held %ld bytes, db:%p-%s, dropped:%ld", size, db->read_held, db, db->name, db->dropped_cnt);
+        }
+    }
+    esp_gmf_oal_mutex_unlock(db->drop_lock);
+    return dropped;
+}
+
+static esp_gmf_err_io_t esp_gmf_db_drop_acquire_write(esp_gmf_data_bus_t *db, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int block_ticks)
+{
+    // The policy only applies when the data bus is full, try it without waiting first
+    esp_gmf_err_io_t ret = ESP_GMF_IO_OK;
+    if (db->wait_key == false) {
+        ret = db->op.acquire_write(db->child, blk, wanted_size, 0);
+        if ((ret >= ESP_GMF_IO_OK) || (ret == ESP_GMF_IO_ABORT) || (block_ticks == 0)) {
+            return ret;
+        }
+        if (db->drop_policy == ESP_GMF_DB_DROP_OLDEST) {
+            // Several old blocks may have to go for a large or a wrapped block
+            while (esp_gmf_db_drop_oldest(db, wanted_size)) {
+                ret = db->op.acquire_write(db->child, blk, wanted_size, 0);
+                if ((ret >= ESP_GMF_IO_OK) || (ret == ESP_GMF_IO_ABORT)) {
+                    return ret;
+                }
+            }
+            // The reader is acquiring or holding the oldest data, the space is back once it is released
+            return db->op.acquire_write(db->child, blk, wanted_size, block_ticks);
+        }
+    }
+    if (db->drop_buf_len < wanted_size) {
+        esp_gmf_oal_free(db->drop_buf);
+        db->drop_buf = esp_gmf_oal_malloc(wanted_size);
+        db->drop_buf_len = db->drop_buf ? wanted_size : 0;
+        ESP_GMF_MEM_CHECK(TAG, db->drop_buf, return ESP_GMF_IO_FAIL);
+    }
+    blk->buf = db->drop_buf;
+    blk->buf_length = wanted_size;
+    blk->valid_size = 0;
+    blk->is_last = false;
+    db->is_dropping = true;
+    return ESP_GMF_IO_OK;
+}
+
+static esp_gmf_err_io_t esp_gmf_db_drop_release_write(esp_gmf_data_bus_t *db, esp_gmf_data_bus_block_t *blk, const esp_gmf_db_meta_t *meta, int block_ticks)
+{
+    db->is_dropping = false;
+    // Keep the data if the reader made space meanwhile, but only from a key frame on after a drop
+    bool keep = (blk->valid_size > 0)
+                && ((db->drop_policy != ESP_GMF_DB_DROP_TO_KEY_FRAME) || (meta && (meta->meta_flag & ESP_GMF_META_FLAG_VID_KEY_FRAME)));
+    if (keep || blk->is_last) {
+        // The last block is written with waiting, so the reader still gets the end of the stream
+        esp_gmf_data_bus_block_t wr_blk = {0};
+        esp_gmf_err_io_t ret = db->op.acquire_write(db->child, &wr_blk, keep ? blk->valid_size : 1, blk->is_last ? block_ticks : 0);
+        if (ret == ESP_GMF_IO_OK) {
+            if (keep) {
+                memcpy(wr_blk.buf, blk->buf, blk->valid_size);
+                db->wait_key = false;
+            }
+            wr_blk.valid_size = keep ? blk->valid_size : 0;
+            wr_blk.is_last = blk->is_last;
+            esp_gmf_db_meta_put(db, meta, wr_blk.valid_size);
+            ret = db->op.release_write(db->child, &wr_blk, block_ticks);
+            if (ret < ESP_GMF_IO_OK) {
+                esp_gmf_db_meta_cancel(db, wr_blk.valid_size);
+            }
+            if (keep) {
+                return ret;
+            }
+        } else if (blk->is_last) {
+            return ret;
+        }
+    }
+    if (blk->valid_size > 0) {
+        db->dropped_cnt++;
+        db->wait_key = (db->drop_policy == ESP_GMF_DB_DROP_TO_KEY_FRAME);
+        ESP_LOGD(TAG, "Drop the newest %d bytes, db:%p-%s, dropped:%ld", blk->valid_size, db, db->name, db->dropped_cnt);
+    }
+    return ESP_GMF_IO_OK;
+}
+
+static inline void esp_gmf_db_trace_free(esp_gmf_data_bus_t *db)
+{
+#ifdef CONFIG_ESP_GMF_LATENCY_TRACE_EN
+    esp_gmf_db_trace_t *trace = (esp_gmf_db_trace_t *)db->trace;
+    if (trace) {
+        if (trace->lock) {
+            esp_gmf_oal_mutex_destroy(trace->lock);
+        }
+        esp_gmf_oal_free(trace);
+        db->trace = NULL;
+    }
+#endif  /* CONFIG_ESP_GMF_LATENCY_TRACE_EN */
+}
+
 esp_gmf_err_t esp_gmf_db_init(esp_gmf_db_config_t *db_config, esp_gmf_db_handle_t *hd)
 {
     ESP_GMF_NULL_CHECK(TAG, db_config, return ESP_GMF_ERR_INVALID_ARG;);
@@ -25,11 +402,26 @@ esp_gmf_err_t esp_gmf_db_init(esp_gmf_db_config_t *db_config, esp_gmf_db_handle_
     db->max_item_num = db_config->max_item_num;
     db->max_size = db_config->max_size;
     db->child = db_config->child;
+    db->notify_lock = esp_gmf_oal_mutex_create();
+    ESP_GMF_MEM_CHECK(TAG, db->notify_lock, goto __init_fail);
+    db->stats.low_watermark = UINT32_MAX;
+#ifdef CONFIG_ESP_GMF_LATENCY_TRACE_EN
+    esp_gmf_db_trace_t *trace = esp_gmf_oal_calloc(1, sizeof(esp_gmf_db_trace_t));
+    ESP_GMF_MEM_CHECK(TAG, trace, goto __init_fail);
+    db->trace = trace;
+    trace->lock = esp_gmf_oal_mutex_create();
+    ESP_GMF_MEM_CHECK(TAG, trace->lock, goto __init_fail);
+#endif  /* CONFIG_ESP_GMF_LATENCY_TRACE_EN */
     *hd = db;
     return ESP_GMF_ERR_OK;
 
 __init_fail:
     if (db) {
+        esp_gmf_db_trace_free(db);
+        if (db->notify_lock) {
+            esp_gmf_oal_mutex_destroy(db->notify_lock);
+        }
+        esp_gmf_oal_free((void *)db->name);
         esp_gmf_oal_free(db);
         db = NULL;
     }
@@ -47,6 +439,16 @@ esp_gmf_err_t esp_gmf_db_deinit(esp_gmf_db_handle_t handle)
         esp_gmf_oal_free((void *)db->name);
         db->name = NULL;
     }
+    if (db->notify_lock) {
+        esp_gmf_oal_mutex_destroy(db->notify_lock);
+        db->notify_lock = NULL;
+    }
+    if (db->drop_lock) {
+        esp_gmf_oal_mutex_destroy(db->drop_lock);
+        db->drop_lock = NULL;
+    }
+    esp_gmf_oal_free(db->drop_buf);
+    esp_gmf_db_trace_free(db);
     if (db) {
         esp_gmf_oal_free(db);
         db = NULL;
@@ -76,17 +478,33 @@ esp_gmf_err_t esp_gmf_db_write(esp_gmf_db_handle_t handle, void *buffer, int buf
     return ret;
 }
 
-esp_gmf_err_io_t esp_gmf_db_acquire_read(esp_gmf_db_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int block_ticks)
+typedef esp_gmf_err_io_t (*esp_gmf_db_acquire_func_t)(esp_gmf_db_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int block_ticks);
+
+static esp_gmf_err_io_t esp_gmf_db_acquire_read_by(esp_gmf_data_bus_t *db, esp_gmf_db_acquire_func_t acquire, esp_gmf_data_bus_block_t *blk,
+                                                   uint32_t wanted_size, int block_ticks)
 {
-    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
-    esp_gmf_data_bus_t *db = (esp_gmf_data_bus_t *)handle;
     esp_gmf_err_io_t ret = ESP_GMF_ERR_OK;
-    if (db->op.acquire_read) {
-        ret = db->op.acquire_read(db->child, blk, wanted_size, block_ticks);
+    int64_t start = esp_gmf_db_stats_start(db, ESP_GMF_DB_READY_READ, wanted_size, block_ticks);
+    if (acquire) {
+        esp_gmf_db_set_reading(db, true, 0);
+        ret = acquire(db->child, blk, wanted_size, block_ticks);
+        // Once the block is got, only the held data is kept from the writer dropping the oldest data if the data bus
+        // can drop the unread data behind it
+        bool held = (ret >= ESP_GMF_IO_OK);
+        esp_gmf_db_set_reading(db, held && (db->op.drop_unread == NULL), held ? blk->valid_size : 0);
+        esp_gmf_db_meta_hold(db, held ? blk->valid_size : 0);
     }
+    esp_gmf_db_stats_end(db, ESP_GMF_DB_READY_READ, true, start, ret);
     return ret;
 }
 
+esp_gmf_err_io_t esp_gmf_db_acquire_read(esp_gmf_db_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_data_bus_t *db = (esp_gmf_data_bus_t *)handle;
+    return esp_gmf_db_acquire_read_by(db, db->op.acquire_read, blk, wanted_size, block_ticks);
+}
+
 esp_gmf_err_io_t esp_gmf_db_release_read(esp_gmf_db_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
@@ -95,6 +513,50 @@ esp_gmf_err_io_t esp_gmf_db_release_read(esp_gmf_db_handle_t handle, esp_gmf_dat
     if (db->op.release_read) {
         ret = db->op.release_read(db->child, blk, block_ticks);
     }
+    esp_gmf_db_meta_unhold(db);
+    esp_gmf_db_set_reading(db, false, 0);
+    esp_gmf_db_stats_watermark(db, false);
+    esp_gmf_db_notify(db, ESP_GMF_DB_READY_WRITE);
+    return ret;
+}
+
+esp_gmf_err_io_t esp_gmf_db_acquire_read_batch(esp_gmf_db_handle_t handle, esp_gmf_data_bus_block_t *blks[], int max_cnt, uint32_t wanted_size, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, blks, return ESP_GMF_IO_FAIL);
+    ESP_GMF_CHECK(TAG, (max_cnt > 0), return ESP_GMF_IO_FAIL, "Invalid batch count");
+    esp_gmf_data_bus_t *db = (esp_gmf_data_bus_t *)handle;
+    if (db->op.acquire_read_batch == NULL) {
+        esp_gmf_err_io_t ret = esp_gmf_db_acquire_read(handle, blks[0], wanted_size, block_ticks);
+        return ret < ESP_GMF_IO_OK ? ret : 1;
+    }
+    int64_t start = esp_gmf_db_stats_start(db, ESP_GMF_DB_READY_READ, wanted_size, block_ticks);
+    // Nothing is dropped while the reader holds a batch
+    esp_gmf_db_set_reading(db, true, 0);
+    esp_gmf_err_io_t ret = db->op.acquire_read_batch(db->child, blks, max_cnt, block_ticks);
+    if (ret < ESP_GMF_IO_OK) {
+        esp_gmf_db_set_reading(db, false, 0);
+    }
+    esp_gmf_db_stats_end(db, ESP_GMF_DB_READY_READ, true, start, ret);
+    return ret;
+}
+
+esp_gmf_err_io_t esp_gmf_db_release_read_batch(esp_gmf_db_handle_t handle, esp_gmf_data_bus_block_t *blks[], int cnt, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, blks, return ESP_GMF_IO_FAIL);
+    esp_gmf_data_bus_t *db = (esp_gmf_data_bus_t *)handle;
+    if (db->op.release_read_batch == NULL) {
+        ESP_GMF_CHECK(TAG, (cnt == 1), return ESP_GMF_IO_FAIL, "Release more than one block without batch support");
+        return esp_gmf_db_release_read(handle, blks[0], block_ticks);
+    }
+    esp_gmf_err_io_t ret = db->op.release_read_batch(db->child, blks, cnt, block_ticks);
+    for (int i = 0; i < cnt; i++) {
+        esp_gmf_db_meta_take(db, blks[i]->valid_size);
+    }
+    esp_gmf_db_set_reading(db, false, 0);
+    esp_gmf_db_stats_watermark(db, false);
+    esp_gmf_db_notify(db, ESP_GMF_DB_READY_WRITE);
     return ret;
 }
 
@@ -103,23 +565,150 @@ esp_gmf_err_io_t esp_gmf_db_acquire_write(esp_gmf_db_handle_t handle, esp_gmf_da
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
     esp_gmf_data_bus_t *db = (esp_gmf_data_bus_t *)handle;
     esp_gmf_err_io_t ret = ESP_GMF_ERR_OK;
-    if (db->op.acquire_write) {
+    // The writer of a byte data bus given its own buffer waits on the copy in `esp_gmf_db_release_write`
+    bool is_copy = (db->type == DATA_BUS_TYPE_BYTE) && blk && blk->buf;
+    int64_t start = is_copy ? 0 : esp_gmf_db_stats_start(db, ESP_GMF_DB_READY_WRITE, wanted_size, block_ticks);
+    if (db->op.acquire_write && (db->drop_policy != ESP_GMF_DB_DROP_NONE)) {
+        ret = esp_gmf_db_drop_acquire_write(db, blk, wanted_size, block_ticks);
+    } else if (db->op.acquire_write) {
         ret = db->op.acquire_write(db->child, blk, wanted_size, block_ticks);
     }
+    esp_gmf_db_stats_end(db, ESP_GMF_DB_READY_WRITE, true, start, ret);
+    return ret;
+}
+
+static esp_gmf_err_io_t esp_gmf_db_release_write_meta(esp_gmf_data_bus_t *db, esp_gmf_data_bus_block_t *blk, const esp_gmf_db_meta_t *meta, int block_ticks)
+{
+    esp_gmf_err_io_t ret = ESP_GMF_ERR_OK;
+    int64_t start = ((db->type == DATA_BUS_TYPE_BYTE) && blk) ? esp_gmf_db_stats_start(db, ESP_GMF_DB_READY_WRITE, blk->valid_size, block_ticks) : 0;
+    if (db->is_dropping && blk) {
+        ret = esp_gmf_db_drop_release_write(db, blk, meta, block_ticks);
+    } else if (db->op.release_write) {
+        uint32_t size = blk ? blk->valid_size : 0;
+        esp_gmf_db_meta_put(db, meta, size);
+        ret = db->op.release_write(db->child, blk, block_ticks);
+        if (ret < ESP_GMF_IO_OK) {
+            esp_gmf_db_meta_cancel(db, size);
+        }
+    }
+    esp_gmf_db_stats_end(db, ESP_GMF_DB_READY_WRITE, false, start, ret);
+    esp_gmf_db_stats_watermark(db, true);
+    if (blk && blk->is_last) {
+        // The last block marks the writing done as `esp_gmf_db_done_write` does
+        db->_is_done = 1;
+    }
+    esp_gmf_db_notify(db, ESP_GMF_DB_READY_READ);
     return ret;
 }
 
 esp_gmf_err_io_t esp_gmf_db_release_write(esp_gmf_db_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    return esp_gmf_db_release_write_meta((esp_gmf_data_bus_t *)handle, blk, NULL, block_ticks);
+}
+
+static inline void esp_gmf_db_payload_to_block(const esp_gmf_payload_t *load, esp_gmf_data_bus_block_t *blk)
+{
+    blk->buf = load->buf;
+    blk->buf_length = load->buf_length;
+    blk->valid_size = load->valid_size;
+    blk->is_last = load->is_done;
+}
+
+static inline void esp_gmf_db_block_to_payload(const esp_gmf_data_bus_block_t *blk, esp_gmf_payload_t *load)
+{
+    load->buf = blk->buf;
+    load->buf_length = blk->buf_length;
+    load->valid_size = blk->valid_size;
+    load->is_done = blk->is_last;
+}
+
+esp_gmf_err_io_t esp_gmf_db_acquire_payload_read(esp_gmf_db_handle_t handle, esp_gmf_payload_t *load, uint32_t wanted_size, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, load, return ESP_GMF_IO_FAIL);
+    esp_gmf_data_bus_block_t blk = {0};
+    esp_gmf_db_payload_to_block(load, &blk);
+    esp_gmf_err_io_t ret = esp_gmf_db_acquire_read(handle, &blk, wanted_size, block_ticks);
+    if (ret >= ESP_GMF_IO_OK) {
+        esp_gmf_db_meta_t meta;
+        esp_gmf_db_meta_get((esp_gmf_data_bus_t *)handle, &meta);
+        esp_gmf_db_block_to_payload(&blk, load);
+        load->trace_us = meta.trace_us;
+    }
+    return ret;
+}
+
+esp_gmf_err_io_t esp_gmf_db_acquire_payload_read_in_place(esp_gmf_db_handle_t handle, esp_gmf_payload_t *load, uint32_t wanted_size, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, load, return ESP_GMF_IO_FAIL);
     esp_gmf_data_bus_t *db = (esp_gmf_data_bus_t *)handle;
-    esp_gmf_err_io_t ret = ESP_GMF_ERR_OK;
-    if (db->op.release_write) {
-        ret = db->op.release_write(db->child, blk, block_ticks);
+    ESP_GMF_CHECK(TAG, (db->op.acquire_read_in_place != NULL), return ESP_GMF_IO_FAIL, "The data bus can't be read in place");
+    ESP_GMF_CHECK(TAG, (load->needs_free == 0), return ESP_GMF_IO_FAIL, "The payload owns its buffer, read in place on a block port");
+    esp_gmf_data_bus_block_t blk = {0};
+    esp_gmf_err_io_t ret = esp_gmf_db_acquire_read_by(db, db->op.acquire_read_in_place, &blk, wanted_size, block_ticks);
+    if (ret >= ESP_GMF_IO_OK) {
+        esp_gmf_db_meta_t meta;
+        esp_gmf_db_meta_get(db, &meta);
+        esp_gmf_db_block_to_payload(&blk, load);
+        load->trace_us = meta.trace_us;
+    }
+    return ret;
+}
+
+esp_gmf_err_io_t esp_gmf_db_release_payload_read(esp_gmf_db_handle_t handle, esp_gmf_payload_t *load, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, load, return ESP_GMF_IO_FAIL);
+    esp_gmf_data_bus_block_t blk = {0};
+    esp_gmf_db_payload_to_block(load, &blk);
+    return esp_gmf_db_release_read(handle, &blk, block_ticks);
+}
+
+esp_gmf_err_io_t esp_gmf_db_acquire_payload_write(esp_gmf_db_handle_t handle, esp_gmf_payload_t *load, uint32_t wanted_size, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, load, return ESP_GMF_IO_FAIL);
+    esp_gmf_data_bus_block_t blk = {0};
+    esp_gmf_db_payload_to_block(load, &blk);
+    esp_gmf_err_io_t ret = esp_gmf_db_acquire_write(handle, &blk, wanted_size, block_ticks);
+    if (ret >= ESP_GMF_IO_OK) {
+        esp_gmf_db_block_to_payload(&blk, load);
+    }
+    return ret;
+}
+
+esp_gmf_err_io_t esp_gmf_db_acquire_payload_write_in_place(esp_gmf_db_handle_t handle, esp_gmf_payload_t *load, uint32_t wanted_size, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, load, return ESP_GMF_IO_FAIL);
+    esp_gmf_data_bus_t *db = (esp_gmf_data_bus_t *)handle;
+    ESP_GMF_CHECK(TAG, (db->op.acquire_write_in_place != NULL), return ESP_GMF_IO_FAIL, "The data bus can't be written in place");
+    ESP_GMF_CHECK(TAG, (load->needs_free == 0), return ESP_GMF_IO_FAIL, "The payload owns its buffer, write in place on a block port");
+    esp_gmf_data_bus_block_t blk = {0};
+    // The writer waits for the space on acquire, as a block type data bus does
+    int64_t start = esp_gmf_db_stats_start(db, ESP_GMF_DB_READY_WRITE, wanted_size, block_ticks);
+    esp_gmf_err_io_t ret = db->op.acquire_write_in_place(db->child, &blk, wanted_size, block_ticks);
+    esp_gmf_db_stats_end(db, ESP_GMF_DB_READY_WRITE, true, start, ret);
+    if (ret >= ESP_GMF_IO_OK) {
+        blk.is_last = false;
+        esp_gmf_db_block_to_payload(&blk, load);
     }
     return ret;
 }
 
+esp_gmf_err_io_t esp_gmf_db_release_payload_write(esp_gmf_db_handle_t handle, esp_gmf_payload_t *load, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, load, return ESP_GMF_IO_FAIL);
+    esp_gmf_data_bus_block_t blk = {0};
+    esp_gmf_db_payload_to_block(load, &blk);
+    esp_gmf_db_meta_t meta = {
+        .trace_us = load->trace_us,
+        .meta_flag = load->meta_flag,
+    };
+    return esp_gmf_db_release_write_meta((esp_gmf_data_bus_t *)handle, &blk, &meta, block_ticks);
+}
+
 esp_gmf_err_t esp_gmf_db_done_write(esp_gmf_db_handle_t handle)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
@@ -128,6 +717,8 @@ esp_gmf_err_t esp_gmf_db_done_write(esp_gmf_db_handle_t handle)
     if (db->op.done_write) {
         ret = db->op.done_write(db->child);
     }
+    db->_is_done = 1;
+    esp_gmf_db_notify(db, ESP_GMF_DB_READY_READ);
     return ret;
 }
 
@@ -139,6 +730,7 @@ esp_gmf_err_t esp_gmf_db_reset_done_write(esp_gmf_db_handle_t handle)
     if (db->op.reset_done_write) {
         ret = db->op.reset_done_write(db->child);
     }
+    db->_is_done = 0;
     return ret;
 }
 
@@ -150,6 +742,12 @@ esp_gmf_err_t esp_gmf_db_reset(esp_gmf_db_handle_t handle)
     if (db->op.reset) {
         ret = db->op.reset(db->child);
     }
+    db->_is_done = 0;
+    db->_is_abort = 0;
+    db->wait_key = false;
+    esp_gmf_db_meta_keep(db, 0);
+    esp_gmf_db_meta_hold(db, 0);
+    esp_gmf_db_notify(db, ESP_GMF_DB_READY_WRITE);
     return ret;
 }
 
@@ -161,6 +759,9 @@ esp_gmf_err_t esp_gmf_db_abort(esp_gmf_db_handle_t handle)
     if (db->op.abort) {
         ret = db->op.abort(db->child);
     }
+    db->_is_abort = 1;
+    esp_gmf_db_notify(db, ESP_GMF_DB_READY_READ);
+    esp_gmf_db_notify(db, ESP_GMF_DB_READY_WRITE);
     return ret;
 }
 
@@ -252,3 +853,142 @@ const char *esp_gmf_db_get_name(esp_gmf_db_handle_t handle)
     esp_gmf_data_bus_t *db = (esp_gmf_data_bus_t *)handle;
     return db->name;
 }
+
+esp_gmf_err_t esp_gmf_db_is_ready(esp_gmf_db_handle_t handle, esp_gmf_db_ready_t type, uint32_t wanted_size, bool *ready)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, ready, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_CHECK(TAG, (type < ESP_GMF_DB_READY_MAX), return ESP_GMF_ERR_INVALID_ARG, "Invalid ready type");
+    esp_gmf_data_bus_t *db = (esp_gmf_data_bus_t *)handle;
+    *ready = true;
+    if (db->_is_abort || ((type == ESP_GMF_DB_READY_READ) && db->_is_done)) {
+        return ESP_GMF_ERR_OK;
+    }
+    if ((type == ESP_GMF_DB_READY_WRITE) && (db->drop_policy != ESP_GMF_DB_DROP_NONE)) {
+        // The writer drops the data instead of waiting
+        return ESP_GMF_ERR_OK;
+    }
+    uint32_t size = 0;
+    uint32_t total = 0;
+    if (db->type == DATA_BUS_TYPE_BYTE) {
+        // A byte data bus acquires the whole wanted size, which can't exceed the capacity
+        if (db->op.get_total_size && (db->op.get_total_size(db->child, &total) == ESP_GMF_ERR_OK) && (total < wanted_size)) {
+            wanted_size = total;
+        }
+    } else {
+        // A block data bus acquires one block whatever its size
+        wanted_size = 1;
+    }
+    if (wanted_size == 0) {
+        wanted_size = 1;
+    }
+    if (type == ESP_GMF_DB_READY_READ) {
+        if (db->op.get_filled_size && (db->op.get_filled_size(db->child, &size) == ESP_GMF_ERR_OK)) {
+            *ready = (size >= wanted_size);
+        }
+    } else if ((db->type == DATA_BUS_TYPE_BYTE) && db->op.get_available
+               && (db->op.get_available(db->child, &size) == ESP_GMF_ERR_OK)) {
+        *ready = (size >= wanted_size);
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_db_set_notify(esp_gmf_db_handle_t handle, esp_gmf_db_ready_t type, esp_gmf_db_notify_cb cb, void *ctx)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_CHECK(TAG, (type < ESP_GMF_DB_READY_MAX), return ESP_GMF_ERR_INVALID_ARG, "Invalid ready type");
+    esp_gmf_data_bus_t *db = (esp_gmf_data_bus_t *)handle;
+    esp_gmf_err_t ret = ESP_GMF_ERR_OK;
+    esp_gmf_oal_mutex_lock(db->notify_lock);
+    int i = 0;
+    while ((i < db->notify_cnt[type]) && (db->notify_ctx[type][i] != ctx)) {
+        i++;
+    }
+    if (cb) {
+        if (i < ESP_GMF_DB_NOTIFY_MAX) {
+            db->notify[type][i] = cb;
+            db->notify_ctx[type][i] = ctx;
+            db->notify_cnt[type] += (i == db->notify_cnt[type]);
+        } else {
+            ESP_LOGE(TAG, "No room for the notification of %s, [%p-%s]", type == ESP_GMF_DB_READY_READ ? "reader" : "writer", db, db->name);
+            ret = ESP_GMF_ERR_NOT_ENOUGH;
+        }
+    } else if (ctx == NULL) {
+        db->notify_cnt[type] = 0;
+    } else if (i < db->notify_cnt[type]) {
+        // Keep the callbacks packed, so the notification only walks the used ones
+        db->notify_cnt[type]--;
+        db->notify[type][i] = db->notify[type][db->notify_cnt[type]];
+        db->notify_ctx[type][i] = db->notify_ctx[type][db->notify_cnt[type]];
+    }
+    esp_gmf_oal_mutex_unlock(db->notify_lock);
+    return ret;
+}
+
+esp_gmf_err_t esp_gmf_db_notify_ready(esp_gmf_db_handle_t handle, esp_gmf_db_ready_t type)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_CHECK(TAG, (type < ESP_GMF_DB_READY_MAX), return ESP_GMF_ERR_INVALID_ARG, "Invalid ready type");
+    esp_gmf_db_notify((esp_gmf_data_bus_t *)handle, type);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_db_set_drop_policy(esp_gmf_db_handle_t handle, esp_gmf_db_drop_policy_t policy)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_CHECK(TAG, (policy <= ESP_GMF_DB_DROP_TO_KEY_FRAME), return ESP_GMF_ERR_INVALID_ARG, "Invalid drop policy");
+    esp_gmf_data_bus_t *db = (esp_gmf_data_bus_t *)handle;
+    if ((policy != ESP_GMF_DB_DROP_NONE) && ((db->type != DATA_BUS_TYPE_BLOCK) || (db->op.acquire_write == NULL))) {
+        ESP_LOGE(TAG, "The data bus can't drop data, db:%p-%s, type:%d", db, db->name, db->type);
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+    if ((policy == ESP_GMF_DB_DROP_OLDEST) && ((db->op.acquire_read == NULL) || (db->op.release_read == NULL))) {
+        ESP_LOGE(TAG, "The data bus can't drop the oldest data, db:%p-%s", db, db->name);
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+    if ((policy == ESP_GMF_DB_DROP_OLDEST) && (db->drop_lock == NULL)) {
+        db->drop_lock = esp_gmf_oal_mutex_create();
+        ESP_GMF_MEM_CHECK(TAG, db->drop_lock, return ESP_GMF_ERR_MEMORY_LACK);
+    }
+    db->drop_policy = policy;
+    db->wait_key = false;
+    ESP_LOGD(TAG, "Set drop policy:%d, db:%p-%s", policy, db, db->name);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_db_get_dropped(esp_gmf_db_handle_t handle, uint32_t *dropped_cnt)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, dropped_cnt, return ESP_GMF_ERR_INVALID_ARG);
+    *dropped_cnt = ((esp_gmf_data_bus_t *)handle)->dropped_cnt;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_db_get_stats(esp_gmf_db_handle_t handle, esp_gmf_db_stats_t *stats)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, stats, return ESP_GMF_ERR_INVALID_ARG);
+#ifdef CONFIG_ESP_GMF_DB_STATS_EN
+    esp_gmf_data_bus_t *db = (esp_gmf_data_bus_t *)handle;
+    memcpy(stats, &db->stats, sizeof(esp_gmf_db_stats_t));
+    if (stats->low_watermark == UINT32_MAX) {
+        stats->low_watermark = 0;
+    }
+    return ESP_GMF_ERR_OK;
+#else
+    return ESP_GMF_ERR_NOT_SUPPORT;
+#endif  /* CONFIG_ESP_GMF_DB_STATS_EN */
+}
+
+esp_gmf_err_t esp_gmf_db_reset_stats(esp_gmf_db_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+#ifdef CONFIG_ESP_GMF_DB_STATS_EN
+    esp_gmf_data_bus_t *db = (esp_gmf_data_bus_t *)handle;
+    memset(&db->stats, 0, sizeof(esp_gmf_db_stats_t));
+    db->stats.low_watermark = UINT32_MAX;
+    return ESP_GMF_ERR_OK;
+#else
+    return ESP_GMF_ERR_NOT_SUPPORT;
+#endif  /* CONFIG_ESP_GMF_DB_STATS_EN */
+}
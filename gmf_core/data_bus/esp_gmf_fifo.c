@@ -19,6 +19,7 @@
 static const char *TAG = "ESP_GMF_FIFO";
 
 #define GMF_FIFO_DEFAULT_ALIGNMENT (16)
+#define GMF_FIFO_MIN_CLASS_SIZE    (64)
 
 typedef struct esp_esp_gmf_fifo_node {
     struct esp_esp_gmf_fifo_node *next;
@@ -42,6 +43,11 @@ typedef struct {
     uint8_t              _is_write_done : 1;  /*!< Flag indicating if all writing operations to the FIFO have been completed. Set to 1 when writing is finished */
     uint8_t              _is_abort      : 1;  /*!< Flag indicating if an abort operation has been requested. Set to 1 to signal that FIFO operations should be aborted */
     uint8_t              align;               /*!< Alignment for the request buffer */
+    uint32_t             max_node_size;       /*!< Size of the preallocated buffers, 0 means the buffers are allocated on demand */
+    uint32_t             min_capacity;        /*!< Capacity which an adaptive FIFO shrinks back to */
+    uint32_t             max_capacity;        /*!< Capacity which an adaptive FIFO grows up to, 0 means the capacity is fixed */
+    TickType_t           quiet_ticks;         /*!< Period without writer stall after which an adaptive FIFO shrinks by one node */
+    TickType_t           last_stall;          /*!< Tick of the last writer stall */
 } esp_gmf_fifo_t;
 
 static inline esp_gmf_fifo_node_t *esp_gmf_fifo_node_create(void)
@@ -72,6 +78,92 @@ static inline esp_gmf_fifo_node_t *esp_gmf_fifo_node_with_buf_create(size_t buf_
     return node;
 }
 
+static inline size_t esp_gmf_fifo_size_class(size_t size)
+{
+    if (size <= GMF_FIFO_MIN_CLASS_SIZE) {
+        return GMF_FIFO_MIN_CLASS_SIZE;
+    }
+    // Round up to a quarter of the highest power of two, which wastes at most 25%
+    size_t step = GMF_FIFO_MIN_CLASS_SIZE;
+    while ((step << 3) <= size) {
+        step <<= 1;
+    }
+    return (size + step - 1) & ~(step - 1);
+}
+
+static inline int esp_gmf_fifo_node_realloc(esp_gmf_fifo_node_t *node, size_t buf_size, uint8_t align)
+{
+    esp_gmf_oal_free(node->buffer);
+    node->buf_length = 0;
+    node->buffer = esp_gmf_oal_malloc_align(align, buf_size);
+    if (!node->buffer) {
+        return ESP_GMF_ERR_MEMORY_LACK;
+    }
+    node->buf_length = buf_size;
+    return ESP_GMF_ERR_OK;
+}
+
+/**
+ * @brief  Move the smallest empty node which fits the wanted size to the head of the empty list,
+ *         or the smallest empty node when none fits. Return true if the head fits
+ */
+static inline bool esp_gmf_fifo_pick_empty(esp_gmf_fifo_t *fifo, size_t wanted_size)
+{
+    esp_gmf_fifo_node_t **best = NULL;
+    esp_gmf_fifo_node_t **smallest = NULL;
+    for (esp_gmf_fifo_node_t **link = &fifo->empty_head; *link; link = &(*link)->next) {
+        size_t length = (*link)->buf_length;
+        if ((length >= wanted_size) && (best == NULL || length < (*best)->buf_length)) {
+            best = link;
+        }
+        if (smallest == NULL || length < (*smallest)->buf_length) {
+            smallest = link;
+        }
+    }
+    esp_gmf_fifo_node_t **pick = best ? best : smallest;
+    if (pick && (*pick != fifo->empty_head)) {
+        esp_gmf_fifo_node_t *node = *pick;
+        *pick = node->next;
+        node->next = fifo->empty_head;
+        fifo->empty_head = node;
+    }
+    return best != NULL;
+}
+
+/**
+ * @brief  Record a writer stall on the full FIFO, an adaptive FIFO grows by one node within its ceiling
+ *         It must be called with the lock taken
+ */
+static inline void esp_gmf_fifo_adapt_grow(esp_gmf_fifo_t *fifo)
+{
+    if (fifo->max_capacity == 0) {
+        return;
+    }
+    fifo->last_stall = xTaskGetTickCount();
+    if (fifo->capacity < fifo->max_capacity) {
+        fifo->capacity++;
+        ESP_LOGD(TAG, "Grow, hd:%p, capacity:%ld", fifo, fifo->capacity);
+    }
+}
+
+/**
+ * @brief  Shrink an adaptive FIFO by one node after a quiet period, return true if the node being released has to be freed
+ *         It must be called with the lock taken
+ */
+static inline bool esp_gmf_fifo_adapt_shrink(esp_gmf_fifo_t *fifo)
+{
+    if (fifo->max_capacity) {
+        TickType_t now = xTaskGetTickCount();
+        if ((fifo->capacity > fifo->min_capacity) && ((now - fifo->last_stall) >= fifo->quiet_ticks)) {
+            fifo->capacity--;
+            fifo->last_stall = now;
+            ESP_LOGD(TAG, "Shrink, hd:%p, capacity:%ld", fifo, fifo->capacity);
+        }
+    }
+    // Only the consumed node is freed, so no data is dropped
+    return fifo->node_cnt > fifo->capacity;
+}
+
 static inline int esp_gmf_fifo_node_get_cnt(esp_gmf_fifo_node_t *node)
 {
     int cnt = 0;
@@ -157,6 +249,60 @@ esp_gmf_err_t esp_gmf_fifo_set_align(esp_gmf_fifo_handle_t handle, uint8_t align
     return ESP_GMF_ERR_OK;
 }
 
+esp_gmf_err_t esp_gmf_fifo_prealloc(esp_gmf_fifo_handle_t handle, uint32_t max_node_size)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_fifo_t *fifo = (esp_gmf_fifo_t *)handle;
+    esp_gmf_oal_mutex_lock(fifo->lock);
+    fifo->max_node_size = max_node_size;
+    if (max_node_size == 0) {
+        esp_gmf_oal_mutex_unlock(fifo->lock);
+        return ESP_GMF_ERR_OK;
+    }
+    int ret = ESP_GMF_ERR_OK;
+    esp_gmf_fifo_node_t *node = fifo->empty_head;
+    while (node && (ret == ESP_GMF_ERR_OK)) {
+        if (node->buf_length != max_node_size) {
+            ret = esp_gmf_fifo_node_realloc(node, max_node_size, fifo->align);
+        }
+        node = node->next;
+    }
+    while ((ret == ESP_GMF_ERR_OK) && (fifo->node_cnt < fifo->capacity)) {
+        node = esp_gmf_fifo_node_with_buf_create(max_node_size, fifo->align);
+        if (node == NULL) {
+            ret = ESP_GMF_ERR_MEMORY_LACK;
+            break;
+        }
+        node->next = fifo->empty_head;
+        fifo->empty_head = node;
+        fifo->node_cnt++;
+    }
+    esp_gmf_oal_mutex_unlock(fifo->lock);
+    ESP_LOGD(TAG, "Preallocated, hd:%p, size:%ld, n:%ld, ret:%d", handle, max_node_size, fifo->node_cnt, ret);
+    return ret;
+}
+
+esp_gmf_err_t esp_gmf_fifo_set_adaptive(esp_gmf_fifo_handle_t handle, int max_block_cnt, uint32_t quiet_ms)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_fifo_t *fifo = (esp_gmf_fifo_t *)handle;
+    esp_gmf_oal_mutex_lock(fifo->lock);
+    if (fifo->max_capacity == 0) {
+        fifo->min_capacity = fifo->capacity;
+    }
+    if (max_block_cnt <= (int)fifo->min_capacity) {
+        // Back to the fixed capacity, the surplus nodes are freed when they are released
+        fifo->capacity = fifo->min_capacity;
+        fifo->max_capacity = 0;
+    } else {
+        fifo->max_capacity = max_block_cnt;
+        fifo->quiet_ticks = pdMS_TO_TICKS(quiet_ms);
+        fifo->last_stall = xTaskGetTickCount();
+    }
+    esp_gmf_oal_mutex_unlock(fifo->lock);
+    return ESP_GMF_ERR_OK;
+}
+
 esp_gmf_err_t esp_gmf_fifo_destroy(esp_gmf_fifo_handle_t handle)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
@@ -171,6 +317,7 @@ esp_gmf_err_io_t esp_gmf_fifo_acquire_read(esp_gmf_fifo_handle_t handle, esp_gmf
     esp_gmf_fifo_t *fifo = (esp_gmf_fifo_t *)handle;
     ESP_LOGD(TAG, "RD_ACQ+, hd:%p, wanted:%ld, ticks:%d", handle, wanted_size, block_ticks);
     if (fifo->fill_head == NULL) {
+        // The reader underrun is not a reason to grow, more blocks don't bring the data any sooner
         while (fifo->fill_head == NULL) {
             if (xSemaphoreTake(fifo->can_read, block_ticks) != pdTRUE) {
                 ESP_LOGE(TAG, "FIFO acquire read timeout");
@@ -210,7 +357,10 @@ esp_gmf_err_io_t esp_gmf_fifo_release_read(esp_gmf_fifo_handle_t handle, esp_gmf
     node->is_done = false;
     node->valid_size = 0;
     node->next = NULL;
-    if (fifo->empty_head == NULL) {
+    if (esp_gmf_fifo_adapt_shrink(fifo)) {
+        esp_gmf_fifo_node_destroy(node);
+        fifo->node_cnt--;
+    } else if (fifo->empty_head == NULL) {
         fifo->empty_head = node;
     } else {
         esp_gmf_fifo_node_t *tmp = fifo->empty_head;
@@ -226,6 +376,76 @@ esp_gmf_err_io_t esp_gmf_fifo_release_read(esp_gmf_fifo_handle_t handle, esp_gmf
     return ESP_GMF_ERR_OK;
 }
 
+esp_gmf_err_io_t esp_gmf_fifo_acquire_read_batch(esp_gmf_fifo_handle_t handle, esp_gmf_data_bus_block_t *blks[], int max_cnt, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, blks, return ESP_GMF_IO_FAIL);
+    ESP_GMF_CHECK(TAG, (max_cnt > 0), return ESP_GMF_IO_FAIL, "Invalid batch count");
+    // Only the first block is waited for, the others are the ones already filled
+    esp_gmf_err_io_t ret = esp_gmf_fifo_acquire_read(handle, blks[0], 0, block_ticks);
+    if (ret != ESP_GMF_IO_OK) {
+        return ret;
+    }
+    esp_gmf_fifo_t *fifo = (esp_gmf_fifo_t *)handle;
+    int cnt = 1;
+    esp_gmf_oal_mutex_lock(fifo->lock);
+    esp_gmf_fifo_node_t *node = fifo->fill_head->next;
+    for (; node && (cnt < max_cnt) && (blks[cnt - 1]->is_last == false); node = node->next, cnt++) {
+        blks[cnt]->buf = node->buffer;
+        blks[cnt]->buf_length = node->buf_length;
+        blks[cnt]->valid_size = node->valid_size;
+        blks[cnt]->is_last = node->is_done;
+    }
+    esp_gmf_oal_mutex_unlock(fifo->lock);
+    ESP_LOGD(TAG, "RD_ACQ_BATCH, hd:%p, cnt:%d, max:%d", handle, cnt, max_cnt);
+    return cnt;
+}
+
+esp_gmf_err_io_t esp_gmf_fifo_release_read_batch(esp_gmf_fifo_handle_t handle, esp_gmf_data_bus_block_t *blks[], int cnt, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, blks, return ESP_GMF_IO_FAIL);
+    ESP_GMF_CHECK(TAG, (cnt > 0), return ESP_GMF_IO_FAIL, "Invalid batch count");
+    esp_gmf_fifo_t *fifo = (esp_gmf_fifo_t *)handle;
+    esp_gmf_oal_mutex_lock(fifo->lock);
+    esp_gmf_fifo_node_t *node = fifo->fill_head;
+    for (int i = 0; i < cnt; i++, node = node->next) {
+        if ((node == NULL) || (node->buffer != blks[i]->buf)) {
+            ESP_LOGE(TAG, "Release read batch error, buffer %d not match", i);
+            esp_gmf_oal_mutex_unlock(fifo->lock);
+            return ESP_GMF_IO_FAIL;
+        }
+    }
+    // All the blocks are checked, move them to the empty list at once and wake up the writer once
+    esp_gmf_fifo_node_t *tail = fifo->empty_head;
+    while (tail && tail->next) {
+        tail = tail->next;
+    }
+    for (int i = 0; i < cnt; i++) {
+        node = fifo->fill_head;
+        fifo->fill_head = node->next;
+        node->is_done = false;
+        node->valid_size = 0;
+        node->next = NULL;
+        if (esp_gmf_fifo_adapt_shrink(fifo)) {
+            esp_gmf_fifo_node_destroy(node);
+            fifo->node_cnt--;
+            continue;
+        }
+        if (tail) {
+            tail->next = node;
+        } else {
+            fifo->empty_head = node;
+        }
+        tail = node;
+    }
+    xSemaphoreGive(fifo->can_write);
+    esp_gmf_oal_mutex_unlock(fifo->lock);
+    ESP_LOGD(TAG, "RD_RLS_BATCH, hd:%p, cnt:%d, n:%ld, e:%d, f:%d", handle, cnt, fifo->node_cnt,
+             esp_gmf_fifo_node_get_cnt(fifo->empty_head), esp_gmf_fifo_node_get_cnt(fifo->fill_head));
+    return ESP_GMF_IO_OK;
+}
+
 esp_gmf_err_io_t esp_gmf_fifo_acquire_write(esp_gmf_fifo_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int block_ticks)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_IO_FAIL);
@@ -235,15 +455,25 @@ esp_gmf_err_io_t esp_gmf_fifo_acquire_write(esp_gmf_fifo_handle_t handle, esp_gm
     ESP_LOGD(TAG, "WR_ACQ+, hd:%p, wanted:%ld, ticks:%d", handle, wanted_size, block_ticks);
     esp_gmf_fifo_node_t *node = NULL;
     esp_gmf_oal_mutex_lock(fifo->lock);
-    if (fifo->empty_head == NULL) {
+    if (fifo->max_node_size && (wanted_size > fifo->max_node_size)) {
+        ESP_LOGE(TAG, "Wanted size %ld exceeds the preallocated node size %ld", wanted_size, fifo->max_node_size);
+        esp_gmf_oal_mutex_unlock(fifo->lock);
+        return ESP_GMF_IO_FAIL;
+    }
+    if (esp_gmf_fifo_pick_empty(fifo, wanted_size) == false) {
+        if ((fifo->empty_head == NULL) && (fifo->node_cnt >= fifo->capacity)) {
+            esp_gmf_fifo_adapt_grow(fifo);
+        }
         if (fifo->node_cnt < fifo->capacity) {
-            node = esp_gmf_fifo_node_with_buf_create(wanted_size, fifo->align);
+            size_t size = fifo->max_node_size ? fifo->max_node_size : esp_gmf_fifo_size_class(wanted_size);
+            node = esp_gmf_fifo_node_with_buf_create(size, fifo->align);
             ESP_GMF_NULL_CHECK(TAG, node, {esp_gmf_oal_mutex_unlock(fifo->lock); return ESP_GMF_ERR_MEMORY_LACK;});
+            node->next = fifo->empty_head;
             fifo->empty_head = node;
             fifo->node_cnt++;
             ESP_LOGD(TAG, "New an empty node:%p, addr:%p, n:%ld, e:%d, f:%d", node, node->buffer, fifo->node_cnt,
                      esp_gmf_fifo_node_get_cnt(fifo->empty_head), esp_gmf_fifo_node_get_cnt(fifo->fill_head));
-        } else {
+        } else if (fifo->empty_head == NULL) {
             esp_gmf_oal_mutex_unlock(fifo->lock);
             while (fifo->empty_head == NULL) {
                 if (xSemaphoreTake(fifo->can_write, block_ticks) != pdTRUE) {
@@ -254,14 +484,15 @@ esp_gmf_err_io_t esp_gmf_fifo_acquire_write(esp_gmf_fifo_handle_t handle, esp_gm
                 }
             }
             esp_gmf_oal_mutex_lock(fifo->lock);
+            esp_gmf_fifo_pick_empty(fifo, wanted_size);
         }
     }
     node = fifo->empty_head;
     if (node->buf_length < wanted_size) {
-        esp_gmf_oal_free(node->buffer);
-        node->buffer = esp_gmf_oal_malloc(wanted_size);
-        ESP_GMF_NULL_CHECK(TAG, node->buffer, {esp_gmf_oal_mutex_unlock(fifo->lock); return ESP_GMF_ERR_MEMORY_LACK;});
-        node->buf_length = wanted_size;
+        // Grow the smallest free buffer, to the preallocated size so that it fits next time
+        size_t size = fifo->max_node_size ? fifo->max_node_size : esp_gmf_fifo_size_class(wanted_size);
+        int ret = esp_gmf_fifo_node_realloc(node, size, fifo->align);
+        ESP_GMF_RET_ON_ERROR(TAG, ret, {esp_gmf_oal_mutex_unlock(fifo->lock); return ESP_GMF_ERR_MEMORY_LACK;}, "Failed to grow node to %d", size);
     }
 
     blk->buf = node->buffer;
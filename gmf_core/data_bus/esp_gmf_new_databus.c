@@ -13,9 +13,11 @@
 
 #include "esp_gmf_data_bus.h"
 #include "esp_gmf_ringbuffer.h"
+#include "esp_gmf_spsc_rb.h"
 #include "esp_gmf_block.h"
 #include "esp_gmf_pbuf.h"
 #include "esp_gmf_fifo.h"
+#include "esp_gmf_bcast.h"
 
 static const char *TAG = "NEW_DATA_BUS";
 
@@ -48,6 +50,8 @@ int esp_gmf_db_new_ringbuf(int num, int item_cnt, esp_gmf_db_handle_t *h)
     db->op.release_read = esp_gmf_rb_release_read;
     db->op.acquire_write = esp_gmf_rb_acquire_write;
     db->op.release_write = esp_gmf_rb_release_write;
+    db->op.acquire_read_in_place = esp_gmf_rb_acquire_read_in_place;
+    db->op.acquire_write_in_place = esp_gmf_rb_acquire_write_in_place;
     db->op.done_write = esp_gmf_rb_done_write;
     db->op.reset_done_write = esp_gmf_rb_reset_done_write;
     db->op.reset = esp_gmf_rb_reset;
@@ -60,6 +64,47 @@ int esp_gmf_db_new_ringbuf(int num, int item_cnt, esp_gmf_db_handle_t *h)
     return ESP_GMF_ERR_OK;
 }
 
+int esp_gmf_db_new_spsc_ringbuf(int num, int item_cnt, esp_gmf_db_handle_t *h)
+{
+    ESP_GMF_NULL_CHECK(TAG, h, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_spsc_rb_handle_t rb = NULL;
+    esp_gmf_spsc_rb_create(num, item_cnt, &rb);
+    ESP_GMF_NULL_CHECK(TAG, rb, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_db_config_t db_config = {
+        .name = "spsc_ringbuffer",
+        .type = DATA_BUS_TYPE_BYTE,
+        .max_size = (item_cnt * num),
+        .max_item_num = num,
+        .child = rb,
+    };
+    esp_gmf_data_bus_t *db = NULL;
+    if (ESP_GMF_ERR_OK != esp_gmf_db_init(&db_config, (esp_gmf_db_handle_t)&db)) {
+        if (rb) {
+            esp_gmf_spsc_rb_destroy(rb);
+        }
+        return ESP_GMF_ERR_MEMORY_LACK;
+    }
+    if (db == NULL) {
+        ESP_LOGE(TAG, "DATA BUS is NULL");
+        return ESP_GMF_ERR_FAIL;
+    }
+    db->op.deinit = esp_gmf_spsc_rb_destroy;
+    db->op.acquire_read = esp_gmf_spsc_rb_acquire_read;
+    db->op.release_read = esp_gmf_spsc_rb_release_read;
+    db->op.acquire_write = esp_gmf_spsc_rb_acquire_write;
+    db->op.release_write = esp_gmf_spsc_rb_release_write;
+    db->op.done_write = esp_gmf_spsc_rb_done_write;
+    db->op.reset_done_write = esp_gmf_spsc_rb_reset_done_write;
+    db->op.reset = esp_gmf_spsc_rb_reset;
+    db->op.abort = esp_gmf_spsc_rb_abort;
+    db->op.get_total_size = esp_gmf_spsc_rb_get_size;
+    db->op.get_filled_size = esp_gmf_spsc_rb_bytes_filled;
+    db->op.get_available = esp_gmf_spsc_rb_bytes_available;
+    ESP_LOGI(TAG, "New SPSC ringbuffer:%p, num:%d, item_cnt:%d, db:%p", rb, num, item_cnt, db);
+    *h = db;
+    return ESP_GMF_ERR_OK;
+}
+
 int esp_gmf_db_new_block(int num, int item_cnt, esp_gmf_db_handle_t *h)
 {
     ESP_GMF_NULL_CHECK(TAG, h, return ESP_GMF_ERR_INVALID_ARG);
@@ -89,6 +134,7 @@ int esp_gmf_db_new_block(int num, int item_cnt, esp_gmf_db_handle_t *h)
     db->op.release_read = esp_gmf_block_release_read;
     db->op.acquire_write = esp_gmf_block_acquire_write;
     db->op.release_write = esp_gmf_block_release_write;
+    db->op.drop_unread = esp_gmf_block_drop_unread;
     db->op.done_write = esp_gmf_block_done_write;
     db->op.reset = esp_gmf_block_reset;
     db->op.abort = esp_gmf_block_abort;
@@ -168,6 +214,8 @@ int esp_gmf_db_new_fifo(int num, int item_cnt, esp_gmf_db_handle_t *h)
     db->op.deinit = esp_gmf_fifo_destroy;
     db->op.acquire_read = esp_gmf_fifo_acquire_read;
     db->op.release_read = esp_gmf_fifo_release_read;
+    db->op.acquire_read_batch = esp_gmf_fifo_acquire_read_batch;
+    db->op.release_read_batch = esp_gmf_fifo_release_read_batch;
     db->op.acquire_write = esp_gmf_fifo_acquire_write;
     db->op.release_write = esp_gmf_fifo_release_write;
     db->op.done_write = esp_gmf_fifo_done_write;
@@ -180,3 +228,117 @@ int esp_gmf_db_new_fifo(int num, int item_cnt, esp_gmf_db_handle_t *h)
     *h = db;
     return ESP_GMF_ERR_OK;
 }
+
+int esp_gmf_db_new_adaptive_fifo(int num, int max_num, uint32_t quiet_ms, esp_gmf_db_handle_t *h)
+{
+    ESP_GMF_NULL_CHECK(TAG, h, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_data_bus_t *db = NULL;
+    int ret = esp_gmf_db_new_fifo(num, 1, (esp_gmf_db_handle_t *)&db);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Failed to create FIFO, ret:%d", ret);
+    ret = esp_gmf_fifo_set_adaptive(db->child, max_num, quiet_ms);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, {esp_gmf_db_deinit(db); return ret;}, "Failed to set adaptive FIFO, ret:%d", ret);
+    ESP_LOGI(TAG, "Adaptive FIFO, num:%d, max_num:%d, quiet:%ldms, db:%p", num, max_num, quiet_ms, db);
+    *h = db;
+    return ESP_GMF_ERR_OK;
+}
+
+int esp_gmf_db_new_broadcast(int num, int item_cnt, esp_gmf_db_handle_t *h)
+{
+    ESP_GMF_NULL_CHECK(TAG, h, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_bcast_handle_t handle = NULL;
+    esp_gmf_bcast_create(num, item_cnt, &handle);
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_db_config_t db_config = {
+        .name = "broadcast",
+        .type = DATA_BUS_TYPE_BLOCK,
+        .max_size = (item_cnt * num),
+        .max_item_num = num,
+        .child = handle,
+    };
+    esp_gmf_data_bus_t *db = NULL;
+    if (ESP_GMF_ERR_OK != esp_gmf_db_init(&db_config, (esp_gmf_db_handle_t)&db)) {
+        if (handle) {
+            esp_gmf_bcast_destroy(handle);
+        }
+        return ESP_GMF_ERR_MEMORY_LACK;
+    }
+    if (db == NULL) {
+        ESP_LOGE(TAG, "DATA BUS is NULL");
+        return ESP_GMF_ERR_FAIL;
+    }
+    db->op.deinit = esp_gmf_bcast_destroy;
+    db->op.acquire_write = esp_gmf_bcast_acquire_write;
+    db->op.release_write = esp_gmf_bcast_release_write;
+    db->op.set_meta = esp_gmf_bcast_set_meta;
+    db->op.done_write = esp_gmf_bcast_done_write;
+    db->op.reset_done_write = esp_gmf_bcast_reset_done_write;
+    db->op.reset = esp_gmf_bcast_reset;
+    db->op.abort = esp_gmf_bcast_abort;
+    db->op.get_total_size = esp_gmf_bcast_get_total_size;
+    db->op.get_available = esp_gmf_bcast_get_free_size;
+    esp_gmf_bcast_set_db(handle, db);
+    ESP_LOGI(TAG, "New broadcast:%p, num:%d, item_cnt:%d, db:%p", handle, num, item_cnt, db);
+    *h = db;
+    return ESP_GMF_ERR_OK;
+}
+
+int esp_gmf_db_new_broadcast_reader(esp_gmf_db_handle_t writer, esp_gmf_bcast_drop_policy_t policy, esp_gmf_db_handle_t *h)
+{
+    ESP_GMF_NULL_CHECK(TAG, writer, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, h, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_data_bus_t *writer_db = (esp_gmf_data_bus_t *)writer;
+    ESP_GMF_CHECK(TAG, (writer_db->op.acquire_write == esp_gmf_bcast_acquire_write), return ESP_GMF_ERR_INVALID_ARG,
+                  "The writer is not a broadcast data bus");
+    esp_gmf_bcast_reader_handle_t reader = NULL;
+    esp_gmf_bcast_reader_create(writer_db->child, policy, &reader);
+    ESP_GMF_NULL_CHECK(TAG, reader, return ESP_GMF_ERR_MEMORY_LACK);
+    esp_gmf_db_config_t db_config = {
+        .name = "broadcast_reader",
+        .type = DATA_BUS_TYPE_BLOCK,
+        .max_size = writer_db->max_size,
+        .max_item_num = writer_db->max_item_num,
+        .child = reader,
+    };
+    esp_gmf_data_bus_t *db = NULL;
+    if (ESP_GMF_ERR_OK != esp_gmf_db_init(&db_config, (esp_gmf_db_handle_t)&db)) {
+        esp_gmf_bcast_reader_destroy(reader);
+        return ESP_GMF_ERR_MEMORY_LACK;
+    }
+    db->op.deinit = esp_gmf_bcast_reader_destroy;
+    db->op.acquire_read = esp_gmf_bcast_reader_acquire_read;
+    db->op.release_read = esp_gmf_bcast_reader_release_read;
+    db->op.get_meta = esp_gmf_bcast_reader_get_meta;
+    db->op.reset = esp_gmf_bcast_reader_reset;
+    db->op.abort = esp_gmf_bcast_reader_abort;
+    db->op.get_total_size = esp_gmf_bcast_reader_get_total_size;
+    db->op.get_filled_size = esp_gmf_bcast_reader_get_filled;
+    esp_gmf_bcast_reader_set_db(reader, db);
+    ESP_LOGI(TAG, "New broadcast reader:%p, policy:%d, writer:%p, db:%p", reader, policy, writer, db);
+    *h = db;
+    return ESP_GMF_ERR_OK;
+}
+
+int esp_gmf_db_broadcast_write_ref(esp_gmf_db_handle_t writer, const esp_gmf_data_bus_block_t *blk, const esp_gmf_db_meta_t *meta,
+                                   esp_gmf_bcast_ref_free_t ref_free, void *ref_ctx, int block_ticks)
+{
+    ESP_GMF_NULL_CHECK(TAG, writer, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, blk, return ESP_GMF_IO_FAIL);
+    esp_gmf_data_bus_t *writer_db = (esp_gmf_data_bus_t *)writer;
+    ESP_GMF_CHECK(TAG, (writer_db->op.acquire_write == esp_gmf_bcast_acquire_write), return ESP_GMF_IO_FAIL,
+                  "The writer is not a broadcast data bus");
+    esp_gmf_err_io_t ret = esp_gmf_bcast_write_ref(writer_db->child, blk, meta, ref_free, ref_ctx, block_ticks);
+    if ((ret == ESP_GMF_IO_OK) && blk->is_last) {
+        // The last block marks the writing done as `esp_gmf_db_release_write` does
+        writer_db->_is_done = 1;
+    }
+    return ret;
+}
+
+int esp_gmf_db_set_broadcast_reader_policy(esp_gmf_db_handle_t reader, esp_gmf_bcast_drop_policy_t policy)
+{
+    ESP_GMF_NULL_CHECK(TAG, reader, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_data_bus_t *reader_db = (esp_gmf_data_bus_t *)reader;
+    ESP_GMF_CHECK(TAG, (reader_db->op.acquire_read == esp_gmf_bcast_reader_acquire_read), return ESP_GMF_ERR_INVALID_ARG,
+                  "The data bus is not a broadcast reader");
+    return esp_gmf_bcast_reader_set_policy(reader_db->child, policy);
+}
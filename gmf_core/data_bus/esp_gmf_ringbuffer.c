@@ -23,6 +23,7 @@ struct esp_gmf_ringbuffer {
     char *p_o;                            /*!< Original pointer */
     char *volatile p_r;                   /*!< Read pointer */
     char *volatile p_w;                   /*!< Write pointer */
+    char *volatile p_w_end;               /*!< End of the data before wrap, it is before the buffer end when a zero-copy write wraps early */
     volatile uint32_t  fill_cnt;           /*!< Number of filled size */
     uint32_t           size;               /*!< Buffer size */
     SemaphoreHandle_t  can_read;           /*!< Semaphore to control reading */
@@ -33,6 +34,159 @@ struct esp_gmf_ringbuffer {
     uint8_t            is_done_write : 1;  /*!< Flag to signal completion of writing */
 };
 
+static inline bool esp_gmf_rb_is_inner(struct esp_gmf_ringbuffer *rb, const uint8_t *buf)
+{
+    return (buf >= (uint8_t *)rb->p_o) && (buf < (uint8_t *)rb->p_o + rb->size);
+}
+
+static inline uint32_t esp_gmf_rb_gap(struct esp_gmf_ringbuffer *rb)
+{
+    // The gap between `p_w_end` and the buffer end is skipped by the reader, so it can't be written either
+    return rb->p_o + rb->size - rb->p_w_end;
+}
+
+static inline void esp_gmf_rb_advance_read(struct esp_gmf_ringbuffer *rb, uint32_t len)
+{
+    rb->p_r += len;
+    rb->fill_cnt -= len;
+    if (rb->p_r == rb->p_w_end) {
+        rb->p_r = rb->p_o;
+        rb->p_w_end = rb->p_o + rb->size;
+    }
+}
+
+static inline void esp_gmf_rb_advance_write(struct esp_gmf_ringbuffer *rb, uint32_t len)
+{
+    rb->p_w += len;
+    rb->fill_cnt += len;
+    if (rb->p_w == rb->p_o + rb->size) {
+        rb->p_w = rb->p_o;
+    }
+}
+
+static void esp_gmf_rb_copy_out(struct esp_gmf_ringbuffer *rb, uint8_t *buf, uint32_t len)
+{
+    while (len) {
+        uint32_t n = rb->p_w_end - rb->p_r;
+        n = n > len ? len : n;
+        if (buf) {
+            memcpy(buf, rb->p_r, n);
+            buf += n;
+        }
+        esp_gmf_rb_advance_read(rb, n);
+        len -= n;
+    }
+}
+
+static void esp_gmf_rb_copy_in(struct esp_gmf_ringbuffer *rb, const uint8_t *buf, uint32_t len)
+{
+    while (len) {
+        uint32_t n = rb->p_o + rb->size - rb->p_w;
+        n = n > len ? len : n;
+        memcpy(rb->p_w, buf, n);
+        buf += n;
+        esp_gmf_rb_advance_write(rb, n);
+        len -= n;
+    }
+}
+
+/**
+ * @brief  Find a contiguous free region of `wanted_size` for the zero-copy writer, the write pointer moves to the
+ *         buffer head when the tail is too short but the head is large enough, as a bip-buffer does
+ */
+static char *esp_gmf_rb_reserve(struct esp_gmf_ringbuffer *rb, uint32_t wanted_size)
+{
+    if (rb->fill_cnt == 0) {
+        // Nothing is readable nor held by the reader, restart at the head to get the largest region
+        rb->p_r = rb->p_w = rb->p_o;
+        rb->p_w_end = rb->p_o + rb->size;
+    }
+    if ((rb->fill_cnt + esp_gmf_rb_gap(rb)) >= rb->size) {
+        return NULL;
+    }
+    if (rb->p_w < rb->p_r) {
+        return ((rb->p_r - rb->p_w) >= wanted_size) ? rb->p_w : NULL;
+    }
+    if ((rb->p_o + rb->size - rb->p_w) >= wanted_size) {
+        return rb->p_w;
+    }
+    if ((rb->p_r - rb->p_o) >= wanted_size) {
+        rb->p_w_end = rb->p_w;
+        rb->p_w = rb->p_o;
+        return rb->p_w;
+    }
+    return NULL;
+}
+
+esp_gmf_err_io_t esp_gmf_rb_acquire_read_in_place(esp_gmf_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait)
+{
+    struct esp_gmf_ringbuffer *rb = (struct esp_gmf_ringbuffer *)handle;
+    if (rb == NULL || blk == NULL) {
+        ESP_LOGE(TAG, "Invalid parameters on in-place acquire read, rb:%p, blk:%p", rb, blk);
+        return ESP_GMF_IO_FAIL;
+    }
+    ESP_GMF_CHECK(TAG, (wanted_size > 0) && (wanted_size <= rb->size), return ESP_GMF_IO_FAIL, "Invalid wanted size for in-place read");
+    while (1) {
+        xSemaphoreTake(rb->lock, portMAX_DELAY);
+        if ((rb->fill_cnt >= wanted_size) || (rb->fill_cnt && rb->is_done_write)) {
+            // Only the contiguous part is handed out, the rest follows on the next acquire
+            uint32_t contiguous = ((rb->p_r < rb->p_w) ? rb->p_w : rb->p_w_end) - rb->p_r;
+            blk->buf = (uint8_t *)rb->p_r;
+            blk->buf_length = contiguous < wanted_size ? contiguous : wanted_size;
+            blk->valid_size = blk->buf_length;
+            blk->is_last = 0;
+            xSemaphoreGive(rb->lock);
+            return ESP_GMF_IO_OK;
+        }
+        if (rb->is_done_write) {
+            blk->valid_size = 0;
+            blk->is_last = 1;
+            xSemaphoreGive(rb->lock);
+            return ESP_GMF_IO_OK;
+        }
+        if (rb->abort_read) {
+            xSemaphoreGive(rb->lock);
+            return ESP_GMF_IO_ABORT;
+        }
+        xSemaphoreGive(rb->lock);
+        xSemaphoreGive(rb->can_write);
+        if (xSemaphoreTake(rb->can_read, ticks_to_wait) != pdTRUE) {
+            blk->valid_size = 0;
+            return ESP_GMF_IO_TIMEOUT;
+        }
+    }
+}
+
+esp_gmf_err_io_t esp_gmf_rb_acquire_write_in_place(esp_gmf_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait)
+{
+    struct esp_gmf_ringbuffer *rb = (struct esp_gmf_ringbuffer *)handle;
+    if (rb == NULL || blk == NULL) {
+        ESP_LOGE(TAG, "Invalid parameters on in-place acquire write, rb:%p, blk:%p", rb, blk);
+        return ESP_GMF_IO_FAIL;
+    }
+    ESP_GMF_CHECK(TAG, (wanted_size > 0) && (wanted_size <= rb->size), return ESP_GMF_IO_FAIL, "Invalid wanted size for in-place write");
+    while (1) {
+        xSemaphoreTake(rb->lock, portMAX_DELAY);
+        char *region = esp_gmf_rb_reserve(rb, wanted_size);
+        if (region) {
+            blk->buf = (uint8_t *)region;
+            blk->buf_length = wanted_size;
+            blk->valid_size = 0;
+            xSemaphoreGive(rb->lock);
+            return ESP_GMF_IO_OK;
+        }
+        if (rb->abort_write) {
+            xSemaphoreGive(rb->lock);
+            return ESP_GMF_IO_ABORT;
+        }
+        xSemaphoreGive(rb->lock);
+        xSemaphoreGive(rb->can_read);
+        if (xSemaphoreTake(rb->can_write, ticks_to_wait) != pdTRUE) {
+            return ESP_GMF_IO_TIMEOUT;
+        }
+    }
+}
+
 esp_gmf_err_t esp_gmf_rb_create(int block_size, int n_blocks, esp_gmf_rb_handle_t *handle)
 {
     struct esp_gmf_ringbuffer *rb = NULL;
@@ -49,6 +203,7 @@ esp_gmf_err_t esp_gmf_rb_create(int block_size, int n_blocks, esp_gmf_rb_handle_
     rb->p_r = rb->p_w = rb->p_o;
     rb->fill_cnt = 0;
     rb->size = block_size * n_blocks;
+    rb->p_w_end = rb->p_o + rb->size;
     rb->is_done_write = 0;
     rb->abort_read = 0;
     rb->abort_write = 0;
@@ -93,6 +248,7 @@ esp_gmf_err_t esp_gmf_rb_reset(esp_gmf_rb_handle_t handle)
         return ESP_GMF_ERR_INVALID_ARG;
     }
     rb->p_r = rb->p_w = rb->p_o;
+    rb->p_w_end = rb->p_o + rb->size;
     rb->fill_cnt = 0;
     rb->is_done_write = 0;
     rb->abort_read = 0;
@@ -111,6 +267,10 @@ esp_gmf_err_io_t esp_gmf_rb_acquire_read(esp_gmf_rb_handle_t handle, esp_gmf_dat
         ESP_LOGE(TAG, "Invalid parameters on acquire read, rb:%p, blk:%p", rb, blk);
         return ESP_GMF_IO_FAIL;
     }
+    if (esp_gmf_rb_is_inner(rb, blk->buf)) {
+        // The block still holds a region of an in-place read, copying onto the storage is never wanted
+        return esp_gmf_rb_acquire_read_in_place(rb, blk, wanted_size, ticks_to_wait);
+    }
     uint32_t buf_len = wanted_size;
     uint8_t *buf = blk->buf;
     ESP_LOGV(TAG, "ACQ_RD+:%p, b:%p, l:%d, s:%ld", rb, buf, blk->buf_length, wanted_size);
@@ -158,23 +318,8 @@ esp_gmf_err_io_t esp_gmf_rb_acquire_read(esp_gmf_rb_handle_t handle, esp_gmf_dat
             continue;
         }
 
-        if ((rb->p_r + read_size) > (rb->p_o + rb->size)) {
-            int rlen1 = rb->p_o + rb->size - rb->p_r;
-            int rlen2 = read_size - rlen1;
-            if (buf) {
-                memcpy(buf, rb->p_r, rlen1);
-                memcpy(buf + rlen1, rb->p_o, rlen2);
-            }
-            rb->p_r = rb->p_o + rlen2;
-        } else {
-            if (buf) {
-                memcpy(buf, rb->p_r, read_size);
-            }
-            rb->p_r = rb->p_r + read_size;
-        }
-
+        esp_gmf_rb_copy_out(rb, buf, read_size);
         buf_len -= read_size;
-        rb->fill_cnt -= read_size;
         total_read_size += read_size;
         buf += read_size;
         xSemaphoreGive(rb->lock);
@@ -193,12 +338,36 @@ read_err:
 
 esp_gmf_err_io_t esp_gmf_rb_release_read(esp_gmf_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks)
 {
-    // Do nothing
+    struct esp_gmf_ringbuffer *rb = (struct esp_gmf_ringbuffer *)handle;
+    if (rb == NULL || blk == NULL || !esp_gmf_rb_is_inner(rb, blk->buf)) {
+        // Nothing to do for the copied read
+        return ESP_GMF_IO_OK;
+    }
+    xSemaphoreTake(rb->lock, portMAX_DELAY);
+    if (((char *)blk->buf != rb->p_r) || (blk->valid_size > rb->fill_cnt)) {
+        ESP_LOGE(TAG, "Invalid in-place read release, rb:%p, b:%p, r:%p, vld:%d, fill:%ld", rb, blk->buf, rb->p_r, blk->valid_size, rb->fill_cnt);
+        xSemaphoreGive(rb->lock);
+        return ESP_GMF_IO_FAIL;
+    }
+    esp_gmf_rb_advance_read(rb, blk->valid_size);
+    xSemaphoreGive(rb->lock);
+    if (blk->valid_size > 0) {
+        xSemaphoreGive(rb->can_write);
+    }
     return ESP_GMF_IO_OK;
 }
 
 esp_gmf_err_io_t esp_gmf_rb_acquire_write(esp_gmf_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait)
 {
+    struct esp_gmf_ringbuffer *rb = (struct esp_gmf_ringbuffer *)handle;
+    if (rb == NULL || blk == NULL) {
+        ESP_LOGE(TAG, "Invalid parameters on acquire write, rb:%p, blk:%p", rb, blk);
+        return ESP_GMF_IO_FAIL;
+    }
+    if (esp_gmf_rb_is_inner(rb, blk->buf)) {
+        return esp_gmf_rb_acquire_write_in_place(rb, blk, wanted_size, ticks_to_wait);
+    }
+    // The caller's buffer is copied on release, a NULL `blk->buf` is set by the caller before the release
     return ESP_GMF_IO_OK;
 }
 
@@ -212,6 +381,26 @@ esp_gmf_err_io_t esp_gmf_rb_release_write(esp_gmf_rb_handle_t handle, esp_gmf_da
         ESP_LOGE(TAG, "Invalid parameters on release write, rb:%p, blk:%p", rb, blk);
         return ESP_GMF_IO_FAIL;
     }
+    if (esp_gmf_rb_is_inner(rb, blk->buf)) {
+        // Commit the data written in place
+        xSemaphoreTake(rb->lock, portMAX_DELAY);
+        uint32_t contiguous = ((rb->p_w < rb->p_r) ? rb->p_r : (rb->p_o + rb->size)) - rb->p_w;
+        if (((char *)blk->buf != rb->p_w) || (blk->valid_size > contiguous)
+            || (blk->valid_size > (rb->size - rb->fill_cnt - esp_gmf_rb_gap(rb)))) {
+            ESP_LOGE(TAG, "Invalid in-place write release, rb:%p, b:%p, w:%p, vld:%d", rb, blk->buf, rb->p_w, blk->valid_size);
+            xSemaphoreGive(rb->lock);
+            return ESP_GMF_IO_FAIL;
+        }
+        esp_gmf_rb_advance_write(rb, blk->valid_size);
+        xSemaphoreGive(rb->lock);
+        if (blk->valid_size > 0) {
+            xSemaphoreGive(rb->can_read);
+        }
+        if (blk->is_last) {
+            esp_gmf_rb_done_write(rb);
+        }
+        return ESP_GMF_IO_OK;
+    }
     uint8_t *buf = blk->buf;
     int buf_len = blk->valid_size;
     esp_gmf_rb_bytes_available(rb, &write_size);
@@ -250,19 +439,8 @@ esp_gmf_err_io_t esp_gmf_rb_release_write(esp_gmf_rb_handle_t handle, esp_gmf_da
             continue;
         }
 
-        if ((rb->p_w + write_size) > (rb->p_o + rb->size)) {
-            int wlen1 = rb->p_o + rb->size - rb->p_w;
-            int wlen2 = write_size - wlen1;
-            memcpy(rb->p_w, buf, wlen1);
-            memcpy(rb->p_o, buf + wlen1, wlen2);
-            rb->p_w = rb->p_o + wlen2;
-        } else {
-            memcpy(rb->p_w, buf, write_size);
-            rb->p_w = rb->p_w + write_size;
-        }
-
+        esp_gmf_rb_copy_in(rb, buf, write_size);
         buf_len -= write_size;
-        rb->fill_cnt += write_size;
         total_write_size += write_size;
         buf += write_size;
         xSemaphoreGive(rb->lock);
@@ -324,7 +502,7 @@ esp_gmf_err_t esp_gmf_rb_bytes_available(esp_gmf_rb_handle_t handle, uint32_t *a
 {
     struct esp_gmf_ringbuffer *rb = (struct esp_gmf_ringbuffer *)handle;
     if (rb && available_size) {
-        *available_size = (rb->size - rb->fill_cnt);
+        *available_size = (rb->size - rb->fill_cnt - esp_gmf_rb_gap(rb));
         return ESP_GMF_ERR_OK;
     }
     return ESP_GMF_ERR_INVALID_ARG;
@@ -0,0 +1,341 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_gmf_spsc_rb.h"
+#include "esp_log.h"
+#include "esp_gmf_oal_mem.h"
+
+static const char *TAG = "ESP_GMF_SPSC_RB";
+
+/**
+ * @brief  Structure representing a SPSC ring buffer
+ *
+ *         The read and write indices run over [0, 2 * size), so a full buffer and an empty buffer are told apart
+ *         without wasting a byte and without requiring the size to be a power of two
+ */
+struct esp_gmf_spsc_rb {
+    uint8_t           *buf;            /*!< Buffer address */
+    uint32_t           size;           /*!< Buffer size */
+    atomic_uint        p_w;            /*!< Write index, only advanced by the writer */
+    atomic_uint        p_r;            /*!< Read index, only advanced by the reader */
+    atomic_bool        read_waiting;   /*!< The reader is waiting on `can_read` */
+    atomic_bool        write_waiting;  /*!< The writer is waiting on `can_write` */
+    atomic_bool        is_abort;       /*!< Flag to indicate read and write abort */
+    atomic_bool        is_done_write;  /*!< Flag to signal completion of writing */
+    SemaphoreHandle_t  can_read;       /*!< Semaphore the reader waits on while the buffer is empty */
+    SemaphoreHandle_t  can_write;      /*!< Semaphore the writer waits on while the buffer is full */
+};
+
+static inline uint32_t spsc_rb_fill(struct esp_gmf_spsc_rb *rb, uint32_t p_w, uint32_t p_r)
+{
+    return p_w >= p_r ? p_w - p_r : p_w + 2 * rb->size - p_r;
+}
+
+static inline uint32_t spsc_rb_advance(struct esp_gmf_spsc_rb *rb, uint32_t idx, uint32_t len)
+{
+    idx += len;
+    return idx >= 2 * rb->size ? idx - 2 * rb->size : idx;
+}
+
+static inline void spsc_rb_copy_out(struct esp_gmf_spsc_rb *rb, uint32_t idx, uint8_t *dst, uint32_t len)
+{
+    uint32_t pos = idx < rb->size ? idx : idx - rb->size;
+    uint32_t len1 = rb->size - pos;
+    if (len1 >= len) {
+        memcpy(dst, rb->buf + pos, len);
+    } else {
+        memcpy(dst, rb->buf + pos, len1);
+        memcpy(dst + len1, rb->buf, len - len1);
+    }
+}
+
+static inline void spsc_rb_copy_in(struct esp_gmf_spsc_rb *rb, uint32_t idx, const uint8_t *src, uint32_t len)
+{
+    uint32_t pos = idx < rb->size ? idx : idx - rb->size;
+    uint32_t len1 = rb->size - pos;
+    if (len1 >= len) {
+        memcpy(rb->buf + pos, src, len);
+    } else {
+        memcpy(rb->buf + pos, src, len1);
+        memcpy(rb->buf, src + len1, len - len1);
+    }
+}
+
+static inline void spsc_rb_wake(atomic_bool *waiting, SemaphoreHandle_t sem)
+{
+    // Only the side which announced its wait costs a kernel call
+    if (atomic_exchange(waiting, false)) {
+        xSemaphoreGive(sem);
+    }
+}
+
+esp_gmf_err_t esp_gmf_spsc_rb_create(int block_size, int n_blocks, esp_gmf_spsc_rb_handle_t *handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    *handle = NULL;
+    ESP_GMF_CHECK(TAG, (block_size > 0 && n_blocks > 0), return ESP_GMF_ERR_INVALID_ARG, "Invalid ringbuffer size");
+    struct esp_gmf_spsc_rb *rb = NULL;
+    bool _success = (
+                        (rb            = esp_gmf_oal_calloc(1, sizeof(struct esp_gmf_spsc_rb))) &&
+                        (rb->buf       = esp_gmf_oal_calloc(n_blocks, block_size)) &&
+                        (rb->can_read  = xSemaphoreCreateBinary()) &&
+                        (rb->can_write = xSemaphoreCreateBinary())
+                    );
+    ESP_GMF_MEM_CHECK(TAG, _success, goto _esp_gmf_spsc_rb_init_failed);
+    rb->size = block_size * n_blocks;
+    atomic_init(&rb->p_w, 0);
+    atomic_init(&rb->p_r, 0);
+    atomic_init(&rb->read_waiting, false);
+    atomic_init(&rb->write_waiting, false);
+    atomic_init(&rb->is_abort, false);
+    atomic_init(&rb->is_done_write, false);
+    *handle = rb;
+    return ESP_GMF_ERR_OK;
+_esp_gmf_spsc_rb_init_failed:
+    esp_gmf_spsc_rb_destroy(rb);
+    return ESP_GMF_ERR_MEMORY_LACK;
+}
+
+esp_gmf_err_t esp_gmf_spsc_rb_destroy(esp_gmf_spsc_rb_handle_t handle)
+{
+    struct esp_gmf_spsc_rb *rb = (struct esp_gmf_spsc_rb *)handle;
+    if (rb == NULL) {
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    if (rb->buf) {
+        esp_gmf_oal_free(rb->buf);
+        rb->buf = NULL;
+    }
+    if (rb->can_read) {
+        vSemaphoreDelete(rb->can_read);
+        rb->can_read = NULL;
+    }
+    if (rb->can_write) {
+        vSemaphoreDelete(rb->can_write);
+        rb->can_write = NULL;
+    }
+    esp_gmf_oal_free(rb);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_spsc_rb_reset(esp_gmf_spsc_rb_handle_t handle)
+{
+    struct esp_gmf_spsc_rb *rb = (struct esp_gmf_spsc_rb *)handle;
+    if (rb == NULL) {
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    atomic_store(&rb->p_w, 0);
+    atomic_store(&rb->p_r, 0);
+    atomic_store(&rb->read_waiting, false);
+    atomic_store(&rb->write_waiting, false);
+    atomic_store(&rb->is_abort, false);
+    atomic_store(&rb->is_done_write, false);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_io_t esp_gmf_spsc_rb_acquire_read(esp_gmf_spsc_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait)
+{
+    struct esp_gmf_spsc_rb *rb = (struct esp_gmf_spsc_rb *)handle;
+    if (rb == NULL || blk == NULL) {
+        ESP_LOGE(TAG, "Invalid parameters on acquire read, rb:%p, blk:%p", rb, blk);
+        return ESP_GMF_IO_FAIL;
+    }
+    esp_gmf_err_io_t ret_val = ESP_GMF_IO_OK;
+    uint32_t buf_len = wanted_size;
+    uint32_t total_read_size = 0;
+    uint8_t *buf = blk->buf;
+    uint32_t p_r = atomic_load_explicit(&rb->p_r, memory_order_relaxed);
+    ESP_LOGV(TAG, "ACQ_RD+:%p, b:%p, l:%d, s:%ld", rb, buf, blk->buf_length, wanted_size);
+    while (buf_len) {
+        uint32_t fill_cnt = spsc_rb_fill(rb, atomic_load(&rb->p_w), p_r);
+        uint32_t read_size = buf_len;
+        if (fill_cnt < buf_len) {
+            // Read in multiple of 4 as the GMF ringbuffer does, unless it is the tail of the stream
+            read_size = fill_cnt & 0xfffffffc;
+            if ((read_size == 0) && atomic_load(&rb->is_done_write)) {
+                read_size = spsc_rb_fill(rb, atomic_load(&rb->p_w), p_r);
+            }
+        }
+        if (read_size == 0) {
+            if (atomic_load(&rb->is_done_write)) {
+                blk->is_last = 1;
+                break;
+            }
+            if (atomic_load(&rb->is_abort)) {
+                ret_val = ESP_GMF_IO_ABORT;
+                break;
+            }
+            // Announce the wait before checking again, so the writer either sees it or the data is already visible
+            atomic_store(&rb->read_waiting, true);
+            if ((spsc_rb_fill(rb, atomic_load(&rb->p_w), p_r) >= (buf_len < 4 ? buf_len : 4))
+                || atomic_load(&rb->is_done_write) || atomic_load(&rb->is_abort)) {
+                atomic_store(&rb->read_waiting, false);
+                continue;
+            }
+            if (xSemaphoreTake(rb->can_read, ticks_to_wait) != pdTRUE) {
+                atomic_store(&rb->read_waiting, false);
+                ret_val = ESP_GMF_IO_TIMEOUT;
+                break;
+            }
+            continue;
+        }
+        if (buf) {
+            spsc_rb_copy_out(rb, p_r, buf + total_read_size, read_size);
+        }
+        p_r = spsc_rb_advance(rb, p_r, read_size);
+        atomic_store(&rb->p_r, p_r);
+        spsc_rb_wake(&rb->write_waiting, rb->can_write);
+        buf_len -= read_size;
+        total_read_size += read_size;
+    }
+    ESP_LOGV(TAG, "ACQ_RD-:%p, ret:%d", rb, ret_val);
+    blk->valid_size = total_read_size;
+    return ret_val;
+}
+
+esp_gmf_err_io_t esp_gmf_spsc_rb_release_read(esp_gmf_spsc_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks)
+{
+    // Do nothing
+    return ESP_GMF_IO_OK;
+}
+
+esp_gmf_err_io_t esp_gmf_spsc_rb_acquire_write(esp_gmf_spsc_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait)
+{
+    return ESP_GMF_IO_OK;
+}
+
+esp_gmf_err_io_t esp_gmf_spsc_rb_release_write(esp_gmf_spsc_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks)
+{
+    struct esp_gmf_spsc_rb *rb = (struct esp_gmf_spsc_rb *)handle;
+    if (rb == NULL || blk == NULL) {
+        ESP_LOGE(TAG, "Invalid parameters on release write, rb:%p, blk:%p", rb, blk);
+        return ESP_GMF_IO_FAIL;
+    }
+    esp_gmf_err_io_t ret_val = ESP_GMF_IO_OK;
+    const uint8_t *buf = blk->buf;
+    uint32_t buf_len = blk->valid_size;
+    uint32_t total_write_size = 0;
+    uint32_t p_w = atomic_load_explicit(&rb->p_w, memory_order_relaxed);
+    ESP_LOGV(TAG, "RLS_WR+:%p, blk:%p, vld_sz:%d, time:%d", rb, blk, blk->valid_size, block_ticks);
+    while (buf_len) {
+        uint32_t write_size = rb->size - spsc_rb_fill(rb, p_w, atomic_load(&rb->p_r));
+        if (buf_len < write_size) {
+            write_size = buf_len;
+        }
+        if (write_size == 0) {
+            if (atomic_load(&rb->is_done_write)) {
+                ESP_LOGD(TAG, "WR:%p, done", rb);
+                break;
+            }
+            if (atomic_load(&rb->is_abort)) {
+                ret_val = ESP_GMF_IO_ABORT;
+                ESP_LOGD(TAG, "WR:%p, abort", rb);
+                break;
+            }
+            atomic_store(&rb->write_waiting, true);
+            if ((spsc_rb_fill(rb, p_w, atomic_load(&rb->p_r)) < rb->size)
+                || atomic_load(&rb->is_done_write) || atomic_load(&rb->is_abort)) {
+                atomic_store(&rb->write_waiting, false);
+                continue;
+            }
+            if (xSemaphoreTake(rb->can_write, block_ticks) != pdTRUE) {
+                atomic_store(&rb->write_waiting, false);
+                ret_val = ESP_GMF_IO_TIMEOUT;
+                ESP_LOGD(TAG, "WR:%p, timeout:%d", rb, block_ticks);
+                break;
+            }
+            continue;
+        }
+        spsc_rb_copy_in(rb, p_w, buf + total_write_size, write_size);
+        p_w = spsc_rb_advance(rb, p_w, write_size);
+        atomic_store(&rb->p_w, p_w);
+        spsc_rb_wake(&rb->read_waiting, rb->can_read);
+        buf_len -= write_size;
+        total_write_size += write_size;
+    }
+    if (total_write_size > 0) {
+        ret_val = ESP_GMF_IO_OK;
+    }
+    ESP_LOGV(TAG, "RLS_WR-:%p, ret:%d, ws:%ld", rb, ret_val, total_write_size);
+    if (blk->is_last) {
+        esp_gmf_spsc_rb_done_write(rb);
+        ret_val = ESP_GMF_IO_OK;
+    }
+    return ret_val;
+}
+
+esp_gmf_err_t esp_gmf_spsc_rb_abort(esp_gmf_spsc_rb_handle_t handle)
+{
+    struct esp_gmf_spsc_rb *rb = (struct esp_gmf_spsc_rb *)handle;
+    if (rb == NULL) {
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    ESP_LOGD(TAG, "Abort, rb:%p", rb);
+    atomic_store(&rb->is_abort, true);
+    spsc_rb_wake(&rb->read_waiting, rb->can_read);
+    spsc_rb_wake(&rb->write_waiting, rb->can_write);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_spsc_rb_done_write(esp_gmf_spsc_rb_handle_t handle)
+{
+    struct esp_gmf_spsc_rb *rb = (struct esp_gmf_spsc_rb *)handle;
+    if (rb == NULL) {
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    atomic_store(&rb->is_done_write, true);
+    ESP_LOGD(TAG, "Set done write, rb:%p", rb);
+    spsc_rb_wake(&rb->read_waiting, rb->can_read);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_spsc_rb_reset_done_write(esp_gmf_spsc_rb_handle_t handle)
+{
+    struct esp_gmf_spsc_rb *rb = (struct esp_gmf_spsc_rb *)handle;
+    if (rb == NULL) {
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    atomic_store(&rb->is_done_write, false);
+    ESP_LOGD(TAG, "Reset done write, rb:%p", rb);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_spsc_rb_bytes_available(esp_gmf_spsc_rb_handle_t handle, uint32_t *available_size)
+{
+    struct esp_gmf_spsc_rb *rb = (struct esp_gmf_spsc_rb *)handle;
+    if (rb && available_size) {
+        *available_size = rb->size - spsc_rb_fill(rb, atomic_load(&rb->p_w), atomic_load(&rb->p_r));
+        return ESP_GMF_ERR_OK;
+    }
+    return ESP_GMF_ERR_INVALID_ARG;
+}
+
+esp_gmf_err_t esp_gmf_spsc_rb_bytes_filled(esp_gmf_spsc_rb_handle_t handle, uint32_t *filled_size)
+{
+    struct esp_gmf_spsc_rb *rb = (struct esp_gmf_spsc_rb *)handle;
+    if (rb && filled_size) {
+        *filled_size = spsc_rb_fill(rb, atomic_load(&rb->p_w), atomic_load(&rb->p_r));
+        return ESP_GMF_ERR_OK;
+    }
+    return ESP_GMF_ERR_INVALID_ARG;
+}
+
+esp_gmf_err_t esp_gmf_spsc_rb_get_size(esp_gmf_spsc_rb_handle_t handle, uint32_t *valid_size)
+{
+    struct esp_gmf_spsc_rb *rb = (struct esp_gmf_spsc_rb *)handle;
+    if (rb == NULL || valid_size == NULL) {
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    *valid_size = rb->size;
+    return ESP_GMF_ERR_OK;
+}
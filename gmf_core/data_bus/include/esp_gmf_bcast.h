@@ -0,0 +1,396 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "esp_gmf_data_bus.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  GMF broadcast is a zero-copy block buffer with one writer and multiple readers.
+ *         The writer acquires a block, fills it and releases it to publish it to all the readers registered at that time.
+ *         Each reader acquires and releases the published blocks in order by its own handle, independently of the other
+ *         readers. Every published block holds one reference per reader, and it becomes free for the writer again when
+ *         the last reader releases it, so no data is copied whatever the number of readers.
+ *
+ *         The writer waits for a free block when the slowest reader is `block_cnt` blocks behind. A reader created with
+ *         `ESP_GMF_BCAST_DROP_OLDEST` does not hold the writer back, instead its oldest unread block is dropped.
+ *
+ *         A writer owning its buffers can publish them by reference with `esp_gmf_bcast_write_ref`, the buffer is handed
+ *         back through a callback once the last reader releases or drops it, so the data is not copied into the blocks either.
+ *
+ * @note  The broadcast handle itself is the writer. The memory is freed after the writer and all the readers are destroyed,
+ *        in any order
+ */
+
+/**
+ * @brief  Handle to the broadcast buffer, used by the writer
+ */
+typedef void *esp_gmf_bcast_handle_t;
+
+/**
+ * @brief  Handle to a reader of the broadcast buffer
+ */
+typedef void *esp_gmf_bcast_reader_handle_t;
+
+/**
+ * @brief  Policy applied when the writer needs a block which a reader has not read yet
+ */
+typedef enum {
+    ESP_GMF_BCAST_DROP_NONE   = 0,  /*!< Never drop, the writer waits for the reader */
+    ESP_GMF_BCAST_DROP_OLDEST = 1,  /*!< Drop the oldest unread block of the reader, unless it is being accessed */
+} esp_gmf_bcast_drop_policy_t;
+
+/**
+ * @brief  Callback returning a buffer published by `esp_gmf_bcast_write_ref` to the writer
+ *
+ * @param[in]  ctx  Context given on publishing
+ * @param[in]  buf  The published buffer
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK  On success
+ *       - Others          The buffer is not returned, the broadcast buffer does not retry
+ */
+typedef esp_gmf_err_t (*esp_gmf_bcast_ref_free_t)(void *ctx, uint8_t *buf);
+
+/**
+ * @brief  Create a broadcast buffer
+ *
+ * @param[in]   block_cnt   Number of blocks
+ * @param[in]   block_size  Minimum size of each block, a block grows to the wanted size of the writer when needed
+ * @param[out]  handle      Pointer to store the handle to the created broadcast buffer
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Operation successful
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument provided
+ *       - ESP_GMF_ERR_MEMORY_LACK  Insufficient memory
+ */
+esp_gmf_err_t esp_gmf_bcast_create(int block_cnt, int block_size, esp_gmf_bcast_handle_t *handle);
+
+/**
+ * @brief  Set the data bus which wraps the writer, its writer readiness callback is called when a reader releases a block
+ *
+ * @param[in]  handle  The broadcast buffer handle
+ * @param[in]  db      The data bus handle of the writer, NULL to unbind
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_bcast_set_db(esp_gmf_bcast_handle_t handle, esp_gmf_db_handle_t db);
+
+/**
+ * @brief  Destroy the writer side of the broadcast buffer
+ *         The memory is freed once all the readers are destroyed, the remaining readers see the writing as done
+ *
+ * @param[in]  handle  The broadcast buffer handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_bcast_destroy(esp_gmf_bcast_handle_t handle);
+
+/**
+ * @brief  Reset the broadcast buffer, dropping all the published blocks and clearing the done and abort status
+ *
+ * @note  It must not be called while the writer or any reader is accessing a block
+ *
+ * @param[in]  handle  The broadcast buffer handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_bcast_reset(esp_gmf_bcast_handle_t handle);
+
+/**
+ * @brief  Acquire a free block for writing, `blk->buf` is set to the block buffer
+ *         When no block is free, it will block for the duration specified by block_ticks
+ *
+ * @param[in]   handle       The broadcast buffer handle
+ * @param[out]  blk          Pointer to the data block structure to be filled
+ * @param[in]   wanted_size  Desired size to write
+ * @param[in]   block_ticks  Maximum duration to wait for the operation to complete
+ *
+ * @return
+ *       - ESP_GMF_IO_OK       Operation succeeded
+ *       - ESP_GMF_IO_FAIL     Invalid arguments or insufficient memory
+ *       - ESP_GMF_IO_TIMEOUT  Operation timed out
+ *       - ESP_GMF_IO_ABORT    Operation aborted
+ */
+esp_gmf_err_io_t esp_gmf_bcast_acquire_write(esp_gmf_bcast_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int block_ticks);
+
+/**
+ * @brief  Publish the acquired block to all the readers
+ *         If `blk->buf` is not the acquired block buffer, the valid data is copied into the block
+ *
+ * @param[in]  handle       The broadcast buffer handle
+ * @param[in]  blk          Pointer to the data block structure to release
+ * @param[in]  block_ticks  Not used
+ *
+ * @return
+ *       - ESP_GMF_IO_OK    Operation succeeded
+ *       - ESP_GMF_IO_FAIL  No block is acquired or invalid arguments
+ */
+esp_gmf_err_io_t esp_gmf_bcast_release_write(esp_gmf_bcast_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks);
+
+/**
+ * @brief  Publish a buffer of the writer to all the readers by reference, in place of the next block
+ *         It waits for a free block like `esp_gmf_bcast_acquire_write`. On success the buffer belongs to the broadcast buffer
+ *         until `ref_free` is called, at once when there is no reader, otherwise when the last reader releases or drops it,
+ *         or when the broadcast buffer is reset or freed
+ *
+ * @note  The readers must not write into the buffer, and the writer must not modify it before `ref_free` is called
+ *
+ * @param[in]  handle       The broadcast buffer handle
+ * @param[in]  blk          The data block to publish, `buf`, `buf_length`, `valid_size` and `is_last` are used
+ * @param[in]  meta         Metadata published along with the block, NULL if none
+ * @param[in]  ref_free     Callback returning the buffer to the writer, called with the lock of the broadcast buffer held
+ * @param[in]  ref_ctx      Context of `ref_free`
+ * @param[in]  block_ticks  Maximum duration to wait for a free block
+ *
+ * @return
+ *       - ESP_GMF_IO_OK       Operation succeeded
+ *       - ESP_GMF_IO_FAIL     Invalid arguments, or a block is acquired for writing
+ *       - ESP_GMF_IO_TIMEOUT  Operation timed out, the buffer still belongs to the writer
+ *       - ESP_GMF_IO_ABORT    Operation aborted, the buffer still belongs to the writer
+ */
+esp_gmf_err_io_t esp_gmf_bcast_write_ref(esp_gmf_bcast_handle_t handle, const esp_gmf_data_bus_block_t *blk, const esp_gmf_db_meta_t *meta,
+                                         esp_gmf_bcast_ref_free_t ref_free, void *ref_ctx, int block_ticks);
+
+/**
+ * @brief  Set the metadata of the block acquired for writing, it is published along with the block
+ *
+ * @param[in]  handle  The broadcast buffer handle
+ * @param[in]  meta    Pointer to the metadata
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_NOT_FOUND    No block is acquired for writing
+ */
+esp_gmf_err_t esp_gmf_bcast_set_meta(esp_gmf_bcast_handle_t handle, const esp_gmf_db_meta_t *meta);
+
+/**
+ * @brief  Set the status of writing to the broadcast buffer as done, the readers get `is_last` after the published blocks
+ *
+ * @param[in]  handle  The broadcast buffer handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_bcast_done_write(esp_gmf_bcast_handle_t handle);
+
+/**
+ * @brief  Reset the status of writing to the broadcast buffer as not done
+ *
+ * @param[in]  handle  The broadcast buffer handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_bcast_reset_done_write(esp_gmf_bcast_handle_t handle);
+
+/**
+ * @brief  Abort the pending operations of the writer and all the readers
+ *
+ * @param[in]  handle  The broadcast buffer handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_bcast_abort(esp_gmf_bcast_handle_t handle);
+
+/**
+ * @brief  Get the total size of the broadcast buffer, which is the block count multiplied by the block size
+ *
+ * @param[in]   handle      The broadcast buffer handle
+ * @param[out]  total_size  Pointer to store the total size
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_bcast_get_total_size(esp_gmf_bcast_handle_t handle, uint32_t *total_size);
+
+/**
+ * @brief  Get the size of the blocks which are released by all the readers
+ *         When no block is released, the next block counts as free if only the readers which drop their oldest block hold it,
+ *         and all the blocks count as free once the buffer is aborted, as the writer does not wait in both cases
+ *
+ * @param[in]   handle     The broadcast buffer handle
+ * @param[out]  free_size  Pointer to store the free size
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_bcast_get_free_size(esp_gmf_bcast_handle_t handle, uint32_t *free_size);
+
+/**
+ * @brief  Register a new reader of the broadcast buffer
+ *         The reader starts from the next published block
+ *
+ * @param[in]   handle  The broadcast buffer handle
+ * @param[in]   policy  Drop policy of the reader
+ * @param[out]  reader  Pointer to store the handle to the created reader
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Operation successful
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument provided
+ *       - ESP_GMF_ERR_MEMORY_LACK  Insufficient memory
+ */
+esp_gmf_err_t esp_gmf_bcast_reader_create(esp_gmf_bcast_handle_t handle, esp_gmf_bcast_drop_policy_t policy, esp_gmf_bcast_reader_handle_t *reader);
+
+/**
+ * @brief  Change the drop policy of a reader, a waiting writer is woken up to apply it
+ *
+ * @param[in]  reader  The reader handle
+ * @param[in]  policy  Drop policy of the reader
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_bcast_reader_set_policy(esp_gmf_bcast_reader_handle_t reader, esp_gmf_bcast_drop_policy_t policy);
+
+/**
+ * @brief  Set the data bus which wraps the reader, its reader readiness callback is called when a block is published
+ *
+ * @param[in]  reader  The reader handle
+ * @param[in]  db      The data bus handle of the reader, NULL to unbind
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_bcast_reader_set_db(esp_gmf_bcast_reader_handle_t reader, esp_gmf_db_handle_t db);
+
+/**
+ * @brief  Unregister and destroy a reader, the blocks it has not released are released
+ *
+ * @param[in]  reader  The reader handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_bcast_reader_destroy(esp_gmf_bcast_reader_handle_t reader);
+
+/**
+ * @brief  Acquire the oldest unread block of the reader, `blk->buf` is set to the block buffer
+ *         When there is no unread block, it will block for the duration specified by block_ticks.
+ *         After writing is done and all the blocks are read, `blk->is_last` is set with zero valid size
+ *
+ * @param[in]   reader       The reader handle
+ * @param[out]  blk          Pointer to the data block structure to be filled
+ * @param[in]   wanted_size  Not used, a whole block is acquired
+ * @param[in]   block_ticks  Maximum duration to wait for the operation to complete
+ *
+ * @return
+ *       - ESP_GMF_IO_OK       Operation succeeded
+ *       - ESP_GMF_IO_FAIL     Invalid arguments
+ *       - ESP_GMF_IO_TIMEOUT  Operation timed out
+ *       - ESP_GMF_IO_ABORT    Operation aborted
+ */
+esp_gmf_err_io_t esp_gmf_bcast_reader_acquire_read(esp_gmf_bcast_reader_handle_t reader, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int block_ticks);
+
+/**
+ * @brief  Release the acquired block of the reader, it becomes free when the last reader releases it
+ *
+ * @param[in]  reader       The reader handle
+ * @param[in]  blk          Pointer to the data block structure to release
+ * @param[in]  block_ticks  Not used
+ *
+ * @return
+ *       - ESP_GMF_IO_OK    Operation succeeded
+ *       - ESP_GMF_IO_FAIL  The block is not the acquired one or invalid arguments
+ */
+esp_gmf_err_io_t esp_gmf_bcast_reader_release_read(esp_gmf_bcast_reader_handle_t reader, esp_gmf_data_bus_block_t *blk, int block_ticks);
+
+/**
+ * @brief  Get the metadata of the block acquired by the reader
+ *
+ * @param[in]   reader  The reader handle
+ * @param[out]  meta    Pointer to store the metadata, cleared if no block is acquired
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_bcast_reader_get_meta(esp_gmf_bcast_reader_handle_t reader, esp_gmf_db_meta_t *meta);
+
+/**
+ * @brief  Abort the pending read operation of the reader only
+ *
+ * @param[in]  reader  The reader handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_bcast_reader_abort(esp_gmf_bcast_reader_handle_t reader);
+
+/**
+ * @brief  Clear the abort status of the reader
+ *
+ * @param[in]  reader  The reader handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_bcast_reader_reset(esp_gmf_bcast_reader_handle_t reader);
+
+/**
+ * @brief  Get the number of unread blocks of the reader
+ *
+ * @note  It counts one when writing is done and all the blocks are read, so that the final acquisition is not blocked
+ *
+ * @param[in]   reader      The reader handle
+ * @param[out]  filled_cnt  Pointer to store the number of unread blocks
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_bcast_reader_get_filled(esp_gmf_bcast_reader_handle_t reader, uint32_t *filled_cnt);
+
+/**
+ * @brief  Get the number of blocks dropped for the reader by `ESP_GMF_BCAST_DROP_OLDEST`
+ *
+ * @param[in]   reader       The reader handle
+ * @param[out]  dropped_cnt  Pointer to store the number of dropped blocks
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_bcast_reader_get_dropped(esp_gmf_bcast_reader_handle_t reader, uint32_t *dropped_cnt);
+
+/**
+ * @brief  Get the total size of the broadcast buffer from the reader
+ *
+ * @param[in]   reader      The reader handle
+ * @param[out]  total_size  Pointer to store the total size
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_bcast_reader_get_total_size(esp_gmf_bcast_reader_handle_t reader, uint32_t *total_size);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
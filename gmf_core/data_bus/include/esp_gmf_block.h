@@ -137,6 +137,22 @@ esp_gmf_err_io_t esp_gmf_block_acquire_write(esp_gmf_block_handle_t handle, esp_
  */
 esp_gmf_err_io_t esp_gmf_block_release_write(esp_gmf_block_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks);
 
+/**
+ * @brief  Drop all the unread data behind the block the reader holds, e.g. for the writer dropping the oldest data
+ *
+ * @note  It's called by the writer between `esp_gmf_block_release_write` and the next `esp_gmf_block_acquire_write`,
+ *        while the reader holds the block acquired by `esp_gmf_block_acquire_read` and doesn't acquire another one
+ *
+ * @param[in]   handle        Handle to the block buffer
+ * @param[in]   held_size     Valid size of the block the reader holds, 0 if it holds nothing
+ * @param[out]  dropped_size  Size of the dropped data
+ *
+ * @return
+ *       - ESP_GMF_IO_OK    Operation succeeded
+ *       - ESP_GMF_IO_FAIL  Invalid arguments, or the held size doesn't match the data in the buffer
+ */
+esp_gmf_err_io_t esp_gmf_block_drop_unread(esp_gmf_block_handle_t handle, uint32_t held_size, uint32_t *dropped_size);
+
 /**
  * @brief  Set status of writing to is done
  *
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "esp_gmf_err.h"
+#include "esp_gmf_payload.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -26,8 +27,41 @@ typedef enum {
     DATA_BUS_TYPE_BLOCK = 2,  /*!< Data bus type for block-oriented data */
 } esp_gmf_data_bus_type_t;
 
+/**
+ * @brief  Readiness of a data bus seen from the reader or the writer side
+ *
+ * @note  The values are the same as `ESP_GMF_PORT_DIR_IN` and `ESP_GMF_PORT_DIR_OUT`, so the readiness APIs
+ *        of the data bus can be set as the readiness operations of a GMF port directly
+ */
+typedef enum {
+    ESP_GMF_DB_READY_READ  = 0,  /*!< There is data to read, or writing is done or aborted */
+    ESP_GMF_DB_READY_WRITE = 1,  /*!< There is space to write, or the data bus is aborted */
+    ESP_GMF_DB_READY_MAX,
+} esp_gmf_db_ready_t;
+
+/**
+ * @brief  Function called when the data bus may have become ready for the reader or the writer
+ *
+ * @note  It is called from the context of the opposite side, e.g. the writer thread for `ESP_GMF_DB_READY_READ`,
+ *        so it must be short and not call the data bus APIs
+ */
+typedef void (*esp_gmf_db_notify_cb)(void *ctx);
+
+#define ESP_GMF_DB_NOTIFY_MAX  (4)  /*!< Maximum readiness notifications of each side, e.g. the writers of several pipelines */
+
+/**
+ * @brief  Policy of a data bus when the reader falls behind and the writer finds no space
+ */
+typedef enum {
+    ESP_GMF_DB_DROP_NONE         = 0,  /*!< Never drop, the writer waits for the reader */
+    ESP_GMF_DB_DROP_OLDEST       = 1,  /*!< Drop the oldest unread data to make space, the data the reader holds is kept */
+    ESP_GMF_DB_DROP_NEWEST       = 2,  /*!< Drop the data being written */
+    ESP_GMF_DB_DROP_TO_KEY_FRAME = 3,  /*!< Drop the data being written, and the following data until the next key frame */
+} esp_gmf_db_drop_policy_t;
+
 /**
  * @brief  Structure representing a block of data for block-oriented data buses
+ * @note  The GMF ports pass `esp_gmf_payload_t` as the block, keep the fields at the same place as the payload ones
  */
 typedef struct {
     uint8_t *buf;         /*!< Pointer to the buffer */
@@ -36,6 +70,37 @@ typedef struct {
     bool     is_last;     /*!< Flag indicating if the buffer is the last */
 } esp_gmf_data_bus_block_t;
 
+/**
+ * @brief  Metadata travelling along with the data through a data bus
+ */
+typedef struct {
+    int64_t trace_us;   /*!< Time the data entered the pipeline in microseconds, see `esp_gmf_payload_t` */
+    uint8_t meta_flag;  /*!< Meta flag of the data, see `ESP_GMF_META_FLAG_*`, read by the drop policy on writing */
+} esp_gmf_db_meta_t;
+
+/**
+ * @brief  Statistics of the accesses from one side of a data bus
+ */
+typedef struct {
+    uint32_t acquire_cnt;  /*!< Number of acquisitions */
+    uint32_t block_cnt;    /*!< Number of accesses which had to wait, underruns for the reader and overruns for the writer */
+    uint64_t block_us;     /*!< Cumulative time of the accesses which had to wait, in microseconds */
+    uint32_t timeout_cnt;  /*!< Number of accesses which timed out */
+    uint32_t abort_cnt;    /*!< Number of accesses which were aborted */
+} esp_gmf_db_access_stats_t;
+
+/**
+ * @brief  Statistics of a data bus, recorded when `CONFIG_ESP_GMF_DB_STATS_EN` is enabled
+ *
+ * @note  The watermarks are in the unit of `esp_gmf_db_get_filled_size`, they stay 0 for a data bus which can't report it
+ */
+typedef struct {
+    uint32_t                  high_watermark;  /*!< Highest filled size after a write is released */
+    uint32_t                  low_watermark;   /*!< Lowest filled size after a read is released */
+    esp_gmf_db_access_stats_t reader;          /*!< Statistics of the reader */
+    esp_gmf_db_access_stats_t writer;          /*!< Statistics of the writer */
+} esp_gmf_db_stats_t;
+
 /**
  * @brief  Structure representing the operations of a data bus
  */
@@ -47,9 +112,16 @@ struct data_bus_op_t {
 
     esp_gmf_err_io_t (*acquire_read)(esp_gmf_db_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int block_ticks);  /*!< Acquire a block of data for reading */
     esp_gmf_err_io_t (*release_read)(esp_gmf_db_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks);                        /*!< Release a block of data after reading */
+    esp_gmf_err_io_t (*acquire_read_batch)(esp_gmf_db_handle_t handle, esp_gmf_data_bus_block_t *blks[], int max_cnt, int block_ticks);  /*!< Optional, acquire several blocks of data for reading at once */
+    esp_gmf_err_io_t (*release_read_batch)(esp_gmf_db_handle_t handle, esp_gmf_data_bus_block_t *blks[], int cnt, int block_ticks);      /*!< Optional, release the blocks acquired at once after reading */
 
     esp_gmf_err_io_t (*acquire_write)(esp_gmf_db_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int block_ticks);  /*!< Acquire a block of data for writing */
     esp_gmf_err_io_t (*release_write)(esp_gmf_db_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks);                        /*!< Release a block of data after writing */
+    esp_gmf_err_io_t (*drop_unread)(esp_gmf_db_handle_t handle, uint32_t held_size, uint32_t *dropped_size);                              /*!< Optional, drop the unread data behind the data the reader holds */
+    esp_gmf_err_t (*set_meta)(esp_gmf_db_handle_t handle, const esp_gmf_db_meta_t *meta);                                                /*!< Optional, set the metadata of the block acquired for writing, called before `release_write` */
+    esp_gmf_err_t (*get_meta)(esp_gmf_db_handle_t handle, esp_gmf_db_meta_t *meta);                                                      /*!< Optional, get the metadata of the block acquired for reading */
+    esp_gmf_err_io_t (*acquire_read_in_place)(esp_gmf_db_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int block_ticks);   /*!< Optional, hand out the data in the storage without copy, released by `release_read` */
+    esp_gmf_err_io_t (*acquire_write_in_place)(esp_gmf_db_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int block_ticks);  /*!< Optional, hand out a region of the storage to write without copy, committed by `release_write` */
 
     esp_gmf_err_t (*done_write)(esp_gmf_db_handle_t handle);                               /*!< Signal that writing to the data bus is done */
     esp_gmf_err_t (*reset_done_write)(esp_gmf_db_handle_t handle);                         /*!< Reset the "done writing" signal */
@@ -64,14 +136,31 @@ struct data_bus_op_t {
  * @brief  Structure representing a data bus
  */
 typedef struct {
-    struct data_bus_op_t     op;            /*!< Operations of the data bus */
-    void                    *child;         /*!< Pointer to the child */
-    void                    *writer;        /*!< Pointer to the writer who call the write associated functions */
-    void                    *reader;        /*!< Pointer to the reader who call the read associated functions*/
-    const char              *name;          /*!< Name of the data bus */
-    esp_gmf_data_bus_type_t  type;          /*!< Type of the data bus */
-    int                      max_item_num;  /*!< Maximum number of items */
-    int                      max_size;      /*!< Maximum size */
+    struct data_bus_op_t     op;                                /*!< Operations of the data bus */
+    void                    *child;                             /*!< Pointer to the child */
+    void                    *writer;                            /*!< Pointer to the writer who call the write associated functions */
+    void                    *reader;                            /*!< Pointer to the reader who call the read associated functions */
+    const char              *name;                              /*!< Name of the data bus */
+    esp_gmf_data_bus_type_t  type;                              /*!< Type of the data bus */
+    int                      max_item_num;                      /*!< Maximum number of items */
+    int                      max_size;                          /*!< Maximum size */
+    void                    *notify_lock;                       /*!< Lock protecting the readiness notification callbacks */
+    esp_gmf_db_notify_cb     notify[ESP_GMF_DB_READY_MAX][ESP_GMF_DB_NOTIFY_MAX];      /*!< Readiness notification callbacks of the reader and the writer */
+    void                    *notify_ctx[ESP_GMF_DB_READY_MAX][ESP_GMF_DB_NOTIFY_MAX];  /*!< Context of the readiness notification callbacks */
+    uint8_t                  notify_cnt[ESP_GMF_DB_READY_MAX];                         /*!< Number of the readiness notification callbacks */
+    uint8_t                  _is_done;                          /*!< Writing is done, the reader is ready until it is reset */
+    uint8_t                  _is_abort;                         /*!< The data bus is aborted, both sides are ready until it is reset */
+    bool                     is_reading;                        /*!< The reader is acquiring data or holds data that can't be dropped behind, protected by `drop_lock` */
+    uint32_t                 read_held;                         /*!< Size of the data the reader holds, the unread data behind it can be dropped, protected by `drop_lock` */
+    bool                     is_dropping;                       /*!< The writer holds the scratch buffer, the data is dropped on release, only accessed by the writer */
+    bool                     wait_key;                          /*!< The written data is dropped until the next key frame, only accessed by the writer */
+    esp_gmf_db_stats_t       stats;                             /*!< Statistics, only recorded when `CONFIG_ESP_GMF_DB_STATS_EN` is enabled */
+    esp_gmf_db_drop_policy_t drop_policy;                       /*!< Policy when the writer finds no space */
+    void                    *drop_lock;                         /*!< Lock between the reader and the writer dropping the oldest data */
+    uint8_t                 *drop_buf;                          /*!< Scratch buffer receiving the data to drop */
+    uint32_t                 drop_buf_len;                      /*!< Length of the scratch buffer */
+    uint32_t                 dropped_cnt;                       /*!< Number of the dropped writes and reads */
+    void                    *trace;                             /*!< Trace stamps of the unread data for the data bus without `get_meta`, used when `CONFIG_ESP_GMF_LATENCY_TRACE_EN` is enabled */
 } esp_gmf_data_bus_t;
 
 /**
@@ -171,6 +260,42 @@ esp_gmf_err_io_t esp_gmf_db_acquire_read(esp_gmf_db_handle_t handle, esp_gmf_dat
  */
 esp_gmf_err_io_t esp_gmf_db_release_read(esp_gmf_db_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks);
 
+/**
+ * @brief  Acquire up to `max_cnt` blocks for reading in one call, which saves the per-block overhead for small frames
+ *         Only the first block is waited for. A data bus without batch support, like the ring buffers, acquires one block
+ *
+ * @note  The acquired blocks must be released by `esp_gmf_db_release_read_batch` with the returned count
+ *
+ * @param[in]   handle       Data bus handle
+ * @param[out]  blks         Array of pointers to the data bus block structures to be filled, in stream order
+ * @param[in]   max_cnt      Maximum number of blocks to acquire
+ * @param[in]   wanted_size  Size of data to acquire, used by the data bus without batch support
+ * @param[in]   block_ticks  Maximum time to wait for the first block
+ *
+ * @return
+ *       - > 0                 The number of acquired blocks
+ *       - ESP_GMF_IO_FAIL     Operation failed
+ *       - ESP_GMF_IO_ABORT    Operation aborted
+ *       - ESP_GMF_IO_TIMEOUT  Operation timed out
+ */
+esp_gmf_err_io_t esp_gmf_db_acquire_read_batch(esp_gmf_db_handle_t handle, esp_gmf_data_bus_block_t *blks[], int max_cnt, uint32_t wanted_size, int block_ticks);
+
+/**
+ * @brief  Release the blocks acquired by `esp_gmf_db_acquire_read_batch` in one call
+ *
+ * @param[in]  handle       Data bus handle
+ * @param[in]  blks         Array of pointers to the acquired data bus block structures
+ * @param[in]  cnt          Number of acquired blocks
+ * @param[in]  block_ticks  Maximum time to wait for the release operation
+ *
+ * @return
+ *       - ESP_GMF_IO_OK       Operation successful
+ *       - ESP_GMF_IO_FAIL     Operation failed
+ *       - ESP_GMF_IO_ABORT    Operation aborted
+ *       - ESP_GMF_IO_TIMEOUT  Operation timed out
+ */
+esp_gmf_err_io_t esp_gmf_db_release_read_batch(esp_gmf_db_handle_t handle, esp_gmf_data_bus_block_t *blks[], int cnt, int block_ticks);
+
 /**
  * @brief  Acquire space to write operation on data bus
  *
@@ -203,6 +328,113 @@ esp_gmf_err_io_t esp_gmf_db_acquire_write(esp_gmf_db_handle_t handle, esp_gmf_da
  */
 esp_gmf_err_io_t esp_gmf_db_release_write(esp_gmf_db_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks);
 
+/**
+ * @brief  Acquire data on data bus into a GMF payload, it can be set as the acquire operation of an in port
+ *
+ * @note  Unlike passing the payload as a block to `esp_gmf_db_acquire_read`, the metadata written by
+ *        `esp_gmf_db_release_payload_write` is carried to the payload, e.g. the trace stamp
+ *
+ * @param[in]      handle       Data bus handle
+ * @param[in,out]  load         Pointer to the payload
+ * @param[in]      wanted_size  Size of data to acquire
+ * @param[in]      block_ticks  Maximum time to wait for the acquire operation
+ *
+ * @return
+ *       - > 0                 The specific length of data being read
+ *       - ESP_GMF_IO_OK       Operation successful
+ *       - ESP_GMF_IO_FAIL     Operation failed
+ *       - ESP_GMF_IO_ABORT    Operation aborted
+ *       - ESP_GMF_IO_TIMEOUT  Operation timed out
+ */
+esp_gmf_err_io_t esp_gmf_db_acquire_payload_read(esp_gmf_db_handle_t handle, esp_gmf_payload_t *load, uint32_t wanted_size, int block_ticks);
+
+/**
+ * @brief  Release the payload acquired by `esp_gmf_db_acquire_payload_read`, it can be set as the release operation of an in port
+ *
+ * @param[in]  handle       Data bus handle
+ * @param[in]  load         Pointer to the payload
+ * @param[in]  block_ticks  Maximum time to wait for the release operation
+ *
+ * @return
+ *       - ESP_GMF_IO_OK       Operation successful
+ *       - ESP_GMF_IO_FAIL     Operation failed
+ *       - ESP_GMF_IO_ABORT    Operation aborted
+ *       - ESP_GMF_IO_TIMEOUT  Operation timed out
+ */
+esp_gmf_err_io_t esp_gmf_db_release_payload_read(esp_gmf_db_handle_t handle, esp_gmf_payload_t *load, int block_ticks);
+
+/**
+ * @brief  Acquire space on data bus for a GMF payload, it can be set as the acquire operation of an out port
+ *
+ * @param[in]      handle       Data bus handle
+ * @param[in,out]  load         Pointer to the payload
+ * @param[in]      wanted_size  Size of data to acquire
+ * @param[in]      block_ticks  Maximum time to wait for the acquire operation
+ *
+ * @return
+ *       - > 0                 The specific length of space can be write
+ *       - ESP_GMF_IO_OK       Operation successful
+ *       - ESP_GMF_IO_FAIL     Operation failed
+ *       - ESP_GMF_IO_ABORT    Operation aborted
+ *       - ESP_GMF_IO_TIMEOUT  Operation timed out
+ */
+esp_gmf_err_io_t esp_gmf_db_acquire_payload_write(esp_gmf_db_handle_t handle, esp_gmf_payload_t *load, uint32_t wanted_size, int block_ticks);
+
+/**
+ * @brief  Release the written payload to data bus along with its metadata, it can be set as the release operation of an out port
+ *
+ * @param[in]  handle       Data bus handle
+ * @param[in]  load         Pointer to the payload
+ * @param[in]  block_ticks  Maximum time to wait for the release operation
+ *
+ * @return
+ *       - ESP_GMF_IO_OK       Operation successful
+ *       - ESP_GMF_IO_FAIL     Operation failed
+ *       - ESP_GMF_IO_ABORT    Operation aborted
+ *       - ESP_GMF_IO_TIMEOUT  Operation timed out
+ */
+esp_gmf_err_io_t esp_gmf_db_release_payload_write(esp_gmf_db_handle_t handle, esp_gmf_payload_t *load, int block_ticks);
+
+/**
+ * @brief  Acquire data on data bus in place, the payload points to the storage of the data bus rather than having the data copied
+ *
+ *         It can be set as the acquire operation of an in port of the block type, which lends its payload the buffer
+ *         of the data bus, with `esp_gmf_db_release_payload_read` as the release operation. The data is consumed on release.
+ *         The payload gets at most `wanted_size` bytes, and can get fewer at the wrap point of the storage
+ *
+ * @param[in]      handle       Data bus handle
+ * @param[in,out]  load         Pointer to the payload, which must not own its buffer, e.g. the one of a block port
+ * @param[in]      wanted_size  Size of data to acquire
+ * @param[in]      block_ticks  Maximum time to wait for the acquire operation
+ *
+ * @return
+ *       - ESP_GMF_IO_OK       Operation successful
+ *       - ESP_GMF_IO_FAIL     Operation failed, or the data bus can't hand out its storage, e.g. it is not a ring buffer
+ *       - ESP_GMF_IO_ABORT    Operation aborted
+ *       - ESP_GMF_IO_TIMEOUT  Operation timed out
+ */
+esp_gmf_err_io_t esp_gmf_db_acquire_payload_read_in_place(esp_gmf_db_handle_t handle, esp_gmf_payload_t *load, uint32_t wanted_size, int block_ticks);
+
+/**
+ * @brief  Acquire space on data bus in place, the payload points to a contiguous region of `wanted_size` bytes in the storage of the data bus
+ *
+ *         It can be set as the acquire operation of an out port of the block type, with `esp_gmf_db_release_payload_write`
+ *         as the release operation, which commits `valid_size` bytes written in place. So the reader acquiring in place
+ *         gets the very memory the writer wrote
+ *
+ * @param[in]      handle       Data bus handle
+ * @param[in,out]  load         Pointer to the payload, which must not own its buffer, e.g. the one of a block port
+ * @param[in]      wanted_size  Size of space to acquire
+ * @param[in]      block_ticks  Maximum time to wait for the acquire operation
+ *
+ * @return
+ *       - ESP_GMF_IO_OK       Operation successful
+ *       - ESP_GMF_IO_FAIL     Operation failed, or the data bus can't hand out its storage, e.g. it is not a ring buffer
+ *       - ESP_GMF_IO_ABORT    Operation aborted
+ *       - ESP_GMF_IO_TIMEOUT  Operation timed out
+ */
+esp_gmf_err_io_t esp_gmf_db_acquire_payload_write_in_place(esp_gmf_db_handle_t handle, esp_gmf_payload_t *load, uint32_t wanted_size, int block_ticks);
+
 /**
  * @brief  Mark a write operation as done on data bus
  *
@@ -353,6 +585,131 @@ esp_gmf_err_t esp_gmf_db_get_type(esp_gmf_db_handle_t handle, esp_gmf_data_bus_t
  */
 const char *esp_gmf_db_get_name(esp_gmf_db_handle_t handle);
 
+/**
+ * @brief  Check whether the reader or the writer of the data bus can acquire without blocking
+ *
+ *         The reader is ready when the filled data reaches the wanted size, or writing is done. The writer is ready
+ *         when the available space reaches the wanted size. For a block type data bus one filled block is enough,
+ *         and the wanted size of a byte type data bus is limited to its total size. Both sides are ready after the
+ *         data bus is aborted. A data bus which can't report its filled or available size, and the writer of a block
+ *         type data bus, are always reported ready
+ *
+ * @param[in]   handle       data bus handle
+ * @param[in]   type         Reader or writer side to check
+ * @param[in]   wanted_size  Size to be acquired, 0 means any size
+ * @param[out]  ready        Pointer to store the readiness
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument
+ */
+esp_gmf_err_t esp_gmf_db_is_ready(esp_gmf_db_handle_t handle, esp_gmf_db_ready_t type, uint32_t wanted_size, bool *ready);
+
+/**
+ * @brief  Set the callback which is called when the reader or the writer of the data bus may have become ready
+ *
+ *         The reader callback is called after data is released by the writer, writing is done or the data bus is aborted.
+ *         The writer callback is called after data is released by the reader, or the data bus is reset or aborted.
+ *         Each side keeps up to `ESP_GMF_DB_NOTIFY_MAX` callbacks told apart by `ctx`, so several pipelines writing
+ *         to one data bus are all notified. Setting a callback for a known `ctx` replaces it
+ *
+ * @param[in]  handle  data bus handle
+ * @param[in]  type    Reader or writer side to be notified
+ * @param[in]  cb      Notification callback, NULL to clear the one of `ctx`, or all of them if `ctx` is NULL too
+ * @param[in]  ctx     Context passed to the callback
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument
+ *       - ESP_GMF_ERR_NOT_ENOUGH   All the callbacks of the side are in use
+ */
+esp_gmf_err_t esp_gmf_db_set_notify(esp_gmf_db_handle_t handle, esp_gmf_db_ready_t type, esp_gmf_db_notify_cb cb, void *ctx);
+
+/**
+ * @brief  Call the readiness callbacks of the reader or the writer of the data bus
+ *
+ * @note  It is intended for the data bus implementations whose state is shared by several data bus handles,
+ *        such as the readers of a broadcast data bus, to notify a handle which is not the one being accessed
+ *
+ * @param[in]  handle  data bus handle
+ * @param[in]  type    Reader or writer side to be notified
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument
+ */
+esp_gmf_err_t esp_gmf_db_notify_ready(esp_gmf_db_handle_t handle, esp_gmf_db_ready_t type);
+
+/**
+ * @brief  Get the statistics of the data bus
+ *
+ *         An acquisition is counted as blocked when `esp_gmf_db_is_ready` reports the side not ready before it, and for the
+ *         writer of a block type data bus when no space is available while data is filled, e.g. a FIFO full of blocks.
+ *         The writer of a byte type data bus which copies its own buffer is checked on `esp_gmf_db_release_write` instead,
+ *         where the copy waits for space. Non-blocking calls are never counted as blocked
+ *
+ * @param[in]   handle  data bus handle
+ * @param[out]  stats   Pointer to store the statistics
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument
+ *       - ESP_GMF_ERR_NOT_SUPPORT  `CONFIG_ESP_GMF_DB_STATS_EN` is disabled
+ */
+esp_gmf_err_t esp_gmf_db_get_stats(esp_gmf_db_handle_t handle, esp_gmf_db_stats_t *stats);
+
+/**
+ * @brief  Set the policy of the data bus when the reader falls behind
+ *
+ *         With a drop policy, the writer doesn't wait for the reader, so a live stream keeps a bounded latency under load.
+ *         `ESP_GMF_DB_DROP_OLDEST` reads out as much old data as the writer wants. The data the reader holds is kept,
+ *         and the unread data behind it is dropped when the data bus supports it, e.g. the block one, otherwise the
+ *         writer waits for the release. The writer waits while the reader is acquiring data too.
+ *         `ESP_GMF_DB_DROP_NEWEST` and `ESP_GMF_DB_DROP_TO_KEY_FRAME` give the writer a scratch buffer, which is dropped
+ *         on release if there is still no space. The latter keeps dropping until the written data has
+ *         `ESP_GMF_META_FLAG_VID_KEY_FRAME` in `meta_flag`, so the reader never gets the frames depending on lost ones.
+ *         The flag is given by `esp_gmf_db_release_payload_write`, the data released as a block has none.
+ *         The block marked as the last one is never dropped, the writer waits for it
+ *
+ * @note  It's only supported by the block type data bus, and it must be set before the data flows
+ *
+ * @param[in]  handle  data bus handle
+ * @param[in]  policy  Drop policy
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument
+ *       - ESP_GMF_ERR_NOT_SUPPORT  The data bus can't drop data
+ *       - ESP_GMF_ERR_MEMORY_LACK  Failed to create the lock
+ */
+esp_gmf_err_t esp_gmf_db_set_drop_policy(esp_gmf_db_handle_t handle, esp_gmf_db_drop_policy_t policy);
+
+/**
+ * @brief  Get the number of the data dropped by the drop policy of the data bus
+ *
+ *         Each acquisition of the writer dropped and each piece of old data read out is counted once
+ *
+ * @param[in]   handle       data bus handle
+ * @param[out]  dropped_cnt  Pointer to store the number of drops
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument
+ */
+esp_gmf_err_t esp_gmf_db_get_dropped(esp_gmf_db_handle_t handle, uint32_t *dropped_cnt);
+
+/**
+ * @brief  Clear the statistics of the data bus
+ *
+ * @param[in]  handle  data bus handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument
+ *       - ESP_GMF_ERR_NOT_SUPPORT  `CONFIG_ESP_GMF_DB_STATS_EN` is disabled
+ */
+esp_gmf_err_t esp_gmf_db_reset_stats(esp_gmf_db_handle_t handle);
+
 #ifdef __cplusplus
 }
 #endif  /* __cplusplus */
@@ -56,6 +56,43 @@ esp_gmf_err_t esp_gmf_fifo_create(int block_cnt, int block_size, esp_gmf_fifo_ha
  */
 esp_gmf_err_t esp_gmf_fifo_set_align(esp_gmf_fifo_handle_t handle, uint8_t align);
 
+/**
+ * @brief  Preallocate all the nodes of the FIFO with buffers of the maximum node size
+ *
+ *         All the nodes up to the block count of the FIFO are allocated at once, so that the steady state of
+ *         `esp_gmf_fifo_acquire_write` does no heap operation. Acquiring a size larger than `max_node_size` fails afterwards
+ *
+ * @note  Should call this API after `esp_gmf_fifo_set_align` and before `esp_gmf_fifo_acquire_write`
+ *
+ * @param[in]  handle         FIFO handle
+ * @param[in]  max_node_size  Size of each preallocated buffer in bytes, 0 to go back to allocating on demand
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Success
+ *       - ESP_GMF_ERR_MEMORY_LACK  Memory allocation failed
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_fifo_prealloc(esp_gmf_fifo_handle_t handle, uint32_t max_node_size);
+
+/**
+ * @brief  Let the FIFO adapt its block count to the traffic
+ *
+ *         A writer stall on a full FIFO raises the block count by one up to `max_block_cnt`. After each `quiet_ms` without
+ *         writer stall, the block count drops by one back to the count given at creation, the surplus buffer is freed when
+ *         the reader releases it, so no data is ever dropped. A reader underrun on an empty FIFO doesn't change the count
+ *
+ * @note  Nodes added on growth use the preallocated size when `esp_gmf_fifo_prealloc` is called, they are allocated on demand
+ *
+ * @param[in]  handle         FIFO handle
+ * @param[in]  max_block_cnt  Ceiling of the block count, not greater than the count given at creation to disable adaptation
+ * @param[in]  quiet_ms       Quiet period in milliseconds before shrinking by one block
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_fifo_set_adaptive(esp_gmf_fifo_handle_t handle, int max_block_cnt, uint32_t quiet_ms);
+
 /**
  * @brief  Destroy the FIFO buffer and release resources
  *
@@ -106,6 +143,41 @@ esp_gmf_err_io_t esp_gmf_fifo_acquire_read(esp_gmf_fifo_handle_t handle, esp_gmf
  */
 esp_gmf_err_io_t esp_gmf_fifo_release_read(esp_gmf_fifo_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks);
 
+/**
+ * @brief  Acquire up to `max_cnt` filled blocks from the FIFO in one call, to amortise the per-block overhead for small frames
+ *         It waits only for the first block like `esp_gmf_fifo_acquire_read`, the others are the blocks already filled,
+ *         and it stops after the last block of the stream
+ *
+ * @note  1. The blocks must be released by `esp_gmf_fifo_release_read_batch` with the same array and the returned count
+ *        2. No other read can be acquired before the batch is released
+ *
+ * @param[in]   handle       FIFO handle
+ * @param[out]  blks         Array of pointers to the data block structures to be filled, in stream order
+ * @param[in]   max_cnt      Maximum number of blocks to acquire
+ * @param[in]   block_ticks  Maximum ticks to wait if no block is available
+ *
+ * @return
+ *       - > 0                 The number of acquired blocks
+ *       - ESP_GMF_IO_FAIL     Invalid arguments
+ *       - ESP_GMF_IO_TIMEOUT  Operation timed out
+ *       - ESP_GMF_IO_ABORT    Operation aborted
+ */
+esp_gmf_err_io_t esp_gmf_fifo_acquire_read_batch(esp_gmf_fifo_handle_t handle, esp_gmf_data_bus_block_t *blks[], int max_cnt, int block_ticks);
+
+/**
+ * @brief  Return the blocks acquired by `esp_gmf_fifo_acquire_read_batch` in one call, under one lock and with one writer wakeup
+ *
+ * @param[in]  handle       FIFO handle
+ * @param[in]  blks         Array of pointers to the acquired data block structures
+ * @param[in]  cnt          Number of acquired blocks
+ * @param[in]  block_ticks  Maximum ticks to wait if necessary
+ *
+ * @return
+ *       - ESP_GMF_IO_OK    Operation succeeded
+ *       - ESP_GMF_IO_FAIL  Invalid arguments, or the buffers are not the filled blocks in order
+ */
+esp_gmf_err_io_t esp_gmf_fifo_release_read_batch(esp_gmf_fifo_handle_t handle, esp_gmf_data_bus_block_t *blks[], int cnt, int block_ticks);
+
 /**
  * @brief  Acquire freed block to the desired size within a specific handle
  *         If the number of the list is reach the maximum and block_ticks is greater than 0, the function will block
@@ -114,8 +186,11 @@ esp_gmf_err_io_t esp_gmf_fifo_release_read(esp_gmf_fifo_handle_t handle, esp_gmf
  * @note  1. `esp_gmf_fifo_acquire_write` and `esp_gmf_fifo_release_write` must be called in pairs
  *        2. The obtained buffer address is internal and should not be freed externally
  *        3. The `wanted_size` parameter is used to specify the size of the block that can be written
- *        4. If the freed block is not ready and the number of items in the list is below the maximum limit, a new node and buffer will be allocated for the list
- *        5. If the obtained buffer is smaller than the `wanted_size`, the buffer will be reallocated to match the requested size
+ *        4. The smallest freed block which fits `wanted_size` is reused. If none fits and the number of items in the list is below
+ *           the maximum limit, a new node and buffer will be allocated for the list
+ *        5. Otherwise the smallest freed block is reallocated. Buffers are aligned as set by `esp_gmf_fifo_set_align` and sized
+ *           by classes (the size is rounded up to a quarter of its highest power of two), so that blocks of varying size get reused
+ *        6. After `esp_gmf_fifo_prealloc`, no buffer is allocated any more and `wanted_size` larger than the maximum node size fails
  *
  * @param[in]   handle       FIFO handle
  * @param[out]  blk          Pointer to the data block structure to be filled
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "esp_gmf_data_bus.h"
+#include "esp_gmf_bcast.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -16,6 +17,9 @@ extern "C" {
 /**
  * @brief  Create a new ring buffer with the specified item count and size
  *
+ *         The ports of the block type can read and write its storage without copy, by setting
+ *         `esp_gmf_db_acquire_payload_read_in_place` and `esp_gmf_db_acquire_payload_write_in_place` as their acquire operations
+ *
  * @param[in]   num       Size of each item
  * @param[in]   item_cnt  Number of items
  * @param[out]  h         Pointer to store the handle of the GMF data bus
@@ -26,6 +30,21 @@ extern "C" {
  */
 int esp_gmf_db_new_ringbuf(int num, int item_cnt, esp_gmf_db_handle_t *h);
 
+/**
+ * @brief  Create a new lock-free ring buffer for single producer and single consumer with the specified item count and size
+ *
+ * @note  Only one task may write and only one task may read the created data bus
+ *
+ * @param[in]   num       Size of each item
+ * @param[in]   item_cnt  Number of items
+ * @param[out]  h         Pointer to store the handle of the GMF data bus
+ *
+ * @return
+ *       - 0    On success
+ *       - < 0  Negative value if an error occurs
+ */
+int esp_gmf_db_new_spsc_ringbuf(int num, int item_cnt, esp_gmf_db_handle_t *h);
+
 /**
  * @brief  Create a new block buffer with the specified item count and size
  *
@@ -65,6 +84,83 @@ int esp_gmf_db_new_pbuf(int num, int item_cnt, esp_gmf_db_handle_t *h);
  */
 int esp_gmf_db_new_fifo(int num, int item_cnt, esp_gmf_db_handle_t *h);
 
+/**
+ * @brief  Create a new FIFO buffer whose number of items adapts to the traffic
+ *
+ * @note  The FIFO grows by one item on a writer stall up to `max_num`, and shrinks by one item back to `num` after
+ *        each `quiet_ms` without writer stall, see `esp_gmf_fifo_set_adaptive`
+ *
+ * @param[in]   num       Initial and minimum number of items
+ * @param[in]   max_num   Maximum number of items
+ * @param[in]   quiet_ms  Quiet period in milliseconds before shrinking by one item
+ * @param[out]  h         Pointer to store the handle of the GMF data bus
+ *
+ * @return
+ *       - 0    On success
+ *       - < 0  Negative value if an error occurs
+ */
+int esp_gmf_db_new_adaptive_fifo(int num, int max_num, uint32_t quiet_ms, esp_gmf_db_handle_t *h);
+
+/**
+ * @brief  Create a new broadcast buffer with the specified item count and size, the created data bus is the writer
+ *
+ * @note  Readers are added by `esp_gmf_db_new_broadcast_reader`, a block published by the writer is shared by
+ *        all the readers without copy, and it is reused once the last reader releases it
+ *
+ * @param[in]   num       Number of blocks
+ * @param[in]   item_cnt  Minimum size of each block
+ * @param[out]  h         Pointer to store the handle of the GMF data bus
+ *
+ * @return
+ *       - 0    On success
+ *       - < 0  Negative value if an error occurs
+ */
+int esp_gmf_db_new_broadcast(int num, int item_cnt, esp_gmf_db_handle_t *h);
+
+/**
+ * @brief  Create a new reader data bus of a broadcast buffer
+ *
+ * @param[in]   writer  Data bus handle created by `esp_gmf_db_new_broadcast`
+ * @param[in]   policy  Drop policy applied when the reader falls behind the writer
+ * @param[out]  h       Pointer to store the handle of the GMF data bus
+ *
+ * @return
+ *       - 0    On success
+ *       - < 0  Negative value if an error occurs
+ */
+int esp_gmf_db_new_broadcast_reader(esp_gmf_db_handle_t writer, esp_gmf_bcast_drop_policy_t policy, esp_gmf_db_handle_t *h);
+
+/**
+ * @brief  Publish a buffer owned by the writer to all the readers of a broadcast buffer by reference, see `esp_gmf_bcast_write_ref`
+ *
+ * @param[in]  writer       Data bus handle created by `esp_gmf_db_new_broadcast`
+ * @param[in]  blk          The data block to publish
+ * @param[in]  meta         Metadata published along with the block, NULL if none
+ * @param[in]  ref_free     Callback returning the buffer to the writer once the last reader releases or drops it
+ * @param[in]  ref_ctx      Context of `ref_free`
+ * @param[in]  block_ticks  Maximum duration to wait for a free block
+ *
+ * @return
+ *       - ESP_GMF_IO_OK       On success, the buffer belongs to the broadcast buffer until `ref_free` is called
+ *       - ESP_GMF_IO_FAIL     Invalid arguments or the data bus is not a broadcast writer
+ *       - ESP_GMF_IO_TIMEOUT  No block is free in time, the buffer still belongs to the writer
+ *       - ESP_GMF_IO_ABORT    Operation aborted, the buffer still belongs to the writer
+ */
+int esp_gmf_db_broadcast_write_ref(esp_gmf_db_handle_t writer, const esp_gmf_data_bus_block_t *blk, const esp_gmf_db_meta_t *meta,
+                                   esp_gmf_bcast_ref_free_t ref_free, void *ref_ctx, int block_ticks);
+
+/**
+ * @brief  Change the drop policy of a broadcast reader data bus
+ *
+ * @param[in]  reader  Data bus handle created by `esp_gmf_db_new_broadcast_reader`
+ * @param[in]  policy  Drop policy applied when the reader falls behind the writer
+ *
+ * @return
+ *       - 0    On success
+ *       - < 0  Negative value if an error occurs
+ */
+int esp_gmf_db_set_broadcast_reader_policy(esp_gmf_db_handle_t reader, esp_gmf_bcast_drop_policy_t policy);
+
 #ifdef __cplusplus
 }
 #endif  /* __cplusplus */
@@ -22,6 +22,15 @@ extern "C" {
  *         `esp_gmf_rb_release_read` and `esp_gmf_rb_acquire_write` have no practical significance.
  *
  *         The `esp_gmf_rb_release_write` and `esp_gmf_rb_acquire_read` have blocking functionality.
+ *
+ *         The in-place access is an explicit opt-in through `esp_gmf_rb_acquire_read_in_place` and
+ *         `esp_gmf_rb_acquire_write_in_place`: they hand out a contiguous region of the storage, and the release
+ *         functions commit or consume it without copy. Through the data bus, the ports of the block type opt in by
+ *         `esp_gmf_db_acquire_payload_read_in_place` and `esp_gmf_db_acquire_payload_write_in_place`.
+ *         The storage is laid out as a bip-buffer, the writer moves to the buffer head early when the tail is too
+ *         short for the wanted size, so an in-place write always gets `wanted_size` bytes. An in-place read gets the
+ *         contiguous part of the wanted size, which can be shorter at the wrap point. Only one in-place region of each
+ *         direction can be held at a time, and it must be released before the next acquire of the same direction.
  */
 
 /**
@@ -69,6 +78,9 @@ esp_gmf_err_t esp_gmf_rb_reset(esp_gmf_rb_handle_t handle);
  *         When the ring buffer handle cannot provide enough size, it will block for the duration specified by block_ticks.
  *         The actual valid size is stored in `blk->valid_size`
  *
+ * @note  When `blk->buf` is NULL the data is consumed without copy, which discards it. When `blk->buf` is still the
+ *        region of a previous in-place read, it works as `esp_gmf_rb_acquire_read_in_place`
+ *
  * @param[in]   handle         The Ringbuffer handle
  * @param[out]  blk            Pointer to the data block structure to be filled
  * @param[in]   wanted_size    Desired size to read
@@ -86,7 +98,7 @@ esp_gmf_err_io_t esp_gmf_rb_acquire_read(esp_gmf_rb_handle_t handle, esp_gmf_dat
 /**
  * @brief  Release the read operation
  *
- * @note  It's do nothing due to read acquire is a copy operation
+ * @note  It's do nothing for the copied read, for the in-place read it consumes `blk->valid_size` bytes
  *
  * @param[in]  handle       The Ringbuffer handle
  * @param[in]  blk          Pointer to the data block structure to release
@@ -100,7 +112,8 @@ esp_gmf_err_io_t esp_gmf_rb_release_read(esp_gmf_rb_handle_t handle, esp_gmf_dat
 /**
  * @brief  Acquire space for write
  *
- * @note  It's do nothing due to write acquire is a copy operation
+ * @note  It's do nothing, the buffer set in `blk->buf` before `esp_gmf_rb_release_write` is copied on release.
+ *        When `blk->buf` is still the region of a previous in-place write, it works as `esp_gmf_rb_acquire_write_in_place`
  *
  * @param[in]   handle         The Ringbuffer handle
  * @param[out]  blk            Pointer to the data block structure to be filled
@@ -116,9 +129,45 @@ esp_gmf_err_io_t esp_gmf_rb_release_read(esp_gmf_rb_handle_t handle, esp_gmf_dat
  */
 esp_gmf_err_io_t esp_gmf_rb_acquire_write(esp_gmf_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait);
 
+/**
+ * @brief  Acquire the readable data in place, `blk->buf` is set to the region inside the ring buffer instead of copying
+ *         Only the contiguous part of `wanted_size` is handed out, which can be shorter at the wrap point, the rest
+ *         follows on the next acquire. The region is consumed by `esp_gmf_rb_release_read`
+ *
+ * @param[in]   handle         The Ringbuffer handle
+ * @param[out]  blk            Pointer to the data block structure to be filled
+ * @param[in]   wanted_size    Desired size to read, no larger than the ring buffer size
+ * @param[in]   ticks_to_wait  Maximum duration to wait for the operation to complete
+ *
+ * @return
+ *       - ESP_GMF_IO_OK       Operation succeeded
+ *       - ESP_GMF_IO_FAIL     Invalid arguments
+ *       - ESP_GMF_IO_TIMEOUT  Operation timed out
+ *       - ESP_GMF_IO_ABORT    Operation aborted
+ */
+esp_gmf_err_io_t esp_gmf_rb_acquire_read_in_place(esp_gmf_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait);
+
+/**
+ * @brief  Acquire a free region in place, it blocks until `wanted_size` contiguous bytes are free, then sets `blk->buf`
+ *         to that region for writing. The data written is committed by `esp_gmf_rb_release_write` without copy
+ *
+ * @param[in]   handle         The Ringbuffer handle
+ * @param[out]  blk            Pointer to the data block structure to be filled
+ * @param[in]   wanted_size    Desired size to write, no larger than the ring buffer size
+ * @param[in]   ticks_to_wait  Maximum duration to wait for the operation to complete
+ *
+ * @return
+ *       - ESP_GMF_IO_OK       Operation succeeded
+ *       - ESP_GMF_IO_FAIL     Invalid arguments
+ *       - ESP_GMF_IO_TIMEOUT  Operation timed out
+ *       - ESP_GMF_IO_ABORT    Operation aborted
+ */
+esp_gmf_err_io_t esp_gmf_rb_acquire_write_in_place(esp_gmf_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait);
+
 /**
  * @brief  Copy the given buffer to the ring buffer with specific handle
  *         When the ring buffer handle cannot accommodate the given buffer size, it will block for the duration specified by block_ticks.
+ *         For the in-place write, it commits `blk->valid_size` bytes written into the acquired region without copy
  *
  * @param[in]  handle       The Ringbuffer handle
  * @param[in]  blk          Pointer to the data block structure to release
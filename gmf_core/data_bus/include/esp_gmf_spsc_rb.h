@@ -0,0 +1,206 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "esp_gmf_data_bus.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  GMF SPSC ringbuffer is a lock-free ring buffer for exactly one writer task and one reader task.
+ *         It has the same copy semantics as the GMF ringbuffer: `esp_gmf_spsc_rb_acquire_read` copies data out
+ *         and `esp_gmf_spsc_rb_release_write` copies data in, `esp_gmf_spsc_rb_release_read` and
+ *         `esp_gmf_spsc_rb_acquire_write` have no practical significance.
+ *
+ *         The read and write positions are atomic indices owned by the reader and the writer respectively,
+ *         so transferring data takes no lock. A semaphore is only taken when the ring buffer is empty for the
+ *         reader or full for the writer, and only given when the other side is waiting on it.
+ *
+ * @note  Concurrent readers or concurrent writers are not supported, use the GMF ringbuffer for such case
+ */
+
+/**
+ * @brief  Handle to the SPSC ring buffer
+ */
+typedef void *esp_gmf_spsc_rb_handle_t;
+
+/**
+ * @brief  Create a SPSC ring buffer with total size = block_size * n_blocks
+ *
+ * @param[in]   block_size  Size of each block
+ * @param[in]   n_blocks    Number of blocks
+ * @param[out]  handle      Pointer to store the handle to the created SPSC ring buffer
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           Operation successful
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument provided
+ *       - ESP_GMF_ERR_MEMORY_LACK  Insufficient memory
+ */
+esp_gmf_err_t esp_gmf_spsc_rb_create(int block_size, int n_blocks, esp_gmf_spsc_rb_handle_t *handle);
+
+/**
+ * @brief  Cleanup and free all memory allocated for the SPSC ring buffer
+ *
+ * @param[in]  handle  The SPSC ring buffer handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_rb_destroy(esp_gmf_spsc_rb_handle_t handle);
+
+/**
+ * @brief  Reset the SPSC ring buffer, clearing all values to the initial state
+ *
+ * @note  It must not be called while the reader or the writer is accessing the ring buffer
+ *
+ * @param[in]  handle  The SPSC ring buffer handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_rb_reset(esp_gmf_spsc_rb_handle_t handle);
+
+/**
+ * @brief  Copy valid data from the SPSC ring buffer to the given buffer
+ *         When the ring buffer cannot provide enough data, it will block for the duration specified by ticks_to_wait.
+ *         The actual valid size is stored in `blk->valid_size`
+ *
+ * @param[in]   handle         The SPSC ring buffer handle
+ * @param[out]  blk            Pointer to the data block structure to be filled
+ * @param[in]   wanted_size    Desired size to read
+ * @param[in]   ticks_to_wait  Maximum duration to wait for the operation to complete
+ *
+ * @return
+ *       - ESP_GMF_IO_OK       Operation succeeded
+ *       - ESP_GMF_IO_FAIL     Invalid arguments
+ *       - ESP_GMF_IO_TIMEOUT  Operation timed out
+ *       - ESP_GMF_IO_ABORT    Operation aborted
+ */
+esp_gmf_err_io_t esp_gmf_spsc_rb_acquire_read(esp_gmf_spsc_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait);
+
+/**
+ * @brief  Release the read operation
+ *
+ * @note  It's do nothing due to read acquire is a copy operation
+ *
+ * @param[in]  handle       The SPSC ring buffer handle
+ * @param[in]  blk          Pointer to the data block structure to release
+ * @param[in]  block_ticks  Maximum duration to wait for the operation to complete
+ *
+ * @return
+ *       - ESP_GMF_IO_OK  Operation succeeded
+ */
+esp_gmf_err_io_t esp_gmf_spsc_rb_release_read(esp_gmf_spsc_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks);
+
+/**
+ * @brief  Acquire space for write
+ *
+ * @note  It's do nothing due to write release is a copy operation
+ *
+ * @param[in]   handle         The SPSC ring buffer handle
+ * @param[out]  blk            Pointer to the data block structure to be filled
+ * @param[in]   wanted_size    Desired size to write
+ * @param[in]   ticks_to_wait  Maximum duration to wait for the operation to complete
+ *
+ * @return
+ *       - ESP_GMF_IO_OK  Operation succeeded
+ */
+esp_gmf_err_io_t esp_gmf_spsc_rb_acquire_write(esp_gmf_spsc_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, uint32_t wanted_size, int ticks_to_wait);
+
+/**
+ * @brief  Copy the given buffer to the SPSC ring buffer
+ *         When the ring buffer cannot accommodate the given buffer size, it will block for the duration specified by block_ticks.
+ *
+ * @param[in]  handle       The SPSC ring buffer handle
+ * @param[in]  blk          Pointer to the data block structure to release
+ * @param[in]  block_ticks  Maximum duration to wait for the operation to complete
+ *
+ * @return
+ *       - ESP_GMF_IO_OK       Operation succeeded
+ *       - ESP_GMF_IO_FAIL     Invalid arguments
+ *       - ESP_GMF_IO_TIMEOUT  Operation timed out
+ *       - ESP_GMF_IO_ABORT    Operation aborted
+ */
+esp_gmf_err_io_t esp_gmf_spsc_rb_release_write(esp_gmf_spsc_rb_handle_t handle, esp_gmf_data_bus_block_t *blk, int block_ticks);
+
+/**
+ * @brief  Abort any pending operations on the SPSC ring buffer
+ *
+ * @param[in]  handle  The SPSC ring buffer handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_rb_abort(esp_gmf_spsc_rb_handle_t handle);
+
+/**
+ * @brief  Set the status of writing to the SPSC ring buffer as done
+ *
+ * @param[in]  handle  The SPSC ring buffer handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_rb_done_write(esp_gmf_spsc_rb_handle_t handle);
+
+/**
+ * @brief  Reset the status of writing to the SPSC ring buffer as not done
+ *
+ * @param[in]  handle  The SPSC ring buffer handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_rb_reset_done_write(esp_gmf_spsc_rb_handle_t handle);
+
+/**
+ * @brief  Get the number of bytes available for writing to the SPSC ring buffer
+ *
+ * @param[in]   handle          The SPSC ring buffer handle
+ * @param[out]  available_size  Pointer to store the available size
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_rb_bytes_available(esp_gmf_spsc_rb_handle_t handle, uint32_t *available_size);
+
+/**
+ * @brief  Get the number of bytes filled in the SPSC ring buffer
+ *
+ * @param[in]   handle       The SPSC ring buffer handle
+ * @param[out]  filled_size  Pointer to store the filled size
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_rb_bytes_filled(esp_gmf_spsc_rb_handle_t handle, uint32_t *filled_size);
+
+/**
+ * @brief  Get the total size of the SPSC ring buffer
+ *
+ * @param[in]   handle      The SPSC ring buffer handle
+ * @param[out]  valid_size  Pointer to store the total size
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_spsc_rb_get_size(esp_gmf_spsc_rb_handle_t handle, uint32_t *valid_size);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
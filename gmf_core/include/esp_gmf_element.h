@@ -72,6 +72,17 @@ typedef struct {
                                          recommended for all elements, even those without specific processing requirements */
 } esp_gmf_element_port_attr_t;
 
+/**
+ * @brief  In-place processing declared by an element
+ *         The pipeline plans the buffer sharing of the whole chain on run, an element declaring it runs on the buffer of its input
+ *         only when the plan grants it, which is reported by the `is_shared` flag of its in port. An element whose output size
+ *         depends on its stream format declares it only while it gets no larger, a declaration changed on open is planned on the next run
+ */
+typedef struct {
+    bool      enable;    /*!< The element can write its output over its input buffer */
+    uint16_t  grow_pct;  /*!< Maximum growth of the output over the input in percent, 0 when the output never gets larger */
+} esp_gmf_element_in_place_t;
+
 /**
  * @brief  Function pointer type for load element capability
  */
@@ -88,6 +99,9 @@ typedef struct {
     esp_gmf_job_func          open;            /*!< Function to open the element */
     esp_gmf_job_func          process;         /*!< Function to process the element */
     esp_gmf_job_func          close;           /*!< Function to close the element */
+    esp_gmf_job_func          reset;           /*!< Function to reset the opened element for the next stream instead of closing and opening it,
+                                                    it drops the data of the last stream and reports the stream information like `open`. It's optional,
+                                                    see `esp_gmf_pipeline_set_warm_restart` */
     esp_gmf_load_caps_func    load_caps;       /*!< Function to load element capability description */
     esp_gmf_load_method_func  load_methods;    /*!< Function to load element methods */
     esp_gmf_event_cb          event_receiver;  /*!< Event receiver function */
@@ -106,6 +120,7 @@ typedef struct esp_gmf_element {
 
     esp_gmf_port_t              *out;            /*!< Output port */
     esp_gmf_element_port_attr_t  out_attr;       /*!< Output port attributes */
+    esp_gmf_element_in_place_t   in_place;       /*!< In-place processing declared by the element */
 
     /* Properties */
     esp_gmf_event_state_t        init_state;     /*!< Initial state */
@@ -117,8 +132,24 @@ typedef struct esp_gmf_element {
     /* Protect */
     void                        *ctx;            /*!< User Context */
     uint8_t                      dependency : 1; /*!< Indicates if the element depends on other information to open */
+    uint8_t                      truncated  : 1; /*!< The last process is truncated, the input data is not consumed completely */
+    uint8_t                      opened     : 1; /*!< The element is opened and not closed yet */
+    void                        *trace;          /*!< Latency records, used when `CONFIG_ESP_GMF_LATENCY_TRACE_EN` is enabled */
 } esp_gmf_element_t;
 
+/**
+ * @brief  Latency statistics of the payloads, the percentiles are estimated from power of two buckets
+ */
+typedef struct {
+    uint32_t  cnt;     /*!< Number of the traced payloads */
+    uint32_t  min_us;  /*!< Shortest latency in microseconds */
+    uint32_t  max_us;  /*!< Longest latency in microseconds */
+    uint32_t  avg_us;  /*!< Average latency in microseconds */
+    uint32_t  p50_us;  /*!< Median latency in microseconds */
+    uint32_t  p90_us;  /*!< 90th percentile latency in microseconds */
+    uint32_t  p99_us;  /*!< 99th percentile latency in microseconds */
+} esp_gmf_latency_stats_t;
+
 /**
  * @brief  Configuration structure for a GMF element
  */
@@ -128,6 +159,7 @@ typedef struct {
     esp_gmf_element_port_attr_t  in_attr;     /*!< Input port attributes */
     esp_gmf_element_port_attr_t  out_attr;    /*!< Output port attributes */
     bool                         dependency;  /*!< Indicates if the element depends on other information to open */
+    esp_gmf_element_in_place_t   in_place;    /*!< In-place processing the element supports, all zero when it always needs a separate output */
 } esp_gmf_element_cfg_t;
 
 /**
@@ -274,6 +306,21 @@ esp_gmf_err_t esp_gmf_element_get_prev_el(esp_gmf_element_handle_t handle, esp_g
  */
 esp_gmf_job_err_t esp_gmf_element_process_open(esp_gmf_element_handle_t handle, void *para);
 
+/**
+ * @brief  Process the close phase for the element kept opened for a warm restart
+ *
+ *         It releases the port references like `esp_gmf_element_process_close` and leaves the element opened,
+ *         the next `esp_gmf_element_process_open` resets the element by `ops.reset` rather than opening it
+ *
+ * @param[in]  handle  GMF element handle
+ * @param[in]  para    Pointer to the parameters for processing
+ *
+ * @return
+ *       - ESP_GMF_JOB_ERR_OK    Indicating the job has executed successfully
+ *       - ESP_GMF_JOB_ERR_FAIL  Indicating the element does not support reset
+ */
+esp_gmf_job_err_t esp_gmf_element_process_keep(esp_gmf_element_handle_t handle, void *para);
+
 /**
  * @brief  Process the close phase for the specific element
  *
@@ -491,6 +538,59 @@ esp_gmf_err_t esp_gmf_element_get_method(esp_gmf_element_handle_t handle, const
  */
 esp_gmf_err_t esp_gmf_element_get_caps(esp_gmf_element_handle_t handle, const esp_gmf_cap_t **caps);
 
+/**
+ * @brief  Get the latency statistics of the specific element
+ *
+ *         The element latency is the time from acquiring the input to releasing each output. The end-to-end latency
+ *         is the time from the payload entering the element chain to leaving it by this element, it is only counted
+ *         by the element which writes out of the chain, e.g. the last element of the pipeline
+ *
+ * @param[in]   handle      GMF element handle
+ * @param[in]   end_to_end  True to get the end-to-end latency, false to get the element latency
+ * @param[out]  stats       Pointer to store the statistics
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_NOT_SUPPORT  `CONFIG_ESP_GMF_LATENCY_TRACE_EN` is disabled, or the records failed to allocate
+ */
+esp_gmf_err_t esp_gmf_element_get_latency_stats(esp_gmf_element_handle_t handle, bool end_to_end, esp_gmf_latency_stats_t *stats);
+
+/**
+ * @brief  Clear the latency statistics of the specific element
+ *
+ * @param[in]  handle  GMF element handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Indicating the handle is invalid
+ *       - ESP_GMF_ERR_NOT_SUPPORT  `CONFIG_ESP_GMF_LATENCY_TRACE_EN` is disabled, or the records failed to allocate
+ */
+esp_gmf_err_t esp_gmf_element_reset_latency_stats(esp_gmf_element_handle_t handle);
+
+/**
+ * @brief  Trace the input of the element, it is called by the GMF ports once the input is acquired
+ *
+ * @note  Do nothing when `CONFIG_ESP_GMF_LATENCY_TRACE_EN` is disabled
+ *
+ * @param[in]  handle   GMF element handle
+ * @param[in]  load     Acquired payload
+ * @param[in]  ingress  True when the payload is read from outside the element chain, it is stamped with the time
+ *                      unless the data bus it is read from carried the stamp of the upstream pipeline
+ */
+void esp_gmf_element_trace_in(esp_gmf_element_handle_t handle, esp_gmf_payload_t *load, bool ingress);
+
+/**
+ * @brief  Trace the output of the element, it is called by the GMF ports when the output is released
+ *
+ * @note  Do nothing when `CONFIG_ESP_GMF_LATENCY_TRACE_EN` is disabled
+ *
+ * @param[in]  handle  GMF element handle
+ * @param[in]  load    Released payload
+ * @param[in]  egress  True when the payload leaves the element chain, the end-to-end latency is counted
+ */
+void esp_gmf_element_trace_out(esp_gmf_element_handle_t handle, esp_gmf_payload_t *load, bool egress);
+
 #ifdef __cplusplus
 }
 #endif  /* __cplusplus */
@@ -17,9 +17,10 @@ extern "C" {
  * @brief  Type of events in GMF
  */
 typedef enum {
-    ESP_GMF_EVT_TYPE_LOADING_JOB  = 0x1000,  /*!< Loading job event */
-    ESP_GMF_EVT_TYPE_CHANGE_STATE = 0x2000,  /*!< State change event */
-    ESP_GMF_EVT_TYPE_REPORT_INFO  = 0x3000,  /*!< Information reporting event */
+    ESP_GMF_EVT_TYPE_LOADING_JOB   = 0x1000,  /*!< Loading job event */
+    ESP_GMF_EVT_TYPE_CHANGE_STATE  = 0x2000,  /*!< State change event */
+    ESP_GMF_EVT_TYPE_REPORT_INFO   = 0x3000,  /*!< Information reporting event */
+    ESP_GMF_EVT_TYPE_DEADLINE_MISS = 0x4000,  /*!< Job deadline miss event, the payload is `esp_gmf_job_deadline_miss_t` */
 } esp_gmf_event_type_t;
 
 /**
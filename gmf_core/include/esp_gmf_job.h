@@ -42,6 +42,8 @@ typedef enum {
  * @brief  This enumeration specifies the error status of a GMF job
  */
 typedef enum {
+    ESP_GMF_JOB_ERR_WAIT     = 4,        /*!< The job is not ready, the task goes on with the next job chain and runs the job again later,
+                                              it sleeps until notified by `esp_gmf_task_notify_ready` when no chain is ready */
     ESP_GMF_JOB_ERR_TRUNCATE = 3,        /*!< The job has been truncated */
     ESP_GMF_JOB_ERR_DONE     = 2,        /*!< The job has been completed */
     ESP_GMF_JOB_ERR_CONTINUE = 1,        /*!< The job should continue */
@@ -65,14 +67,19 @@ typedef esp_gmf_job_err_t (*esp_gmf_job_func)(void *self, void *para);
  *         A job encapsulates a function to be executed, along with its context and other properties
  */
 typedef struct _esp_gmf_job_t {
-    struct _esp_gmf_job_t *prev;   /*!< Pointer to the previous job in the linked list */
-    struct _esp_gmf_job_t *next;   /*!< Pointer to the next job in the linked list */
-    const char            *label;  /*!< Label identifying the job */
-    esp_gmf_job_func       func;   /*!< Function pointer to the job's function */
-    void                  *ctx;    /*!< Context pointer to be passed to the job's function */
-    void                  *para;   /*!< Parameter pointer to be passed to the job's function */
-    esp_gmf_job_times_t    times;  /*!< Times the job should be executed */
-    esp_gmf_job_err_t      ret;    /*!< Return value of the job function */
+    struct _esp_gmf_job_t *prev;        /*!< Pointer to the previous job in the linked list */
+    struct _esp_gmf_job_t *next;        /*!< Pointer to the next job in the linked list */
+    const char            *label;       /*!< Label identifying the job */
+    esp_gmf_job_func       func;        /*!< Function pointer to the job's function */
+    void                  *ctx;         /*!< Context pointer to be passed to the job's function */
+    void                  *para;        /*!< Parameter pointer to be passed to the job's function */
+    esp_gmf_job_times_t    times;       /*!< Times the job should be executed */
+    esp_gmf_job_err_t      ret;         /*!< Return value of the job function */
+    void                  *prof;        /*!< Profiling record of the job, used when `CONFIG_ESP_GMF_TASK_PROFILING_EN` is enabled */
+    void                  *deadline;    /*!< Deadline of the job set by `esp_gmf_task_set_job_deadline`, NULL when the job has none */
+    int64_t                release_us;  /*!< Release time of the current period of the job with deadline */
+    uint8_t                chain_head;  /*!< The job starts a chain which doesn't depend on the jobs in front of it, set by `esp_gmf_task_set_chain_head` */
+    uint8_t                chain_wait;  /*!< The chain is left at the job which waits for data, it goes on from the job */
 } esp_gmf_job_t;
 
 /**
@@ -99,8 +106,15 @@ typedef struct esp_gmf_job_node {
 
 typedef struct {
     esp_gmf_job_node_t *top;
+    esp_gmf_job_node_t *free;  /*!< Removed nodes kept for the next push, so the stack does not allocate once warmed up */
 } esp_gmf_job_stack_t;
 
+static inline void esp_gmf_job_stack_recycle(esp_gmf_job_stack_t *stack, esp_gmf_job_node_t *node)
+{
+    node->next = stack->free;
+    stack->free = node;
+}
+
 static inline esp_gmf_err_t esp_gmf_job_stack_create(esp_gmf_job_stack_t **stack)
 {
     *stack = (esp_gmf_job_stack_t *)esp_gmf_oal_calloc(1, sizeof(esp_gmf_job_stack_t));
@@ -111,8 +125,13 @@ static inline esp_gmf_err_t esp_gmf_job_stack_create(esp_gmf_job_stack_t **stack
 static inline esp_gmf_err_t esp_gmf_job_stack_push(esp_gmf_job_stack_t *stack, uint32_t node_addr)
 {
     ESP_GMF_NULL_CHECK("GMF_JOB_STACK", stack, return ESP_GMF_ERR_INVALID_ARG);
-    esp_gmf_job_node_t *node = (esp_gmf_job_node_t *)esp_gmf_oal_calloc(1, sizeof(esp_gmf_job_node_t));
-    ESP_GMF_MEM_CHECK("GMF_JOB_STACK", node, return ESP_GMF_ERR_MEMORY_LACK);
+    esp_gmf_job_node_t *node = stack->free;
+    if (node) {
+        stack->free = node->next;
+    } else {
+        node = (esp_gmf_job_node_t *)esp_gmf_oal_calloc(1, sizeof(esp_gmf_job_node_t));
+        ESP_GMF_MEM_CHECK("GMF_JOB_STACK", node, return ESP_GMF_ERR_MEMORY_LACK);
+    }
     node->node_addr = node_addr;
     node->next = stack->top;
     stack->top = node;
@@ -130,9 +149,8 @@ static inline esp_gmf_err_t esp_gmf_job_stack_pop(esp_gmf_job_stack_t *stack, ui
         return ESP_GMF_ERR_OK;
     }
     stack->top = node->next;
-    node->next = NULL;
     *node_addr = node->node_addr;
-    esp_gmf_oal_free(node);
+    esp_gmf_job_stack_recycle(stack, node);
     return ESP_GMF_ERR_OK;
 }
 
@@ -145,7 +163,7 @@ static inline void esp_gmf_job_stack_clear(esp_gmf_job_stack_t *stack)
     while (curr) {
         esp_gmf_job_node_t *temp = curr;
         curr = curr->next;
-        esp_gmf_oal_free(temp);
+        esp_gmf_job_stack_recycle(stack, temp);
     }
     stack->top = NULL;
 }
@@ -159,8 +177,7 @@ static inline esp_gmf_err_t esp_gmf_job_stack_remove(esp_gmf_job_stack_t *stack,
     if (stack->top->node_addr == node_addr) {
         esp_gmf_job_node_t *removed = stack->top;
         stack->top = removed->next;
-        removed->next = NULL;
-        esp_gmf_oal_free(removed);
+        esp_gmf_job_stack_recycle(stack, removed);
         return ESP_GMF_ERR_OK;
     }
     esp_gmf_job_node_t *prev = stack->top;
@@ -168,8 +185,7 @@ static inline esp_gmf_err_t esp_gmf_job_stack_remove(esp_gmf_job_stack_t *stack,
     while (curr) {
         if (curr->node_addr == node_addr) {
             prev->next = curr->next;
-            curr->next = NULL;
-            esp_gmf_oal_free(curr);
+            esp_gmf_job_stack_recycle(stack, curr);
             return ESP_GMF_ERR_OK;
         }
         prev = curr;
@@ -191,7 +207,8 @@ static inline esp_gmf_err_t esp_gmf_job_stack_is_empty(const esp_gmf_job_stack_t
 static inline void esp_gmf_job_stack_destroy(esp_gmf_job_stack_t *stack)
 {
     ESP_GMF_NULL_CHECK("GMF_JOB_STACK", stack, return);
-    esp_gmf_job_node_t *curr = stack->top;
+    esp_gmf_job_stack_clear(stack);
+    esp_gmf_job_node_t *curr = stack->free;
     while (curr) {
         esp_gmf_job_node_t *temp = curr;
         curr = curr->next;
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <stdint.h>
+#include <stdbool.h>
 #include "esp_gmf_err.h"
 
 #ifdef __cplusplus
@@ -31,6 +33,7 @@ typedef struct esp_gmf_obj_ {
     esp_gmf_err_t (*del_obj)(esp_gmf_obj_handle_t obj);                  /*!< Function pointer to delete an object */
     const char          *tag;                                            /*!< Pointer to a tag or identifier associated with the object */
     void                *cfg;                                            /*!< Pointer to the configuration data for the object */
+    uint32_t             tag_hash;                                       /*!< Hash of the tag kept by `esp_gmf_obj_set_tag`, 0 without tag */
 } esp_gmf_obj_t;
 
 #define OBJ_GET_TAG(x) ((x) ? ((((esp_gmf_obj_t *)x)->tag) ? ((esp_gmf_obj_t *)x)->tag : "NULL") : "NULL")
@@ -114,6 +117,33 @@ esp_gmf_err_t esp_gmf_obj_set_tag(esp_gmf_obj_handle_t obj, const char *tag);
  */
 esp_gmf_err_t esp_gmf_obj_get_tag(esp_gmf_obj_handle_t obj, char **tag);
 
+/**
+ * @brief  Calculate the case-insensitive hash of a tag
+ *
+ *         Tags equal regardless of case have the same hash, so a lookup by tag compares
+ *         the hash kept in the object before comparing the strings
+ *
+ * @param[in]  tag  Pointer to the tag string
+ *
+ * @return
+ *       - 0       The tag is NULL
+ *       - Others  The hash of the tag
+ */
+uint32_t esp_gmf_obj_tag_hash(const char *tag);
+
+/**
+ * @brief  Check whether the tag of a GMF object matches the given tag, ignoring case
+ *
+ * @param[in]  obj   Handle of the object
+ * @param[in]  tag   Pointer to the tag string
+ * @param[in]  hash  Hash of `tag` calculated by `esp_gmf_obj_tag_hash`
+ *
+ * @return
+ *       - true   The tags match
+ *       - false  The tags do not match
+ */
+bool esp_gmf_obj_tag_match(esp_gmf_obj_handle_t obj, const char *tag, uint32_t hash);
+
 #ifdef __cplusplus
 }
 #endif  /* __cplusplus */
@@ -18,6 +18,7 @@ extern "C" {
  * @brief  The meta flag for the current payload
  */
 #define ESP_GMF_META_FLAG_AUD_RECOVERY_PLC  (1 << 0) /*!< The current frame is recovered through the packet loss concealment (PLC) mechanism */
+#define ESP_GMF_META_FLAG_VID_KEY_FRAME     (1 << 1) /*!< The current frame is a key frame, which can be decoded without the previous frames */
 
 /**
  * @brief  Structure representing a payload in GMF
@@ -27,9 +28,11 @@ typedef struct {
     size_t   buf_length;        /*!< Length of the payload buffer */
     size_t   valid_size;        /*!< Size of valid data in the payload buffer */
     bool     is_done;           /*!< Flag indicating if this payload buffer marks the end of the stream */
+    uint8_t  meta_flag;         /*!< Meta flag for the payload, see `ESP_GMF_META_FLAG_*` */
     uint64_t pts;               /*!< Presentation time stamp */
+    int64_t  trace_us;          /*!< Time the data entered the pipeline in microseconds, set when `CONFIG_ESP_GMF_LATENCY_TRACE_EN` is enabled */
     uint8_t  needs_free : 1;    /*!< Flag indicating if the payload buffer needs to be freed by esp_gmf_payload_delete or not*/
-    uint8_t  meta_flag : 7;     /*!< Meta flag for the payload */
+    void    *pool;              /*!< Payload pool owning the buffer, NULL if the buffer is not pooled, see `esp_gmf_payload_pool.h` */
 } esp_gmf_payload_t;
 
 /**
@@ -123,6 +126,7 @@ esp_gmf_err_t esp_gmf_payload_clean_done(esp_gmf_payload_t *instance);
 
 /**
  * @brief  Delete a payload instance, if needs_free is set free associated resources
+ *         A pooled buffer is detached from the payload instead of freed
  *
  * @param[in]  instance  Payload instance to delete
  */
@@ -0,0 +1,154 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "esp_gmf_err.h"
+#include "esp_gmf_payload.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  The payload pool holds a fixed number of aligned buffers in one allocation, the buffers can have different sizes.
+ *         A buffer is attached to a payload with one reference, each extra holder adds a reference by `esp_gmf_payload_pool_ref`
+ *         and drops it by `esp_gmf_payload_pool_unref`, the buffer goes back to the pool when the last reference is dropped.
+ *         `esp_gmf_payload_delete` and `esp_gmf_payload_realloc_aligned_buf` detach the pooled buffer by themselves, so a pooled
+ *         payload is used like any other
+ */
+
+/**
+ * @brief  Handle to a GMF payload pool
+ */
+typedef struct esp_gmf_payload_pool *esp_gmf_payload_pool_handle_t;
+
+/**
+ * @brief  Create a payload pool, all the buffers are allocated at once
+ *
+ * @param[in]   buf_size  Size of each buffer in bytes
+ * @param[in]   buf_cnt   Number of buffers
+ * @param[in]   align     Byte alignment of each buffer, a power of 2
+ * @param[out]  handle    Pointer to store the pool handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_MEMORY_LACK  Memory allocation failed
+ */
+esp_gmf_err_t esp_gmf_payload_pool_create(uint32_t buf_size, uint16_t buf_cnt, uint8_t align, esp_gmf_payload_pool_handle_t *handle);
+
+/**
+ * @brief  Create a payload pool with one buffer of each given size, all the buffers are allocated at once
+ *
+ * @param[in]   buf_sizes  Array of the buffer sizes in bytes
+ * @param[in]   buf_cnt    Number of buffers, which is the number of items in `buf_sizes`
+ * @param[in]   align      Byte alignment of each buffer, a power of 2
+ * @param[out]  handle     Pointer to store the pool handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_MEMORY_LACK  Memory allocation failed
+ */
+esp_gmf_err_t esp_gmf_payload_pool_create_with_sizes(const uint32_t *buf_sizes, uint16_t buf_cnt, uint8_t align, esp_gmf_payload_pool_handle_t *handle);
+
+/**
+ * @brief  Destroy a payload pool
+ *
+ * @note  All the buffers should be detached before, the payloads still holding a buffer point to freed memory afterwards
+ *
+ * @param[in]  handle  Payload pool handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_payload_pool_destroy(esp_gmf_payload_pool_handle_t handle);
+
+/**
+ * @brief  Attach a free buffer of the pool to a payload without buffer, the buffer has one reference
+ *         The smallest free buffer which fits `wanted_size` is taken
+ *
+ * @param[in]  handle       Payload pool handle
+ * @param[in]  align        Byte alignment required for the buffer
+ * @param[in]  wanted_size  Size required for the buffer
+ * @param[in]  load         Payload to attach the buffer to
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK             On success
+ *       - ESP_GMF_ERR_INVALID_ARG    Invalid arguments
+ *       - ESP_GMF_ERR_INVALID_STATE  The payload already has a buffer
+ *       - ESP_GMF_ERR_NOT_ENOUGH     No free buffer, or the buffers are too small or not aligned enough
+ */
+esp_gmf_err_t esp_gmf_payload_pool_attach(esp_gmf_payload_pool_handle_t handle, uint8_t align, uint32_t wanted_size, esp_gmf_payload_t *load);
+
+/**
+ * @brief  Add a reference to the pooled buffer of a payload, for a holder which detaches it later
+ *
+ * @param[in]  load  Payload holding a pooled buffer
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments or the buffer is not pooled
+ */
+esp_gmf_err_t esp_gmf_payload_pool_ref(esp_gmf_payload_t *load);
+
+/**
+ * @brief  Drop a reference added by `esp_gmf_payload_pool_ref`, the payloads holding the buffer are left untouched
+ *         The buffer goes back to the pool once the last reference is dropped
+ *
+ * @param[in]  handle  Payload pool handle
+ * @param[in]  buf     The pooled buffer
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments or the buffer is not pooled
+ */
+esp_gmf_err_t esp_gmf_payload_pool_unref(esp_gmf_payload_pool_handle_t handle, uint8_t *buf);
+
+/**
+ * @brief  Drop a reference to the pooled buffer of a payload and clear the buffer of the payload
+ *         The buffer goes back to the pool once the last reference is dropped
+ *
+ * @param[in]  load  Payload holding a pooled buffer
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments or the buffer is not pooled
+ */
+esp_gmf_err_t esp_gmf_payload_pool_detach(esp_gmf_payload_t *load);
+
+/**
+ * @brief  Get the number of references to the pooled buffer of a payload
+ *         More than one reference means another holder still reads the buffer, so the payload must not write into it
+ *
+ * @param[in]   load  Payload holding a pooled buffer
+ * @param[out]  ref   Pointer to store the reference count
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments or the buffer is not pooled
+ */
+esp_gmf_err_t esp_gmf_payload_pool_get_ref(const esp_gmf_payload_t *load, uint8_t *ref);
+
+/**
+ * @brief  Get the largest buffer size and the number of free buffers of a payload pool
+ *
+ * @param[in]   handle    Payload pool handle
+ * @param[out]  buf_size  Pointer to store the size of the largest buffer, it can be NULL
+ * @param[out]  free_cnt  Pointer to store the number of free buffers, it can be NULL
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_payload_pool_get_info(esp_gmf_payload_pool_handle_t handle, uint32_t *buf_size, uint16_t *free_cnt);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
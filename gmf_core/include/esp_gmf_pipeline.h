@@ -11,6 +11,7 @@
 #include "esp_gmf_io.h"
 #include "esp_gmf_task.h"
 #include "esp_gmf_event.h"
+#include "esp_gmf_data_bus.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -21,6 +22,10 @@ extern "C" {
 #define ESP_GMF_PIPELINE_GET_FIRST_ELEMENT(p) (p->head_el)
 #define ESP_GMF_PIPELINE_GET_LAST_ELEMENT(p)  (p->last_el)
 
+#define DEFAULT_ESP_GMF_PIPELINE_SPLIT_DB_SIZE (1024)  /*!< Item size of the split data bus when the elements have no acquisition size */
+#define DEFAULT_ESP_GMF_PIPELINE_SPLIT_DB_CNT  (4)     /*!< Item count of the split data bus */
+#define DEFAULT_ESP_GMF_PIPELINE_BRANCH_DB_CNT (4)     /*!< Block count of the broadcast data bus feeding the branches */
+
 /**
  * @brief  Pointer to a GMF pipeline
  */
@@ -31,6 +36,38 @@ typedef struct esp_gmf_pipeline *esp_gmf_pipeline_handle_t;
  */
 typedef esp_gmf_err_t (*esp_gmf_pipeline_prev_act)(void *handle);  /*!<  */
 
+/**
+ * @brief  Segment of a split pipeline, see `esp_gmf_pipeline_split`
+ *
+ *         The elements from `head_el` up to the head element of the next segment run on the segment task.
+ *         The first segment is the head of the pipeline and runs on the task bound to the pipeline
+ */
+typedef struct esp_gmf_pipeline_seg {
+    struct esp_gmf_pipeline_seg  *next;     /*!< Next segment */
+    esp_gmf_element_handle_t      head_el;  /*!< The first element of the segment */
+    esp_gmf_task_handle_t         thread;   /*!< Task created for the segment, NULL for the first segment */
+    esp_gmf_db_handle_t           db;       /*!< Data bus from the previous segment to `head_el`, NULL for the first segment */
+    esp_gmf_event_state_t         state;    /*!< The last state reported by the segment task */
+} esp_gmf_pipeline_seg_t;
+
+/**
+ * @brief  Branch of a pipeline, see `esp_gmf_pipeline_add_branch` and `esp_gmf_pipeline_add_join`
+ *
+ *         The branch pipeline reads the output of `trunk_el` from a broadcast data bus, either the payloads of the primary out port
+ *         shared by the branches on the same element, or the own out port of the branch on an element with multiple out ports.
+ *         A joined branch feeds an extra in port of `trunk_el` through a data bus instead.
+ *         The elements of the branch run on the task which runs `trunk_el`
+ */
+typedef struct esp_gmf_pipeline_branch {
+    struct esp_gmf_pipeline_branch  *next;      /*!< Next branch */
+    esp_gmf_pipeline_handle_t        pipeline;  /*!< Branch pipeline, destroyed with the pipeline owning the branch */
+    esp_gmf_element_handle_t         trunk_el;  /*!< Element of the owning pipeline which feeds the branch, or which the joined branch feeds */
+    esp_gmf_port_handle_t            port;      /*!< Port registered on `trunk_el` for the branch, NULL when the branch shares the primary out port */
+    esp_gmf_db_handle_t              writer;    /*!< Data bus written by `trunk_el`, or by the last element of the joined branch */
+    esp_gmf_db_handle_t              reader;    /*!< Reader of `writer` feeding the head element of the branch, NULL for the joined branch */
+    uint8_t                          is_join;   /*!< The branch feeds `trunk_el` rather than being fed by it */
+} esp_gmf_pipeline_branch_t;
+
 /**
  * @brief  Structure representing a pipeline in GMF
  */
@@ -51,6 +88,16 @@ typedef struct esp_gmf_pipeline {
     void                      *prev_stop_ctx;  /*!< The previous stop context */
     uint8_t                    prev_state;     /*!< The previous action state */
     void                      *lock;           /*!< Lock for thread synchronization */
+    esp_gmf_task_handle_t      pool_thread;    /*!< Task created by the pipeline to run on a task pool, see `esp_gmf_pipeline_bind_pool` */
+    esp_gmf_pipeline_seg_t    *segs;           /*!< Segments of the pipeline, NULL if the pipeline is not split */
+    uint8_t                    seg_stopping;   /*!< The segments are being stopped by `esp_gmf_pipeline_stop` */
+    uint8_t                    warm_restart;   /*!< Keep the elements supporting reset opened across the restarts, see `esp_gmf_pipeline_set_warm_restart` */
+    uint8_t                    pld_pool_en;    /*!< Take the payload buffers of the ports from a pool, see `esp_gmf_pipeline_enable_payload_pool` */
+    void                      *pld_pool;       /*!< Payload pool created on the first run, NULL if the pool is disabled */
+    esp_gmf_pipeline_branch_t *branches;       /*!< Branches fed by or joined to the elements of the pipeline, see `esp_gmf_pipeline_add_branch` */
+    esp_gmf_pipeline_handle_t  trunk;          /*!< Pipeline running this one as a branch, NULL otherwise */
+    void                      *splice;         /*!< Element splice posted to the task and not done yet, see `esp_gmf_pipeline_insert_el` */
+    void                      *infos;          /*!< Copies of the information reported to the elements, given to the elements spliced in later */
 } esp_gmf_pipeline_t;
 
 /**
@@ -144,6 +191,233 @@ esp_gmf_err_t esp_gmf_pipeline_set_event(esp_gmf_pipeline_handle_t pipeline, esp
  */
 esp_gmf_err_t esp_gmf_pipeline_bind_task(esp_gmf_pipeline_handle_t pipeline, esp_gmf_task_handle_t task);
 
+/**
+ * @brief  Bind a task pool to the specific pipeline
+ *
+ *         A GMF task without dedicated thread is created and bound to the pipeline, its jobs are run by the
+ *         workers of the given pool. So many pipelines can share a few threads, and an idle pipeline costs
+ *         no thread and no stack. The created task is owned by the pipeline, it is deinitialized when the
+ *         pipeline is destroyed or another task is bound
+ *
+ * @param[in]  pipeline  GMF pipeline handle
+ * @param[in]  pool      GMF task pool handle
+ * @param[in]  name      Name of the created task, NULL for default name
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  If the pipeline or pool handle is invalid
+ *       - ESP_GMF_ERR_MEMORY_LACK  Insufficient memory to create the task
+ *       - Others                   Failed to create the task
+ */
+esp_gmf_err_t esp_gmf_pipeline_bind_pool(esp_gmf_pipeline_handle_t pipeline, esp_gmf_task_pool_handle_t pool, const char *name);
+
+/**
+ * @brief  Split the pipeline after the given element, so that the elements behind it run on another task
+ *
+ *         The link between the element and its next one is replaced by a data bus, a ring buffer if both elements
+ *         support the byte port, otherwise a block buffer. A new task is created with `task_cfg` (e.g. pin it to another
+ *         core by `thread.core`) to run the elements behind the split point, it is owned by the pipeline.
+ *         The pipeline can be split several times, each part runs on its own task
+ *
+ *         The pipeline still acts as a whole: run, stop, pause, resume, reset and seek apply to all the tasks,
+ *         the state is reported to the pipeline event callback once all the tasks have reached it, and the
+ *         element events are delivered in the same way as before the split
+ *
+ *         If `after_el_name` is NULL, the split point is chosen to balance the cost of the elements between the tasks
+ *
+ * @note  The ports on the split point are created with the readiness operations of the data bus, so the task waiting for
+ *        the data does not block the other task
+ *
+ * @param[in]  pipeline       GMF pipeline handle
+ * @param[in]  after_el_name  Name of the element after which the pipeline is split, NULL to choose automatically
+ * @param[in]  task_cfg       Configuration of the task created for the new segment, NULL for the default one
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK             On success
+ *       - ESP_GMF_ERR_INVALID_ARG    Invalid arguments, or the element is the last one of the pipeline
+ *       - ESP_GMF_ERR_NOT_FOUND      The element is not found
+ *       - ESP_GMF_ERR_INVALID_STATE  The pipeline is running, or it is already split at this element
+ *       - ESP_GMF_ERR_NOT_SUPPORT    The two elements have no port type in common
+ *       - ESP_GMF_ERR_MEMORY_LACK    Insufficient memory
+ *       - Others                     Failed to create the task
+ */
+esp_gmf_err_t esp_gmf_pipeline_split(esp_gmf_pipeline_handle_t pipeline, const char *after_el_name, esp_gmf_task_cfg_t *task_cfg);
+
+/**
+ * @brief  Set the drop policy of the data bus on a split point, see `esp_gmf_db_set_drop_policy`
+ *
+ *         By default, the task before the split point waits when the task behind it falls behind. For a live stream, a drop
+ *         policy keeps the latency bounded, e.g. `ESP_GMF_DB_DROP_TO_KEY_FRAME` between a video encoder and a network sender
+ *
+ * @note  Only the split point over a block buffer supports dropping. Set it before the pipeline runs
+ *
+ * @param[in]  pipeline       GMF pipeline handle
+ * @param[in]  after_el_name  Name of the element after which the pipeline is split
+ * @param[in]  policy         Drop policy
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_NOT_FOUND    The element is not found, or the pipeline is not split after it
+ *       - ESP_GMF_ERR_NOT_SUPPORT  The data bus on the split point can't drop data
+ *       - ESP_GMF_ERR_MEMORY_LACK  Insufficient memory
+ */
+esp_gmf_err_t esp_gmf_pipeline_set_split_drop_policy(esp_gmf_pipeline_handle_t pipeline, const char *after_el_name, esp_gmf_db_drop_policy_t policy);
+
+/**
+ * @brief  Get the number of the data dropped on a split point, see `esp_gmf_db_get_dropped`
+ *
+ * @param[in]   pipeline       GMF pipeline handle
+ * @param[in]   after_el_name  Name of the element after which the pipeline is split
+ * @param[out]  dropped_cnt    Pointer to store the number of drops
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_NOT_FOUND    The element is not found, or the pipeline is not split after it
+ */
+esp_gmf_err_t esp_gmf_pipeline_get_split_dropped(esp_gmf_pipeline_handle_t pipeline, const char *after_el_name, uint32_t *dropped_cnt);
+
+/**
+ * @brief  Add a branch fed by an element of the pipeline, so that the output of the element goes to several chains of elements
+ *         within one pipeline and one task, without extra tasks nor pipelines connected by ring buffers
+ *
+ *         On an element supporting multiple out ports (`ESP_GMF_EL_PORT_CAP_MULTI`), e.g. the copier or the deinterleave,
+ *         each branch gets a new out port of the element, so that the branches take the outputs of the element in the order
+ *         they are added, e.g. the channels of the deinterleave. On the other elements, the payloads released on the primary out
+ *         port are published to a broadcast data bus shared by all the branches on the element with reference counting. A payload
+ *         buffer taken from the payload pool is published by reference, and the trunk writes its next data into another pooled
+ *         buffer until the branches release it, other payloads are copied once to the bus. The head element of the branch gets an in port reading the bus. The elements of the branch run
+ *         on the task running the tee element, and the branch follows the pipeline: its jobs are loaded, run, stopped and reset
+ *         along, and its output IO is opened and closed along. The pipeline finishes when the branches have finished too.
+ *         The element events of the branch are reported to the event callback of the branch pipeline
+ *
+ * @note  1. The branch is a pipeline without input IO nor task, e.g. created by `esp_gmf_pool_new_pipeline` with a NULL input name.
+ *           It is owned by the pipeline once added, don't bind, run or destroy it by itself
+ *        2. By default, the tee element waits on the task for a branch falling behind it by `DEFAULT_ESP_GMF_PIPELINE_BRANCH_DB_CNT`
+ *           blocks, see `esp_gmf_pipeline_set_branch_drop_policy` to let the branch lose its oldest block instead
+ *
+ * @param[in]  pipeline     GMF pipeline handle
+ * @param[in]  tee_el_name  Name of the element feeding the branch
+ * @param[in]  branch       Branch pipeline handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK             On success
+ *       - ESP_GMF_ERR_INVALID_ARG    Invalid arguments
+ *       - ESP_GMF_ERR_NOT_FOUND      The element is not found
+ *       - ESP_GMF_ERR_INVALID_STATE  The pipeline is running, the pipeline is a branch, or the branch has input, task or branches
+ *       - ESP_GMF_ERR_NOT_SUPPORT    The element has neither an out port nor multiple out ports, or the head element of the branch doesn't support the block port
+ *       - ESP_GMF_ERR_MEMORY_LACK    Insufficient memory
+ */
+esp_gmf_err_t esp_gmf_pipeline_add_branch(esp_gmf_pipeline_handle_t pipeline, const char *tee_el_name, esp_gmf_pipeline_handle_t branch);
+
+/**
+ * @brief  Set the drop policy of a branch added by `esp_gmf_pipeline_add_branch`
+ *
+ *         With `ESP_GMF_DB_DROP_NONE`, the default, the tee element waits for the branch, so that the branch gets all the data.
+ *         With `ESP_GMF_DB_DROP_OLDEST`, the branch loses its oldest block rather than holding the tee element back,
+ *         e.g. a preview branch which must not slow down the recording trunk
+ *
+ * @param[in]  pipeline  GMF pipeline handle
+ * @param[in]  branch    Branch pipeline handle
+ * @param[in]  policy    Drop policy
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_NOT_FOUND    The branch is not added to the pipeline
+ *       - ESP_GMF_ERR_NOT_SUPPORT  The policy is not supported by the branches
+ */
+esp_gmf_err_t esp_gmf_pipeline_set_branch_drop_policy(esp_gmf_pipeline_handle_t pipeline, esp_gmf_pipeline_handle_t branch, esp_gmf_db_drop_policy_t policy);
+
+/**
+ * @brief  Join a branch to an element of the pipeline, so that the output of the branch goes to an extra in port of the element,
+ *         e.g. a second source of the mixer or the interleave, within one pipeline and one task
+ *
+ *         The last element of the branch gets an out port writing a ring buffer data bus, and the join element gets an in port
+ *         reading it after its existing in ports. Both ports report their readiness, so that the join element and the branch
+ *         wait for each other on the task instead of blocking it. The elements of the branch run on the task running the join
+ *         element, and the branch follows the pipeline: its jobs are loaded, run, stopped and reset along, and its input IO is
+ *         opened and closed along. The pipeline finishes when the branch has finished too
+ *
+ * @note  1. The branch is a pipeline with input IO and without output, task nor branches, e.g. created by `esp_gmf_pool_new_pipeline`
+ *           with a NULL output name. It is owned by the pipeline once added, don't bind, run or destroy it by itself
+ *        2. The join element reads its in ports in the registration order, like the mixer and the interleave. An element taking
+ *           its extra input by its own setter, e.g. the overlay port of the video overlay, isn't joined this way
+ *        3. The information reported by the branch elements isn't passed to the join element, which takes the one of the pipeline
+ *
+ * @param[in]  pipeline      GMF pipeline handle
+ * @param[in]  join_el_name  Name of the element taking the output of the branch
+ * @param[in]  branch        Branch pipeline handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK             On success
+ *       - ESP_GMF_ERR_INVALID_ARG    Invalid arguments
+ *       - ESP_GMF_ERR_NOT_FOUND      The element is not found
+ *       - ESP_GMF_ERR_INVALID_STATE  The pipeline is running, the pipeline is a branch, or the branch has output, task or branches
+ *       - ESP_GMF_ERR_NOT_SUPPORT    The element doesn't support multiple in ports, or the ports don't support the byte port
+ *       - ESP_GMF_ERR_MEMORY_LACK    Insufficient memory
+ */
+esp_gmf_err_t esp_gmf_pipeline_add_join(esp_gmf_pipeline_handle_t pipeline, const char *join_el_name, esp_gmf_pipeline_handle_t branch);
+
+/**
+ * @brief  Splice an element into the pipeline after the given element, e.g. to toggle an effect during the playback
+ *
+ *         The output of the previous element goes to the new element through a new linked port, and the new element takes
+ *         over the primary out port of the previous one, the branches fed by the previous element stay with it.
+ *         When the pipeline is running or paused, the splice is posted to the task running the previous element and done at
+ *         the boundary of the frames, see `esp_gmf_task_post_job`. The information reported to the previous element, e.g. the
+ *         sound information, is given to the new element, and only the new element runs its open job, the rest of the chain
+ *         goes on without reopen. Otherwise the element is spliced at once and opened along with the others by the next run
+ *
+ * @note  1. The element must have no port nor link, e.g. created by `esp_gmf_pool_new_element`, the pipeline owns it
+ *           once the call succeeds
+ *        2. The function returns once the splice is posted. An element which is not ready to run after given the information
+ *           is not spliced into a running pipeline, it's deleted with an error log
+ *        3. One splice is done at a time, don't call it along with `esp_gmf_pipeline_run`, `esp_gmf_pipeline_stop`
+ *           or `esp_gmf_pipeline_reset` from other threads
+ *        4. The element can't be inserted at a split point, the element behind it is run by the task of another segment
+ *        5. The new linked port is of the block type when both the previous element and the new one support it, otherwise
+ *           of the byte type. The element without a port type in common with the previous one, or whose out port type
+ *           doesn't fit the out port taken over, is rejected
+ *
+ * @param[in]  pipeline       GMF pipeline handle
+ * @param[in]  after_el_name  Name of the element to splice the new element after
+ * @param[in]  el             Element handle to splice in
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK             On success
+ *       - ESP_GMF_ERR_INVALID_ARG    Invalid arguments, or the element has ports or links
+ *       - ESP_GMF_ERR_NOT_FOUND      The element to splice after is not found
+ *       - ESP_GMF_ERR_INVALID_STATE  Another splice is pending
+ *       - ESP_GMF_ERR_NOT_SUPPORT    The ports of the element don't fit the place, or the place is a split point
+ *       - ESP_GMF_ERR_MEMORY_LACK    Insufficient memory
+ */
+esp_gmf_err_t esp_gmf_pipeline_insert_el(esp_gmf_pipeline_handle_t pipeline, const char *after_el_name, esp_gmf_element_handle_t el);
+
+/**
+ * @brief  Splice an element out of the pipeline and delete it, the reverse of `esp_gmf_pipeline_insert_el`
+ *
+ *         The previous element takes the out port of the removed element back. When the pipeline is running or paused,
+ *         the splice is done by the task running the element at the boundary of the frames, the element is closed and its
+ *         jobs are removed, the rest of the chain goes on without reopen. The input left in the element is dropped
+ *
+ * @note  The head element of the pipeline, the elements on either side of a split point and the elements feeding or joined
+ *        by branches can't be removed
+ *
+ * @param[in]  pipeline  GMF pipeline handle
+ * @param[in]  el_name   Name of the element to remove
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK             On success
+ *       - ESP_GMF_ERR_INVALID_ARG    Invalid arguments
+ *       - ESP_GMF_ERR_NOT_FOUND      The element is not found
+ *       - ESP_GMF_ERR_INVALID_STATE  Another splice is pending
+ *       - ESP_GMF_ERR_NOT_SUPPORT    The element can't be removed, or it has more than one in or out port
+ *       - ESP_GMF_ERR_MEMORY_LACK    Insufficient memory
+ */
+esp_gmf_err_t esp_gmf_pipeline_remove_el(esp_gmf_pipeline_handle_t pipeline, const char *el_name);
+
 /**
  * @brief  Load linked element jobs to the bind task on the specific pipeline
  *
@@ -197,6 +471,9 @@ esp_gmf_err_t esp_gmf_pipeline_reg_event_recipient(esp_gmf_pipeline_handle_t con
 /**
  * @brief  Connect two GMF pipelines
  *
+ *         The ports acquiring on a GMF data bus (`esp_gmf_db_acquire_read` and `esp_gmf_db_acquire_write`) get
+ *         the readiness operations of the data bus, so the tasks wait for the data bus instead of blocking in it
+ *
  * @param[in]  connector       GMF pipeline handle of the connector
  * @param[in]  connector_name  Name of the connector element
  * @param[in]  connector_port  Port handle of the connector element
@@ -271,8 +548,8 @@ esp_gmf_err_t esp_gmf_pipeline_prev_stop(esp_gmf_pipeline_handle_t pipeline);
  * @brief  Run the specific pipeline using `esp_gmf_task_run`, which blocks by default for `DEFAULT_TASK_OPT_MAX_TIME_MS`
  *         To change the waiting time, use `esp_gmf_task_set_timeout`
  *
- * @note  This API will automatically trigger the `prev_run` action if configured and not manually triggered yet
- *
+ * @note  This API will automatically trigger the `prev_run` action if configured and not manually triggered yet,
+ *        and plans the in-place processing of the elements, see `esp_gmf_pipeline_show_in_place_plan`
  *
  * @param[in]  pipeline  GMF pipeline handle
  *
@@ -342,6 +619,50 @@ esp_gmf_err_t esp_gmf_pipeline_resume(esp_gmf_pipeline_handle_t pipeline);
  */
 esp_gmf_err_t esp_gmf_pipeline_reset(esp_gmf_pipeline_handle_t pipeline);
 
+/**
+ * @brief  Enable or disable the warm restart of the GMF pipeline
+ *
+ *         When enabled, the elements which implement `ops.reset` are not closed on the stop or the finish of the pipeline,
+ *         `esp_gmf_pipeline_reset` keeps them opened and the next run resets them rather than opening them again, so their
+ *         handles and buffers are reused by the next stream. The other elements are closed and opened as usual,
+ *         and all the elements are closed when the pipeline stops on error
+ *
+ * @note  Once disabled, the kept elements are closed by the next `esp_gmf_pipeline_reset`, and they are always closed
+ *        by `esp_gmf_pipeline_destroy`
+ *
+ * @param[in]  pipeline  GMF pipeline handle
+ * @param[in]  enable    True to keep the elements opened across the restarts
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  If the pipeline handle is invalid
+ */
+esp_gmf_err_t esp_gmf_pipeline_set_warm_restart(esp_gmf_pipeline_handle_t pipeline, bool enable);
+
+/**
+ * @brief  Enable the payload pool of the GMF pipeline
+ *
+ *         On the first run, the pipeline creates a pool of reference-counted buffers and hands it to the ports of its elements.
+ *         There is one buffer for each payload the ports pass along the pipeline, it is sized by the largest data size declared
+ *         by the elements whose ports use that payload, and aligned to the strictest port alignment. The buffers are allocated
+ *         at once and kept until `esp_gmf_pipeline_destroy`, so the pipeline does not allocate them mid-stream.
+ *         A port handing a pooled payload to the next element adds a reference to the buffer, which is dropped when the next
+ *         element releases the payload
+ *
+ * @note  1. It must be called before the first `esp_gmf_pipeline_run`
+ *        2. A port whose wanted size exceeds the buffer size, e.g. an element enlarges its data size on open,
+ *           or a port of an element inserted later, allocates its buffer by itself as before
+ *
+ * @param[in]  pipeline  GMF pipeline handle
+ * @param[in]  enable    True to take the payload buffers from the pool
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK             On success
+ *       - ESP_GMF_ERR_INVALID_ARG    If the pipeline handle is invalid
+ *       - ESP_GMF_ERR_INVALID_STATE  The pool is already created
+ */
+esp_gmf_err_t esp_gmf_pipeline_enable_payload_pool(esp_gmf_pipeline_handle_t pipeline, bool enable);
+
 /**
  * @brief  Seeking to a specific position in the pipeline calls `io_seek`, which means it only
  *         supports streaming audio formats like MP3, AAC, and TS, where each frame can be decoded independently
@@ -455,6 +776,9 @@ esp_gmf_err_t esp_gmf_pipeline_get_next_el(esp_gmf_pipeline_handle_t pipeline, e
 /**
  * @brief  Get a element in specific pipeline by its name
  *
+ *         The name is matched ignoring case, by the hash of the element tag first, see `esp_gmf_obj_tag_hash`.
+ *         The returned handle can be cached while the element stays in the pipeline
+ *
  * @param[in]   pipeline    GMF pipeline handle
  * @param[in]   tag         Name of the wanted element
  * @param[out]  out_handle  Pointer to store the element handle
@@ -503,6 +827,22 @@ esp_gmf_err_t esp_gmf_pipeline_reg_el_port(esp_gmf_pipeline_handle_t pipeline, c
  */
 esp_gmf_err_t esp_gmf_pipeline_report_info(esp_gmf_pipeline_handle_t pipeline, esp_gmf_info_type_t info_type, void *value, int len);
 
+/**
+ * @brief  Print the in-place plan of a GMF pipeline, which is made on each `esp_gmf_pipeline_run`
+ *         For each element it shows whether the in-place processing is granted, denied or not declared,
+ *         and the headroom reserved by its ports for the data grown in place by the following elements
+ *
+ * @note  An element declaring in-place processing is denied when it has more than one in or out port, when the buffer
+ *        comes from or goes to a data bus, or when the buffer is less aligned than its output requires
+ *
+ * @param[in]  pipeline  GMF pipeline handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  If the pipeline handle is invalid
+ */
+esp_gmf_err_t esp_gmf_pipeline_show_in_place_plan(esp_gmf_pipeline_handle_t pipeline);
+
 /**
  * @brief  Print information about a GMF pipeline
  *
@@ -514,6 +854,107 @@ esp_gmf_err_t esp_gmf_pipeline_report_info(esp_gmf_pipeline_handle_t pipeline, e
  */
 esp_gmf_err_t esp_gmf_pipeline_show(esp_gmf_pipeline_handle_t handle);
 
+/**
+ * @brief  Get the profiling statistics of an element in the pipeline
+ *
+ *         The statistics of all the jobs of the element are summed up, the call count and the time distribution
+ *         are the ones of the most called job, i.e. the process job
+ *
+ * @param[in]   pipeline  GMF pipeline handle
+ * @param[in]   el        Element handle in the pipeline
+ * @param[out]  stats     Pointer to store the statistics, `label` is the element tag
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_NOT_FOUND    The element is not in the pipeline
+ *       - ESP_GMF_ERR_NOT_SUPPORT  `CONFIG_ESP_GMF_TASK_PROFILING_EN` is disabled
+ */
+esp_gmf_err_t esp_gmf_pipeline_get_job_stats(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t el, esp_gmf_job_stats_t *stats);
+
+/**
+ * @brief  Print the profiling statistics of every element in the pipeline, and the element which costs the most CPU time
+ *
+ * @param[in]  pipeline  GMF pipeline handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  If the pipeline handle is invalid
+ *       - ESP_GMF_ERR_NOT_SUPPORT  `CONFIG_ESP_GMF_TASK_PROFILING_EN` is disabled
+ */
+esp_gmf_err_t esp_gmf_pipeline_show_job_stats(esp_gmf_pipeline_handle_t pipeline);
+
+/**
+ * @brief  Set the period and deadline of the process job of an element in the pipeline
+ *
+ *         The task running the element runs the job ahead of the others once it is released every `period_us`,
+ *         see `esp_gmf_task_set_job_deadline`. The misses are reported to the pipeline event callback
+ *         as `ESP_GMF_EVT_TYPE_DEADLINE_MISS` with `esp_gmf_job_deadline_miss_t` as payload
+ *
+ * @note  It applies to the task bound to the element when it's called, so call it after `esp_gmf_pipeline_bind_task`
+ *        and `esp_gmf_pipeline_split`
+ *
+ * @param[in]  pipeline     GMF pipeline handle
+ * @param[in]  el           Element handle in the pipeline
+ * @param[in]  period_us    Period of the job in microseconds, typically the frame duration of the element, 0 to remove the deadline
+ * @param[in]  deadline_us  Deadline relative to the release of each period in microseconds, 0 means equal to the period
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK             On success
+ *       - ESP_GMF_ERR_INVALID_ARG    Invalid arguments
+ *       - ESP_GMF_ERR_NOT_FOUND      The element is not in the pipeline
+ *       - ESP_GMF_ERR_INVALID_STATE  No task is bound to the pipeline
+ *       - ESP_GMF_ERR_MEMORY_LACK    Insufficient memory to keep the deadline
+ */
+esp_gmf_err_t esp_gmf_pipeline_set_el_deadline(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t el,
+                                               uint32_t period_us, uint32_t deadline_us);
+
+/**
+ * @brief  Get the latency statistics of the payloads through the pipeline
+ *
+ *         The payloads are stamped when they are read into the pipeline, the element latency is the time from acquiring
+ *         the input to releasing each output of the element, the end-to-end latency is the time from the stamp to
+ *         the last element releasing the output
+ *
+ * @note  The split pipeline passes the data to the next segment by a data bus, the payloads are stamped again there,
+ *        so the end-to-end latency covers the last segment only
+ *
+ * @param[in]   pipeline  GMF pipeline handle
+ * @param[in]   el        Element handle in the pipeline, NULL to get the end-to-end latency
+ * @param[out]  stats     Pointer to store the statistics
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_NOT_FOUND    The element is not in the pipeline, or the pipeline has no element
+ *       - ESP_GMF_ERR_NOT_SUPPORT  `CONFIG_ESP_GMF_LATENCY_TRACE_EN` is disabled
+ */
+esp_gmf_err_t esp_gmf_pipeline_get_latency_stats(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t el, esp_gmf_latency_stats_t *stats);
+
+/**
+ * @brief  Print the latency statistics of every element in the pipeline and the end-to-end latency
+ *
+ * @param[in]  pipeline  GMF pipeline handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  If the pipeline handle is invalid
+ *       - ESP_GMF_ERR_NOT_SUPPORT  `CONFIG_ESP_GMF_LATENCY_TRACE_EN` is disabled
+ */
+esp_gmf_err_t esp_gmf_pipeline_show_latency_stats(esp_gmf_pipeline_handle_t pipeline);
+
+/**
+ * @brief  Clear the latency statistics of every element in the pipeline
+ *
+ * @param[in]  pipeline  GMF pipeline handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  If the pipeline handle is invalid
+ *       - ESP_GMF_ERR_NOT_SUPPORT  `CONFIG_ESP_GMF_LATENCY_TRACE_EN` is disabled
+ */
+esp_gmf_err_t esp_gmf_pipeline_reset_latency_stats(esp_gmf_pipeline_handle_t pipeline);
+
 #ifdef __cplusplus
 }
 #endif  /* __cplusplus */
@@ -115,6 +115,42 @@ esp_gmf_err_t esp_gmf_pool_new_pipeline(esp_gmf_pool_handle_t handle, const char
                                         const char *out_name,
                                         esp_gmf_pipeline_handle_t *pipeline);
 
+/**
+ * @brief  Find the I/O instance registered in the GMF pool by given name
+ *
+ *         The registered instances are indexed by the hash of their tags. The found handle stays valid until
+ *         the pool is deinitialized, so it can be cached and duplicated by `esp_gmf_obj_dupl` without looking up again
+ *
+ * @note  The tag of a registered instance is indexed at registration and must not be changed afterwards
+ *
+ * @param[in]   handle  GMF pool handle
+ * @param[in]   name    Name of the I/O handle
+ * @param[in]   dir     Direction of the I/O (reader or writer)
+ * @param[out]  io      Pointer to store the registered I/O handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_NOT_FOUND    Not found the specific I/O instance
+ */
+esp_gmf_err_t esp_gmf_pool_find_io(esp_gmf_pool_handle_t handle, const char *name, esp_gmf_io_dir_t dir, esp_gmf_io_handle_t *io);
+
+/**
+ * @brief  Find the element registered in the GMF pool by given name
+ *
+ *         The same as `esp_gmf_pool_find_io`, the found handle can be cached and duplicated by `esp_gmf_obj_dupl`
+ *
+ * @param[in]   handle   GMF pool handle
+ * @param[in]   el_name  Name of the element
+ * @param[out]  el       Pointer to store the registered element handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_NOT_FOUND    Not found the specific element instance
+ */
+esp_gmf_err_t esp_gmf_pool_find_element(esp_gmf_pool_handle_t handle, const char *el_name, esp_gmf_element_handle_t *el);
+
 /**
  * @brief  Create a new I/O instance from the GMF pool by given name
  *
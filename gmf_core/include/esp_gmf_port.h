@@ -11,6 +11,7 @@
 #include "sys/queue.h"
 #include "esp_gmf_err.h"
 #include "esp_gmf_payload.h"
+#include "esp_gmf_payload_pool.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -52,6 +53,8 @@ extern "C" {
 #define ESP_GMF_PORT_TYPE_BYTE  (0x01)  /*!< Bit0 for the byte type of GMF port */
 #define ESP_GMF_PORT_TYPE_BLOCK (0x02)  /*!< Bit1 for the block type of GMF port */
 
+#define ESP_GMF_PORT_BATCH_DEPTH_MAX  (16)  /*!< Maximum number of payloads read ahead in one batch, see `esp_gmf_port_set_batch_depth` */
+
 /**
  * @brief  Handle to a GMF port
  */
@@ -72,13 +75,42 @@ typedef esp_gmf_err_io_t (*port_release)(void *handle, esp_gmf_payload_t *load,
  */
 typedef void (*port_free)(void *p);
 
+/**
+ * @brief  Function pointer type for checking whether a port can be acquired without blocking
+ */
+typedef esp_gmf_err_t (*port_ready)(void *handle, uint8_t dir, uint32_t wanted_size, bool *ready);
+
+/**
+ * @brief  Function called when a port may have become ready
+ */
+typedef void (*esp_gmf_port_notify_cb)(void *ctx);
+
+/**
+ * @brief  Function pointer type for setting the readiness notification of a port
+ */
+typedef esp_gmf_err_t (*port_set_notify)(void *handle, uint8_t dir, esp_gmf_port_notify_cb cb, void *ctx);
+
+/**
+ * @brief  Function pointer type for acquiring several payloads from a port at once, it returns the number of acquired payloads
+ */
+typedef esp_gmf_err_io_t (*port_acquire_batch)(void *handle, esp_gmf_payload_t *loads[], int max_cnt, uint32_t wanted_size, int wait_ticks);
+
+/**
+ * @brief  Function pointer type for releasing the payloads acquired at once from a port
+ */
+typedef esp_gmf_err_io_t (*port_release_batch)(void *handle, esp_gmf_payload_t *loads[], int cnt, int wait_ticks);
+
 /**
  * @brief  Structure defining the I/O operations of a GMF port
  */
 typedef struct {
-    port_acquire  acquire;  /*!< Function pointer for acquiring data */
-    port_release  release;  /*!< Function pointer for releasing data */
-    port_free     del;      /*!< Function pointer for freeing the port */
+    port_acquire        acquire;        /*!< Function pointer for acquiring data */
+    port_release        release;        /*!< Function pointer for releasing data */
+    port_free           del;            /*!< Function pointer for freeing the port */
+    port_ready          ready;          /*!< Optional function pointer for checking the readiness, NULL means always ready */
+    port_set_notify     set_notify;     /*!< Optional function pointer for setting the readiness notification */
+    port_acquire_batch  acquire_batch;  /*!< Optional function pointer for acquiring several payloads at once */
+    port_release_batch  release_batch;  /*!< Optional function pointer for releasing the payloads acquired at once */
 } esp_gmf_port_io_ops_t;
 
 /**
@@ -123,6 +155,19 @@ typedef struct esp_gmf_port_ {
     esp_gmf_payload_t     *self_payload;   /*!< Self payload of the port */
     struct esp_gmf_port_  *ref_port;       /*!< Pointer to the reference port */
     int8_t                 ref_count;      /*!< Reference count indicating the number of active references */
+    void                  *payload_pool;   /*!< Pool to take the buffer of the self payload from, NULL to allocate it on demand */
+    void                  *held_pool;      /*!< Pool of `held_buf` */
+    uint8_t               *held_buf;       /*!< Pooled buffer referenced while the port holds the payload handed over by the previous element */
+    uint16_t               headroom_pct;   /*!< Extra buffer size in percent reserved for the following elements growing the data in place */
+    int16_t                batch_cnt;      /*!< Number of payloads held by the last batch acquire, 0 when no batch is held */
+    uint8_t                ahead_depth;    /*!< Number of payloads `esp_gmf_port_acquire_in` reads ahead in one batch, 0 for none */
+    uint8_t                ahead_cnt;      /*!< Number of payloads held by the last read ahead, 0 when none is held */
+    uint8_t                ahead_pos;      /*!< Index of the read ahead payload handed out by `esp_gmf_port_acquire_in` */
+    esp_gmf_payload_t     *ahead_loads;    /*!< Payloads read ahead, `ahead_depth` of them */
+    port_release           tee;            /*!< Function receiving each released out payload besides the normal release, NULL for none */
+    void                  *tee_ctx;        /*!< Context passed to `tee` */
+    port_ready             tee_ready;      /*!< Optional function checking whether `tee` takes the next payload without dropping it, NULL means always */
+    port_set_notify        tee_set_notify; /*!< Optional function setting the readiness notification of `tee_ctx` */
 } esp_gmf_port_t;
 
 /**
@@ -196,6 +241,34 @@ esp_gmf_err_t esp_gmf_port_clean_payload_done(esp_gmf_port_handle_t handle);
  */
 esp_gmf_err_t esp_gmf_port_enable_payload_share(esp_gmf_port_handle_t handle, bool enable);
 
+/**
+ * @brief  Set the pool which the port takes the buffer of its own payload from
+ *
+ * @note  The buffer is taken from the pool the first time the port needs one. If the pool has no free buffer,
+ *        or the wanted size exceeds the buffer size of the pool, the port falls back to allocating the buffer by itself
+ *
+ * @param[in]  handle  The port handle
+ * @param[in]  pool    The payload pool handle, NULL to allocate on demand
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument provided
+ */
+esp_gmf_err_t esp_gmf_port_set_payload_pool(esp_gmf_port_handle_t handle, esp_gmf_payload_pool_handle_t pool);
+
+/**
+ * @brief  Set the extra buffer size reserved by the port when it allocates a payload buffer,
+ *         so that the following elements can grow the data in place on it
+ *
+ * @param[in]  handle        The handle of the port
+ * @param[in]  headroom_pct  Extra size in percent of the acquired size
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument provided
+ */
+esp_gmf_err_t esp_gmf_port_set_headroom(esp_gmf_port_handle_t handle, uint16_t headroom_pct);
+
 /**
  * @brief  Reset the port payload and variable of self payload
  *
@@ -243,6 +316,124 @@ esp_gmf_err_t esp_gmf_port_set_reader(esp_gmf_port_handle_t handle, void *reader
  */
 esp_gmf_err_t esp_gmf_port_set_writer(esp_gmf_port_handle_t handle, void *writer);
 
+/**
+ * @brief  Set the readiness operations for the specific port
+ *
+ *         With the readiness operations, the element checks the port before processing, and returns
+ *         `ESP_GMF_JOB_ERR_WAIT` instead of blocking inside the acquire operation when the port is not ready.
+ *         The GMF data bus provides these operations, e.g. `esp_gmf_port_set_ready_ops(port, esp_gmf_db_is_ready, esp_gmf_db_set_notify)`
+ *
+ * @param[in]  handle      The handle of the port
+ * @param[in]  ready       Function to check the readiness of the port context
+ * @param[in]  set_notify  Function to set the readiness notification of the port context
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument
+ */
+esp_gmf_err_t esp_gmf_port_set_ready_ops(esp_gmf_port_handle_t handle, port_ready ready, port_set_notify set_notify);
+
+/**
+ * @brief  Set the batch operations for the specific port
+ *
+ *         With the batch operations, `esp_gmf_port_acquire_in_batch` takes several queued payloads in one call.
+ *         The GMF data bus provides these operations, e.g. `esp_gmf_port_set_batch_ops(port, esp_gmf_db_acquire_read_batch, esp_gmf_db_release_read_batch)`
+ *
+ * @param[in]  handle         The handle of the port
+ * @param[in]  acquire_batch  Function to acquire several payloads of the port context at once
+ * @param[in]  release_batch  Function to release the payloads acquired at once, NULL to release them one by one
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument
+ */
+esp_gmf_err_t esp_gmf_port_set_batch_ops(esp_gmf_port_handle_t handle, port_acquire_batch acquire_batch, port_release_batch release_batch);
+
+/**
+ * @brief  Set the number of payloads the input port reads ahead in one batch
+ *
+ *         With a depth above 1, `esp_gmf_port_acquire_in` acquires up to `depth` queued payloads by the batch operations
+ *         and hands them out one per call, then `esp_gmf_port_release_in` releases them at once after the last one.
+ *         So the element reading a FIFO data bus pays the acquire and the wake up of the writer once per batch,
+ *         while the writer gets the space back only after the whole batch is read
+ *
+ * @note  Only the block type input port reads ahead, and only when it is not linked to a previous element
+ *
+ * @param[in]  handle  The handle of the port
+ * @param[in]  depth   Maximum number of payloads read ahead, 0 or 1 to acquire one payload per call
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK             On success
+ *       - ESP_GMF_ERR_INVALID_ARG    Invalid argument, or the depth is above `ESP_GMF_PORT_BATCH_DEPTH_MAX`
+ *       - ESP_GMF_ERR_NOT_SUPPORT    Not a block type input port, or no batch operations are set
+ *       - ESP_GMF_ERR_INVALID_STATE  Read ahead payloads are held
+ *       - ESP_GMF_ERR_MEMORY_LACK    Failed to allocate the payloads
+ */
+esp_gmf_err_t esp_gmf_port_set_batch_depth(esp_gmf_port_handle_t handle, uint8_t depth);
+
+/**
+ * @brief  Set the tee of the specific out port
+ *
+ *         The tee is called with each payload released by `esp_gmf_port_release_out`, before the payload is handed over,
+ *         so that the data can be passed elsewhere, e.g. to the branches of a pipeline. The tee must not keep the payload,
+ *         it may keep a reference on a pooled buffer by `esp_gmf_payload_pool_ref`, then the port writes the next data
+ *         into another buffer while the reference is held
+ *
+ * @param[in]  handle   The handle of the port
+ * @param[in]  tee      Function receiving the released payloads, NULL to remove the tee
+ * @param[in]  tee_ctx  Context passed to the tee
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument
+ */
+esp_gmf_err_t esp_gmf_port_set_tee(esp_gmf_port_handle_t handle, port_release tee, void *tee_ctx);
+
+/**
+ * @brief  Set the readiness operations of the tee of the specific out port, they are called with the context of the tee
+ *
+ *         The tee is called without waiting, with these operations the element waits until the tee can take the payload,
+ *         also when the port is linked to the next element
+ *
+ * @param[in]  handle      The handle of the port
+ * @param[in]  ready       Function to check the readiness of the tee context, NULL to remove the check
+ * @param[in]  set_notify  Function to set the readiness notification of the tee context
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument
+ */
+esp_gmf_err_t esp_gmf_port_set_tee_ready_ops(esp_gmf_port_handle_t handle, port_ready ready, port_set_notify set_notify);
+
+/**
+ * @brief  Check whether the port can be acquired without blocking
+ *
+ *         The wanted size is the data length of the port. A port linked between two elements, or without the
+ *         readiness operation, is always ready
+ *
+ * @param[in]   handle  The handle of the port
+ * @param[out]  ready   Pointer to store the readiness
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument
+ */
+esp_gmf_err_t esp_gmf_port_is_ready(esp_gmf_port_handle_t handle, bool *ready);
+
+/**
+ * @brief  Set the callback which is called when the port may have become ready
+ *
+ * @param[in]  handle  The handle of the port
+ * @param[in]  cb      Notification callback, NULL to clear it
+ * @param[in]  ctx     Context passed to the callback
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid argument
+ *       - ESP_GMF_ERR_NOT_SUPPORT  The port has no readiness notification
+ */
+esp_gmf_err_t esp_gmf_port_set_notify(esp_gmf_port_handle_t handle, esp_gmf_port_notify_cb cb, void *ctx);
+
 /**
  * @brief  Add a GMF port to the end of the list
  *
@@ -301,6 +492,47 @@ esp_gmf_err_io_t esp_gmf_port_acquire_in(esp_gmf_port_handle_t handle, esp_gmf_p
  */
 esp_gmf_err_io_t esp_gmf_port_release_in(esp_gmf_port_handle_t handle, esp_gmf_payload_t *load, int wait_ticks);
 
+/**
+ * @brief  Acquire up to `max_cnt` payloads from the input port in one call, the caller provides the payloads
+ *         It lets an element consuming small frames, like an encoder or a mixer, pay the acquire overhead once per batch.
+ *         Only the first payload is waited for. A port linked between two elements, or without the batch operations,
+ *         acquires one payload by `esp_gmf_port_acquire_in`
+ *
+ * @note  The acquired payloads must be released by `esp_gmf_port_release_in_batch` with the returned count
+ * @note  Only the FIFO data bus reads several blocks at once, and the next linked element takes one payload per job,
+ *        so the batch suits an element whose output port is not linked to another element. The other elements read
+ *        ahead through `esp_gmf_port_acquire_in` instead, see `esp_gmf_port_set_batch_depth`
+ *
+ * @param[in]   handle       The handle of the port
+ * @param[out]  loads        Array of payload pointers, the payloads are filled in stream order
+ * @param[in]   max_cnt      Maximum number of payloads to acquire
+ * @param[in]   wanted_size  Size of the expected data, used when one payload is acquired
+ * @param[in]   wait_ticks   Number of ticks to wait for the first payload
+ *
+ * @return
+ *       - > 0                 The number of acquired payloads
+ *       - ESP_GMF_IO_FAIL     Operation failed or invalid arguments
+ *       - ESP_GMF_IO_ABORT    Operation aborted
+ *       - ESP_GMF_IO_TIMEOUT  Operation timed out
+ */
+esp_gmf_err_io_t esp_gmf_port_acquire_in_batch(esp_gmf_port_handle_t handle, esp_gmf_payload_t *loads[], int max_cnt, uint32_t wanted_size, int wait_ticks);
+
+/**
+ * @brief  Release the payloads acquired by `esp_gmf_port_acquire_in_batch`
+ *
+ * @param[in]  handle      The handle of the port
+ * @param[in]  loads       Array of the acquired payload pointers
+ * @param[in]  cnt         Number of acquired payloads
+ * @param[in]  wait_ticks  Number of ticks to wait
+ *
+ * @return
+ *       - ESP_GMF_IO_OK       Operation successful
+ *       - ESP_GMF_IO_FAIL     Operation failed or invalid arguments
+ *       - ESP_GMF_IO_ABORT    Operation aborted
+ *       - ESP_GMF_IO_TIMEOUT  Operation timed out
+ */
+esp_gmf_err_io_t esp_gmf_port_release_in_batch(esp_gmf_port_handle_t handle, esp_gmf_payload_t *loads[], int cnt, int wait_ticks);
+
 /**
  * @brief  Acquire the buffer of the expected size into the specified payload,
  *         If the reader of the port is valid, store the provided or allocated payload to the input port of the next element
@@ -12,6 +12,7 @@
 #include "esp_gmf_event.h"
 #include "esp_gmf_job.h"
 #include "esp_gmf_obj.h"
+#include "esp_gmf_task_pool.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,32 +44,52 @@ typedef struct esp_gmf_task_config {
  *         Represents a GMF task, including its properties, configuration, and internal state.
  */
 typedef struct _esp_gmf_task {
-    struct esp_gmf_obj_    base;           /*!< Base object for GMF tasks */
-    esp_gmf_job_t         *working;        /*!< Currently executing job in the task */
-    esp_gmf_job_stack_t   *start_stack;    /*!< Stack for the start job */
+    struct esp_gmf_obj_         base;           /*!< Base object for GMF tasks */
+    esp_gmf_job_t              *working;        /*!< Currently executing job in the task */
+    esp_gmf_job_stack_t        *start_stack;    /*!< Stack for the start job */
 
     /* Properties */
-    esp_gmf_event_cb       event_func;     /*!< Callback function for task events */
-    esp_gmf_event_state_t  state;          /*!< Current state of the task */
+    esp_gmf_event_cb            event_func;     /*!< Callback function for task events */
+    esp_gmf_event_state_t       state;          /*!< Current state of the task */
 
     /* Protect */
-    esp_gmf_task_config_t  thread;         /*!< Configuration settings for the task */
-    void                  *ctx;            /*!< Context associated with the task */
+    esp_gmf_task_config_t       thread;         /*!< Configuration settings for the task */
+    void                       *ctx;            /*!< Context associated with the task */
 
     /* Private */
-    void                  *oal_thread;     /*!< Handle to the thread */
-    void                  *lock;           /*!< Mutex lock for task synchronization */
-    void                  *event_group;    /*!< Event group for wait events */
-    void                  *block_sem;      /*!< Semaphore for blocking tasks */
-    void                  *wait_sem;       /*!< Semaphore for task waiting */
-    int                    api_sync_time;  /*!< Timeout for synchronization */
-
-    uint8_t                _task_run : 1;  /*!< Internal flag for task execution */
-    uint8_t                _running  : 1;  /*!< Internal flag for task running state */
-    uint8_t                _run      : 1;  /*!< Internal flag for task run API flag */
-    uint8_t                _pause    : 1;  /*!< Internal flag for task pause API flag */
-    uint8_t                _stop     : 1;  /*!< Internal flag for task stop API flag */
-    uint8_t                _destroy  : 1;  /*!< Internal flag for task destruction API flag */
+    void                       *oal_thread;     /*!< Handle to the thread */
+    void                       *lock;           /*!< Mutex lock for task synchronization */
+    void                       *event_group;    /*!< Event group for wait events */
+    void                       *block_sem;      /*!< Semaphore for blocking the task until it runs, or its waiting job is ready */
+    void                       *wait_sem;       /*!< Semaphore for task waiting */
+    int                         api_sync_time;  /*!< Timeout for synchronization */
+    esp_gmf_task_pool_handle_t  pool;           /*!< Task pool which runs the jobs, NULL when the task owns a thread */
+    esp_gmf_task_pool_item_t    pool_item;      /*!< Schedulable item submitted to the task pool */
+    esp_gmf_job_t              *cur_job;        /*!< Job to be run by the next loop iteration */
+    esp_gmf_event_state_t       quit_state;     /*!< State to report when the job loop quits */
+    void                       *prof;           /*!< Profiling records of the jobs, used when `CONFIG_ESP_GMF_TASK_PROFILING_EN` is enabled */
+    void                       *job_lock;       /*!< Mutex lock for the job slabs and labels */
+    esp_gmf_job_t              *free_jobs;      /*!< Released jobs, reused by the next registered jobs */
+    void                       *job_slabs;      /*!< Slabs holding the jobs of the task */
+    void                       *labels;         /*!< Interned labels of the jobs */
+    void                       *deadlines;      /*!< Deadlines of the jobs set by `esp_gmf_task_set_job_deadline` */
+    esp_gmf_job_t              *resume_job;     /*!< Job to go on with in list order after the job run ahead for its deadline */
+    void                       *wake_timer;     /*!< One-shot timer dispatching the pool task at the next release of the jobs with deadline */
+    esp_gmf_job_t              *wait_job;       /*!< First job waiting for data since a job made progress, the task sleeps when the loop comes back to it */
+    esp_gmf_job_t              *posted;         /*!< Jobs posted by `esp_gmf_task_post_job`, run at the end of the job list or before the task sleeps */
+    bool                        accept_post;    /*!< The job loop is running and takes the posted jobs, protected by `job_lock` */
+    uint32_t                    post_cnt;       /*!< Count of the posted jobs, protected by `job_lock` */
+    uint32_t                    post_seen;      /*!< Count of the posted jobs when the task run them last time before sleeping */
+    uint32_t                    slice_us;       /*!< Time slice of each job call in microseconds, 0 means no limit */
+
+    uint8_t                     _task_run : 1;  /*!< Internal flag for task execution */
+    uint8_t                     _running  : 1;  /*!< Internal flag for task running state */
+    uint8_t                     _run      : 1;  /*!< Internal flag for task run API flag */
+    uint8_t                     _pause    : 1;  /*!< Internal flag for task pause API flag */
+    uint8_t                     _stop     : 1;  /*!< Internal flag for task stop API flag */
+    uint8_t                     _destroy  : 1;  /*!< Internal flag for task destruction API flag */
+    uint8_t                     _in_loop  : 1;  /*!< Internal flag for the job loop is entered, used by pool mode */
+    uint8_t                     _parked   : 1;  /*!< Internal flag for the job loop is paused, used by pool mode */
 } esp_gmf_task_t;
 
 /**
@@ -78,12 +99,46 @@ typedef struct _esp_gmf_task {
  *         task name, user context, and callback function.
  */
 typedef struct {
-    esp_gmf_task_config_t  thread;  /*!< Configuration settings for the task thread */
-    const char            *name;    /*!< Name of the task */
-    void                  *ctx;     /*!< User context */
-    esp_gmf_event_cb       cb;      /*!< Callback function for task events */
+    esp_gmf_task_config_t       thread;  /*!< Configuration settings for the task thread */
+    const char                 *name;    /*!< Name of the task */
+    void                       *ctx;     /*!< User context */
+    esp_gmf_event_cb            cb;      /*!< Callback function for task events */
+    esp_gmf_task_pool_handle_t  pool;    /*!< Task pool to run the jobs on, if set, no dedicated thread is created
+                                              and `thread` is ignored */
 } esp_gmf_task_cfg_t;
 
+/**
+ * @brief  Profiling statistics of a GMF job
+ *
+ *         Collected by the task loop when `CONFIG_ESP_GMF_TASK_PROFILING_EN` is enabled. The jobs with the same function
+ *         and context (e.g. the process job of an element) share one record, which is accumulated across runs until
+ *         `esp_gmf_task_reset_job_stats` is called. The percentiles are estimated from power of two buckets
+ */
+typedef struct {
+    const char *label;       /*!< Label of the job, valid until the jobs of the context are unregistered */
+    void       *ctx;         /*!< Context of the job, it is the element for the element jobs */
+    uint32_t    call_cnt;    /*!< Number of calls */
+    uint64_t    total_us;    /*!< Total time of the calls in microseconds, including the blocked time */
+    uint64_t    blocked_us;  /*!< Time blocked in port acquire and release in microseconds */
+    uint32_t    min_us;      /*!< Time of the shortest call in microseconds */
+    uint32_t    max_us;      /*!< Time of the longest call in microseconds */
+    uint32_t    p50_us;      /*!< Median time of the calls in microseconds */
+    uint32_t    p90_us;      /*!< 90th percentile time of the calls in microseconds */
+    uint32_t    p99_us;      /*!< 99th percentile time of the calls in microseconds */
+    uint64_t    bytes_in;    /*!< Bytes acquired from the input ports */
+    uint64_t    bytes_out;   /*!< Bytes released to the output ports */
+} esp_gmf_job_stats_t;
+
+/**
+ * @brief  Payload of the `ESP_GMF_EVT_TYPE_DEADLINE_MISS` event, reported when a job with deadline completes late
+ */
+typedef struct {
+    const char *label;     /*!< Label of the job */
+    void       *ctx;       /*!< Context of the job, it is the element for the element jobs */
+    uint32_t    late_us;   /*!< Time the job completed after its deadline in microseconds */
+    uint32_t    miss_cnt;  /*!< Number of the missed deadlines of the jobs with this context */
+} esp_gmf_job_deadline_miss_t;
+
 #define DEFAULT_ESP_GMF_STACK_SIZE (4 * 1024)
 #define DEFAULT_ESP_GMF_TASK_PRIO  (5)
 #define DEFAULT_ESP_GMF_TASK_CORE  (0)
@@ -140,6 +195,115 @@ esp_gmf_err_t esp_gmf_task_deinit(esp_gmf_task_handle_t handle);
  */
 esp_gmf_err_t esp_gmf_task_register_ready_job(esp_gmf_task_handle_t handle, const char *label, esp_gmf_job_func job, esp_gmf_job_times_t times, void *ctx, bool done);
 
+/**
+ * @brief  Register a ready job in front of the jobs with the specific context
+ *
+ *         The jobs of a task run in list order, so a job which consumes the data of another one must be behind it.
+ *         It's used to put the jobs of an element spliced into a running pipeline in front of the jobs of its next element.
+ *         The job is added to the end of the list when no job has the context
+ *
+ * @note  The job list is not protected, call it from the jobs of the task or when the task is not running
+ *
+ * @param[in]  handle    GMF task handle
+ * @param[in]  next_ctx  Context of the jobs to put the new job in front of
+ * @param[in]  label     Label for the job
+ * @param[in]  job       Job function to register
+ * @param[in]  times     Job execution times configuration
+ * @param[in]  ctx       Context to be passed to the job function
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Indicating the handle is invalid
+ *       - ESP_GMF_ERR_MEMORY_LACK  Insufficient memory to perform the registration
+ */
+esp_gmf_err_t esp_gmf_task_insert_ready_job(esp_gmf_task_handle_t handle, void *next_ctx, const char *label, esp_gmf_job_func job,
+                                            esp_gmf_job_times_t times, void *ctx);
+
+/**
+ * @brief  Mark the registered jobs with the specific context as the head of a job chain
+ *
+ *         The jobs behind a chain head consume the data of the ones in front of them until the next chain head, e.g. the elements
+ *         of a pipeline segment, which reads its input from a data bus. When a job returns `ESP_GMF_JOB_ERR_WAIT` the task leaves
+ *         the rest of its chain and goes on with the next chain, the left chain goes on from the waiting job on the next loop.
+ *         The first job of the list always starts a chain
+ *
+ * @note  The job list is not protected, call it from the jobs of the task or when the task is not running
+ *
+ * @param[in]  handle  GMF task handle
+ * @param[in]  ctx     Context of the jobs to mark
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Indicating the handle is invalid
+ *       - ESP_GMF_ERR_NOT_FOUND    No job with the context is registered
+ */
+esp_gmf_err_t esp_gmf_task_set_chain_head(esp_gmf_task_handle_t handle, void *ctx);
+
+/**
+ * @brief  Remove all the registered jobs with the specific context, e.g. the jobs of an element spliced out of a running pipeline
+ *
+ *         When the job to run next is removed, the task goes on with the one following it.
+ *         The deadline and the profiling records of the context are freed too, call it before the context is deleted while the task lives on
+ *
+ * @note  The job list is not protected, call it from the jobs of the task or when the task is not running
+ *
+ * @param[in]  handle  GMF task handle
+ * @param[in]  ctx     Context of the jobs to remove
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Indicating the handle is invalid
+ */
+esp_gmf_err_t esp_gmf_task_unregister_jobs(esp_gmf_task_handle_t handle, void *ctx);
+
+/**
+ * @brief  Post a job to the running task, it's run once when the task reaches the end of its job list,
+ *         or before the task sleeps as all its jobs wait for data
+ *
+ *         Both are the boundary of the frames, all the elements of the task have handed their output over and only
+ *         the elements which returned `ESP_GMF_JOB_ERR_TRUNCATE` keep some input. So the posted job can change the job list
+ *         and the links of the elements safely, it can post itself again to wait for the next boundary.
+ *         It's safe to post from any thread. A paused task runs the job after resumed, and a task
+ *         quitting the job loop runs it after the quit jobs with the task state set to the quit state
+ *
+ * @param[in]  handle  GMF task handle
+ * @param[in]  label   Label for the job
+ * @param[in]  job     Job function to post, it's called with `ctx` and NULL
+ * @param[in]  ctx     Context to be passed to the job function
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK             On success
+ *       - ESP_GMF_ERR_INVALID_ARG    Indicating the handle is invalid
+ *       - ESP_GMF_ERR_INVALID_STATE  The task is not in the job loop, run the job directly instead
+ *       - ESP_GMF_ERR_MEMORY_LACK    Insufficient memory to keep the job
+ */
+esp_gmf_err_t esp_gmf_task_post_job(esp_gmf_task_handle_t handle, const char *label, esp_gmf_job_func job, void *ctx);
+
+/**
+ * @brief  Set the period and deadline of the infinite jobs with the specific context, e.g. the process job of an element
+ *
+ *         The setting is kept by the task and applies to the registered jobs and those registered later, so it survives
+ *         the stop and run cycles. A job with deadline is released every `period_us`, after each job the task runs the
+ *         released job with the earliest deadline before going on in list order. So a latency critical job (e.g. the sink
+ *         feeding I2S every 10 ms) waits for one job at most, rather than for all the jobs of the task.
+ *         When the job completes later than `deadline_us` after its release, `ESP_GMF_EVT_TYPE_DEADLINE_MISS` is reported
+ *         to the event callback of the task with `esp_gmf_job_deadline_miss_t` as payload.
+ *         The setting is freed by `esp_gmf_task_unregister_jobs` with the context
+ *
+ * @note  The period is typically the duration of the frame processed by the job, e.g. 10 ms for 160 samples at 16 kHz
+ *
+ * @param[in]  handle       GMF task handle
+ * @param[in]  ctx          Context of the jobs
+ * @param[in]  period_us    Period of the jobs in microseconds, 0 to remove the deadline
+ * @param[in]  deadline_us  Deadline relative to the release of each period in microseconds, 0 means equal to the period
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Indicating the handle is invalid
+ *       - ESP_GMF_ERR_MEMORY_LACK  Insufficient memory to keep the deadline
+ */
+esp_gmf_err_t esp_gmf_task_set_job_deadline(esp_gmf_task_handle_t handle, void *ctx, uint32_t period_us, uint32_t deadline_us);
+
 /**
  * @brief  Set the event callback function for a GMF task
  *
@@ -212,6 +376,23 @@ esp_gmf_err_t esp_gmf_task_pause(esp_gmf_task_handle_t handle);
  */
 esp_gmf_err_t esp_gmf_task_resume(esp_gmf_task_handle_t handle);
 
+/**
+ * @brief  Notify a GMF task that its waiting job may have become ready
+ *
+ *         A job returning `ESP_GMF_JOB_ERR_WAIT` is not run again until the task is notified, so the task
+ *         sleeps instead of spinning. It is typically called by the readiness notification of the ports,
+ *         spurious notifications are harmless
+ *
+ * @note  It must not be called from an ISR
+ *
+ * @param[in]  handle  GMF task handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Indicating the handle is invalid
+ */
+esp_gmf_err_t esp_gmf_task_notify_ready(esp_gmf_task_handle_t handle);
+
 /**
  * @brief  Reset a GMF task to its initial state
  *
@@ -235,6 +416,38 @@ esp_gmf_err_t esp_gmf_task_reset(esp_gmf_task_handle_t handle);
  */
 esp_gmf_err_t esp_gmf_task_set_timeout(esp_gmf_task_handle_t handle, int wait_ms);
 
+/**
+ * @brief  Set the time slice of each job call of the specific task
+ *
+ *         A job processing a large frame (e.g. decoding 16k FLAC samples or scaling a full video frame) can query
+ *         `esp_gmf_task_get_slice_left_us` while it works, and return `ESP_GMF_JOB_ERR_TRUNCATE` with its progress saved
+ *         once the slice is used up. The task runs the other jobs and serves pause and stop before it calls the job again,
+ *         so their latency is bounded by the slice rather than by the frame. In pool mode, the worker is also given
+ *         to the other tasks once a dispatch uses up the slice
+ *
+ * @note  The slice is cooperative, a job which doesn't query it is never interrupted
+ *
+ * @param[in]  handle    GMF task handle
+ * @param[in]  slice_us  Time slice in microseconds, 0 means no limit which is the default
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Indicating the handle is invalid
+ */
+esp_gmf_err_t esp_gmf_task_set_time_slice(esp_gmf_task_handle_t handle, uint32_t slice_us);
+
+/**
+ * @brief  Get the time left in the slice of the job running on the calling thread
+ *
+ *         It's called by the jobs, typically the element process functions, to know when to yield
+ *
+ * @return
+ *       - 0           The slice is used up, or pause or stop is requested, the job should yield as soon as possible
+ *       - UINT32_MAX  No time slice is set, or no job is running on the calling thread
+ *       - Others      Time left in microseconds
+ */
+uint32_t esp_gmf_task_get_slice_left_us(void);
+
 /**
  * @brief  Get the state of the specific task
  *
@@ -247,6 +460,44 @@ esp_gmf_err_t esp_gmf_task_set_timeout(esp_gmf_task_handle_t handle, int wait_ms
  */
 esp_gmf_err_t esp_gmf_task_get_state(esp_gmf_task_handle_t handle, esp_gmf_event_state_t *state);
 
+/**
+ * @brief  Iterate the profiling statistics of the jobs registered to the specific task
+ *
+ * @param[in]   handle    GMF task handle
+ * @param[out]  iterator  To retrieve the first job set `*iterator = NULL`, after that do not modify `*iterator` any more
+ * @param[out]  stats     Pointer to store the statistics of the job
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_NOT_FOUND    Iterate finished, no more jobs found
+ *       - ESP_GMF_ERR_NOT_SUPPORT  `CONFIG_ESP_GMF_TASK_PROFILING_EN` is disabled
+ */
+esp_gmf_err_t esp_gmf_task_get_job_stats(esp_gmf_task_handle_t handle, const void **iterator, esp_gmf_job_stats_t *stats);
+
+/**
+ * @brief  Clear the profiling statistics of the jobs registered to the specific task
+ *
+ * @param[in]  handle  GMF task handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Indicating the handle is invalid
+ *       - ESP_GMF_ERR_NOT_SUPPORT  `CONFIG_ESP_GMF_TASK_PROFILING_EN` is disabled
+ */
+esp_gmf_err_t esp_gmf_task_reset_job_stats(esp_gmf_task_handle_t handle);
+
+/**
+ * @brief  Account the port IO of the job which is running on the calling thread, it is called by the GMF ports
+ *
+ * @note  Do nothing when `CONFIG_ESP_GMF_TASK_PROFILING_EN` is disabled or no job is running on the calling thread
+ *
+ * @param[in]  blocked_us  Time blocked in the port operation in microseconds
+ * @param[in]  bytes_in    Bytes acquired from an input port
+ * @param[in]  bytes_out   Bytes released to an output port
+ */
+void esp_gmf_task_prof_add_io(uint32_t blocked_us, uint32_t bytes_in, uint32_t bytes_out);
+
 #ifdef __cplusplus
 }
 #endif  /* __cplusplus */
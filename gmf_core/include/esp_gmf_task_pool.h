@@ -0,0 +1,180 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "stdbool.h"
+#include "esp_gmf_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  The GMF task pool is a shared executor made of a few worker threads (by default one per core)
+ *         which run the job loops of many GMF tasks. A GMF task created with `esp_gmf_task_cfg_t.pool` set
+ *         does not own a thread or a stack, it is submitted to the pool when it becomes ready and is
+ *         dispatched to whichever worker is free. Each worker keeps its own ready queue, an idle worker
+ *         steals ready items from the other workers, so that busy pipelines are spread over all cores.
+ *
+ *         A dispatched task runs at most `job_slice` jobs before it is put back into the ready queue,
+ *         which keeps the pipelines that share the pool fair to each other.
+ *
+ * @note  The worker thread is blocked while a job is blocked (e.g. a port waiting on a data bus). When two
+ *        pipelines sharing the pool exchange data through a data bus, set the readiness ops on the ports
+ *        (see `esp_gmf_port_set_ready_ops`) so that a job waiting for data returns `ESP_GMF_JOB_ERR_WAIT`
+ *        and frees the worker, or make sure the pool has enough workers
+ */
+
+#define DEFAULT_ESP_GMF_TASK_POOL_STACK_SIZE (4 * 1024)
+#define DEFAULT_ESP_GMF_TASK_POOL_PRIO       (5)
+#define DEFAULT_ESP_GMF_TASK_POOL_JOB_SLICE  (16)
+
+/**
+ * @brief  GMF task pool handle
+ */
+typedef void *esp_gmf_task_pool_handle_t;
+
+/**
+ * @brief  Return values of the function executed by a pool worker
+ */
+typedef enum {
+    ESP_GMF_TASK_POOL_EXEC_IDLE  = 0,  /*!< The item has nothing to do, it is not scheduled again until it is submitted */
+    ESP_GMF_TASK_POOL_EXEC_YIELD = 1,  /*!< The item is still ready, put it back into the ready queue */
+} esp_gmf_task_pool_exec_ret_t;
+
+/**
+ * @brief  Function executed by a pool worker for the dispatched item
+ */
+typedef esp_gmf_task_pool_exec_ret_t (*esp_gmf_task_pool_exec_func)(void *ctx, uint16_t job_slice);
+
+/**
+ * @brief  Schedulable item of the GMF task pool
+ *
+ * @note  The item is embedded in its owner (e.g. `esp_gmf_task_t`), so submitting it never allocates memory.
+ *        All the members are private to the pool except `exec` and `ctx` which are set by the owner
+ */
+typedef struct esp_gmf_task_pool_item {
+    struct esp_gmf_task_pool_item  *next;      /*!< Next item in the ready queue */
+    esp_gmf_task_pool_exec_func     exec;      /*!< Function to execute on a worker */
+    void                           *ctx;       /*!< Context passed to `exec` */
+    int8_t                          affinity;  /*!< Worker index preferred by the item, -1 for no affinity */
+    uint8_t                         state;     /*!< Scheduling state of the item, private to the pool */
+    uint8_t                         pending;   /*!< The item was submitted again while it was executing */
+} esp_gmf_task_pool_item_t;
+
+/**
+ * @brief  Configuration of the GMF task pool
+ */
+typedef struct {
+    uint8_t      worker_num;    /*!< Number of worker threads up to 24, 0 means one worker per core */
+    uint16_t     job_slice;     /*!< Maximum jobs a task runs on a worker before yielding, 0 means the default */
+    int          stack;         /*!< Stack size of each worker thread */
+    int          prio;          /*!< Priority of the worker threads */
+    bool         stack_in_ext;  /*!< Whether the worker stacks are allocated in external memory */
+    bool         pin_to_core;   /*!< Pin worker N to core (N % core number) */
+    const char  *name;          /*!< Name prefix of the worker threads, NULL for the default one */
+} esp_gmf_task_pool_cfg_t;
+
+#define DEFAULT_ESP_GMF_TASK_POOL_CONFIG() {               \
+    .worker_num   = 0,                                     \
+    .job_slice    = DEFAULT_ESP_GMF_TASK_POOL_JOB_SLICE,   \
+    .stack        = DEFAULT_ESP_GMF_TASK_POOL_STACK_SIZE,  \
+    .prio         = DEFAULT_ESP_GMF_TASK_POOL_PRIO,        \
+    .stack_in_ext = false,                                 \
+    .pin_to_core  = true,                                  \
+    .name         = NULL,                                  \
+}
+
+/**
+ * @brief  Create a GMF task pool and start its worker threads
+ *
+ * @param[in]   config  Configuration of the task pool
+ * @param[out]  handle  Pointer to store the task pool handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_MEMORY_LACK  Insufficient memory
+ *       - ESP_GMF_ERR_FAIL         Failed to create the worker threads
+ */
+esp_gmf_err_t esp_gmf_task_pool_create(esp_gmf_task_pool_cfg_t *config, esp_gmf_task_pool_handle_t *handle);
+
+/**
+ * @brief  Destroy a GMF task pool, all the worker threads are stopped
+ *
+ * @note  All the GMF tasks bound to the pool must be deinitialized before calling this API
+ *
+ * @param[in]  handle  Task pool handle
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid handle
+ */
+esp_gmf_err_t esp_gmf_task_pool_destroy(esp_gmf_task_pool_handle_t handle);
+
+/**
+ * @brief  Submit an item to the ready queue of the pool
+ *
+ *         If the item is already queued, nothing happens. If the item is being executed, it is put back into
+ *         the ready queue once the execution returns, whatever `exec` returned
+ *
+ * @param[in]  handle  Task pool handle
+ * @param[in]  item    Item to be scheduled
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_task_pool_submit(esp_gmf_task_pool_handle_t handle, esp_gmf_task_pool_item_t *item);
+
+/**
+ * @brief  Post an item to the pool without blocking
+ *
+ *         The item is queued by the next worker that wakes up, with the same rules as `esp_gmf_task_pool_submit`.
+ *         It never waits for the pool lock, so it can be called from the timer service task
+ *
+ * @param[in]  handle  Task pool handle
+ * @param[in]  item    Item to be scheduled
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ *       - ESP_GMF_ERR_FAIL         The post queue is full, post it again later
+ */
+esp_gmf_err_t esp_gmf_task_pool_post(esp_gmf_task_pool_handle_t handle, esp_gmf_task_pool_item_t *item);
+
+/**
+ * @brief  Remove an item from the pool
+ *
+ *         The item is taken off the ready queue, and if it is being executed, this function waits for the
+ *         execution to return. After that the item is not referenced by the pool anymore
+ *
+ * @param[in]  handle  Task pool handle
+ * @param[in]  item    Item to be removed
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_task_pool_remove(esp_gmf_task_pool_handle_t handle, esp_gmf_task_pool_item_t *item);
+
+/**
+ * @brief  Get the number of worker threads of the pool
+ *
+ * @param[in]   handle      Task pool handle
+ * @param[out]  worker_num  Pointer to store the number of workers
+ *
+ * @return
+ *       - ESP_GMF_ERR_OK           On success
+ *       - ESP_GMF_ERR_INVALID_ARG  Invalid arguments
+ */
+esp_gmf_err_t esp_gmf_task_pool_get_worker_num(esp_gmf_task_pool_handle_t handle, uint8_t *worker_num);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
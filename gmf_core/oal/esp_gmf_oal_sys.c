@@ -50,6 +50,13 @@ int64_t esp_gmf_oal_sys_get_time_ms(void)
     return milliseconds;
 }
 
+int64_t esp_gmf_oal_sys_get_time_us(void)
+{
+    struct timeval t;
+    gettimeofday(&t, NULL);
+    return t.tv_sec * 1000000LL + t.tv_usec;
+}
+
 #if (CONFIG_FREERTOS_VTASKLIST_INCLUDE_COREID && CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS)
 static TaskStatus_t *matched_status;
 
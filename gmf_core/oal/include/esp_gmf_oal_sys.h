@@ -37,6 +37,14 @@ int esp_gmf_oal_sys_get_tick_by_time_ms(int ms);
  */
 int64_t esp_gmf_oal_sys_get_time_ms(void);
 
+/**
+ * @brief  Retrieve the current system time in microseconds
+ *
+ * @return
+ *       - The  system time in microseconds
+ */
+int64_t esp_gmf_oal_sys_get_time_us(void);
+
 /**
  * @brief  Print CPU usage statistics of tasks over a specified time period
  *
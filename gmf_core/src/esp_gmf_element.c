@@ -13,10 +13,67 @@
 #include "esp_gmf_oal_mutex.h"
 #include "esp_gmf_oal_thread.h"
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
 #include "esp_gmf_node.h"
 
+#define GMF_EL_TRACE_HIST_NUM (20)  // Bucket N counts the latency of [2^(N-1), 2^N) us, the last one counts all the longer latency
+
+/**
+ * @brief  Latency histogram of the payloads
+ */
+typedef struct {
+    uint32_t  cnt;                          /*!< Number of the traced payloads */
+    uint32_t  min_us;                       /*!< Shortest latency */
+    uint32_t  max_us;                       /*!< Longest latency */
+    uint64_t  total_us;                     /*!< Total latency */
+    uint32_t  hist[GMF_EL_TRACE_HIST_NUM];  /*!< Histogram of the latency */
+} esp_gmf_latency_hist_t;
+
+/**
+ * @brief  Latency records of the element
+ */
+typedef struct {
+    int64_t                 in_us;  /*!< Time the current input was acquired */
+    esp_gmf_latency_hist_t  el;     /*!< Latency from acquiring the input to releasing the output */
+    esp_gmf_latency_hist_t  e2e;    /*!< Latency from entering the element chain to leaving it by this element */
+} esp_gmf_element_trace_t;
+
 static const char *TAG = "ESP_GMF_ELEMENT";
 
+#ifdef CONFIG_ESP_GMF_LATENCY_TRACE_EN
+static inline void esp_gmf_latency_hist_reset(esp_gmf_latency_hist_t *hist)
+{
+    memset(hist, 0, sizeof(esp_gmf_latency_hist_t));
+    hist->min_us = UINT32_MAX;
+}
+
+static inline void esp_gmf_latency_hist_add(esp_gmf_latency_hist_t *hist, int64_t latency)
+{
+    uint32_t us = latency > 0 ? (latency > UINT32_MAX ? UINT32_MAX : (uint32_t)latency) : 0;
+    int idx = us ? (32 - __builtin_clz(us)) : 0;
+    hist->hist[idx < GMF_EL_TRACE_HIST_NUM ? idx : (GMF_EL_TRACE_HIST_NUM - 1)]++;
+    hist->cnt++;
+    hist->total_us += us;
+    hist->min_us = us < hist->min_us ? us : hist->min_us;
+    hist->max_us = us > hist->max_us ? us : hist->max_us;
+}
+
+static inline uint32_t esp_gmf_latency_hist_percentile(esp_gmf_latency_hist_t *hist, uint32_t percent)
+{
+    uint32_t target = (uint32_t)(((uint64_t)hist->cnt * percent + 99) / 100);
+    uint32_t cnt = 0;
+    for (int i = 0; i < GMF_EL_TRACE_HIST_NUM - 1; i++) {
+        cnt += hist->hist[i];
+        if (cnt >= target) {
+            uint32_t upper = (1UL << i) - 1;
+            upper = upper > hist->max_us ? hist->max_us : upper;
+            return upper < hist->min_us ? hist->min_us : upper;
+        }
+    }
+    return hist->max_us;
+}
+#endif  /* CONFIG_ESP_GMF_LATENCY_TRACE_EN */
+
 static inline int _get_port_cnt(esp_gmf_port_handle_t port)
 {
     int k = 0;
@@ -54,6 +111,18 @@ static inline esp_gmf_err_t esp_gmf_notify_state_changed(esp_gmf_element_handle_
     return el->event_func(&evt, el->ctx);
 }
 
+static inline void esp_gmf_element_release_in_ref(esp_gmf_element_t *el)
+{
+    // Release port still have reference
+    esp_gmf_port_t *in_port = ESP_GMF_ELEMENT_GET_IN_PORT(el);
+    if (in_port && in_port->ref_count) {
+        if (in_port->ops.release) {
+            in_port->ops.release(in_port->ctx, in_port->self_payload, 0);
+        }
+        in_port->ref_count = 0;
+    }
+}
+
 esp_gmf_err_t esp_gmf_element_init(esp_gmf_element_handle_t handle, esp_gmf_element_cfg_t *config)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
@@ -78,9 +147,21 @@ esp_gmf_err_t esp_gmf_element_init(esp_gmf_element_handle_t handle, esp_gmf_elem
     el->out_attr.port.buf_addr_aligned = config->out_attr.port.buf_addr_aligned == 0 ? ESP_GMF_ELEMENT_PORT_ADDR_ALIGNED_DEFAULT : config->out_attr.port.buf_addr_aligned;
     el->in_attr.port.buf_size_aligned = config->in_attr.port.buf_size_aligned == 0 ? 1 : config->in_attr.port.buf_size_aligned;
     el->out_attr.port.buf_size_aligned = config->out_attr.port.buf_size_aligned == 0 ? 1 : config->out_attr.port.buf_size_aligned;
+    el->in_place = config->in_place;
 
     el->ctx = config->ctx;
     el->job_mask = 0;
+#ifdef CONFIG_ESP_GMF_LATENCY_TRACE_EN
+    // Tracing is optional, the element without records is not traced
+    esp_gmf_element_trace_t *trace = esp_gmf_oal_calloc(1, sizeof(esp_gmf_element_trace_t));
+    if (trace) {
+        esp_gmf_latency_hist_reset(&trace->el);
+        esp_gmf_latency_hist_reset(&trace->e2e);
+    } else {
+        ESP_LOGW(TAG, "Failed to allocate latency records for %p", el);
+    }
+    el->trace = trace;
+#endif  /* CONFIG_ESP_GMF_LATENCY_TRACE_EN */
     return ESP_GMF_ERR_OK;
 }
 
@@ -104,6 +185,10 @@ esp_gmf_err_t esp_gmf_element_deinit(esp_gmf_element_handle_t handle)
         esp_gmf_port_deinit(port);
         port = tmp;
     }
+    if (el->trace) {
+        esp_gmf_oal_free(el->trace);
+        el->trace = NULL;
+    }
     return ESP_GMF_ERR_OK;
 }
 
@@ -263,7 +348,14 @@ esp_gmf_job_err_t esp_gmf_element_process_open(esp_gmf_element_handle_t handle,
         return ESP_GMF_JOB_ERR_FAIL;
     }
     esp_gmf_job_err_t ret = ESP_GMF_JOB_ERR_OK;
-    ret = el->ops.open(el, NULL);
+    el->truncated = 0;
+    if (el->opened && el->ops.reset) {
+        // Kept opened by the warm restart, reuse the resources of the last stream
+        ret = el->ops.reset(el, NULL);
+    } else {
+        ret = el->ops.open(el, NULL);
+    }
+    el->opened = (ret == ESP_GMF_JOB_ERR_OK);
     if (ret == ESP_GMF_JOB_ERR_OK) {
         esp_gmf_notify_state_changed(handle, ESP_GMF_EVENT_STATE_RUNNING);
     }
@@ -277,7 +369,23 @@ esp_gmf_job_err_t esp_gmf_element_process_running(esp_gmf_element_handle_t handl
         ESP_LOGE(TAG, "There is no process function [%p-%s]", handle, OBJ_GET_TAG(handle));
         return ESP_GMF_ERR_FAIL;
     }
-    return el->ops.process(el, NULL);
+    // Wait for the ports to be ready rather than block inside the acquire operations,
+    // the input port is not acquired when the remaining input data of a truncated process is handled.
+    // All the ports are checked, an element joining several inputs or feeding several outputs uses them in the same process
+    bool ready = true;
+    for (esp_gmf_port_handle_t port = el->in; port && ready && (el->truncated == 0); port = port->next) {
+        esp_gmf_port_is_ready(port, &ready);
+    }
+    for (esp_gmf_port_handle_t port = el->out; port && ready; port = port->next) {
+        esp_gmf_port_is_ready(port, &ready);
+    }
+    if (ready == false) {
+        ESP_LOGV(TAG, "Ports are not ready, wait [%p-%s]", handle, OBJ_GET_TAG(handle));
+        return ESP_GMF_JOB_ERR_WAIT;
+    }
+    esp_gmf_job_err_t ret = el->ops.process(el, NULL);
+    el->truncated = (ret == ESP_GMF_JOB_ERR_TRUNCATE);
+    return ret;
 }
 
 esp_gmf_job_err_t esp_gmf_element_process_close(esp_gmf_element_handle_t handle, void *para)
@@ -288,17 +396,22 @@ esp_gmf_job_err_t esp_gmf_element_process_close(esp_gmf_element_handle_t handle,
         return ESP_GMF_ERR_FAIL;
     }
     esp_gmf_job_err_t ret = el->ops.close(el, NULL);
-    // Release port still have reference
-    esp_gmf_port_t *in_port = ESP_GMF_ELEMENT_GET_IN_PORT(el);
-    if (in_port && in_port->ref_count) {
-        if (in_port->ops.release) {
-            in_port->ops.release(in_port->ctx, in_port->self_payload, 0);
-        }
-        in_port->ref_count = 0;
-    }
+    el->opened = 0;
+    esp_gmf_element_release_in_ref(el);
     return ret;
 }
 
+esp_gmf_job_err_t esp_gmf_element_process_keep(esp_gmf_element_handle_t handle, void *para)
+{
+    esp_gmf_element_t *el = (esp_gmf_element_t *)handle;
+    if ((el == NULL) || (el->ops.reset == NULL)) {
+        ESP_LOGE(TAG, "There is no reset function [%p-%s]", handle, OBJ_GET_TAG(handle));
+        return ESP_GMF_JOB_ERR_FAIL;
+    }
+    esp_gmf_element_release_in_ref(el);
+    return ESP_GMF_JOB_ERR_OK;
+}
+
 esp_gmf_err_t esp_gmf_element_set_state(esp_gmf_element_handle_t handle, esp_gmf_event_state_t new_state)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
@@ -477,3 +590,75 @@ esp_gmf_err_t esp_gmf_element_get_caps(esp_gmf_element_handle_t handle, const es
     *caps = el->caps;
     return ESP_GMF_ERR_OK;
 }
+
+esp_gmf_err_t esp_gmf_element_get_latency_stats(esp_gmf_element_handle_t handle, bool end_to_end, esp_gmf_latency_stats_t *stats)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, stats, return ESP_GMF_ERR_INVALID_ARG);
+#ifdef CONFIG_ESP_GMF_LATENCY_TRACE_EN
+    esp_gmf_element_trace_t *trace = (esp_gmf_element_trace_t *)((esp_gmf_element_t *)handle)->trace;
+    if (trace == NULL) {
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+    esp_gmf_latency_hist_t *hist = end_to_end ? &trace->e2e : &trace->el;
+    memset(stats, 0, sizeof(esp_gmf_latency_stats_t));
+    stats->cnt = hist->cnt;
+    if (hist->cnt) {
+        stats->min_us = hist->min_us;
+        stats->max_us = hist->max_us;
+        stats->avg_us = (uint32_t)(hist->total_us / hist->cnt);
+        stats->p50_us = esp_gmf_latency_hist_percentile(hist, 50);
+        stats->p90_us = esp_gmf_latency_hist_percentile(hist, 90);
+        stats->p99_us = esp_gmf_latency_hist_percentile(hist, 99);
+    }
+    return ESP_GMF_ERR_OK;
+#else
+    return ESP_GMF_ERR_NOT_SUPPORT;
+#endif  /* CONFIG_ESP_GMF_LATENCY_TRACE_EN */
+}
+
+esp_gmf_err_t esp_gmf_element_reset_latency_stats(esp_gmf_element_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+#ifdef CONFIG_ESP_GMF_LATENCY_TRACE_EN
+    esp_gmf_element_trace_t *trace = (esp_gmf_element_trace_t *)((esp_gmf_element_t *)handle)->trace;
+    if (trace == NULL) {
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+    esp_gmf_latency_hist_reset(&trace->el);
+    esp_gmf_latency_hist_reset(&trace->e2e);
+    return ESP_GMF_ERR_OK;
+#else
+    return ESP_GMF_ERR_NOT_SUPPORT;
+#endif  /* CONFIG_ESP_GMF_LATENCY_TRACE_EN */
+}
+
+void esp_gmf_element_trace_in(esp_gmf_element_handle_t handle, esp_gmf_payload_t *load, bool ingress)
+{
+#ifdef CONFIG_ESP_GMF_LATENCY_TRACE_EN
+    esp_gmf_element_trace_t *trace = handle ? (esp_gmf_element_trace_t *)((esp_gmf_element_t *)handle)->trace : NULL;
+    if (trace == NULL) {
+        return;
+    }
+    trace->in_us = esp_gmf_oal_sys_get_time_us();
+    // Keep the stamp carried from the upstream pipeline through the data bus
+    if (ingress && load && (load->trace_us == 0)) {
+        load->trace_us = trace->in_us;
+    }
+#endif  /* CONFIG_ESP_GMF_LATENCY_TRACE_EN */
+}
+
+void esp_gmf_element_trace_out(esp_gmf_element_handle_t handle, esp_gmf_payload_t *load, bool egress)
+{
+#ifdef CONFIG_ESP_GMF_LATENCY_TRACE_EN
+    esp_gmf_element_trace_t *trace = handle ? (esp_gmf_element_trace_t *)((esp_gmf_element_t *)handle)->trace : NULL;
+    if ((trace == NULL) || (trace->in_us == 0)) {
+        return;
+    }
+    int64_t now = esp_gmf_oal_sys_get_time_us();
+    esp_gmf_latency_hist_add(&trace->el, now - trace->in_us);
+    if (egress && load && load->trace_us) {
+        esp_gmf_latency_hist_add(&trace->e2e, now - load->trace_us);
+    }
+#endif  /* CONFIG_ESP_GMF_LATENCY_TRACE_EN */
+}
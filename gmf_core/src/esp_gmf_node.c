@@ -96,6 +96,12 @@ void esp_gmf_node_del_at(esp_gmf_node_t **root, esp_gmf_node_t *del)
     }
     if (*root == del) {
         *root = del->next;
+        // Don't leave the new root pointing to the removed node, which may be reused
+        if (del->next) {
+            del->next->prev = NULL;
+        }
+        del->next = NULL;
+        del->prev = NULL;
         return;
     }
     if (del->next) {
@@ -6,6 +6,7 @@
  */
 
 #include <stdlib.h>
+#include <ctype.h>
 #include <string.h>
 #include "esp_gmf_obj.h"
 #include "esp_gmf_err.h"
@@ -79,6 +80,7 @@ esp_gmf_err_t esp_gmf_obj_set_tag(esp_gmf_obj_handle_t obj, const char *tag)
     if (h->tag) {
         esp_gmf_oal_free((void *)h->tag);
         h->tag = NULL;
+        h->tag_hash = 0;
     }
     if (tag) {
         if (strlen(tag) >= ESP_GMF_TAG_MAX_LEN) {
@@ -87,6 +89,7 @@ esp_gmf_err_t esp_gmf_obj_set_tag(esp_gmf_obj_handle_t obj, const char *tag)
         }
         h->tag = esp_gmf_oal_strdup(tag);
         ESP_GMF_MEM_CHECK(TAG, h->tag, return ESP_GMF_ERR_MEMORY_LACK);
+        h->tag_hash = esp_gmf_obj_tag_hash(h->tag);
     }
     return ESP_GMF_ERR_OK;
 }
@@ -99,3 +102,26 @@ esp_gmf_err_t esp_gmf_obj_get_tag(esp_gmf_obj_handle_t obj, char **tag)
     *tag = (char *)h->tag;
     return ESP_GMF_ERR_OK;
 }
+
+uint32_t esp_gmf_obj_tag_hash(const char *tag)
+{
+    if (tag == NULL) {
+        return 0;
+    }
+    // FNV-1a over the lower case characters, never 0 so that it differs from an object without tag
+    uint32_t hash = 2166136261u;
+    while (*tag) {
+        hash ^= (uint8_t)tolower((uint8_t)*tag++);
+        hash *= 16777619u;
+    }
+    return hash ? hash : 1;
+}
+
+bool esp_gmf_obj_tag_match(esp_gmf_obj_handle_t obj, const char *tag, uint32_t hash)
+{
+    esp_gmf_obj_t *h = (esp_gmf_obj_t *)obj;
+    if ((h == NULL) || (h->tag == NULL) || (tag == NULL) || (h->tag_hash != hash)) {
+        return false;
+    }
+    return strcasecmp(h->tag, tag) == 0;
+}
@@ -8,6 +8,7 @@
 #include "stdlib.h"
 #include "esp_gmf_oal_mem.h"
 #include "esp_gmf_payload.h"
+#include "esp_gmf_payload_pool.h"
 #include "esp_log.h"
 #include "string.h"
 
@@ -75,7 +76,10 @@ esp_gmf_err_t esp_gmf_payload_realloc_aligned_buf(esp_gmf_payload_t *instance, u
     }
     uint8_t *buf = esp_gmf_oal_malloc_align(align, new_length);
     ESP_GMF_NULL_CHECK(TAG, buf, { return ESP_GMF_ERR_MEMORY_LACK;});
-    if (instance->buf) {
+    if (instance->pool) {
+        // The pooled buffer is too small, it goes back to the pool and the payload owns the new buffer from now on
+        esp_gmf_payload_pool_detach(instance);
+    } else if (instance->buf) {
         // There was no operation of memcpy valid size. Because this function is to expand the buffer size.
         ESP_LOGD(TAG, "Free payload:%p, buf:%p-%d, needs_free:%d", instance, instance->buf, instance->buf_length, instance->needs_free);
         esp_gmf_oal_free(instance->buf);
@@ -111,7 +115,9 @@ void esp_gmf_payload_delete(esp_gmf_payload_t *instance)
     ESP_LOGD(TAG, "Delete a payload, h:%p, needs_free:%d, buf:%p, l:%d", instance, instance != NULL ? instance->needs_free : -1,
              instance != NULL ? instance->buf : NULL, instance != NULL ? instance->buf_length : -1);
     if (instance) {
-        if (instance->needs_free) {
+        if (instance->pool) {
+            esp_gmf_payload_pool_detach(instance);
+        } else if (instance->needs_free) {
             esp_gmf_oal_free(instance->buf);
             instance->needs_free = 0;
         }
@@ -0,0 +1,223 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <string.h>
+#include "esp_log.h"
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_mutex.h"
+#include "esp_gmf_payload_pool.h"
+
+static const char *TAG = "ESP_GMF_PLD_POOL";
+
+typedef struct {
+    uint32_t  offset;  /*!< Offset of the buffer in the pool memory */
+    uint32_t  size;    /*!< Size of the buffer */
+    uint8_t   ref;     /*!< Reference count of the buffer, 0 means free */
+} esp_gmf_payload_pool_buf_t;
+
+typedef struct esp_gmf_payload_pool {
+    uint8_t                     *mem;       /*!< One allocation holding all the buffers */
+    esp_gmf_payload_pool_buf_t  *bufs;      /*!< Layout and reference count of each buffer */
+    uint32_t                     max_size;  /*!< Size of the largest buffer */
+    uint16_t                     buf_cnt;   /*!< Number of buffers */
+    uint16_t                     free_cnt;  /*!< Number of free buffers */
+    uint8_t                      align;     /*!< Byte alignment of each buffer */
+    void                        *lock;      /*!< Lock for the reference counts */
+} esp_gmf_payload_pool_t;
+
+static inline int esp_gmf_payload_pool_index(esp_gmf_payload_pool_t *pool, uint8_t *buf)
+{
+    for (int i = 0; buf && (i < pool->buf_cnt); i++) {
+        if (buf == pool->mem + pool->bufs[i].offset) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+esp_gmf_err_t esp_gmf_payload_pool_create(uint32_t buf_size, uint16_t buf_cnt, uint8_t align, esp_gmf_payload_pool_handle_t *handle)
+{
+    ESP_GMF_CHECK(TAG, buf_cnt, return ESP_GMF_ERR_INVALID_ARG, "Invalid buffer count");
+    uint32_t *sizes = esp_gmf_oal_malloc(buf_cnt * sizeof(uint32_t));
+    ESP_GMF_MEM_CHECK(TAG, sizes, return ESP_GMF_ERR_MEMORY_LACK);
+    for (int i = 0; i < buf_cnt; i++) {
+        sizes[i] = buf_size;
+    }
+    esp_gmf_err_t ret = esp_gmf_payload_pool_create_with_sizes(sizes, buf_cnt, align, handle);
+    esp_gmf_oal_free(sizes);
+    return ret;
+}
+
+esp_gmf_err_t esp_gmf_payload_pool_create_with_sizes(const uint32_t *buf_sizes, uint16_t buf_cnt, uint8_t align, esp_gmf_payload_pool_handle_t *handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, buf_sizes, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_CHECK(TAG, (buf_cnt && align && ((align & (align - 1)) == 0)), return ESP_GMF_ERR_INVALID_ARG,
+                  "Invalid buffer count or alignment");
+    for (int i = 0; i < buf_cnt; i++) {
+        ESP_GMF_CHECK(TAG, buf_sizes[i], return ESP_GMF_ERR_INVALID_ARG, "Invalid buffer size");
+    }
+    esp_gmf_payload_pool_t *pool = esp_gmf_oal_calloc(1, sizeof(esp_gmf_payload_pool_t));
+    ESP_GMF_MEM_CHECK(TAG, pool, return ESP_GMF_ERR_MEMORY_LACK);
+    pool->bufs = esp_gmf_oal_calloc(buf_cnt, sizeof(esp_gmf_payload_pool_buf_t));
+    uint32_t total = 0;
+    for (int i = 0; pool->bufs && (i < buf_cnt); i++) {
+        // Each buffer starts on the alignment, the size is rounded up for the next one
+        pool->bufs[i].offset = total;
+        pool->bufs[i].size = buf_sizes[i];
+        total += (buf_sizes[i] + align - 1) & ~((uint32_t)align - 1);
+        pool->max_size = buf_sizes[i] > pool->max_size ? buf_sizes[i] : pool->max_size;
+    }
+    pool->mem = pool->bufs ? esp_gmf_oal_malloc_align(align, total) : NULL;
+    pool->lock = esp_gmf_oal_mutex_create();
+    if ((pool->mem == NULL) || (pool->bufs == NULL) || (pool->lock == NULL)) {
+        ESP_LOGE(TAG, "Failed to allocate the pool, total:%ld, cnt:%d", total, buf_cnt);
+        esp_gmf_payload_pool_destroy(pool);
+        return ESP_GMF_ERR_MEMORY_LACK;
+    }
+    pool->buf_cnt = buf_cnt;
+    pool->free_cnt = buf_cnt;
+    pool->align = align;
+    *handle = pool;
+    ESP_LOGI(TAG, "Create payload pool:%p, total:%ld, max:%ld, cnt:%d, align:%d", pool, total, pool->max_size, buf_cnt, align);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_payload_pool_destroy(esp_gmf_payload_pool_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_payload_pool_t *pool = (esp_gmf_payload_pool_t *)handle;
+    if (pool->free_cnt != pool->buf_cnt) {
+        ESP_LOGW(TAG, "Destroy payload pool:%p with %d buffers in use", pool, pool->buf_cnt - pool->free_cnt);
+    }
+    if (pool->lock) {
+        esp_gmf_oal_mutex_destroy(pool->lock);
+    }
+    if (pool->mem) {
+        esp_gmf_oal_free(pool->mem);
+    }
+    if (pool->bufs) {
+        esp_gmf_oal_free(pool->bufs);
+    }
+    esp_gmf_oal_free(pool);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_payload_pool_attach(esp_gmf_payload_pool_handle_t handle, uint8_t align, uint32_t wanted_size, esp_gmf_payload_t *load)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, load, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_payload_pool_t *pool = (esp_gmf_payload_pool_t *)handle;
+    if (load->buf) {
+        ESP_LOGE(TAG, "The payload already has a buffer, h:%p, buf:%p", load, load->buf);
+        return ESP_GMF_ERR_INVALID_STATE;
+    }
+    if ((wanted_size > pool->max_size) || (align > pool->align)) {
+        ESP_LOGD(TAG, "No fit buffer in pool:%p, wanted:%ld-%d, size:%ld-%d", pool, wanted_size, align, pool->max_size, pool->align);
+        return ESP_GMF_ERR_NOT_ENOUGH;
+    }
+    esp_gmf_oal_mutex_lock(pool->lock);
+    // Take the smallest free buffer which fits, so the large ones are left for the ports which need them
+    int fit = -1;
+    for (int i = 0; i < pool->buf_cnt; i++) {
+        if ((pool->bufs[i].ref == 0) && (pool->bufs[i].size >= wanted_size)
+            && ((fit < 0) || (pool->bufs[i].size < pool->bufs[fit].size))) {
+            fit = i;
+        }
+    }
+    if (fit < 0) {
+        esp_gmf_oal_mutex_unlock(pool->lock);
+        ESP_LOGD(TAG, "No free buffer of %ld bytes in pool:%p", wanted_size, pool);
+        return ESP_GMF_ERR_NOT_ENOUGH;
+    }
+    pool->bufs[fit].ref = 1;
+    pool->free_cnt--;
+    esp_gmf_oal_mutex_unlock(pool->lock);
+    load->buf = pool->mem + pool->bufs[fit].offset;
+    load->buf_length = pool->bufs[fit].size;
+    load->needs_free = 1;
+    load->pool = pool;
+    ESP_LOGD(TAG, "Attach buffer %d of pool:%p to payload:%p, size:%ld, free:%d", fit, pool, load, pool->bufs[fit].size, pool->free_cnt);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_payload_pool_ref(esp_gmf_payload_t *load)
+{
+    ESP_GMF_NULL_CHECK(TAG, load, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_payload_pool_t *pool = (esp_gmf_payload_pool_t *)load->pool;
+    ESP_GMF_NULL_CHECK(TAG, pool, return ESP_GMF_ERR_INVALID_ARG);
+    int i = esp_gmf_payload_pool_index(pool, load->buf);
+    ESP_GMF_CHECK(TAG, (i >= 0), return ESP_GMF_ERR_INVALID_ARG, "The buffer does not belong to the pool");
+    esp_gmf_oal_mutex_lock(pool->lock);
+    pool->bufs[i].ref++;
+    esp_gmf_oal_mutex_unlock(pool->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+static inline void esp_gmf_payload_pool_put(esp_gmf_payload_pool_t *pool, int i)
+{
+    esp_gmf_oal_mutex_lock(pool->lock);
+    if (pool->bufs[i].ref && (--pool->bufs[i].ref == 0)) {
+        pool->free_cnt++;
+    }
+    esp_gmf_oal_mutex_unlock(pool->lock);
+}
+
+esp_gmf_err_t esp_gmf_payload_pool_unref(esp_gmf_payload_pool_handle_t handle, uint8_t *buf)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_payload_pool_t *pool = (esp_gmf_payload_pool_t *)handle;
+    int i = esp_gmf_payload_pool_index(pool, buf);
+    ESP_GMF_CHECK(TAG, (i >= 0), return ESP_GMF_ERR_INVALID_ARG, "The buffer does not belong to the pool");
+    esp_gmf_payload_pool_put(pool, i);
+    ESP_LOGD(TAG, "Unref buffer %d of pool:%p, free:%d", i, pool, pool->free_cnt);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_payload_pool_detach(esp_gmf_payload_t *load)
+{
+    ESP_GMF_NULL_CHECK(TAG, load, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_payload_pool_t *pool = (esp_gmf_payload_pool_t *)load->pool;
+    ESP_GMF_NULL_CHECK(TAG, pool, return ESP_GMF_ERR_INVALID_ARG);
+    int i = esp_gmf_payload_pool_index(pool, load->buf);
+    ESP_GMF_CHECK(TAG, (i >= 0), return ESP_GMF_ERR_INVALID_ARG, "The buffer does not belong to the pool");
+    esp_gmf_payload_pool_put(pool, i);
+    ESP_LOGD(TAG, "Detach buffer %d of pool:%p from payload:%p, free:%d", i, pool, load, pool->free_cnt);
+    load->buf = NULL;
+    load->buf_length = 0;
+    load->valid_size = 0;
+    load->needs_free = 0;
+    load->pool = NULL;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_payload_pool_get_ref(const esp_gmf_payload_t *load, uint8_t *ref)
+{
+    ESP_GMF_NULL_CHECK(TAG, load, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, ref, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_payload_pool_t *pool = (esp_gmf_payload_pool_t *)load->pool;
+    ESP_GMF_NULL_CHECK(TAG, pool, return ESP_GMF_ERR_INVALID_ARG);
+    int i = esp_gmf_payload_pool_index(pool, load->buf);
+    ESP_GMF_CHECK(TAG, (i >= 0), return ESP_GMF_ERR_INVALID_ARG, "The buffer does not belong to the pool");
+    esp_gmf_oal_mutex_lock(pool->lock);
+    *ref = pool->bufs[i].ref;
+    esp_gmf_oal_mutex_unlock(pool->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_payload_pool_get_info(esp_gmf_payload_pool_handle_t handle, uint32_t *buf_size, uint16_t *free_cnt)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_payload_pool_t *pool = (esp_gmf_payload_pool_t *)handle;
+    if (buf_size) {
+        *buf_size = pool->max_size;
+    }
+    if (free_cnt) {
+        *free_cnt = pool->free_cnt;
+    }
+    return ESP_GMF_ERR_OK;
+}
@@ -6,30 +6,101 @@
  */
 
 #include <string.h>
+#include <inttypes.h>
 #include "esp_log.h"
 #include "esp_gmf_oal_mem.h"
 #include "esp_gmf_oal_mutex.h"
 #include "esp_gmf_element.h"
 #include "esp_gmf_pipeline.h"
 #include "esp_gmf_node.h"
+#include "esp_gmf_new_databus.h"
+#include "esp_gmf_payload_pool.h"
 
 #define PIPELINE_PRE_RUN_STATE  (1 << 0)
 #define PIPELINE_PRE_STOP_STATE (1 << 1)
 
 static const char *TAG = "ESP_GMF_PIPELINE";
 
-static inline void register_close_jobs_to_task(esp_gmf_pipeline_handle_t pipeline)
+/**
+ * @brief  Element to splice into or out of the pipeline, see `esp_gmf_pipeline_insert_el` and `esp_gmf_pipeline_remove_el`
+ */
+typedef struct {
+    esp_gmf_element_handle_t  prev_el;   /*!< Element in front of the spliced one */
+    esp_gmf_element_handle_t  el;        /*!< Element to insert or remove */
+    esp_gmf_port_handle_t     out_port;  /*!< New out port of `prev_el` linked to the inserted element, NULL for the removal */
+    esp_gmf_port_handle_t     in_port;   /*!< New in port of the inserted element, NULL for the removal */
+} esp_gmf_pipeline_splice_t;
+
+/**
+ * @brief  Copy of the information reported to the elements of the pipeline
+ */
+typedef struct esp_gmf_pipeline_info {
+    struct esp_gmf_pipeline_info *next;    /*!< Next information */
+    void                         *from;    /*!< Reporter of the information */
+    int                           sub;     /*!< Type of the information, see `esp_gmf_info_type_t` */
+    int                           size;    /*!< Size of the information */
+    uint8_t                       data[];  /*!< Information data */
+} esp_gmf_pipeline_info_t;
+
+static inline esp_gmf_task_handle_t _get_seg_thread(esp_gmf_pipeline_handle_t pipeline, esp_gmf_pipeline_seg_t *seg)
 {
-    esp_gmf_node_t *node = (esp_gmf_node_t *)pipeline->head_el;
+    return (seg && seg->thread) ? seg->thread : pipeline->thread;
+}
+
+static inline esp_gmf_element_handle_t _get_seg_head_el(esp_gmf_pipeline_handle_t pipeline, esp_gmf_pipeline_seg_t *seg)
+{
+    return seg ? seg->head_el : pipeline->head_el;
+}
+
+static inline esp_gmf_element_handle_t _get_seg_end_el(esp_gmf_pipeline_seg_t *seg)
+{
+    // The element behind the last one of the segment, NULL for the tail of the pipeline
+    return (seg && seg->next) ? seg->next->head_el : NULL;
+}
+
+static inline esp_gmf_pipeline_seg_t *_get_seg_by_task(esp_gmf_pipeline_handle_t pipeline, esp_gmf_task_handle_t tsk)
+{
+    esp_gmf_pipeline_seg_t *seg = pipeline->segs;
+    while (seg && (_get_seg_thread(pipeline, seg) != tsk)) {
+        seg = seg->next;
+    }
+    return seg;
+}
+
+static inline esp_gmf_pipeline_seg_t *_get_seg_by_el(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t el)
+{
+    esp_gmf_pipeline_seg_t *seg = pipeline->segs;
     esp_gmf_element_handle_t next_el = pipeline->head_el;
+    while (seg && next_el) {
+        if (seg->next && (next_el == seg->next->head_el)) {
+            seg = seg->next;
+        }
+        if (next_el == el) {
+            return seg;
+        }
+        next_el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)next_el);
+    }
+    return NULL;
+}
+
+static inline void register_close_jobs_to_task(esp_gmf_pipeline_handle_t pipeline, esp_gmf_pipeline_seg_t *seg, bool keep_opened)
+{
+    esp_gmf_task_handle_t tsk = _get_seg_thread(pipeline, seg);
+    esp_gmf_element_handle_t end_el = _get_seg_end_el(seg);
+    esp_gmf_node_t *node = (esp_gmf_node_t *)_get_seg_head_el(pipeline, seg);
+    esp_gmf_element_handle_t next_el = (esp_gmf_element_handle_t)node;
     do {
-        ESP_LOGD(TAG, "Add close job, p:%p, tsk:%p, [el:%s-%p]", pipeline, pipeline->thread, OBJ_GET_TAG(next_el), next_el);
+        ESP_LOGD(TAG, "Add close job, p:%p, tsk:%p, [el:%s-%p]", pipeline, tsk, OBJ_GET_TAG(next_el), next_el);
         esp_gmf_element_change_job_mask(next_el, ESP_GMF_ELEMENT_JOB_CLOSE);
         char name[ESP_GMF_JOB_LABLE_MAX_LEN] = "";
         esp_gmf_job_str_cat(name, ESP_GMF_JOB_LABLE_MAX_LEN, OBJ_GET_TAG(next_el), ESP_GMF_JOB_STR_CLOSE, strlen(ESP_GMF_JOB_STR_CLOSE));
-        esp_gmf_task_register_ready_job(pipeline->thread, name, esp_gmf_element_process_close, ESP_GMF_JOB_TIMES_ONCE, next_el, true);
+        if (keep_opened && ESP_GMF_ELEMENT_GET(next_el)->ops.reset) {
+            esp_gmf_task_register_ready_job(tsk, name, esp_gmf_element_process_keep, ESP_GMF_JOB_TIMES_ONCE, next_el, true);
+        } else {
+            esp_gmf_task_register_ready_job(tsk, name, esp_gmf_element_process_close, ESP_GMF_JOB_TIMES_ONCE, next_el, true);
+        }
         node = (esp_gmf_node_t *)next_el;
-    } while ((next_el = (esp_gmf_element_handle_t)esp_gmf_node_for_next(node)));
+    } while ((next_el = (esp_gmf_element_handle_t)esp_gmf_node_for_next(node)) && (next_el != end_el));
 }
 
 static inline esp_gmf_err_t register_working_jobs_to_task(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t el)
@@ -43,30 +114,74 @@ static inline esp_gmf_err_t register_working_jobs_to_task(esp_gmf_pipeline_handl
         esp_gmf_oal_mutex_unlock(pipeline->lock);
         return ESP_GMF_ERR_NOT_READY;
     }
-    if (pipeline->thread == NULL) {
-        ESP_LOGW(TAG, "There is no thread for add jobs, pipe:%p, tsk:%p, [el:%s-%p]", pipeline, pipeline->thread, OBJ_GET_TAG(el), el);
+    esp_gmf_pipeline_seg_t *seg = _get_seg_by_el(pipeline, el);
+    esp_gmf_task_handle_t tsk = _get_seg_thread(pipeline, seg);
+    if (tsk == NULL) {
+        ESP_LOGW(TAG, "There is no thread for add jobs, pipe:%p, tsk:%p, [el:%s-%p]", pipeline, tsk, OBJ_GET_TAG(el), el);
         esp_gmf_oal_mutex_unlock(pipeline->lock);
         return ESP_GMF_ERR_NOT_SUPPORT;
     }
     esp_gmf_element_get_job_mask(el, &job_mask);
     if ((job_mask & (ESP_GMF_ELEMENT_JOB_OPEN | ESP_GMF_ELEMENT_JOB_PROCESS)) == 0) {
-        ESP_LOGD(TAG, "Add open and process jobs, p:%p, tsk:%p, [el:%s-%p]", pipeline, pipeline->thread, OBJ_GET_TAG(el), el);
+        ESP_LOGD(TAG, "Add open and process jobs, p:%p, tsk:%p, [el:%s-%p]", pipeline, tsk, OBJ_GET_TAG(el), el);
         esp_gmf_element_change_job_mask(el, ESP_GMF_ELEMENT_JOB_OPEN);
         esp_gmf_element_change_job_mask(el, ESP_GMF_ELEMENT_JOB_PROCESS);
         char name[ESP_GMF_JOB_LABLE_MAX_LEN] = "";
         esp_gmf_job_str_cat(name, ESP_GMF_JOB_LABLE_MAX_LEN, OBJ_GET_TAG(el), ESP_GMF_JOB_STR_OPEN, strlen(ESP_GMF_JOB_STR_OPEN));
-        esp_gmf_task_register_ready_job(pipeline->thread, name, esp_gmf_element_process_open, ESP_GMF_JOB_TIMES_ONCE, el, false);
-        esp_gmf_job_str_cat(name, ESP_GMF_JOB_LABLE_MAX_LEN, OBJ_GET_TAG(el), ESP_GMF_JOB_STR_PROCESS, strlen(ESP_GMF_JOB_STR_PROCESS));
-        esp_gmf_task_register_ready_job(pipeline->thread, name, esp_gmf_element_process_running, ESP_GMF_JOB_TIMES_INFINITE, el, true);
+        // The next element consuming the output may have its jobs already, e.g. the element is spliced in, run in front of it
+        esp_gmf_element_handle_t next_el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el);
+        uint16_t next_mask = 0;
+        if (next_el) {
+            esp_gmf_element_get_job_mask(next_el, &next_mask);
+        }
+        if (next_mask & ESP_GMF_ELEMENT_JOB_PROCESS) {
+            esp_gmf_task_insert_ready_job(tsk, next_el, name, esp_gmf_element_process_open, ESP_GMF_JOB_TIMES_ONCE, el);
+            esp_gmf_job_str_cat(name, ESP_GMF_JOB_LABLE_MAX_LEN, OBJ_GET_TAG(el), ESP_GMF_JOB_STR_PROCESS, strlen(ESP_GMF_JOB_STR_PROCESS));
+            esp_gmf_task_insert_ready_job(tsk, next_el, name, esp_gmf_element_process_running, ESP_GMF_JOB_TIMES_INFINITE, el);
+        } else {
+            esp_gmf_task_register_ready_job(tsk, name, esp_gmf_element_process_open, ESP_GMF_JOB_TIMES_ONCE, el, false);
+            esp_gmf_job_str_cat(name, ESP_GMF_JOB_LABLE_MAX_LEN, OBJ_GET_TAG(el), ESP_GMF_JOB_STR_PROCESS, strlen(ESP_GMF_JOB_STR_PROCESS));
+            esp_gmf_task_register_ready_job(tsk, name, esp_gmf_element_process_running, ESP_GMF_JOB_TIMES_INFINITE, el, true);
+        }
+        if (el == _get_seg_head_el(pipeline, seg)) {
+            // The segment reads the data bus, e.g. a branch on the task of the trunk, it doesn't wait for the jobs in front of it
+            esp_gmf_task_set_chain_head(tsk, el);
+        }
     }
     esp_gmf_oal_mutex_unlock(pipeline->lock);
     return ESP_GMF_ERR_OK;
 }
 
-static inline void _set_pipe_linked_el_state(esp_gmf_pipeline_handle_t pipeline, esp_gmf_event_state_t event)
+static void pipeline_port_ready_notify(void *ctx)
 {
-    esp_gmf_element_handle_t next_el = (esp_gmf_element_handle_t)pipeline->head_el;
-    while (next_el) {
+    esp_gmf_task_notify_ready((esp_gmf_task_handle_t)ctx);
+}
+
+static inline void _set_pipe_ports_notify(esp_gmf_pipeline_handle_t pipeline, esp_gmf_pipeline_seg_t *seg, esp_gmf_task_handle_t tsk, bool attach)
+{
+    // Wake up the task when the ports are ready, detach the notification of the task before the job loop ends.
+    // The task tells its notification apart from the others on a data bus shared by several pipelines
+    esp_gmf_port_notify_cb cb = attach ? pipeline_port_ready_notify : NULL;
+    esp_gmf_element_handle_t end_el = _get_seg_end_el(seg);
+    esp_gmf_element_handle_t next_el = _get_seg_head_el(pipeline, seg);
+    while (next_el && (next_el != end_el)) {
+        esp_gmf_port_handle_t port = ESP_GMF_ELEMENT_GET_IN_PORT(next_el);
+        for (; port; port = port->next) {
+            esp_gmf_port_set_notify(port, cb, tsk);
+        }
+        port = ESP_GMF_ELEMENT_GET_OUT_PORT(next_el);
+        for (; port; port = port->next) {
+            esp_gmf_port_set_notify(port, cb, tsk);
+        }
+        next_el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)next_el);
+    }
+}
+
+static inline void _set_pipe_linked_el_state(esp_gmf_pipeline_handle_t pipeline, esp_gmf_pipeline_seg_t *seg, esp_gmf_event_state_t event)
+{
+    esp_gmf_element_handle_t end_el = _get_seg_end_el(seg);
+    esp_gmf_element_handle_t next_el = _get_seg_head_el(pipeline, seg);
+    while (next_el && (next_el != end_el)) {
         esp_gmf_event_state_t st = ESP_GMF_EVENT_STATE_NONE;
         esp_gmf_element_get_state(next_el, &st);
         if (st == ESP_GMF_EVENT_STATE_INITIALIZED) {
@@ -76,6 +191,107 @@ static inline void _set_pipe_linked_el_state(esp_gmf_pipeline_handle_t pipeline,
     }
 }
 
+static inline void _abort_pipe_segs(esp_gmf_pipeline_handle_t pipeline)
+{
+    for (esp_gmf_pipeline_seg_t *seg = pipeline->segs; seg; seg = seg->next) {
+        if (seg->db) {
+            esp_gmf_db_abort(seg->db);
+        }
+    }
+}
+
+static esp_gmf_err_t _open_branches(esp_gmf_pipeline_handle_t pipeline, esp_gmf_task_handle_t tsk)
+{
+    esp_gmf_err_t ret = ESP_GMF_ERR_OK;
+    for (esp_gmf_pipeline_branch_t *br = pipeline->branches; br && (ret == ESP_GMF_ERR_OK); br = br->next) {
+        if (br->pipeline->thread != tsk) {
+            continue;
+        }
+        if (br->pipeline->in) {
+            ret = esp_gmf_io_open(br->pipeline->in);
+        }
+        if ((ret == ESP_GMF_ERR_OK) && br->pipeline->out) {
+            ret = esp_gmf_io_open(br->pipeline->out);
+        }
+        if (ret == ESP_GMF_ERR_OK) {
+            _set_pipe_ports_notify(br->pipeline, NULL, tsk, true);
+        }
+    }
+    return ret;
+}
+
+static void _close_branches(esp_gmf_pipeline_handle_t pipeline, esp_gmf_task_handle_t tsk, bool keep_opened)
+{
+    for (esp_gmf_pipeline_branch_t *br = pipeline->branches; br; br = br->next) {
+        if (br->pipeline->thread != tsk) {
+            continue;
+        }
+        _set_pipe_ports_notify(br->pipeline, NULL, tsk, false);
+        register_close_jobs_to_task(br->pipeline, NULL, keep_opened);
+        if (br->pipeline->in) {
+            esp_gmf_io_close(br->pipeline->in);
+        }
+        if (br->pipeline->out) {
+            esp_gmf_io_close(br->pipeline->out);
+        }
+    }
+}
+
+static void _set_branches_el_state(esp_gmf_pipeline_handle_t pipeline, esp_gmf_task_handle_t tsk, esp_gmf_event_state_t event)
+{
+    for (esp_gmf_pipeline_branch_t *br = pipeline->branches; br; br = br->next) {
+        if (br->pipeline->thread == tsk) {
+            _set_pipe_linked_el_state(br->pipeline, NULL, event);
+            br->pipeline->state = event;
+        }
+    }
+}
+
+static inline bool _is_end_state(esp_gmf_event_state_t st)
+{
+    return (st == ESP_GMF_EVENT_STATE_STOPPED) || (st == ESP_GMF_EVENT_STATE_FINISHED) || (st == ESP_GMF_EVENT_STATE_ERROR);
+}
+
+/**
+ * @brief  Record the state reported by a segment task, and merge the states of all the segments into the state of the pipeline
+ *
+ *         Return true when the merged state in `evt->sub` is to be reported. The running state is reported by the first segment,
+ *         the paused state and the end states are reported once all the segments have reached them
+ */
+static bool _merge_seg_state(esp_gmf_pipeline_handle_t pipeline, esp_gmf_pipeline_seg_t *seg, esp_gmf_event_pkt_t *evt)
+{
+    if (seg == NULL) {
+        return true;
+    }
+    esp_gmf_oal_mutex_lock(pipeline->lock);
+    seg->state = evt->sub;
+    bool report = true;
+    if (evt->sub == ESP_GMF_EVENT_STATE_PAUSED) {
+        for (esp_gmf_pipeline_seg_t *tmp = pipeline->segs; tmp; tmp = tmp->next) {
+            if ((tmp->state != ESP_GMF_EVENT_STATE_PAUSED) && !_is_end_state(tmp->state)) {
+                report = false;
+            }
+        }
+    } else if (_is_end_state(evt->sub)) {
+        esp_gmf_event_state_t merged = ESP_GMF_EVENT_STATE_FINISHED;
+        for (esp_gmf_pipeline_seg_t *tmp = pipeline->segs; tmp; tmp = tmp->next) {
+            if (!_is_end_state(tmp->state)) {
+                report = false;
+            } else if ((tmp->state == ESP_GMF_EVENT_STATE_ERROR) || (merged == ESP_GMF_EVENT_STATE_ERROR)) {
+                merged = ESP_GMF_EVENT_STATE_ERROR;
+            } else if (tmp->state == ESP_GMF_EVENT_STATE_STOPPED) {
+                merged = ESP_GMF_EVENT_STATE_STOPPED;
+            }
+        }
+        // The segments aborted by stop may quit with error, they are stopped as a whole
+        evt->sub = pipeline->seg_stopping ? ESP_GMF_EVENT_STATE_STOPPED : merged;
+    } else {
+        report = (seg == pipeline->segs);
+    }
+    esp_gmf_oal_mutex_unlock(pipeline->lock);
+    return report;
+}
+
 static esp_gmf_err_t esp_gmf_task_evt(esp_gmf_event_pkt_t *evt, void *ctx)
 {
     esp_gmf_pipeline_handle_t pipeline = (esp_gmf_pipeline_handle_t)ctx;
@@ -83,18 +299,31 @@ static esp_gmf_err_t esp_gmf_task_evt(esp_gmf_event_pkt_t *evt, void *ctx)
     ESP_LOGD(TAG, "TASK EVT, p:%p tsk:%s-%p, t:%x, sub:%s, pld:%p, sz:%d", pipeline,
              OBJ_GET_TAG(tsk), evt->from, evt->type, esp_gmf_event_get_state_str(evt->sub), evt->payload, evt->payload_size);
     int ret_val = ESP_GMF_ERR_OK;
+    // The segment which the task runs, NULL when the pipeline is not split
+    esp_gmf_pipeline_seg_t *seg = _get_seg_by_task(pipeline, tsk);
+    bool is_head = (seg == NULL) || (seg == pipeline->segs);
+    bool is_tail = (seg == NULL) || (seg->next == NULL);
     if (evt->type == ESP_GMF_EVT_TYPE_LOADING_JOB) {
         switch (evt->sub) {
             case ESP_GMF_EVENT_STATE_ERROR:
             case ESP_GMF_EVENT_STATE_STOPPED:
             case ESP_GMF_EVENT_STATE_FINISHED: {
-                register_close_jobs_to_task(pipeline);
-                if (pipeline->in) {
+                _set_pipe_ports_notify(pipeline, seg, tsk, false);
+                // Close all the elements on error, the state of the kept ones may be broken
+                register_close_jobs_to_task(pipeline, seg, pipeline->warm_restart && (evt->sub != ESP_GMF_EVENT_STATE_ERROR));
+                _close_branches(pipeline, tsk, pipeline->warm_restart && (evt->sub != ESP_GMF_EVENT_STATE_ERROR));
+                if (pipeline->in && is_head) {
                     esp_gmf_io_close(pipeline->in);
                 }
-                if (pipeline->out) {
+                if (pipeline->out && is_tail) {
                     esp_gmf_io_close(pipeline->out);
                 }
+                if (seg && (evt->sub == ESP_GMF_EVENT_STATE_FINISHED) && seg->next) {
+                    esp_gmf_db_done_write(seg->next->db);
+                } else if (seg && (evt->sub == ESP_GMF_EVENT_STATE_ERROR)) {
+                    // Let the other segments quit rather than wait for the data forever
+                    _abort_pipe_segs(pipeline);
+                }
             } break;
         }
     } else if (evt->type == ESP_GMF_EVT_TYPE_CHANGE_STATE) {
@@ -102,7 +331,11 @@ static esp_gmf_err_t esp_gmf_task_evt(esp_gmf_event_pkt_t *evt, void *ctx)
             case ESP_GMF_EVENT_STATE_ERROR:
             case ESP_GMF_EVENT_STATE_STOPPED:
             case ESP_GMF_EVENT_STATE_FINISHED:
-                _set_pipe_linked_el_state(pipeline, evt->sub);
+                _set_pipe_linked_el_state(pipeline, seg, evt->sub);
+                _set_branches_el_state(pipeline, tsk, evt->sub);
+                if (_merge_seg_state(pipeline, seg, evt) == false) {
+                    break;
+                }
                 if (pipeline->user_cb) {
                     evt->from = pipeline;
                     pipeline->user_cb(evt, pipeline->user_ctx);
@@ -110,7 +343,11 @@ static esp_gmf_err_t esp_gmf_task_evt(esp_gmf_event_pkt_t *evt, void *ctx)
                 pipeline->state = evt->sub;
                 break;
             case ESP_GMF_EVENT_STATE_PAUSED:
-                _set_pipe_linked_el_state(pipeline, evt->sub);
+                _set_pipe_linked_el_state(pipeline, seg, evt->sub);
+                _set_branches_el_state(pipeline, tsk, evt->sub);
+                if (_merge_seg_state(pipeline, seg, evt) == false) {
+                    break;
+                }
                 if (pipeline->user_cb) {
                     evt->from = pipeline;
                     pipeline->user_cb(evt, pipeline->user_ctx);
@@ -121,24 +358,37 @@ static esp_gmf_err_t esp_gmf_task_evt(esp_gmf_event_pkt_t *evt, void *ctx)
                 esp_gmf_event_state_t st = 0;
                 esp_gmf_task_get_state(tsk, &st);
                 if (st != ESP_GMF_EVENT_STATE_PAUSED) {
-                    if (pipeline->in) {
+                    if (pipeline->in && is_head) {
                         ret_val = esp_gmf_io_open(pipeline->in);
                         if (ret_val != ESP_GMF_ERR_OK) {
                             evt->sub = ESP_GMF_EVENT_STATE_ERROR;
                             ESP_LOGE(TAG, "Failed to open the in port, ret:%d,[%p-%s]", ret_val, tsk, OBJ_GET_TAG(tsk));
                         }
                     }
-                    if ((ret_val == ESP_GMF_ERR_OK) && pipeline->out) {
+                    if ((ret_val == ESP_GMF_ERR_OK) && pipeline->out && is_tail) {
                         ret_val = esp_gmf_io_open(pipeline->out);
                         if (ret_val != ESP_GMF_ERR_OK) {
                             evt->sub = ESP_GMF_EVENT_STATE_ERROR;
                             ESP_LOGE(TAG, "Failed to open the out port, ret:%d,[%p-%s]", ret_val, tsk, OBJ_GET_TAG(tsk));
                         }
                     }
+                    if (ret_val == ESP_GMF_ERR_OK) {
+                        ret_val = _open_branches(pipeline, tsk);
+                        if (ret_val != ESP_GMF_ERR_OK) {
+                            ESP_LOGE(TAG, "Failed to open the IO of the branches, ret:%d,[%p-%s]", ret_val, tsk, OBJ_GET_TAG(tsk));
+                        }
+                    }
                     evt->sub = ESP_GMF_EVENT_STATE_OPENING;
+                    if (ret_val == ESP_GMF_ERR_OK) {
+                        _set_pipe_ports_notify(pipeline, seg, tsk, true);
+                    }
                 }
                 evt->from = pipeline;
-                _set_pipe_linked_el_state(pipeline, evt->sub);
+                _set_pipe_linked_el_state(pipeline, seg, evt->sub);
+                _set_branches_el_state(pipeline, tsk, evt->sub);
+                if (_merge_seg_state(pipeline, seg, evt) == false) {
+                    break;
+                }
                 if (pipeline->user_cb) {
                     pipeline->user_cb(evt, pipeline->user_ctx);
                 }
@@ -148,12 +398,48 @@ static esp_gmf_err_t esp_gmf_task_evt(esp_gmf_event_pkt_t *evt, void *ctx)
             default:
                 break;
         }
+    } else if (evt->type == ESP_GMF_EVT_TYPE_DEADLINE_MISS) {
+        if (pipeline->user_cb) {
+            evt->from = pipeline;
+            pipeline->user_cb(evt, pipeline->user_ctx);
+        }
     } else {
         ESP_LOGW(TAG, "Not supported event type(%d), [p:%p, tsk:%s-%p]", evt->type, pipeline, OBJ_GET_TAG(tsk), tsk);
     }
     return ret_val;
 }
 
+static void pipeline_keep_info(esp_gmf_pipeline_handle_t pipeline, esp_gmf_event_pkt_t *evt)
+{
+    // Keep the last information of each reporter and type, it's given to the elements spliced into the running pipeline
+    if ((evt->payload == NULL) || (evt->payload_size <= 0)) {
+        return;
+    }
+    esp_gmf_oal_mutex_lock(pipeline->lock);
+    esp_gmf_pipeline_info_t **pos = (esp_gmf_pipeline_info_t **)&pipeline->infos;
+    while (*pos && (((*pos)->from != evt->from) || ((*pos)->sub != evt->sub))) {
+        pos = &(*pos)->next;
+    }
+    esp_gmf_pipeline_info_t *info = *pos;
+    if ((info == NULL) || (info->size < evt->payload_size)) {
+        esp_gmf_pipeline_info_t *new_info = esp_gmf_oal_malloc(sizeof(esp_gmf_pipeline_info_t) + evt->payload_size);
+        if (new_info == NULL) {
+            esp_gmf_oal_mutex_unlock(pipeline->lock);
+            ESP_LOGW(TAG, "No memory to keep the information, type:%x, sz:%d, p:%p", evt->sub, evt->payload_size, pipeline);
+            return;
+        }
+        new_info->next = info ? info->next : NULL;
+        new_info->from = evt->from;
+        new_info->sub = evt->sub;
+        *pos = new_info;
+        esp_gmf_oal_free(info);
+        info = new_info;
+    }
+    memcpy(info->data, evt->payload, evt->payload_size);
+    info->size = evt->payload_size;
+    esp_gmf_oal_mutex_unlock(pipeline->lock);
+}
+
 static esp_gmf_err_t pipeline_element_events(esp_gmf_event_pkt_t *evt, void *ctx)
 {
     esp_gmf_pipeline_handle_t pipeline = (esp_gmf_pipeline_handle_t)ctx;
@@ -162,6 +448,9 @@ static esp_gmf_err_t pipeline_element_events(esp_gmf_event_pkt_t *evt, void *ctx
     }
     esp_gmf_element_handle_t el = evt->from;
     esp_gmf_element_handle_t next_el = (esp_gmf_element_handle_t)pipeline->head_el;
+    if (evt->type == ESP_GMF_EVT_TYPE_REPORT_INFO) {
+        pipeline_keep_info(pipeline, evt);
+    }
 
     // 0. Confirm whether the notification target is the first element of another pipeline or
     //    the element of the current pipeline.
@@ -231,6 +520,12 @@ static esp_gmf_err_t pipeline_element_events(esp_gmf_event_pkt_t *evt, void *ctx
                 next_el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)next_el);
             }
         }
+        // The branches take the information of the tee element as the one of the previous element
+        for (esp_gmf_pipeline_branch_t *br = pipeline->branches; br; br = br->next) {
+            if ((br->trunk_el == el) && (br->is_join == 0)) {
+                pipeline_element_events(evt, br->pipeline);
+            }
+        }
         if (el == pipeline->last_el && pipeline->user_cb) {
             pipeline->user_cb(evt, pipeline->user_ctx);
         }
@@ -243,104 +538,1150 @@ static esp_gmf_err_t pipeline_element_events(esp_gmf_event_pkt_t *evt, void *ctx
     } else {
         ESP_LOGE(TAG, "Not supported event type(%d), [p:%p, el:%s-%p]", evt->type, pipeline, OBJ_GET_TAG(el), el);
     }
-    ESP_LOGD(TAG, "EL EVT END, from:%s-%p, p:%p", OBJ_GET_TAG(el), el, pipeline);
-    return ESP_GMF_ERR_OK;
+    ESP_LOGD(TAG, "EL EVT END, from:%s-%p, p:%p", OBJ_GET_TAG(el), el, pipeline);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_pipeline_create(esp_gmf_pipeline_handle_t *pipeline)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    *pipeline = esp_gmf_oal_calloc(1, sizeof(esp_gmf_pipeline_t));
+    ESP_GMF_MEM_CHECK(TAG, *pipeline, return ESP_GMF_ERR_MEMORY_LACK);
+    (*pipeline)->lock = esp_gmf_oal_mutex_create();
+    ESP_GMF_MEM_CHECK(TAG, (*pipeline)->lock, {esp_gmf_oal_free(*pipeline); return ESP_GMF_ERR_MEMORY_LACK;});
+    (*pipeline)->evt_acceptor = pipeline_element_events;
+    (*pipeline)->state = ESP_GMF_EVENT_STATE_NONE;
+    return ESP_GMF_ERR_OK;
+}
+
+static void pipeline_close_kept_els(esp_gmf_pipeline_handle_t pipeline)
+{
+    // Close the elements kept opened by the warm restart, the tasks have finished running them
+    esp_gmf_element_handle_t el = pipeline->head_el;
+    for (; el; el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el)) {
+        if (ESP_GMF_ELEMENT_GET(el)->opened && ESP_GMF_ELEMENT_GET(el)->ops.reset) {
+            ESP_LOGD(TAG, "Close the kept element, p:%p, [el:%s-%p]", pipeline, OBJ_GET_TAG(el), el);
+            esp_gmf_element_process_close(el, NULL);
+        }
+    }
+}
+
+static void pipeline_unregister_jobs(esp_gmf_pipeline_handle_t pipeline, esp_gmf_task_handle_t tsk)
+{
+    // The bound task outlives the pipeline, release what it keeps for the elements, e.g. the profiling records
+    esp_gmf_element_handle_t el = pipeline->head_el;
+    for (; el; el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el)) {
+        esp_gmf_task_unregister_jobs(tsk, el);
+    }
+    for (esp_gmf_pipeline_branch_t *br = pipeline->branches; br; br = br->next) {
+        pipeline_unregister_jobs(br->pipeline, tsk);
+    }
+}
+
+esp_gmf_err_t esp_gmf_pipeline_destroy(esp_gmf_pipeline_handle_t pipeline)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_LOGD(TAG, "Pipeline destroying, %p", pipeline);
+    esp_gmf_oal_mutex_lock(pipeline->lock);
+    if (pipeline->thread && (pipeline->thread != pipeline->pool_thread) && (pipeline->trunk == NULL)) {
+        pipeline_unregister_jobs(pipeline, pipeline->thread);
+    }
+    if (pipeline->pool_thread) {
+        // The task created by `esp_gmf_pipeline_bind_pool` may still run jobs of the elements, release it first
+        esp_gmf_task_deinit(pipeline->pool_thread);
+        pipeline->pool_thread = NULL;
+    }
+    for (esp_gmf_pipeline_seg_t *seg = pipeline->segs; seg; seg = seg->next) {
+        if (seg->thread) {
+            esp_gmf_task_deinit(seg->thread);
+            seg->thread = NULL;
+        }
+    }
+    if (pipeline->in) {
+        esp_gmf_element_unregister_in_port(pipeline->head_el, NULL);
+        esp_gmf_obj_delete((esp_gmf_obj_handle_t)pipeline->in);
+    }
+    if (pipeline->out) {
+        esp_gmf_element_unregister_out_port(pipeline->last_el, NULL);
+        esp_gmf_obj_delete((esp_gmf_obj_handle_t)pipeline->out);
+    }
+
+    esp_gmf_event_item_t *item = pipeline->evt_conveyor;
+    while (item) {
+        esp_gmf_event_item_t *tmp = item->next;
+        esp_gmf_oal_free(item);
+        item = tmp;
+    }
+    // The branches run on the tasks released above, destroy them before the tee elements
+    for (esp_gmf_pipeline_branch_t *br = pipeline->branches; br; br = br->next) {
+        br->pipeline->thread = NULL;
+        esp_gmf_pipeline_destroy(br->pipeline);
+        if (br->reader) {
+            esp_gmf_db_deinit(br->reader);
+        }
+    }
+    pipeline_close_kept_els(pipeline);
+    esp_gmf_pipeline_splice_t *sp = (esp_gmf_pipeline_splice_t *)pipeline->splice;
+    if (sp && sp->out_port) {
+        // The element of the pending insertion is not linked yet, its in port is deleted along
+        esp_gmf_port_deinit(sp->out_port);
+        esp_gmf_obj_delete(sp->el);
+    }
+    esp_gmf_oal_free(sp);
+    pipeline->splice = NULL;
+    esp_gmf_node_clear((esp_gmf_node_t **)&pipeline->head_el, (void *)esp_gmf_obj_delete);
+    esp_gmf_pipeline_branch_t *br = pipeline->branches;
+    while (br) {
+        esp_gmf_pipeline_branch_t *tmp = br->next;
+        // The writer is shared by the branches on the same element, release it with the last of them
+        bool shared = false;
+        for (esp_gmf_pipeline_branch_t *rest = tmp; rest; rest = rest->next) {
+            shared |= (rest->writer == br->writer);
+        }
+        if (shared == false) {
+            esp_gmf_db_deinit(br->writer);
+        }
+        esp_gmf_oal_free(br);
+        br = tmp;
+    }
+    pipeline->branches = NULL;
+    // The ports on the split points are deleted with the elements, release the data buses after them
+    esp_gmf_pipeline_seg_t *seg = pipeline->segs;
+    while (seg) {
+        esp_gmf_pipeline_seg_t *tmp = seg->next;
+        if (seg->db) {
+            esp_gmf_db_deinit(seg->db);
+        }
+        esp_gmf_oal_free(seg);
+        seg = tmp;
+    }
+    pipeline->segs = NULL;
+    esp_gmf_pipeline_info_t *info = (esp_gmf_pipeline_info_t *)pipeline->infos;
+    while (info) {
+        esp_gmf_pipeline_info_t *tmp = info->next;
+        esp_gmf_oal_free(info);
+        info = tmp;
+    }
+    pipeline->infos = NULL;
+    // The ports returned their buffers when they were deleted with the elements
+    if (pipeline->pld_pool) {
+        esp_gmf_payload_pool_destroy(pipeline->pld_pool);
+        pipeline->pld_pool = NULL;
+    }
+    esp_gmf_oal_mutex_unlock(pipeline->lock);
+    esp_gmf_oal_mutex_destroy(pipeline->lock);
+    esp_gmf_oal_free(pipeline);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_pipeline_set_io(esp_gmf_pipeline_handle_t pipeline, esp_gmf_io_handle_t io, int dir)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    if (dir == ESP_GMF_IO_DIR_READER) {
+        pipeline->in = io;
+    } else if (dir == ESP_GMF_IO_DIR_WRITER) {
+        pipeline->out = io;
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_pipeline_register_el(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t el)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_element_set_event_func(el, pipeline_element_events, pipeline);
+    if (pipeline->head_el == NULL) {
+        pipeline->head_el = el;
+        pipeline->last_el = el;
+    } else {
+        pipeline->last_el = el;
+        esp_gmf_element_link_el(pipeline->head_el, el);
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_pipeline_list_el(esp_gmf_pipeline_handle_t pipeline)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_node_t *head = (esp_gmf_node_t *)pipeline->head_el;
+    while (head) {
+        printf("%p-%s, prev:%p-%s, next:%p-%s \r\n", head, OBJ_GET_TAG(head), head->prev, OBJ_GET_TAG(head->prev), head->next, OBJ_GET_TAG(head->next));
+        head = head->next;
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_pipeline_set_event(esp_gmf_pipeline_handle_t pipeline, esp_gmf_event_cb cb, void *ctx)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    pipeline->user_cb = cb;
+    pipeline->user_ctx = ctx;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_pipeline_bind_task(esp_gmf_pipeline_handle_t pipeline, esp_gmf_task_handle_t task)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    if (pipeline->pool_thread && (pipeline->pool_thread != task)) {
+        // Release the task created by `esp_gmf_pipeline_bind_pool`
+        if (pipeline->thread == pipeline->pool_thread) {
+            pipeline->thread = NULL;
+        }
+        esp_gmf_task_deinit(pipeline->pool_thread);
+        pipeline->pool_thread = NULL;
+    }
+    if (task == NULL) {
+        // Allow clear bind task, so that can recreate task and bind
+        pipeline->thread = NULL;
+        return ESP_GMF_ERR_OK;
+    }
+    ESP_GMF_NULL_CHECK(TAG, task, return ESP_GMF_ERR_INVALID_ARG);
+    pipeline->thread = task;
+    esp_gmf_task_set_event_func(task, esp_gmf_task_evt, pipeline);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_pipeline_bind_pool(esp_gmf_pipeline_handle_t pipeline, esp_gmf_task_pool_handle_t pool, const char *name)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, pool, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.name = name;
+    cfg.pool = pool;
+    esp_gmf_task_handle_t task = NULL;
+    esp_gmf_err_t ret = esp_gmf_task_init(&cfg, &task);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Failed to create pool task for %p, pool:%p", pipeline, pool);
+    ret = esp_gmf_pipeline_bind_task(pipeline, task);
+    if (ret != ESP_GMF_ERR_OK) {
+        esp_gmf_task_deinit(task);
+        return ret;
+    }
+    pipeline->pool_thread = task;
+    ESP_LOGD(TAG, "Bind pool, p:%p, tsk:%p, pool:%p", pipeline, task, pool);
+    return ESP_GMF_ERR_OK;
+}
+
+static bool pipeline_has_el(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t el)
+{
+    esp_gmf_element_handle_t next_el = pipeline->head_el;
+    while (next_el && (next_el != el)) {
+        next_el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)next_el);
+    }
+    return next_el != NULL;
+}
+
+static esp_gmf_err_t pipeline_el_job_stats(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t el, esp_gmf_job_stats_t *stats)
+{
+    // Sum up all the jobs of the element, the time distribution is the one of the most called job, i.e. the process job
+    esp_gmf_pipeline_seg_t *seg = _get_seg_by_el(pipeline, el);
+    esp_gmf_task_handle_t tsk = _get_seg_thread(pipeline, seg);
+    memset(stats, 0, sizeof(esp_gmf_job_stats_t));
+    stats->label = OBJ_GET_TAG(el);
+    stats->ctx = el;
+    if (tsk == NULL) {
+        return ESP_GMF_ERR_OK;
+    }
+    const void *iter = NULL;
+    esp_gmf_job_stats_t job = {0};
+    uint32_t most_cnt = 0;
+    esp_gmf_err_t ret = ESP_GMF_ERR_OK;
+    while ((ret = esp_gmf_task_get_job_stats(tsk, &iter, &job)) == ESP_GMF_ERR_OK) {
+        if (job.ctx != el) {
+            continue;
+        }
+        stats->total_us += job.total_us;
+        stats->blocked_us += job.blocked_us;
+        stats->bytes_in += job.bytes_in;
+        stats->bytes_out += job.bytes_out;
+        if (job.call_cnt > most_cnt) {
+            most_cnt = job.call_cnt;
+            stats->call_cnt = job.call_cnt;
+            stats->min_us = job.min_us;
+            stats->max_us = job.max_us;
+            stats->p50_us = job.p50_us;
+            stats->p90_us = job.p90_us;
+            stats->p99_us = job.p99_us;
+        }
+    }
+    return ret == ESP_GMF_ERR_NOT_FOUND ? ESP_GMF_ERR_OK : ret;
+}
+
+static inline uint64_t pipeline_el_cost(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t el)
+{
+    // The measured computing time, every element weighs the same when it is not profiled
+    esp_gmf_job_stats_t stats;
+    if ((pipeline_el_job_stats(pipeline, el, &stats) != ESP_GMF_ERR_OK) || (stats.total_us <= stats.blocked_us)) {
+        return 1;
+    }
+    return stats.total_us - stats.blocked_us;
+}
+
+static esp_gmf_element_handle_t pipeline_pick_split_el(esp_gmf_pipeline_handle_t pipeline)
+{
+    // Split the most costly segment at the point where the cost of the two parts is the closest
+    esp_gmf_pipeline_seg_t whole = {.head_el = pipeline->head_el};
+    esp_gmf_pipeline_seg_t *seg = pipeline->segs ? pipeline->segs : &whole;
+    esp_gmf_element_handle_t best_el = NULL;
+    uint64_t best_total = 0;
+    for (; seg; seg = seg->next) {
+        esp_gmf_element_handle_t end_el = _get_seg_end_el(seg);
+        uint64_t total = 0;
+        esp_gmf_element_handle_t el = seg->head_el;
+        for (; el && (el != end_el); el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el)) {
+            total += pipeline_el_cost(pipeline, el);
+        }
+        if (total <= best_total) {
+            continue;
+        }
+        uint64_t left = 0;
+        uint64_t seg_cost = UINT64_MAX;
+        esp_gmf_element_handle_t seg_el = NULL;
+        for (el = seg->head_el; el && (el != end_el); el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el)) {
+            esp_gmf_element_handle_t next_el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el);
+            if ((next_el == NULL) || (next_el == end_el)) {
+                break;
+            }
+            left += pipeline_el_cost(pipeline, el);
+            uint64_t cost = left > (total - left) ? left : (total - left);
+            if (cost < seg_cost) {
+                seg_cost = cost;
+                seg_el = el;
+            }
+        }
+        if (seg_el) {
+            best_el = seg_el;
+            best_total = total;
+        }
+    }
+    return best_el;
+}
+
+static inline uint8_t pipeline_split_port_type(esp_gmf_element_handle_t el, esp_gmf_element_handle_t next_el)
+{
+    uint8_t type = ESP_GMF_ELEMENT_GET(el)->out_attr.port.type & ESP_GMF_ELEMENT_GET(next_el)->in_attr.port.type;
+    if (type & ESP_GMF_PORT_TYPE_BYTE) {
+        return ESP_GMF_PORT_TYPE_BYTE;
+    }
+    return type & ESP_GMF_PORT_TYPE_BLOCK;
+}
+
+static inline uint8_t pipeline_link_port_type(esp_gmf_element_handle_t el, esp_gmf_element_handle_t next_el)
+{
+    // The linked elements hand the payload over, the block port is preferred as `esp_gmf_pool_new_pipeline` does
+    uint8_t type = ESP_GMF_ELEMENT_GET(el)->out_attr.port.type & ESP_GMF_ELEMENT_GET(next_el)->in_attr.port.type;
+    if (type & ESP_GMF_PORT_TYPE_BLOCK) {
+        return ESP_GMF_PORT_TYPE_BLOCK;
+    }
+    return type & ESP_GMF_PORT_TYPE_BYTE;
+}
+
+static inline void pipeline_move_tee(esp_gmf_port_handle_t to, esp_gmf_port_handle_t from)
+{
+    esp_gmf_port_set_tee(to, from->tee, from->tee_ctx);
+    esp_gmf_port_set_tee_ready_ops(to, from->tee_ready, from->tee_set_notify);
+    esp_gmf_port_set_tee(from, NULL, NULL);
+    esp_gmf_port_set_tee_ready_ops(from, NULL, NULL);
+}
+
+static inline void pipeline_replace_port(esp_gmf_port_handle_t *head, esp_gmf_port_handle_t old, esp_gmf_port_handle_t new)
+{
+    // Put the new port at the place of the old one, so that the primary port of the element is kept
+    esp_gmf_port_handle_t *pos = head;
+    while (*pos != old) {
+        pos = &(*pos)->next;
+    }
+    new->next = old->next;
+    *pos = new;
+    old->next = NULL;
+    esp_gmf_port_deinit(old);
+}
+
+esp_gmf_err_t esp_gmf_pipeline_split(esp_gmf_pipeline_handle_t pipeline, const char *after_el_name, esp_gmf_task_cfg_t *task_cfg)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, pipeline->head_el, return ESP_GMF_ERR_INVALID_ARG);
+    if ((pipeline->state != ESP_GMF_EVENT_STATE_NONE) && !_is_end_state(pipeline->state)) {
+        ESP_LOGE(TAG, "Can't split the pipeline on %s, [%p]", esp_gmf_event_get_state_str(pipeline->state), pipeline);
+        return ESP_GMF_ERR_INVALID_STATE;
+    }
+    esp_gmf_element_handle_t el = NULL;
+    esp_gmf_err_t ret = ESP_GMF_ERR_OK;
+    if (after_el_name) {
+        ret = esp_gmf_pipeline_get_el_by_name(pipeline, after_el_name, &el);
+        ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "The split element[%s] is not found, [%p]", after_el_name, pipeline);
+    } else {
+        el = pipeline_pick_split_el(pipeline);
+    }
+    esp_gmf_element_handle_t next_el = el ? (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el) : NULL;
+    if (next_el == NULL) {
+        ESP_LOGE(TAG, "No element behind the split point, [%p]", pipeline);
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    for (esp_gmf_pipeline_seg_t *seg = pipeline->segs; seg; seg = seg->next) {
+        if (seg->head_el == next_el) {
+            ESP_LOGE(TAG, "Already split after [%s], [%p]", OBJ_GET_TAG(el), pipeline);
+            return ESP_GMF_ERR_INVALID_STATE;
+        }
+    }
+    esp_gmf_port_handle_t old_out = ESP_GMF_ELEMENT_GET(el)->out;
+    while (old_out && (old_out->reader != next_el)) {
+        old_out = old_out->next;
+    }
+    esp_gmf_port_handle_t old_in = ESP_GMF_ELEMENT_GET(next_el)->in;
+    while (old_in && (old_in->writer != el)) {
+        old_in = old_in->next;
+    }
+    if ((old_out == NULL) || (old_in == NULL)) {
+        ESP_LOGE(TAG, "No link between [%s] and [%s], [%p]", OBJ_GET_TAG(el), OBJ_GET_TAG(next_el), pipeline);
+        return ESP_GMF_ERR_INVALID_STATE;
+    }
+    uint8_t port_type = pipeline_split_port_type(el, next_el);
+    if (port_type == 0) {
+        ESP_LOGE(TAG, "No common port type between [%s] and [%s], [%p]", OBJ_GET_TAG(el), OBJ_GET_TAG(next_el), pipeline);
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+
+    int out_size = ESP_GMF_ELEMENT_GET(el)->out_attr.data_size;
+    int in_size = ESP_GMF_ELEMENT_GET(next_el)->in_attr.data_size;
+    int db_size = out_size > in_size ? out_size : in_size;
+    db_size = db_size > 0 ? db_size : DEFAULT_ESP_GMF_PIPELINE_SPLIT_DB_SIZE;
+    esp_gmf_db_handle_t db = NULL;
+    esp_gmf_task_handle_t task = NULL;
+    esp_gmf_port_handle_t out_port = NULL;
+    esp_gmf_port_handle_t in_port = NULL;
+    esp_gmf_pipeline_seg_t *head_seg = NULL;
+    esp_gmf_pipeline_seg_t *new_seg = NULL;
+    if (port_type == ESP_GMF_PORT_TYPE_BYTE) {
+        ret = esp_gmf_db_new_ringbuf(db_size, DEFAULT_ESP_GMF_PIPELINE_SPLIT_DB_CNT, &db);
+        out_port = NEW_ESP_GMF_PORT_OUT_BYTE(esp_gmf_db_acquire_payload_write, esp_gmf_db_release_payload_write, NULL, db, out_size, ESP_GMF_MAX_DELAY);
+        in_port = NEW_ESP_GMF_PORT_IN_BYTE(esp_gmf_db_acquire_payload_read, esp_gmf_db_release_payload_read, NULL, db, in_size, ESP_GMF_MAX_DELAY);
+    } else {
+        ret = esp_gmf_db_new_block(db_size, DEFAULT_ESP_GMF_PIPELINE_SPLIT_DB_CNT, &db);
+        out_port = NEW_ESP_GMF_PORT_OUT_BLOCK(esp_gmf_db_acquire_payload_write, esp_gmf_db_release_payload_write, NULL, db, out_size, ESP_GMF_MAX_DELAY);
+        in_port = NEW_ESP_GMF_PORT_IN_BLOCK(esp_gmf_db_acquire_payload_read, esp_gmf_db_release_payload_read, NULL, db, in_size, ESP_GMF_MAX_DELAY);
+    }
+    if ((ret != ESP_GMF_ERR_OK) || (db == NULL) || (out_port == NULL) || (in_port == NULL)) {
+        ESP_LOGE(TAG, "Failed to create the split data bus, [%p]", pipeline);
+        ret = ESP_GMF_ERR_MEMORY_LACK;
+        goto _split_fail;
+    }
+    esp_gmf_port_set_ready_ops(out_port, (port_ready)esp_gmf_db_is_ready, (port_set_notify)esp_gmf_db_set_notify);
+    esp_gmf_port_set_ready_ops(in_port, (port_ready)esp_gmf_db_is_ready, (port_set_notify)esp_gmf_db_set_notify);
+
+    new_seg = esp_gmf_oal_calloc(1, sizeof(esp_gmf_pipeline_seg_t));
+    ESP_GMF_MEM_CHECK(TAG, new_seg, {ret = ESP_GMF_ERR_MEMORY_LACK; goto _split_fail;});
+    if (pipeline->segs == NULL) {
+        head_seg = esp_gmf_oal_calloc(1, sizeof(esp_gmf_pipeline_seg_t));
+        ESP_GMF_MEM_CHECK(TAG, head_seg, {ret = ESP_GMF_ERR_MEMORY_LACK; goto _split_fail;});
+        head_seg->head_el = pipeline->head_el;
+    }
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    if (task_cfg) {
+        cfg = *task_cfg;
+    }
+    if (cfg.name == NULL) {
+        cfg.name = OBJ_GET_TAG(next_el);
+    }
+    ret = esp_gmf_task_init(&cfg, &task);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, goto _split_fail, "Failed to create the split task, [%p]", pipeline);
+
+    // Nothing can fail from now on, replace the linked ports by the data bus ports
+    out_port->attr.buf_size_aligned = ESP_GMF_ELEMENT_GET(el)->out_attr.port.buf_size_aligned;
+    out_port->attr.buf_addr_aligned = ESP_GMF_ELEMENT_GET(el)->out_attr.port.buf_addr_aligned;
+    esp_gmf_port_set_writer(out_port, el);
+    pipeline_move_tee(out_port, old_out);
+    pipeline_replace_port(&ESP_GMF_ELEMENT_GET(el)->out, old_out, out_port);
+    in_port->attr.buf_size_aligned = ESP_GMF_ELEMENT_GET(next_el)->in_attr.port.buf_size_aligned;
+    in_port->attr.buf_addr_aligned = ESP_GMF_ELEMENT_GET(next_el)->in_attr.port.buf_addr_aligned;
+    esp_gmf_port_set_reader(in_port, next_el);
+    pipeline_replace_port(&ESP_GMF_ELEMENT_GET(next_el)->in, old_in, in_port);
+
+    new_seg->head_el = next_el;
+    new_seg->thread = task;
+    new_seg->db = db;
+    if (head_seg) {
+        pipeline->segs = head_seg;
+    }
+    esp_gmf_pipeline_seg_t *prev_seg = _get_seg_by_el(pipeline, el);
+    new_seg->next = prev_seg->next;
+    prev_seg->next = new_seg;
+    esp_gmf_task_set_event_func(task, esp_gmf_task_evt, pipeline);
+    ESP_LOGI(TAG, "Split after [%s], p:%p, tsk:%p, db:%p-%s", OBJ_GET_TAG(el), pipeline, task, db,
+             port_type == ESP_GMF_PORT_TYPE_BYTE ? "ringbuf" : "block");
+    return ESP_GMF_ERR_OK;
+
+_split_fail:
+    if (task) {
+        esp_gmf_task_deinit(task);
+    }
+    if (in_port) {
+        esp_gmf_port_deinit(in_port);
+    }
+    if (out_port) {
+        esp_gmf_port_deinit(out_port);
+    }
+    if (db) {
+        esp_gmf_db_deinit(db);
+    }
+    esp_gmf_oal_free(head_seg);
+    esp_gmf_oal_free(new_seg);
+    return ret;
+}
+
+static esp_gmf_err_io_t pipeline_tee_publish_ref(esp_gmf_db_handle_t db, esp_gmf_payload_t *load, int wait_ticks)
+{
+    // The broadcast bus holds a reference on the pooled buffer until the last branch releases it
+    esp_gmf_payload_pool_handle_t pool = load->pool;
+    if (esp_gmf_payload_pool_ref(load) != ESP_GMF_ERR_OK) {
+        return ESP_GMF_IO_FAIL;
+    }
+    esp_gmf_data_bus_block_t blk = {
+        .buf = load->buf,
+        .buf_length = load->buf_length,
+        .valid_size = load->valid_size,
+        .is_last = load->is_done,
+    };
+    esp_gmf_db_meta_t meta = {
+        .trace_us = load->trace_us,
+    };
+    esp_gmf_err_io_t ret = esp_gmf_db_broadcast_write_ref(db, &blk, &meta, (esp_gmf_bcast_ref_free_t)esp_gmf_payload_pool_unref, pool, wait_ticks);
+    if (ret != ESP_GMF_IO_OK) {
+        esp_gmf_payload_pool_unref(pool, blk.buf);
+    }
+    return ret;
+}
+
+static esp_gmf_err_io_t pipeline_tee_release(void *handle, esp_gmf_payload_t *load, int wait_ticks)
+{
+    // The readers of all the branches share the block, a pooled payload is published by reference, the others are copied once
+    esp_gmf_db_handle_t db = (esp_gmf_db_handle_t)handle;
+    if ((load->valid_size > 0) && load->pool) {
+        esp_gmf_err_io_t ret = pipeline_tee_publish_ref(db, load, wait_ticks);
+        if (ret != ESP_GMF_IO_OK) {
+            ESP_LOGW(TAG, "No free block for the branches, drop %d bytes, db:%p, ret:%d", load->valid_size, db, ret);
+        }
+    } else if (load->valid_size > 0) {
+        esp_gmf_payload_t br_load = {0};
+        esp_gmf_err_io_t ret = esp_gmf_db_acquire_payload_write(db, &br_load, load->valid_size, wait_ticks);
+        if (ret < ESP_GMF_IO_OK) {
+            ESP_LOGW(TAG, "No free block for the branches, drop %d bytes, db:%p, ret:%d", load->valid_size, db, ret);
+        } else {
+            memcpy(br_load.buf, load->buf, load->valid_size);
+            br_load.valid_size = load->valid_size;
+            br_load.is_done = load->is_done;
+            br_load.trace_us = load->trace_us;
+            esp_gmf_db_release_payload_write(db, &br_load, wait_ticks);
+        }
+    }
+    if (load->is_done) {
+        // The branches finish even though the last block is dropped
+        esp_gmf_db_done_write(db);
+    }
+    return ESP_GMF_IO_OK;
+}
+
+static esp_gmf_pipeline_seg_t *pipeline_find_split_seg(esp_gmf_pipeline_handle_t pipeline, const char *after_el_name)
+{
+    esp_gmf_element_handle_t el = NULL;
+    if (esp_gmf_pipeline_get_el_by_name(pipeline, after_el_name, &el) != ESP_GMF_ERR_OK) {
+        return NULL;
+    }
+    esp_gmf_element_handle_t next_el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el);
+    for (esp_gmf_pipeline_seg_t *seg = pipeline->segs; seg && next_el; seg = seg->next) {
+        if ((seg->head_el == next_el) && seg->db) {
+            return seg;
+        }
+    }
+    return NULL;
+}
+
+esp_gmf_err_t esp_gmf_pipeline_set_split_drop_policy(esp_gmf_pipeline_handle_t pipeline, const char *after_el_name, esp_gmf_db_drop_policy_t policy)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, after_el_name, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_pipeline_seg_t *seg = pipeline_find_split_seg(pipeline, after_el_name);
+    if (seg == NULL) {
+        ESP_LOGE(TAG, "The pipeline is not split after [%s], [%p]", after_el_name, pipeline);
+        return ESP_GMF_ERR_NOT_FOUND;
+    }
+    return esp_gmf_db_set_drop_policy(seg->db, policy);
+}
+
+esp_gmf_err_t esp_gmf_pipeline_get_split_dropped(esp_gmf_pipeline_handle_t pipeline, const char *after_el_name, uint32_t *dropped_cnt)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, after_el_name, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, dropped_cnt, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_pipeline_seg_t *seg = pipeline_find_split_seg(pipeline, after_el_name);
+    if (seg == NULL) {
+        return ESP_GMF_ERR_NOT_FOUND;
+    }
+    return esp_gmf_db_get_dropped(seg->db, dropped_cnt);
+}
+
+static esp_gmf_err_t pipeline_branch_ready(void *handle, uint8_t dir, uint32_t wanted_size, bool *ready)
+{
+    // The branches are on the same task, so the tee element waits for a free block rather than blocking the task
+    uint32_t available = 0;
+    *ready = (esp_gmf_db_get_available((esp_gmf_db_handle_t)handle, &available) != ESP_GMF_ERR_OK) || (available > 0);
+    return ESP_GMF_ERR_OK;
+}
+
+static inline void pipeline_append_branch(esp_gmf_pipeline_handle_t pipeline, esp_gmf_pipeline_branch_t *new_br)
+{
+    new_br->pipeline->trunk = pipeline;
+    esp_gmf_pipeline_branch_t **pos = &pipeline->branches;
+    while (*pos) {
+        pos = &(*pos)->next;
+    }
+    *pos = new_br;
+}
+
+esp_gmf_err_t esp_gmf_pipeline_add_branch(esp_gmf_pipeline_handle_t pipeline, const char *tee_el_name, esp_gmf_pipeline_handle_t branch)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, tee_el_name, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, branch, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, branch->head_el, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_CHECK(TAG, (branch != pipeline), return ESP_GMF_ERR_INVALID_ARG, "The pipeline can't be a branch of itself");
+    if ((pipeline->state != ESP_GMF_EVENT_STATE_NONE) && !_is_end_state(pipeline->state)) {
+        ESP_LOGE(TAG, "Can't add branch to the pipeline on %s, [%p]", esp_gmf_event_get_state_str(pipeline->state), pipeline);
+        return ESP_GMF_ERR_INVALID_STATE;
+    }
+    if (pipeline->trunk || branch->trunk || branch->branches || branch->segs || branch->thread || branch->in
+        || ESP_GMF_ELEMENT_GET(branch->head_el)->in) {
+        ESP_LOGE(TAG, "The branch must be a pipeline without input, task nor branches, [%p-%p]", pipeline, branch);
+        return ESP_GMF_ERR_INVALID_STATE;
+    }
+    esp_gmf_element_handle_t tee_el = NULL;
+    esp_gmf_err_t ret = esp_gmf_pipeline_get_el_by_name(pipeline, tee_el_name, &tee_el);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "The tee element[%s] is not found, [%p]", tee_el_name, pipeline);
+    esp_gmf_element_t *tee = ESP_GMF_ELEMENT_GET(tee_el);
+    // Each branch takes an own out port of the element supporting multiple out ports, e.g. a channel of the deinterleave
+    bool own_port = (tee->out_attr.cap & ESP_GMF_EL_PORT_CAP_MULTI) && (tee->out_attr.port.type & ESP_GMF_PORT_TYPE_BLOCK);
+    if ((own_port == false) && (tee->out == NULL)) {
+        ESP_LOGE(TAG, "No out port on the tee element[%s], [%p]", OBJ_GET_TAG(tee_el), pipeline);
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+    esp_gmf_element_handle_t head_el = branch->head_el;
+    if ((ESP_GMF_ELEMENT_GET(head_el)->in_attr.port.type & ESP_GMF_PORT_TYPE_BLOCK) == 0) {
+        ESP_LOGE(TAG, "The branch head[%s] doesn't support the block port, [%p]", OBJ_GET_TAG(head_el), pipeline);
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+    esp_gmf_pipeline_branch_t *new_br = esp_gmf_oal_calloc(1, sizeof(esp_gmf_pipeline_branch_t));
+    ESP_GMF_MEM_CHECK(TAG, new_br, return ESP_GMF_ERR_MEMORY_LACK);
+    esp_gmf_port_handle_t in_port = NULL;
+    esp_gmf_port_handle_t out_port = NULL;
+    bool new_writer = false;
+    // All the branches sharing the primary out port of the element read the same bus
+    for (esp_gmf_pipeline_branch_t *br = pipeline->branches; br && (own_port == false); br = br->next) {
+        if ((br->trunk_el == tee_el) && (br->is_join == 0)) {
+            new_br->writer = br->writer;
+            break;
+        }
+    }
+    int out_size = tee->out_attr.data_size > 0 ? tee->out_attr.data_size : DEFAULT_ESP_GMF_PIPELINE_SPLIT_DB_SIZE;
+    if (new_br->writer == NULL) {
+        ret = esp_gmf_db_new_broadcast(DEFAULT_ESP_GMF_PIPELINE_BRANCH_DB_CNT, out_size, &new_br->writer);
+        ESP_GMF_RET_ON_ERROR(TAG, ret, goto _branch_fail, "Failed to create the branch data bus, [%p]", pipeline);
+        new_writer = true;
+    }
+    ret = esp_gmf_db_new_broadcast_reader(new_br->writer, ESP_GMF_BCAST_DROP_NONE, &new_br->reader);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, goto _branch_fail, "Failed to create the branch reader, [%p]", pipeline);
+    in_port = NEW_ESP_GMF_PORT_IN_BLOCK(esp_gmf_db_acquire_payload_read, esp_gmf_db_release_payload_read, NULL, new_br->reader,
+                                        ESP_GMF_ELEMENT_GET(head_el)->in_attr.data_size, ESP_GMF_MAX_DELAY);
+    ESP_GMF_MEM_CHECK(TAG, in_port, {ret = ESP_GMF_ERR_MEMORY_LACK; goto _branch_fail;});
+    esp_gmf_port_set_ready_ops(in_port, (port_ready)esp_gmf_db_is_ready, (port_set_notify)esp_gmf_db_set_notify);
+    if (own_port) {
+        // The writer doesn't block the task, the tee element waits by the readiness of the port instead
+        out_port = NEW_ESP_GMF_PORT_OUT_BLOCK(esp_gmf_db_acquire_payload_write, esp_gmf_db_release_payload_write, NULL, new_br->writer, out_size, 0);
+        ESP_GMF_MEM_CHECK(TAG, out_port, {ret = ESP_GMF_ERR_MEMORY_LACK; goto _branch_fail;});
+        esp_gmf_port_set_ready_ops(out_port, pipeline_branch_ready, (port_set_notify)esp_gmf_db_set_notify);
+        ret = esp_gmf_element_register_out_port(tee_el, out_port);
+        ESP_GMF_RET_ON_ERROR(TAG, ret, goto _branch_fail, "Failed to register the out port of the tee element[%s], [%p]", OBJ_GET_TAG(tee_el), pipeline);
+    }
+    ret = esp_gmf_element_register_in_port(head_el, in_port);
+    if (ret != ESP_GMF_ERR_OK) {
+        ESP_LOGE(TAG, "Failed to register the in port of the branch head[%s], [%p]", OBJ_GET_TAG(head_el), pipeline);
+        if (out_port) {
+            // The port is deleted along
+            esp_gmf_element_unregister_out_port(tee_el, out_port);
+            out_port = NULL;
+        }
+        goto _branch_fail;
+    }
+
+    // Nothing can fail from now on
+    if (new_writer && (own_port == false)) {
+        esp_gmf_port_set_tee(tee->out, pipeline_tee_release, new_br->writer);
+        esp_gmf_port_set_tee_ready_ops(tee->out, pipeline_branch_ready, (port_set_notify)esp_gmf_db_set_notify);
+    }
+    new_br->pipeline = branch;
+    new_br->trunk_el = tee_el;
+    new_br->port = out_port;
+    pipeline_append_branch(pipeline, new_br);
+    ESP_LOGI(TAG, "Add branch after [%s], p:%p, branch:%p, db:%p, port:%p", OBJ_GET_TAG(tee_el), pipeline, branch, new_br->writer, out_port);
+    return ESP_GMF_ERR_OK;
+
+_branch_fail:
+    if (in_port) {
+        esp_gmf_port_deinit(in_port);
+    }
+    if (out_port) {
+        esp_gmf_port_deinit(out_port);
+    }
+    if (new_br->reader) {
+        esp_gmf_db_deinit(new_br->reader);
+    }
+    if (new_writer) {
+        esp_gmf_db_deinit(new_br->writer);
+    }
+    esp_gmf_oal_free(new_br);
+    return ret;
+}
+
+esp_gmf_err_t esp_gmf_pipeline_set_branch_drop_policy(esp_gmf_pipeline_handle_t pipeline, esp_gmf_pipeline_handle_t branch, esp_gmf_db_drop_policy_t policy)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, branch, return ESP_GMF_ERR_INVALID_ARG);
+    if ((policy != ESP_GMF_DB_DROP_NONE) && (policy != ESP_GMF_DB_DROP_OLDEST)) {
+        ESP_LOGE(TAG, "The branches only drop the oldest block, policy:%d, [%p]", policy, pipeline);
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+    for (esp_gmf_pipeline_branch_t *br = pipeline->branches; br; br = br->next) {
+        if ((br->pipeline == branch) && br->reader) {
+            return esp_gmf_db_set_broadcast_reader_policy(br->reader, policy == ESP_GMF_DB_DROP_OLDEST ? ESP_GMF_BCAST_DROP_OLDEST : ESP_GMF_BCAST_DROP_NONE);
+        }
+    }
+    ESP_LOGE(TAG, "The branch is not added to the pipeline, [%p-%p]", pipeline, branch);
+    return ESP_GMF_ERR_NOT_FOUND;
+}
+
+esp_gmf_err_t esp_gmf_pipeline_add_join(esp_gmf_pipeline_handle_t pipeline, const char *join_el_name, esp_gmf_pipeline_handle_t branch)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, join_el_name, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, branch, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, branch->last_el, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_CHECK(TAG, (branch != pipeline), return ESP_GMF_ERR_INVALID_ARG, "The pipeline can't be a branch of itself");
+    if ((pipeline->state != ESP_GMF_EVENT_STATE_NONE) && !_is_end_state(pipeline->state)) {
+        ESP_LOGE(TAG, "Can't join branch to the pipeline on %s, [%p]", esp_gmf_event_get_state_str(pipeline->state), pipeline);
+        return ESP_GMF_ERR_INVALID_STATE;
+    }
+    if (pipeline->trunk || branch->trunk || branch->branches || branch->segs || branch->thread || branch->out
+        || ESP_GMF_ELEMENT_GET(branch->last_el)->out) {
+        ESP_LOGE(TAG, "The joined branch must be a pipeline without output, task nor branches, [%p-%p]", pipeline, branch);
+        return ESP_GMF_ERR_INVALID_STATE;
+    }
+    esp_gmf_element_handle_t join_el = NULL;
+    esp_gmf_err_t ret = esp_gmf_pipeline_get_el_by_name(pipeline, join_el_name, &join_el);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "The join element[%s] is not found, [%p]", join_el_name, pipeline);
+    esp_gmf_element_t *join = ESP_GMF_ELEMENT_GET(join_el);
+    esp_gmf_element_t *last = ESP_GMF_ELEMENT_GET(branch->last_el);
+    if ((join->in_attr.cap & ESP_GMF_EL_PORT_CAP_MULTI) == 0) {
+        ESP_LOGE(TAG, "The join element[%s] doesn't support multiple in ports, [%p]", OBJ_GET_TAG(join_el), pipeline);
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+    // The ring buffer reports the free room to the writer, so that the branch waits for the join element on the same task
+    if ((pipeline_split_port_type(branch->last_el, join_el) & ESP_GMF_PORT_TYPE_BYTE) == 0) {
+        ESP_LOGE(TAG, "No byte port between [%s] and [%s], [%p]", OBJ_GET_TAG(branch->last_el), OBJ_GET_TAG(join_el), pipeline);
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+    int out_size = last->out_attr.data_size;
+    int in_size = join->in_attr.data_size;
+    int db_size = out_size > in_size ? out_size : in_size;
+    db_size = db_size > 0 ? db_size : DEFAULT_ESP_GMF_PIPELINE_SPLIT_DB_SIZE;
+    esp_gmf_pipeline_branch_t *new_br = esp_gmf_oal_calloc(1, sizeof(esp_gmf_pipeline_branch_t));
+    ESP_GMF_MEM_CHECK(TAG, new_br, return ESP_GMF_ERR_MEMORY_LACK);
+    esp_gmf_port_handle_t out_port = NULL;
+    esp_gmf_port_handle_t in_port = NULL;
+    ret = esp_gmf_db_new_ringbuf(db_size, DEFAULT_ESP_GMF_PIPELINE_SPLIT_DB_CNT, &new_br->writer);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, goto _join_fail, "Failed to create the join data bus, [%p]", pipeline);
+    out_port = NEW_ESP_GMF_PORT_OUT_BYTE(esp_gmf_db_acquire_payload_write, esp_gmf_db_release_payload_write, NULL, new_br->writer, out_size, ESP_GMF_MAX_DELAY);
+    in_port = NEW_ESP_GMF_PORT_IN_BYTE(esp_gmf_db_acquire_payload_read, esp_gmf_db_release_payload_read, NULL, new_br->writer, in_size, ESP_GMF_MAX_DELAY);
+    if ((out_port == NULL) || (in_port == NULL)) {
+        ESP_LOGE(TAG, "Failed to create the join ports, [%p]", pipeline);
+        ret = ESP_GMF_ERR_MEMORY_LACK;
+        goto _join_fail;
+    }
+    esp_gmf_port_set_ready_ops(out_port, (port_ready)esp_gmf_db_is_ready, (port_set_notify)esp_gmf_db_set_notify);
+    esp_gmf_port_set_ready_ops(in_port, (port_ready)esp_gmf_db_is_ready, (port_set_notify)esp_gmf_db_set_notify);
+    ret = esp_gmf_element_register_out_port(branch->last_el, out_port);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, goto _join_fail, "Failed to register the out port of the branch tail[%s], [%p]", OBJ_GET_TAG(branch->last_el), pipeline);
+    ret = esp_gmf_element_register_in_port(join_el, in_port);
+    if (ret != ESP_GMF_ERR_OK) {
+        ESP_LOGE(TAG, "Failed to register the in port of the join element[%s], [%p]", OBJ_GET_TAG(join_el), pipeline);
+        // The port is deleted along
+        esp_gmf_element_unregister_out_port(branch->last_el, out_port);
+        out_port = NULL;
+        goto _join_fail;
+    }
+
+    // Nothing can fail from now on
+    new_br->pipeline = branch;
+    new_br->trunk_el = join_el;
+    new_br->port = in_port;
+    new_br->is_join = 1;
+    pipeline_append_branch(pipeline, new_br);
+    ESP_LOGI(TAG, "Join branch to [%s], p:%p, branch:%p, db:%p", OBJ_GET_TAG(join_el), pipeline, branch, new_br->writer);
+    return ESP_GMF_ERR_OK;
+
+_join_fail:
+    if (in_port) {
+        esp_gmf_port_deinit(in_port);
+    }
+    if (out_port) {
+        esp_gmf_port_deinit(out_port);
+    }
+    if (new_br->writer) {
+        esp_gmf_db_deinit(new_br->writer);
+    }
+    esp_gmf_oal_free(new_br);
+    return ret;
+}
+
+static inline bool pipeline_is_seg_head(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t el)
+{
+    for (esp_gmf_pipeline_seg_t *seg = pipeline->segs; seg && el; seg = seg->next) {
+        if (seg->head_el == el) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static esp_gmf_err_t pipeline_claim_splice(esp_gmf_pipeline_handle_t pipeline, esp_gmf_pipeline_splice_t *sp)
+{
+    // The splice is checked and set by the caller, and cleared by the task doing it
+    esp_gmf_err_t ret = ESP_GMF_ERR_OK;
+    esp_gmf_oal_mutex_lock(pipeline->lock);
+    if (pipeline->splice == NULL) {
+        pipeline->splice = sp;
+    } else {
+        ret = ESP_GMF_ERR_INVALID_STATE;
+    }
+    esp_gmf_oal_mutex_unlock(pipeline->lock);
+    ESP_GMF_CHECK(TAG, (ret == ESP_GMF_ERR_OK), return ret, "Another element splice is pending");
+    return ESP_GMF_ERR_OK;
+}
+
+static inline void pipeline_release_splice(esp_gmf_pipeline_handle_t pipeline)
+{
+    esp_gmf_oal_mutex_lock(pipeline->lock);
+    pipeline->splice = NULL;
+    esp_gmf_oal_mutex_unlock(pipeline->lock);
+}
+
+static void pipeline_give_infos(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t el, esp_gmf_element_handle_t prev_el)
+{
+    // Replay the information reported before to the spliced element in the order it is reported in the pipeline:
+    // the one from other pipelines first, then the one of the elements in front of it
+    if (ESP_GMF_ELEMENT_GET_DEPENDENCY(el) == 0) {
+        return;
+    }
+    esp_gmf_oal_mutex_lock(pipeline->lock);
+    esp_gmf_element_handle_t from = NULL;
+    do {
+        for (esp_gmf_pipeline_info_t *info = (esp_gmf_pipeline_info_t *)pipeline->infos; info; info = info->next) {
+            if ((from && (info->from != from)) || ((from == NULL) && pipeline_has_el(pipeline, info->from))) {
+                continue;
+            }
+            esp_gmf_event_pkt_t evt = {
+                .from = info->from,
+                .type = ESP_GMF_EVT_TYPE_REPORT_INFO,
+                .sub = info->sub,
+                .payload = info->data,
+                .payload_size = info->size,
+            };
+            esp_gmf_element_receive_event(el, &evt, pipeline);
+        }
+        from = from ? (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)from) : pipeline->head_el;
+    } while (from && (from != (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)prev_el)));
+    esp_gmf_oal_mutex_unlock(pipeline->lock);
+}
+
+static void pipeline_drop_infos(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t el)
+{
+    esp_gmf_pipeline_info_t **pos = (esp_gmf_pipeline_info_t **)&pipeline->infos;
+    while (*pos) {
+        esp_gmf_pipeline_info_t *info = *pos;
+        if (info->from == el) {
+            *pos = info->next;
+            esp_gmf_oal_free(info);
+        } else {
+            pos = &info->next;
+        }
+    }
+}
+
+static inline void pipeline_forget_payloads(esp_gmf_port_handle_t port)
+{
+    // Nothing is in flight on the frame boundary, drop the references to the payloads of the old links
+    for (; port; port = port->next) {
+        port->payload = NULL;
+        port->ref_port = NULL;
+    }
 }
 
-esp_gmf_err_t esp_gmf_pipeline_create(esp_gmf_pipeline_handle_t *pipeline)
+static inline void pipeline_move_out_port(esp_gmf_port_handle_t port, esp_gmf_element_handle_t writer)
 {
-    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
-    *pipeline = esp_gmf_oal_calloc(1, sizeof(esp_gmf_pipeline_t));
-    ESP_GMF_MEM_CHECK(TAG, *pipeline, return ESP_GMF_ERR_MEMORY_LACK);
-    (*pipeline)->lock = esp_gmf_oal_mutex_create();
-    ESP_GMF_MEM_CHECK(TAG, (*pipeline)->lock, {esp_gmf_oal_free(*pipeline); return ESP_GMF_ERR_MEMORY_LACK;});
-    (*pipeline)->evt_acceptor = pipeline_element_events;
-    (*pipeline)->state = ESP_GMF_EVENT_STATE_NONE;
-    return ESP_GMF_ERR_OK;
+    esp_gmf_element_t *elem = ESP_GMF_ELEMENT_GET(writer);
+    port->attr.buf_size_aligned = elem->out_attr.port.buf_size_aligned;
+    port->attr.buf_addr_aligned = elem->out_attr.port.buf_addr_aligned;
+    port->data_length = elem->out_attr.data_size;
+    esp_gmf_port_set_writer(port, writer);
 }
 
-esp_gmf_err_t esp_gmf_pipeline_destroy(esp_gmf_pipeline_handle_t pipeline)
+static inline void pipeline_relink_next(esp_gmf_element_handle_t next_el, esp_gmf_element_handle_t old_writer,
+                                        esp_gmf_element_handle_t new_writer)
 {
-    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
-    ESP_LOGD(TAG, "Pipeline destroying, %p", pipeline);
-    esp_gmf_oal_mutex_lock(pipeline->lock);
-    if (pipeline->in) {
-        esp_gmf_element_unregister_in_port(pipeline->head_el, NULL);
-        esp_gmf_obj_delete((esp_gmf_obj_handle_t)pipeline->in);
+    if (next_el == NULL) {
+        return;
     }
-    if (pipeline->out) {
-        esp_gmf_element_unregister_out_port(pipeline->last_el, NULL);
-        esp_gmf_obj_delete((esp_gmf_obj_handle_t)pipeline->out);
+    for (esp_gmf_port_t *port = ESP_GMF_ELEMENT_GET(next_el)->in; port; port = port->next) {
+        if (port->writer == old_writer) {
+            esp_gmf_port_set_writer(port, new_writer);
+        }
     }
+}
 
-    esp_gmf_event_item_t *item = pipeline->evt_conveyor;
-    while (item) {
-        esp_gmf_event_item_t *tmp = item->next;
-        esp_gmf_oal_free(item);
-        item = tmp;
+static void pipeline_splice_in(esp_gmf_pipeline_handle_t pipeline, esp_gmf_pipeline_splice_t *sp)
+{
+    esp_gmf_element_t *prev = ESP_GMF_ELEMENT_GET(sp->prev_el);
+    esp_gmf_element_t *elem = ESP_GMF_ELEMENT_GET(sp->el);
+    esp_gmf_element_handle_t next_el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)sp->prev_el);
+    // The inserted element takes over the out ports of the previous one, the tee stays on the primary port of the previous one
+    esp_gmf_port_handle_t old_out = prev->out;
+    if (old_out) {
+        pipeline_move_tee(sp->out_port, old_out);
+        sp->out_port->next = old_out->next;
+        old_out->next = NULL;
+        pipeline_move_out_port(old_out, sp->el);
+        elem->out = old_out;
+    }
+    prev->out = sp->out_port;
+    pipeline_relink_next(next_el, sp->prev_el, sp->el);
+    esp_gmf_node_insert_after((esp_gmf_node_t *)sp->prev_el, (esp_gmf_node_t *)sp->el);
+    if (pipeline->last_el == sp->prev_el) {
+        pipeline->last_el = sp->el;
+    }
+    esp_gmf_element_set_event_func(sp->el, pipeline_element_events, pipeline);
+    if (elem->in_place.enable) {
+        // The in-place plan is made for the whole pipeline on running, let the inserted element write to its own buffer
+        esp_gmf_port_enable_payload_share(sp->in_port, false);
+    }
+    if (pipeline->pld_pool) {
+        esp_gmf_port_set_payload_pool(sp->out_port, pipeline->pld_pool);
+    }
+    pipeline_forget_payloads(elem->out);
+    if (next_el) {
+        pipeline_forget_payloads(ESP_GMF_ELEMENT_GET(next_el)->in);
+        pipeline_forget_payloads(ESP_GMF_ELEMENT_GET(next_el)->out);
     }
-    esp_gmf_node_clear((esp_gmf_node_t **)&pipeline->head_el, (void *)esp_gmf_obj_delete);
-    esp_gmf_oal_mutex_unlock(pipeline->lock);
-    esp_gmf_oal_mutex_destroy(pipeline->lock);
-    esp_gmf_oal_free(pipeline);
-    return ESP_GMF_ERR_OK;
 }
 
-esp_gmf_err_t esp_gmf_pipeline_set_io(esp_gmf_pipeline_handle_t pipeline, esp_gmf_io_handle_t io, int dir)
+static void pipeline_splice_out(esp_gmf_pipeline_handle_t pipeline, esp_gmf_pipeline_splice_t *sp)
 {
-    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
-    if (dir == ESP_GMF_IO_DIR_READER) {
-        pipeline->in = io;
-    } else if (dir == ESP_GMF_IO_DIR_WRITER) {
-        pipeline->out = io;
+    esp_gmf_element_t *prev = ESP_GMF_ELEMENT_GET(sp->prev_el);
+    esp_gmf_element_t *elem = ESP_GMF_ELEMENT_GET(sp->el);
+    esp_gmf_element_handle_t next_el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)sp->el);
+    // The previous element takes the out port of the removed one back, the port linking them is deleted
+    esp_gmf_port_handle_t link_out = prev->out;
+    esp_gmf_port_handle_t moved = elem->out;
+    elem->out = NULL;
+    if (moved) {
+        pipeline_move_tee(moved, link_out);
+        moved->next = link_out->next;
+        pipeline_move_out_port(moved, sp->prev_el);
+        prev->out = moved;
+    } else {
+        prev->out = link_out->next;
     }
-    return ESP_GMF_ERR_OK;
+    link_out->next = NULL;
+    esp_gmf_port_deinit(link_out);
+    esp_gmf_element_unregister_in_port(sp->el, NULL);
+    pipeline_relink_next(next_el, sp->el, sp->prev_el);
+    esp_gmf_node_del_at((esp_gmf_node_t **)&pipeline->head_el, (esp_gmf_node_t *)sp->el);
+    if (pipeline->last_el == sp->el) {
+        pipeline->last_el = sp->prev_el;
+    }
+    pipeline_forget_payloads(prev->out);
+    if (next_el) {
+        pipeline_forget_payloads(ESP_GMF_ELEMENT_GET(next_el)->in);
+        pipeline_forget_payloads(ESP_GMF_ELEMENT_GET(next_el)->out);
+    }
+    pipeline_drop_infos(pipeline, sp->el);
 }
 
-esp_gmf_err_t esp_gmf_pipeline_register_el(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t el)
+static void pipeline_do_splice(esp_gmf_pipeline_handle_t pipeline, esp_gmf_pipeline_splice_t *sp, esp_gmf_task_handle_t tsk, bool live)
 {
-    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
-    esp_gmf_element_set_event_func(el, pipeline_element_events, pipeline);
-    if (pipeline->head_el == NULL) {
-        pipeline->head_el = el;
-        pipeline->last_el = el;
+    uint16_t mask = 0;
+    if (sp->out_port) {
+        pipeline_give_infos(pipeline, sp->el, sp->prev_el);
+        esp_gmf_event_state_t st = ESP_GMF_EVENT_STATE_NONE;
+        esp_gmf_element_get_state(sp->el, &st);
+        if (live && (st != ESP_GMF_EVENT_STATE_INITIALIZED)) {
+            ESP_LOGE(TAG, "The element[%s] is not ready after the information given, drop it, p:%p", OBJ_GET_TAG(sp->el), pipeline);
+            esp_gmf_port_deinit(sp->out_port);
+            esp_gmf_obj_delete(sp->el);
+            goto _splice_done;
+        }
+        esp_gmf_oal_mutex_lock(pipeline->lock);
+        pipeline_splice_in(pipeline, sp);
+        esp_gmf_oal_mutex_unlock(pipeline->lock);
+        // Only the new element opens, the others keep running with their state
+        esp_gmf_element_get_job_mask(sp->prev_el, &mask);
+        if (mask & ESP_GMF_ELEMENT_JOB_PROCESS) {
+            register_working_jobs_to_task(pipeline, sp->el);
+        }
+        ESP_LOGI(TAG, "Insert [%s] after [%s], p:%p, live:%d", OBJ_GET_TAG(sp->el), OBJ_GET_TAG(sp->prev_el), pipeline, live);
     } else {
-        pipeline->last_el = el;
-        esp_gmf_element_link_el(pipeline->head_el, el);
+        esp_gmf_element_get_job_mask(sp->el, &mask);
+        if (tsk && mask) {
+            esp_gmf_task_unregister_jobs(tsk, sp->el);
+        }
+        if (ESP_GMF_ELEMENT_GET(sp->el)->opened) {
+            esp_gmf_element_process_close(sp->el, NULL);
+        }
+        esp_gmf_oal_mutex_lock(pipeline->lock);
+        pipeline_splice_out(pipeline, sp);
+        esp_gmf_oal_mutex_unlock(pipeline->lock);
+        ESP_LOGI(TAG, "Remove [%s] after [%s], p:%p, live:%d", OBJ_GET_TAG(sp->el), OBJ_GET_TAG(sp->prev_el), pipeline, live);
+        esp_gmf_obj_delete(sp->el);
     }
-    return ESP_GMF_ERR_OK;
+_splice_done:
+    esp_gmf_oal_free(sp);
+    pipeline_release_splice(pipeline);
 }
 
-esp_gmf_err_t esp_gmf_pipeline_list_el(esp_gmf_pipeline_handle_t pipeline)
+static esp_gmf_job_err_t pipeline_splice_job(void *ctx, void *para)
 {
-    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
-    esp_gmf_node_t *head = (esp_gmf_node_t *)pipeline->head_el;
-    while (head) {
-        printf("%p-%s, prev:%p-%s, next:%p-%s \r\n", head, OBJ_GET_TAG(head), head->prev, OBJ_GET_TAG(head->prev), head->next, OBJ_GET_TAG(head->next));
-        head = head->next;
+    esp_gmf_pipeline_handle_t pipeline = (esp_gmf_pipeline_handle_t)ctx;
+    esp_gmf_pipeline_splice_t *sp = (esp_gmf_pipeline_splice_t *)pipeline->splice;
+    esp_gmf_task_handle_t tsk = _get_seg_thread(pipeline, _get_seg_by_el(pipeline, sp->prev_el));
+    esp_gmf_event_state_t st = ESP_GMF_EVENT_STATE_NONE;
+    esp_gmf_task_get_state(tsk, &st);
+    bool live = (st == ESP_GMF_EVENT_STATE_RUNNING);
+    // The elements keeping some input need it on the next round, wait for the boundary they have consumed it
+    esp_gmf_element_handle_t next_el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)(sp->out_port ? sp->prev_el : sp->el));
+    bool truncated = ESP_GMF_ELEMENT_GET(sp->prev_el)->truncated || (next_el && ESP_GMF_ELEMENT_GET(next_el)->truncated)
+                     || ((sp->out_port == NULL) && ESP_GMF_ELEMENT_GET(sp->el)->truncated);
+    if (live && truncated && (esp_gmf_task_post_job(tsk, "splice", pipeline_splice_job, pipeline) == ESP_GMF_ERR_OK)) {
+        ESP_LOGD(TAG, "Splice waits for the truncated input, p:%p, [el:%s-%p]", pipeline, OBJ_GET_TAG(sp->el), sp->el);
+        return ESP_GMF_JOB_ERR_OK;
     }
-    return ESP_GMF_ERR_OK;
+    pipeline_do_splice(pipeline, sp, tsk, live);
+    return ESP_GMF_JOB_ERR_OK;
 }
 
-esp_gmf_err_t esp_gmf_pipeline_set_event(esp_gmf_pipeline_handle_t pipeline, esp_gmf_event_cb cb, void *ctx)
+static void pipeline_post_splice(esp_gmf_pipeline_handle_t pipeline, esp_gmf_pipeline_splice_t *sp)
+{
+    // The splice is done by the task running the previous element on the frame boundary, or right now without task
+    esp_gmf_task_handle_t tsk = _get_seg_thread(pipeline, _get_seg_by_el(pipeline, sp->prev_el));
+    if (tsk && (esp_gmf_task_post_job(tsk, "splice", pipeline_splice_job, pipeline) == ESP_GMF_ERR_OK)) {
+        ESP_LOGD(TAG, "Post the splice of [%s] to task:%p, p:%p", OBJ_GET_TAG(sp->el), tsk, pipeline);
+        return;
+    }
+    pipeline_do_splice(pipeline, sp, tsk, false);
+}
+
+esp_gmf_err_t esp_gmf_pipeline_insert_el(esp_gmf_pipeline_handle_t pipeline, const char *after_el_name, esp_gmf_element_handle_t el)
 {
     ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
-    pipeline->user_cb = cb;
-    pipeline->user_ctx = ctx;
+    ESP_GMF_NULL_CHECK(TAG, after_el_name, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, el, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_element_t *elem = ESP_GMF_ELEMENT_GET(el);
+    if (elem->in || elem->out || ((esp_gmf_node_t *)el)->prev || ((esp_gmf_node_t *)el)->next) {
+        ESP_LOGE(TAG, "The element[%s] to insert must have no port nor link, [%p]", OBJ_GET_TAG(el), pipeline);
+        return ESP_GMF_ERR_INVALID_ARG;
+    }
+    esp_gmf_element_handle_t prev_el = NULL;
+    esp_gmf_err_t ret = esp_gmf_pipeline_get_el_by_name(pipeline, after_el_name, &prev_el);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "The element[%s] to insert after is not found, [%p]", after_el_name, pipeline);
+    esp_gmf_element_t *prev = ESP_GMF_ELEMENT_GET(prev_el);
+    uint8_t port_type = pipeline_link_port_type(prev_el, el);
+    if ((port_type == 0) || (prev->out && ((elem->out_attr.port.type & prev->out->attr.type) == 0))) {
+        ESP_LOGE(TAG, "The ports of [%s] and [%s] can't be linked, [%p]", OBJ_GET_TAG(prev_el), OBJ_GET_TAG(el), pipeline);
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+    // The element behind a split point is run by another task, the splice can't relink it on the frame boundary
+    if (pipeline_is_seg_head(pipeline, (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)prev_el))) {
+        ESP_LOGE(TAG, "Can't insert at the split point after [%s], [%p]", OBJ_GET_TAG(prev_el), pipeline);
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+    esp_gmf_pipeline_splice_t *sp = esp_gmf_oal_calloc(1, sizeof(esp_gmf_pipeline_splice_t));
+    ESP_GMF_MEM_CHECK(TAG, sp, return ESP_GMF_ERR_MEMORY_LACK);
+    ret = pipeline_claim_splice(pipeline, sp);
+    if (ret != ESP_GMF_ERR_OK) {
+        esp_gmf_oal_free(sp);
+        return ret;
+    }
+    sp->prev_el = prev_el;
+    sp->el = el;
+    if (port_type == ESP_GMF_PORT_TYPE_BYTE) {
+        sp->out_port = NEW_ESP_GMF_PORT_OUT_BYTE(NULL, NULL, NULL, NULL, prev->out_attr.data_size, ESP_GMF_MAX_DELAY);
+        sp->in_port = NEW_ESP_GMF_PORT_IN_BYTE(NULL, NULL, NULL, NULL, elem->in_attr.data_size, ESP_GMF_MAX_DELAY);
+    } else {
+        sp->out_port = NEW_ESP_GMF_PORT_OUT_BLOCK(NULL, NULL, NULL, NULL, prev->out_attr.data_size, ESP_GMF_MAX_DELAY);
+        sp->in_port = NEW_ESP_GMF_PORT_IN_BLOCK(NULL, NULL, NULL, NULL, elem->in_attr.data_size, ESP_GMF_MAX_DELAY);
+    }
+    ESP_GMF_MEM_CHECK(TAG, sp->out_port, {ret = ESP_GMF_ERR_MEMORY_LACK; goto _insert_fail;});
+    ESP_GMF_MEM_CHECK(TAG, sp->in_port, {ret = ESP_GMF_ERR_MEMORY_LACK; goto _insert_fail;});
+    ret = esp_gmf_element_register_in_port(el, sp->in_port);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, goto _insert_fail, "Failed to register the in port of [%s], [%p]", OBJ_GET_TAG(el), pipeline);
+    esp_gmf_port_set_writer(sp->in_port, prev_el);
+    pipeline_move_out_port(sp->out_port, prev_el);
+    esp_gmf_port_set_reader(sp->out_port, el);
+    pipeline_post_splice(pipeline, sp);
     return ESP_GMF_ERR_OK;
+
+_insert_fail:
+    if (sp->out_port) {
+        esp_gmf_port_deinit(sp->out_port);
+    }
+    if (sp->in_port) {
+        esp_gmf_port_deinit(sp->in_port);
+    }
+    pipeline_release_splice(pipeline);
+    esp_gmf_oal_free(sp);
+    return ret;
 }
 
-esp_gmf_err_t esp_gmf_pipeline_bind_task(esp_gmf_pipeline_handle_t pipeline, esp_gmf_task_handle_t task)
+esp_gmf_err_t esp_gmf_pipeline_remove_el(esp_gmf_pipeline_handle_t pipeline, const char *el_name)
 {
     ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
-    if (task == NULL) {
-        // Allow clear bind task, so that can recreate task and bind
-        pipeline->thread = NULL;
-        return ESP_GMF_ERR_OK;
+    ESP_GMF_NULL_CHECK(TAG, el_name, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_element_handle_t el = NULL;
+    esp_gmf_err_t ret = esp_gmf_pipeline_get_el_by_name(pipeline, el_name, &el);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "The element[%s] to remove is not found, [%p]", el_name, pipeline);
+    esp_gmf_element_handle_t prev_el = (esp_gmf_element_handle_t)esp_gmf_node_for_prev((esp_gmf_node_t *)el);
+    // The element on either side of a split point is linked to another task, the splice can't relink it on the frame boundary
+    bool removable = (prev_el != NULL) && !pipeline_is_seg_head(pipeline, el)
+                     && !pipeline_is_seg_head(pipeline, (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el));
+    for (esp_gmf_pipeline_branch_t *br = pipeline->branches; br && removable; br = br->next) {
+        removable = (br->trunk_el != el);
     }
-    ESP_GMF_NULL_CHECK(TAG, task, return ESP_GMF_ERR_INVALID_ARG);
-    pipeline->thread = task;
-    esp_gmf_task_set_event_func(task, esp_gmf_task_evt, pipeline);
+    if (removable) {
+        // Only the element linked in a row can be removed, the previous element takes the out port of it
+        esp_gmf_element_t *elem = ESP_GMF_ELEMENT_GET(el);
+        esp_gmf_element_t *prev = ESP_GMF_ELEMENT_GET(prev_el);
+        removable = elem->in && (elem->in->next == NULL) && (elem->in->writer == prev_el)
+                    && prev->out && (prev->out->reader == el) && ((elem->out == NULL) || (elem->out->next == NULL))
+                    && ((elem->out == NULL) || (prev->out_attr.port.type & elem->out->attr.type));
+    }
+    if (removable == false) {
+        ESP_LOGE(TAG, "The element[%s] can't be removed, [%p]", el_name, pipeline);
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+    esp_gmf_pipeline_splice_t *sp = esp_gmf_oal_calloc(1, sizeof(esp_gmf_pipeline_splice_t));
+    ESP_GMF_MEM_CHECK(TAG, sp, return ESP_GMF_ERR_MEMORY_LACK);
+    ret = pipeline_claim_splice(pipeline, sp);
+    if (ret != ESP_GMF_ERR_OK) {
+        esp_gmf_oal_free(sp);
+        return ret;
+    }
+    sp->prev_el = prev_el;
+    sp->el = el;
+    pipeline_post_splice(pipeline, sp);
     return ESP_GMF_ERR_OK;
 }
 
@@ -361,6 +1702,11 @@ esp_gmf_err_t esp_gmf_pipeline_loading_jobs(esp_gmf_pipeline_handle_t pipeline)
         }
         node = (esp_gmf_node_t *)el;
     } while ((el = (esp_gmf_element_handle_t)esp_gmf_node_for_next(node)));
+    for (esp_gmf_pipeline_branch_t *br = pipeline->branches; br; br = br->next) {
+        // Run the branch on the task of its tee or join element, which may be a segment task
+        br->pipeline->thread = _get_seg_thread(pipeline, _get_seg_by_el(pipeline, br->trunk_el));
+        esp_gmf_pipeline_loading_jobs(br->pipeline);
+    }
     return ESP_GMF_ERR_OK;
 }
 
@@ -409,6 +1755,17 @@ esp_gmf_err_t esp_gmf_pipeline_reg_event_recipient(esp_gmf_pipeline_handle_t con
     return ESP_GMF_ERR_OK;
 }
 
+static inline void pipeline_port_use_db_ready(esp_gmf_port_handle_t port)
+{
+    // A port on the GMF data bus lets the task wait for the readiness instead of blocking inside the acquire
+    if ((port->ops.ready == NULL) && ((port->ops.acquire == (port_acquire)esp_gmf_db_acquire_read)
+                                      || (port->ops.acquire == (port_acquire)esp_gmf_db_acquire_write)
+                                      || (port->ops.acquire == esp_gmf_db_acquire_payload_read)
+                                      || (port->ops.acquire == esp_gmf_db_acquire_payload_write))) {
+        esp_gmf_port_set_ready_ops(port, (port_ready)esp_gmf_db_is_ready, (port_set_notify)esp_gmf_db_set_notify);
+    }
+}
+
 esp_gmf_err_t esp_gmf_pipeline_connect_pipe(esp_gmf_pipeline_handle_t connector, const char *connector_name, esp_gmf_port_handle_t connector_port,
                                             esp_gmf_pipeline_handle_t connectee, const char *connectee_name, esp_gmf_port_handle_t connectee_port)
 {
@@ -425,6 +1782,7 @@ esp_gmf_err_t esp_gmf_pipeline_connect_pipe(esp_gmf_pipeline_handle_t connector,
 
         ret = esp_gmf_element_register_out_port(connector_el, connector_port);
         ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Register connector out port failed, [%s]", connectee_name);
+        pipeline_port_use_db_ready(connector_port);
     }
     esp_gmf_element_handle_t connectee_el = NULL;
     ret = esp_gmf_pipeline_get_el_by_name(connectee, connectee_name, &connectee_el);
@@ -432,6 +1790,7 @@ esp_gmf_err_t esp_gmf_pipeline_connect_pipe(esp_gmf_pipeline_handle_t connector,
 
     ret = esp_gmf_element_register_in_port(connectee_el, connectee_port);
     ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Register connectee in port failed, [%s]", connectee_name);
+    pipeline_port_use_db_ready(connectee_port);
 
     return esp_gmf_pipeline_reg_event_recipient(connector, connectee);
 }
@@ -482,11 +1841,215 @@ esp_gmf_err_t esp_gmf_pipeline_prev_stop(esp_gmf_pipeline_handle_t pipeline)
     return ESP_GMF_ERR_OK;
 }
 
+static inline bool pipeline_port_is_linked(esp_gmf_port_t *port)
+{
+    // The port between two linked elements passes the payload without any data bus
+    return port->reader && port->writer && (port->ops.acquire == NULL);
+}
+
+static void pipeline_plan_in_place(esp_gmf_pipeline_handle_t pipeline)
+{
+    // The port allocating the buffer read by the current element, and the size the data reaches on it in percent
+    esp_gmf_port_t *owner = NULL;
+    uint64_t scale = 100;
+    bool shared = false;
+    esp_gmf_element_t *prev = NULL;
+    esp_gmf_element_handle_t el = pipeline->head_el;
+    for (; el; el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el)) {
+        esp_gmf_element_t *elem = ESP_GMF_ELEMENT_GET(el);
+        esp_gmf_port_t *in = elem->in;
+        esp_gmf_port_t *out = elem->out;
+        // Drop the headroom of the last plan, the owner of a buffer is never behind the elements using it
+        for (esp_gmf_port_t *port = in; port; port = port->next) {
+            esp_gmf_port_set_headroom(port, 0);
+        }
+        for (esp_gmf_port_t *port = out; port; port = port->next) {
+            esp_gmf_port_set_headroom(port, 0);
+        }
+        if (shared == false) {
+            // A new buffer starts here, allocated by the out port of the previous linked element or by the in port itself
+            owner = (prev && in && (in->writer == prev)) ? prev->out : in;
+            scale = 100;
+        }
+        shared = false;
+        if (elem->in_place.enable && in) {
+            // The buffer can be written over when it is passed along the linked elements or copied by a byte port,
+            // the blocks of a block port belong to its data bus
+            shared = owner && out && (in->next == NULL) && (out->next == NULL)
+                     && (pipeline_port_is_linked(owner) || (owner->attr.type == ESP_GMF_PORT_TYPE_BYTE))
+                     && (pipeline_port_is_linked(out) || (out->attr.type == ESP_GMF_PORT_TYPE_BYTE))
+                     && (owner->attr.buf_addr_aligned >= out->attr.buf_addr_aligned);
+            // The payload published to the branches by the tee is read by them later, it must not be written over
+            shared = shared && !(prev && prev->out && prev->out->tee && (in->writer == prev));
+            if (shared) {
+                scale = scale * (100 + elem->in_place.grow_pct) / 100;
+                scale = scale > (UINT16_MAX + 100) ? (UINT16_MAX + 100) : scale;
+                esp_gmf_port_set_headroom(owner, (uint16_t)(scale - 100));
+            }
+            esp_gmf_port_enable_payload_share(in, shared);
+            ESP_LOGD(TAG, "Plan in place for [%p-%s], %s, owner:%p, headroom:%d%%", el, OBJ_GET_TAG(el),
+                     shared ? "granted" : "denied", owner, owner ? owner->headroom_pct : 0);
+        }
+        prev = elem;
+    }
+}
+
+typedef struct {
+    esp_gmf_port_t *owner;  /*!< Port owning the payload */
+    uint32_t        size;   /*!< Largest size wanted on the payload by the ports using it */
+} pipeline_pool_need_t;
+
+static void pipeline_pool_add_need(pipeline_pool_need_t *needs, uint16_t *cnt, esp_gmf_port_t *owner, esp_gmf_port_t *user, uint32_t size)
+{
+    if ((owner == NULL) || (size == 0)) {
+        return;
+    }
+    // The port reserves its headroom on the payload it uses, see `esp_gmf_port_reserve_buf`
+    size += (uint32_t)((uint64_t)size * user->headroom_pct / 100);
+    for (int i = 0; i < *cnt; i++) {
+        if (needs[i].owner == owner) {
+            needs[i].size = size > needs[i].size ? size : needs[i].size;
+            return;
+        }
+    }
+    needs[*cnt].owner = owner;
+    needs[*cnt].size = size;
+    (*cnt)++;
+}
+
+static uint16_t pipeline_pool_collect_needs(esp_gmf_pipeline_handle_t pipeline, pipeline_pool_need_t *needs)
+{
+    // Follow the payload hand-over of the ports to find the payloads which get a buffer and the sizes used on them:
+    // a linked in port takes the payload of the previous out port, a shared in payload is taken over by the out port
+    // of the next element, and an in-place element writes its output into its in payload
+    uint16_t cnt = 0;
+    esp_gmf_port_t *prev_out = NULL;
+    esp_gmf_port_t *adopt = NULL;
+    esp_gmf_element_handle_t el = pipeline->head_el;
+    for (; el; el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el)) {
+        esp_gmf_element_t *elem = ESP_GMF_ELEMENT_GET(el);
+        esp_gmf_port_t *in_owner = NULL;
+        esp_gmf_port_t *out_owner = NULL;
+        for (esp_gmf_port_t *port = elem->in; port; port = port->next) {
+            esp_gmf_port_t *owner = port->writer ? NULL : (port->attr.type == ESP_GMF_PORT_TYPE_BYTE ? port : NULL);
+            pipeline_pool_add_need(needs, &cnt, owner, port, elem->in_attr.data_size);
+            if (port == elem->in) {
+                in_owner = port->writer ? prev_out : owner;
+            }
+        }
+        bool in_place = elem->in_place.enable && elem->in && elem->in->is_shared;
+        for (esp_gmf_port_t *port = elem->out; port; port = port->next) {
+            esp_gmf_port_t *owner = port;
+            if (port == elem->out) {
+                owner = in_place ? in_owner : ((adopt && (port->ops.acquire == NULL)) ? adopt : port);
+                out_owner = owner;
+            }
+            if (port->reader || (port->attr.type == ESP_GMF_PORT_TYPE_BYTE)) {
+                pipeline_pool_add_need(needs, &cnt, owner, port, elem->out_attr.data_size);
+            }
+        }
+        adopt = NULL;
+        if (in_owner && !in_place && elem->in->is_shared && (elem->in->writer || (elem->in->attr.type != ESP_GMF_PORT_TYPE_BLOCK))) {
+            adopt = in_owner;
+        }
+        prev_out = out_owner;
+    }
+    return cnt;
+}
+
+static esp_gmf_err_t pipeline_setup_payload_pool(esp_gmf_pipeline_handle_t pipeline)
+{
+    uint16_t port_cnt = 0;
+    uint16_t extra_cnt = 0;
+    uint8_t align = 1;
+    esp_gmf_element_handle_t el = pipeline->head_el;
+    for (; el; el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el)) {
+        esp_gmf_port_t *out = ESP_GMF_ELEMENT_GET(el)->out;
+        if (out && (out->tee == pipeline_tee_release)) {
+            // The broadcast bus holds the buffers published to the branches by reference, the trunk takes others meanwhile
+            extra_cnt += DEFAULT_ESP_GMF_PIPELINE_BRANCH_DB_CNT;
+        }
+        for (esp_gmf_port_t *port = ESP_GMF_ELEMENT_GET(el)->in; port; port = port->next) {
+            port_cnt++;
+            align = port->attr.buf_addr_aligned > align ? port->attr.buf_addr_aligned : align;
+        }
+        for (esp_gmf_port_t *port = ESP_GMF_ELEMENT_GET(el)->out; port; port = port->next) {
+            port_cnt++;
+            align = port->attr.buf_addr_aligned > align ? port->attr.buf_addr_aligned : align;
+        }
+    }
+    if (port_cnt == 0) {
+        ESP_LOGW(TAG, "No port on the elements, run without payload pool, p:%p", pipeline);
+        return ESP_GMF_ERR_OK;
+    }
+    pipeline_pool_need_t *needs = esp_gmf_oal_calloc(port_cnt, sizeof(pipeline_pool_need_t));
+    uint32_t *sizes = esp_gmf_oal_calloc(port_cnt + extra_cnt, sizeof(uint32_t));
+    esp_gmf_payload_pool_handle_t pool = NULL;
+    esp_gmf_err_t ret = ESP_GMF_ERR_MEMORY_LACK;
+    uint16_t buf_cnt = 0;
+    ESP_GMF_MEM_CHECK(TAG, needs && sizes, goto _pool_exit);
+    // The in-place plan is made before, so the buffers also have room for the data grown in place
+    buf_cnt = pipeline_pool_collect_needs(pipeline, needs);
+    if (buf_cnt == 0) {
+        ESP_LOGW(TAG, "No data size declared by the elements, run without payload pool, p:%p", pipeline);
+        ret = ESP_GMF_ERR_OK;
+        goto _pool_exit;
+    }
+    uint32_t max_size = 0;
+    for (int i = 0; i < buf_cnt; i++) {
+        sizes[i] = needs[i].size;
+        max_size = sizes[i] > max_size ? sizes[i] : max_size;
+        ESP_LOGD(TAG, "Pooled buffer %d for port:%p, size:%ld", i, needs[i].owner, sizes[i]);
+    }
+    for (int i = 0; i < extra_cnt; i++) {
+        sizes[buf_cnt++] = max_size;
+    }
+    ret = esp_gmf_payload_pool_create_with_sizes(sizes, buf_cnt, align, &pool);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, goto _pool_exit, "Fail to create payload pool for %p, cnt:%d", pipeline, buf_cnt);
+    for (el = pipeline->head_el; el; el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el)) {
+        for (esp_gmf_port_t *port = ESP_GMF_ELEMENT_GET(el)->in; port; port = port->next) {
+            esp_gmf_port_set_payload_pool(port, pool);
+        }
+        for (esp_gmf_port_t *port = ESP_GMF_ELEMENT_GET(el)->out; port; port = port->next) {
+            esp_gmf_port_set_payload_pool(port, pool);
+        }
+    }
+    pipeline->pld_pool = pool;
+_pool_exit:
+    esp_gmf_oal_free(needs);
+    esp_gmf_oal_free(sizes);
+    return ret;
+}
+
 esp_gmf_err_t esp_gmf_pipeline_run(esp_gmf_pipeline_handle_t pipeline)
 {
     ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
     esp_gmf_err_t ret = esp_gmf_pipeline_prev_run(pipeline);
     ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Fail to prev run for %p", pipeline);
+    pipeline_plan_in_place(pipeline);
+    if (pipeline->pld_pool_en && (pipeline->pld_pool == NULL)) {
+        ret = pipeline_setup_payload_pool(pipeline);
+        ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Fail to set up payload pool for %p", pipeline);
+    }
+    for (esp_gmf_pipeline_branch_t *br = pipeline->branches; br; br = br->next) {
+        pipeline_plan_in_place(br->pipeline);
+        if (br->pipeline->pld_pool_en && (br->pipeline->pld_pool == NULL)) {
+            ret = pipeline_setup_payload_pool(br->pipeline);
+            ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Fail to set up payload pool for branch %p of %p", br->pipeline, pipeline);
+        }
+    }
+    if (pipeline->segs == NULL) {
+        return esp_gmf_task_run(pipeline->thread);
+    }
+    pipeline->seg_stopping = 0;
+    for (esp_gmf_pipeline_seg_t *seg = pipeline->segs; seg; seg = seg->next) {
+        seg->state = ESP_GMF_EVENT_STATE_NONE;
+    }
+    // Start the segments from the tail, so that the data from the head is consumed once it is produced
+    for (esp_gmf_pipeline_seg_t *seg = pipeline->segs->next; seg; seg = seg->next) {
+        ret = esp_gmf_task_run(seg->thread);
+        ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Fail to run segment %p-%s for %p", seg, OBJ_GET_TAG(seg->head_el), pipeline);
+    }
     return esp_gmf_task_run(pipeline->thread);
 }
 
@@ -497,7 +2060,22 @@ esp_gmf_err_t esp_gmf_pipeline_stop(esp_gmf_pipeline_handle_t pipeline)
     ESP_LOGD(TAG, "Pipeline going to stop, %p", pipeline);
     ret = esp_gmf_pipeline_prev_stop(pipeline);
     ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Fail to prev stop for %p", pipeline);
-    ret = esp_gmf_task_stop(pipeline->thread);
+    if (pipeline->segs == NULL) {
+        return esp_gmf_task_stop(pipeline->thread);
+    }
+    pipeline->seg_stopping = 1;
+    // Stop from the head, the next segment keeps on reading until the previous one is stopped,
+    // then mark the data bus done in case the next segment is blocked on it
+    for (esp_gmf_pipeline_seg_t *seg = pipeline->segs; seg; seg = seg->next) {
+        esp_gmf_err_t seg_ret = esp_gmf_task_stop(_get_seg_thread(pipeline, seg));
+        if (seg_ret != ESP_GMF_ERR_OK) {
+            ESP_LOGE(TAG, "Fail to stop segment %p-%s for %p, ret:%d", seg, OBJ_GET_TAG(seg->head_el), pipeline, seg_ret);
+            ret = seg_ret;
+        }
+        if (seg->next) {
+            esp_gmf_db_done_write(seg->next->db);
+        }
+    }
     return ret;
 }
 
@@ -506,6 +2084,11 @@ esp_gmf_err_t esp_gmf_pipeline_pause(esp_gmf_pipeline_handle_t pipeline)
     ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
     int ret = ESP_GMF_ERR_OK;
     ret = esp_gmf_task_pause(pipeline->thread);
+    for (esp_gmf_pipeline_seg_t *seg = pipeline->segs; seg && (ret == ESP_GMF_ERR_OK); seg = seg->next) {
+        if (seg->thread) {
+            ret = esp_gmf_task_pause(seg->thread);
+        }
+    }
     return ret;
 }
 
@@ -513,22 +2096,28 @@ esp_gmf_err_t esp_gmf_pipeline_resume(esp_gmf_pipeline_handle_t pipeline)
 {
     ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
     int ret = ESP_GMF_ERR_OK;
-    ret = esp_gmf_task_resume(pipeline->thread);
+    for (esp_gmf_pipeline_seg_t *seg = pipeline->segs; seg && (ret == ESP_GMF_ERR_OK); seg = seg->next) {
+        if (seg->thread) {
+            ret = esp_gmf_task_resume(seg->thread);
+        }
+    }
+    if (ret == ESP_GMF_ERR_OK) {
+        ret = esp_gmf_task_resume(pipeline->thread);
+    }
     return ret;
 }
 
-esp_gmf_err_t esp_gmf_pipeline_reset(esp_gmf_pipeline_handle_t pipeline)
+static void pipeline_reset_els(esp_gmf_pipeline_handle_t pipeline)
 {
-    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
-    int ret = ESP_GMF_ERR_OK;
-    pipeline->state = ESP_GMF_EVENT_STATE_NONE;
-    ret = esp_gmf_task_reset(pipeline->thread);
     if (pipeline->in) {
         esp_gmf_io_reset(pipeline->in);
     }
     if (pipeline->out) {
         esp_gmf_io_reset(pipeline->out);
     }
+    if (pipeline->warm_restart == 0) {
+        pipeline_close_kept_els(pipeline);
+    }
     esp_gmf_element_handle_t next_el = pipeline->head_el;
     do {
         esp_gmf_element_reset_state(next_el);
@@ -536,9 +2125,54 @@ esp_gmf_err_t esp_gmf_pipeline_reset(esp_gmf_pipeline_handle_t pipeline)
         esp_gmf_element_set_job_mask(next_el, 0);
         ESP_LOGD(TAG, "Pipeline reset, %p, %p-%s", pipeline, next_el, OBJ_GET_TAG(next_el));
     } while ((next_el = (esp_gmf_element_handle_t)esp_gmf_node_for_next(next_el)));
+}
+
+esp_gmf_err_t esp_gmf_pipeline_reset(esp_gmf_pipeline_handle_t pipeline)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    int ret = ESP_GMF_ERR_OK;
+    pipeline->state = ESP_GMF_EVENT_STATE_NONE;
+    ret = esp_gmf_task_reset(pipeline->thread);
+    pipeline->seg_stopping = 0;
+    for (esp_gmf_pipeline_seg_t *seg = pipeline->segs; seg; seg = seg->next) {
+        seg->state = ESP_GMF_EVENT_STATE_NONE;
+        if (seg->thread) {
+            esp_gmf_task_reset(seg->thread);
+        }
+        if (seg->db) {
+            esp_gmf_db_reset(seg->db);
+        }
+    }
+    pipeline_reset_els(pipeline);
+    // The branches share the tasks of the pipeline, only their buses and elements are reset
+    for (esp_gmf_pipeline_branch_t *br = pipeline->branches; br; br = br->next) {
+        br->pipeline->state = ESP_GMF_EVENT_STATE_NONE;
+        esp_gmf_db_reset(br->writer);
+        if (br->reader) {
+            esp_gmf_db_reset(br->reader);
+        }
+        pipeline_reset_els(br->pipeline);
+    }
     return ret;
 }
 
+esp_gmf_err_t esp_gmf_pipeline_set_warm_restart(esp_gmf_pipeline_handle_t pipeline, bool enable)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    pipeline->warm_restart = enable;
+    ESP_LOGD(TAG, "Set warm restart:%d, %p", enable, pipeline);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_pipeline_enable_payload_pool(esp_gmf_pipeline_handle_t pipeline, bool enable)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_CHECK(TAG, (pipeline->pld_pool == NULL), return ESP_GMF_ERR_INVALID_STATE, "The payload pool is already created");
+    pipeline->pld_pool_en = enable;
+    ESP_LOGD(TAG, "Set payload pool:%d, %p", enable, pipeline);
+    return ESP_GMF_ERR_OK;
+}
+
 esp_gmf_err_t esp_gmf_pipeline_seek(esp_gmf_pipeline_handle_t pipeline, uint64_t pos)
 {
     ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
@@ -554,6 +2188,14 @@ esp_gmf_err_t esp_gmf_pipeline_seek(esp_gmf_pipeline_handle_t pipeline, uint64_t
     }
     int ret = ESP_GMF_ERR_OK;
     ret = esp_gmf_io_seek(pipeline->in, pos);
+    if ((ret == ESP_GMF_ERR_OK) && (pipeline->state == ESP_GMF_EVENT_STATE_PAUSED)) {
+        // Drop the data queued between the segments, it belongs to the previous position
+        for (esp_gmf_pipeline_seg_t *seg = pipeline->segs; seg; seg = seg->next) {
+            if (seg->db) {
+                esp_gmf_db_reset(seg->db);
+            }
+        }
+    }
     ESP_LOGD(TAG, "Seek to %lld, ret:%d", pos, ret);
     return ret;
 }
@@ -647,10 +2289,11 @@ esp_gmf_err_t esp_gmf_pipeline_get_el_by_name(esp_gmf_pipeline_handle_t pipeline
     ESP_GMF_NULL_CHECK(TAG, tag, return ESP_GMF_ERR_INVALID_ARG);
     ESP_GMF_NULL_CHECK(TAG, out_handle, return ESP_GMF_ERR_INVALID_ARG);
 
+    uint32_t hash = esp_gmf_obj_tag_hash(tag);
     esp_gmf_node_t *node = (esp_gmf_node_t *)pipeline->head_el;
     esp_gmf_element_handle_t next_el = node;
     do {
-        if (strncasecmp(tag, OBJ_GET_TAG(next_el), ESP_GMF_TAG_MAX_LEN) == 0) {
+        if (esp_gmf_obj_tag_match(next_el, tag, hash)) {
             ESP_LOGD(TAG, "Find EL %s-%p", OBJ_GET_TAG(next_el), next_el);
             *out_handle = next_el;
             return ESP_GMF_ERR_OK;
@@ -698,6 +2341,119 @@ esp_gmf_err_t esp_gmf_pipeline_report_info(esp_gmf_pipeline_handle_t pipeline, e
     return el->event_func(&evt, el->ctx);
 }
 
+esp_gmf_err_t esp_gmf_pipeline_get_job_stats(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t el, esp_gmf_job_stats_t *stats)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, el, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, stats, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_CHECK(TAG, pipeline_has_el(pipeline, el), return ESP_GMF_ERR_NOT_FOUND, "The element is not in the pipeline");
+    return pipeline_el_job_stats(pipeline, el, stats);
+}
+
+esp_gmf_err_t esp_gmf_pipeline_show_job_stats(esp_gmf_pipeline_handle_t pipeline)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_job_stats_t stats;
+    uint64_t total_cost = 0;
+    uint64_t hot_cost = 0;
+    esp_gmf_element_handle_t hot_el = NULL;
+    esp_gmf_element_handle_t el = pipeline->head_el;
+    for (; el; el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el)) {
+        esp_gmf_err_t ret = pipeline_el_job_stats(pipeline, el, &stats);
+        ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Failed to get the job stats of %p-%s", el, OBJ_GET_TAG(el));
+        uint64_t cost = stats.total_us - stats.blocked_us;
+        total_cost += cost;
+        if (cost > hot_cost) {
+            hot_cost = cost;
+            hot_el = el;
+        }
+    }
+    ESP_LOGI(TAG, "SHOW PIPELINE JOB STATS, [%p]:", pipeline);
+    for (el = pipeline->head_el; el; el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el)) {
+        pipeline_el_job_stats(pipeline, el, &stats);
+        uint64_t cost = stats.total_us - stats.blocked_us;
+        ESP_LOGI(TAG, "The EL, [%p-%s], calls:%" PRIu32 ", cpu:%" PRIu64 "us(%d%%), blocked:%" PRIu64 "us, "
+                 "min/p50/p90/p99/max:%" PRIu32 "/%" PRIu32 "/%" PRIu32 "/%" PRIu32 "/%" PRIu32 "us, in:%" PRIu64 ", out:%" PRIu64,
+                 el, OBJ_GET_TAG(el), stats.call_cnt, cost, total_cost ? (int)(cost * 100 / total_cost) : 0, stats.blocked_us,
+                 stats.min_us, stats.p50_us, stats.p90_us, stats.p99_us, stats.max_us, stats.bytes_in, stats.bytes_out);
+    }
+    if (hot_el) {
+        ESP_LOGI(TAG, "The hottest EL, [%p-%s]", hot_el, OBJ_GET_TAG(hot_el));
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_pipeline_set_el_deadline(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t el,
+                                               uint32_t period_us, uint32_t deadline_us)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, el, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_CHECK(TAG, pipeline_has_el(pipeline, el), return ESP_GMF_ERR_NOT_FOUND, "The element is not in the pipeline");
+    esp_gmf_pipeline_seg_t *seg = _get_seg_by_el(pipeline, el);
+    esp_gmf_task_handle_t tsk = _get_seg_thread(pipeline, seg);
+    ESP_GMF_CHECK(TAG, tsk, return ESP_GMF_ERR_INVALID_STATE, "No task for pipeline");
+    return esp_gmf_task_set_job_deadline(tsk, el, period_us, deadline_us);
+}
+
+esp_gmf_err_t esp_gmf_pipeline_get_latency_stats(esp_gmf_pipeline_handle_t pipeline, esp_gmf_element_handle_t el, esp_gmf_latency_stats_t *stats)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, stats, return ESP_GMF_ERR_INVALID_ARG);
+    if (el == NULL) {
+        ESP_GMF_CHECK(TAG, pipeline->last_el, return ESP_GMF_ERR_NOT_FOUND, "The pipeline has no element");
+        return esp_gmf_element_get_latency_stats(pipeline->last_el, true, stats);
+    }
+    ESP_GMF_CHECK(TAG, pipeline_has_el(pipeline, el), return ESP_GMF_ERR_NOT_FOUND, "The element is not in the pipeline");
+    return esp_gmf_element_get_latency_stats(el, false, stats);
+}
+
+esp_gmf_err_t esp_gmf_pipeline_show_latency_stats(esp_gmf_pipeline_handle_t pipeline)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_latency_stats_t stats;
+    ESP_LOGI(TAG, "SHOW PIPELINE LATENCY STATS, [%p]:", pipeline);
+    esp_gmf_element_handle_t el = pipeline->head_el;
+    for (; el; el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el)) {
+        esp_gmf_err_t ret = esp_gmf_element_get_latency_stats(el, false, &stats);
+        ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Failed to get the latency stats of %p-%s", el, OBJ_GET_TAG(el));
+        ESP_LOGI(TAG, "The EL, [%p-%s], outputs:%" PRIu32 ", min/avg/p50/p90/p99/max:%" PRIu32 "/%" PRIu32 "/%" PRIu32 "/%" PRIu32 "/%" PRIu32 "/%" PRIu32 "us",
+                 el, OBJ_GET_TAG(el), stats.cnt, stats.min_us, stats.avg_us, stats.p50_us, stats.p90_us, stats.p99_us, stats.max_us);
+    }
+    if (pipeline->last_el && (esp_gmf_element_get_latency_stats(pipeline->last_el, true, &stats) == ESP_GMF_ERR_OK)) {
+        ESP_LOGI(TAG, "End to end, outputs:%" PRIu32 ", min/avg/p50/p90/p99/max:%" PRIu32 "/%" PRIu32 "/%" PRIu32 "/%" PRIu32 "/%" PRIu32 "/%" PRIu32 "us",
+                 stats.cnt, stats.min_us, stats.avg_us, stats.p50_us, stats.p90_us, stats.p99_us, stats.max_us);
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_pipeline_reset_latency_stats(esp_gmf_pipeline_handle_t pipeline)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_element_handle_t el = pipeline->head_el;
+    for (; el; el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el)) {
+        esp_gmf_err_t ret = esp_gmf_element_reset_latency_stats(el);
+        ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Failed to reset the latency stats of %p-%s", el, OBJ_GET_TAG(el));
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_pipeline_show_in_place_plan(esp_gmf_pipeline_handle_t pipeline)
+{
+    ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_LOGI(TAG, "IN-PLACE PLAN OF PIPELINE %p:", pipeline);
+    esp_gmf_element_handle_t el = pipeline->head_el;
+    for (; el; el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el)) {
+        esp_gmf_element_t *elem = ESP_GMF_ELEMENT_GET(el);
+        const char *state = "no";
+        if (elem->in_place.enable) {
+            state = (elem->in && elem->in->is_shared) ? "granted" : "denied";
+        }
+        ESP_LOGI(TAG, "The EL, [%p-%s], in-place:%s, grow:%d%%, headroom[in:%d%%, out:%d%%]", el, OBJ_GET_TAG(el), state,
+                 elem->in_place.grow_pct, elem->in ? elem->in->headroom_pct : 0, elem->out ? elem->out->headroom_pct : 0);
+    }
+    return ESP_GMF_ERR_OK;
+}
+
 esp_gmf_err_t esp_gmf_pipeline_show(esp_gmf_pipeline_handle_t pipeline)
 {
     ESP_GMF_NULL_CHECK(TAG, pipeline, return ESP_GMF_ERR_INVALID_ARG);
@@ -19,31 +19,48 @@
 
 static const char *TAG = "ESP_GMF_POOL";
 
+/* Number of buckets of the tag index, a power of 2 */
+#define ESP_GMF_POOL_INDEX_SIZE  (16)
+#define ESP_GMF_POOL_INDEX_OF(hash)  ((hash) & (ESP_GMF_POOL_INDEX_SIZE - 1))
+
 typedef struct gmp_pool_io_item {
     STAILQ_ENTRY(gmp_pool_io_item)  next;
+    struct gmp_pool_io_item        *hash_next;
     esp_gmf_io_handle_t             instance;
 } esp_gmf_io_item_t;
 typedef STAILQ_HEAD(gmp_io_list, gmp_pool_io_item) gmp_io_list_t;
 
 typedef struct esp_gmf_element_item {
     STAILQ_ENTRY(esp_gmf_element_item)  next;
+    struct esp_gmf_element_item        *hash_next;
     esp_gmf_element_handle_t            instance;
 } esp_gmf_element_item_t;
 typedef STAILQ_HEAD(esp_gmf_element_list, esp_gmf_element_item) esp_gmf_element_list_t;
 
 struct esp_gmf_pool {
-    esp_gmf_element_list_t  el_list;
-    gmp_io_list_t           io_list;
+    esp_gmf_element_list_t   el_list;
+    gmp_io_list_t            io_list;
+    esp_gmf_element_item_t  *el_index[ESP_GMF_POOL_INDEX_SIZE];  // Elements chained by the hash of the tag, in the lookup order
+    esp_gmf_io_item_t       *io_index[ESP_GMF_POOL_INDEX_SIZE];  // IOs chained by the hash of the tag, in the lookup order
 } esp_gmf_pool_t;
 
+static inline void __index_element_item(esp_gmf_pool_handle_t handle, esp_gmf_element_item_t *item, bool at_head)
+{
+    esp_gmf_element_item_t **slot = &handle->el_index[ESP_GMF_POOL_INDEX_OF(((esp_gmf_obj_t *)item->instance)->tag_hash)];
+    while (!at_head && *slot) {
+        slot = &(*slot)->hash_next;
+    }
+    item->hash_next = *slot;
+    *slot = item;
+}
+
 static inline esp_gmf_element_item_t *__get_element_item_by_tag(esp_gmf_pool_handle_t handle, const char *tag)
 {
-    esp_gmf_element_item_t *item, *tmp;
-    STAILQ_FOREACH_SAFE(item, &handle->el_list, next, tmp) {
-        char *el_tag = (char *)"NULL";
-        esp_gmf_obj_get_tag((esp_gmf_obj_handle_t)item->instance, &el_tag);
-        ESP_LOGD(TAG, "Get EL items:%p-%s", item->instance, el_tag);
-        if (el_tag && strcasecmp(el_tag, tag) == 0) {
+    uint32_t hash = esp_gmf_obj_tag_hash(tag);
+    esp_gmf_element_item_t *item = handle->el_index[ESP_GMF_POOL_INDEX_OF(hash)];
+    for (; item; item = item->hash_next) {
+        ESP_LOGD(TAG, "Get EL items:%p-%s", item->instance, OBJ_GET_TAG(item->instance));
+        if (esp_gmf_obj_tag_match(item->instance, tag, hash)) {
             return item;
         }
     }
@@ -52,12 +69,11 @@ static inline esp_gmf_element_item_t *__get_element_item_by_tag(esp_gmf_pool_han
 
 static inline esp_gmf_io_item_t *_get_io_item_by_tag(esp_gmf_pool_handle_t handle, const char *tag, esp_gmf_io_dir_t dir)
 {
-    esp_gmf_io_item_t *item, *tmp;
-    STAILQ_FOREACH_SAFE(item, &handle->io_list, next, tmp) {
-        char *io_tag = (char *)"NULL";
-        esp_gmf_obj_get_tag((esp_gmf_obj_handle_t)item->instance, &io_tag);
-        ESP_LOGD(TAG, "Get IO items: %p-%s, dir:%d", item->instance, io_tag, ((esp_gmf_io_t *)item->instance)->dir);
-        if (io_tag && (strcasecmp(io_tag, tag) == 0) && (((esp_gmf_io_t *)item->instance)->dir == dir)) {
+    uint32_t hash = esp_gmf_obj_tag_hash(tag);
+    esp_gmf_io_item_t *item = handle->io_index[ESP_GMF_POOL_INDEX_OF(hash)];
+    for (; item; item = item->hash_next) {
+        ESP_LOGD(TAG, "Get IO items: %p-%s, dir:%d", item->instance, OBJ_GET_TAG(item->instance), ((esp_gmf_io_t *)item->instance)->dir);
+        if (esp_gmf_obj_tag_match(item->instance, tag, hash) && (((esp_gmf_io_t *)item->instance)->dir == dir)) {
             return item;
         }
     }
@@ -109,6 +125,7 @@ esp_gmf_err_t esp_gmf_pool_register_element(esp_gmf_pool_handle_t handle, esp_gm
     }
     el_item->instance = el;
     STAILQ_INSERT_TAIL(&handle->el_list, el_item, next);
+    __index_element_item(handle, el_item, false);
     ESP_LOGD(TAG, "REG el:[%p-%s], item:%p", el, OBJ_GET_TAG(el), el_item);
     return ESP_GMF_ERR_OK;
 }
@@ -125,6 +142,7 @@ esp_gmf_err_t esp_gmf_pool_register_element_at_head(esp_gmf_pool_handle_t handle
     }
     el_item->instance = el;
     STAILQ_INSERT_HEAD(&handle->el_list, el_item, next);
+    __index_element_item(handle, el_item, true);
     ESP_LOGD(TAG, "REG at head el:[%p-%s], item:%p", el, OBJ_GET_TAG(el), el_item);
     return ESP_GMF_ERR_OK;
 }
@@ -141,6 +159,11 @@ esp_gmf_err_t esp_gmf_pool_register_io(esp_gmf_pool_handle_t handle, esp_gmf_io_
     }
     io_item->instance = io;
     STAILQ_INSERT_TAIL(&handle->io_list, io_item, next);
+    esp_gmf_io_item_t **slot = &handle->io_index[ESP_GMF_POOL_INDEX_OF(((esp_gmf_obj_t *)io)->tag_hash)];
+    while (*slot) {
+        slot = &(*slot)->hash_next;
+    }
+    *slot = io_item;
     ESP_LOGD(TAG, "REG IO:[%p-%s], item:%p, pool:%p", io, OBJ_GET_TAG(io), io_item, handle);
     return ESP_GMF_ERR_OK;
 }
@@ -166,6 +189,26 @@ esp_gmf_err_t esp_gmf_pool_iterate_element(esp_gmf_pool_handle_t handle, const v
     return ESP_GMF_ERR_NOT_FOUND;
 }
 
+esp_gmf_err_t esp_gmf_pool_find_element(esp_gmf_pool_handle_t handle, const char *el_name, esp_gmf_element_handle_t *el)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, el_name, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, el, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_element_item_t *el_item = __get_element_item_by_tag(handle, el_name);
+    *el = el_item ? el_item->instance : NULL;
+    return el_item ? ESP_GMF_ERR_OK : ESP_GMF_ERR_NOT_FOUND;
+}
+
+esp_gmf_err_t esp_gmf_pool_find_io(esp_gmf_pool_handle_t handle, const char *name, esp_gmf_io_dir_t dir, esp_gmf_io_handle_t *io)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, name, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, io, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_io_item_t *io_item = _get_io_item_by_tag(handle, name, dir);
+    *io = io_item ? io_item->instance : NULL;
+    return io_item ? ESP_GMF_ERR_OK : ESP_GMF_ERR_NOT_FOUND;
+}
+
 esp_gmf_err_t esp_gmf_pool_new_io(esp_gmf_pool_handle_t handle, const char *name, esp_gmf_io_dir_t dir, esp_gmf_io_handle_t *new_io)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
@@ -9,9 +9,11 @@
 #include <string.h>
 #include "esp_log.h"
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
 #include "esp_gmf_port.h"
 #include "esp_gmf_element.h"
 #include "esp_gmf_node.h"
+#include "esp_gmf_task.h"
 
 static const char *TAG = "ESP_GMF_PORT";
 
@@ -29,6 +31,154 @@ static inline esp_gmf_err_io_t esp_gmf_port_dec_ref(esp_gmf_port_handle_t port,
     return ESP_GMF_ERR_OK;
 }
 
+static esp_gmf_err_io_t esp_gmf_port_release_batch(esp_gmf_port_t *port, esp_gmf_payload_t *loads[], int cnt, int wait_ticks)
+{
+    if (port->ops.release_batch) {
+        return port->ops.release_batch(port->ctx, loads, cnt, wait_ticks);
+    }
+    // Without the batch release, the payloads go back one by one in stream order
+    esp_gmf_err_io_t ret = ESP_GMF_IO_OK;
+    for (int i = 0; (i < cnt) && port->ops.release; i++) {
+        ret = port->ops.release(port->ctx, loads[i], wait_ticks);
+        if (ret < ESP_GMF_IO_OK) {
+            break;
+        }
+    }
+    return ret;
+}
+
+static esp_gmf_err_io_t esp_gmf_port_acquire_ahead(esp_gmf_port_t *port, esp_gmf_payload_t *load, uint32_t wanted_size, int wait_ticks)
+{
+    if (port->ahead_pos >= port->ahead_cnt) {
+        esp_gmf_payload_t *loads[ESP_GMF_PORT_BATCH_DEPTH_MAX] = {0};
+        for (int i = 0; i < port->ahead_depth; i++) {
+            loads[i] = &port->ahead_loads[i];
+            loads[i]->trace_us = 0;
+        }
+        esp_gmf_err_io_t ret = port->ops.acquire_batch(port->ctx, loads, port->ahead_depth, wanted_size, wait_ticks);
+        if (ret <= 0) {
+            return ret < ESP_GMF_IO_OK ? ret : ESP_GMF_IO_FAIL;
+        }
+        port->ahead_cnt = ret;
+        port->ahead_pos = 0;
+    }
+    esp_gmf_payload_t *ahead = &port->ahead_loads[port->ahead_pos];
+    load->buf = ahead->buf;
+    load->buf_length = ahead->buf_length;
+    load->valid_size = ahead->valid_size;
+    load->is_done = ahead->is_done;
+    load->trace_us = ahead->trace_us;
+    return ESP_GMF_IO_OK;
+}
+
+static esp_gmf_err_io_t esp_gmf_port_release_ahead(esp_gmf_port_t *port, int wait_ticks)
+{
+    if (port->ref_count == 0) {
+        return ESP_GMF_IO_OK;
+    }
+    port->ref_count = 0;
+    // The read ahead payloads are released at once after the last one is read
+    if (++port->ahead_pos < port->ahead_cnt) {
+        return ESP_GMF_IO_OK;
+    }
+    esp_gmf_payload_t *loads[ESP_GMF_PORT_BATCH_DEPTH_MAX] = {0};
+    int cnt = port->ahead_cnt;
+    for (int i = 0; i < cnt; i++) {
+        loads[i] = &port->ahead_loads[i];
+    }
+    port->ahead_cnt = 0;
+    port->ahead_pos = 0;
+    return esp_gmf_port_release_batch(port, loads, cnt, wait_ticks);
+}
+
+static inline int64_t esp_gmf_port_trace_stamp(esp_gmf_element_handle_t el)
+{
+#ifdef CONFIG_ESP_GMF_LATENCY_TRACE_EN
+    // The output inherits the stamp of the input, the element without input generates the data itself
+    esp_gmf_port_t *in = el ? ESP_GMF_ELEMENT_GET(el)->in : NULL;
+    if (in && in->payload && in->payload->trace_us) {
+        return in->payload->trace_us;
+    }
+    return esp_gmf_oal_sys_get_time_us();
+#else
+    return 0;
+#endif  /* CONFIG_ESP_GMF_LATENCY_TRACE_EN */
+}
+
+static inline int64_t esp_gmf_port_prof_start(void)
+{
+#ifdef CONFIG_ESP_GMF_TASK_PROFILING_EN
+    return esp_gmf_oal_sys_get_time_us();
+#else
+    return 0;
+#endif  /* CONFIG_ESP_GMF_TASK_PROFILING_EN */
+}
+
+static inline void esp_gmf_port_prof_end(int64_t start, uint32_t bytes_in, uint32_t bytes_out)
+{
+#ifdef CONFIG_ESP_GMF_TASK_PROFILING_EN
+    // Zero start means no port operation which may block
+    esp_gmf_task_prof_add_io(start ? (uint32_t)(esp_gmf_oal_sys_get_time_us() - start) : 0, bytes_in, bytes_out);
+#endif  /* CONFIG_ESP_GMF_TASK_PROFILING_EN */
+}
+
+static inline esp_gmf_element_t *esp_gmf_port_get_linked_next(esp_gmf_element_handle_t el)
+{
+    // The next element which reads the payload of `el` directly, it is NULL when the next element reads
+    // from a data bus, e.g. the next element runs on another task of a split pipeline
+    esp_gmf_element_t *next = ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next);
+    if (next && next->in && (next->in->writer == el)) {
+        return next;
+    }
+    return NULL;
+}
+
+static inline esp_gmf_err_t esp_gmf_port_reserve_buf(esp_gmf_port_t *port, esp_gmf_payload_t *load, uint32_t wanted_size)
+{
+    if (load->buf_length >= wanted_size) {
+        return ESP_GMF_ERR_OK;
+    }
+    // Leave room for the following elements which grow the data in place
+    wanted_size += (uint32_t)((uint64_t)wanted_size * port->headroom_pct / 100);
+    // Take the buffer from the pool the first time, fall back to allocating it if the pool does not fit
+    if (port->payload_pool && (load->buf == NULL)
+        && (esp_gmf_payload_pool_attach(port->payload_pool, port->attr.buf_addr_aligned, wanted_size, load) == ESP_GMF_ERR_OK)) {
+        return ESP_GMF_ERR_OK;
+    }
+    return esp_gmf_payload_realloc_aligned_buf(load, port->attr.buf_addr_aligned, wanted_size);
+}
+
+static inline void esp_gmf_port_unshare_buf(esp_gmf_payload_t *load)
+{
+    // The pooled buffer still referenced elsewhere, e.g. published to the branches by reference, is left to the holders,
+    // the payload takes another buffer rather than writing over the data they read
+    uint8_t ref = 0;
+    if (load->pool && (esp_gmf_payload_pool_get_ref(load, &ref) == ESP_GMF_ERR_OK) && (ref > 1)) {
+        esp_gmf_payload_pool_detach(load);
+    }
+}
+
+static inline void esp_gmf_port_drop_held(esp_gmf_port_t *port)
+{
+    if (port->held_buf) {
+        esp_gmf_payload_pool_unref(port->held_pool, port->held_buf);
+        port->held_buf = NULL;
+        port->held_pool = NULL;
+    }
+}
+
+static inline void esp_gmf_port_hand_over(esp_gmf_port_t *next_in, esp_gmf_payload_t *load)
+{
+    // The reader holds a reference on the pooled buffer until it releases the payload, so the buffer is not reused
+    // by the pool even if the writer drops it in between, e.g. reallocating its payload for a larger size
+    esp_gmf_port_drop_held(next_in);
+    next_in->payload = load;
+    if (load && load->pool && (esp_gmf_payload_pool_ref(load) == ESP_GMF_ERR_OK)) {
+        next_in->held_pool = load->pool;
+        next_in->held_buf = load->buf;
+    }
+}
+
 esp_gmf_err_t esp_gmf_port_init(esp_gmf_port_config_t *cfg, esp_gmf_port_handle_t *out_result)
 {
     ESP_GMF_NULL_CHECK(TAG, cfg, return ESP_GMF_ERR_INVALID_ARG);
@@ -54,7 +204,9 @@ esp_gmf_err_t esp_gmf_port_deinit(esp_gmf_port_handle_t handle)
     esp_gmf_port_t *port = (esp_gmf_port_t *)handle;
     ESP_LOGD(TAG, "Delete a port:%p, t:%d, dir:%d, self_payload:%p, ptr:%p", port,
              port->attr.type, port->attr.dir, port->self_payload, port->payload);
+    esp_gmf_port_drop_held(port);
     esp_gmf_payload_delete(port->self_payload);
+    esp_gmf_oal_free(port->ahead_loads);
     if (port->ops.del && (port->attr.dir == ESP_GMF_PORT_DIR_OUT)) {
         port->ops.del(port->ctx);
         port->ops.del = NULL;
@@ -96,11 +248,31 @@ esp_gmf_err_t esp_gmf_port_enable_payload_share(esp_gmf_port_handle_t handle, bo
     return ESP_GMF_ERR_OK;
 }
 
+esp_gmf_err_t esp_gmf_port_set_payload_pool(esp_gmf_port_handle_t handle, esp_gmf_payload_pool_handle_t pool)
+{
+    esp_gmf_port_t *port = (esp_gmf_port_t *)handle;
+    ESP_GMF_NULL_CHECK(TAG, port, return ESP_GMF_ERR_INVALID_ARG);
+    port->payload_pool = pool;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_port_set_headroom(esp_gmf_port_handle_t handle, uint16_t headroom_pct)
+{
+    esp_gmf_port_t *port = (esp_gmf_port_t *)handle;
+    ESP_GMF_NULL_CHECK(TAG, port, return ESP_GMF_ERR_INVALID_ARG);
+    port->headroom_pct = headroom_pct;
+    return ESP_GMF_ERR_OK;
+}
+
 esp_gmf_err_t esp_gmf_port_reset(esp_gmf_port_handle_t handle)
 {
     esp_gmf_port_t *port = (esp_gmf_port_t *)handle;
     ESP_GMF_NULL_CHECK(TAG, port, return ESP_GMF_ERR_INVALID_ARG);
     port->payload = NULL;
+    port->batch_cnt = 0;
+    port->ahead_cnt = 0;
+    port->ahead_pos = 0;
+    esp_gmf_port_drop_held(port);
     if (port->self_payload) {
         esp_gmf_payload_clean_done(port->self_payload);
         port->self_payload->valid_size = 0;
@@ -133,6 +305,99 @@ esp_gmf_err_t esp_gmf_port_set_writer(esp_gmf_port_handle_t handle, void *writer
     return ESP_GMF_ERR_OK;
 }
 
+esp_gmf_err_t esp_gmf_port_set_ready_ops(esp_gmf_port_handle_t handle, port_ready ready, port_set_notify set_notify)
+{
+    esp_gmf_port_t *port = (esp_gmf_port_t *)handle;
+    ESP_GMF_NULL_CHECK(TAG, port, return ESP_GMF_ERR_INVALID_ARG);
+    port->ops.ready = ready;
+    port->ops.set_notify = set_notify;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_port_set_batch_ops(esp_gmf_port_handle_t handle, port_acquire_batch acquire_batch, port_release_batch release_batch)
+{
+    esp_gmf_port_t *port = (esp_gmf_port_t *)handle;
+    ESP_GMF_NULL_CHECK(TAG, port, return ESP_GMF_ERR_INVALID_ARG);
+    port->ops.acquire_batch = acquire_batch;
+    port->ops.release_batch = release_batch;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_port_set_batch_depth(esp_gmf_port_handle_t handle, uint8_t depth)
+{
+    esp_gmf_port_t *port = (esp_gmf_port_t *)handle;
+    ESP_GMF_NULL_CHECK(TAG, port, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_CHECK(TAG, (depth <= ESP_GMF_PORT_BATCH_DEPTH_MAX), return ESP_GMF_ERR_INVALID_ARG, "Invalid batch depth");
+    if ((port->attr.dir != ESP_GMF_PORT_DIR_IN) || (port->attr.type != ESP_GMF_PORT_TYPE_BLOCK) || (port->ops.acquire_batch == NULL)) {
+        ESP_LOGE(TAG, "Read ahead needs a block in port with the batch operations, p:%p, dir:%d, type:%d", port, port->attr.dir, port->attr.type);
+        return ESP_GMF_ERR_NOT_SUPPORT;
+    }
+    if (port->ahead_cnt) {
+        ESP_LOGE(TAG, "Can't change the batch depth while %d payloads are read ahead, p:%p", port->ahead_cnt, port);
+        return ESP_GMF_ERR_INVALID_STATE;
+    }
+    esp_gmf_oal_free(port->ahead_loads);
+    port->ahead_loads = NULL;
+    port->ahead_depth = 0;
+    if (depth > 1) {
+        port->ahead_loads = esp_gmf_oal_calloc(depth, sizeof(esp_gmf_payload_t));
+        ESP_GMF_MEM_CHECK(TAG, port->ahead_loads, return ESP_GMF_ERR_MEMORY_LACK);
+        port->ahead_depth = depth;
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_port_set_tee(esp_gmf_port_handle_t handle, port_release tee, void *tee_ctx)
+{
+    esp_gmf_port_t *port = (esp_gmf_port_t *)handle;
+    ESP_GMF_NULL_CHECK(TAG, port, return ESP_GMF_ERR_INVALID_ARG);
+    port->tee = tee;
+    port->tee_ctx = tee_ctx;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_port_set_tee_ready_ops(esp_gmf_port_handle_t handle, port_ready ready, port_set_notify set_notify)
+{
+    esp_gmf_port_t *port = (esp_gmf_port_t *)handle;
+    ESP_GMF_NULL_CHECK(TAG, port, return ESP_GMF_ERR_INVALID_ARG);
+    port->tee_ready = ready;
+    port->tee_set_notify = set_notify;
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_port_is_ready(esp_gmf_port_handle_t handle, bool *ready)
+{
+    esp_gmf_port_t *port = (esp_gmf_port_t *)handle;
+    ESP_GMF_NULL_CHECK(TAG, port, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, ready, return ESP_GMF_ERR_INVALID_ARG);
+    *ready = true;
+    if (port->tee && port->tee_ready) {
+        esp_gmf_err_t ret = port->tee_ready(port->tee_ctx, port->attr.dir, port->data_length, ready);
+        if ((ret != ESP_GMF_ERR_OK) || (*ready == false)) {
+            return ret;
+        }
+    }
+    if ((port->ops.ready == NULL) || (port->reader && port->writer)) {
+        return ESP_GMF_ERR_OK;
+    }
+    return port->ops.ready(port->ctx, port->attr.dir, port->data_length, ready);
+}
+
+esp_gmf_err_t esp_gmf_port_set_notify(esp_gmf_port_handle_t handle, esp_gmf_port_notify_cb cb, void *ctx)
+{
+    esp_gmf_port_t *port = (esp_gmf_port_t *)handle;
+    ESP_GMF_NULL_CHECK(TAG, port, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_err_t ret = ESP_GMF_ERR_NOT_SUPPORT;
+    if (port->tee && port->tee_set_notify) {
+        ret = port->tee_set_notify(port->tee_ctx, port->attr.dir, cb, ctx);
+    }
+    if (port->ops.set_notify == NULL) {
+        return ret;
+    }
+    ESP_LOGD(TAG, "P:%p, set notify:%p, ctx:%p", port, cb, ctx);
+    return port->ops.set_notify(port->ctx, port->attr.dir, cb, ctx);
+}
+
 esp_gmf_err_t esp_gmf_port_add_last(esp_gmf_port_handle_t head, esp_gmf_port_handle_t io_inst)
 {
     ESP_GMF_NULL_CHECK(TAG, head, return ESP_GMF_ERR_INVALID_ARG);
@@ -177,6 +442,7 @@ esp_gmf_err_io_t esp_gmf_port_acquire_in(esp_gmf_port_handle_t handle, esp_gmf_p
         return ESP_GMF_IO_FAIL;
     }
     esp_gmf_err_io_t ret = ESP_GMF_ERR_OK;
+    int64_t prof_start = 0;
     esp_gmf_element_handle_t el = (esp_gmf_element_handle_t)port->reader;
     // Both reader and writer existed
     if (el && port->writer) {
@@ -185,10 +451,9 @@ esp_gmf_err_io_t esp_gmf_port_acquire_in(esp_gmf_port_handle_t handle, esp_gmf_p
                  port, port->attr.type, el, OBJ_GET_TAG(el), port->payload, port->payload ? port->payload->buf : NULL, port->payload ? port->payload->valid_size : 0);
         if (port->payload) {
             *load = port->payload;
-            if (ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next)) {
-                if ((port->payload->needs_free) && (port->is_shared) && ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next)->out) {
-                    ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next)->out->payload = port->payload;
-                }
+            esp_gmf_element_t *nxt_el = esp_gmf_port_get_linked_next(el);
+            if ((port->payload->needs_free) && (port->is_shared) && nxt_el && nxt_el->out) {
+                nxt_el->out->payload = port->payload;
             }
         } else {
             ESP_LOGE(TAG, "ACQ IN, there is no payload, p:%p, el:%p-%s", port, el, OBJ_GET_TAG(el));
@@ -206,26 +471,43 @@ esp_gmf_err_io_t esp_gmf_port_acquire_in(esp_gmf_port_handle_t handle, esp_gmf_p
         } else {
             port->payload = *load;
         }
+        if (port->attr.type == ESP_GMF_PORT_TYPE_BYTE) {
+            esp_gmf_port_unshare_buf(*load);
+        }
         if ((port->attr.type == ESP_GMF_PORT_TYPE_BYTE) && ((*load)->buf_length < wanted_size)) {
             // Check whether the buffer length is sufficient for use; if not, reallocate it.
-            ret = esp_gmf_payload_realloc_aligned_buf(*load, port->attr.buf_addr_aligned, wanted_size);
+            ret = esp_gmf_port_reserve_buf(port, *load, wanted_size);
             ESP_GMF_RET_ON_ERROR(TAG, ret, return ESP_GMF_IO_FAIL, "ACQ IN, reallocate payload buffer failed, ret:%d, %s, p:%p, new_sz:%ld",
                                  ret, __func__, port, wanted_size);
         }
-        esp_gmf_element_t *nxt_el = el ? ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next) : NULL;
+        // The payload is handed over to the next element only when it reads the payload of `el` directly
+        esp_gmf_element_t *nxt_el = el ? esp_gmf_port_get_linked_next(el) : NULL;
         ESP_LOGD(TAG, "ACQ IN, port:%p-%d, el:%p-%s, PLD[p:%p, h:%p, b:%p, l:%d], nxt_el:%p-%s", port, port->attr.type, el, OBJ_GET_TAG(el), port->payload,
                  *load, (*load)->buf, (*load)->buf_length, nxt_el, OBJ_GET_TAG(nxt_el));
         if ((port->payload->needs_free) && (port->attr.type != ESP_GMF_PORT_TYPE_BLOCK) && (port->is_shared)
             && nxt_el && nxt_el->out) {
             nxt_el->out->payload = port->payload;
         }
-        if (port->ops.acquire) {
+        if (port->ahead_depth > 1) {
+            prof_start = esp_gmf_port_prof_start();
+            ret = esp_gmf_port_acquire_ahead(port, *load, wanted_size, wait_ticks);
+            if (ret >= ESP_GMF_IO_OK) {
+                port->ref_count = 1;
+            }
+        } else if (port->ops.acquire) {
+            // The data bus carrying the stamps of its writer sets it, otherwise the data is stamped on entering
+            (*load)->trace_us = 0;
+            prof_start = esp_gmf_port_prof_start();
             ret = port->ops.acquire(port->ctx, *load, wanted_size, wait_ticks);
             if (ret >= ESP_GMF_IO_OK) {
                 port->ref_count = 1;
             }
         }
     }
+    esp_gmf_port_prof_end(prof_start, ((ret >= ESP_GMF_IO_OK) && *load) ? (*load)->valid_size : 0, 0);
+    if ((ret >= ESP_GMF_IO_OK) && el) {
+        esp_gmf_element_trace_in(el, *load, port->writer == NULL);
+    }
     return ret;
 }
 
@@ -250,12 +532,73 @@ esp_gmf_err_io_t esp_gmf_port_release_in(esp_gmf_port_handle_t handle, esp_gmf_p
         if (port->payload && port->is_shared) {
             port->payload = NULL;
         }
+        esp_gmf_port_drop_held(port);
+    } else if (port->ahead_cnt) {
+        ret = esp_gmf_port_release_ahead(port, wait_ticks);
     } else {
         ret = esp_gmf_port_dec_ref(port, load, wait_ticks);
     }
     return ret;
 }
 
+esp_gmf_err_io_t esp_gmf_port_acquire_in_batch(esp_gmf_port_handle_t handle, esp_gmf_payload_t *loads[], int max_cnt, uint32_t wanted_size, int wait_ticks)
+{
+    esp_gmf_port_t *port = (esp_gmf_port_t *)handle;
+    ESP_GMF_NULL_CHECK(TAG, port, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, loads, return ESP_GMF_IO_FAIL);
+    ESP_GMF_CHECK(TAG, (max_cnt > 0), return ESP_GMF_IO_FAIL, "Invalid batch count");
+    ESP_GMF_CHECK(TAG, (port->ahead_cnt == 0), return ESP_GMF_IO_FAIL, "Read ahead payloads are held");
+    esp_gmf_element_handle_t el = (esp_gmf_element_handle_t)port->reader;
+    if ((max_cnt == 1) || (port->ops.acquire_batch == NULL) || (el && port->writer)) {
+        esp_gmf_err_io_t ret = esp_gmf_port_acquire_in(handle, &loads[0], wanted_size, wait_ticks);
+        return ret < ESP_GMF_IO_OK ? ret : 1;
+    }
+    if (port->attr.dir != ESP_GMF_PORT_DIR_IN) {
+        ESP_LOGE(TAG, "Wrong port direction! %s, p:%p-dir:%d", __func__, port, port->attr.dir);
+        return ESP_GMF_IO_FAIL;
+    }
+    for (int i = 0; i < max_cnt; i++) {
+        ESP_GMF_NULL_CHECK(TAG, loads[i], return ESP_GMF_IO_FAIL);
+        loads[i]->trace_us = 0;
+    }
+    int64_t prof_start = esp_gmf_port_prof_start();
+    esp_gmf_err_io_t ret = port->ops.acquire_batch(port->ctx, loads, max_cnt, wanted_size, wait_ticks);
+    uint32_t bytes_in = 0;
+    if (ret > 0) {
+        port->ref_count = 1;
+        port->batch_cnt = ret;
+        port->payload = loads[ret - 1];
+        for (int i = 0; i < ret; i++) {
+            bytes_in += loads[i]->valid_size;
+        }
+    }
+    esp_gmf_port_prof_end(prof_start, bytes_in, 0);
+    ESP_LOGD(TAG, "ACQ IN BATCH, port:%p, el:%p-%s, cnt:%d, bytes:%ld", port, el, OBJ_GET_TAG(el), ret, bytes_in);
+    for (int i = 0; el && (i < ret); i++) {
+        esp_gmf_element_trace_in(el, loads[i], true);
+    }
+    return ret;
+}
+
+esp_gmf_err_io_t esp_gmf_port_release_in_batch(esp_gmf_port_handle_t handle, esp_gmf_payload_t *loads[], int cnt, int wait_ticks)
+{
+    esp_gmf_port_t *port = (esp_gmf_port_t *)handle;
+    ESP_GMF_NULL_CHECK(TAG, port, return ESP_GMF_IO_FAIL);
+    ESP_GMF_NULL_CHECK(TAG, loads, return ESP_GMF_IO_FAIL);
+    if (port->batch_cnt == 0) {
+        ESP_GMF_CHECK(TAG, (cnt == 1), return ESP_GMF_IO_FAIL, "Release more than one payload without a batch held");
+        return esp_gmf_port_release_in(handle, loads[0], wait_ticks);
+    }
+    if (cnt != port->batch_cnt) {
+        ESP_LOGE(TAG, "Release %d payloads of the batch, held:%d, p:%p", cnt, port->batch_cnt, port);
+        return ESP_GMF_IO_FAIL;
+    }
+    port->batch_cnt = 0;
+    port->ref_count = 0;
+    port->payload = NULL;
+    return esp_gmf_port_release_batch(port, loads, cnt, wait_ticks);
+}
+
 esp_gmf_err_io_t esp_gmf_port_acquire_out(esp_gmf_port_handle_t handle, esp_gmf_payload_t **load, uint32_t wanted_size, int wait_ticks)
 {
     esp_gmf_port_t *port = (esp_gmf_port_t *)handle;
@@ -269,6 +612,7 @@ esp_gmf_err_io_t esp_gmf_port_acquire_out(esp_gmf_port_handle_t handle, esp_gmf_
     int ret = ESP_GMF_ERR_OK;
     esp_gmf_element_handle_t el = (esp_gmf_element_handle_t)port->writer;
     esp_gmf_payload_t *in_original_load = *load;
+    int64_t trace_us = esp_gmf_port_trace_stamp(el);
     if ((*load) && ((*load) == ESP_GMF_ELEMENT_GET(el)->in->payload)) {
         if (wanted_size > ESP_GMF_ELEMENT_GET(el)->in->payload->buf_length) {
             ESP_LOGE(TAG, "Input and output use the same payload, but the acquired length is too large. I:%p-%d, O:%p-%ld",
@@ -276,8 +620,9 @@ esp_gmf_err_io_t esp_gmf_port_acquire_out(esp_gmf_port_handle_t handle, esp_gmf_
             return ESP_GMF_IO_FAIL;
         }
         // When in and out use same payload, clear the next element out payload which is set by acquire in
-        if (ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next) && ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next)->out) {
-            ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next)->out->payload = NULL;
+        esp_gmf_element_t *next = esp_gmf_port_get_linked_next(el);
+        if (next && next->out) {
+            next->out->payload = NULL;
         }
     }
     if (*load == NULL) {
@@ -292,10 +637,14 @@ esp_gmf_err_io_t esp_gmf_port_acquire_out(esp_gmf_port_handle_t handle, esp_gmf_
             port->payload = port->self_payload;
             *load = port->self_payload;
         }
+        esp_gmf_port_t *el_in = el ? ESP_GMF_ELEMENT_GET(el)->in : NULL;
+        if ((el_in == NULL) || (*load != el_in->payload)) {
+            esp_gmf_port_unshare_buf(*load);
+        }
     }
     if (el && port->reader) {
         if ((*load)->buf_length < wanted_size) {
-            ret = esp_gmf_payload_realloc_aligned_buf(*load, port->attr.buf_addr_aligned, wanted_size);
+            ret = esp_gmf_port_reserve_buf(port, *load, wanted_size);
             ESP_GMF_RET_ON_ERROR(TAG, ret, return ESP_GMF_IO_FAIL, "ACQ OUT, SET NEXT, reallocate payload buffer failed, el:%s, p:%p, sz:%d, new_sz:%ld",
                                  OBJ_GET_TAG(el), port, port->data_length, wanted_size);
         }
@@ -304,17 +653,17 @@ esp_gmf_err_io_t esp_gmf_port_acquire_out(esp_gmf_port_handle_t handle, esp_gmf_
                 ESP_LOGD(TAG, "ACQ OUT, COPY DATA TO NEXT[%p], port:%p-%d, el:%p-%s",
                          ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next)->in->payload, port, port->attr.type, el, OBJ_GET_TAG(el));
                 esp_gmf_payload_copy_data(ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next)->in->payload, *load);
+                ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next)->in->payload->trace_us = trace_us;
             } else {
                 esp_gmf_port_t *next_in = ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next)->in;
-                next_in->payload = *load;
+                esp_gmf_port_hand_over(next_in, *load);
                 esp_gmf_port_t *ref_in = ESP_GMF_ELEMENT_GET(el)->in;
                 ref_in = ref_in->ref_port ? ref_in->ref_port : ref_in;
                 next_in->ref_port = ref_in;
                 ref_in->ref_count++;
             }
         } else {
-            esp_gmf_port_t *next_in = ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next)->in;
-            next_in->payload = *load;
+            esp_gmf_port_hand_over(ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next)->in, *load);
         }
         ESP_LOGD(TAG, "ACQ OUT, SET NEXT, port:%p-%d, el:%p-%s, PLD[in:%p-done:%d, nxt:%p]", port, port->attr.type, el,
                  OBJ_GET_TAG(el), *load, (*load)->is_done, ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next)->in->payload);
@@ -322,22 +671,27 @@ esp_gmf_err_io_t esp_gmf_port_acquire_out(esp_gmf_port_handle_t handle, esp_gmf_
         port->payload = *load;
         if (port->attr.type == ESP_GMF_PORT_TYPE_BYTE) {
             if ((*load)->buf_length < wanted_size) {
-                ret = esp_gmf_payload_realloc_aligned_buf(*load, port->attr.buf_addr_aligned, wanted_size);
+                ret = esp_gmf_port_reserve_buf(port, *load, wanted_size);
             }
             ESP_GMF_RET_ON_ERROR(TAG, ret, return ESP_GMF_IO_FAIL, "ACQ OUT, reallocate payload buffer failed, el:%s, p:%p, ld:%p, sz:%d, new_sz:%ld",
                                  OBJ_GET_TAG(el), port, *load, port->data_length, wanted_size);
         }
         ESP_LOGD(TAG, "ACQ OUT, port:%p-%d, el:%p-%s, PLD[p:%p, h:%p, b:%p, v:%d, l:%d]", port, port->attr.type, el, OBJ_GET_TAG(el),
                  port->payload, *load, (*load)->buf, (*load)->valid_size, (*load)->buf_length);
-        if (el && ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next)) {
-            if ((port->payload->needs_free) && ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next)->in) {
-                ESP_GMF_ELEMENT_GET(((esp_gmf_node_t *)el)->next)->in->payload = port->payload;
+        if (el && esp_gmf_port_get_linked_next(el)) {
+            if (port->payload->needs_free) {
+                esp_gmf_port_hand_over(esp_gmf_port_get_linked_next(el)->in, port->payload);
             }
         }
         if (port->ops.acquire) {
+            int64_t prof_start = esp_gmf_port_prof_start();
             ret = port->ops.acquire(port->ctx, *load, wanted_size, wait_ticks);
+            esp_gmf_port_prof_end(prof_start, 0, 0);
         }
     }
+    if (ret >= ESP_GMF_IO_OK) {
+        (*load)->trace_us = trace_us;
+    }
     return ret;
 }
 
@@ -354,10 +708,21 @@ esp_gmf_err_io_t esp_gmf_port_release_out(esp_gmf_port_handle_t handle, esp_gmf_
     esp_gmf_element_handle_t el = (esp_gmf_element_handle_t)port->writer;
     esp_gmf_err_io_t ret = ESP_GMF_ERR_OK;
     ESP_LOGD(TAG, "%s, p:%p, el:%s,reader:%p, PLD[h:%p, b:%p, l:%d]", __func__, port, OBJ_GET_TAG(el), port->reader, load, load->buf, load->buf_length);
+    int64_t prof_start = 0;
+    if (el) {
+        // Count the latency up to handing the data over, the output IO may block on its own pace
+        esp_gmf_element_trace_out(el, load, port->reader == NULL);
+    }
+    if (port->tee) {
+        // Hand the data to the tee while the payload is still valid
+        port->tee(port->tee_ctx, load, 0);
+    }
     if (el && port->reader) {
         port->payload = NULL;
     } else {
+        prof_start = esp_gmf_port_prof_start();
         ret = port->ops.release(port->ctx, load, wait_ticks);
     }
+    esp_gmf_port_prof_end(prof_start, 0, load->valid_size);
     return ret;
 }
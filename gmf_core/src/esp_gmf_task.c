@@ -5,19 +5,23 @@
  * See LICENSE file for details.
  */
 
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
+#include "freertos/timers.h"
 #include "sys/queue.h"
 
 #include "esp_gmf_oal_mutex.h"
 #include "esp_gmf_oal_thread.h"
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
 #include "esp_gmf_node.h"
 #include "esp_gmf_task.h"
+#include "esp_gmf_task_pool.h"
 #include "esp_log.h"
 
 static const char *TAG = "ESP_GMF_TASK";
@@ -30,6 +34,74 @@ static const char *TAG = "ESP_GMF_TASK";
 #define GMF_TASK_STOP_BIT   (1 << 3)
 #define GMF_TASK_EXIT_BIT   (1 << 4)
 
+#define GMF_TASK_LOOP_NEXT  (0)
+#define GMF_TASK_LOOP_PARK  (1)
+#define GMF_TASK_LOOP_QUIT  (2)
+#define GMF_TASK_LOOP_WAIT  (3)
+
+#define GMF_TASK_JOB_IS_VALID(job) (((job) != NULL) && ((job)->func != NULL))
+
+#define GMF_TASK_JOB_SLAB_CNT  (8)   // Jobs allocated at once when the free jobs run out
+#define GMF_TASK_PROF_HIST_NUM (20)  // Bucket N counts the calls of [2^(N-1), 2^N) us, the last one counts all the longer calls
+#define GMF_TASK_LABEL_IDLE_MAX (16)  // Unused labels kept for the next registrations, the older ones are freed
+
+#define GMF_TASK_LABEL_ITEM(label) ((esp_gmf_job_label_t *)((label) - offsetof(esp_gmf_job_label_t, str)))
+
+/**
+ * @brief  Block of jobs, the jobs are returned to the free list of the task and only freed with the task
+ */
+typedef struct esp_gmf_job_slab {
+    struct esp_gmf_job_slab *next;                         /*!< Next slab of the task */
+    esp_gmf_job_t            jobs[GMF_TASK_JOB_SLAB_CNT];  /*!< Jobs of the slab */
+} esp_gmf_job_slab_t;
+
+/**
+ * @brief  Interned job label, shared by all the jobs registered with the same label
+ */
+typedef struct esp_gmf_job_label {
+    struct esp_gmf_job_label *next;   /*!< Next label of the task */
+    uint16_t                  ref;    /*!< Number of the jobs and profiling records using the label */
+    char                      str[];  /*!< Label string */
+} esp_gmf_job_label_t;
+
+/**
+ * @brief  Deadline of the infinite jobs with the same context
+ */
+typedef struct esp_gmf_job_deadline {
+    struct esp_gmf_job_deadline *next;         /*!< Next deadline of the task */
+    void                        *ctx;          /*!< Context of the jobs */
+    uint32_t                     period_us;    /*!< Period of the jobs, 0 means no deadline */
+    uint32_t                     deadline_us;  /*!< Deadline relative to the release of each period */
+    uint32_t                     miss_cnt;     /*!< Number of the missed deadlines */
+} esp_gmf_job_deadline_t;
+
+/**
+ * @brief  Profiling record shared by the jobs with the same function and context
+ */
+typedef struct esp_gmf_job_prof {
+    struct esp_gmf_job_prof *next;                          /*!< Next record of the task */
+    esp_gmf_job_func         func;                          /*!< Function of the jobs */
+    void                    *ctx;                           /*!< Context of the jobs */
+    const char              *label;                         /*!< Label of the first registered job */
+    uint32_t                 call_cnt;                      /*!< Number of calls */
+    uint32_t                 min_us;                        /*!< Time of the shortest call */
+    uint32_t                 max_us;                        /*!< Time of the longest call */
+    uint64_t                 total_us;                      /*!< Total time of the calls */
+    uint64_t                 blocked_us;                    /*!< Time blocked in the ports */
+    uint64_t                 bytes_in;                      /*!< Bytes acquired from the input ports */
+    uint64_t                 bytes_out;                     /*!< Bytes released to the output ports */
+    uint32_t                 hist[GMF_TASK_PROF_HIST_NUM];  /*!< Histogram of the call time */
+} esp_gmf_job_prof_t;
+
+#ifdef CONFIG_ESP_GMF_TASK_PROFILING_EN
+// Record of the job running on the current thread, the ports account their IO to it
+static __thread esp_gmf_job_prof_t *cur_prof;
+#endif  /* CONFIG_ESP_GMF_TASK_PROFILING_EN */
+
+// Task of the job running on the current thread and the end of its time slice, 0 means no limit
+static __thread esp_gmf_task_t *cur_tsk;
+static __thread int64_t cur_slice_end;
+
 #define GMF_TASK_WAIT_FOR_STATE_BITS(event_group, bits, timeout) \
     (bits == (bits & xEventGroupWaitBits((EventGroupHandle_t)event_group, bits, true, true, timeout)))
 
@@ -97,12 +169,25 @@ static inline int esp_gmf_task_acquire_signal(esp_gmf_task_handle_t handle, int
 static inline int esp_gmf_task_release_signal(esp_gmf_task_handle_t handle, int ticks)
 {
     esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    if (tsk->pool) {
+        // The paused job loop is parked, schedule it again to resume
+        return esp_gmf_task_pool_submit(tsk->pool, &tsk->pool_item);
+    }
     if (xSemaphoreGive(tsk->wait_sem) != pdTRUE) {
         return ESP_GMF_ERR_FAIL;
     }
     return ESP_GMF_ERR_OK;
 }
 
+static inline void esp_gmf_task_wakeup(esp_gmf_task_t *tsk)
+{
+    if (tsk->pool) {
+        esp_gmf_task_pool_submit(tsk->pool, &tsk->pool_item);
+    } else {
+        xSemaphoreGive(tsk->block_sem);
+    }
+}
+
 static int get_jobs_num(esp_gmf_job_t *job)
 {
     int k = 1;
@@ -131,21 +216,410 @@ static inline void __esp_gmf_task_free(esp_gmf_task_handle_t handle)
     if (tsk->start_stack) {
         esp_gmf_job_stack_destroy(tsk->start_stack);
     }
+    if (tsk->job_lock) {
+        esp_gmf_oal_mutex_destroy(tsk->job_lock);
+    }
+    esp_gmf_job_prof_t *prof = (esp_gmf_job_prof_t *)tsk->prof;
+    while (prof) {
+        esp_gmf_job_prof_t *next = prof->next;
+        esp_gmf_oal_free(prof);
+        prof = next;
+    }
+    esp_gmf_job_slab_t *slab = (esp_gmf_job_slab_t *)tsk->job_slabs;
+    while (slab) {
+        esp_gmf_job_slab_t *next = slab->next;
+        esp_gmf_oal_free(slab);
+        slab = next;
+    }
+    esp_gmf_job_label_t *label = (esp_gmf_job_label_t *)tsk->labels;
+    while (label) {
+        esp_gmf_job_label_t *next = label->next;
+        esp_gmf_oal_free(label);
+        label = next;
+    }
+    esp_gmf_job_deadline_t *dl = (esp_gmf_job_deadline_t *)tsk->deadlines;
+    while (dl) {
+        esp_gmf_job_deadline_t *next = dl->next;
+        esp_gmf_oal_free(dl);
+        dl = next;
+    }
+    if (tsk->wake_timer) {
+        xTimerDelete((TimerHandle_t)tsk->wake_timer, portMAX_DELAY);
+    }
     esp_gmf_oal_free(tsk);
 }
 
-static int esp_gmf_job_item_free(void *ptr)
+static const char *esp_gmf_task_intern_label(esp_gmf_task_t *tsk, const char *label)
 {
-    esp_gmf_job_t *job = (esp_gmf_job_t *)ptr;
-    esp_gmf_oal_free((void *)job->label);
-    esp_gmf_oal_free(job);
-    return ESP_GMF_ERR_OK;
+    esp_gmf_job_label_t *item = (esp_gmf_job_label_t *)tsk->labels;
+    while (item && strcmp(item->str, label)) {
+        item = item->next;
+    }
+    if (item) {
+        item->ref++;
+        return item->str;
+    }
+    int len = strlen(label) + 1;
+    item = esp_gmf_oal_malloc(sizeof(esp_gmf_job_label_t) + len);
+    ESP_GMF_MEM_CHECK(TAG, item, return NULL);
+    memcpy(item->str, label, len);
+    item->ref = 1;
+    item->next = (esp_gmf_job_label_t *)tsk->labels;
+    tsk->labels = item;
+    return item->str;
+}
+
+/**
+ * @brief  Drop a reference of the interned label, called with `job_lock` held
+ *
+ *         The unused labels are kept for the jobs registered by the next run, only the older ones beyond
+ *         `GMF_TASK_LABEL_IDLE_MAX` are freed, so the labels of the deleted elements don't pile up
+ */
+static void esp_gmf_task_label_release(esp_gmf_task_t *tsk, const char *label)
+{
+    if (--GMF_TASK_LABEL_ITEM(label)->ref) {
+        return;
+    }
+    int idle = 0;
+    esp_gmf_job_label_t **pos = (esp_gmf_job_label_t **)&tsk->labels;
+    while (*pos) {
+        esp_gmf_job_label_t *item = *pos;
+        if ((item->ref == 0) && (++idle > GMF_TASK_LABEL_IDLE_MAX)) {
+            *pos = item->next;
+            esp_gmf_oal_free(item);
+        } else {
+            pos = &item->next;
+        }
+    }
+}
+
+#ifdef CONFIG_ESP_GMF_TASK_PROFILING_EN
+static esp_gmf_job_prof_t *esp_gmf_task_prof_get(esp_gmf_task_t *tsk, esp_gmf_job_t *job)
+{
+    esp_gmf_job_prof_t *prof = (esp_gmf_job_prof_t *)tsk->prof;
+    while (prof && ((prof->func != job->func) || (prof->ctx != job->ctx))) {
+        prof = prof->next;
+    }
+    if (prof) {
+        return prof;
+    }
+    prof = esp_gmf_oal_calloc(1, sizeof(esp_gmf_job_prof_t));
+    ESP_GMF_MEM_CHECK(TAG, prof, return NULL);
+    prof->label = job->label;
+    prof->func = job->func;
+    prof->ctx = job->ctx;
+    prof->min_us = UINT32_MAX;
+    esp_gmf_oal_mutex_lock(tsk->job_lock);
+    // The record outlives the job, it holds the interned label too
+    GMF_TASK_LABEL_ITEM(prof->label)->ref++;
+    prof->next = (esp_gmf_job_prof_t *)tsk->prof;
+    tsk->prof = prof;
+    esp_gmf_oal_mutex_unlock(tsk->job_lock);
+    return prof;
+}
+
+/**
+ * @brief  Free the records of the context whose jobs are unregistered, the context may be deleted while the task lives on
+ */
+static void esp_gmf_task_prof_release(esp_gmf_task_t *tsk, void *ctx)
+{
+    esp_gmf_oal_mutex_lock(tsk->job_lock);
+    esp_gmf_job_prof_t **pos = (esp_gmf_job_prof_t **)&tsk->prof;
+    while (*pos) {
+        esp_gmf_job_prof_t *prof = *pos;
+        if (prof->ctx == ctx) {
+            *pos = prof->next;
+            esp_gmf_task_label_release(tsk, prof->label);
+            esp_gmf_oal_free(prof);
+        } else {
+            pos = &prof->next;
+        }
+    }
+    esp_gmf_oal_mutex_unlock(tsk->job_lock);
+}
+
+static inline uint32_t esp_gmf_task_prof_percentile(esp_gmf_job_prof_t *prof, uint32_t percent)
+{
+    uint32_t target = (uint32_t)(((uint64_t)prof->call_cnt * percent + 99) / 100);
+    uint32_t cnt = 0;
+    for (int i = 0; i < GMF_TASK_PROF_HIST_NUM - 1; i++) {
+        cnt += prof->hist[i];
+        if (cnt >= target) {
+            uint32_t upper = (1UL << i) - 1;
+            upper = upper > prof->max_us ? prof->max_us : upper;
+            return upper < prof->min_us ? prof->min_us : upper;
+        }
+    }
+    return prof->max_us;
+}
+#endif  /* CONFIG_ESP_GMF_TASK_PROFILING_EN */
+
+static inline esp_gmf_job_err_t esp_gmf_task_call_job_func(esp_gmf_job_t *worker)
+{
+#ifdef CONFIG_ESP_GMF_TASK_PROFILING_EN
+    esp_gmf_job_prof_t *prof = (esp_gmf_job_prof_t *)worker->prof;
+    if (prof) {
+        cur_prof = prof;
+        int64_t start = esp_gmf_oal_sys_get_time_us();
+        esp_gmf_job_err_t ret = worker->func(worker->ctx, NULL);
+        uint32_t cost = (uint32_t)(esp_gmf_oal_sys_get_time_us() - start);
+        cur_prof = NULL;
+        int idx = cost ? (32 - __builtin_clz(cost)) : 0;
+        prof->hist[idx < GMF_TASK_PROF_HIST_NUM ? idx : (GMF_TASK_PROF_HIST_NUM - 1)]++;
+        prof->call_cnt++;
+        prof->total_us += cost;
+        prof->min_us = cost < prof->min_us ? cost : prof->min_us;
+        prof->max_us = cost > prof->max_us ? cost : prof->max_us;
+        return ret;
+    }
+#endif  /* CONFIG_ESP_GMF_TASK_PROFILING_EN */
+    return worker->func(worker->ctx, NULL);
+}
+
+static inline esp_gmf_job_err_t esp_gmf_task_call_job(esp_gmf_task_t *tsk, esp_gmf_job_t *worker)
+{
+    cur_tsk = tsk;
+    if (tsk->slice_us == 0) {
+        cur_slice_end = 0;
+        esp_gmf_job_err_t ret = esp_gmf_task_call_job_func(worker);
+        cur_tsk = NULL;
+        return ret;
+    }
+    cur_slice_end = esp_gmf_oal_sys_get_time_us() + tsk->slice_us;
+    esp_gmf_job_err_t ret = esp_gmf_task_call_job_func(worker);
+    int64_t over_us = esp_gmf_oal_sys_get_time_us() - cur_slice_end;
+    if (over_us > 0) {
+        ESP_LOGD(TAG, "Job overran the time slice by %ld us, [tsk:%s-%p, job:%p-%s]", (long)over_us, OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk,
+                 worker->ctx, worker->label);
+    }
+    cur_tsk = NULL;
+    return ret;
+}
+
+static esp_gmf_job_t *esp_gmf_task_job_alloc(esp_gmf_task_t *tsk, const char *label)
+{
+    esp_gmf_job_t *job = NULL;
+    esp_gmf_oal_mutex_lock(tsk->job_lock);
+    label = esp_gmf_task_intern_label(tsk, label);
+    if (label == NULL) {
+        esp_gmf_oal_mutex_unlock(tsk->job_lock);
+        return NULL;
+    }
+    if (tsk->free_jobs == NULL) {
+        esp_gmf_job_slab_t *slab = esp_gmf_oal_malloc(sizeof(esp_gmf_job_slab_t));
+        ESP_GMF_MEM_CHECK(TAG, slab, { esp_gmf_task_label_release(tsk, label); esp_gmf_oal_mutex_unlock(tsk->job_lock); return NULL;});
+        slab->next = (esp_gmf_job_slab_t *)tsk->job_slabs;
+        tsk->job_slabs = slab;
+        for (int i = 0; i < GMF_TASK_JOB_SLAB_CNT; i++) {
+            slab->jobs[i].next = tsk->free_jobs;
+            tsk->free_jobs = &slab->jobs[i];
+        }
+    }
+    job = tsk->free_jobs;
+    tsk->free_jobs = job->next;
+    esp_gmf_oal_mutex_unlock(tsk->job_lock);
+    memset(job, 0, sizeof(esp_gmf_job_t));
+    job->label = label;
+    return job;
+}
+
+static void esp_gmf_task_job_free(esp_gmf_task_t *tsk, esp_gmf_job_t *job)
+{
+    esp_gmf_oal_mutex_lock(tsk->job_lock);
+    esp_gmf_task_label_release(tsk, job->label);
+    job->label = NULL;
+    job->prev = NULL;
+    job->next = tsk->free_jobs;
+    tsk->free_jobs = job;
+    esp_gmf_oal_mutex_unlock(tsk->job_lock);
 }
 
 static inline void __esp_gmf_task_delete_jobs(esp_gmf_task_handle_t handle)
 {
     esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
-    esp_gmf_node_clear((esp_gmf_node_t **)&tsk->working, esp_gmf_job_item_free);
+    esp_gmf_job_t *job = tsk->working;
+    tsk->working = NULL;
+    tsk->resume_job = NULL;
+    tsk->wait_job = NULL;
+    while (job) {
+        esp_gmf_job_t *next = job->next;
+        esp_gmf_task_job_free(tsk, job);
+        job = next;
+    }
+}
+
+static inline void esp_gmf_task_run_posted(esp_gmf_task_t *tsk)
+{
+    esp_gmf_oal_mutex_lock(tsk->job_lock);
+    esp_gmf_job_t *job = tsk->posted;
+    tsk->posted = NULL;
+    esp_gmf_oal_mutex_unlock(tsk->job_lock);
+    while (job) {
+        esp_gmf_job_t *next = job->next;
+        ESP_LOGD(TAG, "Run posted job, [%s-%p, wk:%p, job:%p-%s]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, job, job->ctx, job->label);
+        job->func(job->ctx, NULL);
+        esp_gmf_task_job_free(tsk, job);
+        job = next;
+    }
+}
+
+/**
+ * @brief  Run the jobs posted since the last wait when all the job chains wait for data, it's the boundary of the frames too
+ *
+ *         The jobs posted again by the posted jobs, e.g. to wait for the truncated input, are left to the next wait
+ *         so that the task doesn't spin on them
+ */
+static inline bool esp_gmf_task_run_posted_on_wait(esp_gmf_task_t *tsk)
+{
+    esp_gmf_oal_mutex_lock(tsk->job_lock);
+    bool has_new = tsk->posted && (tsk->post_cnt != tsk->post_seen);
+    esp_gmf_oal_mutex_unlock(tsk->job_lock);
+    if (has_new == false) {
+        return false;
+    }
+    esp_gmf_task_run_posted(tsk);
+    esp_gmf_oal_mutex_lock(tsk->job_lock);
+    tsk->post_seen = tsk->post_cnt;
+    esp_gmf_oal_mutex_unlock(tsk->job_lock);
+    return true;
+}
+
+static esp_gmf_job_deadline_t *esp_gmf_task_deadline_find(esp_gmf_task_t *tsk, void *ctx)
+{
+    esp_gmf_job_deadline_t *dl = (esp_gmf_job_deadline_t *)tsk->deadlines;
+    while (dl && (dl->ctx != ctx)) {
+        dl = dl->next;
+    }
+    return dl;
+}
+
+/**
+ * @brief  Free the deadline of the context whose jobs are unregistered, no job refers to it any more
+ */
+static void esp_gmf_task_deadline_release(esp_gmf_task_t *tsk, void *ctx)
+{
+    esp_gmf_oal_mutex_lock(tsk->job_lock);
+    esp_gmf_job_deadline_t **pos = (esp_gmf_job_deadline_t **)&tsk->deadlines;
+    while (*pos && ((*pos)->ctx != ctx)) {
+        pos = &(*pos)->next;
+    }
+    esp_gmf_job_deadline_t *dl = *pos;
+    if (dl) {
+        *pos = dl->next;
+        esp_gmf_oal_free(dl);
+    }
+    esp_gmf_oal_mutex_unlock(tsk->job_lock);
+}
+
+static inline bool esp_gmf_task_job_is_due(esp_gmf_job_t *job, int64_t now)
+{
+    esp_gmf_job_deadline_t *dl = (esp_gmf_job_deadline_t *)job->deadline;
+    // A job waiting for data is run in list order, after the jobs which feed it
+    return dl && dl->period_us && (job->release_us <= now) && (job->ret != ESP_GMF_JOB_ERR_WAIT);
+}
+
+/**
+ * @brief  Pick the released job with the earliest deadline to run before `next`, which is resumed after it
+ */
+static inline esp_gmf_job_t *esp_gmf_task_deadline_pick(esp_gmf_task_t *tsk, esp_gmf_job_t *next)
+{
+    if ((tsk->deadlines == NULL) || !GMF_TASK_JOB_IS_VALID(next)) {
+        return next;
+    }
+    int64_t now = esp_gmf_oal_sys_get_time_us();
+    esp_gmf_job_t *due = NULL;
+    int64_t due_at = INT64_MAX;
+    for (esp_gmf_job_t *job = tsk->working; job; job = job->next) {
+        if (esp_gmf_task_job_is_due(job, now)
+            && (job->release_us + ((esp_gmf_job_deadline_t *)job->deadline)->deadline_us < due_at)) {
+            due = job;
+            due_at = job->release_us + ((esp_gmf_job_deadline_t *)job->deadline)->deadline_us;
+        }
+    }
+    if ((due == NULL) || (due == next)) {
+        return next;
+    }
+    ESP_LOGV(TAG, "Run job ahead for deadline, [tsk:%s-%p, job:%p-%s, next:%s]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk,
+             due->ctx, due->label, next->label);
+    tsk->resume_job = next;
+    return due;
+}
+
+/**
+ * @brief  Move the job to its next period once it completes the released one, report the miss when it completes late
+ */
+static inline void esp_gmf_task_deadline_check(esp_gmf_task_t *tsk, esp_gmf_job_t *job)
+{
+    esp_gmf_job_deadline_t *dl = (esp_gmf_job_deadline_t *)job->deadline;
+    if ((dl == NULL) || (dl->period_us == 0) || (job->ret == ESP_GMF_JOB_ERR_WAIT)) {
+        return;
+    }
+    int64_t now = esp_gmf_oal_sys_get_time_us();
+    if (now < job->release_us) {
+        // Run in list order ahead of its period
+        return;
+    }
+    int64_t due_at = job->release_us + dl->deadline_us;
+    job->release_us += dl->period_us;
+    if (now <= due_at) {
+        return;
+    }
+    if (job->release_us + dl->deadline_us < now) {
+        // Too late to catch up, restart the periods from now rather than report a miss for each of them
+        job->release_us = now;
+    }
+    dl->miss_cnt++;
+    esp_gmf_job_deadline_miss_t miss = {
+        .label = job->label,
+        .ctx = job->ctx,
+        .late_us = (uint32_t)(now - due_at),
+        .miss_cnt = dl->miss_cnt,
+    };
+    ESP_LOGD(TAG, "Deadline missed, [tsk:%s-%p, job:%p-%s], late:%ld us", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, job->ctx, job->label,
+             (long)miss.late_us);
+    if (tsk->event_func) {
+        esp_gmf_event_pkt_t evt = {
+            .from = tsk,
+            .type = ESP_GMF_EVT_TYPE_DEADLINE_MISS,
+            .sub = 0,
+            .payload = &miss,
+            .payload_size = sizeof(miss),
+        };
+        tsk->event_func(&evt, tsk->ctx);
+    }
+}
+
+/**
+ * @brief  Get the ticks to wait for the data, bounded by the next release of the jobs with deadline
+ */
+static inline TickType_t esp_gmf_task_deadline_wait_ticks(esp_gmf_task_t *tsk)
+{
+    if (tsk->deadlines == NULL) {
+        return portMAX_DELAY;
+    }
+    int64_t release_us = INT64_MAX;
+    for (esp_gmf_job_t *job = tsk->working; job; job = job->next) {
+        if (esp_gmf_task_job_is_due(job, INT64_MAX) && (job->release_us < release_us)) {
+            release_us = job->release_us;
+        }
+    }
+    if (release_us == INT64_MAX) {
+        return portMAX_DELAY;
+    }
+    int64_t wait_us = release_us - esp_gmf_oal_sys_get_time_us();
+    return wait_us > 0 ? (TickType_t)(wait_us / 1000 / portTICK_PERIOD_MS + 1) : 0;
+}
+
+static inline void esp_gmf_task_deadline_reset(esp_gmf_task_t *tsk)
+{
+    tsk->resume_job = NULL;
+    if (tsk->deadlines == NULL) {
+        return;
+    }
+    int64_t now = esp_gmf_oal_sys_get_time_us();
+    for (esp_gmf_job_t *job = tsk->working; job; job = job->next) {
+        job->release_us = now;
+    }
 }
 
 static inline esp_gmf_job_t *_esp_gmf_get_next_job(esp_gmf_task_t *tsk, esp_gmf_job_t *worker)
@@ -154,7 +628,7 @@ static inline esp_gmf_job_t *_esp_gmf_get_next_job(esp_gmf_task_t *tsk, esp_gmf_
     if (worker->times == ESP_GMF_JOB_TIMES_ONCE) {
         ESP_LOGI(TAG, "One times job is complete, del[wk:%p, ctx:%p, label:%s]", worker, worker->ctx, worker->label);
         esp_gmf_node_del_at((esp_gmf_node_t **)&tsk->working, (esp_gmf_node_t *)worker);
-        esp_gmf_job_item_free(worker);
+        esp_gmf_task_job_free(tsk, worker);
     }
     if (next_job) {
         return next_job;
@@ -167,101 +641,269 @@ static inline esp_gmf_job_t *_esp_gmf_get_next_job(esp_gmf_task_t *tsk, esp_gmf_
     return next_job;
 }
 
-static inline int process_func(esp_gmf_task_handle_t handle, void *para)
+static inline bool esp_gmf_task_job_starts_chain(esp_gmf_task_t *tsk, esp_gmf_job_t *job)
+{
+    // The open and process jobs of an element are marked both, they are in the same chain
+    return (job == tsk->working) || (job->chain_head && (job->prev->ctx != job->ctx));
+}
+
+/**
+ * @brief  Get the job to run for the chain starting at `job`, it's the waiting job when the chain was left at it
+ */
+static inline esp_gmf_job_t *esp_gmf_task_chain_resume(esp_gmf_task_t *tsk, esp_gmf_job_t *job)
+{
+    if (!GMF_TASK_JOB_IS_VALID(job) || !esp_gmf_task_job_starts_chain(tsk, job)) {
+        return job;
+    }
+    esp_gmf_job_t *pos = job;
+    do {
+        if (pos->chain_wait) {
+            return pos;
+        }
+        pos = pos->next;
+    } while (pos && !esp_gmf_task_job_starts_chain(tsk, pos));
+    return job;
+}
+
+/**
+ * @brief  Leave the chain of the job which waits for data, the jobs behind it in the chain depend on it
+ *
+ *         Go on with the next chain, the task sleeps when the loop comes back to the first waiting job without any progress
+ */
+static inline int esp_gmf_task_chain_leave(esp_gmf_task_t *tsk, esp_gmf_job_t *worker)
+{
+    worker->chain_wait = 1;
+    if (tsk->wait_job == NULL) {
+        tsk->wait_job = worker;
+    }
+    esp_gmf_job_t *next = worker->next;
+    while (next && !esp_gmf_task_job_starts_chain(tsk, next)) {
+        next = next->next;
+    }
+    next = esp_gmf_task_chain_resume(tsk, next ? next : tsk->working);
+    if (next != tsk->wait_job) {
+        tsk->cur_job = esp_gmf_task_deadline_pick(tsk, next);
+        return GMF_TASK_LOOP_NEXT;
+    }
+    tsk->wait_job = NULL;
+    // Run the released job with deadline before sleeping for the data
+    tsk->cur_job = esp_gmf_task_deadline_pick(tsk, next);
+    if (tsk->cur_job != next) {
+        return GMF_TASK_LOOP_NEXT;
+    }
+    if (esp_gmf_task_run_posted_on_wait(tsk)) {
+        // The posted jobs may change the job list, try the chains again before sleeping
+        next = tsk->cur_job ? tsk->cur_job : tsk->working;
+        tsk->cur_job = esp_gmf_task_deadline_pick(tsk, esp_gmf_task_chain_resume(tsk, next));
+        return GMF_TASK_JOB_IS_VALID(tsk->cur_job) ? GMF_TASK_LOOP_NEXT : GMF_TASK_LOOP_QUIT;
+    }
+    return GMF_TASK_LOOP_WAIT;
+}
+
+static inline int esp_gmf_task_loop_enter(esp_gmf_task_t *tsk)
 {
-    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
     esp_gmf_job_t *worker = tsk->working;
     if ((worker == NULL) || (worker->func == NULL)) {
         ESP_LOGE(TAG, "Jobs list are invalid[%p, %p]", tsk, worker);
         return ESP_GMF_ERR_INVALID_ARG;
     }
-    int result = ESP_GMF_ERR_OK;
     GMF_TASK_CLR_STATE_BITS(tsk->event_group, GMF_TASK_STOP_BIT);
-    esp_gmf_event_state_t quit_state = ESP_GMF_EVENT_STATE_STOPPED;
-    while (worker && worker->func) {
-        ESP_LOGD(TAG, "Running, job:%p, ctx:%p", worker->func, worker->ctx);
-        worker->ret = worker->func(worker->ctx, NULL);
-        ESP_LOGV(TAG, "Job ret:%d, [tsk:%s-%p:%p-%p-%s]", worker->ret, OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label);
-        if (worker->ret == ESP_GMF_JOB_ERR_CONTINUE) {
-            // The means need more loops
-            worker = tsk->working;
-            // When receive command need process command
-            if (tsk->_pause == false && tsk->_stop == false) {
-                continue;
-            }
-        } else if (worker->ret == ESP_GMF_JOB_ERR_TRUNCATE) {
-            ESP_LOGD(TAG, "Job truncated [tsk:%s-%p:%p-%p-%s], st:%s", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label,
-                     esp_gmf_event_get_state_str(tsk->state));
-            esp_gmf_job_stack_push(tsk->start_stack, (uint32_t)worker);
-        } else if (worker->ret == ESP_GMF_JOB_ERR_DONE) {
-            ESP_LOGI(TAG, "Job is done, [tsk:%s-%p, wk:%p, job:%p-%s]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label);
-            esp_gmf_job_t *tmp = worker->next;
-            esp_gmf_node_del_at((esp_gmf_node_t **)&tsk->working, (esp_gmf_node_t *)worker);
-            esp_gmf_job_stack_remove(tsk->start_stack, (uint32_t)worker);
-            esp_gmf_job_item_free(worker);
-            worker = tmp;
-            if (worker == NULL) {
-                ESP_LOGD(TAG, "All jobs are finished, [tsk:%s-%p]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk);
-                quit_state = ESP_GMF_EVENT_STATE_FINISHED;
-                break;
-            }
-            continue;
-        } else if (worker->ret == ESP_GMF_JOB_ERR_FAIL) {
-            ESP_LOGE(TAG, "Job failed[tsk:%s-%p:%p-%p-%s], ret:%d, st:%s", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label, worker->ret,
-                     esp_gmf_event_get_state_str(tsk->state));
-            if (tsk->state != ESP_GMF_EVENT_STATE_STOPPED) {
-                __esp_gmf_task_delete_jobs(tsk);
-                quit_state = ESP_GMF_EVENT_STATE_ERROR;
-                break;
-            }
+    tsk->quit_state = ESP_GMF_EVENT_STATE_STOPPED;
+    tsk->cur_job = worker;
+    tsk->wait_job = NULL;
+    esp_gmf_task_deadline_reset(tsk);
+    esp_gmf_oal_mutex_lock(tsk->job_lock);
+    tsk->accept_post = true;
+    esp_gmf_oal_mutex_unlock(tsk->job_lock);
+    return ESP_GMF_ERR_OK;
+}
+
+static inline void esp_gmf_task_loop_resumed(esp_gmf_task_t *tsk)
+{
+    esp_gmf_job_t *worker = tsk->cur_job;
+    ESP_LOGI(TAG, "Resume job, [%s-%p, wk:%p, job:%p-%s]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label);
+    esp_gmf_task_event_state_change_and_notify(tsk, ESP_GMF_EVENT_STATE_RUNNING);
+    GMF_TASK_SET_STATE_BITS(tsk->event_group, GMF_TASK_RESUME_BIT);
+    tsk->_pause = 0;
+}
+
+static inline int esp_gmf_task_loop_advance(esp_gmf_task_t *tsk)
+{
+    esp_gmf_job_t *worker = tsk->cur_job;
+    if (tsk->_stop && (tsk->state != ESP_GMF_EVENT_STATE_ERROR)) {
+        ESP_LOGV(TAG, "Stop job, [%s-%p, wk:%p, job:%p-%s]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label);
+        __esp_gmf_task_delete_jobs(tsk);
+        tsk->quit_state = ESP_GMF_EVENT_STATE_STOPPED;
+        tsk->_stop = 0;
+        return GMF_TASK_LOOP_QUIT;
+    }
+    if ((worker->ret == ESP_GMF_JOB_ERR_WAIT) && (tsk->resume_job == NULL)) {
+        // The job is not ready yet, skip its successors which depend on it rather than the independent chains
+        return esp_gmf_task_chain_leave(tsk, worker);
+    }
+    ESP_LOGD(TAG, "Find next job to process, [%s-%p, cur:%p-%p-%s]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label);
+    esp_gmf_job_t *next = tsk->resume_job;
+    if (next) {
+        // Go on in list order after the job run ahead for its deadline
+        tsk->resume_job = NULL;
+    } else {
+        bool list_end = (worker->next == NULL);
+        next = _esp_gmf_get_next_job(tsk, worker);
+        if (list_end && tsk->posted) {
+            // The end of the job list is the boundary of the frames, the posted jobs may change the list
+            tsk->cur_job = next;
+            esp_gmf_task_run_posted(tsk);
+            next = tsk->cur_job;
         }
-        if (tsk->_pause) {
-            if (tsk->state != ESP_GMF_EVENT_STATE_ERROR) {
-                ESP_LOGI(TAG, "Pause job, [%s-%p, wk:%p, job:%p-%s],st:%s", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label,
-                         esp_gmf_event_get_state_str(tsk->state));
-                esp_gmf_task_event_state_change_and_notify(tsk, ESP_GMF_EVENT_STATE_PAUSED);
-                GMF_TASK_SET_STATE_BITS(tsk->event_group, GMF_TASK_PAUSE_BIT);
-                esp_gmf_task_acquire_signal(tsk, portMAX_DELAY);
-                ESP_LOGI(TAG, "Resume job, [%s-%p, wk:%p, job:%p-%s]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label);
-                esp_gmf_task_event_state_change_and_notify(tsk, ESP_GMF_EVENT_STATE_RUNNING);
-                GMF_TASK_SET_STATE_BITS(tsk->event_group, GMF_TASK_RESUME_BIT);
-            } else {
-                ESP_LOGI(TAG, "Skip pause by error state, [%s-%p, wk:%p, job:%p-%s],st:%s", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label,
-                         esp_gmf_event_get_state_str(tsk->state));
+    }
+    tsk->cur_job = esp_gmf_task_deadline_pick(tsk, esp_gmf_task_chain_resume(tsk, next));
+    ESP_LOGD(TAG, "Found next job[%p] to process", tsk->cur_job);
+    return GMF_TASK_JOB_IS_VALID(tsk->cur_job) ? GMF_TASK_LOOP_NEXT : GMF_TASK_LOOP_QUIT;
+}
+
+/**
+ * @brief  Run the current job once and move to the job for the next iteration
+ *
+ *         Return GMF_TASK_LOOP_NEXT to keep on looping, GMF_TASK_LOOP_PARK when the loop is paused in pool mode,
+ *         it is continued by `esp_gmf_task_loop_resumed` on the next dispatch, GMF_TASK_LOOP_WAIT when no job chain is ready,
+ *         the waiting job runs again after the task is woken up, GMF_TASK_LOOP_QUIT when the loop is finished
+ */
+static inline int esp_gmf_task_loop_step(esp_gmf_task_t *tsk)
+{
+    esp_gmf_job_t *worker = tsk->cur_job;
+    ESP_LOGD(TAG, "Running, job:%p, ctx:%p", worker->func, worker->ctx);
+    worker->chain_wait = 0;
+    worker->ret = esp_gmf_task_call_job(tsk, worker);
+    ESP_LOGV(TAG, "Job ret:%d, [tsk:%s-%p:%p-%p-%s]", worker->ret, OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label);
+    esp_gmf_task_deadline_check(tsk, worker);
+    if (worker->ret != ESP_GMF_JOB_ERR_WAIT) {
+        tsk->wait_job = NULL;
+    }
+    if (worker->ret == ESP_GMF_JOB_ERR_CONTINUE) {
+        // The means need more loops
+        tsk->resume_job = NULL;
+        worker = esp_gmf_task_deadline_pick(tsk, esp_gmf_task_chain_resume(tsk, tsk->working));
+        tsk->cur_job = worker;
+        // When receive command need process command
+        if (tsk->_pause == false && tsk->_stop == false) {
+            return GMF_TASK_JOB_IS_VALID(worker) ? GMF_TASK_LOOP_NEXT : GMF_TASK_LOOP_QUIT;
+        }
+    } else if (worker->ret == ESP_GMF_JOB_ERR_WAIT) {
+        ESP_LOGV(TAG, "Job wait [tsk:%s-%p:%p-%p-%s]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label);
+        // The job run ahead for its deadline doesn't block the jobs which feed it, go on in list order
+        if (tsk->resume_job == NULL && tsk->_pause == false && tsk->_stop == false) {
+            return esp_gmf_task_chain_leave(tsk, worker);
+        }
+    } else if (worker->ret == ESP_GMF_JOB_ERR_TRUNCATE) {
+        ESP_LOGD(TAG, "Job truncated [tsk:%s-%p:%p-%p-%s], st:%s", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label,
+                 esp_gmf_event_get_state_str(tsk->state));
+        esp_gmf_job_stack_push(tsk->start_stack, (uint32_t)worker);
+    } else if (worker->ret == ESP_GMF_JOB_ERR_DONE) {
+        ESP_LOGI(TAG, "Job is done, [tsk:%s-%p, wk:%p, job:%p-%s]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label);
+        esp_gmf_job_t *tmp = tsk->resume_job ? tsk->resume_job : worker->next;
+        tsk->resume_job = NULL;
+        esp_gmf_node_del_at((esp_gmf_node_t **)&tsk->working, (esp_gmf_node_t *)worker);
+        esp_gmf_job_stack_remove(tsk->start_stack, (uint32_t)worker);
+        esp_gmf_task_job_free(tsk, worker);
+        // The last job may be done before the others, e.g. a branch fed by the pipeline, go on with the left jobs
+        tmp = esp_gmf_task_chain_resume(tsk, tmp ? tmp : tsk->working);
+        tsk->cur_job = tmp;
+        if (tmp == NULL) {
+            ESP_LOGD(TAG, "All jobs are finished, [tsk:%s-%p]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk);
+            tsk->quit_state = ESP_GMF_EVENT_STATE_FINISHED;
+            return GMF_TASK_LOOP_QUIT;
+        }
+        return GMF_TASK_JOB_IS_VALID(tmp) ? GMF_TASK_LOOP_NEXT : GMF_TASK_LOOP_QUIT;
+    } else if (worker->ret == ESP_GMF_JOB_ERR_FAIL) {
+        ESP_LOGE(TAG, "Job failed[tsk:%s-%p:%p-%p-%s], ret:%d, st:%s", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label, worker->ret,
+                 esp_gmf_event_get_state_str(tsk->state));
+        if (tsk->state != ESP_GMF_EVENT_STATE_STOPPED) {
+            __esp_gmf_task_delete_jobs(tsk);
+            tsk->quit_state = ESP_GMF_EVENT_STATE_ERROR;
+            return GMF_TASK_LOOP_QUIT;
+        }
+    }
+    if (tsk->_pause) {
+        if (tsk->state != ESP_GMF_EVENT_STATE_ERROR) {
+            ESP_LOGI(TAG, "Pause job, [%s-%p, wk:%p, job:%p-%s],st:%s", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label,
+                     esp_gmf_event_get_state_str(tsk->state));
+            esp_gmf_task_event_state_change_and_notify(tsk, ESP_GMF_EVENT_STATE_PAUSED);
+            if (tsk->pool) {
+                // Give the worker back to the pool, resume or stop will submit the task again
+                tsk->_parked = 1;
                 GMF_TASK_SET_STATE_BITS(tsk->event_group, GMF_TASK_PAUSE_BIT);
+                return GMF_TASK_LOOP_PARK;
             }
+            GMF_TASK_SET_STATE_BITS(tsk->event_group, GMF_TASK_PAUSE_BIT);
+            esp_gmf_task_acquire_signal(tsk, portMAX_DELAY);
+            esp_gmf_task_loop_resumed(tsk);
+        } else {
+            ESP_LOGI(TAG, "Skip pause by error state, [%s-%p, wk:%p, job:%p-%s],st:%s", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label,
+                     esp_gmf_event_get_state_str(tsk->state));
+            GMF_TASK_SET_STATE_BITS(tsk->event_group, GMF_TASK_PAUSE_BIT);
             tsk->_pause = 0;
         }
-        if (tsk->_stop && (tsk->state != ESP_GMF_EVENT_STATE_ERROR)) {
-            ESP_LOGV(TAG, "Stop job, [%s-%p, wk:%p, job:%p-%s]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label);
-            __esp_gmf_task_delete_jobs(tsk);
-            quit_state = ESP_GMF_EVENT_STATE_STOPPED;
-            tsk->_stop = 0;
-            break;
-        }
-        ESP_LOGD(TAG, "Find next job to process, [%s-%p, cur:%p-%p-%s]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, worker, worker->ctx, worker->label);
-        worker = _esp_gmf_get_next_job(tsk, worker);
-        ESP_LOGD(TAG, "Found next job[%p] to process", worker);
     }
+    return esp_gmf_task_loop_advance(tsk);
+}
+
+static inline void esp_gmf_task_loop_exit(esp_gmf_task_t *tsk)
+{
     // Load quit jobs and run
     esp_gmf_job_stack_clear(tsk->start_stack);
-    esp_gmf_task_event_loading_job(tsk, quit_state);
+    esp_gmf_task_event_loading_job(tsk, tsk->quit_state);
     ESP_LOGV(TAG, "Worker exit, [%p-%s], st:%s", tsk, OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), esp_gmf_event_get_state_str(tsk->state));
-    worker = tsk->working;
+    esp_gmf_job_t *worker = tsk->working;
     while (worker && worker->func) {
-        worker->ret = worker->func(worker->ctx, NULL);
+        worker->ret = esp_gmf_task_call_job(tsk, worker);
         // Failed when do clear up set state to error, continue to clear up for other jobs
         if (worker->ret != ESP_GMF_JOB_ERR_OK) {
-            quit_state = ESP_GMF_EVENT_STATE_ERROR;
+            tsk->quit_state = ESP_GMF_EVENT_STATE_ERROR;
         }
         worker = _esp_gmf_get_next_job(tsk, worker);
     }
-    tsk->state = quit_state;
+    tsk->cur_job = NULL;
+    esp_gmf_oal_mutex_lock(tsk->job_lock);
+    tsk->accept_post = false;
+    esp_gmf_oal_mutex_unlock(tsk->job_lock);
+    // A stop request which raced with the end of the jobs is served by this quit, don't leak it to the next run
+    tsk->_stop = 0;
+    tsk->state = tsk->quit_state;
+    // No more job to post from now on, run the posted ones which the job loop didn't reach
+    esp_gmf_task_run_posted(tsk);
     esp_gmf_event_state_notify(tsk, ESP_GMF_EVT_TYPE_CHANGE_STATE, tsk->state);
     GMF_TASK_SET_STATE_BITS(tsk->event_group, GMF_TASK_STOP_BIT);
+}
+
+static inline int process_func(esp_gmf_task_handle_t handle, void *para)
+{
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    int result = esp_gmf_task_loop_enter(tsk);
+    if (result != ESP_GMF_ERR_OK) {
+        return result;
+    }
+    while ((result = esp_gmf_task_loop_step(tsk)) != GMF_TASK_LOOP_QUIT) {
+        if (result == GMF_TASK_LOOP_WAIT) {
+            // Sleep until any port is ready, a command is received or a job with deadline is released
+            xSemaphoreTake(tsk->block_sem, esp_gmf_task_deadline_wait_ticks(tsk));
+        }
+    }
+    result = ESP_GMF_ERR_OK;
+    esp_gmf_task_loop_exit(tsk);
     return result;
 }
 
+static inline int esp_gmf_task_prepare(esp_gmf_task_t *tsk)
+{
+    int ret = esp_gmf_task_event_state_change_and_notify(tsk, ESP_GMF_EVENT_STATE_RUNNING);
+    GMF_TASK_SET_STATE_BITS(tsk->event_group, GMF_TASK_RUN_BIT);
+    if (ret != ESP_GMF_ERR_OK) {
+        tsk->_running = 0;
+        ESP_LOGE(TAG, "Failed on prepare, [%s,%p],ret:%d", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, ret);
+    }
+    return ret;
+}
+
 static void esp_gmf_thread_fun(void *pv)
 {
     esp_gmf_task_t *tsk = (esp_gmf_task_t *)pv;
@@ -280,11 +922,7 @@ static void esp_gmf_thread_fun(void *pv)
                 tsk->_run = 0;
             }
         }
-        int ret = esp_gmf_task_event_state_change_and_notify(tsk, ESP_GMF_EVENT_STATE_RUNNING);
-        GMF_TASK_SET_STATE_BITS(tsk->event_group, GMF_TASK_RUN_BIT);
-        if (ret != ESP_GMF_ERR_OK) {
-            tsk->_running = 0;
-            ESP_LOGE(TAG, "Failed on prepare, [%s,%p],ret:%d", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, ret);
+        if (esp_gmf_task_prepare(tsk) != ESP_GMF_ERR_OK) {
             continue;
         }
         // Loop jobs until done or error
@@ -299,6 +937,104 @@ ESP_GMF_THREAD_EXIT:
     esp_gmf_oal_thread_delete(oal_thread);
 }
 
+static void esp_gmf_task_wake_timer_cb(TimerHandle_t timer)
+{
+    // Runs in the timer service task, which must not wait for the pool lock
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)pvTimerGetTimerID(timer);
+    if (esp_gmf_task_pool_post(tsk->pool, &tsk->pool_item) != ESP_GMF_ERR_OK) {
+        // The post queue is full, try again on the next tick
+        xTimerChangePeriod(timer, 1, 0);
+    }
+}
+
+/**
+ * @brief  Give the worker back to the pool until a port is ready
+ *
+ *         The pool task has no thread to sleep with a timeout, so a one-shot timer dispatches it again
+ *         at the next release of the jobs with deadline
+ */
+static esp_gmf_task_pool_exec_ret_t esp_gmf_task_pool_wait(esp_gmf_task_t *tsk)
+{
+    TickType_t ticks = esp_gmf_task_deadline_wait_ticks(tsk);
+    if (ticks == portMAX_DELAY) {
+        return ESP_GMF_TASK_POOL_EXEC_IDLE;
+    }
+    if (ticks == 0) {
+        return ESP_GMF_TASK_POOL_EXEC_YIELD;
+    }
+    if (tsk->wake_timer == NULL) {
+        tsk->wake_timer = xTimerCreate(OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), ticks, pdFALSE, tsk, esp_gmf_task_wake_timer_cb);
+        // Without timer poll the release by yielding to the other items
+        ESP_GMF_MEM_CHECK(TAG, tsk->wake_timer, return ESP_GMF_TASK_POOL_EXEC_YIELD);
+    }
+    xTimerChangePeriod((TimerHandle_t)tsk->wake_timer, ticks, 0);
+    return ESP_GMF_TASK_POOL_EXEC_IDLE;
+}
+
+static esp_gmf_task_pool_exec_ret_t esp_gmf_task_pool_exec(void *ctx, uint16_t job_slice)
+{
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)ctx;
+    int st = GMF_TASK_LOOP_NEXT;
+    if (tsk->_in_loop == 0) {
+        if (tsk->_destroy) {
+            goto ESP_GMF_POOL_EXIT;
+        }
+        if (tsk->_run == 1) {
+            tsk->_running = 1;
+            tsk->_run = 0;
+        }
+        if ((tsk->working == NULL) || (tsk->_running == 0)) {
+            ESP_LOGD(TAG, "Waiting to run... [tsk:%s-%p, wk:%p, run:%d]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, tsk->working, tsk->_running);
+            return ESP_GMF_TASK_POOL_EXEC_IDLE;
+        }
+        if (esp_gmf_task_prepare(tsk) != ESP_GMF_ERR_OK) {
+            return ESP_GMF_TASK_POOL_EXEC_IDLE;
+        }
+        if (esp_gmf_task_loop_enter(tsk) != ESP_GMF_ERR_OK) {
+            tsk->_running = 0;
+            return ESP_GMF_TASK_POOL_EXEC_IDLE;
+        }
+        tsk->_in_loop = 1;
+    } else if (tsk->_parked) {
+        tsk->_parked = 0;
+        esp_gmf_task_loop_resumed(tsk);
+        st = esp_gmf_task_loop_advance(tsk);
+    }
+    int64_t slice_end = tsk->slice_us ? esp_gmf_oal_sys_get_time_us() + tsk->slice_us : 0;
+    while ((st == GMF_TASK_LOOP_NEXT) && job_slice--) {
+        st = esp_gmf_task_loop_step(tsk);
+        if (slice_end && (esp_gmf_oal_sys_get_time_us() >= slice_end)) {
+            // The time slice is used up, give the worker to the other tasks
+            break;
+        }
+    }
+    if (st == GMF_TASK_LOOP_NEXT) {
+        return ESP_GMF_TASK_POOL_EXEC_YIELD;
+    }
+    if (st == GMF_TASK_LOOP_WAIT) {
+        // Dispatched again by the readiness notification, a command or the release of a job with deadline
+        return esp_gmf_task_pool_wait(tsk);
+    }
+    if (st == GMF_TASK_LOOP_PARK) {
+        // Dispatched again by resume or stop
+        return ESP_GMF_TASK_POOL_EXEC_IDLE;
+    }
+    esp_gmf_task_loop_exit(tsk);
+    if (tsk->wake_timer) {
+        xTimerStop((TimerHandle_t)tsk->wake_timer, 0);
+    }
+    tsk->_in_loop = 0;
+    tsk->_running = 0;
+    if (tsk->_destroy == 0) {
+        return ESP_GMF_TASK_POOL_EXEC_IDLE;
+    }
+ESP_GMF_POOL_EXIT:
+    tsk->state = ESP_GMF_EVENT_STATE_NONE;
+    GMF_TASK_SET_STATE_BITS(tsk->event_group, GMF_TASK_EXIT_BIT);
+    ESP_LOGD(TAG, "Task detached from pool, [%s,%p]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk);
+    return ESP_GMF_TASK_POOL_EXEC_IDLE;
+}
+
 static esp_gmf_err_t _task_new(void *cfg, esp_gmf_obj_handle_t *handle)
 {
     return esp_gmf_task_init((esp_gmf_task_cfg_t *)cfg, handle);
@@ -312,13 +1048,17 @@ esp_gmf_err_t esp_gmf_task_init(esp_gmf_task_cfg_t *config, esp_gmf_task_handle_
     ESP_GMF_MEM_CHECK(TAG, handle, return ESP_GMF_ERR_MEMORY_LACK);
     handle->lock = esp_gmf_oal_mutex_create();
     ESP_GMF_MEM_CHECK(TAG, handle->lock, goto _tsk_init_failed);
+    handle->job_lock = esp_gmf_oal_mutex_create();
+    ESP_GMF_MEM_CHECK(TAG, handle->job_lock, goto _tsk_init_failed);
     handle->event_group = xEventGroupCreate();
     ESP_GMF_MEM_CHECK(TAG, handle->event_group, goto _tsk_init_failed);
-    handle->block_sem = xSemaphoreCreateBinary();
-    ESP_GMF_MEM_CHECK(TAG, handle->block_sem, goto _tsk_init_failed);
-    handle->wait_sem = xSemaphoreCreateBinary();
-    ESP_GMF_MEM_CHECK(TAG, handle->wait_sem, goto _tsk_init_failed);
     esp_gmf_task_cfg_t *cfg = (esp_gmf_task_cfg_t *)config;
+    if (cfg->pool == NULL) {
+        handle->block_sem = xSemaphoreCreateBinary();
+        ESP_GMF_MEM_CHECK(TAG, handle->block_sem, goto _tsk_init_failed);
+        handle->wait_sem = xSemaphoreCreateBinary();
+        ESP_GMF_MEM_CHECK(TAG, handle->wait_sem, goto _tsk_init_failed);
+    }
     handle->event_func = cfg->cb;
     handle->ctx = cfg->ctx;
     handle->api_sync_time = DEFAULT_TASK_OPT_MAX_TIME_MS;
@@ -357,7 +1097,14 @@ esp_gmf_err_t esp_gmf_task_init(esp_gmf_task_cfg_t *config, esp_gmf_task_handle_
         handle->thread.core = DEFAULT_ESP_GMF_TASK_CORE;
     }
     handle->_task_run = true;
-    if (handle->thread.stack > 0) {
+    if (cfg->pool) {
+        // Jobs are run by the pool workers, no dedicated thread for this task
+        handle->pool = cfg->pool;
+        handle->pool_item.exec = esp_gmf_task_pool_exec;
+        handle->pool_item.ctx = handle;
+        handle->pool_item.affinity = -1;
+        ESP_LOGD(TAG, "Task bind to pool, [%s,%p], pool:%p", OBJ_GET_TAG(obj), handle, handle->pool);
+    } else if (handle->thread.stack > 0) {
         ret = esp_gmf_oal_thread_create(&handle->oal_thread, OBJ_GET_TAG(obj), esp_gmf_thread_fun, handle, handle->thread.stack,
                                         handle->thread.prio, handle->thread.stack_in_ext, handle->thread.core);
         if (ret == ESP_GMF_ERR_FAIL) {
@@ -388,11 +1135,20 @@ esp_gmf_err_t esp_gmf_task_deinit(esp_gmf_task_handle_t handle)
     }
     tsk->_task_run = 0;
     tsk->_destroy = 1;
-    xSemaphoreGive(tsk->block_sem);
+    esp_gmf_task_wakeup(tsk);
     // Wait for task exit
     if (GMF_TASK_WAIT_FOR_STATE_BITS(tsk->event_group, GMF_TASK_EXIT_BIT, portMAX_DELAY) == false) {
         ESP_LOGE(TAG, "Failed to wait task %p to exit", tsk);
     }
+    if (tsk->wake_timer) {
+        // Delete the timer first, so its last post is dropped by the removal below
+        xTimerDelete((TimerHandle_t)tsk->wake_timer, portMAX_DELAY);
+        tsk->wake_timer = NULL;
+    }
+    if (tsk->pool) {
+        // Make sure no worker still references the task before free it
+        esp_gmf_task_pool_remove(tsk->pool, &tsk->pool_item);
+    }
     ESP_LOGD(TAG, "%s, %s", __func__, OBJ_GET_TAG(tsk));
     __esp_gmf_task_delete_jobs(tsk);
     esp_gmf_oal_mutex_unlock(tsk->lock);
@@ -401,18 +1157,21 @@ esp_gmf_err_t esp_gmf_task_deinit(esp_gmf_task_handle_t handle)
     return ESP_GMF_ERR_OK;
 }
 
-esp_gmf_err_t esp_gmf_task_register_ready_job(esp_gmf_task_handle_t handle, const char *label, esp_gmf_job_func job, esp_gmf_job_times_t times, void *ctx, bool done)
+static esp_gmf_job_t *esp_gmf_task_new_job(esp_gmf_task_t *tsk, const char *label, esp_gmf_job_func job, esp_gmf_job_times_t times, void *ctx)
 {
-    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
-    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
-    esp_gmf_job_t *new_job = NULL;
-    new_job = esp_gmf_oal_calloc(1, sizeof(esp_gmf_job_t));
-    ESP_GMF_MEM_CHECK(TAG, new_job, return ESP_GMF_ERR_MEMORY_LACK;);
-    new_job->label = esp_gmf_oal_strdup(label == NULL ? "NULL" : label);
-    ESP_GMF_MEM_CHECK(TAG, new_job->label, { esp_gmf_oal_free(new_job); return ESP_GMF_ERR_MEMORY_LACK;});
+    esp_gmf_job_t *new_job = esp_gmf_task_job_alloc(tsk, label == NULL ? "NULL" : label);
+    ESP_GMF_MEM_CHECK(TAG, new_job, return NULL);
     new_job->func = job;
     new_job->ctx = ctx;
     new_job->times = times;
+    if ((times == ESP_GMF_JOB_TIMES_INFINITE) && tsk->deadlines) {
+        new_job->deadline = esp_gmf_task_deadline_find(tsk, ctx);
+        new_job->release_us = esp_gmf_oal_sys_get_time_us();
+    }
+#ifdef CONFIG_ESP_GMF_TASK_PROFILING_EN
+    // Without record the job is just not profiled
+    new_job->prof = esp_gmf_task_prof_get(tsk, new_job);
+#endif  /* CONFIG_ESP_GMF_TASK_PROFILING_EN */
 
     // Add the first infinite processing job to the stack
     bool is_empty = false;
@@ -420,7 +1179,15 @@ esp_gmf_err_t esp_gmf_task_register_ready_job(esp_gmf_task_handle_t handle, cons
     if ((times == ESP_GMF_JOB_TIMES_INFINITE) && (is_empty == true)) {
         esp_gmf_job_stack_push(tsk->start_stack, (uint32_t)new_job);
     }
+    return new_job;
+}
 
+esp_gmf_err_t esp_gmf_task_register_ready_job(esp_gmf_task_handle_t handle, const char *label, esp_gmf_job_func job, esp_gmf_job_times_t times, void *ctx, bool done)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    esp_gmf_job_t *new_job = esp_gmf_task_new_job(tsk, label, job, times, ctx);
+    ESP_GMF_MEM_CHECK(TAG, new_job, return ESP_GMF_ERR_MEMORY_LACK;);
     if (tsk->working == NULL) {
         tsk->working = new_job;
     } else {
@@ -428,11 +1195,151 @@ esp_gmf_err_t esp_gmf_task_register_ready_job(esp_gmf_task_handle_t handle, cons
     }
     ESP_LOGD(TAG, "Reg new job to task:%p, item:%p, label:%s, func:%p, ctx:%p cnt:%d", tsk, new_job, new_job->label, job, ctx, get_jobs_num(tsk->working));
     if (done) {
-        xSemaphoreGive(tsk->block_sem);
+        esp_gmf_task_wakeup(tsk);
     }
     return ESP_GMF_ERR_OK;
 }
 
+esp_gmf_err_t esp_gmf_task_insert_ready_job(esp_gmf_task_handle_t handle, void *next_ctx, const char *label, esp_gmf_job_func job,
+                                            esp_gmf_job_times_t times, void *ctx)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    esp_gmf_job_t *pos = tsk->working;
+    while (pos && (pos->ctx != next_ctx)) {
+        pos = pos->next;
+    }
+    if (pos == NULL) {
+        return esp_gmf_task_register_ready_job(handle, label, job, times, ctx, false);
+    }
+    esp_gmf_job_t *new_job = esp_gmf_task_new_job(tsk, label, job, times, ctx);
+    ESP_GMF_MEM_CHECK(TAG, new_job, return ESP_GMF_ERR_MEMORY_LACK;);
+    if (pos->prev) {
+        esp_gmf_node_insert_after((esp_gmf_node_t *)pos->prev, (esp_gmf_node_t *)new_job);
+    } else {
+        new_job->next = pos;
+        pos->prev = new_job;
+        tsk->working = new_job;
+    }
+    ESP_LOGD(TAG, "Insert new job to task:%p, item:%p, label:%s, func:%p, ctx:%p, before:%p-%s", tsk, new_job, new_job->label, job, ctx,
+             pos, pos->label);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_task_set_chain_head(esp_gmf_task_handle_t handle, void *ctx)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    esp_gmf_err_t ret = ESP_GMF_ERR_NOT_FOUND;
+    for (esp_gmf_job_t *job = tsk->working; job; job = job->next) {
+        if (job->ctx == ctx) {
+            job->chain_head = 1;
+            ret = ESP_GMF_ERR_OK;
+        }
+    }
+    return ret;
+}
+
+esp_gmf_err_t esp_gmf_task_unregister_jobs(esp_gmf_task_handle_t handle, void *ctx)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    esp_gmf_job_t *job = tsk->working;
+    while (job) {
+        esp_gmf_job_t *next = job->next;
+        if (job->ctx == ctx) {
+            ESP_LOGD(TAG, "Unregister job from task:%p, item:%p, label:%s, ctx:%p", tsk, job, job->label, ctx);
+            esp_gmf_node_del_at((esp_gmf_node_t **)&tsk->working, (esp_gmf_node_t *)job);
+            esp_gmf_job_stack_remove(tsk->start_stack, (uint32_t)job);
+            if (tsk->resume_job == job) {
+                tsk->resume_job = next;
+            }
+            if (tsk->wait_job == job) {
+                tsk->wait_job = NULL;
+            }
+            if (tsk->cur_job == job) {
+                tsk->cur_job = next;
+                bool is_empty = true;
+                esp_gmf_job_stack_is_empty(tsk->start_stack, &is_empty);
+                if ((next == NULL) && (is_empty == false)) {
+                    esp_gmf_job_stack_pop(tsk->start_stack, (uint32_t *)&tsk->cur_job);
+                }
+            }
+            esp_gmf_task_job_free(tsk, job);
+        }
+        job = next;
+    }
+    esp_gmf_task_deadline_release(tsk, ctx);
+#ifdef CONFIG_ESP_GMF_TASK_PROFILING_EN
+    esp_gmf_task_prof_release(tsk, ctx);
+#endif  /* CONFIG_ESP_GMF_TASK_PROFILING_EN */
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_task_post_job(esp_gmf_task_handle_t handle, const char *label, esp_gmf_job_func job, void *ctx)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, job, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    esp_gmf_job_t *new_job = esp_gmf_task_job_alloc(tsk, label == NULL ? "NULL" : label);
+    ESP_GMF_MEM_CHECK(TAG, new_job, return ESP_GMF_ERR_MEMORY_LACK;);
+    new_job->func = job;
+    new_job->ctx = ctx;
+    new_job->times = ESP_GMF_JOB_TIMES_ONCE;
+    esp_gmf_oal_mutex_lock(tsk->job_lock);
+    if (tsk->accept_post == false) {
+        esp_gmf_oal_mutex_unlock(tsk->job_lock);
+        esp_gmf_task_job_free(tsk, new_job);
+        ESP_LOGD(TAG, "Not in the job loop to post job, [%s,%p], st:%s", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk,
+                 esp_gmf_event_get_state_str(tsk->state));
+        return ESP_GMF_ERR_INVALID_STATE;
+    }
+    esp_gmf_job_t **pos = &tsk->posted;
+    while (*pos) {
+        pos = &(*pos)->next;
+    }
+    *pos = new_job;
+    tsk->post_cnt++;
+    esp_gmf_oal_mutex_unlock(tsk->job_lock);
+    ESP_LOGD(TAG, "Post job to task:%p, item:%p, label:%s, func:%p, ctx:%p", tsk, new_job, new_job->label, job, ctx);
+    // Wake up the task waiting for the data, the job is run once it gets to the end of the job list or waits again
+    esp_gmf_task_wakeup(tsk);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_task_set_job_deadline(esp_gmf_task_handle_t handle, void *ctx, uint32_t period_us, uint32_t deadline_us)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    esp_gmf_oal_mutex_lock(tsk->job_lock);
+    esp_gmf_job_deadline_t *dl = esp_gmf_task_deadline_find(tsk, ctx);
+    if ((dl == NULL) && period_us) {
+        dl = esp_gmf_oal_calloc(1, sizeof(esp_gmf_job_deadline_t));
+        ESP_GMF_MEM_CHECK(TAG, dl, { esp_gmf_oal_mutex_unlock(tsk->job_lock); return ESP_GMF_ERR_MEMORY_LACK;});
+        dl->ctx = ctx;
+        // Deadlines are only added at the head and freed by the unregistration which runs in the jobs of the task,
+        // so the loop reads them without lock
+        dl->next = (esp_gmf_job_deadline_t *)tsk->deadlines;
+        tsk->deadlines = dl;
+    }
+    if (dl) {
+        dl->period_us = period_us;
+        dl->deadline_us = deadline_us ? deadline_us : period_us;
+        int64_t now = esp_gmf_oal_sys_get_time_us();
+        for (esp_gmf_job_t *job = tsk->working; job; job = job->next) {
+            // Restart the periods from now, the old release may be stale when the deadline was removed
+            if ((job->ctx == ctx) && (job->times == ESP_GMF_JOB_TIMES_INFINITE)) {
+                job->deadline = dl;
+                job->release_us = now;
+            }
+        }
+    }
+    esp_gmf_oal_mutex_unlock(tsk->job_lock);
+    ESP_LOGD(TAG, "Set job deadline, [tsk:%s-%p, ctx:%p], period:%ld us, deadline:%ld us", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk, ctx,
+             (long)period_us, (long)deadline_us);
+    return ESP_GMF_ERR_OK;
+}
+
 esp_gmf_err_t esp_gmf_task_set_event_func(esp_gmf_task_handle_t handle, esp_gmf_event_cb cb, void *ctx)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
@@ -461,7 +1368,7 @@ esp_gmf_err_t esp_gmf_task_run(esp_gmf_task_handle_t handle)
         return ESP_GMF_ERR_INVALID_STATE;
     }
     tsk->_run = 1;
-    xSemaphoreGive(tsk->block_sem);
+    esp_gmf_task_wakeup(tsk);
     // Wait for run finished
     if (GMF_TASK_WAIT_FOR_STATE_BITS(tsk->event_group, GMF_TASK_RUN_BIT, tsk->api_sync_time) == false) {
         ESP_LOGE(TAG, "Run timeout,[%s,%p]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk);
@@ -497,6 +1404,9 @@ esp_gmf_err_t esp_gmf_task_stop(esp_gmf_task_handle_t handle)
     tsk->_stop = 1;
     if (tsk->state == ESP_GMF_EVENT_STATE_PAUSED) {
         esp_gmf_task_release_signal(tsk, portMAX_DELAY);
+    } else {
+        // Wake up the job loop in case it is waiting for the jobs to be ready
+        esp_gmf_task_wakeup(tsk);
     }
     if (GMF_TASK_WAIT_FOR_STATE_BITS(tsk->event_group, GMF_TASK_STOP_BIT, tsk->api_sync_time) == false) {
         ESP_LOGE(TAG, "Stop timeout,[%s,%p]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk);
@@ -529,6 +1439,7 @@ esp_gmf_err_t esp_gmf_task_pause(esp_gmf_task_handle_t handle)
         return ESP_GMF_ERR_NOT_SUPPORT;
     }
     tsk->_pause = 1;
+    esp_gmf_task_wakeup(tsk);
     if (GMF_TASK_WAIT_FOR_MULTI_STATE_BITS(tsk->event_group, GMF_TASK_PAUSE_BIT | GMF_TASK_STOP_BIT, tsk->api_sync_time) == false) {
         ESP_LOGE(TAG, "Pause timeout,[%s,%p]", OBJ_GET_TAG((esp_gmf_obj_handle_t)tsk), tsk);
         esp_gmf_oal_mutex_unlock(tsk->lock);
@@ -563,6 +1474,13 @@ esp_gmf_err_t esp_gmf_task_resume(esp_gmf_task_handle_t handle)
     return ESP_GMF_ERR_OK;
 }
 
+esp_gmf_err_t esp_gmf_task_notify_ready(esp_gmf_task_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_wakeup((esp_gmf_task_t *)handle);
+    return ESP_GMF_ERR_OK;
+}
+
 esp_gmf_err_t esp_gmf_task_reset(esp_gmf_task_handle_t handle)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
@@ -579,6 +1497,31 @@ esp_gmf_err_t esp_gmf_task_set_timeout(esp_gmf_task_handle_t handle, int wait_ms
     return ESP_GMF_ERR_OK;
 }
 
+esp_gmf_err_t esp_gmf_task_set_time_slice(esp_gmf_task_handle_t handle, uint32_t slice_us)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    tsk->slice_us = slice_us;
+    return ESP_GMF_ERR_OK;
+}
+
+uint32_t esp_gmf_task_get_slice_left_us(void)
+{
+    esp_gmf_task_t *tsk = cur_tsk;
+    if (tsk == NULL) {
+        return UINT32_MAX;
+    }
+    if (tsk->_pause || tsk->_stop) {
+        // Let the job yield at once, so the command is served without waiting for the whole frame
+        return 0;
+    }
+    if (cur_slice_end == 0) {
+        return UINT32_MAX;
+    }
+    int64_t left_us = cur_slice_end - esp_gmf_oal_sys_get_time_us();
+    return left_us > 0 ? (uint32_t)left_us : 0;
+}
+
 esp_gmf_err_t esp_gmf_task_get_state(esp_gmf_task_handle_t handle, esp_gmf_event_state_t *state)
 {
     ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
@@ -589,3 +1532,81 @@ esp_gmf_err_t esp_gmf_task_get_state(esp_gmf_task_handle_t handle, esp_gmf_event
     }
     return ESP_GMF_ERR_INVALID_ARG;
 }
+
+esp_gmf_err_t esp_gmf_task_get_job_stats(esp_gmf_task_handle_t handle, const void **iterator, esp_gmf_job_stats_t *stats)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, iterator, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, stats, return ESP_GMF_ERR_INVALID_ARG);
+#ifdef CONFIG_ESP_GMF_TASK_PROFILING_EN
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    esp_gmf_oal_mutex_lock(tsk->job_lock);
+    esp_gmf_job_prof_t *prof = (esp_gmf_job_prof_t *)tsk->prof;
+    if (*iterator) {
+        // The record of the iterator may be freed by the unregistration since the last call, the iteration ends then
+        while (prof && (prof != *iterator)) {
+            prof = prof->next;
+        }
+        prof = prof ? prof->next : NULL;
+    }
+    if (prof == NULL) {
+        esp_gmf_oal_mutex_unlock(tsk->job_lock);
+        return ESP_GMF_ERR_NOT_FOUND;
+    }
+    *iterator = prof;
+    memset(stats, 0, sizeof(esp_gmf_job_stats_t));
+    stats->label = prof->label;
+    stats->ctx = prof->ctx;
+    stats->call_cnt = prof->call_cnt;
+    stats->total_us = prof->total_us;
+    stats->blocked_us = prof->blocked_us;
+    stats->bytes_in = prof->bytes_in;
+    stats->bytes_out = prof->bytes_out;
+    if (prof->call_cnt) {
+        stats->min_us = prof->min_us;
+        stats->max_us = prof->max_us;
+        stats->p50_us = esp_gmf_task_prof_percentile(prof, 50);
+        stats->p90_us = esp_gmf_task_prof_percentile(prof, 90);
+        stats->p99_us = esp_gmf_task_prof_percentile(prof, 99);
+    }
+    esp_gmf_oal_mutex_unlock(tsk->job_lock);
+    return ESP_GMF_ERR_OK;
+#else
+    return ESP_GMF_ERR_NOT_SUPPORT;
+#endif  /* CONFIG_ESP_GMF_TASK_PROFILING_EN */
+}
+
+esp_gmf_err_t esp_gmf_task_reset_job_stats(esp_gmf_task_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+#ifdef CONFIG_ESP_GMF_TASK_PROFILING_EN
+    esp_gmf_task_t *tsk = (esp_gmf_task_t *)handle;
+    esp_gmf_oal_mutex_lock(tsk->job_lock);
+    for (esp_gmf_job_prof_t *prof = (esp_gmf_job_prof_t *)tsk->prof; prof; prof = prof->next) {
+        prof->call_cnt = 0;
+        prof->min_us = UINT32_MAX;
+        prof->max_us = 0;
+        prof->total_us = 0;
+        prof->blocked_us = 0;
+        prof->bytes_in = 0;
+        prof->bytes_out = 0;
+        memset(prof->hist, 0, sizeof(prof->hist));
+    }
+    esp_gmf_oal_mutex_unlock(tsk->job_lock);
+    return ESP_GMF_ERR_OK;
+#else
+    return ESP_GMF_ERR_NOT_SUPPORT;
+#endif  /* CONFIG_ESP_GMF_TASK_PROFILING_EN */
+}
+
+void esp_gmf_task_prof_add_io(uint32_t blocked_us, uint32_t bytes_in, uint32_t bytes_out)
+{
+#ifdef CONFIG_ESP_GMF_TASK_PROFILING_EN
+    esp_gmf_job_prof_t *prof = cur_prof;
+    if (prof) {
+        prof->blocked_us += blocked_us;
+        prof->bytes_in += bytes_in;
+        prof->bytes_out += bytes_out;
+    }
+#endif  /* CONFIG_ESP_GMF_TASK_PROFILING_EN */
+}
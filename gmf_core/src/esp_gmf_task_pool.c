@@ -0,0 +1,370 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+#include "freertos/event_groups.h"
+#include "freertos/task.h"
+
+#include "esp_gmf_oal_mutex.h"
+#include "esp_gmf_oal_thread.h"
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_task_pool.h"
+#include "esp_log.h"
+
+static const char *TAG = "ESP_GMF_TASK_POOL";
+
+#define GMF_TASK_POOL_ITEM_IDLE    (0)
+#define GMF_TASK_POOL_ITEM_QUEUED  (1)
+#define GMF_TASK_POOL_ITEM_RUNNING (2)
+
+#define GMF_TASK_POOL_NAME_MAX_LEN (16)
+#define GMF_TASK_POOL_MAX_WORKERS  (24)  // One bit of the event group for each worker
+#define GMF_TASK_POOL_POST_LEN     (16)
+
+struct esp_gmf_task_pool;
+
+/**
+ * @brief  Worker of the task pool, each worker owns a ready queue
+ */
+typedef struct {
+    struct esp_gmf_task_pool  *pool;    /*!< The pool that owns the worker */
+    esp_gmf_task_pool_item_t  *head;    /*!< Head of the ready queue, the next item to run */
+    esp_gmf_task_pool_item_t  *tail;    /*!< Tail of the ready queue */
+    void                      *thread;  /*!< Handle of the worker thread */
+    uint8_t                    id;      /*!< Index of the worker */
+} esp_gmf_task_pool_worker_t;
+
+/**
+ * @brief  Task pool structure
+ */
+typedef struct esp_gmf_task_pool {
+    esp_gmf_task_pool_worker_t  *workers;     /*!< Array of workers */
+    uint8_t                      worker_num;  /*!< Number of workers */
+    uint8_t                      next_id;     /*!< Round-robin index for the items without affinity */
+    uint16_t                     job_slice;   /*!< Maximum jobs run by one dispatch */
+    void                        *lock;        /*!< Protect the ready queues and the item states */
+    SemaphoreHandle_t            ready_sem;   /*!< Counting semaphore, one count for each submission */
+    QueueHandle_t                post_q;      /*!< Items posted without blocking, moved to the ready queues by the workers */
+    SemaphoreHandle_t            exit_sem;    /*!< Counting semaphore, one count for each exited worker */
+    EventGroupHandle_t           idle_evt;    /*!< Bit N is set when worker N finishes an execution, waited on by the removal */
+    uint8_t                      _exit : 1;   /*!< Flag to exit all the workers */
+} esp_gmf_task_pool_t;
+
+static inline void pool_queue_push(esp_gmf_task_pool_worker_t *worker, esp_gmf_task_pool_item_t *item)
+{
+    item->next = NULL;
+    if (worker->tail) {
+        worker->tail->next = item;
+    } else {
+        worker->head = item;
+    }
+    worker->tail = item;
+}
+
+static inline esp_gmf_task_pool_item_t *pool_queue_pop(esp_gmf_task_pool_worker_t *worker)
+{
+    esp_gmf_task_pool_item_t *item = worker->head;
+    if (item) {
+        worker->head = item->next;
+        if (worker->head == NULL) {
+            worker->tail = NULL;
+        }
+        item->next = NULL;
+    }
+    return item;
+}
+
+static inline bool pool_queue_del(esp_gmf_task_pool_worker_t *worker, esp_gmf_task_pool_item_t *item)
+{
+    esp_gmf_task_pool_item_t *prev = NULL;
+    esp_gmf_task_pool_item_t *cur = worker->head;
+    while (cur) {
+        if (cur == item) {
+            if (prev) {
+                prev->next = cur->next;
+            } else {
+                worker->head = cur->next;
+            }
+            if (worker->tail == cur) {
+                worker->tail = prev;
+            }
+            cur->next = NULL;
+            return true;
+        }
+        prev = cur;
+        cur = cur->next;
+    }
+    return false;
+}
+
+static esp_gmf_task_pool_item_t *pool_fetch_item(esp_gmf_task_pool_t *pool, esp_gmf_task_pool_worker_t *worker)
+{
+    // Local queue first, then steal from the others starting from the next worker
+    esp_gmf_task_pool_item_t *item = pool_queue_pop(worker);
+    for (int i = 1; (item == NULL) && (i < pool->worker_num); i++) {
+        esp_gmf_task_pool_worker_t *victim = &pool->workers[(worker->id + i) % pool->worker_num];
+        item = pool_queue_pop(victim);
+        if (item) {
+            ESP_LOGV(TAG, "Worker %d steal item:%p from worker %d", worker->id, item, victim->id);
+        }
+    }
+    return item;
+}
+
+/**
+ * @brief  Put the item into a ready queue, called with `lock` held
+ *
+ * @return
+ *       - true   The item is queued, the caller gives `ready_sem` for it
+ *       - false  The item is already queued or running
+ */
+static bool pool_submit_locked(esp_gmf_task_pool_t *pool, esp_gmf_task_pool_item_t *item)
+{
+    if (item->state == GMF_TASK_POOL_ITEM_QUEUED) {
+        return false;
+    }
+    if (item->state == GMF_TASK_POOL_ITEM_RUNNING) {
+        // Let the worker put it back when the execution returns
+        item->pending = 1;
+        return false;
+    }
+    int id = 0;
+    if ((item->affinity >= 0) && (item->affinity < pool->worker_num)) {
+        id = item->affinity;
+    } else {
+        id = pool->next_id;
+        pool->next_id = (pool->next_id + 1) % pool->worker_num;
+    }
+    item->state = GMF_TASK_POOL_ITEM_QUEUED;
+    pool_queue_push(&pool->workers[id], item);
+    ESP_LOGV(TAG, "Submit item:%p to worker %d, pool:%p", item, id, pool);
+    return true;
+}
+
+static void pool_take_posted(esp_gmf_task_pool_t *pool)
+{
+    // Each posted item has given its count of `ready_sem` already
+    esp_gmf_task_pool_item_t *item = NULL;
+    while (xQueueReceive(pool->post_q, &item, 0) == pdTRUE) {
+        pool_submit_locked(pool, item);
+    }
+}
+
+static void esp_gmf_task_pool_worker_fun(void *pv)
+{
+    esp_gmf_task_pool_worker_t *worker = (esp_gmf_task_pool_worker_t *)pv;
+    esp_gmf_task_pool_t *pool = worker->pool;
+    ESP_LOGD(TAG, "Worker %d is running, pool:%p", worker->id, pool);
+    while (1) {
+        xSemaphoreTake(pool->ready_sem, portMAX_DELAY);
+        if (pool->_exit) {
+            break;
+        }
+        esp_gmf_oal_mutex_lock(pool->lock);
+        pool_take_posted(pool);
+        esp_gmf_task_pool_item_t *item = pool_fetch_item(pool, worker);
+        if (item == NULL) {
+            // The item has been removed after it was submitted
+            esp_gmf_oal_mutex_unlock(pool->lock);
+            continue;
+        }
+        item->state = GMF_TASK_POOL_ITEM_RUNNING;
+        item->pending = 0;
+        item->affinity = worker->id;
+        esp_gmf_oal_mutex_unlock(pool->lock);
+
+        esp_gmf_task_pool_exec_ret_t ret = item->exec(item->ctx, pool->job_slice);
+
+        esp_gmf_oal_mutex_lock(pool->lock);
+        if ((ret == ESP_GMF_TASK_POOL_EXEC_YIELD) || item->pending) {
+            item->pending = 0;
+            item->state = GMF_TASK_POOL_ITEM_QUEUED;
+            pool_queue_push(worker, item);
+            esp_gmf_oal_mutex_unlock(pool->lock);
+            xSemaphoreGive(pool->ready_sem);
+        } else {
+            item->state = GMF_TASK_POOL_ITEM_IDLE;
+            esp_gmf_oal_mutex_unlock(pool->lock);
+        }
+        xEventGroupSetBits(pool->idle_evt, BIT(worker->id));
+    }
+    ESP_LOGD(TAG, "Worker %d exit, pool:%p", worker->id, pool);
+    void *thread = worker->thread;
+    xSemaphoreGive(pool->exit_sem);
+    esp_gmf_oal_thread_delete(thread);
+}
+
+static void esp_gmf_task_pool_stop_workers(esp_gmf_task_pool_t *pool, int started)
+{
+    pool->_exit = 1;
+    for (int i = 0; i < started; i++) {
+        xSemaphoreGive(pool->ready_sem);
+    }
+    for (int i = 0; i < started; i++) {
+        xSemaphoreTake(pool->exit_sem, portMAX_DELAY);
+    }
+}
+
+static inline void esp_gmf_task_pool_free(esp_gmf_task_pool_t *pool)
+{
+    if (pool->ready_sem) {
+        vSemaphoreDelete(pool->ready_sem);
+    }
+    if (pool->exit_sem) {
+        vSemaphoreDelete(pool->exit_sem);
+    }
+    if (pool->post_q) {
+        vQueueDelete(pool->post_q);
+    }
+    if (pool->idle_evt) {
+        vEventGroupDelete(pool->idle_evt);
+    }
+    if (pool->lock) {
+        esp_gmf_oal_mutex_destroy(pool->lock);
+    }
+    if (pool->workers) {
+        esp_gmf_oal_free(pool->workers);
+    }
+    esp_gmf_oal_free(pool);
+}
+
+esp_gmf_err_t esp_gmf_task_pool_create(esp_gmf_task_pool_cfg_t *config, esp_gmf_task_pool_handle_t *handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, config, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_CHECK(TAG, (config->worker_num <= GMF_TASK_POOL_MAX_WORKERS), return ESP_GMF_ERR_INVALID_ARG, "Too many workers");
+    *handle = NULL;
+    esp_gmf_task_pool_t *pool = esp_gmf_oal_calloc(1, sizeof(esp_gmf_task_pool_t));
+    ESP_GMF_MEM_CHECK(TAG, pool, return ESP_GMF_ERR_MEMORY_LACK);
+    esp_gmf_err_t ret = ESP_GMF_ERR_MEMORY_LACK;
+    pool->worker_num = config->worker_num ? config->worker_num : portNUM_PROCESSORS;
+    pool->job_slice = config->job_slice ? config->job_slice : DEFAULT_ESP_GMF_TASK_POOL_JOB_SLICE;
+    pool->lock = esp_gmf_oal_mutex_create();
+    ESP_GMF_MEM_CHECK(TAG, pool->lock, goto _pool_create_failed);
+    pool->ready_sem = xSemaphoreCreateCounting(INT16_MAX, 0);
+    ESP_GMF_MEM_CHECK(TAG, pool->ready_sem, goto _pool_create_failed);
+    pool->exit_sem = xSemaphoreCreateCounting(pool->worker_num, 0);
+    ESP_GMF_MEM_CHECK(TAG, pool->exit_sem, goto _pool_create_failed);
+    pool->post_q = xQueueCreate(GMF_TASK_POOL_POST_LEN, sizeof(esp_gmf_task_pool_item_t *));
+    ESP_GMF_MEM_CHECK(TAG, pool->post_q, goto _pool_create_failed);
+    pool->idle_evt = xEventGroupCreate();
+    ESP_GMF_MEM_CHECK(TAG, pool->idle_evt, goto _pool_create_failed);
+    pool->workers = esp_gmf_oal_calloc(pool->worker_num, sizeof(esp_gmf_task_pool_worker_t));
+    ESP_GMF_MEM_CHECK(TAG, pool->workers, goto _pool_create_failed);
+
+    int stack = config->stack > 0 ? config->stack : DEFAULT_ESP_GMF_TASK_POOL_STACK_SIZE;
+    int prio = config->prio ? config->prio : DEFAULT_ESP_GMF_TASK_POOL_PRIO;
+    char name[GMF_TASK_POOL_NAME_MAX_LEN] = {0};
+    for (int i = 0; i < pool->worker_num; i++) {
+        esp_gmf_task_pool_worker_t *worker = &pool->workers[i];
+        worker->pool = pool;
+        worker->id = i;
+        snprintf(name, sizeof(name), "%s_%d", config->name ? config->name : "gmf_pool", i);
+        int core = config->pin_to_core ? (i % portNUM_PROCESSORS) : tskNO_AFFINITY;
+        if (esp_gmf_oal_thread_create(&worker->thread, name, esp_gmf_task_pool_worker_fun, worker, stack,
+                                      prio, config->stack_in_ext, core) != ESP_GMF_ERR_OK) {
+            ESP_LOGE(TAG, "Create worker %d failed, pool:%p", i, pool);
+            esp_gmf_task_pool_stop_workers(pool, i);
+            ret = ESP_GMF_ERR_FAIL;
+            goto _pool_create_failed;
+        }
+    }
+    ESP_LOGI(TAG, "Task pool created, pool:%p, workers:%d, slice:%d", pool, pool->worker_num, pool->job_slice);
+    *handle = pool;
+    return ESP_GMF_ERR_OK;
+
+_pool_create_failed:
+    esp_gmf_task_pool_free(pool);
+    return ret;
+}
+
+esp_gmf_err_t esp_gmf_task_pool_destroy(esp_gmf_task_pool_handle_t handle)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_pool_t *pool = (esp_gmf_task_pool_t *)handle;
+    esp_gmf_task_pool_stop_workers(pool, pool->worker_num);
+    for (int i = 0; i < pool->worker_num; i++) {
+        if (pool->workers[i].head) {
+            ESP_LOGW(TAG, "Worker %d still has queued items, pool:%p, head:%p", i, pool, pool->workers[i].head);
+        }
+    }
+    ESP_LOGD(TAG, "Task pool destroyed, pool:%p", pool);
+    esp_gmf_task_pool_free(pool);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_task_pool_submit(esp_gmf_task_pool_handle_t handle, esp_gmf_task_pool_item_t *item)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, item, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, item->exec, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_pool_t *pool = (esp_gmf_task_pool_t *)handle;
+    esp_gmf_oal_mutex_lock(pool->lock);
+    bool queued = pool_submit_locked(pool, item);
+    esp_gmf_oal_mutex_unlock(pool->lock);
+    if (queued) {
+        xSemaphoreGive(pool->ready_sem);
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_task_pool_post(esp_gmf_task_pool_handle_t handle, esp_gmf_task_pool_item_t *item)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, item, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_pool_t *pool = (esp_gmf_task_pool_t *)handle;
+    if (xQueueSend(pool->post_q, &item, 0) != pdTRUE) {
+        return ESP_GMF_ERR_FAIL;
+    }
+    xSemaphoreGive(pool->ready_sem);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_task_pool_remove(esp_gmf_task_pool_handle_t handle, esp_gmf_task_pool_item_t *item)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, item, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_pool_t *pool = (esp_gmf_task_pool_t *)handle;
+    esp_gmf_oal_mutex_lock(pool->lock);
+    while (item->state == GMF_TASK_POOL_ITEM_RUNNING) {
+        // The bit is cleared while the worker still runs the item, so the next set is the end of that execution
+        EventBits_t bit = BIT(item->affinity);
+        item->pending = 0;
+        xEventGroupClearBits(pool->idle_evt, bit);
+        esp_gmf_oal_mutex_unlock(pool->lock);
+        xEventGroupWaitBits(pool->idle_evt, bit, pdFALSE, pdTRUE, portMAX_DELAY);
+        esp_gmf_oal_mutex_lock(pool->lock);
+    }
+    // The item may still wait in the post queue
+    pool_take_posted(pool);
+    if (item->state == GMF_TASK_POOL_ITEM_QUEUED) {
+        for (int i = 0; i < pool->worker_num; i++) {
+            if (pool_queue_del(&pool->workers[i], item)) {
+                break;
+            }
+        }
+    }
+    item->state = GMF_TASK_POOL_ITEM_IDLE;
+    item->pending = 0;
+    esp_gmf_oal_mutex_unlock(pool->lock);
+    return ESP_GMF_ERR_OK;
+}
+
+esp_gmf_err_t esp_gmf_task_pool_get_worker_num(esp_gmf_task_pool_handle_t handle, uint8_t *worker_num)
+{
+    ESP_GMF_NULL_CHECK(TAG, handle, return ESP_GMF_ERR_INVALID_ARG);
+    ESP_GMF_NULL_CHECK(TAG, worker_num, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_task_pool_t *pool = (esp_gmf_task_pool_t *)handle;
+    *worker_num = pool->worker_num;
+    return ESP_GMF_ERR_OK;
+}
@@ -0,0 +1,367 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_data_bus.h"
+#include "esp_gmf_new_databus.h"
+#include "esp_gmf_payload_pool.h"
+#include "gmf_ut_common.h"
+
+#define BCAST_READER_NUM  (3)
+#define BCAST_BLOCK_NUM   (200)
+#define BCAST_BLOCK_SIZE  (512)
+
+static const char *TAG = "TEST_ESP_GMF_BCAST";
+
+typedef struct {
+    esp_gmf_db_handle_t db;
+    int                 delay_ms;
+    int                 block_cnt;
+    bool                data_err;
+    volatile bool       done;
+} bcast_task_t;
+
+static void bcast_write_task(void *param)
+{
+    bcast_task_t *wr = (bcast_task_t *)param;
+    for (int i = 0; i < BCAST_BLOCK_NUM; i++) {
+        esp_gmf_data_bus_block_t blk = {0};
+        if (esp_gmf_db_acquire_write(wr->db, &blk, BCAST_BLOCK_SIZE, portMAX_DELAY) != ESP_GMF_IO_OK) {
+            wr->data_err = true;
+            break;
+        }
+        memset(blk.buf, (uint8_t)i, BCAST_BLOCK_SIZE);
+        blk.valid_size = BCAST_BLOCK_SIZE;
+        blk.is_last = (i == BCAST_BLOCK_NUM - 1);
+        esp_gmf_db_release_write(wr->db, &blk, portMAX_DELAY);
+        wr->block_cnt++;
+    }
+    wr->done = true;
+    vTaskDelete(NULL);
+}
+
+static void bcast_read_task(void *param)
+{
+    bcast_task_t *rd = (bcast_task_t *)param;
+    while (true) {
+        esp_gmf_data_bus_block_t blk = {0};
+        if (esp_gmf_db_acquire_read(rd->db, &blk, BCAST_BLOCK_SIZE, portMAX_DELAY) != ESP_GMF_IO_OK) {
+            rd->data_err = true;
+            break;
+        }
+        bool is_last = blk.is_last;
+        if (blk.valid_size) {
+            if ((blk.valid_size != BCAST_BLOCK_SIZE) || (blk.buf[0] != (uint8_t)rd->block_cnt)
+                || (blk.buf[BCAST_BLOCK_SIZE - 1] != (uint8_t)rd->block_cnt)) {
+                ESP_LOGE(TAG, "Data mismatch on block:%d, valid:%d", rd->block_cnt, blk.valid_size);
+                rd->data_err = true;
+            }
+            rd->block_cnt++;
+        }
+        if (rd->delay_ms) {
+            vTaskDelay(rd->delay_ms / portTICK_PERIOD_MS);
+        }
+        esp_gmf_db_release_read(rd->db, &blk, portMAX_DELAY);
+        if (is_last || rd->data_err) {
+            break;
+        }
+    }
+    rd->done = true;
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("Broadcast data bus read and write", "[ESP_GMF_BCAST]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_db_handle_t wr = NULL;
+    esp_gmf_db_handle_t rd1 = NULL;
+    esp_gmf_db_handle_t rd2 = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_broadcast(2, 64, &wr));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_broadcast_reader(wr, ESP_GMF_BCAST_DROP_NONE, &rd1));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_broadcast_reader(wr, ESP_GMF_BCAST_DROP_OLDEST, &rd2));
+    TEST_ASSERT_NOT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_broadcast_reader(rd1, ESP_GMF_BCAST_DROP_NONE, &rd2));
+
+    // Both readers get the same block, which is free after the last release
+    esp_gmf_data_bus_block_t wr_blk = {0};
+    esp_gmf_data_bus_block_t rd_blk1 = {0};
+    esp_gmf_data_bus_block_t rd_blk2 = {0};
+    uint32_t size = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_write(wr, &wr_blk, 64, 0));
+    memset(wr_blk.buf, 0x5A, 64);
+    wr_blk.valid_size = 64;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(wr, &wr_blk, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(rd1, &rd_blk1, 64, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(rd2, &rd_blk2, 64, 0));
+    TEST_ASSERT_EQUAL_PTR(wr_blk.buf, rd_blk1.buf);
+    TEST_ASSERT_EQUAL_PTR(wr_blk.buf, rd_blk2.buf);
+    TEST_ASSERT_EQUAL(64, rd_blk2.valid_size);
+    TEST_ASSERT_EQUAL(0x5A, rd_blk2.buf[63]);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_read(rd1, &rd_blk1, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_available(wr, &size));
+    TEST_ASSERT_EQUAL(64, size);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_read(rd2, &rd_blk2, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_available(wr, &size));
+    TEST_ASSERT_EQUAL(128, size);
+
+    // The reader without drop holds the writer back, the other one loses its oldest block
+    for (int i = 1; i <= 2; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_write(wr, &wr_blk, 64, 0));
+        memset(wr_blk.buf, i, 64);
+        wr_blk.valid_size = 64;
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(wr, &wr_blk, 0));
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_filled_size(rd2, &size));
+    TEST_ASSERT_EQUAL(2, size);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_TIMEOUT, esp_gmf_db_acquire_write(wr, &wr_blk, 64, 0));
+    for (int i = 1; i <= 2; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(rd1, &rd_blk1, 64, 0));
+        TEST_ASSERT_EQUAL(i, rd_blk1.buf[0]);
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_read(rd1, &rd_blk1, 0));
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_write(wr, &wr_blk, 64, 0));
+    memset(wr_blk.buf, 3, 64);
+    wr_blk.valid_size = 64;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(wr, &wr_blk, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(rd2, &rd_blk2, 64, 0));
+    TEST_ASSERT_EQUAL(2, rd_blk2.buf[0]);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_read(rd2, &rd_blk2, 0));
+
+    // Writing done is seen by every reader after its unread blocks
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_done_write(wr));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(rd2, &rd_blk2, 64, 0));
+    TEST_ASSERT_EQUAL(3, rd_blk2.buf[0]);
+    TEST_ASSERT_FALSE(rd_blk2.is_last);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_read(rd2, &rd_blk2, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(rd2, &rd_blk2, 64, 0));
+    TEST_ASSERT_TRUE(rd_blk2.is_last);
+    TEST_ASSERT_EQUAL(0, rd_blk2.valid_size);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_read(rd2, &rd_blk2, 0));
+
+    // Aborting a reader does not affect the others
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_reset(wr));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_abort(rd1));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_ABORT, esp_gmf_db_acquire_read(rd1, &rd_blk1, 64, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_TIMEOUT, esp_gmf_db_acquire_read(rd2, &rd_blk2, 64, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_reset(rd1));
+
+    // The writer can go first, the remaining readers see writing done
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(wr));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(rd1, &rd_blk1, 64, 0));
+    TEST_ASSERT_TRUE(rd_blk1.is_last);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(rd1));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(rd2));
+}
+
+TEST_CASE("Broadcast data bus carries the metadata of the payloads", "[ESP_GMF_BCAST]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_db_handle_t wr = NULL;
+    esp_gmf_db_handle_t rd1 = NULL;
+    esp_gmf_db_handle_t rd2 = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_broadcast(2, 64, &wr));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_broadcast_reader(wr, ESP_GMF_BCAST_DROP_NONE, &rd1));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_broadcast_reader(wr, ESP_GMF_BCAST_DROP_NONE, &rd2));
+
+    // Every reader gets the stamp of the block, the block written without one has none
+    esp_gmf_payload_t wr_load = {0};
+    esp_gmf_payload_t rd_load = {0};
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_payload_write(wr, &wr_load, 64, 0));
+        memset(wr_load.buf, i, 64);
+        wr_load.valid_size = 64;
+        wr_load.trace_us = i ? 0 : 1234;
+        if (i) {
+            esp_gmf_data_bus_block_t blk = {
+                .buf = wr_load.buf,
+                .buf_length = wr_load.buf_length,
+                .valid_size = 64,
+            };
+            TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(wr, &blk, 0));
+        } else {
+            TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_payload_write(wr, &wr_load, 0));
+        }
+    }
+    esp_gmf_db_handle_t rds[] = {rd1, rd2};
+    for (int r = 0; r < 2; r++) {
+        for (int i = 0; i < 2; i++) {
+            rd_load.trace_us = -1;
+            TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_payload_read(rds[r], &rd_load, 64, 0));
+            TEST_ASSERT_EQUAL(i, rd_load.buf[0]);
+            TEST_ASSERT_EQUAL(i ? 0 : 1234, rd_load.trace_us);
+            TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_payload_read(rds[r], &rd_load, 0));
+        }
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(rd1));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(rd2));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(wr));
+}
+
+TEST_CASE("Broadcast reader aborted while holding a block", "[ESP_GMF_BCAST]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_db_handle_t wr = NULL;
+    esp_gmf_db_handle_t rd1 = NULL;
+    esp_gmf_db_handle_t rd2 = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_broadcast(1, 64, &wr));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_broadcast_reader(wr, ESP_GMF_BCAST_DROP_NONE, &rd1));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_broadcast_reader(wr, ESP_GMF_BCAST_DROP_NONE, &rd2));
+
+    esp_gmf_data_bus_block_t wr_blk = {0};
+    esp_gmf_data_bus_block_t rd_blk = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_write(wr, &wr_blk, 64, 0));
+    memset(wr_blk.buf, 1, 64);
+    wr_blk.valid_size = 64;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(wr, &wr_blk, 0));
+
+    // The abort keeps the held block, its release frees it for the writer
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(rd1, &rd_blk, 64, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_abort(rd1));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_read(rd1, &rd_blk, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(rd2, &rd_blk, 64, 0));
+    TEST_ASSERT_EQUAL(1, rd_blk.buf[0]);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_read(rd2, &rd_blk, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_write(wr, &wr_blk, 64, 0));
+    memset(wr_blk.buf, 2, 64);
+    wr_blk.valid_size = 64;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(wr, &wr_blk, 0));
+
+    // The aborted reader reads again once it is reset
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_ABORT, esp_gmf_db_acquire_read(rd1, &rd_blk, 64, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_reset(rd1));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(rd1, &rd_blk, 64, 0));
+    TEST_ASSERT_EQUAL(2, rd_blk.buf[0]);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_read(rd1, &rd_blk, 0));
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(rd1));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(rd2));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(wr));
+}
+
+TEST_CASE("Broadcast data bus publishes the pooled buffers of the writer by reference", "[ESP_GMF_BCAST]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_payload_pool_handle_t pool = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_create(64, 2, 16, &pool));
+    esp_gmf_db_handle_t wr = NULL;
+    esp_gmf_db_handle_t rd1 = NULL;
+    esp_gmf_db_handle_t rd2 = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_broadcast(1, 64, &wr));
+    TEST_ASSERT_NOT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_broadcast_write_ref(NULL, NULL, NULL, NULL, NULL, 0));
+
+    // Nobody reads the buffer, it goes back to the writer at once
+    esp_gmf_payload_t load = {0};
+    uint8_t ref = 0;
+    uint16_t free_cnt = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_attach(pool, 16, 64, &load));
+    esp_gmf_data_bus_block_t blk = {
+        .buf = load.buf,
+        .buf_length = load.buf_length,
+        .valid_size = 64,
+    };
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_ref(&load));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_broadcast_write_ref(wr, &blk, NULL, (esp_gmf_bcast_ref_free_t)esp_gmf_payload_pool_unref, pool, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_ref(&load, &ref));
+    TEST_ASSERT_EQUAL(1, ref);
+
+    // Every reader gets the buffer of the writer, which is held until the last reader releases it
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_broadcast_reader(wr, ESP_GMF_BCAST_DROP_NONE, &rd1));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_broadcast_reader(wr, ESP_GMF_BCAST_DROP_NONE, &rd2));
+    memset(load.buf, 0x3C, 64);
+    esp_gmf_db_meta_t meta = {
+        .trace_us = 1234,
+    };
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_ref(&load));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_broadcast_write_ref(wr, &blk, &meta, (esp_gmf_bcast_ref_free_t)esp_gmf_payload_pool_unref, pool, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_detach(&load));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_info(pool, NULL, &free_cnt));
+    TEST_ASSERT_EQUAL(1, free_cnt);
+    esp_gmf_payload_t rd_load = {0};
+    esp_gmf_db_handle_t rds[] = {rd1, rd2};
+    for (int r = 0; r < 2; r++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_payload_read(rds[r], &rd_load, 64, 0));
+        TEST_ASSERT_EQUAL_PTR(blk.buf, rd_load.buf);
+        TEST_ASSERT_EQUAL(64, rd_load.valid_size);
+        TEST_ASSERT_EQUAL(0x3C, rd_load.buf[63]);
+        TEST_ASSERT_EQUAL(1234, rd_load.trace_us);
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_payload_read(rds[r], &rd_load, 0));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_info(pool, NULL, &free_cnt));
+        TEST_ASSERT_EQUAL(r ? 2 : 1, free_cnt);
+    }
+
+    // A reader without drop holds the writer back until its policy changes, the unread buffers go back on reset
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_attach(pool, 16, 64, &load));
+        blk.buf = load.buf;
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_ref(&load));
+        esp_gmf_err_io_t ret = esp_gmf_db_broadcast_write_ref(wr, &blk, NULL, (esp_gmf_bcast_ref_free_t)esp_gmf_payload_pool_unref, pool, 0);
+        if (i) {
+            uint32_t size = 0;
+            TEST_ASSERT_EQUAL(ESP_GMF_IO_TIMEOUT, ret);
+            TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_available(wr, &size));
+            TEST_ASSERT_EQUAL(0, size);
+            TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_set_broadcast_reader_policy(rd1, ESP_GMF_BCAST_DROP_OLDEST));
+            TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_available(wr, &size));
+            TEST_ASSERT_EQUAL(0, size);
+            TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_set_broadcast_reader_policy(rd2, ESP_GMF_BCAST_DROP_OLDEST));
+            TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_available(wr, &size));
+            TEST_ASSERT_EQUAL(64, size);
+            ret = esp_gmf_db_broadcast_write_ref(wr, &blk, NULL, (esp_gmf_bcast_ref_free_t)esp_gmf_payload_pool_unref, pool, 0);
+        }
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, ret);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_detach(&load));
+    }
+    // The first buffer is dropped for both readers and goes back to the pool, they get the second one
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_payload_read(rd1, &rd_load, 64, 0));
+    TEST_ASSERT_EQUAL_PTR(blk.buf, rd_load.buf);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_payload_read(rd1, &rd_load, 0));
+    TEST_ASSERT_NOT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_set_broadcast_reader_policy(wr, ESP_GMF_BCAST_DROP_NONE));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_info(pool, NULL, &free_cnt));
+    TEST_ASSERT_EQUAL(1, free_cnt);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_reset(wr));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_info(pool, NULL, &free_cnt));
+    TEST_ASSERT_EQUAL(2, free_cnt);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(rd1));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(rd2));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(wr));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_destroy(pool));
+}
+
+TEST_CASE("Broadcast data bus fan-out on different tasks", "[ESP_GMF_BCAST]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    bcast_task_t wr = {0};
+    bcast_task_t rd[BCAST_READER_NUM] = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_broadcast(4, BCAST_BLOCK_SIZE, &wr.db));
+    for (int i = 0; i < BCAST_READER_NUM; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_broadcast_reader(wr.db, ESP_GMF_BCAST_DROP_NONE, &rd[i].db));
+        rd[i].delay_ms = i * 2;
+        xTaskCreate(bcast_read_task, "bcast_rd", 4096, &rd[i], 5, NULL);
+    }
+    xTaskCreatePinnedToCore(bcast_write_task, "bcast_wr", 4096, &wr, 5, NULL, portNUM_PROCESSORS - 1);
+    bool done = false;
+    while (!done) {
+        vTaskDelay(10 / portTICK_PERIOD_MS);
+        done = wr.done;
+        for (int i = 0; i < BCAST_READER_NUM; i++) {
+            done &= rd[i].done;
+        }
+    }
+    TEST_ASSERT_FALSE(wr.data_err);
+    TEST_ASSERT_EQUAL(BCAST_BLOCK_NUM, wr.block_cnt);
+    for (int i = 0; i < BCAST_READER_NUM; i++) {
+        TEST_ASSERT_FALSE(rd[i].data_err);
+        TEST_ASSERT_EQUAL(BCAST_BLOCK_NUM, rd[i].block_cnt);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(rd[i].db));
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(wr.db));
+}
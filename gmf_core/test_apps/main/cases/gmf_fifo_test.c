@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
 #include <sys/stat.h>
 #include "unity.h"
 #include "freertos/FreeRTOS.h"
@@ -12,7 +13,10 @@
 #include "esp_log.h"
 
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
 #include "esp_gmf_fifo.h"
+#include "esp_gmf_new_databus.h"
+#include "esp_gmf_port.h"
 #include "gmf_ut_common.h"
 
 static const char *TAG = "TEST_ESP_GMF_FIFO";
@@ -143,3 +147,293 @@ TEST_CASE("FIFO read and write on different task", "[ESP_GMF_FIFO]")
     esp_gmf_ut_teardown_sdmmc(card);
     vTaskDelay(10 / portTICK_PERIOD_MS);
 }
+
+TEST_CASE("FIFO buffer recycling with best fit and preallocation", "[ESP_GMF_FIFO]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_fifo_handle_t fifo = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_create(3, 1, &fifo));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_set_align(fifo, 64));
+
+    // Fill three nodes of different sizes, the buffers are aligned and sized by classes
+    const uint32_t sizes[] = {100, 1000, 4000};
+    uint8_t *bufs[3] = {NULL};
+    esp_gmf_data_bus_block_t blk = {0};
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_write(fifo, &blk, sizes[i], 0));
+        TEST_ASSERT_EQUAL(0, (uintptr_t)blk.buf % 64);
+        TEST_ASSERT_GREATER_OR_EQUAL(sizes[i], blk.buf_length);
+        bufs[i] = blk.buf;
+        blk.valid_size = sizes[i];
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_write(fifo, &blk, 0));
+    }
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_read(fifo, &blk, 0, 0));
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_read(fifo, &blk, 0));
+    }
+
+    // Each size is served by the smallest free buffer which fits
+    const uint32_t reuse[][2] = {{900, 1}, {64, 0}, {3000, 2}, {1024, 1}};
+    for (int i = 0; i < sizeof(reuse) / sizeof(reuse[0]); i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_write(fifo, &blk, reuse[i][0], 0));
+        TEST_ASSERT_EQUAL_PTR(bufs[reuse[i][1]], blk.buf);
+        blk.valid_size = reuse[i][0];
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_write(fifo, &blk, 0));
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_read(fifo, &blk, 0, 0));
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_read(fifo, &blk, 0));
+    }
+    // Nothing fits, the smallest buffer grows and keeps the alignment
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_write(fifo, &blk, 8000, 0));
+    TEST_ASSERT_EQUAL(0, (uintptr_t)blk.buf % 64);
+    TEST_ASSERT_GREATER_OR_EQUAL(8000, blk.buf_length);
+    blk.valid_size = 8000;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_write(fifo, &blk, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_read(fifo, &blk, 0, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_read(fifo, &blk, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_destroy(fifo));
+
+    // All the nodes are preallocated, the buffers are reused whatever the wanted size
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_create(4, 1, &fifo));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_prealloc(fifo, 2048));
+    uint32_t size = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_get_total_size(fifo, &size));
+    TEST_ASSERT_EQUAL(4 * 2048, size);
+    for (int i = 0; i < 16; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_write(fifo, &blk, 128 * (i + 1), 0));
+        TEST_ASSERT_EQUAL(2048, blk.buf_length);
+        blk.valid_size = 128 * (i + 1);
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_write(fifo, &blk, 0));
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_read(fifo, &blk, 0, 0));
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_read(fifo, &blk, 0));
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_get_total_size(fifo, &size));
+    TEST_ASSERT_EQUAL(4 * 2048, size);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_FAIL, esp_gmf_fifo_acquire_write(fifo, &blk, 4096, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_destroy(fifo));
+}
+
+static void fifo_write_read_once(esp_gmf_fifo_handle_t fifo, uint32_t size)
+{
+    esp_gmf_data_bus_block_t blk = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_write(fifo, &blk, size, 0));
+    blk.valid_size = size;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_write(fifo, &blk, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_read(fifo, &blk, 0, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_read(fifo, &blk, 0));
+}
+
+TEST_CASE("FIFO adaptive block count", "[ESP_GMF_FIFO]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_fifo_handle_t fifo = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_create(2, 1, &fifo));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_set_adaptive(fifo, 4, 50));
+
+    // The writer stalls on a full FIFO, it grows up to the ceiling
+    esp_gmf_data_bus_block_t blk = {0};
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_write(fifo, &blk, 256, 0));
+        blk.valid_size = 256;
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_write(fifo, &blk, 0));
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_FAIL, esp_gmf_fifo_acquire_write(fifo, &blk, 256, 0));
+    uint32_t size = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_get_total_size(fifo, &size));
+    TEST_ASSERT_EQUAL(4 * 256, size);
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_read(fifo, &blk, 0, 0));
+        TEST_ASSERT_EQUAL(256, blk.valid_size);
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_read(fifo, &blk, 0));
+    }
+    // No shrink within the quiet period
+    fifo_write_read_once(fifo, 256);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_get_total_size(fifo, &size));
+    TEST_ASSERT_EQUAL(4 * 256, size);
+
+    // One block is freed after each quiet period, down to the initial count
+    for (int i = 3; i >= 2; i--) {
+        vTaskDelay(60 / portTICK_PERIOD_MS);
+        fifo_write_read_once(fifo, 256);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_get_total_size(fifo, &size));
+        TEST_ASSERT_EQUAL(i * 256, size);
+    }
+    vTaskDelay(60 / portTICK_PERIOD_MS);
+    fifo_write_read_once(fifo, 256);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_get_total_size(fifo, &size));
+    TEST_ASSERT_EQUAL(2 * 256, size);
+
+    // The reader underruns on an empty FIFO, more blocks don't help it so the FIFO keeps its size
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_NOT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_read(fifo, &blk, 0, 0));
+    }
+    fifo_write_read_once(fifo, 256);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_get_total_size(fifo, &size));
+    TEST_ASSERT_EQUAL(2 * 256, size);
+
+    // The writer stalls again, it grows again
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_write(fifo, &blk, 256, 0));
+        blk.valid_size = 256;
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_write(fifo, &blk, 0));
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_get_total_size(fifo, &size));
+    TEST_ASSERT_EQUAL(3 * 256, size);
+
+    // Disabled, the surplus block is freed on release and no growth any more
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_set_adaptive(fifo, 0, 0));
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_read(fifo, &blk, 0, 0));
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_read(fifo, &blk, 0));
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_get_total_size(fifo, &size));
+    TEST_ASSERT_EQUAL(2 * 256, size);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_destroy(fifo));
+}
+
+TEST_CASE("FIFO batch read", "[ESP_GMF_FIFO]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_fifo_handle_t fifo = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_create(8, 1, &fifo));
+    esp_gmf_data_bus_block_t blk = {0};
+    for (int i = 0; i < 6; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_write(fifo, &blk, 64, 0));
+        memset(blk.buf, i, 64);
+        blk.valid_size = 64;
+        blk.is_last = (i == 5);
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_write(fifo, &blk, 0));
+    }
+    // The batch keeps the stream order and stops at the last block
+    esp_gmf_data_bus_block_t blks[4] = {0};
+    esp_gmf_data_bus_block_t *pblks[4] = {&blks[0], &blks[1], &blks[2], &blks[3]};
+    TEST_ASSERT_EQUAL(4, esp_gmf_fifo_acquire_read_batch(fifo, pblks, 4, 0));
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(i, blks[i].buf[0]);
+        TEST_ASSERT_EQUAL(64, blks[i].valid_size);
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_FAIL, esp_gmf_fifo_release_read_batch(fifo, &pblks[1], 3, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_read_batch(fifo, pblks, 4, 0));
+    TEST_ASSERT_EQUAL(2, esp_gmf_fifo_acquire_read_batch(fifo, pblks, 4, 0));
+    TEST_ASSERT_EQUAL(5, blks[1].buf[0]);
+    TEST_ASSERT_TRUE(blks[1].is_last);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_release_read_batch(fifo, pblks, 2, 0));
+    TEST_ASSERT_NOT_EQUAL(ESP_GMF_IO_OK, esp_gmf_fifo_acquire_read_batch(fifo, pblks, 4, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_fifo_destroy(fifo));
+
+    // The input port reads a batch from the FIFO data bus
+    esp_gmf_db_handle_t db = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_fifo(8, 1, &db));
+    esp_gmf_port_handle_t in_port = NEW_ESP_GMF_PORT_IN_BLOCK(esp_gmf_db_acquire_read, esp_gmf_db_release_read, NULL, db, 64, 0);
+    TEST_ASSERT_NOT_NULL(in_port);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_write(db, &blk, 64, 0));
+        blk.valid_size = 64;
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(db, &blk, 0));
+    }
+    esp_gmf_payload_t loads[4] = {0};
+    esp_gmf_payload_t *ploads[4] = {&loads[0], &loads[1], &loads[2], &loads[3]};
+    // Without the batch operations one payload is acquired
+    TEST_ASSERT_EQUAL(1, esp_gmf_port_acquire_in_batch(in_port, ploads, 4, 64, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_FAIL, esp_gmf_port_release_in_batch(in_port, ploads, 2, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_port_release_in_batch(in_port, ploads, 1, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_port_set_batch_ops(in_port, (port_acquire_batch)esp_gmf_db_acquire_read_batch,
+                                                                  (port_release_batch)esp_gmf_db_release_read_batch));
+    TEST_ASSERT_EQUAL(2, esp_gmf_port_acquire_in_batch(in_port, ploads, 4, 64, 0));
+    TEST_ASSERT_EQUAL(64, loads[1].valid_size);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_FAIL, esp_gmf_port_release_in_batch(in_port, ploads, 1, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_port_release_in_batch(in_port, ploads, 2, 0));
+    // Without the batch release the payloads are released one by one
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_write(db, &blk, 64, 0));
+        blk.valid_size = 64;
+        TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(db, &blk, 0));
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_port_set_batch_ops(in_port, (port_acquire_batch)esp_gmf_db_acquire_read_batch, NULL));
+    TEST_ASSERT_EQUAL(3, esp_gmf_port_acquire_in_batch(in_port, ploads, 4, 64, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_port_release_in_batch(in_port, ploads, 3, 0));
+    uint32_t filled = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_filled_size(db, &filled));
+    TEST_ASSERT_EQUAL(0, filled);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_port_deinit(in_port));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(db));
+}
+
+static uint32_t port_acquire_cnt;
+static uint32_t port_wake_cnt;
+
+static esp_gmf_err_io_t port_counted_acquire(esp_gmf_db_handle_t db, esp_gmf_payload_t *load, uint32_t wanted_size, int wait_ticks)
+{
+    port_acquire_cnt++;
+    return esp_gmf_db_acquire_read(db, (esp_gmf_data_bus_block_t *)load, wanted_size, wait_ticks);
+}
+
+static esp_gmf_err_io_t port_counted_acquire_batch(esp_gmf_db_handle_t db, esp_gmf_payload_t *loads[], int max_cnt, uint32_t wanted_size, int wait_ticks)
+{
+    port_acquire_cnt++;
+    return esp_gmf_db_acquire_read_batch(db, (esp_gmf_data_bus_block_t **)loads, max_cnt, wanted_size, wait_ticks);
+}
+
+static void port_writer_wake(void *ctx)
+{
+    port_wake_cnt++;
+}
+
+TEST_CASE("FIFO port batch read benchmark", "[ESP_GMF_FIFO]")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    esp_log_level_set(TAG, ESP_LOG_INFO);
+    // 10 ms frames of 16 kHz mono 16 bits, the writer queues a full FIFO before the reader drains it
+    const int frame_size = 320;
+    const int queued = 8;
+    const int rounds = 500;
+    esp_gmf_db_handle_t db = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_fifo(queued, 1, &db));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_set_notify(db, ESP_GMF_DB_READY_WRITE, port_writer_wake, NULL));
+    esp_gmf_port_handle_t in_port = NEW_ESP_GMF_PORT_IN_BLOCK(port_counted_acquire, esp_gmf_db_release_read, NULL, db, frame_size, 0);
+    TEST_ASSERT_NOT_NULL(in_port);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_SUPPORT, esp_gmf_port_set_batch_depth(in_port, queued));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_port_set_batch_ops(in_port, port_counted_acquire_batch,
+                                                                  (port_release_batch)esp_gmf_db_release_read_batch));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_ARG, esp_gmf_port_set_batch_depth(in_port, ESP_GMF_PORT_BATCH_DEPTH_MAX + 1));
+    int64_t cost[2] = {0};
+    uint32_t acquire_cnt[2] = {0};
+    uint32_t wake_cnt[2] = {0};
+    for (int batch = 0; batch < 2; batch++) {
+        // The element reads one payload per call either way, the port reads the queued ones ahead in the batch mode
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_port_set_batch_depth(in_port, batch ? queued : 0));
+        port_acquire_cnt = 0;
+        port_wake_cnt = 0;
+        uint32_t frame_cnt = 0;
+        for (int r = 0; r < rounds; r++) {
+            esp_gmf_data_bus_block_t blk = {0};
+            for (int i = 0; i < queued; i++) {
+                TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_write(db, &blk, frame_size, 0));
+                blk.buf[0] = (uint8_t)i;
+                blk.valid_size = frame_size;
+                TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(db, &blk, 0));
+            }
+            int64_t start = esp_gmf_oal_sys_get_time_us();
+            for (int i = 0; i < queued; i++) {
+                esp_gmf_payload_t *load = NULL;
+                TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_port_acquire_in(in_port, &load, frame_size, 0));
+                TEST_ASSERT_EQUAL(i, load->buf[0]);
+                TEST_ASSERT_EQUAL(frame_size, load->valid_size);
+                TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_port_release_in(in_port, load, 0));
+            }
+            cost[batch] += esp_gmf_oal_sys_get_time_us() - start;
+            frame_cnt += queued;
+        }
+        acquire_cnt[batch] = port_acquire_cnt;
+        wake_cnt[batch] = port_wake_cnt;
+        TEST_ASSERT_EQUAL(queued * rounds, frame_cnt);
+        ESP_LOGI(TAG, "%-6s read, frames:%ld, acquires:%ld, writer wakes:%ld, cost per frame:%lld ns", batch ? "batch" : "single",
+                 frame_cnt, acquire_cnt[batch], wake_cnt[batch], cost[batch] * 1000 / frame_cnt);
+    }
+    // One acquire and one wake up of the writer per batch rather than per frame
+    TEST_ASSERT_EQUAL(queued * rounds, acquire_cnt[0]);
+    TEST_ASSERT_EQUAL(queued * rounds, wake_cnt[0]);
+    TEST_ASSERT_EQUAL(rounds, acquire_cnt[1]);
+    TEST_ASSERT_EQUAL(rounds, wake_cnt[1]);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_port_deinit(in_port));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(db));
+}
@@ -0,0 +1,185 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+
+#include "esp_gmf_element.h"
+#include "esp_gmf_node.h"
+#include "esp_gmf_pipeline.h"
+#include "esp_gmf_pool.h"
+#include "esp_gmf_payload.h"
+#include "esp_gmf_payload_pool.h"
+#include "gmf_fake_io.h"
+#include "gmf_fake_dec.h"
+#include "gmf_ut_common.h"
+
+static const char *TAG = "TEST_ESP_GMF_PLD_POOL";
+
+TEST_CASE("Payload pool attach, reference and detach", "[ESP_GMF_PAYLOAD_POOL]")
+{
+    esp_gmf_payload_pool_handle_t pool = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_ARG, esp_gmf_payload_pool_create(1000, 2, 3, &pool));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_create(1000, 2, 64, &pool));
+
+    esp_gmf_payload_t *load[3] = {NULL};
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_new(&load[i]));
+    }
+    // Too large or too strictly aligned buffers are not served
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_ENOUGH, esp_gmf_payload_pool_attach(pool, 16, 1001, load[0]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_ENOUGH, esp_gmf_payload_pool_attach(pool, 128, 100, load[0]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_attach(pool, 16, 1000, load[0]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_STATE, esp_gmf_payload_pool_attach(pool, 16, 1000, load[0]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_attach(pool, 16, 10, load[1]));
+    TEST_ASSERT_EQUAL(0, (uintptr_t)load[0]->buf % 64);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)load[1]->buf % 64);
+    TEST_ASSERT_EQUAL(1000, load[1]->buf_length);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_ENOUGH, esp_gmf_payload_pool_attach(pool, 16, 10, load[2]));
+
+    // The shared buffer goes back to the pool when the last holder releases it
+    uint16_t free_cnt = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_ref(load[1]));
+    esp_gmf_payload_t shared = *load[1];
+    esp_gmf_payload_delete(load[1]);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_info(pool, NULL, &free_cnt));
+    TEST_ASSERT_EQUAL(0, free_cnt);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_detach(&shared));
+    TEST_ASSERT_NULL(shared.buf);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_info(pool, NULL, &free_cnt));
+    TEST_ASSERT_EQUAL(1, free_cnt);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_attach(pool, 16, 10, load[2]));
+
+    // Growing beyond the pool moves the payload to its own buffer and frees the pooled one
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_realloc_buf(load[0], 2000));
+    TEST_ASSERT_NULL(load[0]->pool);
+    TEST_ASSERT_EQUAL(2000, load[0]->buf_length);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_info(pool, NULL, &free_cnt));
+    TEST_ASSERT_EQUAL(1, free_cnt);
+    esp_gmf_payload_delete(load[0]);
+    esp_gmf_payload_delete(load[2]);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_info(pool, NULL, &free_cnt));
+    TEST_ASSERT_EQUAL(2, free_cnt);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_destroy(pool));
+
+    // The smallest free buffer which fits is taken, a holder which shares the payload drops its reference by the buffer
+    const uint32_t sizes[] = {4000, 1000, 2000};
+    uint32_t buf_size = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_create_with_sizes(sizes, 3, 16, &pool));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_info(pool, &buf_size, &free_cnt));
+    TEST_ASSERT_EQUAL(4000, buf_size);
+    TEST_ASSERT_EQUAL(3, free_cnt);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_new(&load[i]));
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_attach(pool, 16, 1500, load[0]));
+    TEST_ASSERT_EQUAL(2000, load[0]->buf_length);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_attach(pool, 16, 500, load[1]));
+    TEST_ASSERT_EQUAL(1000, load[1]->buf_length);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_ENOUGH, esp_gmf_payload_pool_attach(pool, 16, 4001, load[2]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_attach(pool, 16, 10, load[2]));
+    TEST_ASSERT_EQUAL(4000, load[2]->buf_length);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)load[2]->buf % 16);
+    uint8_t *held = load[0]->buf;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_ref(load[0]));
+    esp_gmf_payload_delete(load[0]);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_info(pool, NULL, &free_cnt));
+    TEST_ASSERT_EQUAL(0, free_cnt);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_ARG, esp_gmf_payload_pool_unref(pool, held + 1));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_unref(pool, held));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_info(pool, NULL, &free_cnt));
+    TEST_ASSERT_EQUAL(1, free_cnt);
+    esp_gmf_payload_delete(load[1]);
+    esp_gmf_payload_delete(load[2]);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_info(pool, NULL, &free_cnt));
+    TEST_ASSERT_EQUAL(3, free_cnt);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_destroy(pool));
+}
+
+static int pipeline_pooled_bufs(esp_gmf_pipeline_handle_t pipe, uint8_t **bufs, int max_cnt)
+{
+    // Collect the buffers of the payloads owned by the ports, each of them must come from the pipeline pool
+    int cnt = 0;
+    esp_gmf_element_handle_t el = pipe->head_el;
+    for (; el; el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el)) {
+        esp_gmf_port_t *ports[] = {ESP_GMF_ELEMENT_GET(el)->in, ESP_GMF_ELEMENT_GET(el)->out};
+        for (int i = 0; i < 2; i++) {
+            esp_gmf_payload_t *load = ports[i] ? ports[i]->self_payload : NULL;
+            if (load && load->buf) {
+                TEST_ASSERT_EQUAL_PTR(pipe->pld_pool, load->pool);
+                TEST_ASSERT_LESS_THAN(max_cnt, cnt);
+                bufs[cnt++] = load->buf;
+            }
+        }
+    }
+    return cnt;
+}
+
+TEST_CASE("Pipeline takes the payloads from the pool, [FILE->dec->dec->dec->FILE]", "[ESP_GMF_PAYLOAD_POOL]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    fake_io_cfg_t io_cfg = FAKE_IO_CFG_DEFAULT();
+    esp_gmf_io_handle_t fs = NULL;
+    io_cfg.dir = ESP_GMF_IO_DIR_READER;
+    fake_io_init(&io_cfg, &fs);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_register_io(pool, fs, NULL));
+    io_cfg.dir = ESP_GMF_IO_DIR_WRITER;
+    fake_io_init(&io_cfg, &fs);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_register_io(pool, fs, NULL));
+    fake_dec_cfg_t dec_cfg = DEFAULT_FAKE_DEC_CONFIG();
+    dec_cfg.name = "dec1";
+    dec_cfg.in_buf_size = 2 * 1024;
+    dec_cfg.out_buf_size = 1 * 1024;
+    esp_gmf_element_handle_t dec = NULL;
+    fake_dec_init(&dec_cfg, &dec);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_register_element(pool, dec, NULL));
+
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    const char *name[] = {"dec1", "dec1", "dec1"};
+    esp_gmf_pool_new_pipeline(pool, "file", name, sizeof(name) / sizeof(char *), "file", &pipe);
+    TEST_ASSERT_NOT_NULL(pipe);
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.ctx = NULL;
+    cfg.cb = NULL;
+    esp_gmf_task_handle_t work_task = NULL;
+    esp_gmf_task_init(&cfg, &work_task);
+    TEST_ASSERT_NOT_NULL(work_task);
+    esp_gmf_pipeline_bind_task(pipe, work_task);
+    esp_gmf_pipeline_set_in_uri(pipe, "/sdcard/gmf_ut_test1.mp3");
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_enable_payload_pool(pipe, true));
+
+    // The pool is sized once by the declared data sizes and kept across the runs. The payload of the first in port
+    // is taken over by the out port of the second decoder, so it needs 2K, the other two payloads need 1K
+    uint32_t buf_size = 0;
+    uint16_t free_cnt = 0;
+    uint8_t *bufs[2][8] = {{NULL}};
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_loading_jobs(pipe));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe));
+        TEST_ASSERT_NOT_NULL(pipe->pld_pool);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_STATE, esp_gmf_pipeline_enable_payload_pool(pipe, false));
+        // All the buffers are pooled and none of them is reallocated mid-stream
+        vTaskDelay(100 / portTICK_PERIOD_MS);
+        TEST_ASSERT_EQUAL(3, pipeline_pooled_bufs(pipe, bufs[0], 8));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_info(pipe->pld_pool, &buf_size, &free_cnt));
+        TEST_ASSERT_EQUAL(2 * 1024, buf_size);
+        TEST_ASSERT_EQUAL(0, free_cnt);
+        vTaskDelay(100 / portTICK_PERIOD_MS);
+        TEST_ASSERT_EQUAL(3, pipeline_pooled_bufs(pipe, bufs[1], 8));
+        TEST_ASSERT_EQUAL_MEMORY(bufs[0], bufs[1], sizeof(bufs[0]));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_stop(pipe));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_pool_get_info(pipe->pld_pool, NULL, &free_cnt));
+        ESP_LOGI(TAG, "Run %d, free payload buffers:%d", i, free_cnt);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_reset(pipe));
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(work_task));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+}
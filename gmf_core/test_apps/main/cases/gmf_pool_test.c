@@ -13,6 +13,7 @@
 #include "esp_gmf_element.h"
 #include "esp_gmf_pipeline.h"
 #include "esp_gmf_pool.h"
+#include "esp_gmf_node.h"
 #include "esp_gmf_data_bus.h"
 
 #include "esp_gmf_oal_mem.h"
@@ -248,6 +249,58 @@ TEST_CASE("Create and destroy pipeline", "[ELEMENT_POOL]")
     esp_gmf_pool_deinit(pool);
 }
 
+TEST_CASE("Find the registered elements and IOs by tag", "[ELEMENT_POOL]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    pool_register_io_func(pool);
+    fake_dec_cfg_t dec_cfg = DEFAULT_FAKE_DEC_CONFIG();
+    esp_gmf_element_handle_t dec = NULL;
+    char name[16] = {0};
+    for (int i = 0; i < 40; i++) {
+        snprintf(name, sizeof(name), "dec%d", i);
+        dec_cfg.name = name;
+        fake_dec_init(&dec_cfg, &dec);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_register_element(pool, dec, NULL));
+    }
+    TEST_ASSERT_EQUAL(esp_gmf_obj_tag_hash("Dec7"), esp_gmf_obj_tag_hash("dEC7"));
+
+    // The lookup ignores case and the found handle is the registered one
+    esp_gmf_element_handle_t found = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_find_element(pool, "DEC25", &found));
+    TEST_ASSERT_EQUAL_STRING("dec25", OBJ_GET_TAG(found));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_pool_find_element(pool, "dec40", &found));
+    TEST_ASSERT_NULL(found);
+
+    // The element registered at head takes precedence over the same tag
+    dec_cfg.name = "dec25";
+    fake_dec_init(&dec_cfg, &dec);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_register_element_at_head(pool, dec, NULL));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_find_element(pool, "dec25", &found));
+    TEST_ASSERT_EQUAL_PTR(dec, found);
+
+    esp_gmf_io_handle_t io = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_find_io(pool, "FILE", ESP_GMF_IO_DIR_WRITER, &io));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_DIR_WRITER, ((esp_gmf_io_t *)io)->dir);
+
+    // The cached handle is duplicated without looking up again
+    esp_gmf_element_handle_t new_el = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_obj_dupl(found, &new_el));
+    TEST_ASSERT_EQUAL_STRING("dec25", OBJ_GET_TAG(new_el));
+    esp_gmf_obj_delete(new_el);
+
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    const char *el_name[] = {"dec3", "Dec17", "dec39"};
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_new_pipeline(pool, "file", el_name, sizeof(el_name) / sizeof(char *), "file", &pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_el_by_name(pipe, "DEC17", &found));
+    TEST_ASSERT_EQUAL_STRING("dec17", OBJ_GET_TAG(found));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_pipeline_get_el_by_name(pipe, "dec1", &found));
+    esp_gmf_pipeline_destroy(pipe);
+    esp_gmf_pool_deinit(pool);
+}
+
 TEST_CASE("One Pipe, [FILE->dec->dec->dec->FILE]", "[ELEMENT_POOL]")
 {
     esp_log_level_set("*", ESP_LOG_INFO);
@@ -291,6 +344,770 @@ TEST_CASE("One Pipe, [FILE->dec->dec->dec->FILE]", "[ELEMENT_POOL]")
 
     ESP_LOGE(TAG, "%s-%d", __func__, __LINE__);
     TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_stop(pipe));
+    esp_gmf_latency_stats_t lat = {0};
+#ifdef CONFIG_ESP_GMF_LATENCY_TRACE_EN
+    // Every element passes the payloads on, the last one writes them out of the pipeline
+    esp_gmf_element_handle_t el = ESP_GMF_PIPELINE_GET_FIRST_ELEMENT(pipe);
+    for (; el; el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el)) {
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_latency_stats(pipe, el, &lat));
+        TEST_ASSERT_GREATER_THAN(0, lat.cnt);
+        TEST_ASSERT_GREATER_OR_EQUAL(lat.min_us, lat.p50_us);
+        TEST_ASSERT_GREATER_OR_EQUAL(lat.p50_us, lat.p99_us);
+        TEST_ASSERT_GREATER_OR_EQUAL(lat.p99_us, lat.max_us);
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_latency_stats(pipe, NULL, &lat));
+    TEST_ASSERT_GREATER_THAN(0, lat.cnt);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_show_latency_stats(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_reset_latency_stats(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_latency_stats(pipe, NULL, &lat));
+    TEST_ASSERT_EQUAL(0, lat.cnt);
+#else
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_SUPPORT, esp_gmf_pipeline_get_latency_stats(pipe, NULL, &lat));
+#endif  /* CONFIG_ESP_GMF_LATENCY_TRACE_EN */
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(work_task));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+}
+
+static int split_stop_cnt;
+
+static esp_err_t _split_pipeline_event(esp_gmf_event_pkt_t *event, void *ctx)
+{
+    ESP_LOGI(TAG, "CB: RECV split pipeline EVT: type:%d, sub:%s", event->type, esp_gmf_event_get_state_str(event->sub));
+    if ((event->type == ESP_GMF_EVT_TYPE_CHANGE_STATE)
+        && ((event->sub == ESP_GMF_EVENT_STATE_STOPPED)
+            || (event->sub == ESP_GMF_EVENT_STATE_FINISHED)
+            || (event->sub == ESP_GMF_EVENT_STATE_ERROR))) {
+        split_stop_cnt++;
+    }
+    return 0;
+}
+
+TEST_CASE("Split Pipe, [FILE->dec->|rb|->dec->|rb|->dec->FILE]", "[ELEMENT_POOL]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_log_level_set("ESP_GMF_PIPELINE", ESP_LOG_DEBUG);
+
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    pool_register_io_func(pool);
+    pool_register_dec_func(pool);
+
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    const char *name[] = {"dec1", "dec2", "dec3"};
+    esp_gmf_pool_new_pipeline(pool, "file", name, sizeof(name) / sizeof(char *), "file", &pipe);
+    TEST_ASSERT_NOT_NULL(pipe);
+
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.ctx = NULL;
+    cfg.cb = NULL;
+    esp_gmf_task_handle_t work_task = NULL;
+    esp_gmf_task_init(&cfg, &work_task);
+    TEST_ASSERT_NOT_NULL(work_task);
+
+    // Invalid split points
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_pipeline_split(pipe, "dec4", NULL));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_ARG, esp_gmf_pipeline_split(pipe, "dec3", NULL));
+
+    esp_gmf_task_cfg_t split_cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    split_cfg.name = "split_dec";
+    split_cfg.thread.core = 1;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_split(pipe, "dec1", &split_cfg));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_STATE, esp_gmf_pipeline_split(pipe, "dec1", &split_cfg));
+    // Pick the split point automatically, only dec2 and dec3 can be split
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_split(pipe, NULL, NULL));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_ARG, esp_gmf_pipeline_split(pipe, NULL, NULL));
+    // The byte ring buffers on the split points can't drop data
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_pipeline_set_split_drop_policy(pipe, "dec3", ESP_GMF_DB_DROP_NEWEST));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_SUPPORT, esp_gmf_pipeline_set_split_drop_policy(pipe, "dec1", ESP_GMF_DB_DROP_NEWEST));
+    uint32_t dropped = 1;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_split_dropped(pipe, "dec1", &dropped));
+    TEST_ASSERT_EQUAL(0, dropped);
+    // The elements around the split points run in different tasks, nothing is spliced there
+    esp_gmf_element_handle_t spliced = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_new_element(pool, "dec3", &spliced));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_SUPPORT, esp_gmf_pipeline_insert_el(pipe, "dec1", spliced));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_SUPPORT, esp_gmf_pipeline_insert_el(pipe, "dec2", spliced));
+    esp_gmf_obj_delete(spliced);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_SUPPORT, esp_gmf_pipeline_remove_el(pipe, "dec2"));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_SUPPORT, esp_gmf_pipeline_remove_el(pipe, "dec3"));
+
+    // The elements are still linked as one pipeline
+    esp_gmf_element_handle_t el = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_el_by_name(pipe, "dec3", &el));
+    TEST_ASSERT_EQUAL_PTR(el, ESP_GMF_PIPELINE_GET_LAST_ELEMENT(pipe));
+
+    esp_gmf_pipeline_bind_task(pipe, work_task);
+    esp_gmf_pipeline_loading_jobs(pipe);
+    esp_gmf_pipeline_set_event(pipe, _split_pipeline_event, NULL);
+    esp_gmf_pipeline_set_in_uri(pipe, test_file_uri);
+
+    for (int i = 0; i < 2; i++) {
+        split_stop_cnt = 0;
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe));
+        vTaskDelay(300 / portTICK_PERIOD_MS);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_pause(pipe));
+        TEST_ASSERT_EQUAL(ESP_GMF_EVENT_STATE_PAUSED, pipe->state);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_seek(pipe, 0));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_resume(pipe));
+        vTaskDelay(300 / portTICK_PERIOD_MS);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_stop(pipe));
+        // The tasks of all the segments are stopped and reported as one
+        TEST_ASSERT_EQUAL(1, split_stop_cnt);
+        TEST_ASSERT_EQUAL(ESP_GMF_EVENT_STATE_STOPPED, pipe->state);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_reset(pipe));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_loading_jobs(pipe));
+    }
+#ifdef CONFIG_ESP_GMF_LATENCY_TRACE_EN
+    // The stamps are carried over the ring buffers, so the end to end latency covers all the segments
+    esp_gmf_latency_stats_t lat = {0};
+    uint32_t el_min_us = 0;
+    for (el = ESP_GMF_PIPELINE_GET_FIRST_ELEMENT(pipe); el; el = (esp_gmf_element_handle_t)esp_gmf_node_for_next((esp_gmf_node_t *)el)) {
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_latency_stats(pipe, el, &lat));
+        TEST_ASSERT_GREATER_THAN(0, lat.cnt);
+        el_min_us += lat.min_us;
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_latency_stats(pipe, NULL, &lat));
+    TEST_ASSERT_GREATER_THAN(0, lat.cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL(el_min_us, lat.min_us);
+#endif  /* CONFIG_ESP_GMF_LATENCY_TRACE_EN */
+#ifdef CONFIG_ESP_GMF_TASK_PROFILING_EN
+    // Every element is profiled by the task of its segment
+    const char *el_names[] = {"dec1", "dec2", "dec3"};
+    for (int i = 0; i < sizeof(el_names) / sizeof(el_names[0]); i++) {
+        esp_gmf_job_stats_t stats = {0};
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_el_by_name(pipe, el_names[i], &el));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_job_stats(pipe, el, &stats));
+        TEST_ASSERT_EQUAL_PTR(el, stats.ctx);
+        TEST_ASSERT_GREATER_THAN(0, stats.call_cnt);
+        TEST_ASSERT_GREATER_OR_EQUAL(stats.blocked_us, stats.total_us);
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_show_job_stats(pipe));
+#endif  /* CONFIG_ESP_GMF_TASK_PROFILING_EN */
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(work_task));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+}
+
+#define BRANCH_TEST_DATA_SIZE (25 * 1024 + 100)
+#define JOIN_TEST_CHUNK_SIZE  (4 * 1024)
+#define JOIN_TEST_DATA_SIZE   (5 * JOIN_TEST_CHUNK_SIZE + 1000)
+
+static inline void pool_register_pattern_io(esp_gmf_pool_handle_t pool, const char *name, uint8_t seed, uint32_t size)
+{
+    fake_io_cfg_t io_cfg = FAKE_IO_CFG_DEFAULT();
+    io_cfg.dir = ESP_GMF_IO_DIR_READER;
+    io_cfg.name = name;
+    io_cfg.seed = seed;
+    io_cfg.data_size = size;
+    esp_gmf_io_handle_t fs = NULL;
+    fake_io_init(&io_cfg, &fs);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_gmf_pool_register_io(pool, fs, NULL));
+}
+
+static inline void pool_register_dump_io(esp_gmf_pool_handle_t pool, const char *name, uint8_t *buf, uint32_t size)
+{
+    fake_io_cfg_t io_cfg = FAKE_IO_CFG_DEFAULT();
+    io_cfg.dir = ESP_GMF_IO_DIR_WRITER;
+    io_cfg.name = name;
+    io_cfg.dump_buf = buf;
+    io_cfg.dump_size = size;
+    esp_gmf_io_handle_t fs = NULL;
+    fake_io_init(&io_cfg, &fs);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_gmf_pool_register_io(pool, fs, NULL));
+}
+
+static inline void check_pattern(const uint8_t *buf, uint32_t size, uint8_t seed, uint32_t start)
+{
+    for (uint32_t i = 0; i < size; i++) {
+        TEST_ASSERT_EQUAL_HEX8(FAKE_IO_PATTERN(seed, start + i), buf[i]);
+    }
+}
+
+static inline void wait_split_pipeline_end(esp_gmf_pipeline_handle_t pipe)
+{
+    for (int i = 0; (i < 500) && (split_stop_cnt == 0); i++) {
+        vTaskDelay(10 / portTICK_PERIOD_MS);
+    }
+    TEST_ASSERT_EQUAL(1, split_stop_cnt);
+}
+
+TEST_CASE("Branch Pipe, [FILE->dec->dec->FILE] and [dec->FILE] fed by the first dec", "[ELEMENT_POOL]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_log_level_set("ESP_GMF_PIPELINE", ESP_LOG_DEBUG);
+
+    uint8_t *trunk_dump = esp_gmf_oal_calloc(1, BRANCH_TEST_DATA_SIZE);
+    uint8_t *branch_dump = esp_gmf_oal_calloc(1, BRANCH_TEST_DATA_SIZE);
+    TEST_ASSERT_NOT_NULL(trunk_dump);
+    TEST_ASSERT_NOT_NULL(branch_dump);
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    pool_register_pattern_io(pool, "pattern", 0, BRANCH_TEST_DATA_SIZE);
+    pool_register_dump_io(pool, "trunk_out", trunk_dump, BRANCH_TEST_DATA_SIZE);
+    pool_register_dump_io(pool, "branch_out", branch_dump, BRANCH_TEST_DATA_SIZE);
+    pool_register_dec_func2(pool);
+
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    const char *name[] = {"dec1", "dec2"};
+    esp_gmf_pool_new_pipeline(pool, "pattern", name, sizeof(name) / sizeof(char *), "trunk_out", &pipe);
+    TEST_ASSERT_NOT_NULL(pipe);
+    esp_gmf_pipeline_handle_t branch = NULL;
+    const char *branch_name[] = {"dec3"};
+    esp_gmf_pool_new_pipeline(pool, NULL, branch_name, sizeof(branch_name) / sizeof(char *), "branch_out", &branch);
+    TEST_ASSERT_NOT_NULL(branch);
+
+    // Invalid tee elements and branches
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_pipeline_add_branch(pipe, "dec4", branch));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_ARG, esp_gmf_pipeline_add_branch(pipe, "dec1", pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_add_branch(pipe, "dec1", branch));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_STATE, esp_gmf_pipeline_add_branch(pipe, "dec1", branch));
+    TEST_ASSERT_EQUAL_PTR(pipe, branch->trunk);
+    // The single out port of the element is shared by the trunk and the branch
+    TEST_ASSERT_NULL(pipe->branches->port);
+
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.ctx = NULL;
+    cfg.cb = NULL;
+    esp_gmf_task_handle_t work_task = NULL;
+    esp_gmf_task_init(&cfg, &work_task);
+    TEST_ASSERT_NOT_NULL(work_task);
+
+    esp_gmf_pipeline_bind_task(pipe, work_task);
+    esp_gmf_pipeline_loading_jobs(pipe);
+    esp_gmf_pipeline_set_event(pipe, _split_pipeline_event, NULL);
+    // The branch runs on the task of the pipeline
+    TEST_ASSERT_EQUAL_PTR(work_task, branch->thread);
+
+    for (int i = 0; i < 2; i++) {
+        split_stop_cnt = 0;
+        memset(trunk_dump, 0, BRANCH_TEST_DATA_SIZE);
+        memset(branch_dump, 0, BRANCH_TEST_DATA_SIZE);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe));
+        // Both the trunk and the branch finish on the end of the input, the task finishes once all their jobs are done
+        wait_split_pipeline_end(pipe);
+        TEST_ASSERT_EQUAL(ESP_GMF_EVENT_STATE_FINISHED, pipe->state);
+        TEST_ASSERT_EQUAL(ESP_GMF_EVENT_STATE_FINISHED, branch->state);
+        uint64_t pos = 0;
+        uint64_t branch_pos = 0;
+        esp_gmf_io_get_pos(ESP_GMF_PIPELINE_GET_OUT_INSTANCE(pipe), &pos);
+        esp_gmf_io_get_pos(ESP_GMF_PIPELINE_GET_OUT_INSTANCE(branch), &branch_pos);
+        ESP_LOGI(TAG, "Run %d, out pos:%lld, branch out pos:%lld", i, pos, branch_pos);
+        TEST_ASSERT_EQUAL(BRANCH_TEST_DATA_SIZE, pos);
+        TEST_ASSERT_EQUAL(BRANCH_TEST_DATA_SIZE, branch_pos);
+        // The branch gets the same bytes as the trunk
+        check_pattern(trunk_dump, BRANCH_TEST_DATA_SIZE, 0, 0);
+        TEST_ASSERT_EQUAL_MEMORY(trunk_dump, branch_dump, BRANCH_TEST_DATA_SIZE);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_reset(pipe));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_loading_jobs(pipe));
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(work_task));
+    // The branch is destroyed with the pipeline
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+    esp_gmf_oal_free(trunk_dump);
+    esp_gmf_oal_free(branch_dump);
+}
+
+TEST_CASE("Branch Pipe with payload pool, [FILE->dec->dec->FILE] and [dec->FILE] reading the pooled payloads of the first dec", "[ELEMENT_POOL]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_log_level_set("ESP_GMF_PIPELINE", ESP_LOG_DEBUG);
+
+    uint8_t *trunk_dump = esp_gmf_oal_calloc(1, BRANCH_TEST_DATA_SIZE);
+    uint8_t *branch_dump = esp_gmf_oal_calloc(1, BRANCH_TEST_DATA_SIZE);
+    TEST_ASSERT_NOT_NULL(trunk_dump);
+    TEST_ASSERT_NOT_NULL(branch_dump);
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    pool_register_pattern_io(pool, "pattern", 0, BRANCH_TEST_DATA_SIZE);
+    pool_register_dump_io(pool, "trunk_out", trunk_dump, BRANCH_TEST_DATA_SIZE);
+    pool_register_dump_io(pool, "branch_out", branch_dump, BRANCH_TEST_DATA_SIZE);
+    pool_register_dec_func2(pool);
+
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    const char *name[] = {"dec1", "dec2"};
+    esp_gmf_pool_new_pipeline(pool, "pattern", name, sizeof(name) / sizeof(char *), "trunk_out", &pipe);
+    TEST_ASSERT_NOT_NULL(pipe);
+    esp_gmf_pipeline_handle_t branch = NULL;
+    const char *branch_name[] = {"dec3"};
+    esp_gmf_pool_new_pipeline(pool, NULL, branch_name, sizeof(branch_name) / sizeof(char *), "branch_out", &branch);
+    TEST_ASSERT_NOT_NULL(branch);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_enable_payload_pool(pipe, true));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_pipeline_set_branch_drop_policy(pipe, branch, ESP_GMF_DB_DROP_NONE));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_add_branch(pipe, "dec1", branch));
+
+    // Only waiting for the branch or dropping its oldest payload are supported
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_SUPPORT, esp_gmf_pipeline_set_branch_drop_policy(pipe, branch, ESP_GMF_DB_DROP_TO_KEY_FRAME));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_pipeline_set_branch_drop_policy(pipe, pipe, ESP_GMF_DB_DROP_NONE));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_set_branch_drop_policy(pipe, branch, ESP_GMF_DB_DROP_OLDEST));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_set_branch_drop_policy(pipe, branch, ESP_GMF_DB_DROP_NONE));
+
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.ctx = NULL;
+    cfg.cb = NULL;
+    esp_gmf_task_handle_t work_task = NULL;
+    esp_gmf_task_init(&cfg, &work_task);
+    TEST_ASSERT_NOT_NULL(work_task);
+
+    esp_gmf_pipeline_bind_task(pipe, work_task);
+    esp_gmf_pipeline_loading_jobs(pipe);
+    esp_gmf_pipeline_set_event(pipe, _split_pipeline_event, NULL);
+
+    for (int i = 0; i < 2; i++) {
+        split_stop_cnt = 0;
+        memset(trunk_dump, 0, BRANCH_TEST_DATA_SIZE);
+        memset(branch_dump, 0, BRANCH_TEST_DATA_SIZE);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe));
+        wait_split_pipeline_end(pipe);
+        TEST_ASSERT_EQUAL(ESP_GMF_EVENT_STATE_FINISHED, pipe->state);
+        TEST_ASSERT_EQUAL(ESP_GMF_EVENT_STATE_FINISHED, branch->state);
+        TEST_ASSERT_NOT_NULL(pipe->pld_pool);
+        uint64_t pos = 0;
+        uint64_t branch_pos = 0;
+        esp_gmf_io_get_pos(ESP_GMF_PIPELINE_GET_OUT_INSTANCE(pipe), &pos);
+        esp_gmf_io_get_pos(ESP_GMF_PIPELINE_GET_OUT_INSTANCE(branch), &branch_pos);
+        ESP_LOGI(TAG, "Run %d, out pos:%lld, branch out pos:%lld", i, pos, branch_pos);
+        TEST_ASSERT_EQUAL(BRANCH_TEST_DATA_SIZE, pos);
+        TEST_ASSERT_EQUAL(BRANCH_TEST_DATA_SIZE, branch_pos);
+        // The branch reads the pooled buffers of the trunk, the trunk must not write over them before the branch releases them
+        check_pattern(trunk_dump, BRANCH_TEST_DATA_SIZE, 0, 0);
+        TEST_ASSERT_EQUAL_MEMORY(trunk_dump, branch_dump, BRANCH_TEST_DATA_SIZE);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_reset(pipe));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_loading_jobs(pipe));
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(work_task));
+    // The broadcast data bus releases its references before the payload pool is destroyed
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+    esp_gmf_oal_free(trunk_dump);
+    esp_gmf_oal_free(branch_dump);
+}
+
+TEST_CASE("Branch Pipe, [FILE->copier->FILE] and two [dec->FILE] on the out ports of the copier", "[ELEMENT_POOL]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_log_level_set("ESP_GMF_PIPELINE", ESP_LOG_DEBUG);
+
+    uint8_t *dump[3] = {NULL};
+    for (int i = 0; i < 3; i++) {
+        dump[i] = esp_gmf_oal_calloc(1, BRANCH_TEST_DATA_SIZE);
+        TEST_ASSERT_NOT_NULL(dump[i]);
+    }
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    pool_register_pattern_io(pool, "pattern", 0, BRANCH_TEST_DATA_SIZE);
+    pool_register_dump_io(pool, "trunk_out", dump[0], BRANCH_TEST_DATA_SIZE);
+    pool_register_dump_io(pool, "branch_out", dump[1], BRANCH_TEST_DATA_SIZE);
+    pool_register_dump_io(pool, "branch_out2", dump[2], BRANCH_TEST_DATA_SIZE);
+    pool_register_dec_func2(pool);
+    // The copier takes an out port for each branch
+    fake_dec_cfg_t fake_dec_cfg = DEFAULT_FAKE_DEC_CONFIG();
+    fake_dec_cfg.name = "copier";
+    fake_dec_cfg.is_pass = true;
+    fake_dec_cfg.is_multi_out = true;
+    fake_dec_cfg.in_buf_size = 10 * 1024;
+    fake_dec_cfg.out_buf_size = 10 * 1024;
+    esp_gmf_element_handle_t fake_dec = NULL;
+    fake_dec_init(&fake_dec_cfg, &fake_dec);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_gmf_pool_register_element(pool, fake_dec, NULL));
+
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    const char *name[] = {"copier"};
+    esp_gmf_pool_new_pipeline(pool, "pattern", name, sizeof(name) / sizeof(char *), "trunk_out", &pipe);
+    TEST_ASSERT_NOT_NULL(pipe);
+    esp_gmf_pipeline_handle_t branch[2] = {NULL};
+    const char *branch_name[][1] = {{"dec3"}, {"dec4"}};
+    const char *branch_out[] = {"branch_out", "branch_out2"};
+    for (int i = 0; i < 2; i++) {
+        esp_gmf_pool_new_pipeline(pool, NULL, branch_name[i], 1, branch_out[i], &branch[i]);
+        TEST_ASSERT_NOT_NULL(branch[i]);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_add_branch(pipe, "copier", branch[i]));
+    }
+    // Each branch has its own out port and data bus
+    esp_gmf_element_handle_t copier = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_el_by_name(pipe, "copier", &copier));
+    esp_gmf_port_handle_t out_port = ESP_GMF_ELEMENT_GET(copier)->out;
+    TEST_ASSERT_EQUAL_PTR(out_port->next, pipe->branches->port);
+    TEST_ASSERT_EQUAL_PTR(out_port->next->next, pipe->branches->next->port);
+    TEST_ASSERT_NOT_EQUAL(pipe->branches->writer, pipe->branches->next->writer);
+
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.ctx = NULL;
+    cfg.cb = NULL;
+    esp_gmf_task_handle_t work_task = NULL;
+    esp_gmf_task_init(&cfg, &work_task);
+    TEST_ASSERT_NOT_NULL(work_task);
+    esp_gmf_pipeline_bind_task(pipe, work_task);
+    esp_gmf_pipeline_loading_jobs(pipe);
+    esp_gmf_pipeline_set_event(pipe, _split_pipeline_event, NULL);
+
+    for (int i = 0; i < 2; i++) {
+        split_stop_cnt = 0;
+        for (int j = 0; j < 3; j++) {
+            memset(dump[j], 0, BRANCH_TEST_DATA_SIZE);
+        }
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe));
+        wait_split_pipeline_end(pipe);
+        TEST_ASSERT_EQUAL(ESP_GMF_EVENT_STATE_FINISHED, pipe->state);
+        check_pattern(dump[0], BRANCH_TEST_DATA_SIZE, 0, 0);
+        for (int j = 0; j < 2; j++) {
+            TEST_ASSERT_EQUAL(ESP_GMF_EVENT_STATE_FINISHED, branch[j]->state);
+            TEST_ASSERT_EQUAL_MEMORY(dump[0], dump[j + 1], BRANCH_TEST_DATA_SIZE);
+        }
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_reset(pipe));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_loading_jobs(pipe));
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(work_task));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+    for (int i = 0; i < 3; i++) {
+        esp_gmf_oal_free(dump[i]);
+    }
+}
+
+TEST_CASE("Join Pipe, [FILE->mux->FILE] and [FILE->dec] joined to the mux", "[ELEMENT_POOL]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_log_level_set("ESP_GMF_PIPELINE", ESP_LOG_DEBUG);
+
+    uint8_t *dump = esp_gmf_oal_calloc(1, 2 * JOIN_TEST_DATA_SIZE);
+    TEST_ASSERT_NOT_NULL(dump);
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    pool_register_pattern_io(pool, "pattern", 0, JOIN_TEST_DATA_SIZE);
+    pool_register_pattern_io(pool, "pattern2", 1, JOIN_TEST_DATA_SIZE);
+    pool_register_dump_io(pool, "trunk_out", dump, 2 * JOIN_TEST_DATA_SIZE);
+    fake_dec_cfg_t fake_dec_cfg = DEFAULT_FAKE_DEC_CONFIG();
+    fake_dec_cfg.name = "mux";
+    fake_dec_cfg.is_multi_in = true;
+    fake_dec_cfg.in_buf_size = JOIN_TEST_CHUNK_SIZE;
+    fake_dec_cfg.out_buf_size = 2 * JOIN_TEST_CHUNK_SIZE;
+    esp_gmf_element_handle_t fake_dec = NULL;
+    fake_dec_init(&fake_dec_cfg, &fake_dec);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_gmf_pool_register_element(pool, fake_dec, NULL));
+    fake_dec_cfg = (fake_dec_cfg_t)DEFAULT_FAKE_DEC_CONFIG();
+    fake_dec_cfg.name = "dec3";
+    fake_dec_cfg.in_buf_size = JOIN_TEST_CHUNK_SIZE;
+    fake_dec_cfg.out_buf_size = JOIN_TEST_CHUNK_SIZE;
+    fake_dec_init(&fake_dec_cfg, &fake_dec);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_gmf_pool_register_element(pool, fake_dec, NULL));
+
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    const char *name[] = {"mux"};
+    esp_gmf_pool_new_pipeline(pool, "pattern", name, sizeof(name) / sizeof(char *), "trunk_out", &pipe);
+    TEST_ASSERT_NOT_NULL(pipe);
+    esp_gmf_pipeline_handle_t branch = NULL;
+    const char *branch_name[] = {"dec3"};
+    esp_gmf_pool_new_pipeline(pool, "pattern2", branch_name, sizeof(branch_name) / sizeof(char *), NULL, &branch);
+    TEST_ASSERT_NOT_NULL(branch);
+
+    // Invalid join elements and branches
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_pipeline_add_join(pipe, "dec4", branch));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_ARG, esp_gmf_pipeline_add_join(pipe, "mux", pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_add_join(pipe, "mux", branch));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_STATE, esp_gmf_pipeline_add_join(pipe, "mux", branch));
+    TEST_ASSERT_EQUAL_PTR(pipe, branch->trunk);
+    esp_gmf_element_handle_t mux = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_el_by_name(pipe, "mux", &mux));
+    TEST_ASSERT_EQUAL_PTR(ESP_GMF_ELEMENT_GET(mux)->in->next, pipe->branches->port);
+
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.ctx = NULL;
+    cfg.cb = NULL;
+    esp_gmf_task_handle_t work_task = NULL;
+    esp_gmf_task_init(&cfg, &work_task);
+    TEST_ASSERT_NOT_NULL(work_task);
+    esp_gmf_pipeline_bind_task(pipe, work_task);
+    esp_gmf_pipeline_loading_jobs(pipe);
+    esp_gmf_pipeline_set_event(pipe, _split_pipeline_event, NULL);
+    TEST_ASSERT_EQUAL_PTR(work_task, branch->thread);
+
+    for (int i = 0; i < 2; i++) {
+        split_stop_cnt = 0;
+        memset(dump, 0, 2 * JOIN_TEST_DATA_SIZE);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe));
+        wait_split_pipeline_end(pipe);
+        TEST_ASSERT_EQUAL(ESP_GMF_EVENT_STATE_FINISHED, pipe->state);
+        TEST_ASSERT_EQUAL(ESP_GMF_EVENT_STATE_FINISHED, branch->state);
+        // The mux takes a chunk of the trunk then a chunk of the branch
+        const uint8_t *out = dump;
+        for (uint32_t pos = 0; pos < JOIN_TEST_DATA_SIZE; pos += JOIN_TEST_CHUNK_SIZE) {
+            uint32_t size = (JOIN_TEST_DATA_SIZE - pos) < JOIN_TEST_CHUNK_SIZE ? (JOIN_TEST_DATA_SIZE - pos) : JOIN_TEST_CHUNK_SIZE;
+            check_pattern(out, size, 0, pos);
+            check_pattern(out + size, size, 1, pos);
+            out += 2 * size;
+        }
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_reset(pipe));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_loading_jobs(pipe));
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(work_task));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+    esp_gmf_oal_free(dump);
+}
+
+TEST_CASE("Connected Pipes, [FILE->dec]-|rb|->[dec->FILE] on one worker of the task pool", "[ELEMENT_POOL]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+
+    uint8_t *dump = esp_gmf_oal_calloc(1, BRANCH_TEST_DATA_SIZE);
+    TEST_ASSERT_NOT_NULL(dump);
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    pool_register_pattern_io(pool, "pattern", 0, BRANCH_TEST_DATA_SIZE);
+    pool_register_dump_io(pool, "conn_out", dump, BRANCH_TEST_DATA_SIZE);
+    pool_register_dec_func(pool);
+
+    esp_gmf_pipeline_handle_t pipe1 = NULL;
+    const char *name1[] = {"dec1"};
+    esp_gmf_pool_new_pipeline(pool, "pattern", name1, sizeof(name1) / sizeof(char *), NULL, &pipe1);
+    TEST_ASSERT_NOT_NULL(pipe1);
+    esp_gmf_pipeline_handle_t pipe2 = NULL;
+    const char *name2[] = {"dec2"};
+    esp_gmf_pool_new_pipeline(pool, NULL, name2, sizeof(name2) / sizeof(char *), "conn_out", &pipe2);
+    TEST_ASSERT_NOT_NULL(pipe2);
+
+    // The ring buffer holds less than the two elements move at once, so the writer finds it full
+    esp_gmf_db_handle_t db = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_ringbuf(1, FAKE_DEC_BUFFER_SIZE + 1024, &db));
+    esp_gmf_port_handle_t out_port = NEW_ESP_GMF_PORT_OUT_BYTE(esp_gmf_db_acquire_write, esp_gmf_db_release_write, NULL, db,
+                                                               FAKE_DEC_BUFFER_SIZE, ESP_GMF_MAX_DELAY);
+    esp_gmf_port_handle_t in_port = NEW_ESP_GMF_PORT_IN_BYTE(esp_gmf_db_acquire_read, esp_gmf_db_release_read, NULL, db,
+                                                             FAKE_DEC_BUFFER_SIZE, ESP_GMF_MAX_DELAY);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_connect_pipe(pipe1, "dec1", out_port, pipe2, "dec2", in_port));
+    // The data bus ports wait for the readiness, a blocking acquire would hold the only worker
+    TEST_ASSERT_NOT_NULL(out_port->ops.ready);
+    TEST_ASSERT_NOT_NULL(in_port->ops.ready);
+
+    esp_gmf_task_pool_cfg_t pool_cfg = DEFAULT_ESP_GMF_TASK_POOL_CONFIG();
+    pool_cfg.worker_num = 1;
+    esp_gmf_task_pool_handle_t task_pool = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_pool_create(&pool_cfg, &task_pool));
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.pool = task_pool;
+    esp_gmf_task_handle_t task1 = NULL;
+    esp_gmf_task_handle_t task2 = NULL;
+    cfg.name = "conn_tsk1";
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_init(&cfg, &task1));
+    cfg.name = "conn_tsk2";
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_init(&cfg, &task2));
+    esp_gmf_pipeline_bind_task(pipe1, task1);
+    esp_gmf_pipeline_bind_task(pipe2, task2);
+    esp_gmf_pipeline_loading_jobs(pipe1);
+    esp_gmf_pipeline_loading_jobs(pipe2);
+    esp_gmf_pipeline_set_event(pipe1, _split_pipeline_event, NULL);
+    esp_gmf_pipeline_set_event(pipe2, _split_pipeline_event, NULL);
+
+    split_stop_cnt = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe2));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe1));
+    for (int i = 0; (i < 500) && (split_stop_cnt < 2); i++) {
+        vTaskDelay(10 / portTICK_PERIOD_MS);
+    }
+    TEST_ASSERT_EQUAL(2, split_stop_cnt);
+    TEST_ASSERT_EQUAL(ESP_GMF_EVENT_STATE_FINISHED, pipe1->state);
+    TEST_ASSERT_EQUAL(ESP_GMF_EVENT_STATE_FINISHED, pipe2->state);
+    uint64_t pos = 0;
+    esp_gmf_io_get_pos(ESP_GMF_PIPELINE_GET_OUT_INSTANCE(pipe2), &pos);
+    TEST_ASSERT_EQUAL(BRANCH_TEST_DATA_SIZE, pos);
+    check_pattern(dump, BRANCH_TEST_DATA_SIZE, 0, 0);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(task1));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(task2));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe1));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe2));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_pool_destroy(task_pool));
+    esp_gmf_db_deinit(db);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+    esp_gmf_oal_free(dump);
+}
+
+#define LIVE_TEST_CHUNK_SIZE FAKE_DEC_BUFFER_SIZE
+#define LIVE_TEST_DATA_SIZE  (40 * LIVE_TEST_CHUNK_SIZE + 1000)
+
+TEST_CASE("Split Pipe, [FILE->dec->|blk|->dec->dec->FILE] dropping the oldest data for the slow reader", "[ELEMENT_POOL]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+
+    uint8_t *dump = esp_gmf_oal_calloc(1, LIVE_TEST_DATA_SIZE);
+    TEST_ASSERT_NOT_NULL(dump);
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    pool_register_pattern_io(pool, "pattern", 0, LIVE_TEST_DATA_SIZE);
+    pool_register_dump_io(pool, "live_out", dump, LIVE_TEST_DATA_SIZE);
+    const char *name[] = {"dec1", "dec2", "dec3"};
+    for (int i = 0; i < sizeof(name) / sizeof(char *); i++) {
+        fake_dec_cfg_t fake_dec_cfg = DEFAULT_FAKE_DEC_CONFIG();
+        fake_dec_cfg.name = name[i];
+        esp_gmf_element_handle_t fake_dec = NULL;
+        fake_dec_init(&fake_dec_cfg, &fake_dec);
+        TEST_ASSERT_EQUAL(ESP_OK, esp_gmf_pool_register_element(pool, fake_dec, NULL));
+    }
+
+    // The reader segment runs two decoders for each chunk the writer segment decodes, so it falls behind
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    esp_gmf_pool_new_pipeline(pool, "pattern", name, sizeof(name) / sizeof(char *), "live_out", &pipe);
+    TEST_ASSERT_NOT_NULL(pipe);
+    esp_gmf_element_handle_t dec1 = NULL;
+    esp_gmf_element_handle_t dec2 = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_el_by_name(pipe, "dec1", &dec1));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_el_by_name(pipe, "dec2", &dec2));
+    // Link the segments by a block data bus, which can drop the data
+    ESP_GMF_ELEMENT_GET(dec1)->out_attr.port.type = ESP_GMF_PORT_TYPE_BLOCK;
+    ESP_GMF_ELEMENT_GET(dec2)->in_attr.port.type = ESP_GMF_PORT_TYPE_BLOCK;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_split(pipe, "dec1", NULL));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_set_split_drop_policy(pipe, "dec1", ESP_GMF_DB_DROP_OLDEST));
+
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.ctx = NULL;
+    cfg.cb = NULL;
+    esp_gmf_task_handle_t work_task = NULL;
+    esp_gmf_task_init(&cfg, &work_task);
+    TEST_ASSERT_NOT_NULL(work_task);
+    esp_gmf_pipeline_bind_task(pipe, work_task);
+    esp_gmf_pipeline_loading_jobs(pipe);
+    esp_gmf_pipeline_set_event(pipe, _split_pipeline_event, NULL);
+
+    split_stop_cnt = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe));
+    // The writer never waits for the reader, so the input is read out at its own pace like a live source
+    uint64_t in_pos = 0;
+    uint64_t out_pos = 0;
+    for (int i = 0; (i < 500) && (in_pos < LIVE_TEST_DATA_SIZE); i++) {
+        vTaskDelay(10 / portTICK_PERIOD_MS);
+        esp_gmf_io_get_pos(ESP_GMF_PIPELINE_GET_IN_INSTANCE(pipe), &in_pos);
+    }
+    TEST_ASSERT_GREATER_OR_EQUAL(LIVE_TEST_DATA_SIZE, in_pos);
+    esp_gmf_io_get_pos(ESP_GMF_PIPELINE_GET_OUT_INSTANCE(pipe), &out_pos);
+    wait_split_pipeline_end(pipe);
+    TEST_ASSERT_EQUAL(ESP_GMF_EVENT_STATE_FINISHED, pipe->state);
+
+    uint32_t dropped = 0;
+    uint64_t end_pos = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_split_dropped(pipe, "dec1", &dropped));
+    esp_gmf_io_get_pos(ESP_GMF_PIPELINE_GET_OUT_INSTANCE(pipe), &end_pos);
+    ESP_LOGI(TAG, "Out pos:%lld at the input end, %lld at last, dropped:%ld", out_pos, end_pos, dropped);
+    TEST_ASSERT_GREATER_THAN(0, dropped);
+    // Every chunk is either dropped or written out, the last one is never dropped
+    TEST_ASSERT_EQUAL(LIVE_TEST_DATA_SIZE, end_pos + dropped * LIVE_TEST_CHUNK_SIZE);
+    check_pattern(dump + end_pos - 1000, 1000, 0, LIVE_TEST_DATA_SIZE - 1000);
+    // The input ends far ahead of the output, which is only possible when the writer doesn't wait for the reader
+    TEST_ASSERT_LESS_THAN(LIVE_TEST_DATA_SIZE - (DEFAULT_ESP_GMF_PIPELINE_SPLIT_DB_CNT + 3) * LIVE_TEST_CHUNK_SIZE, out_pos);
+    // The latency is bounded: once the input ends, only the data bus, the held chunk and the chunks being decoded
+    // are left to write out
+    TEST_ASSERT_LESS_OR_EQUAL((DEFAULT_ESP_GMF_PIPELINE_SPLIT_DB_CNT + 3) * LIVE_TEST_CHUNK_SIZE, end_pos - out_pos);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(work_task));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+    esp_gmf_oal_free(dump);
+}
+
+TEST_CASE("Hot splice, insert and remove dec in [FILE->dec->dec->FILE]", "[ELEMENT_POOL]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_log_level_set("ESP_GMF_PIPELINE", ESP_LOG_DEBUG);
+
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    pool_register_io_func(pool);
+    pool_register_dec_func2(pool);
+
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    const char *name[] = {"dec1", "dec2"};
+    esp_gmf_pool_new_pipeline(pool, "file", name, sizeof(name) / sizeof(char *), "file", &pipe);
+    TEST_ASSERT_NOT_NULL(pipe);
+
+    // Insert without task, the element is spliced in at once
+    esp_gmf_element_handle_t el = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_new_element(pool, "dec3", &el));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_pipeline_insert_el(pipe, "dec4", el));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_insert_el(pipe, "dec2", el));
+    TEST_ASSERT_EQUAL_PTR(el, pipe->last_el);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_ARG, esp_gmf_pipeline_insert_el(pipe, "dec1", el));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_SUPPORT, esp_gmf_pipeline_remove_el(pipe, "dec1"));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_remove_el(pipe, "dec3"));
+    esp_gmf_element_handle_t found = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_pipeline_get_el_by_name(pipe, "dec3", &found));
+    // The element reading bytes only is linked through a byte port, and rejected without a port type in common
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_new_element(pool, "dec3", &el));
+    ESP_GMF_ELEMENT_GET(el)->in_attr.port.type = ESP_GMF_PORT_TYPE_BYTE;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_el_by_name(pipe, "dec1", &found));
+    ESP_GMF_ELEMENT_GET(found)->out_attr.port.type = ESP_GMF_PORT_TYPE_BLOCK;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_SUPPORT, esp_gmf_pipeline_insert_el(pipe, "dec1", el));
+    ESP_GMF_ELEMENT_GET(found)->out_attr.port.type = ESP_GMF_PORT_TYPE_BLOCK | ESP_GMF_PORT_TYPE_BYTE;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_insert_el(pipe, "dec1", el));
+    TEST_ASSERT_EQUAL(ESP_GMF_PORT_TYPE_BYTE, ESP_GMF_ELEMENT_GET(el)->in->attr.type);
+    TEST_ASSERT_EQUAL(ESP_GMF_PORT_TYPE_BYTE, ESP_GMF_ELEMENT_GET(found)->out->attr.type);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_remove_el(pipe, "dec3"));
+
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.ctx = NULL;
+    cfg.cb = NULL;
+    esp_gmf_task_handle_t work_task = NULL;
+    esp_gmf_task_init(&cfg, &work_task);
+    TEST_ASSERT_NOT_NULL(work_task);
+    esp_gmf_pipeline_bind_task(pipe, work_task);
+    esp_gmf_pipeline_loading_jobs(pipe);
+    esp_gmf_pipeline_set_event(pipe, _split_pipeline_event, NULL);
+    esp_gmf_pipeline_set_in_uri(pipe, test_file_uri);
+
+    for (int i = 0; i < 2; i++) {
+        split_stop_cnt = 0;
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe));
+        vTaskDelay(100 / portTICK_PERIOD_MS);
+        esp_gmf_element_handle_t dec1 = NULL;
+        esp_gmf_element_handle_t dec2 = NULL;
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_el_by_name(pipe, "dec1", &dec1));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_el_by_name(pipe, "dec2", &dec2));
+        uint32_t dec1_opened = fake_dec_get_open_count(dec1);
+        uint32_t dec2_opened = fake_dec_get_open_count(dec2);
+        TEST_ASSERT_GREATER_THAN(0, dec1_opened);
+        TEST_ASSERT_GREATER_THAN(0, dec2_opened);
+        // Insert in the middle of the running pipeline, the new element opens alone
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_new_element(pool, "dec3", &el));
+        if (i == 1) {
+            // The second time the data flows into it through a byte port
+            ESP_GMF_ELEMENT_GET(el)->in_attr.port.type = ESP_GMF_PORT_TYPE_BYTE;
+        }
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_insert_el(pipe, "dec1", el));
+        vTaskDelay(100 / portTICK_PERIOD_MS);
+        TEST_ASSERT_NULL(pipe->splice);
+        TEST_ASSERT_EQUAL_PTR(el, esp_gmf_node_for_next((esp_gmf_node_t *)pipe->head_el));
+        TEST_ASSERT_EQUAL(i ? ESP_GMF_PORT_TYPE_BYTE : ESP_GMF_PORT_TYPE_BLOCK, ESP_GMF_ELEMENT_GET(el)->in->attr.type);
+        esp_gmf_event_state_t st = ESP_GMF_EVENT_STATE_NONE;
+        esp_gmf_element_get_state(el, &st);
+        TEST_ASSERT_EQUAL(ESP_GMF_EVENT_STATE_RUNNING, st);
+        esp_gmf_task_get_state(work_task, &st);
+        TEST_ASSERT_EQUAL(ESP_GMF_EVENT_STATE_RUNNING, st);
+        uint64_t pos = 0;
+        esp_gmf_io_get_pos(ESP_GMF_PIPELINE_GET_OUT_INSTANCE(pipe), &pos);
+        // Remove it while the data keeps flowing
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_remove_el(pipe, "dec3"));
+        vTaskDelay(100 / portTICK_PERIOD_MS);
+        TEST_ASSERT_NULL(pipe->splice);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_pipeline_get_el_by_name(pipe, "dec3", &found));
+        uint64_t new_pos = 0;
+        esp_gmf_io_get_pos(ESP_GMF_PIPELINE_GET_OUT_INSTANCE(pipe), &new_pos);
+        ESP_LOGI(TAG, "Run %d, out pos:%lld, after removal:%lld", i, pos, new_pos);
+        TEST_ASSERT_GREATER_THAN(pos, new_pos);
+        // The elements around the spliced one keep running without reopen
+        TEST_ASSERT_EQUAL(dec1_opened, fake_dec_get_open_count(dec1));
+        TEST_ASSERT_EQUAL(dec2_opened, fake_dec_get_open_count(dec2));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_stop(pipe));
+        TEST_ASSERT_EQUAL(1, split_stop_cnt);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_reset(pipe));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_loading_jobs(pipe));
+    }
     TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(work_task));
     TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
     TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
@@ -340,6 +1157,150 @@ TEST_CASE("One Pipe, [FILE->dec->FILE]", "[ELEMENT_POOL]")
     TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
 }
 
+static int warm_reset_cnt;
+
+static esp_gmf_job_err_t _warm_reset(esp_gmf_element_handle_t self, void *para)
+{
+    warm_reset_cnt++;
+    return ESP_GMF_JOB_ERR_OK;
+}
+
+TEST_CASE("Warm restart, [FILE->dec->dec->FILE]", "[ELEMENT_POOL]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    pool_register_io_func(pool);
+    pool_register_dec_func(pool);
+
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    const char *name[] = {"dec1", "dec2"};
+    esp_gmf_pool_new_pipeline(pool, "file", name, sizeof(name) / sizeof(char *), "file", &pipe);
+    TEST_ASSERT_NOT_NULL(pipe);
+
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.ctx = NULL;
+    cfg.cb = NULL;
+    esp_gmf_task_handle_t work_task = NULL;
+    esp_gmf_task_init(&cfg, &work_task);
+    TEST_ASSERT_NOT_NULL(work_task);
+
+    // Only the element supporting reset is kept opened
+    esp_gmf_element_handle_t dec1 = NULL;
+    esp_gmf_element_handle_t dec2 = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_el_by_name(pipe, "dec1", &dec1));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_el_by_name(pipe, "dec2", &dec2));
+    ESP_GMF_ELEMENT_GET(dec2)->ops.reset = _warm_reset;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_INVALID_ARG, esp_gmf_pipeline_set_warm_restart(NULL, true));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_set_warm_restart(pipe, true));
+
+    esp_gmf_pipeline_bind_task(pipe, work_task);
+    esp_gmf_pipeline_set_event(pipe, _pipeline_event, NULL);
+    esp_gmf_pipeline_set_in_uri(pipe, test_file_uri);
+
+    warm_reset_cnt = 0;
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_loading_jobs(pipe));
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe));
+        vTaskDelay(200 / portTICK_PERIOD_MS);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_stop(pipe));
+        TEST_ASSERT_FALSE(ESP_GMF_ELEMENT_GET(dec1)->opened);
+        TEST_ASSERT_TRUE(ESP_GMF_ELEMENT_GET(dec2)->opened);
+        // Opened by the first run, then reset by the others
+        TEST_ASSERT_EQUAL(i, warm_reset_cnt);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_reset(pipe));
+    }
+    // The kept element is closed once the warm restart is disabled
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_set_warm_restart(pipe, false));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_reset(pipe));
+    TEST_ASSERT_FALSE(ESP_GMF_ELEMENT_GET(dec2)->opened);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_loading_jobs(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe));
+    vTaskDelay(200 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_stop(pipe));
+    TEST_ASSERT_FALSE(ESP_GMF_ELEMENT_GET(dec2)->opened);
+    TEST_ASSERT_EQUAL(2, warm_reset_cnt);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(work_task));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+}
+
+TEST_CASE("In-place plan, [FILE->dec->dec->dec->dec->FILE]", "[ELEMENT_POOL]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+
+    esp_gmf_pool_handle_t pool = NULL;
+    esp_gmf_pool_init(&pool);
+    TEST_ASSERT_NOT_NULL(pool);
+    pool_register_io_func(pool);
+    fake_dec_cfg_t fake_dec_cfg = DEFAULT_FAKE_DEC_CONFIG();
+    fake_dec_cfg.name = "dec1";
+    fake_dec_cfg.in_buf_size = 4 * 1024;
+    fake_dec_cfg.out_buf_size = 4 * 1024;
+    esp_gmf_element_handle_t fake_dec = NULL;
+    fake_dec_init(&fake_dec_cfg, &fake_dec);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_gmf_pool_register_element(pool, fake_dec, NULL));
+    // The passing elements write the output over the input when the plan grants it
+    fake_dec_cfg.name = "dec2";
+    fake_dec_cfg.is_pass = true;
+    fake_dec_init(&fake_dec_cfg, &fake_dec);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_gmf_pool_register_element(pool, fake_dec, NULL));
+    fake_dec_cfg.name = "dec3";
+    fake_dec_cfg.out_buf_size = 8 * 1024;
+    fake_dec_init(&fake_dec_cfg, &fake_dec);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_gmf_pool_register_element(pool, fake_dec, NULL));
+    fake_dec_cfg.name = "dec4";
+    fake_dec_cfg.in_buf_size = 8 * 1024;
+    fake_dec_init(&fake_dec_cfg, &fake_dec);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_gmf_pool_register_element(pool, fake_dec, NULL));
+
+    esp_gmf_pipeline_handle_t pipe = NULL;
+    const char *name[] = {"dec1", "dec2", "dec3", "dec4"};
+    esp_gmf_pool_new_pipeline(pool, "file", name, sizeof(name) / sizeof(char *), "file", &pipe);
+    TEST_ASSERT_NOT_NULL(pipe);
+    esp_gmf_element_handle_t dec[4] = {NULL};
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_get_el_by_name(pipe, name[i], &dec[i]));
+    }
+    // dec3 doubles the data on the buffer of dec1, dec4 needs a more aligned output than the buffer has
+    ESP_GMF_ELEMENT_GET(dec[1])->in_place.enable = true;
+    ESP_GMF_ELEMENT_GET(dec[2])->in_place.enable = true;
+    ESP_GMF_ELEMENT_GET(dec[2])->in_place.grow_pct = 100;
+    ESP_GMF_ELEMENT_GET(dec[3])->in_place.enable = true;
+    ESP_GMF_ELEMENT_GET(dec[3])->out->attr.buf_addr_aligned = 64;
+
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.ctx = NULL;
+    cfg.cb = NULL;
+    esp_gmf_task_handle_t work_task = NULL;
+    esp_gmf_task_init(&cfg, &work_task);
+    TEST_ASSERT_NOT_NULL(work_task);
+    esp_gmf_pipeline_bind_task(pipe, work_task);
+    esp_gmf_pipeline_loading_jobs(pipe);
+    esp_gmf_pipeline_set_event(pipe, _pipeline_event, NULL);
+    esp_gmf_pipeline_set_in_uri(pipe, test_file_uri);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_run(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_show_in_place_plan(pipe));
+    TEST_ASSERT_TRUE(ESP_GMF_ELEMENT_GET(dec[1])->in->is_shared);
+    TEST_ASSERT_TRUE(ESP_GMF_ELEMENT_GET(dec[2])->in->is_shared);
+    TEST_ASSERT_FALSE(ESP_GMF_ELEMENT_GET(dec[3])->in->is_shared);
+    TEST_ASSERT_EQUAL(100, ESP_GMF_ELEMENT_GET(dec[0])->out->headroom_pct);
+    TEST_ASSERT_EQUAL(0, ESP_GMF_ELEMENT_GET(dec[2])->out->headroom_pct);
+    vTaskDelay(200 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_stop(pipe));
+    // The buffer shared by dec1, dec2 and dec3 is allocated once with the room for dec3
+    TEST_ASSERT_NOT_NULL(ESP_GMF_ELEMENT_GET(dec[0])->out->self_payload);
+    TEST_ASSERT_GREATER_OR_EQUAL(8 * 1024, ESP_GMF_ELEMENT_GET(dec[0])->out->self_payload->buf_length);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(work_task));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pipeline_destroy(pipe));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_pool_deinit(pool));
+}
+
 TEST_CASE("IN-OUT Different payload, [FILE->dec->FILE]", "[ELEMENT_PORT]")
 {
     esp_log_level_set("*", ESP_LOG_INFO);
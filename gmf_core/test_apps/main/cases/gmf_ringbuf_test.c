@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
 #include "unity.h"
 #include "freertos/FreeRTOS.h"
 #include "esp_private/esp_clk.h"
@@ -11,7 +12,11 @@
 #include "esp_log.h"
 
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_payload.h"
 #include "esp_gmf_ringbuffer.h"
+#include "esp_gmf_data_bus.h"
+#include "esp_gmf_new_databus.h"
+#include "esp_gmf_port.h"
 #include "gmf_ut_common.h"
 
 static const char *TAG = "TEST_ESP_GMF_RINGBUF";
@@ -110,6 +115,508 @@ write_task_err:
     vTaskDelete(NULL);
 }
 
+static void db_ready_notify(void *ctx)
+{
+    (*(int *)ctx)++;
+}
+
+TEST_CASE("Ringbuffer data bus readiness and notification", "[ESP_GMF_RINGBUF]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_db_handle_t db = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_ringbuf(1, 1024, &db));
+    int read_notified = 0;
+    int write_notified = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_set_notify(db, ESP_GMF_DB_READY_READ, db_ready_notify, &read_notified));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_set_notify(db, ESP_GMF_DB_READY_WRITE, db_ready_notify, &write_notified));
+
+    bool ready = true;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_is_ready(db, ESP_GMF_DB_READY_READ, 256, &ready));
+    TEST_ASSERT_FALSE(ready);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_is_ready(db, ESP_GMF_DB_READY_WRITE, 256, &ready));
+    TEST_ASSERT_TRUE(ready);
+
+    uint8_t buf[512] = {0};
+    esp_gmf_data_bus_block_t blk = {.buf = buf, .buf_length = sizeof(buf), .valid_size = sizeof(buf)};
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_write(db, &blk, sizeof(buf), 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(db, &blk, 0));
+    TEST_ASSERT_EQUAL(1, read_notified);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_is_ready(db, ESP_GMF_DB_READY_READ, 256, &ready));
+    TEST_ASSERT_TRUE(ready);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_is_ready(db, ESP_GMF_DB_READY_WRITE, 1024, &ready));
+    TEST_ASSERT_FALSE(ready);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(db, &blk, sizeof(buf), 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_read(db, &blk, 0));
+    TEST_ASSERT_EQUAL(1, write_notified);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_is_ready(db, ESP_GMF_DB_READY_READ, 256, &ready));
+    TEST_ASSERT_FALSE(ready);
+
+    // The reader is ready without data once writing is done, until the data bus is reset
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_done_write(db));
+    TEST_ASSERT_EQUAL(2, read_notified);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_is_ready(db, ESP_GMF_DB_READY_READ, 256, &ready));
+    TEST_ASSERT_TRUE(ready);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_reset(db));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_is_ready(db, ESP_GMF_DB_READY_READ, 256, &ready));
+    TEST_ASSERT_FALSE(ready);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_abort(db));
+    TEST_ASSERT_EQUAL(3, read_notified);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_is_ready(db, ESP_GMF_DB_READY_READ, 256, &ready));
+    TEST_ASSERT_TRUE(ready);
+
+    // Each context keeps its own notification, e.g. the tasks of several pipelines reading one data bus
+    int more_notified[ESP_GMF_DB_NOTIFY_MAX] = {0};
+    for (int i = 0; i < ESP_GMF_DB_NOTIFY_MAX - 1; i++) {
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_set_notify(db, ESP_GMF_DB_READY_READ, db_ready_notify, &more_notified[i]));
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_ENOUGH, esp_gmf_db_set_notify(db, ESP_GMF_DB_READY_READ, db_ready_notify,
+                                                                    &more_notified[ESP_GMF_DB_NOTIFY_MAX - 1]));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_done_write(db));
+    TEST_ASSERT_EQUAL(4, read_notified);
+    TEST_ASSERT_EQUAL(1, more_notified[0]);
+    TEST_ASSERT_EQUAL(0, more_notified[ESP_GMF_DB_NOTIFY_MAX - 1]);
+    // Clearing the notification of one context keeps the others
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_set_notify(db, ESP_GMF_DB_READY_READ, NULL, &read_notified));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_done_write(db));
+    TEST_ASSERT_EQUAL(4, read_notified);
+    TEST_ASSERT_EQUAL(2, more_notified[0]);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_set_notify(db, ESP_GMF_DB_READY_READ, NULL, NULL));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_done_write(db));
+    TEST_ASSERT_EQUAL(4, read_notified);
+    TEST_ASSERT_EQUAL(2, more_notified[0]);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(db));
+}
+
+TEST_CASE("Ringbuffer in-place read and write", "[ESP_GMF_RINGBUF]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_rb_handle_t rb = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_rb_create(1, 1024, &rb));
+    uint8_t pattern[1024];
+    uint8_t rd_buf[1024];
+    for (int i = 0; i < sizeof(pattern); i++) {
+        pattern[i] = (uint8_t)(i * 7);
+    }
+    // Write and read in place at the head of the storage
+    esp_gmf_data_bus_block_t wr_blk = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_rb_acquire_write_in_place(rb, &wr_blk, 600, 0));
+    TEST_ASSERT_NOT_NULL(wr_blk.buf);
+    TEST_ASSERT_EQUAL(600, wr_blk.buf_length);
+    uint8_t *head = wr_blk.buf;
+    memcpy(wr_blk.buf, pattern, 600);
+    wr_blk.valid_size = 600;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_rb_release_write(rb, &wr_blk, 0));
+    esp_gmf_data_bus_block_t rd_blk = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_rb_acquire_read_in_place(rb, &rd_blk, 512, 0));
+    TEST_ASSERT_EQUAL_PTR(head, rd_blk.buf);
+    TEST_ASSERT_EQUAL(512, rd_blk.valid_size);
+    TEST_ASSERT_EQUAL_MEMORY(pattern, rd_blk.buf, 512);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_rb_release_read(rb, &rd_blk, 0));
+
+    // Neither the tail nor the head has 600 contiguous bytes, while 500 bytes wrap to the head early
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_TIMEOUT, esp_gmf_rb_acquire_write_in_place(rb, &wr_blk, 600, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_rb_acquire_write_in_place(rb, &wr_blk, 500, 0));
+    TEST_ASSERT_EQUAL_PTR(head, wr_blk.buf);
+    memcpy(wr_blk.buf, pattern + 100, 500);
+    wr_blk.valid_size = 500;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_rb_release_write(rb, &wr_blk, 0));
+    uint32_t size = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_rb_bytes_filled(rb, &size));
+    TEST_ASSERT_EQUAL(588, size);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_rb_bytes_available(rb, &size));
+    TEST_ASSERT_EQUAL(12, size);
+
+    // The copied read skips the unused tail
+    esp_gmf_data_bus_block_t copy_blk = {.buf = rd_buf, .buf_length = sizeof(rd_buf)};
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_rb_acquire_read(rb, &copy_blk, 588, 0));
+    TEST_ASSERT_EQUAL(588, copy_blk.valid_size);
+    TEST_ASSERT_EQUAL_MEMORY(pattern + 512, rd_buf, 88);
+    TEST_ASSERT_EQUAL_MEMORY(pattern + 100, rd_buf + 88, 500);
+
+    // The copied write is read in place
+    copy_blk.buf = pattern;
+    copy_blk.valid_size = 300;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_rb_release_write(rb, &copy_blk, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_rb_acquire_read_in_place(rb, &rd_blk, 300, 0));
+    TEST_ASSERT_EQUAL_PTR(head + 500, rd_blk.buf);
+    TEST_ASSERT_EQUAL(300, rd_blk.valid_size);
+    TEST_ASSERT_EQUAL_MEMORY(pattern, rd_blk.buf, 300);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_rb_release_read(rb, &rd_blk, 0));
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_rb_done_write(rb));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_rb_acquire_read_in_place(rb, &rd_blk, 300, 0));
+    TEST_ASSERT_EQUAL(0, rd_blk.valid_size);
+    TEST_ASSERT_TRUE(rd_blk.is_last);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_rb_destroy(rb));
+}
+
+TEST_CASE("Ringbuffer keeps the copy on the NULL block buffer", "[ESP_GMF_RINGBUF]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_db_handle_t db = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_ringbuf(1, 1024, &db));
+    uint8_t pattern[1024];
+    uint8_t rd_buf[1024];
+    for (int i = 0; i < sizeof(pattern); i++) {
+        pattern[i] = (uint8_t)(i * 3);
+    }
+    // Acquiring the write with a NULL buffer does nothing, the buffer set afterwards is copied on release
+    esp_gmf_data_bus_block_t blk = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_write(db, &blk, 800, 0));
+    TEST_ASSERT_NULL(blk.buf);
+    blk.buf = pattern;
+    blk.valid_size = 800;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(db, &blk, 0));
+    esp_gmf_data_bus_block_t rd_blk = {.buf = rd_buf, .buf_length = sizeof(rd_buf)};
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(db, &rd_blk, 600, 0));
+    TEST_ASSERT_EQUAL_MEMORY(pattern, rd_buf, 600);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_read(db, &rd_blk, 0));
+
+    // Wrap the data around the end of the storage
+    memset(&blk, 0, sizeof(blk));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_write(db, &blk, 600, 0));
+    blk.buf = pattern + 200;
+    blk.valid_size = 600;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(db, &blk, 0));
+    uint32_t size = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_filled_size(db, &size));
+    TEST_ASSERT_EQUAL(800, size);
+
+    // Reading with a NULL buffer discards the whole wanted size, even across the wrap point
+    esp_gmf_data_bus_block_t drop_blk = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(db, &drop_blk, 500, 0));
+    TEST_ASSERT_NULL(drop_blk.buf);
+    TEST_ASSERT_EQUAL(500, drop_blk.valid_size);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_read(db, &drop_blk, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_filled_size(db, &size));
+    TEST_ASSERT_EQUAL(300, size);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(db, &rd_blk, 300, 0));
+    TEST_ASSERT_EQUAL(300, rd_blk.valid_size);
+    TEST_ASSERT_EQUAL_MEMORY(pattern + 500, rd_buf, 300);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(db));
+}
+
+TEST_CASE("Ringbuffer block ports read the memory written in place", "[ESP_GMF_RINGBUF]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_db_handle_t db = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_ringbuf(1, 1024, &db));
+    esp_gmf_port_handle_t out_port = NEW_ESP_GMF_PORT_OUT_BLOCK(esp_gmf_db_acquire_payload_write_in_place, esp_gmf_db_release_payload_write,
+                                                                NULL, db, 600, 0);
+    esp_gmf_port_handle_t in_port = NEW_ESP_GMF_PORT_IN_BLOCK(esp_gmf_db_acquire_payload_read_in_place, esp_gmf_db_release_payload_read,
+                                                              NULL, db, 600, 0);
+    TEST_ASSERT_NOT_NULL(out_port);
+    TEST_ASSERT_NOT_NULL(in_port);
+    uint8_t pattern[1024];
+    for (int i = 0; i < sizeof(pattern); i++) {
+        pattern[i] = (uint8_t)(i * 5);
+    }
+    // The reader gets the very memory the writer wrote
+    esp_gmf_payload_t *out_load = NULL;
+    esp_gmf_payload_t *in_load = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_port_acquire_out(out_port, &out_load, 600, 0));
+    TEST_ASSERT_NOT_NULL(out_load->buf);
+    TEST_ASSERT_EQUAL(600, out_load->buf_length);
+    uint8_t *head = out_load->buf;
+    memcpy(out_load->buf, pattern, 600);
+    out_load->valid_size = 600;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_port_release_out(out_port, out_load, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_port_acquire_in(in_port, &in_load, 600, 0));
+    TEST_ASSERT_EQUAL_PTR(head, in_load->buf);
+    TEST_ASSERT_EQUAL(600, in_load->valid_size);
+    TEST_ASSERT_EQUAL_MEMORY(pattern, in_load->buf, 600);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_port_release_in(in_port, in_load, 0));
+    uint32_t size = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_filled_size(db, &size));
+    TEST_ASSERT_EQUAL(0, size);
+
+    // The emptied storage is written from its head again, and a read spans the regions of two writes
+    out_load = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_port_acquire_out(out_port, &out_load, 500, 0));
+    TEST_ASSERT_EQUAL_PTR(head, out_load->buf);
+    memcpy(out_load->buf, pattern + 100, 500);
+    out_load->valid_size = 500;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_port_release_out(out_port, out_load, 0));
+    out_load = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_port_acquire_out(out_port, &out_load, 400, 0));
+    TEST_ASSERT_EQUAL_PTR(head + 500, out_load->buf);
+    memcpy(out_load->buf, pattern + 600, 400);
+    out_load->valid_size = 400;
+    out_load->is_done = true;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_port_release_out(out_port, out_load, 0));
+    in_load = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_port_acquire_in(in_port, &in_load, 600, 0));
+    TEST_ASSERT_EQUAL_PTR(head, in_load->buf);
+    TEST_ASSERT_EQUAL(600, in_load->valid_size);
+    TEST_ASSERT_EQUAL_MEMORY(pattern + 100, in_load->buf, 600);
+    TEST_ASSERT_FALSE(in_load->is_done);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_port_release_in(in_port, in_load, 0));
+    in_load = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_port_acquire_in(in_port, &in_load, 600, 0));
+    TEST_ASSERT_EQUAL_PTR(head + 600, in_load->buf);
+    TEST_ASSERT_EQUAL(300, in_load->valid_size);
+    TEST_ASSERT_EQUAL_MEMORY(pattern + 700, in_load->buf, 300);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_port_release_in(in_port, in_load, 0));
+    in_load = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_port_acquire_in(in_port, &in_load, 600, 0));
+    TEST_ASSERT_EQUAL(0, in_load->valid_size);
+    TEST_ASSERT_TRUE(in_load->is_done);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_port_release_in(in_port, in_load, 0));
+    esp_gmf_port_deinit(out_port);
+    esp_gmf_port_deinit(in_port);
+
+    // A payload owning its buffer is refused, so is a data bus which can't hand out its storage
+    esp_gmf_payload_t *load = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_new_with_len(64, &load));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_FAIL, esp_gmf_db_acquire_payload_read_in_place(db, load, 64, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_FAIL, esp_gmf_db_acquire_payload_write_in_place(db, load, 64, 0));
+    esp_gmf_payload_delete(load);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(db));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_block(64, 2, &db));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_payload_new(&load));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_FAIL, esp_gmf_db_acquire_payload_write_in_place(db, load, 64, 0));
+    esp_gmf_payload_delete(load);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(db));
+}
+
+#ifdef CONFIG_ESP_GMF_DB_STATS_EN
+TEST_CASE("Data bus statistics of watermarks, blocking and timeouts", "[ESP_GMF_RINGBUF]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_db_handle_t db = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_ringbuf(256, 4, &db));
+    uint8_t buf[1024] = {0};
+    esp_gmf_data_bus_block_t wr_blk = {.buf = buf, .buf_length = sizeof(buf), .valid_size = 600};
+    esp_gmf_data_bus_block_t rd_blk = {.buf = buf, .buf_length = sizeof(buf)};
+    esp_gmf_db_stats_t stats = {0};
+
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_write(db, &wr_blk, 600, portMAX_DELAY));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(db, &wr_blk, portMAX_DELAY));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(db, &rd_blk, 512, portMAX_DELAY));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_read(db, &rd_blk, 0));
+    // Not enough data, the reader waits and times out
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_TIMEOUT, esp_gmf_db_acquire_read(db, &rd_blk, 512, 1));
+    // Fill up the ringbuffer, then the copy of the writer waits for space and times out
+    wr_blk.valid_size = 1024;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(db, &wr_blk, 1));
+    wr_blk.valid_size = 4;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_TIMEOUT, esp_gmf_db_release_write(db, &wr_blk, 1));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_abort(db));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_ABORT, esp_gmf_db_release_write(db, &wr_blk, portMAX_DELAY));
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_stats(db, &stats));
+    TEST_ASSERT_EQUAL(1024, stats.high_watermark);
+    TEST_ASSERT_EQUAL(88, stats.low_watermark);
+    TEST_ASSERT_EQUAL(2, stats.reader.acquire_cnt);
+    TEST_ASSERT_EQUAL(1, stats.reader.block_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stats.reader.block_us);
+    TEST_ASSERT_EQUAL(1, stats.reader.timeout_cnt);
+    TEST_ASSERT_EQUAL(1, stats.writer.acquire_cnt);
+    TEST_ASSERT_EQUAL(1, stats.writer.block_cnt);
+    TEST_ASSERT_EQUAL(1, stats.writer.timeout_cnt);
+    TEST_ASSERT_EQUAL(1, stats.writer.abort_cnt);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_reset_stats(db));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_stats(db, &stats));
+    TEST_ASSERT_EQUAL(0, stats.high_watermark + stats.low_watermark + stats.reader.acquire_cnt + stats.writer.block_cnt);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(db));
+
+    // The writer of a FIFO waits when all the blocks are filled
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_fifo(1, 1, &db));
+    wr_blk.buf = NULL;
+    wr_blk.valid_size = 100;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_write(db, &wr_blk, 100, portMAX_DELAY));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(db, &wr_blk, portMAX_DELAY));
+    esp_gmf_db_acquire_write(db, &wr_blk, 100, 1);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_stats(db, &stats));
+    TEST_ASSERT_EQUAL(2, stats.writer.acquire_cnt);
+    TEST_ASSERT_EQUAL(1, stats.writer.block_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stats.high_watermark);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(db));
+}
+#endif  /* CONFIG_ESP_GMF_DB_STATS_EN */
+
+static void db_drop_write(esp_gmf_db_handle_t db, uint8_t val, uint8_t meta_flag, bool is_last)
+{
+    esp_gmf_payload_t load = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_payload_write(db, &load, 100, portMAX_DELAY));
+    memset(load.buf, val, 100);
+    load.valid_size = 100;
+    load.meta_flag = meta_flag;
+    load.is_done = is_last;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_payload_write(db, &load, portMAX_DELAY));
+}
+
+static void db_drop_read(esp_gmf_db_handle_t db, uint8_t val)
+{
+    esp_gmf_data_bus_block_t blk = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(db, &blk, 100, 0));
+    TEST_ASSERT_EQUAL(100, blk.valid_size);
+    TEST_ASSERT_EQUAL(val, blk.buf[0]);
+    TEST_ASSERT_EQUAL(val, blk.buf[99]);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_read(db, &blk, 0));
+}
+
+TEST_CASE("Data bus drop policies for the slow reader", "[ESP_GMF_RINGBUF]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_db_handle_t db = NULL;
+    esp_gmf_data_bus_block_t blk = {0};
+    uint32_t dropped = 0;
+    bool ready = false;
+
+    // The byte data bus has no boundary to drop at
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_ringbuf(1, 256, &db));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_SUPPORT, esp_gmf_db_set_drop_policy(db, ESP_GMF_DB_DROP_NEWEST));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_set_drop_policy(db, ESP_GMF_DB_DROP_NONE));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(db));
+
+    // The newest data is dropped once the data bus is full, unless the reader makes space before the release
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_block(100, 2, &db));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_set_drop_policy(db, ESP_GMF_DB_DROP_NEWEST));
+    db_drop_write(db, 1, 0, false);
+    db_drop_write(db, 2, 0, false);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_is_ready(db, ESP_GMF_DB_READY_WRITE, 100, &ready));
+    TEST_ASSERT_TRUE(ready);
+    db_drop_write(db, 3, 0, false);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_dropped(db, &dropped));
+    TEST_ASSERT_EQUAL(1, dropped);
+    esp_gmf_data_bus_block_t wr_blk = {0};
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_write(db, &wr_blk, 100, portMAX_DELAY));
+    memset(wr_blk.buf, 4, 100);
+    wr_blk.valid_size = 100;
+    db_drop_read(db, 1);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(db, &wr_blk, portMAX_DELAY));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_dropped(db, &dropped));
+    TEST_ASSERT_EQUAL(1, dropped);
+    db_drop_read(db, 2);
+    db_drop_read(db, 4);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(db));
+
+    // The oldest data is dropped, while the reader holds a block the unread data behind it is dropped
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_block(100, 2, &db));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_set_drop_policy(db, ESP_GMF_DB_DROP_OLDEST));
+    db_drop_write(db, 1, 0, false);
+    db_drop_write(db, 2, 0, false);
+    db_drop_write(db, 3, 0, false);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_dropped(db, &dropped));
+    TEST_ASSERT_EQUAL(1, dropped);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(db, &blk, 100, 0));
+    TEST_ASSERT_EQUAL(2, blk.buf[0]);
+    db_drop_write(db, 4, 0, false);
+    db_drop_write(db, 5, 0, false);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_dropped(db, &dropped));
+    TEST_ASSERT_EQUAL(3, dropped);
+    TEST_ASSERT_EQUAL(2, blk.buf[0]);
+    TEST_ASSERT_EQUAL(2, blk.buf[99]);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_read(db, &blk, 0));
+    db_drop_read(db, 5);
+    // The same for the held block at the head of the storage, with the unread data at its end
+    db_drop_write(db, 6, 0, false);
+    db_drop_write(db, 7, 0, false);
+    db_drop_read(db, 6);
+    db_drop_write(db, 8, 0, false);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(db, &blk, 100, 0));
+    TEST_ASSERT_EQUAL(7, blk.buf[0]);
+    db_drop_write(db, 9, 0, false);
+    TEST_ASSERT_EQUAL(7, blk.buf[99]);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_read(db, &blk, 0));
+    db_drop_read(db, 9);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_dropped(db, &dropped));
+    TEST_ASSERT_EQUAL(4, dropped);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(db));
+
+    // After a drop, the data is dropped until the next key frame even though there is space
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_block(100, 2, &db));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_set_drop_policy(db, ESP_GMF_DB_DROP_TO_KEY_FRAME));
+    db_drop_write(db, 1, ESP_GMF_META_FLAG_VID_KEY_FRAME, false);
+    db_drop_write(db, 2, 0, false);
+    db_drop_write(db, 3, 0, false);
+    db_drop_read(db, 1);
+    db_drop_write(db, 4, 0, false);
+    db_drop_write(db, 5, ESP_GMF_META_FLAG_VID_KEY_FRAME, false);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_dropped(db, &dropped));
+    TEST_ASSERT_EQUAL(2, dropped);
+    db_drop_read(db, 2);
+    db_drop_read(db, 5);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(db));
+}
+
+#ifdef CONFIG_ESP_GMF_LATENCY_TRACE_EN
+static void db_stamp_write(esp_gmf_db_handle_t db, int64_t trace_us, uint32_t size)
+{
+    uint8_t data[100] = {0};
+    esp_gmf_payload_t load = {
+        .buf = data,
+        .buf_length = sizeof(data),
+    };
+    TEST_ASSERT_GREATER_OR_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_payload_write(db, &load, size, portMAX_DELAY));
+    memset(load.buf, (uint8_t)trace_us, size);
+    load.valid_size = size;
+    load.trace_us = trace_us;
+    TEST_ASSERT_GREATER_OR_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_payload_write(db, &load, portMAX_DELAY));
+}
+
+static int64_t db_stamp_read(esp_gmf_db_handle_t db, uint32_t size)
+{
+    uint8_t data[100] = {0};
+    esp_gmf_payload_t load = {
+        .buf = data,
+        .buf_length = sizeof(data),
+        .trace_us = -1,
+    };
+    TEST_ASSERT_GREATER_OR_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_payload_read(db, &load, size, 0));
+    TEST_ASSERT_EQUAL(size, load.valid_size);
+    int64_t trace_us = load.trace_us;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_payload_read(db, &load, 0));
+    return trace_us;
+}
+
+TEST_CASE("Data bus carries the trace stamps of the payloads", "[ESP_GMF_RINGBUF]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_db_handle_t db = NULL;
+
+    // The read gets the stamp of its first byte, whatever the sizes of the writes
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_ringbuf(1, 256, &db));
+    db_stamp_write(db, 10, 60);
+    db_stamp_write(db, 20, 60);
+    TEST_ASSERT_EQUAL(10, db_stamp_read(db, 50));
+    TEST_ASSERT_EQUAL(10, db_stamp_read(db, 50));
+    TEST_ASSERT_EQUAL(20, db_stamp_read(db, 20));
+    // The data written as a block has no stamp
+    uint8_t data[10] = {0};
+    esp_gmf_data_bus_block_t blk = {
+        .buf = data,
+        .buf_length = sizeof(data),
+        .valid_size = sizeof(data),
+    };
+    TEST_ASSERT_GREATER_OR_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_write(db, &blk, sizeof(data), 0));
+    TEST_ASSERT_GREATER_OR_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(db, &blk, 0));
+    db_stamp_write(db, 30, 10);
+    TEST_ASSERT_EQUAL(0, db_stamp_read(db, 10));
+    TEST_ASSERT_EQUAL(30, db_stamp_read(db, 10));
+    // The stamps go with the data on reset
+    db_stamp_write(db, 40, 10);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_reset(db));
+    db_stamp_write(db, 50, 10);
+    TEST_ASSERT_EQUAL(50, db_stamp_read(db, 10));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(db));
+
+    // The stamps of the dropped data go along
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_block(100, 2, &db));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_set_drop_policy(db, ESP_GMF_DB_DROP_OLDEST));
+    db_stamp_write(db, 1, 100);
+    db_stamp_write(db, 2, 100);
+    db_stamp_write(db, 3, 100);
+    TEST_ASSERT_EQUAL(2, db_stamp_read(db, 100));
+    TEST_ASSERT_EQUAL(3, db_stamp_read(db, 100));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(db));
+}
+#endif  /* CONFIG_ESP_GMF_LATENCY_TRACE_EN */
+
 TEST_CASE("Ringbuffer read and write on different task", "[ESP_GMF_RINGBUF]")
 {
     esp_log_level_set("*", ESP_LOG_INFO);
@@ -0,0 +1,252 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+
+#include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
+#include "esp_gmf_data_bus.h"
+#include "esp_gmf_new_databus.h"
+#include "esp_gmf_spsc_rb.h"
+#include "esp_gmf_ringbuffer.h"
+#include "gmf_ut_common.h"
+
+#define BENCH_TOTAL_SIZE (1024 * 1024)
+#define BENCH_STAMP_SIZE (sizeof(int64_t))
+
+static const char *TAG = "TEST_ESP_GMF_SPSC_RB";
+
+typedef int (*db_new_func)(int num, int item_cnt, esp_gmf_db_handle_t *h);
+
+typedef struct {
+    esp_gmf_db_handle_t db;
+    esp_gmf_rb_handle_t rb;
+    uint32_t            chunk_size;
+    uint32_t            write_size;
+    uint32_t            read_size;
+    uint64_t            latency_sum;
+    uint32_t            latency_max;
+    uint32_t            latency_cnt;
+    bool                data_err;
+    volatile bool       write_done;
+    volatile bool       read_done;
+} db_bench_t;
+
+/**
+ * The zero-copy entry has no data bus wrapper, it drives the ring buffer through the in-place calls directly
+ */
+static esp_gmf_err_io_t bench_acquire_write(db_bench_t *bench, esp_gmf_data_bus_block_t *blk)
+{
+    if (bench->rb) {
+        return esp_gmf_rb_acquire_write_in_place(bench->rb, blk, bench->chunk_size, portMAX_DELAY);
+    }
+    return esp_gmf_db_acquire_write(bench->db, blk, bench->chunk_size, portMAX_DELAY);
+}
+
+static esp_gmf_err_io_t bench_release_write(db_bench_t *bench, esp_gmf_data_bus_block_t *blk)
+{
+    if (bench->rb) {
+        return esp_gmf_rb_release_write(bench->rb, blk, portMAX_DELAY);
+    }
+    return esp_gmf_db_release_write(bench->db, blk, portMAX_DELAY);
+}
+
+static esp_gmf_err_io_t bench_acquire_read(db_bench_t *bench, esp_gmf_data_bus_block_t *blk)
+{
+    if (bench->rb) {
+        return esp_gmf_rb_acquire_read_in_place(bench->rb, blk, bench->chunk_size, portMAX_DELAY);
+    }
+    return esp_gmf_db_acquire_read(bench->db, blk, bench->chunk_size, portMAX_DELAY);
+}
+
+static esp_gmf_err_io_t bench_release_read(db_bench_t *bench, esp_gmf_data_bus_block_t *blk)
+{
+    if (bench->rb) {
+        return esp_gmf_rb_release_read(bench->rb, blk, portMAX_DELAY);
+    }
+    return esp_gmf_db_release_read(bench->db, blk, portMAX_DELAY);
+}
+
+static void bench_write_task(void *param)
+{
+    db_bench_t *bench = (db_bench_t *)param;
+    uint8_t *local = esp_gmf_oal_malloc(bench->chunk_size);
+    ESP_GMF_MEM_CHECK(TAG, local, goto _bench_write_exit);
+    while (bench->write_size < BENCH_TOTAL_SIZE) {
+        esp_gmf_data_bus_block_t blk = {.buf = local, .buf_length = bench->chunk_size};
+        if (bench_acquire_write(bench, &blk) != ESP_GMF_IO_OK) {
+            ESP_LOGE(TAG, "Acquire write failed");
+            bench->data_err = true;
+            break;
+        }
+        for (int i = BENCH_STAMP_SIZE; i < bench->chunk_size; i++) {
+            blk.buf[i] = (uint8_t)(bench->write_size + i);
+        }
+        int64_t stamp = esp_gmf_oal_sys_get_time_us();
+        memcpy(blk.buf, &stamp, BENCH_STAMP_SIZE);
+        blk.valid_size = bench->chunk_size;
+        if (bench_release_write(bench, &blk) != ESP_GMF_IO_OK) {
+            ESP_LOGE(TAG, "Release write failed");
+            bench->data_err = true;
+            break;
+        }
+        bench->write_size += bench->chunk_size;
+    }
+    if (bench->rb) {
+        esp_gmf_rb_done_write(bench->rb);
+    } else {
+        esp_gmf_db_done_write(bench->db);
+    }
+_bench_write_exit:
+    esp_gmf_oal_free(local);
+    bench->write_done = true;
+    vTaskDelete(NULL);
+}
+
+static void bench_read_task(void *param)
+{
+    db_bench_t *bench = (db_bench_t *)param;
+    uint8_t *local = esp_gmf_oal_malloc(bench->chunk_size);
+    ESP_GMF_MEM_CHECK(TAG, local, goto _bench_read_exit);
+    while (bench->read_size < BENCH_TOTAL_SIZE) {
+        esp_gmf_data_bus_block_t blk = {.buf = local, .buf_length = bench->chunk_size};
+        if (bench_acquire_read(bench, &blk) != ESP_GMF_IO_OK
+            || blk.valid_size != bench->chunk_size) {
+            ESP_LOGE(TAG, "Acquire read failed, valid:%d", blk.valid_size);
+            bench->data_err = true;
+            break;
+        }
+        int64_t stamp = 0;
+        memcpy(&stamp, blk.buf, BENCH_STAMP_SIZE);
+        uint32_t latency = (uint32_t)(esp_gmf_oal_sys_get_time_us() - stamp);
+        bench->latency_sum += latency;
+        bench->latency_cnt++;
+        if (latency > bench->latency_max) {
+            bench->latency_max = latency;
+        }
+        for (int i = BENCH_STAMP_SIZE; i < bench->chunk_size; i++) {
+            if (blk.buf[i] != (uint8_t)(bench->read_size + i)) {
+                bench->data_err = true;
+                break;
+            }
+        }
+        bench_release_read(bench, &blk);
+        bench->read_size += bench->chunk_size;
+        if (bench->data_err) {
+            break;
+        }
+    }
+_bench_read_exit:
+    esp_gmf_oal_free(local);
+    bench->read_done = true;
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("SPSC ringbuffer data bus read and write", "[ESP_GMF_SPSC_RB]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_db_handle_t db = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_new_spsc_ringbuf(1, 1024, &db));
+    uint32_t size = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_total_size(db, &size));
+    TEST_ASSERT_EQUAL(1024, size);
+
+    uint8_t wr_buf[1024];
+    uint8_t rd_buf[1024];
+    for (int i = 0; i < sizeof(wr_buf); i++) {
+        wr_buf[i] = (uint8_t)i;
+    }
+    esp_gmf_data_bus_block_t wr_blk = {.buf = wr_buf, .buf_length = sizeof(wr_buf), .valid_size = 600};
+    esp_gmf_data_bus_block_t rd_blk = {.buf = rd_buf, .buf_length = sizeof(rd_buf)};
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(db, &wr_blk, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(db, &rd_blk, 512, 0));
+    TEST_ASSERT_EQUAL(512, rd_blk.valid_size);
+    TEST_ASSERT_EQUAL_MEMORY(wr_buf, rd_buf, 512);
+
+    // Write across the end of the buffer
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(db, &wr_blk, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_filled_size(db, &size));
+    TEST_ASSERT_EQUAL(688, size);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(db, &rd_blk, 688, 0));
+    TEST_ASSERT_EQUAL(688, rd_blk.valid_size);
+    TEST_ASSERT_EQUAL_MEMORY(wr_buf + 512, rd_buf, 88);
+    TEST_ASSERT_EQUAL_MEMORY(wr_buf, rd_buf + 88, 600);
+
+    // Empty for the reader and full for the writer
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_TIMEOUT, esp_gmf_db_acquire_read(db, &rd_blk, 4, 0));
+    TEST_ASSERT_EQUAL(0, rd_blk.valid_size);
+    wr_blk.valid_size = sizeof(wr_buf);
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(db, &wr_blk, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_get_available(db, &size));
+    TEST_ASSERT_EQUAL(0, size);
+    wr_blk.valid_size = 4;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_TIMEOUT, esp_gmf_db_release_write(db, &wr_blk, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_abort(db));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_ABORT, esp_gmf_db_release_write(db, &wr_blk, 0));
+
+    // The tail which is not a multiple of 4 is read out once writing is done
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_reset(db));
+    wr_blk.valid_size = 7;
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_release_write(db, &wr_blk, 0));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_done_write(db));
+    TEST_ASSERT_EQUAL(ESP_GMF_IO_OK, esp_gmf_db_acquire_read(db, &rd_blk, 16, 0));
+    TEST_ASSERT_EQUAL(7, rd_blk.valid_size);
+    TEST_ASSERT_TRUE(rd_blk.is_last);
+    TEST_ASSERT_EQUAL_MEMORY(wr_buf, rd_buf, 7);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(db));
+}
+
+TEST_CASE("Data bus throughput and latency benchmark", "[ESP_GMF_SPSC_RB]")
+{
+    esp_log_level_set("*", ESP_LOG_WARN);
+    esp_log_level_set(TAG, ESP_LOG_INFO);
+    const struct {
+        const char *name;
+        db_new_func new_db;
+        int         num;
+        int         item_cnt;
+    } buses[] = {
+        {"spsc_ringbuffer", esp_gmf_db_new_spsc_ringbuf, 1, 4},
+        {"ringbuffer", esp_gmf_db_new_ringbuf, 1, 4},
+        {"ringbuffer_zc", NULL, 1, 4},
+        {"block", esp_gmf_db_new_block, 1, 4},
+        {"fifo", esp_gmf_db_new_fifo, 4, 1},
+    };
+    const uint32_t chunk_sizes[] = {256, 4096};
+    for (int c = 0; c < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); c++) {
+        for (int b = 0; b < sizeof(buses) / sizeof(buses[0]); b++) {
+            // The ring and block buses hold 4 chunks, the fifo holds 4 nodes
+            int num = buses[b].num == 1 ? chunk_sizes[c] : buses[b].num;
+            db_bench_t bench = {.chunk_size = chunk_sizes[c]};
+            if (buses[b].new_db) {
+                TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, buses[b].new_db(num, buses[b].item_cnt, &bench.db));
+            } else {
+                TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_rb_create(num, buses[b].item_cnt, &bench.rb));
+            }
+            int64_t start = esp_gmf_oal_sys_get_time_us();
+            xTaskCreatePinnedToCore(bench_read_task, "bench_rd", 4096, &bench, 5, NULL, 0);
+            xTaskCreatePinnedToCore(bench_write_task, "bench_wr", 4096, &bench, 5, NULL, portNUM_PROCESSORS - 1);
+            while (!bench.read_done || !bench.write_done) {
+                vTaskDelay(10 / portTICK_PERIOD_MS);
+            }
+            int64_t elapsed = esp_gmf_oal_sys_get_time_us() - start;
+            ESP_LOGI(TAG, "%-16s chunk:%5ld, throughput:%7lld KB/s, latency avg:%5lld us, max:%6ld us",
+                     buses[b].name, chunk_sizes[c], (int64_t)bench.read_size * 1000000 / 1024 / (elapsed ? elapsed : 1),
+                     bench.latency_cnt ? (int64_t)(bench.latency_sum / bench.latency_cnt) : 0, bench.latency_max);
+            TEST_ASSERT_FALSE(bench.data_err);
+            TEST_ASSERT_EQUAL(BENCH_TOTAL_SIZE, bench.read_size);
+            if (bench.rb) {
+                TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_rb_destroy(bench.rb));
+            } else {
+                TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_db_deinit(bench.db));
+            }
+        }
+    }
+}
@@ -7,8 +7,11 @@
 #include "unity.h"
 #include "freertos/FreeRTOS.h"
 #include "esp_log.h"
+#include "esp_heap_caps.h"
 #include "esp_gmf_oal_mem.h"
+#include "esp_gmf_oal_sys.h"
 #include "esp_gmf_task.h"
+#include "esp_gmf_task_pool.h"
 
 static const char *TAG = "TEST_ESP_GMF_TASK";
 
@@ -108,6 +111,30 @@ esp_gmf_job_err_t cleanup4(void *self, void *para)
     test_gmf_task4_count.cleanup++;
     return test_gmf_task4_count.cleanup_return;
 }
+static int test_gmf_wait_ready_cnt;
+static int test_gmf_wait_run_cnt;
+
+esp_gmf_job_err_t working_wait(void *self, void *para)
+{
+    test_gmf_wait_run_cnt++;
+    if (test_gmf_wait_ready_cnt == 0) {
+        return ESP_GMF_JOB_ERR_WAIT;
+    }
+    test_gmf_wait_ready_cnt--;
+    return ESP_GMF_JOB_ERR_OK;
+}
+
+static int test_gmf_feed_cnt;
+
+esp_gmf_job_err_t working_feed(void *self, void *para)
+{
+    if (test_gmf_feed_cnt == 0) {
+        return ESP_GMF_JOB_ERR_WAIT;
+    }
+    test_gmf_feed_cnt--;
+    return ESP_GMF_JOB_ERR_OK;
+}
+
 static void clear_test_gmf_task_count(void)
 {
     memset(&test_gmf_task4_count, 0, sizeof(test_gmf_task4_count));
@@ -486,6 +513,515 @@ TEST_CASE("Stopped by stop API", "[ESP_GMF_TASK]")
     // }
 }
 
+TEST_CASE("Two tasks share one task pool", "[ESP_GMF_TASK]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    clear_test_gmf_task_count();
+    ESP_GMF_MEM_SHOW(TAG);
+
+    esp_gmf_task_pool_cfg_t pool_cfg = DEFAULT_ESP_GMF_TASK_POOL_CONFIG();
+    pool_cfg.worker_num = 1;
+    pool_cfg.job_slice = 2;
+    esp_gmf_task_pool_handle_t pool = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_pool_create(&pool_cfg, &pool));
+    uint8_t worker_num = 0;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_pool_get_worker_num(pool, &worker_num));
+    TEST_ASSERT_EQUAL(1, worker_num);
+
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.pool = pool;
+    esp_gmf_task_handle_t hd1 = NULL;
+    esp_gmf_task_handle_t hd2 = NULL;
+    cfg.name = "pool_tsk1";
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_init(&cfg, &hd1));
+    cfg.name = "pool_tsk2";
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_init(&cfg, &hd2));
+    esp_gmf_task_set_event_func(hd1, esp_gmf_task_evt, NULL);
+    esp_gmf_task_set_event_func(hd2, esp_gmf_task_evt, NULL);
+
+    esp_gmf_task_register_ready_job(hd1, NULL, prepare1, ESP_GMF_JOB_TIMES_ONCE, NULL, false);
+    esp_gmf_task_register_ready_job(hd1, NULL, prepare2, ESP_GMF_JOB_TIMES_ONCE, NULL, false);
+    esp_gmf_task_register_ready_job(hd1, NULL, working1, ESP_GMF_JOB_TIMES_INFINITE, NULL, false);
+    esp_gmf_task_register_ready_job(hd1, NULL, working2, ESP_GMF_JOB_TIMES_INFINITE, NULL, false);
+
+    esp_gmf_task_register_ready_job(hd2, NULL, prepare3, ESP_GMF_JOB_TIMES_ONCE, NULL, false);
+    esp_gmf_task_register_ready_job(hd2, NULL, prepare4, ESP_GMF_JOB_TIMES_ONCE, NULL, false);
+    esp_gmf_task_register_ready_job(hd2, NULL, working3, ESP_GMF_JOB_TIMES_INFINITE, NULL, false);
+    esp_gmf_task_register_ready_job(hd2, NULL, working4, ESP_GMF_JOB_TIMES_INFINITE, NULL, false);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_run(hd1));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_run(hd2));
+    vTaskDelay(1000 / portTICK_PERIOD_MS);
+
+    // Both tasks make progress on the single worker
+    TEST_ASSERT_NOT_EQUAL(0, test_gmf_task1_count.working);
+    TEST_ASSERT_NOT_EQUAL(0, test_gmf_task3_count.working);
+
+    // A paused task releases the worker to the other one
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_pause(hd1));
+    uint32_t task1_working = test_gmf_task1_count.working;
+    uint32_t task3_working = test_gmf_task3_count.working;
+    vTaskDelay(500 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(task1_working, test_gmf_task1_count.working);
+    TEST_ASSERT_GREATER_THAN(task3_working, test_gmf_task3_count.working);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_resume(hd1));
+    vTaskDelay(500 / portTICK_PERIOD_MS);
+    TEST_ASSERT_GREATER_THAN(task1_working, test_gmf_task1_count.working);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_stop(hd1));
+    ESP_LOGW(TAG, "SET task2 working return DONE");
+    test_gmf_task3_count.working_return = ESP_GMF_JOB_ERR_DONE;
+    test_gmf_task4_count.working_return = ESP_GMF_JOB_ERR_DONE;
+    vTaskDelay(1500 / portTICK_PERIOD_MS);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(hd1));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(hd2));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_pool_destroy(pool));
+    ESP_GMF_MEM_SHOW(TAG);
+
+    TEST_ASSERT_EQUAL(1, test_gmf_task1_count.prepare);
+    TEST_ASSERT_EQUAL(1, test_gmf_task2_count.prepare);
+    TEST_ASSERT_EQUAL(1, test_gmf_task3_count.prepare);
+    TEST_ASSERT_EQUAL(1, test_gmf_task4_count.prepare);
+
+    // The cleanup jobs are registered on both tasks by the event callback
+    TEST_ASSERT_EQUAL(2, test_gmf_task1_count.cleanup);
+    TEST_ASSERT_EQUAL(2, test_gmf_task2_count.cleanup);
+    TEST_ASSERT_EQUAL(2, test_gmf_task3_count.cleanup);
+    TEST_ASSERT_EQUAL(2, test_gmf_task4_count.cleanup);
+
+    ESP_LOGI(TAG, "task1: %d, task2: %d, task3: %d, task4: %d", test_gmf_task1_count.working,
+             test_gmf_task2_count.working, test_gmf_task3_count.working, test_gmf_task4_count.working);
+}
+
+static int test_gmf_posted_cnt;
+
+static esp_gmf_job_err_t posted_job(void *self, void *para)
+{
+    // Post itself again on the first run, as the splice waiting for the truncated input
+    if (test_gmf_posted_cnt++ == 0) {
+        esp_gmf_task_post_job((esp_gmf_task_handle_t)self, "posted", posted_job, self);
+    }
+    return ESP_GMF_JOB_ERR_OK;
+}
+
+static void test_gmf_task_wait_ready(esp_gmf_task_pool_handle_t pool)
+{
+    clear_test_gmf_task_count();
+    test_gmf_wait_ready_cnt = 0;
+    test_gmf_wait_run_cnt = 0;
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.pool = pool;
+    esp_gmf_task_handle_t hd = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_init(&cfg, &hd));
+    esp_gmf_task_set_event_func(hd, esp_gmf_task_evt, NULL);
+    esp_gmf_task_register_ready_job(hd, NULL, prepare1, ESP_GMF_JOB_TIMES_ONCE, NULL, false);
+    esp_gmf_task_register_ready_job(hd, NULL, working_wait, ESP_GMF_JOB_TIMES_INFINITE, NULL, false);
+    esp_gmf_task_register_ready_job(hd, NULL, working1, ESP_GMF_JOB_TIMES_INFINITE, NULL, false);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_run(hd));
+    vTaskDelay(500 / portTICK_PERIOD_MS);
+    // The task sleeps instead of calling the waiting job again and again, the following job is not run
+    TEST_ASSERT_LESS_OR_EQUAL(2, test_gmf_wait_run_cnt);
+    TEST_ASSERT_EQUAL(0, test_gmf_task1_count.working);
+
+    // The posted job runs before the task sleeps again, the job posted by it waits for the next boundary without spinning
+    test_gmf_posted_cnt = 0;
+    int run_cnt = test_gmf_wait_run_cnt;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_post_job(hd, "posted", posted_job, hd));
+    vTaskDelay(200 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(1, test_gmf_posted_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(run_cnt + 3, test_gmf_wait_run_cnt);
+
+    test_gmf_wait_ready_cnt = 3;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_notify_ready(hd));
+    vTaskDelay(500 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(3, test_gmf_task1_count.working);
+    TEST_ASSERT_EQUAL(0, test_gmf_wait_ready_cnt);
+    TEST_ASSERT_EQUAL(2, test_gmf_posted_cnt);
+
+    // Commands are handled while the job is waiting
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_pause(hd));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_resume(hd));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_stop(hd));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(hd));
+
+    TEST_ASSERT_EQUAL(1, test_gmf_task1_count.prepare);
+    TEST_ASSERT_EQUAL(3, test_gmf_task1_count.working);
+    TEST_ASSERT_EQUAL(1, test_gmf_task1_count.cleanup);
+    ESP_LOGI(TAG, "Waiting job run %d times", test_gmf_wait_run_cnt);
+}
+
+TEST_CASE("Waiting job sleeps until notified", "[ESP_GMF_TASK]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    ESP_GMF_MEM_SHOW(TAG);
+    test_gmf_task_wait_ready(NULL);
+
+    esp_gmf_task_pool_cfg_t pool_cfg = DEFAULT_ESP_GMF_TASK_POOL_CONFIG();
+    esp_gmf_task_pool_handle_t pool = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_pool_create(&pool_cfg, &pool));
+    test_gmf_task_wait_ready(pool);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_pool_destroy(pool));
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+static void test_gmf_task_wait_chains(esp_gmf_task_pool_handle_t pool)
+{
+    clear_test_gmf_task_count();
+    test_gmf_wait_ready_cnt = 0;
+    test_gmf_wait_run_cnt = 0;
+    test_gmf_feed_cnt = 5;
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.pool = pool;
+    esp_gmf_task_handle_t hd = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_init(&cfg, &hd));
+    esp_gmf_task_set_event_func(hd, esp_gmf_task_evt, NULL);
+    esp_gmf_task_register_ready_job(hd, NULL, prepare1, ESP_GMF_JOB_TIMES_ONCE, NULL, false);
+    esp_gmf_task_register_ready_job(hd, NULL, working_wait, ESP_GMF_JOB_TIMES_INFINITE, NULL, false);
+    esp_gmf_task_register_ready_job(hd, NULL, working1, ESP_GMF_JOB_TIMES_INFINITE, NULL, false);
+    // The second chain is fed by its own source, it doesn't depend on the waiting job
+    esp_gmf_task_register_ready_job(hd, NULL, working_feed, ESP_GMF_JOB_TIMES_INFINITE, &test_gmf_feed_cnt, false);
+    esp_gmf_task_register_ready_job(hd, NULL, working2, ESP_GMF_JOB_TIMES_INFINITE, &test_gmf_feed_cnt, false);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_task_set_chain_head(hd, &test_gmf_wait_run_cnt));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_set_chain_head(hd, &test_gmf_feed_cnt));
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_run(hd));
+    vTaskDelay(1200 / portTICK_PERIOD_MS);
+    // The second chain runs all its data while the first one waits, the successor of the waiting job is not run
+    TEST_ASSERT_EQUAL(5, test_gmf_task2_count.working);
+    TEST_ASSERT_EQUAL(0, test_gmf_task1_count.working);
+    // Both chains wait now, the task sleeps
+    int run_cnt = test_gmf_wait_run_cnt;
+    vTaskDelay(300 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(run_cnt, test_gmf_wait_run_cnt);
+
+    test_gmf_wait_ready_cnt = 3;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_notify_ready(hd));
+    vTaskDelay(500 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(3, test_gmf_task1_count.working);
+    TEST_ASSERT_EQUAL(5, test_gmf_task2_count.working);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_stop(hd));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(hd));
+}
+
+TEST_CASE("Waiting job doesn't stall the independent chain", "[ESP_GMF_TASK]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    ESP_GMF_MEM_SHOW(TAG);
+    test_gmf_task_wait_chains(NULL);
+
+    esp_gmf_task_pool_cfg_t pool_cfg = DEFAULT_ESP_GMF_TASK_POOL_CONFIG();
+    esp_gmf_task_pool_handle_t pool = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_pool_create(&pool_cfg, &pool));
+    test_gmf_task_wait_chains(pool);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_pool_destroy(pool));
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+TEST_CASE("Profile the jobs of task", "[ESP_GMF_TASK]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    clear_test_gmf_task_count();
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    esp_gmf_task_handle_t hd = NULL;
+    ESP_GMF_MEM_SHOW(TAG);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_init(&cfg, &hd));
+    esp_gmf_task_set_event_func(hd, esp_gmf_task_evt, NULL);
+    esp_gmf_task_register_ready_job(hd, "prepare", prepare1, ESP_GMF_JOB_TIMES_ONCE, NULL, false);
+    esp_gmf_task_register_ready_job(hd, "fast", working1, ESP_GMF_JOB_TIMES_INFINITE, NULL, false);
+    esp_gmf_task_register_ready_job(hd, "slow", working3, ESP_GMF_JOB_TIMES_INFINITE, NULL, false);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_run(hd));
+    vTaskDelay(600 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_stop(hd));
+
+    const void *iter = NULL;
+    esp_gmf_job_stats_t stats = {0};
+#ifdef CONFIG_ESP_GMF_TASK_PROFILING_EN
+    esp_gmf_job_stats_t fast = {0};
+    esp_gmf_job_stats_t slow = {0};
+    int job_cnt = 0;
+    while (esp_gmf_task_get_job_stats(hd, &iter, &stats) == ESP_GMF_ERR_OK) {
+        ESP_LOGI(TAG, "%s, calls:%ld, total:%lld, min/p50/p90/p99/max:%ld/%ld/%ld/%ld/%ld", stats.label, stats.call_cnt,
+                 stats.total_us, stats.min_us, stats.p50_us, stats.p90_us, stats.p99_us, stats.max_us);
+        if (strcmp(stats.label, "prepare") == 0) {
+            TEST_ASSERT_EQUAL(1, stats.call_cnt);
+        } else if (strcmp(stats.label, "fast") == 0) {
+            fast = stats;
+        } else if (strcmp(stats.label, "slow") == 0) {
+            slow = stats;
+        }
+        // No port is used by the jobs
+        TEST_ASSERT_EQUAL(0, stats.blocked_us);
+        TEST_ASSERT_EQUAL(0, stats.bytes_in);
+        job_cnt++;
+    }
+    // The records are kept after the jobs are done, the cleanup jobs are profiled too
+    TEST_ASSERT_EQUAL(7, job_cnt);
+    TEST_ASSERT_EQUAL(test_gmf_task1_count.working, fast.call_cnt);
+    TEST_ASSERT_EQUAL(test_gmf_task3_count.working, slow.call_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL(40000, fast.min_us);
+    TEST_ASSERT_GREATER_OR_EQUAL(90000, slow.min_us);
+    TEST_ASSERT_GREATER_OR_EQUAL(fast.p50_us, slow.p50_us);
+    TEST_ASSERT_TRUE((slow.min_us <= slow.p50_us) && (slow.p50_us <= slow.p99_us) && (slow.p99_us <= slow.max_us));
+    TEST_ASSERT_GREATER_OR_EQUAL((uint64_t)slow.min_us * slow.call_cnt, slow.total_us);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_reset_job_stats(hd));
+    iter = NULL;
+    while (esp_gmf_task_get_job_stats(hd, &iter, &stats) == ESP_GMF_ERR_OK) {
+        TEST_ASSERT_EQUAL(0, stats.call_cnt);
+        TEST_ASSERT_EQUAL(0, stats.total_us);
+    }
+    // The records of the unregistered context are freed, e.g. the one of an element deleted while the task lives on
+    esp_gmf_task_register_ready_job(hd, "kept", working2, ESP_GMF_JOB_TIMES_INFINITE, &test_gmf_feed_cnt, false);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_unregister_jobs(hd, NULL));
+    iter = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_get_job_stats(hd, &iter, &stats));
+    TEST_ASSERT_EQUAL_STRING("kept", stats.label);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_task_get_job_stats(hd, &iter, &stats));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_unregister_jobs(hd, &test_gmf_feed_cnt));
+    iter = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_FOUND, esp_gmf_task_get_job_stats(hd, &iter, &stats));
+#else
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_NOT_SUPPORT, esp_gmf_task_get_job_stats(hd, &iter, &stats));
+#endif  /* CONFIG_ESP_GMF_TASK_PROFILING_EN */
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(hd));
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+#define TEST_GMF_TASK_HEAP_TOLERANCE (64)
+
+TEST_CASE("Reuse the jobs on run and stop cycles", "[ESP_GMF_TASK]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    clear_test_gmf_task_count();
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    esp_gmf_task_handle_t hd = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_init(&cfg, &hd));
+    esp_gmf_task_set_event_func(hd, esp_gmf_task_evt, NULL);
+    size_t warm_heap = 0;
+    for (int i = 0; i < 4; i++) {
+        esp_gmf_task_register_ready_job(hd, "prepare", prepare1, ESP_GMF_JOB_TIMES_ONCE, NULL, false);
+        esp_gmf_task_register_ready_job(hd, "proc", working1, ESP_GMF_JOB_TIMES_INFINITE, NULL, false);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_run(hd));
+        vTaskDelay(200 / portTICK_PERIOD_MS);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_stop(hd));
+        TEST_ASSERT_NULL(((esp_gmf_task_t *)hd)->working);
+        TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_reset(hd));
+        // The first cycle allocates the jobs and labels, the later cycles reuse them
+        size_t heap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+        ESP_LOGI(TAG, "Cycle %d, free heap:%d", i, (int)heap);
+        if (i == 0) {
+            warm_heap = heap;
+        } else {
+            // Leave some room for the allocations out of the task, e.g. by the logging, a job slab alone is much larger
+            TEST_ASSERT_INT_WITHIN(TEST_GMF_TASK_HEAP_TOLERANCE, warm_heap, heap);
+        }
+    }
+    TEST_ASSERT_EQUAL(4, test_gmf_task1_count.prepare);
+    TEST_ASSERT_EQUAL(4, test_gmf_task1_count.cleanup);
+    TEST_ASSERT_EQUAL(4, test_gmf_task4_count.cleanup);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(hd));
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+TEST_CASE("Free the labels of the unregistered jobs", "[ESP_GMF_TASK]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    esp_gmf_task_handle_t hd = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_init(&cfg, &hd));
+    size_t first_heap = 0;
+    for (int round = 0; round < 4; round++) {
+        // Distinct labels on each round, as the jobs of the elements created and deleted one after another
+        for (int i = 0; i < 32; i++) {
+            char label[16];
+            snprintf(label, sizeof(label), "el%d_%d", round, i);
+            TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_register_ready_job(hd, label, working1, ESP_GMF_JOB_TIMES_INFINITE,
+                                                                             (void *)((intptr_t)(i % 8) + 1), false));
+        }
+        for (int i = 0; i < 8; i++) {
+            TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_unregister_jobs(hd, (void *)((intptr_t)i + 1)));
+        }
+        size_t heap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+        ESP_LOGI(TAG, "Round %d, free heap:%d", round, (int)heap);
+        if (round == 0) {
+            first_heap = heap;
+        } else {
+            TEST_ASSERT_INT_WITHIN(TEST_GMF_TASK_HEAP_TOLERANCE, first_heap, heap);
+        }
+    }
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(hd));
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+static int test_gmf_sink_cnt;
+static int test_gmf_miss_cnt;
+
+esp_gmf_job_err_t working_sink(void *self, void *para)
+{
+    test_gmf_sink_cnt++;
+    return ESP_GMF_JOB_ERR_OK;
+}
+
+static esp_gmf_err_t esp_gmf_task_deadline_evt(esp_gmf_event_pkt_t *evt, void *ctx)
+{
+    if (evt->type == ESP_GMF_EVT_TYPE_DEADLINE_MISS) {
+        esp_gmf_job_deadline_miss_t *miss = (esp_gmf_job_deadline_miss_t *)evt->payload;
+        ESP_LOGI(TAG, "Deadline missed, job:%s, late:%ld us, cnt:%ld", miss->label, miss->late_us, miss->miss_cnt);
+        TEST_ASSERT_EQUAL_PTR(&test_gmf_sink_cnt, miss->ctx);
+        test_gmf_miss_cnt++;
+    }
+    return ESP_GMF_ERR_OK;
+}
+
+TEST_CASE("Run the job with earliest deadline first", "[ESP_GMF_TASK]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    clear_test_gmf_task_count();
+    test_gmf_sink_cnt = 0;
+    test_gmf_miss_cnt = 0;
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    esp_gmf_task_handle_t hd = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_init(&cfg, &hd));
+    esp_gmf_task_set_event_func(hd, esp_gmf_task_deadline_evt, NULL);
+    // One round of the jobs in list order takes 250 ms, longer than the period of the sink
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_set_job_deadline(hd, &test_gmf_sink_cnt, 200000, 0));
+    esp_gmf_task_register_ready_job(hd, "sink", working_sink, ESP_GMF_JOB_TIMES_INFINITE, &test_gmf_sink_cnt, false);
+    esp_gmf_task_register_ready_job(hd, "bulk1", working1, ESP_GMF_JOB_TIMES_INFINITE, NULL, false);
+    esp_gmf_task_register_ready_job(hd, "bulk2", working2, ESP_GMF_JOB_TIMES_INFINITE, NULL, false);
+    esp_gmf_task_register_ready_job(hd, "bulk4", working4, ESP_GMF_JOB_TIMES_INFINITE, NULL, false);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_run(hd));
+    vTaskDelay(2000 / portTICK_PERIOD_MS);
+    // The sink waits for one bulk job at most, so it never misses
+    TEST_ASSERT_EQUAL(0, test_gmf_miss_cnt);
+    TEST_ASSERT_GREATER_THAN(test_gmf_task2_count.working, test_gmf_sink_cnt);
+
+    // Even the longest job can't meet a deadline shorter than itself
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_set_job_deadline(hd, &test_gmf_sink_cnt, 20000, 0));
+    vTaskDelay(1000 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_stop(hd));
+    TEST_ASSERT_GREATER_THAN(0, test_gmf_miss_cnt);
+
+    // The deadline is removed, the jobs run in list order
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_set_job_deadline(hd, &test_gmf_sink_cnt, 0, 0));
+    test_gmf_miss_cnt = 0;
+    esp_gmf_task_register_ready_job(hd, "sink", working_sink, ESP_GMF_JOB_TIMES_INFINITE, &test_gmf_sink_cnt, false);
+    esp_gmf_task_register_ready_job(hd, "bulk2", working2, ESP_GMF_JOB_TIMES_INFINITE, NULL, false);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_reset(hd));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_run(hd));
+    vTaskDelay(500 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_stop(hd));
+    TEST_ASSERT_EQUAL(0, test_gmf_miss_cnt);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(hd));
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+static void test_gmf_task_deadline_wakeup(esp_gmf_task_pool_handle_t pool)
+{
+    test_gmf_wait_ready_cnt = 0;
+    test_gmf_sink_cnt = 0;
+    test_gmf_miss_cnt = 0;
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    cfg.pool = pool;
+    esp_gmf_task_handle_t hd = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_init(&cfg, &hd));
+    esp_gmf_task_set_event_func(hd, esp_gmf_task_deadline_evt, NULL);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_set_job_deadline(hd, &test_gmf_sink_cnt, 20000, 0));
+    esp_gmf_task_register_ready_job(hd, "wait", working_wait, ESP_GMF_JOB_TIMES_INFINITE, NULL, false);
+    esp_gmf_task_register_ready_job(hd, "sink", working_sink, ESP_GMF_JOB_TIMES_INFINITE, &test_gmf_sink_cnt, false);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_run(hd));
+    vTaskDelay(500 / portTICK_PERIOD_MS);
+    // The sink behind the waiting job runs on its releases only, the sleeping task is woken up for each of them
+    TEST_ASSERT_GREATER_OR_EQUAL(10, test_gmf_sink_cnt);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_stop(hd));
+
+    // The deadline is kept over the run and stop cycles, and freed with the jobs of the context
+    esp_gmf_task_register_ready_job(hd, "sink", working_sink, ESP_GMF_JOB_TIMES_INFINITE, &test_gmf_sink_cnt, false);
+    TEST_ASSERT_NOT_NULL(((esp_gmf_task_t *)hd)->working->deadline);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_unregister_jobs(hd, &test_gmf_sink_cnt));
+    esp_gmf_task_register_ready_job(hd, "sink", working_sink, ESP_GMF_JOB_TIMES_INFINITE, &test_gmf_sink_cnt, false);
+    TEST_ASSERT_NULL(((esp_gmf_task_t *)hd)->working->deadline);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_unregister_jobs(hd, &test_gmf_sink_cnt));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(hd));
+}
+
+TEST_CASE("Wake up the waiting task for the job with deadline", "[ESP_GMF_TASK]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    ESP_GMF_MEM_SHOW(TAG);
+    test_gmf_task_deadline_wakeup(NULL);
+
+    esp_gmf_task_pool_cfg_t pool_cfg = DEFAULT_ESP_GMF_TASK_POOL_CONFIG();
+    esp_gmf_task_pool_handle_t pool = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_pool_create(&pool_cfg, &pool));
+    test_gmf_task_deadline_wakeup(pool);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_pool_destroy(pool));
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
+static int test_gmf_heavy_chunks;
+static int test_gmf_heavy_frames;
+static int test_gmf_heavy_yields;
+
+esp_gmf_job_err_t working_heavy(void *self, void *para)
+{
+    // One frame takes 1 s, it is processed by chunks of 10 ms and yields when the time slice is used up
+    while (test_gmf_heavy_chunks < 100) {
+        if (esp_gmf_task_get_slice_left_us() == 0) {
+            test_gmf_heavy_yields++;
+            return ESP_GMF_JOB_ERR_TRUNCATE;
+        }
+        vTaskDelay(10 / portTICK_PERIOD_MS);
+        test_gmf_heavy_chunks++;
+    }
+    test_gmf_heavy_chunks = 0;
+    test_gmf_heavy_frames++;
+    return ESP_GMF_JOB_ERR_OK;
+}
+
+TEST_CASE("Yield the long job by time slice", "[ESP_GMF_TASK]")
+{
+    esp_log_level_set("*", ESP_LOG_INFO);
+    clear_test_gmf_task_count();
+    test_gmf_heavy_chunks = 0;
+    test_gmf_heavy_frames = 0;
+    test_gmf_heavy_yields = 0;
+    esp_gmf_task_cfg_t cfg = DEFAULT_ESP_GMF_TASK_CONFIG();
+    esp_gmf_task_handle_t hd = NULL;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_init(&cfg, &hd));
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_set_time_slice(hd, 30000));
+    TEST_ASSERT_EQUAL(UINT32_MAX, esp_gmf_task_get_slice_left_us());
+    esp_gmf_task_register_ready_job(hd, "heavy", working_heavy, ESP_GMF_JOB_TIMES_INFINITE, NULL, false);
+    esp_gmf_task_register_ready_job(hd, "light", working1, ESP_GMF_JOB_TIMES_INFINITE, NULL, false);
+
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_run(hd));
+    vTaskDelay(500 / portTICK_PERIOD_MS);
+    // The light job runs between the slices of the frame
+    TEST_ASSERT_EQUAL(0, test_gmf_heavy_frames);
+    TEST_ASSERT_GREATER_THAN(2, test_gmf_heavy_yields);
+    TEST_ASSERT_GREATER_THAN(2, test_gmf_task1_count.working);
+
+    // Pause and stop are served within one chunk or one light job, rather than the rest of the frame
+    int64_t start = esp_gmf_oal_sys_get_time_us();
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_pause(hd));
+    TEST_ASSERT_LESS_THAN(150000, esp_gmf_oal_sys_get_time_us() - start);
+    int chunks = test_gmf_heavy_chunks;
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_resume(hd));
+    vTaskDelay(200 / portTICK_PERIOD_MS);
+    TEST_ASSERT_GREATER_THAN(chunks, test_gmf_heavy_chunks);
+    start = esp_gmf_oal_sys_get_time_us();
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_stop(hd));
+    TEST_ASSERT_LESS_THAN(150000, esp_gmf_oal_sys_get_time_us() - start);
+    TEST_ASSERT_EQUAL(ESP_GMF_ERR_OK, esp_gmf_task_deinit(hd));
+    ESP_GMF_MEM_SHOW(TAG);
+}
+
 TEST_CASE("Return error on the PREPARE stage", "[ESP_GMF_TASK]")
 {
     esp_log_level_set("*", ESP_LOG_INFO);
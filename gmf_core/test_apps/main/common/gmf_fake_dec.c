@@ -18,6 +18,7 @@ static const char *TAG = "FAKE_DEC";
 typedef struct {
     esp_gmf_audio_element_t parent;
     bool                    is_opened;
+    uint32_t                open_cnt;
     uint64_t                data_size;
     uint64_t                filter[2];
     mock_dec_handle_t       mock_hd;
@@ -44,9 +45,47 @@ static esp_gmf_job_err_t fake_dec_open(esp_gmf_audio_element_handle_t self, void
     ESP_LOGW(TAG, "fake_dec_open, %p-%s", self, OBJ_GET_TAG(self));
     fake_decoder_t *dec = (fake_decoder_t *)self;
     mock_dec_open(&dec->mock_hd);
+    dec->open_cnt++;
     return ESP_GMF_JOB_ERR_OK;
 }
 
+static esp_gmf_job_err_t fake_dec_join_process(esp_gmf_audio_element_handle_t self, void *para)
+{
+    esp_gmf_element_handle_t hd = (esp_gmf_element_handle_t)self;
+    esp_gmf_port_t *out_port = ESP_GMF_ELEMENT_GET(hd)->out;
+    esp_gmf_payload_t *out_load = NULL;
+    esp_gmf_err_io_t ret = esp_gmf_port_acquire_out(out_port, &out_load, ESP_GMF_ELEMENT_GET(self)->out_attr.data_size, portMAX_DELAY);
+    if (ret < ESP_GMF_IO_OK) {
+        ESP_LOGE(TAG, "Out port get error, %p, ret:%d", out_port, ret);
+        return ret == ESP_GMF_IO_ABORT ? ESP_GMF_JOB_ERR_OK : ESP_GMF_JOB_ERR_FAIL;
+    }
+    // Join one payload of each in port in the registration order, done when all the inputs are done
+    int filled = 0;
+    bool is_done = true;
+    for (esp_gmf_port_t *in_port = ESP_GMF_ELEMENT_GET(hd)->in; in_port; in_port = in_port->next) {
+        esp_gmf_payload_t *in_load = NULL;
+        ret = esp_gmf_port_acquire_in(in_port, &in_load, ESP_GMF_ELEMENT_GET(self)->in_attr.data_size, portMAX_DELAY);
+        if (ret < ESP_GMF_IO_OK) {
+            ESP_LOGE(TAG, "Read data error, port:%p, ret:%d", in_port, ret);
+            esp_gmf_port_release_out(out_port, out_load, 0);
+            return ret == ESP_GMF_IO_ABORT ? ESP_GMF_JOB_ERR_OK : ESP_GMF_JOB_ERR_FAIL;
+        }
+        int size = in_load->valid_size < (out_load->buf_length - filled) ? in_load->valid_size : (out_load->buf_length - filled);
+        memcpy(out_load->buf + filled, in_load->buf, size);
+        filled += size;
+        is_done &= in_load->is_done;
+        esp_gmf_port_release_in(in_port, in_load, portMAX_DELAY);
+    }
+    out_load->valid_size = filled;
+    out_load->is_done = is_done;
+    ret = esp_gmf_port_release_out(out_port, out_load, portMAX_DELAY);
+    if (ret < ESP_GMF_IO_OK) {
+        ESP_LOGE(TAG, "Out port get error, %p, ret:%d", out_port, ret);
+        return ret == ESP_GMF_IO_ABORT ? ESP_GMF_JOB_ERR_OK : ESP_GMF_JOB_ERR_FAIL;
+    }
+    return is_done ? ESP_GMF_JOB_ERR_DONE : ESP_GMF_JOB_ERR_OK;
+}
+
 static esp_gmf_job_err_t fake_dec_process(esp_gmf_audio_element_handle_t self, void *para)
 {
     esp_gmf_element_handle_t hd = (esp_gmf_element_handle_t)self;
@@ -71,12 +110,27 @@ static esp_gmf_job_err_t fake_dec_process(esp_gmf_audio_element_handle_t self, v
         ESP_LOGE(TAG, "Out port get error, %p, ret:%d", out_port, ret);
         return ret == ESP_GMF_IO_ABORT ? ESP_GMF_JOB_ERR_OK : ESP_GMF_JOB_ERR_FAIL;
     }
+    if ((out_load != in_load) && out_load->buf) {
+        // Decode as a plain copy, so that the output can be checked against the input
+        out_load->valid_size = in_load->valid_size < out_load->buf_length ? in_load->valid_size : out_load->buf_length;
+        memcpy(out_load->buf, in_load->buf, out_load->valid_size);
+        out_load->is_done = in_load->is_done;
+    }
     vTaskDelay(10 / portTICK_PERIOD_MS);
     ret = esp_gmf_port_release_out(out_port, out_load, portMAX_DELAY);
     if (ret < ESP_GMF_IO_OK) {
         ESP_LOGE(TAG, "Out port get error, %p, ret:%d", out_port, ret);
         return ret == ESP_GMF_IO_ABORT ? ESP_GMF_JOB_ERR_OK : ESP_GMF_JOB_ERR_FAIL;
     }
+    for (esp_gmf_port_handle_t port = out_port->next; port && cfg->is_multi_out; port = port->next) {
+        // Copy to the extra out ports without waiting, like the copier
+        esp_gmf_payload_t *copy_load = NULL;
+        if (esp_gmf_port_acquire_out(port, &copy_load, in_load->valid_size > 0 ? in_load->valid_size : in_load->buf_length, 0) < ESP_GMF_IO_OK) {
+            continue;
+        }
+        esp_gmf_payload_copy_data(in_load, copy_load);
+        esp_gmf_port_release_out(port, copy_load, 0);
+    }
     ESP_LOGD(TAG, "[%p-%s]I:%p,b:%p,s:%d, done:%d; O:%p,b:%p,s:%d, done:%d", hd, OBJ_GET_TAG(hd), in_port, in_load->buf, in_load->valid_size, in_load->is_done,
              out_port, out_load->buf, out_load->valid_size, out_load->is_done);
     ret = esp_gmf_port_release_in(in_port, in_load, portMAX_DELAY);
@@ -405,8 +459,8 @@ esp_err_t fake_dec_init(fake_dec_cfg_t *config, esp_gmf_obj_handle_t *handle)
 
     esp_gmf_element_cfg_t el_cfg = {
         .cb = config->cb,
-        .in_attr.cap = ESP_GMF_EL_PORT_CAP_SINGLE,
-        .out_attr.cap = ESP_GMF_EL_PORT_CAP_SINGLE,
+        .in_attr.cap = config->is_multi_in ? ESP_GMF_EL_PORT_CAP_MULTI : ESP_GMF_EL_PORT_CAP_SINGLE,
+        .out_attr.cap = config->is_multi_out ? ESP_GMF_EL_PORT_CAP_MULTI : ESP_GMF_EL_PORT_CAP_SINGLE,
         .in_attr.port.type = ESP_GMF_PORT_TYPE_BLOCK | ESP_GMF_PORT_TYPE_BYTE,
         .out_attr.port.type = ESP_GMF_PORT_TYPE_BLOCK | ESP_GMF_PORT_TYPE_BYTE,
         .in_attr.data_size = config->in_buf_size,
@@ -415,7 +469,7 @@ esp_err_t fake_dec_init(fake_dec_cfg_t *config, esp_gmf_obj_handle_t *handle)
     ret = esp_gmf_audio_el_init(fake, &el_cfg);
     ESP_GMF_RET_ON_NOT_OK(TAG, ret, goto FAKE_DEC_FAIL, "Failed Initialize audio el");
     ESP_GMF_ELEMENT_GET(fake)->ops.open = fake_dec_open;
-    ESP_GMF_ELEMENT_GET(fake)->ops.process = fake_dec_process;
+    ESP_GMF_ELEMENT_GET(fake)->ops.process = config->is_multi_in ? fake_dec_join_process : fake_dec_process;
     ESP_GMF_ELEMENT_GET(fake)->ops.close = fake_dec_close;
     ESP_GMF_ELEMENT_GET(fake)->ops.load_caps = _load_caps_func;
     ESP_GMF_ELEMENT_GET(fake)->ops.load_methods = _load_methods_func;
@@ -427,3 +481,8 @@ FAKE_DEC_FAIL:
     fake_dec_destroy(obj);
     return ret;
 }
+
+uint32_t fake_dec_get_open_count(esp_gmf_element_handle_t handle)
+{
+    return handle ? ((fake_decoder_t *)handle)->open_cnt : 0;
+}
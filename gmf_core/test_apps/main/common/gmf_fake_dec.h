@@ -17,12 +17,14 @@ extern "C" {
  * @brief  Fake Decoder configurations
  */
 typedef struct {
-    int               in_buf_size;  /*!< Size of output ringbuffer */
+    int               in_buf_size;   /*!< Size of output ringbuffer */
     int               out_buf_size;
     esp_gmf_event_cb  cb;
     const char       *name;
     bool              is_pass;
     bool              is_shared;
+    bool              is_multi_in;   /*!< Take multiple in ports, one payload of each in port is joined to the out payload */
+    bool              is_multi_out;  /*!< Take multiple out ports, the input is copied to the extra out ports */
 } fake_dec_cfg_t;
 
 #define FAKE_DEC_BUFFER_SIZE (5 * 1024)
@@ -34,10 +36,17 @@ typedef struct {
     .name         = NULL,                  \
     .is_pass      = false,                 \
     .is_shared    = true,                  \
+    .is_multi_in  = false,                 \
+    .is_multi_out = false,                 \
 }
 
 esp_err_t fake_dec_init(fake_dec_cfg_t *config, esp_gmf_obj_handle_t *handle);
 
+/**
+ * @brief  Get how many times the fake decoder is opened since it's created
+ */
+uint32_t fake_dec_get_open_count(esp_gmf_element_handle_t handle);
+
 #ifdef __cplusplus
 }
 #endif  /* __cplusplus */
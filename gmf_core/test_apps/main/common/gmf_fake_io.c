@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
 #include <sys/unistd.h>
 #include "freertos/FreeRTOS.h"
 #include <sys/stat.h>
@@ -15,12 +16,14 @@ static const char *TAG = "FAKE_IO";
 
 typedef struct {
     esp_gmf_io_t  base;
+    uint32_t      pos;
 } fake_io_t;
 
 static esp_gmf_err_t _file_open(esp_gmf_io_handle_t io)
 {
     fake_io_t *file_io = (fake_io_t *)io;
     ESP_LOGI(TAG, "%s, %s-%p", __func__, OBJ_GET_TAG(file_io), file_io);
+    file_io->pos = 0;
     return ESP_GMF_ERR_OK;
 }
 
@@ -29,9 +32,23 @@ esp_gmf_err_io_t _file_acquire_read(esp_gmf_io_handle_t handle, void *payload, u
     fake_io_t *file_io = (fake_io_t *)handle;
     ESP_LOGD(TAG, "%s, %s-%p", __func__, OBJ_GET_TAG(file_io), file_io);
     esp_gmf_payload_t *pload = (esp_gmf_payload_t *)payload;
+    fake_io_cfg_t *cfg = (fake_io_cfg_t *)OBJ_GET_CFG(handle);
     pload->valid_size = wanted_size;
+    if (cfg->data_size) {
+        // Give a known pattern which ends with done, so that the output can be checked
+        uint32_t left = cfg->data_size - file_io->pos;
+        pload->valid_size = (wanted_size < left) ? wanted_size : left;
+        if (pload->buf_length < pload->valid_size) {
+            pload->valid_size = pload->buf_length;
+        }
+        for (uint32_t i = 0; i < pload->valid_size; i++) {
+            pload->buf[i] = FAKE_IO_PATTERN(cfg->seed, file_io->pos + i);
+        }
+        file_io->pos += pload->valid_size;
+        pload->is_done = (file_io->pos == cfg->data_size);
+    }
     vTaskDelay(3 / portTICK_PERIOD_MS);
-    return wanted_size;
+    return pload->valid_size;
 }
 
 esp_gmf_err_io_t _file_release_read(esp_gmf_io_handle_t handle, void *payload, int block_ticks)
@@ -57,6 +74,11 @@ esp_gmf_err_io_t _file_release_write(esp_gmf_io_handle_t handle, void *payload,
     fake_io_t *file_io = (fake_io_t *)handle;
     ESP_LOGD(TAG, "%s, %s-%p", __func__, OBJ_GET_TAG(file_io), file_io);
     esp_gmf_payload_t *pload = (esp_gmf_payload_t *)payload;
+    fake_io_cfg_t *cfg = (fake_io_cfg_t *)OBJ_GET_CFG(handle);
+    if (cfg->dump_buf && pload->buf && (file_io->pos + pload->valid_size <= cfg->dump_size)) {
+        memcpy(cfg->dump_buf + file_io->pos, pload->buf, pload->valid_size);
+    }
+    file_io->pos += pload->valid_size;
     esp_gmf_io_update_pos((esp_gmf_io_handle_t)handle, pload->valid_size);
     vTaskDelay(2 / portTICK_PERIOD_MS);
     return 1;
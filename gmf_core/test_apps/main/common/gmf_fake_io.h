@@ -16,13 +16,26 @@ extern "C" {
  * @brief  Fake IO configurations
  */
 typedef struct {
-    int          dir;   /*!< IO direction, reader or writer */
-    const char  *name;  /*!< Name for this instance */
+    int          dir;        /*!< IO direction, reader or writer */
+    const char  *name;       /*!< Name for this instance */
+    uint32_t     data_size;  /*!< Reader: size of the pattern stream ending with done, 0 for an endless stream without data */
+    uint8_t      seed;       /*!< Reader: seed of the pattern, see `FAKE_IO_PATTERN` */
+    uint8_t     *dump_buf;   /*!< Writer: buffer keeping the written data at its position, NULL to drop the data */
+    uint32_t     dump_size;  /*!< Writer: size of the dump buffer */
 } fake_io_cfg_t;
 
-#define FAKE_IO_CFG_DEFAULT() {   \
-    .dir  = ESP_GMF_IO_DIR_NONE,  \
-    .name = NULL,                 \
+/**
+ * @brief  Byte of the reader pattern at the position
+ */
+#define FAKE_IO_PATTERN(seed, pos) ((uint8_t)((seed) + (pos) + ((pos) >> 8)))
+
+#define FAKE_IO_CFG_DEFAULT() {        \
+    .dir       = ESP_GMF_IO_DIR_NONE,  \
+    .name      = NULL,                 \
+    .data_size = 0,                    \
+    .seed      = 0,                    \
+    .dump_buf  = NULL,                 \
+    .dump_size = 0,                    \
 }
 
 /**
@@ -14,11 +14,14 @@ from pytest_embedded import Dut
 @pytest.mark.ESP_GMF_TASK
 @pytest.mark.ESP_GMF_IO
 @pytest.mark.ESP_GMF_RINGBUF
+@pytest.mark.ESP_GMF_SPSC_RB
 @pytest.mark.ESP_GMF_PBUF
 @pytest.mark.ESP_GMF_BLOCK
+@pytest.mark.ESP_GMF_BCAST
 @pytest.mark.ELEMENT_POOL
 @pytest.mark.ELEMENT_PORT
 @pytest.mark.ESP_GMF_METHOD
+@pytest.mark.ESP_GMF_PAYLOAD_POOL
 @pytest.mark.parametrize(
     'config',
     [
@@ -180,6 +180,8 @@ static int __setup_pipeline(esp_audio_simple_player_t *player, const char *uri,
             esp_gmf_uri_free(uri_st);
             return ESP_GMF_ERR_FAIL;
         }
+        // Keep the converters opened across the tracks, the decoder is still opened for each track
+        esp_gmf_pipeline_set_warm_restart(player->pipe, true);
         if (in_str == NULL) {
             esp_gmf_port_handle_t in_port = NEW_ESP_GMF_PORT_IN_BYTE(asp_func_acquire_read, asp_func_release_read, NULL, &player->cfg.in, 1024, ESP_GMF_MAX_DELAY);
             ESP_GMF_CHECK(TAG, in_port, goto __setup_pipe_err, "Failed to create in port");
@@ -12,6 +12,7 @@
 #include "esp_gmf_ch_cvt.h"
 #include "esp_gmf_bit_cvt.h"
 #include "esp_gmf_rate_cvt.h"
+#include "esp_gmf_fmt_cvt.h"
 #include "esp_gmf_sonic.h"
 #include "esp_gmf_alc.h"
 #include "esp_gmf_eq.h"
@@ -145,6 +146,24 @@ static esp_gmf_err_t gmf_loader_setup_default_rate_cvt(esp_gmf_pool_handle_t poo
 }
 #endif  /* CONFIG_GMF_AUDIO_EFFECT_INIT_RATE_CVT */
 
+#ifdef CONFIG_GMF_AUDIO_EFFECT_INIT_FMT_CVT
+static esp_gmf_err_t gmf_loader_setup_default_fmt_cvt(esp_gmf_pool_handle_t pool)
+{
+    ESP_GMF_NULL_CHECK(TAG, pool, return ESP_GMF_ERR_INVALID_ARG);
+    esp_gmf_err_t ret = ESP_GMF_ERR_OK;
+    esp_gmf_element_handle_t hd = NULL;
+    esp_gmf_fmt_cvt_cfg_t es_fmt_cvt_cfg = DEFAULT_ESP_GMF_FMT_CVT_CONFIG();
+    es_fmt_cvt_cfg.dest_rate = CONFIG_GMF_AUDIO_EFFECT_FMT_CVT_DEST_RATE;
+    es_fmt_cvt_cfg.dest_ch = CONFIG_GMF_AUDIO_EFFECT_FMT_CVT_DEST_CH;
+    es_fmt_cvt_cfg.dest_bits = CONFIG_GMF_AUDIO_EFFECT_FMT_CVT_DEST_BITS;
+    ret = esp_gmf_fmt_cvt_init(&es_fmt_cvt_cfg, &hd);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Failed to init audio fmt cvt");
+    ret = esp_gmf_pool_register_element(pool, hd, NULL);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, {esp_gmf_element_deinit(hd); return ret;}, "Failed to register element in pool");
+    return ret;
+}
+#endif  /* CONFIG_GMF_AUDIO_EFFECT_INIT_FMT_CVT */
+
 #ifdef CONFIG_GMF_AUDIO_EFFECT_INIT_FADE
 static esp_gmf_err_t gmf_loader_setup_default_fade(esp_gmf_pool_handle_t pool)
 {
@@ -292,6 +311,11 @@ esp_gmf_err_t gmf_loader_setup_audio_effects_default(esp_gmf_pool_handle_t pool)
     ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Failed to register rate cvt");
 #endif  /* CONFIG_GMF_AUDIO_EFFECT_INIT_RATE_CVT */
 
+#ifdef CONFIG_GMF_AUDIO_EFFECT_INIT_FMT_CVT
+    ret = gmf_loader_setup_default_fmt_cvt(pool);
+    ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Failed to register fmt cvt");
+#endif  /* CONFIG_GMF_AUDIO_EFFECT_INIT_FMT_CVT */
+
 #ifdef CONFIG_GMF_AUDIO_EFFECT_INIT_FADE
     ret = gmf_loader_setup_default_fade(pool);
     ESP_GMF_RET_ON_ERROR(TAG, ret, return ret, "Failed to register fade");